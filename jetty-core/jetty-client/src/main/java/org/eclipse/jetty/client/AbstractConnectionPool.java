@@ -319,7 +319,7 @@ public abstract class AbstractConnectionPool extends ContainerLifeCycle implemen
     {
         while (true)
         {
-            Pool.Entry<Connection> entry = pool.acquire();
+            Pool.Entry<Connection> entry = acquireEntry(pool);
             if (entry != null)
             {
                 Connection connection = entry.getPooled();
@@ -366,6 +366,19 @@ public abstract class AbstractConnectionPool extends ContainerLifeCycle implemen
         }
     }
 
+    /**
+     * <p>Acquires an entry from the given pool.</p>
+     * <p>Subclasses may override this method to select
+     * the entry using a specific algorithm.</p>
+     *
+     * @param pool the pool to acquire the entry from
+     * @return an acquired entry, or {@code null} if no entry could be acquired
+     */
+    protected Pool.Entry<Connection> acquireEntry(Pool<Connection> pool)
+    {
+        return pool.acquire();
+    }
+
     @Override
     public boolean isActive(Connection connection)
     {
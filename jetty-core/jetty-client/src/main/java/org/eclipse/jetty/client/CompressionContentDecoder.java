@@ -0,0 +1,129 @@
+//
+// ========================================================================
+// Copyright (c) 1995 Mort Bay Consulting Pty Ltd and others.
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License v. 2.0 which is available at
+// https://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+// ========================================================================
+//
+
+package org.eclipse.jetty.client;
+
+import java.util.ListIterator;
+
+import org.eclipse.jetty.client.transport.HttpResponse;
+import org.eclipse.jetty.http.HttpField;
+import org.eclipse.jetty.http.HttpHeader;
+import org.eclipse.jetty.io.ByteBufferPool;
+import org.eclipse.jetty.io.RetainableByteBuffer;
+import org.eclipse.jetty.util.compression.Compression;
+
+/**
+ * {@link ContentDecoder} for the encoding of a {@link Compression}.
+ */
+public class CompressionContentDecoder extends org.eclipse.jetty.http.CompressionContentDecoder implements ContentDecoder
+{
+    public static final int DEFAULT_BUFFER_SIZE = 8192;
+
+    private long decodedLength;
+
+    public CompressionContentDecoder(Compression compression)
+    {
+        this(compression, null, DEFAULT_BUFFER_SIZE);
+    }
+
+    public CompressionContentDecoder(Compression compression, ByteBufferPool byteBufferPool, int bufferSize)
+    {
+        super(compression, byteBufferPool, bufferSize);
+    }
+
+    @Override
+    public void beforeDecoding(Response response)
+    {
+        HttpResponse httpResponse = (HttpResponse)response;
+        httpResponse.headers(headers ->
+        {
+            boolean seenContentEncoding = false;
+            for (ListIterator<HttpField> iterator = headers.listIterator(headers.size()); iterator.hasPrevious();)
+            {
+                HttpField field = iterator.previous();
+                HttpHeader header = field.getHeader();
+                if (header == HttpHeader.CONTENT_LENGTH)
+                {
+                    // Content-Length is not valid anymore while we are decoding.
+                    iterator.remove();
+                }
+                else if (header == HttpHeader.CONTENT_ENCODING && !seenContentEncoding)
+                {
+                    // Last Content-Encoding should be removed/modified as the content will be decoded.
+                    seenContentEncoding = true;
+                    String value = field.getValue();
+                    int comma = value.lastIndexOf(",");
+                    if (comma < 0)
+                        iterator.remove();
+                    else
+                        iterator.set(new HttpField(HttpHeader.CONTENT_ENCODING, value.substring(0, comma)));
+                }
+            }
+        });
+    }
+
+    @Override
+    protected boolean decodedChunk(RetainableByteBuffer chunk)
+    {
+        decodedLength += chunk.remaining();
+        super.decodedChunk(chunk);
+        return true;
+    }
+
+    @Override
+    public void afterDecoding(Response response)
+    {
+        // Return the decoder to the Compression pool.
+        destroy();
+        HttpResponse httpResponse = (HttpResponse)response;
+        httpResponse.headers(headers ->
+        {
+            headers.remove(HttpHeader.TRANSFER_ENCODING);
+            headers.put(HttpHeader.CONTENT_LENGTH, decodedLength);
+        });
+    }
+
+    /**
+     * Specialized {@link ContentDecoder.Factory} for the encoding of a {@link Compression}.
+     */
+    public static class Factory extends ContentDecoder.Factory
+    {
+        private final Compression compression;
+        private final ByteBufferPool byteBufferPool;
+        private final int bufferSize;
+
+        public Factory(Compression compression)
+        {
+            this(compression, null);
+        }
+
+        public Factory(Compression compression, ByteBufferPool byteBufferPool)
+        {
+            this(compression, byteBufferPool, DEFAULT_BUFFER_SIZE);
+        }
+
+        public Factory(Compression compression, ByteBufferPool byteBufferPool, int bufferSize)
+        {
+            super(compression.getEncoding());
+            this.compression = compression;
+            this.byteBufferPool = byteBufferPool;
+            this.bufferSize = bufferSize;
+        }
+
+        @Override
+        public ContentDecoder newContentDecoder()
+        {
+            return new CompressionContentDecoder(compression, byteBufferPool, bufferSize);
+        }
+    }
+}
@@ -61,6 +61,7 @@ import org.eclipse.jetty.util.URIUtil;
 import org.eclipse.jetty.util.annotation.ManagedAttribute;
 import org.eclipse.jetty.util.annotation.ManagedObject;
 import org.eclipse.jetty.util.component.ContainerLifeCycle;
+import org.eclipse.jetty.util.compression.Compression;
 import org.eclipse.jetty.util.ssl.SslContextFactory;
 import org.eclipse.jetty.util.thread.QueuedThreadPool;
 import org.eclipse.jetty.util.thread.ScheduledExecutorScheduler;
@@ -137,6 +138,7 @@ public class HttpClient extends ContainerLifeCycle
     private boolean useOutputDirectByteBuffers = true;
     private int maxResponseHeadersSize = -1;
     private Sweeper destinationSweeper;
+    private List<Compression> compressions;
 
     /**
      * Creates a HttpClient instance that can perform HTTP/1.1 requests to non-TLS and TLS destinations.
@@ -214,6 +216,16 @@ public class HttpClient extends ContainerLifeCycle
         handlers.put(new UpgradeProtocolHandler());
 
         decoderFactories.put(new GZIPContentDecoder.Factory(byteBufferPool));
+        if (compressions == null)
+        {
+            // Content codings such as "br" or "zstd" may be provided as services.
+            compressions = Compression.getProvidedCompressions();
+            compressions.forEach(this::installBean);
+        }
+        for (Compression compression : compressions)
+        {
+            decoderFactories.put(new CompressionContentDecoder.Factory(compression, byteBufferPool));
+        }
 
         if (cookieStore == null)
             cookieStore = new HttpCookieStore.Default();
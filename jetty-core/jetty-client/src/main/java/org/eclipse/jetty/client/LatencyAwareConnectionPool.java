@@ -0,0 +1,391 @@
+//
+// ========================================================================
+// Copyright (c) 1995 Mort Bay Consulting Pty Ltd and others.
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License v. 2.0 which is available at
+// https://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+// ========================================================================
+//
+
+package org.eclipse.jetty.client;
+
+import java.io.IOException;
+import java.util.List;
+import java.util.Map;
+import java.util.concurrent.ConcurrentHashMap;
+import java.util.concurrent.TimeUnit;
+import java.util.concurrent.atomic.AtomicInteger;
+import java.util.concurrent.atomic.AtomicReference;
+
+import org.eclipse.jetty.util.ConcurrentPool;
+import org.eclipse.jetty.util.NanoTime;
+import org.eclipse.jetty.util.Pool;
+import org.eclipse.jetty.util.annotation.ManagedAttribute;
+import org.eclipse.jetty.util.annotation.ManagedObject;
+import org.eclipse.jetty.util.component.Dumpable;
+import org.eclipse.jetty.util.component.DumpableCollection;
+import org.eclipse.jetty.util.thread.AutoLock;
+import org.slf4j.Logger;
+import org.slf4j.LoggerFactory;
+
+/**
+ * <p>A multiplexed {@link ConnectionPool} that provides the connection
+ * with the least outstanding requests, weighted by response latency.</p>
+ * <p>Each connection tracks the number of outstanding requests and a
+ * peak exponentially weighted moving average (EWMA) of the response latency,
+ * derived from the time requests spend outstanding on that connection.
+ * The cost of a connection is its latency multiplied by its outstanding
+ * requests plus one; when a connection is acquired, two connections are
+ * picked at random and the one with the lower cost is provided
+ * (the <em>power of two choices</em> algorithm).</p>
+ * <p>Connections are opened ahead of demand, one at a time, until
+ * {@link #getMaxConnectionCount() the max number of connections} is reached,
+ * so that the cost comparison always has candidates to choose from.</p>
+ * <p>A connection whose latency exceeds the average latency of the other
+ * connections by more than {@link #getRetireRatio() the retire ratio} is
+ * retired: it is not provided anymore unless no other connection is available,
+ * and it is removed from the pool when its outstanding requests complete,
+ * so that it can be replaced by a new connection.
+ * At most one connection is retiring at any time, so that connections
+ * are replaced gradually.</p>
+ * <p>This class is typically used with multiplexed protocols such as
+ * HTTP/2 and HTTP/3.</p>
+ *
+ * @see RandomConnectionPool
+ */
+@ManagedObject
+public class LatencyAwareConnectionPool extends MultiplexConnectionPool
+{
+    private static final Logger LOG = LoggerFactory.getLogger(LatencyAwareConnectionPool.class);
+
+    private final Map<Connection, Stats> stats = new ConcurrentHashMap<>();
+    private final AtomicReference<Stats> retiring = new AtomicReference<>();
+    private volatile long decayNanos = TimeUnit.SECONDS.toNanos(10);
+    private volatile double retireRatio = 4.0D;
+    private volatile int minSamples = 32;
+    private volatile boolean preWarm = true;
+
+    public LatencyAwareConnectionPool(Destination destination, int maxConnections)
+    {
+        this(destination, maxConnections, 1);
+    }
+
+    public LatencyAwareConnectionPool(Destination destination, int maxConnections, int initialMaxMultiplex)
+    {
+        super(destination, () -> new ConcurrentPool<>(ConcurrentPool.StrategyType.RANDOM, maxConnections, newMaxMultiplexer(initialMaxMultiplex)), initialMaxMultiplex);
+        // Connections are opened ahead of demand and
+        // retired connections must be replaced, so
+        // aggressively try to open new connections.
+        setMaximizeConnections(true);
+    }
+
+    /**
+     * @return the time, in milliseconds, over which past latency samples decay
+     */
+    @ManagedAttribute("The time in ms over which past latency samples decay")
+    public long getDecayTime()
+    {
+        return TimeUnit.NANOSECONDS.toMillis(decayNanos);
+    }
+
+    /**
+     * @param decayTime the time, in milliseconds, over which past latency samples decay
+     */
+    public void setDecayTime(long decayTime)
+    {
+        if (decayTime <= 0)
+            throw new IllegalArgumentException("Invalid decay time " + decayTime);
+        this.decayNanos = TimeUnit.MILLISECONDS.toNanos(decayTime);
+    }
+
+    /**
+     * @return the ratio between the latency of a connection and the average
+     * latency of the other connections above which the connection is retired,
+     * or a non-positive value if connections are never retired
+     */
+    @ManagedAttribute("The latency ratio above which a connection is retired")
+    public double getRetireRatio()
+    {
+        return retireRatio;
+    }
+
+    /**
+     * @param retireRatio the ratio between the latency of a connection and the average
+     * latency of the other connections above which the connection is retired,
+     * or a non-positive value to never retire connections
+     */
+    public void setRetireRatio(double retireRatio)
+    {
+        this.retireRatio = retireRatio;
+    }
+
+    /**
+     * @return the min number of latency samples a connection must have
+     * before it is considered for retirement
+     */
+    @ManagedAttribute("The min number of latency samples before a connection is considered for retirement")
+    public int getMinSamples()
+    {
+        return minSamples;
+    }
+
+    /**
+     * @param minSamples the min number of latency samples a connection must have
+     * before it is considered for retirement
+     */
+    public void setMinSamples(int minSamples)
+    {
+        this.minSamples = minSamples;
+    }
+
+    /**
+     * @return whether connections are opened ahead of demand up to the max number of connections
+     */
+    @ManagedAttribute("Whether connections are opened ahead of demand")
+    public boolean isPreWarm()
+    {
+        return preWarm;
+    }
+
+    /**
+     * @param preWarm whether connections are opened ahead of demand up to the max number of connections
+     */
+    public void setPreWarm(boolean preWarm)
+    {
+        this.preWarm = preWarm;
+    }
+
+    @ManagedAttribute("The number of connections being retired")
+    public int getRetiringConnectionCount()
+    {
+        return retiring.get() == null ? 0 : 1;
+    }
+
+    @Override
+    public Connection acquire(boolean create)
+    {
+        Connection connection = super.acquire(create);
+        if (connection != null && isPreWarm() && getPendingConnectionCount() == 0 && getConnectionCount() < getMaxConnectionCount())
+            tryCreate(false);
+        return connection;
+    }
+
+    @Override
+    protected Pool.Entry<Connection> acquireEntry(Pool<Connection> pool)
+    {
+        if (pool instanceof ConcurrentPool<Connection> concurrentPool)
+            return concurrentPool.acquire(this::cost);
+        return super.acquireEntry(pool);
+    }
+
+    @Override
+    protected Connection activate()
+    {
+        Connection connection = super.activate();
+        if (connection != null)
+        {
+            Stats stats = this.stats.get(connection);
+            if (stats != null)
+                stats.onAcquired(NanoTime.now());
+        }
+        return connection;
+    }
+
+    @Override
+    public boolean release(Connection connection)
+    {
+        Stats stats = this.stats.get(connection);
+        if (stats != null)
+        {
+            stats.onReleased(NanoTime.now(), decayNanos);
+            if (stats != retiring.get())
+                maybeRetire(stats);
+        }
+        return super.release(connection);
+    }
+
+    @Override
+    protected boolean deactivate(Connection connection)
+    {
+        Stats stats = this.stats.get(connection);
+        if (stats != null && stats == retiring.get() && stats.getOutstanding() == 0)
+        {
+            if (LOG.isDebugEnabled())
+                LOG.debug("Removing retired {} from {}", stats, this);
+            // Removing the entry makes it unacquirable.
+            // If it was acquired again after its outstanding requests
+            // completed, the removal fails and the connection stays open
+            // for that request, and it is removed when that request is released.
+            return !remove(connection);
+        }
+        return super.deactivate(connection);
+    }
+
+    @Override
+    protected void onCreated(Connection connection)
+    {
+        stats.put(connection, new Stats(connection));
+        super.onCreated(connection);
+    }
+
+    @Override
+    protected void onRemoved(Connection connection)
+    {
+        Stats stats = this.stats.remove(connection);
+        if (stats != null)
+            retiring.compareAndSet(stats, null);
+        super.onRemoved(connection);
+    }
+
+    private long cost(Connection connection)
+    {
+        Stats stats = this.stats.get(connection);
+        if (stats == null)
+            return Long.MAX_VALUE;
+        if (stats == retiring.get())
+            return Long.MAX_VALUE;
+        return stats.cost();
+    }
+
+    private void maybeRetire(Stats candidate)
+    {
+        double retireRatio = getRetireRatio();
+        if (retireRatio <= 0)
+            return;
+        if (retiring.get() != null)
+            return;
+        int minSamples = getMinSamples();
+        if (candidate.getSamples() < minSamples)
+            return;
+
+        long total = 0;
+        int count = 0;
+        for (Stats stats : this.stats.values())
+        {
+            if (stats == candidate || stats.getSamples() < minSamples)
+                continue;
+            total += stats.getLatency();
+            ++count;
+        }
+        if (count == 0)
+            return;
+
+        double average = (double)total / count;
+        long latency = candidate.getLatency();
+        if (latency > retireRatio * average && retiring.compareAndSet(null, candidate))
+        {
+            if (LOG.isDebugEnabled())
+                LOG.debug("Retiring {}, average latency {} ns on {}", candidate, (long)average, this);
+        }
+    }
+
+    @Override
+    public void dump(Appendable out, String indent) throws IOException
+    {
+        Dumpable.dumpObjects(out, indent, this, new DumpableCollection("connections", List.copyOf(stats.values())));
+    }
+
+    /**
+     * <p>The statistics of a connection.</p>
+     * <p>The latency of a request is derived from the integral of the number
+     * of outstanding requests over time: at every completion, the integral
+     * accumulated since the previous completion is, by Little's law, a sample of
+     * the time a request spends outstanding on the connection.
+     * Samples feed a peak EWMA: a sample greater than the current latency
+     * replaces it immediately, while smaller samples are averaged with
+     * a weight that depends on the time elapsed since the previous sample.</p>
+     */
+    private class Stats
+    {
+        private final AutoLock lock = new AutoLock();
+        private final AtomicInteger outstanding = new AtomicInteger();
+        private final Connection connection;
+        private long lastNanoTime = NanoTime.now();
+        private long lastSampleNanoTime = lastNanoTime;
+        private long busyNanos;
+        private volatile long latency;
+        private volatile long samples;
+
+        private Stats(Connection connection)
+        {
+            this.connection = connection;
+        }
+
+        private void onAcquired(long now)
+        {
+            try (AutoLock ignored = lock.lock())
+            {
+                advance(now);
+                outstanding.incrementAndGet();
+            }
+        }
+
+        private void onReleased(long now, long decayNanos)
+        {
+            try (AutoLock ignored = lock.lock())
+            {
+                advance(now);
+                outstanding.decrementAndGet();
+                long sample = busyNanos;
+                busyNanos = 0;
+                long current = latency;
+                if (samples == 0 || sample >= current)
+                {
+                    latency = sample;
+                }
+                else
+                {
+                    double elapsed = NanoTime.elapsed(lastSampleNanoTime, now);
+                    double weight = Math.exp(-elapsed / decayNanos);
+                    latency = (long)(current * weight + sample * (1 - weight));
+                }
+                lastSampleNanoTime = now;
+                ++samples;
+            }
+        }
+
+        private void advance(long now)
+        {
+            busyNanos += outstanding.get() * NanoTime.elapsed(lastNanoTime, now);
+            lastNanoTime = now;
+        }
+
+        private long cost()
+        {
+            // Add one to the latency so that connections without
+            // samples are still ordered by outstanding requests.
+            return (latency + 1) * (outstanding.get() + 1);
+        }
+
+        private int getOutstanding()
+        {
+            return outstanding.get();
+        }
+
+        private long getLatency()
+        {
+            return latency;
+        }
+
+        private long getSamples()
+        {
+            return samples;
+        }
+
+        @Override
+        public String toString()
+        {
+            return String.format("%s@%x[outstanding=%d,latency=%dus,samples=%d,retiring=%b]",
+                connection.getClass().getSimpleName(),
+                connection.hashCode(),
+                outstanding.get(),
+                TimeUnit.NANOSECONDS.toMicros(latency),
+                samples,
+                this == retiring.get());
+        }
+    }
+}
@@ -75,10 +75,11 @@ public class ConnectionPoolTest
         return pool;
     });
     private static final ConnectionPoolFactory ROUND_ROBIN = new ConnectionPoolFactory("round-robin", destination -> new RoundRobinConnectionPool(destination, destination.getHttpClient().getMaxConnectionsPerDestination()));
+    private static final ConnectionPoolFactory LATENCY_AWARE = new ConnectionPoolFactory("latency-aware", destination -> new LatencyAwareConnectionPool(destination, destination.getHttpClient().getMaxConnectionsPerDestination()));
 
     public static Stream<ConnectionPoolFactory> pools()
     {
-        return Stream.of(DUPLEX, MULTIPLEX, RANDOM, DUPLEX_MAX_DURATION, ROUND_ROBIN);
+        return Stream.of(DUPLEX, MULTIPLEX, RANDOM, DUPLEX_MAX_DURATION, ROUND_ROBIN, LATENCY_AWARE);
     }
 
     public static Stream<ConnectionPoolFactory> poolsNoRoundRobin()
@@ -703,6 +704,62 @@ public class ConnectionPoolTest
         assertThat(connectionPool.toString(), not(nullValue()));
     }
 
+    @Test
+    public void testLatencyAwareRetiresSlowConnection() throws Exception
+    {
+        int maxConnections = 3;
+        AtomicInteger slowPort = new AtomicInteger();
+        List<Integer> remotePorts = new CopyOnWriteArrayList<>();
+        startServer(new EmptyServerHandler()
+        {
+            @Override
+            protected void service(org.eclipse.jetty.server.Request request, Response response) throws Exception
+            {
+                int port = org.eclipse.jetty.server.Request.getRemotePort(request);
+                remotePorts.add(port);
+                // The first connection is slow.
+                slowPort.compareAndSet(0, port);
+                if (port == slowPort.get())
+                    Thread.sleep(100);
+            }
+        });
+        startClient(destination ->
+        {
+            LatencyAwareConnectionPool connectionPool = new LatencyAwareConnectionPool(destination, maxConnections);
+            connectionPool.setMinSamples(2);
+            return connectionPool;
+        });
+
+        // Send concurrent requests so that all connections are used,
+        // until the slow connection is retired and replaced.
+        for (int i = 0; i < 20 && remotePorts.stream().distinct().count() <= maxConnections; ++i)
+        {
+            sendConcurrently(maxConnections);
+        }
+        assertThat(remotePorts.stream().distinct().count(), greaterThan((long)maxConnections));
+
+        // The slow connection is not used anymore.
+        remotePorts.clear();
+        sendConcurrently(maxConnections);
+        assertThat(remotePorts, not(Matchers.hasItem(slowPort.get())));
+    }
+
+    private void sendConcurrently(int count) throws Exception
+    {
+        CountDownLatch latch = new CountDownLatch(count);
+        for (int i = 0; i < count; ++i)
+        {
+            client.newRequest("localhost", connector.getLocalPort())
+                .timeout(5, TimeUnit.SECONDS)
+                .send(result ->
+                {
+                    if (result.isSucceeded())
+                        latch.countDown();
+                });
+        }
+        assertTrue(latch.await(10, TimeUnit.SECONDS));
+    }
+
     private static class ConnectionPoolFactory
     {
         private final String name;
@@ -18,12 +18,17 @@ import java.util.ArrayList;
 import java.util.Collection;
 import java.util.Collections;
 import java.util.HashMap;
+import java.util.HashSet;
 import java.util.Iterator;
+import java.util.LinkedHashMap;
 import java.util.List;
 import java.util.Map;
 import java.util.Objects;
 import java.util.Queue;
+import java.util.Set;
 import java.util.concurrent.ConcurrentLinkedQueue;
+import java.util.concurrent.Executor;
+import java.util.concurrent.RejectedExecutionException;
 
 import org.eclipse.jetty.deploy.bindings.StandardDeployer;
 import org.eclipse.jetty.deploy.bindings.StandardStarter;
@@ -36,6 +41,9 @@ import org.eclipse.jetty.server.Deployable;
 import org.eclipse.jetty.server.Server;
 import org.eclipse.jetty.server.handler.ContextHandlerCollection;
 import org.eclipse.jetty.util.ExceptionUtil;
+import org.eclipse.jetty.util.FileID;
+import org.eclipse.jetty.util.StringUtil;
+import org.eclipse.jetty.util.TopologicalSort;
 import org.eclipse.jetty.util.annotation.ManagedAttribute;
 import org.eclipse.jetty.util.annotation.ManagedObject;
 import org.eclipse.jetty.util.annotation.ManagedOperation;
@@ -58,6 +66,12 @@ import org.slf4j.LoggerFactory;
  * <li>Executing AppLifeCycle on App based on current and desired LifeCycle Location.</li>
  * </ol>
  * <p>
+ * The apps found by the providers while the deployment manager starts are moved to the
+ * default lifecycle goal once all the providers have started, in the order of the
+ * dependencies declared by their {@link Deployable#DEPENDS_ON} property, which is a comma
+ * separated list of app ids. Up to {@link #getStartupParallelism()} independent apps are
+ * deployed concurrently.
+ * <p>
  * <img alt="deployment manager graph" src="doc-files/DeploymentManager.png">
  */
 @ManagedObject("Deployment Manager")
@@ -127,6 +141,8 @@ public class DeploymentManager extends ContainerLifeCycle
     private ContextHandlerCollection _contexts;
     private boolean _useStandardBindings = true;
     private String _defaultLifeCycleGoal = AppLifeCycle.STARTED;
+    private int _startupParallelism = 1;
+    private List<AppEntry> _startupApps;
 
     /**
      * Get the default {@link Environment} name for deployed applications, which is
@@ -158,11 +174,42 @@ public class DeploymentManager extends ContainerLifeCycle
 
         if (isRunning() && _defaultLifeCycleGoal != null)
         {
+            // Defer apps found while starting, so they can be deployed in dependency order
+            try (AutoLock l = _lock.lock())
+            {
+                if (_startupApps != null)
+                {
+                    _startupApps.add(entry);
+                    return;
+                }
+            }
+
             // Immediately attempt to go to default lifecycle state
             this.requestAppGoal(entry, _defaultLifeCycleGoal);
         }
     }
 
+    /**
+     * @return the maximum number of apps deployed concurrently while starting
+     */
+    @ManagedAttribute("The maximum number of apps deployed concurrently while starting")
+    public int getStartupParallelism()
+    {
+        return _startupParallelism;
+    }
+
+    /**
+     * Set the maximum number of apps deployed concurrently while starting.
+     * Apps are only deployed concurrently with the apps they do not depend on,
+     * as declared by their {@link Deployable#DEPENDS_ON} property.
+     *
+     * @param startupParallelism the maximum number of concurrent deployments, or 1 to deploy apps one at a time
+     */
+    public void setStartupParallelism(int startupParallelism)
+    {
+        _startupParallelism = Math.max(1, startupParallelism);
+    }
+
     /**
      * Set the AppProviders.
      * The providers passed are added via {@link #addBean(Object)} so that
@@ -257,12 +304,31 @@ public class DeploymentManager extends ContainerLifeCycle
             addLifeCycleBinding(new StandardUndeployer());
         }
 
-        // Start all of the AppProviders
-        for (AppProvider provider : _providers)
+        try (AutoLock l = _lock.lock())
+        {
+            _startupApps = new ArrayList<>();
+        }
+
+        List<AppEntry> startupApps;
+        try
+        {
+            // Start all of the AppProviders
+            for (AppProvider provider : _providers)
+            {
+                startAppProvider(provider);
+            }
+        }
+        finally
         {
-            startAppProvider(provider);
+            try (AutoLock l = _lock.lock())
+            {
+                startupApps = _startupApps;
+                _startupApps = null;
+            }
         }
 
+        deployStartupApps(startupApps);
+
         try (AutoLock l = _lock.lock())
         {
             ExceptionUtil.ifExceptionThrow(_onStartupErrors);
@@ -548,6 +614,140 @@ public class DeploymentManager extends ContainerLifeCycle
         }
     }
 
+    /**
+     * Move the apps found while starting to the default lifecycle goal, in dependency order
+     * and with up to {@link #getStartupParallelism()} concurrent deployments.
+     *
+     * @param apps the apps found while starting
+     * @throws InterruptedException if interrupted while waiting for concurrent deployments
+     */
+    private void deployStartupApps(List<AppEntry> apps) throws InterruptedException
+    {
+        if (apps.isEmpty())
+            return;
+
+        Map<AppEntry, Set<AppEntry>> dependencies = new LinkedHashMap<>();
+        TopologicalSort<AppEntry> sort = new TopologicalSort<>();
+        for (AppEntry entry : apps)
+        {
+            Set<AppEntry> dependsOn = new HashSet<>();
+            String[] appIds = StringUtil.csvSplit(entry.app.getProperties().get(Deployable.DEPENDS_ON));
+            for (String appId : appIds == null ? new String[0] : appIds)
+            {
+                AppEntry dependency = apps.stream().filter(e -> e != entry && isAppId(e, appId)).findFirst().orElse(null);
+                if (dependency == null)
+                {
+                    LOG.warn("Unknown dependency {} of {}", appId, entry.app);
+                    continue;
+                }
+                dependsOn.add(dependency);
+                sort.addDependency(entry, dependency);
+            }
+            dependencies.put(entry, dependsOn);
+        }
+        // Throws IllegalStateException for cyclic dependencies.
+        sort.sort(apps);
+
+        Executor executor = getServer() == null ? null : getServer().getThreadPool();
+        if (_startupParallelism <= 1 || apps.size() == 1 || executor == null)
+        {
+            Set<AppEntry> failed = new HashSet<>();
+            for (AppEntry entry : apps)
+            {
+                if (!deployAfter(entry, dependencies.get(entry), failed))
+                    failed.add(entry);
+            }
+            return;
+        }
+
+        if (LOG.isDebugEnabled())
+            LOG.debug("Deploying {} apps with parallelism {}", apps.size(), _startupParallelism);
+
+        AutoLock.WithCondition lock = new AutoLock.WithCondition();
+        Set<AppEntry> deployed = new HashSet<>();
+        Set<AppEntry> failed = new HashSet<>();
+        List<AppEntry> waiting = new ArrayList<>(apps);
+        int deploying = 0;
+        try (AutoLock.WithCondition l = lock.lock())
+        {
+            while (!waiting.isEmpty() || deploying > 0)
+            {
+                for (Iterator<AppEntry> i = waiting.iterator(); i.hasNext() && deploying < _startupParallelism; )
+                {
+                    AppEntry entry = i.next();
+                    if (!deployed.containsAll(dependencies.get(entry)))
+                        continue;
+                    i.remove();
+                    deploying++;
+                    // The failed set is only modified with the lock held,
+                    // and all the dependencies of the entry are done.
+                    Set<AppEntry> failedDependencies = new HashSet<>(failed);
+                    Runnable task = () ->
+                    {
+                        boolean success = false;
+                        try
+                        {
+                            success = deployAfter(entry, dependencies.get(entry), failedDependencies);
+                        }
+                        finally
+                        {
+                            try (AutoLock.WithCondition ll = lock.lock())
+                            {
+                                if (!success)
+                                    failed.add(entry);
+                                deployed.add(entry);
+                                ll.signalAll();
+                            }
+                        }
+                    };
+                    try
+                    {
+                        executor.execute(task);
+                    }
+                    catch (RejectedExecutionException x)
+                    {
+                        if (LOG.isDebugEnabled())
+                            LOG.debug("Deploying {} in the starting thread", entry.app, x);
+                        task.run();
+                    }
+                }
+                deploying = apps.size() - waiting.size() - deployed.size();
+                if (deploying > 0)
+                    l.await();
+            }
+        }
+    }
+
+    /**
+     * Move an app found while starting to the default lifecycle goal, unless one of its dependencies failed.
+     *
+     * @param entry the app to deploy
+     * @param dependencies the apps the app depends on, all already deployed or failed
+     * @param failed the apps that failed to deploy
+     * @return whether the app reached the default lifecycle goal
+     */
+    private boolean deployAfter(AppEntry entry, Set<AppEntry> dependencies, Set<AppEntry> failed)
+    {
+        for (AppEntry dependency : dependencies)
+        {
+            if (failed.contains(dependency))
+            {
+                LOG.warn("Not deploying {}, its dependency {} failed", entry.app, dependency.app);
+                return false;
+            }
+        }
+        requestAppGoal(entry, _defaultLifeCycleGoal);
+        Node node = entry.getLifecyleNode();
+        return node == null || !AppLifeCycle.FAILED.equals(node.getName());
+    }
+
+    private static boolean isAppId(AppEntry entry, String appId)
+    {
+        Path path = entry.app.getPath();
+        String name = path.getName(path.getNameCount() - 1).toString();
+        return appId.equals(name) || appId.equals(FileID.getBasename(path));
+    }
+
     private void addOnStartupError(Throwable cause)
     {
         try (AutoLock l = _lock.lock())
@@ -15,10 +15,15 @@ package org.eclipse.jetty.deploy;
 
 import java.nio.file.Path;
 import java.util.Collection;
+import java.util.List;
 import java.util.Set;
+import java.util.concurrent.CopyOnWriteArrayList;
 
+import org.eclipse.jetty.deploy.graph.Node;
 import org.eclipse.jetty.deploy.test.XmlConfiguredJetty;
+import org.eclipse.jetty.logging.StacklessLogging;
 import org.eclipse.jetty.server.Deployable;
+import org.eclipse.jetty.server.Server;
 import org.eclipse.jetty.server.handler.ContextHandlerCollection;
 import org.eclipse.jetty.toolchain.test.jupiter.WorkDir;
 import org.eclipse.jetty.toolchain.test.jupiter.WorkDirExtension;
@@ -26,13 +31,18 @@ import org.eclipse.jetty.util.component.Environment;
 import org.hamcrest.Matchers;
 import org.junit.jupiter.api.Test;
 import org.junit.jupiter.api.extension.ExtendWith;
+import org.junit.jupiter.params.ParameterizedTest;
+import org.junit.jupiter.params.provider.ValueSource;
 
 import static org.hamcrest.MatcherAssert.assertThat;
 import static org.hamcrest.Matchers.contains;
+import static org.hamcrest.Matchers.containsInAnyOrder;
 import static org.hamcrest.Matchers.endsWith;
+import static org.hamcrest.Matchers.greaterThan;
 import static org.hamcrest.Matchers.is;
 import static org.junit.jupiter.api.Assertions.assertEquals;
 import static org.junit.jupiter.api.Assertions.assertNotNull;
+import static org.junit.jupiter.api.Assertions.assertThrows;
 
 @ExtendWith(WorkDirExtension.class)
 public class DeploymentManagerTest
@@ -69,6 +79,102 @@ public class DeploymentManagerTest
         assertThat(actual.getPath().toString(), endsWith("mock-foo-webapp-1.war"));
     }
 
+    /**
+     * @param parallelism the startup parallelism of the DeploymentManager
+     * @param events the list where the deploying and deployed events are recorded
+     * @param failingApp the name of the app that fails to deploy, or null
+     * @param apps the apps added at startup, as {@code name} or {@code name:dependsOn}
+     * @return a server with a DeploymentManager that deploys the given apps when started
+     */
+    private static Server newStartupServer(int parallelism, List<String> events, String failingApp, String... apps)
+    {
+        Server server = new Server();
+        ContextHandlerCollection contexts = new ContextHandlerCollection();
+        server.setHandler(contexts);
+        DeploymentManager depman = new DeploymentManager();
+        depman.setContexts(contexts);
+        depman.setUseStandardBindings(false);
+        depman.setStartupParallelism(parallelism);
+        server.addBean(depman);
+
+        depman.addLifeCycleBinding(new AppLifeCycle.Binding()
+        {
+            @Override
+            public String[] getBindingTargets()
+            {
+                return new String[]{AppLifeCycle.DEPLOYING, AppLifeCycle.DEPLOYED};
+            }
+
+            @Override
+            public void processBinding(Node node, App app)
+            {
+                events.add(node.getName() + " " + app.getPath().getFileName());
+                if (app.getPath().getFileName().toString().equals(failingApp))
+                    throw new IllegalStateException("Test failure of " + failingApp);
+            }
+        });
+        depman.addAppProvider(new MockAppProvider()
+        {
+            @Override
+            public void doStart()
+            {
+                super.doStart();
+                for (String spec : apps)
+                {
+                    String[] parts = spec.split(":", 2);
+                    App app = new App(depman, this, Path.of(parts[0]));
+                    if (parts.length > 1)
+                        app.getProperties().put(Deployable.DEPENDS_ON, parts[1]);
+                    depman.addApp(app);
+                }
+            }
+        });
+        return server;
+    }
+
+    @Test
+    public void testStartupAppsDeployedInDependencyOrder() throws Exception
+    {
+        List<String> events = new CopyOnWriteArrayList<>();
+        Server server = newStartupServer(3, events, null, "mock-a:mock-c", "mock-b", "mock-c:mock-b");
+
+        try
+        {
+            server.start();
+
+            assertThat(events, containsInAnyOrder(
+                "deploying mock-a", "deployed mock-a",
+                "deploying mock-b", "deployed mock-b",
+                "deploying mock-c", "deployed mock-c"));
+            assertThat(events.indexOf("deploying mock-c"), greaterThan(events.indexOf("deployed mock-b")));
+            assertThat(events.indexOf("deploying mock-a"), greaterThan(events.indexOf("deployed mock-c")));
+        }
+        finally
+        {
+            server.stop();
+        }
+    }
+
+    @ParameterizedTest
+    @ValueSource(ints = {1, 3})
+    public void testStartupAppsNotDeployedAfterFailedDependency(int parallelism) throws Exception
+    {
+        List<String> events = new CopyOnWriteArrayList<>();
+        Server server = newStartupServer(parallelism, events, "mock-b", "mock-a:mock-c", "mock-b", "mock-c:mock-b", "mock-d");
+
+        try (StacklessLogging ignored = new StacklessLogging(DeploymentManager.class))
+        {
+            assertThrows(Exception.class, server::start);
+
+            // The direct and indirect dependents of the failed app are not deployed.
+            assertThat(events, containsInAnyOrder("deploying mock-b", "deploying mock-d", "deployed mock-d"));
+        }
+        finally
+        {
+            server.stop();
+        }
+    }
+
     @Test
     public void testBinding()
     {
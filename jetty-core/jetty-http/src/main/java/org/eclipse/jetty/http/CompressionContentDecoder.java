@@ -0,0 +1,186 @@
+//
+// ========================================================================
+// Copyright (c) 1995 Mort Bay Consulting Pty Ltd and others.
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License v. 2.0 which is available at
+// https://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+// ========================================================================
+//
+
+package org.eclipse.jetty.http;
+
+import java.io.IOException;
+import java.nio.ByteBuffer;
+import java.util.ArrayList;
+import java.util.List;
+
+import org.eclipse.jetty.io.ByteBufferPool;
+import org.eclipse.jetty.io.RetainableByteBuffer;
+import org.eclipse.jetty.util.BufferUtil;
+import org.eclipse.jetty.util.component.Destroyable;
+import org.eclipse.jetty.util.compression.Compression;
+
+/**
+ * <p>Decoder for any content encoding provided by a {@link Compression}.</p>
+ * <p>This decoder has the same usage as {@link GZIPContentDecoder}, but
+ * delegates the decoding to a {@link Compression.Decoder}.</p>
+ */
+public class CompressionContentDecoder implements Destroyable
+{
+    private final List<RetainableByteBuffer> _decodeds = new ArrayList<>();
+    private final ByteBufferPool _pool;
+    private final int _bufferSize;
+    private Compression.Decoder _decoder;
+    private RetainableByteBuffer _decoded;
+
+    public CompressionContentDecoder(Compression compression, ByteBufferPool byteBufferPool, int bufferSize)
+    {
+        _decoder = compression.newDecoder();
+        _bufferSize = bufferSize;
+        _pool = byteBufferPool != null ? byteBufferPool : new ByteBufferPool.NonPooling();
+    }
+
+    /**
+     * <p>Decodes compressed data from a buffer.</p>
+     * <p>The {@link RetainableByteBuffer} returned by this method
+     * <b>must</b> be released via {@link RetainableByteBuffer#release()}.</p>
+     *
+     * @param compressed the buffer containing compressed data.
+     * @return a buffer containing decoded data.
+     * @see GZIPContentDecoder#decode(ByteBuffer)
+     */
+    public RetainableByteBuffer decode(ByteBuffer compressed)
+    {
+        decodeChunks(compressed);
+
+        if (_decodeds.isEmpty())
+        {
+            if (_decoded == null || !_decoded.hasRemaining())
+                return acquire(0);
+            RetainableByteBuffer result = _decoded;
+            _decoded = null;
+            return result;
+        }
+        else
+        {
+            _decodeds.add(_decoded);
+            _decoded = null;
+            int length = _decodeds.stream().mapToInt(RetainableByteBuffer::remaining).sum();
+            RetainableByteBuffer result = acquire(length);
+            for (RetainableByteBuffer buffer : _decodeds)
+            {
+                BufferUtil.append(result.getByteBuffer(), buffer.getByteBuffer());
+                buffer.release();
+            }
+            _decodeds.clear();
+            return result;
+        }
+    }
+
+    /**
+     * <p>Called when a chunk of data is decoded.</p>
+     *
+     * @param chunk the decoded chunk of data
+     * @return false if decoding should continue, or true if the call
+     * to {@link #decodeChunks(ByteBuffer)} or {@link #decode(ByteBuffer)}
+     * should return, allowing to consume the decoded chunk and apply
+     * backpressure
+     * @see GZIPContentDecoder#decodedChunk(RetainableByteBuffer)
+     */
+    protected boolean decodedChunk(RetainableByteBuffer chunk)
+    {
+        // Retain the chunk because it is stored for later use.
+        chunk.retain();
+        if (_decoded != null)
+            _decodeds.add(_decoded);
+        _decoded = chunk;
+        return false;
+    }
+
+    /**
+     * <p>Decodes compressed data.</p>
+     * <p>Decoding continues until the end of the encoded stream is reached, there is no
+     * more compressed data or a call to {@link #decodedChunk(RetainableByteBuffer)} returns true.
+     * Decoding fails if the decoder cannot make progress with the compressed data.</p>
+     *
+     * @param compressed the buffer of compressed data to decode
+     */
+    protected void decodeChunks(ByteBuffer compressed)
+    {
+        RetainableByteBuffer buffer = null;
+        try
+        {
+            // A finished decoder may accept more input, for example another gzip member.
+            while (!_decoder.isFinished() || compressed.hasRemaining() && _decoder.needsInput())
+            {
+                if (_decoder.needsInput())
+                {
+                    if (!compressed.hasRemaining())
+                        return;
+                    _decoder.setInput(compressed);
+                }
+
+                if (buffer == null)
+                    buffer = acquire(_bufferSize);
+
+                int remaining = compressed.remaining();
+                ByteBuffer decoded = buffer.getByteBuffer();
+                int pos = BufferUtil.flipToFill(decoded);
+                int produced = _decoder.decode(decoded);
+                BufferUtil.flipToFlush(decoded, pos);
+
+                // A decoder, possibly provided by a third party, that neither
+                // consumes nor produces bytes would otherwise loop forever.
+                if (produced == 0 && compressed.remaining() == remaining && !_decoder.needsInput() && !_decoder.isFinished())
+                    throw new IOException("Decoder made no progress");
+
+                if (buffer.hasRemaining())
+                {
+                    boolean stop = decodedChunk(buffer);
+                    buffer.release();
+                    buffer = null;
+                    if (stop)
+                        return;
+                }
+            }
+        }
+        catch (IOException x)
+        {
+            throw new RuntimeException(x);
+        }
+        finally
+        {
+            if (buffer != null)
+                buffer.release();
+        }
+    }
+
+    @Override
+    public void destroy()
+    {
+        if (_decoder != null)
+            _decoder.release();
+        _decoder = null;
+    }
+
+    public boolean isFinished()
+    {
+        return _decoder == null || _decoder.isFinished();
+    }
+
+    /**
+     * @param capacity capacity of the ByteBuffer to acquire
+     * @return a heap buffer of the configured capacity either from the pool or freshly allocated.
+     */
+    public RetainableByteBuffer acquire(int capacity)
+    {
+        // Zero-capacity buffers aren't released, they MUST NOT come from the pool.
+        if (capacity == 0)
+            return RetainableByteBuffer.EMPTY;
+        return _pool.acquire(capacity, false);
+    }
+}
@@ -550,7 +550,7 @@ public class HttpField
         return _name.equalsIgnoreCase(name);
     }
 
-    private int nameHashCode()
+    int nameHashCode()
     {
         int h = this._hash;
         int len = _name.length();
@@ -589,6 +589,17 @@ public class HttpGenerator
             int n = fields.size();
             for (int f = 0; f < n; f++)
             {
+                // Copy the encoding of a whole template of fields.
+                PreEncodedHttpFields template = PreEncodedHttpFields.getTemplate(fields, f);
+                if (template != null)
+                {
+                    template.putTo(header, HttpVersion.HTTP_1_0);
+                    if (template.contains(HttpHeader.CONTENT_TYPE))
+                        contentType = true;
+                    f += template.size() - 1;
+                    continue;
+                }
+
                 HttpField field = fields.getField(f);
                 HttpHeader h = field.getHeader();
                 if (h == null)
@@ -275,6 +275,8 @@ public class HttpParser
     private ByteBuffer _contentChunk;
     private int _length;
     private final StringBuilder _string = new StringBuilder();
+    private long _headerCacheHits;
+    private long _headerCacheMisses;
 
     private static HttpCompliance compliance()
     {
@@ -358,6 +360,23 @@ public class HttpParser
         _fieldCache.setCaseSensitive(headerCacheCaseSensitive);
     }
 
+    /**
+     * @return the number of header fields parsed by this parser that reused a cached {@link HttpField} instance,
+     * either from the static {@link #CACHE} or from the fields learned on this connection.
+     */
+    public long getHeaderCacheHits()
+    {
+        return _headerCacheHits;
+    }
+
+    /**
+     * @return the number of header fields parsed by this parser that required a new {@link HttpField} to be allocated.
+     */
+    public long getHeaderCacheMisses()
+    {
+        return _headerCacheMisses;
+    }
+
     protected void checkViolation(Violation violation) throws BadMessageException
     {
         if (violation.isAllowedBy(_complianceMode))
@@ -830,31 +849,30 @@ public class HttpParser
                             {
                                 _uri.reset();
                                 setState(State.URI);
-                                // quick scan for space or EoBuffer
+                                // quick scan, 8 bytes at a time, for space, other non-visible characters or EoBuffer
+                                int p = buffer.position();
+                                int i = StringUtil.indexOfNonVisibleAscii(buffer, p, buffer.limit());
+                                int len = i - p;
+                                _headerBytes += len;
+
+                                if (_maxHeaderBytes > 0 && ++_headerBytes > _maxHeaderBytes)
+                                {
+                                    LOG.warn("URI is too large >{}", _maxHeaderBytes);
+                                    throw new BadMessageException(HttpStatus.URI_TOO_LONG_414);
+                                }
                                 if (buffer.hasArray())
                                 {
-                                    byte[] array = buffer.array();
-                                    int p = buffer.arrayOffset() + buffer.position();
-                                    int l = buffer.arrayOffset() + buffer.limit();
-                                    int i = p;
-                                    while (i < l && array[i] > HttpTokens.SPACE)
-                                    {
-                                        i++;
-                                    }
-
-                                    int len = i - p;
-                                    _headerBytes += len;
-
-                                    if (_maxHeaderBytes > 0 && ++_headerBytes > _maxHeaderBytes)
-                                    {
-                                        LOG.warn("URI is too large >{}", _maxHeaderBytes);
-                                        throw new BadMessageException(HttpStatus.URI_TOO_LONG_414);
-                                    }
-                                    _uri.append(array, p - 1, len + 1);
-                                    buffer.position(i - buffer.arrayOffset());
+                                    _uri.append(buffer.array(), buffer.arrayOffset() + p - 1, len + 1);
                                 }
                                 else
+                                {
                                     _uri.append(t.getByte());
+                                    for (int j = p; j < i; j++)
+                                    {
+                                        _uri.append(buffer.get(j));
+                                    }
+                                }
+                                buffer.position(i);
                             }
                             break;
 
@@ -1069,11 +1087,27 @@ public class HttpParser
             throw new HttpException.RuntimeException(HttpStatus.HTTP_VERSION_NOT_SUPPORTED_505, "Unsupported Version");
     }
 
+    private static boolean matches(ByteBuffer buffer, int position, String value)
+    {
+        int length = value.length();
+        if (position + length > buffer.limit())
+            return false;
+        for (int i = 0; i < length; i++)
+        {
+            if ((buffer.get(position + i) & 0xFF) != value.charAt(i))
+                return false;
+        }
+        return true;
+    }
+
     private void parsedHeader()
     {
         // handler last header if any.  Delayed to here just in case there was a continuation line (above)
         if (_headerString != null || _valueString != null)
         {
+            HttpField cachedField = _field;
+            boolean learnField = false;
+
             // Handle known headers
             if (_header != null)
             {
@@ -1185,6 +1219,8 @@ public class HttpParser
                         break;
 
                     default:
+                        // Other known headers are only cached once they are seen repeating
+                        learnField = _field == null;
                         break;
                 }
 
@@ -1197,9 +1233,25 @@ public class HttpParser
                     _fieldCache.add(_field);
                 }
             }
+            else
+            {
+                // Unknown headers are only cached once they are seen repeating
+                learnField = _field == null && _headerString != null;
+            }
+
+            if (_field == null)
+                _field = new HttpField(_header, _headerString, _valueString);
+            if (learnField)
+                _fieldCache.learn(_field);
+
+            if (_field == cachedField)
+                _headerCacheHits++;
+            else
+                _headerCacheMisses++;
+
             if (LOG.isDebugEnabled())
                 LOG.debug("parsedHeader({}) header={}, headerString=[{}], valueString=[{}]", _field, _header, _headerString, _valueString);
-            _handler.parsedHeader(_field != null ? _field : new HttpField(_header, _headerString, _valueString));
+            _handler.parsedHeader(_field);
         }
 
         _headerString = _valueString = null;
@@ -1368,9 +1420,8 @@ public class HttpParser
                                 // Try a look ahead for the known header name and value in dynamic, then static cache.
                                 // Need to use an offset of -1 and to increase the remaining since we have already consumed
                                 // the first ALPHA/DIGIT/TCHAR byte to switch to this case.
-                                HttpField cachedField = _fieldCache.getBest(buffer, -1, buffer.remaining() + 1);
-                                if (cachedField == null)
-                                    cachedField = CACHE.getBest(buffer, -1, buffer.remaining() + 1);
+                                HttpField learnedField = _fieldCache.getBest(buffer, -1, buffer.remaining() + 1);
+                                HttpField cachedField = learnedField != null ? learnedField : CACHE.getBest(buffer, -1, buffer.remaining() + 1);
 
                                 if (cachedField != null)
                                 {
@@ -1389,7 +1440,9 @@ public class HttpParser
                                         }
                                     }
 
-                                    if (v != null && isHeaderCacheCaseSensitive())
+                                    // Learned fields are always matched exactly, as values such as tokens are case sensitive
+                                    if (v != null && (isHeaderCacheCaseSensitive() || learnedField != null) &&
+                                        !matches(buffer, buffer.position() + n.length() + 1, v))
                                     {
                                         String ev = BufferUtil.toString(buffer, buffer.position() + n.length() + 1, v.length(), StandardCharsets.ISO_8859_1);
                                         if (!v.equals(ev))
@@ -1421,6 +1474,8 @@ public class HttpParser
                                     {
                                         _field = cachedField;
                                         _valueString = v;
+                                        if (cachedField == learnedField)
+                                            _fieldCache.used(learnedField);
                                         buffer.position(posAfterValue + 1);
                                         if (peek == LINE_FEED)
                                         {
@@ -1494,7 +1549,7 @@ public class HttpParser
                         case DIGIT:
                         case TCHAR:
                             _string.append(t.getChar());
-                            _length = _string.length();
+                            scanFieldName(buffer);
                             break;
 
                         default:
@@ -1551,6 +1606,7 @@ public class HttpParser
                             _string.append(t.getChar());
                             _length = _string.length();
                             setState(FieldState.IN_VALUE);
+                            scanFieldValue(buffer);
                             break;
 
                         default:
@@ -1573,6 +1629,7 @@ public class HttpParser
                         case SPACE:
                         case HTAB:
                             _string.append(t.getChar());
+                            scanFieldValue(buffer);
                             break;
 
                         case ALPHA:
@@ -1583,6 +1640,7 @@ public class HttpParser
                         case OTEXT: // TODO review? should this be a utf8 string?
                             _string.append(t.getChar());
                             _length = _string.length();
+                            scanFieldValue(buffer);
                             break;
 
                         default:
@@ -1598,6 +1656,68 @@ public class HttpParser
         return false;
     }
 
+    /**
+     * <p>Appends to the field name the run of token characters that follows,
+     * without going through the state machine for each byte.</p>
+     *
+     * @param buffer the buffer to scan
+     */
+    private void scanFieldName(ByteBuffer buffer)
+    {
+        int position = buffer.position();
+        int end = scanLimit(buffer);
+        int i = position;
+        while (i < end)
+        {
+            HttpTokens.Token t = HttpTokens.TOKENS[0xFF & buffer.get(i)];
+            HttpTokens.Type type = t.getType();
+            if (type != HttpTokens.Type.ALPHA && type != HttpTokens.Type.DIGIT && type != HttpTokens.Type.TCHAR)
+                break;
+            _string.append(t.getChar());
+            i++;
+        }
+        _length = _string.length();
+        scanned(buffer, i);
+    }
+
+    /**
+     * <p>Appends to the field value the run of printable US-ASCII characters that follows,
+     * found 8 bytes at a time, without going through the state machine for each byte.</p>
+     * <p>The scan stops before CR, LF, HTAB, other control characters and obsolete text,
+     * which are then handled by the state machine.</p>
+     *
+     * @param buffer the buffer to scan
+     */
+    private void scanFieldValue(ByteBuffer buffer)
+    {
+        int position = buffer.position();
+        int end = StringUtil.indexOfNonPrintableAscii(buffer, position, scanLimit(buffer));
+        for (int i = position; i < end; i++)
+        {
+            char c = (char)buffer.get(i);
+            _string.append(c);
+            // Trailing whitespace is not part of the value.
+            if (c != ' ')
+                _length = _string.length();
+        }
+        scanned(buffer, end);
+    }
+
+    private int scanLimit(ByteBuffer buffer)
+    {
+        int limit = buffer.limit();
+        if (_maxHeaderBytes > 0)
+            limit = Math.min(limit, buffer.position() + Math.max(0, _maxHeaderBytes - _headerBytes));
+        return limit;
+    }
+
+    private void scanned(ByteBuffer buffer, int position)
+    {
+        if (_maxHeaderBytes > 0)
+            _headerBytes += position - buffer.position();
+        buffer.position(position);
+    }
+
     /**
      * Parse until next Event.
      *
@@ -2010,6 +2130,7 @@ public class HttpParser
         _headerBytes = 0;
         _parsedHost = null;
         _headerComplete = false;
+        _fieldCache.nextMessage();
     }
 
     public void servletUpgrade()
@@ -2168,12 +2289,25 @@ public class HttpParser
         }
     }
 
+    /**
+     * <p>A per-parser (and thus per-connection) cache of the {@link HttpField}s seen on previous messages.</p>
+     * <p>Fields of the well known headers that are typically repeated on a persistent connection are cached
+     * on first sight, while any other field is only cached once it has been seen twice, so that fields with
+     * per-message values do not pollute the cache.  When the cache is full it is rebuilt with only the fields
+     * that were used by the last two messages, so that the most recently used fields are retained.</p>
+     */
     private static class FieldCache
     {
+        private static final int CANDIDATES = 16;
+
         private int _size = 1024;
         private Index.Mutable<HttpField> _cache;
         private List<HttpField> _cacheableFields;
         private boolean _caseSensitive;
+        private HttpField[] _candidates;
+        private int _nextCandidate;
+        private List<HttpField> _used = new ArrayList<>();
+        private List<HttpField> _previouslyUsed = new ArrayList<>();
 
         public int getCapacity()
         {
@@ -2187,6 +2321,9 @@ public class HttpParser
                 _cache = NO_CACHE;
             else
                 _cache = null;
+            _candidates = null;
+            _used.clear();
+            _previouslyUsed.clear();
         }
 
         public boolean isCaseSensitive()
@@ -2225,9 +2362,73 @@ public class HttpParser
             }
             else if (!_cache.put(field))
             {
+                // The cache is full, so rebuild it with only the recently used fields
                 _cache.clear();
-                _cache.put(field);
+                if (!retain(_previouslyUsed) || !retain(_used) || !_cache.put(field))
+                {
+                    _cache.clear();
+                    _cache.put(field);
+                }
+            }
+        }
+
+        private boolean retain(List<HttpField> fields)
+        {
+            for (HttpField f : fields)
+            {
+                if (!_cache.put(f))
+                    return false;
+            }
+            return true;
+        }
+
+        /**
+         * <p>Adds the field to the cache if it is the second time it has been seen recently.</p>
+         * @param field the parsed field
+         */
+        public void learn(HttpField field)
+        {
+            if (!isEnabled() || !learnable(field.getValue()))
+                return;
+
+            if (_candidates == null)
+                _candidates = new HttpField[CANDIDATES];
+            for (int i = 0; i < _candidates.length; i++)
+            {
+                HttpField candidate = _candidates[i];
+                if (candidate != null &&
+                    field.getValue().equals(candidate.getValue()) &&
+                    (_caseSensitive ? field.getName().equals(candidate.getName()) : field.isSameName(candidate)))
+                {
+                    _candidates[i] = null;
+                    add(field);
+                    return;
+                }
             }
+            _candidates[_nextCandidate] = field;
+            _nextCandidate = (_nextCandidate + 1) % _candidates.length;
+        }
+
+        /**
+         * <p>Records that a cached field has been used by the current message.</p>
+         * @param field the cached field
+         */
+        public void used(HttpField field)
+        {
+            _used.add(field);
+        }
+
+        /**
+         * <p>Called at the start of each message to age the record of used fields.</p>
+         */
+        public void nextMessage()
+        {
+            if (_previouslyUsed.isEmpty() && _used.isEmpty())
+                return;
+            List<HttpField> used = _previouslyUsed;
+            _previouslyUsed = _used;
+            _used = used;
+            _used.clear();
         }
 
         public boolean cacheable(HttpHeader header, String valueString)
@@ -2235,6 +2436,20 @@ public class HttpParser
             return isEnabled() && header != null && valueString != null && valueString.length() <= _size;
         }
 
+        private boolean learnable(String valueString)
+        {
+            // Learned fields must be small relative to the cache and only contain characters the cache can index
+            if (valueString == null || valueString.length() > _size / 4)
+                return false;
+            for (int i = valueString.length(); i-- > 0; )
+            {
+                char c = valueString.charAt(i);
+                if (c < 0x20 || c > 0x7E)
+                    return false;
+            }
+            return true;
+        }
+
         private void prepare()
         {
             if (_cache == null && _cacheableFields != null)
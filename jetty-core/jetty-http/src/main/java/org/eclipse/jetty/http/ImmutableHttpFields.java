@@ -26,11 +26,27 @@ import java.util.stream.Stream;
  * single thread.
  *
  * <p>The cookie handling provided by this class is guided by the Servlet specification and RFC6265.
+ *
+ * <p>Lookups by name are linear for few fields, otherwise they use an index of the field names
+ * that is built on the first lookup.
  */
 class ImmutableHttpFields implements HttpFields
 {
+    private static final int INDEX_MIN_SIZE = 8;
+    private static final HttpHeader[] HEADERS = HttpHeader.values();
+    private static final int[] HEADER_HASHES = new int[HEADERS.length];
+
+    static
+    {
+        for (HttpHeader header : HEADERS)
+        {
+            HEADER_HASHES[header.ordinal()] = nameHash(header.asString());
+        }
+    }
+
     final HttpField[] _fields;
     final int _size;
+    private Index _index;
 
     /**
      * Initialize HttpFields from copy.
@@ -76,52 +92,109 @@ class ImmutableHttpFields implements HttpFields
         return isEqualTo((HttpFields)o);
     }
 
+    @Override
+    public boolean contains(HttpHeader header)
+    {
+        // default impl overridden for efficiency
+        return indexOf(header) >= 0;
+    }
+
+    @Override
+    public boolean contains(String name)
+    {
+        // default impl overridden for efficiency
+        return indexOf(name) >= 0;
+    }
+
     @Override
     public String get(String name)
     {
         // default impl overridden for efficiency
-        for (HttpField f : _fields)
-        {
-            if (f != null && f.is(name))
-                return f.getValue();
-        }
-        return null;
+        int i = indexOf(name);
+        return i < 0 ? null : _fields[i].getValue();
     }
 
     @Override
     public String get(HttpHeader header)
     {
         // default impl overridden for efficiency
-        for (HttpField f : _fields)
-        {
-            if (f != null && f.getHeader() == header)
-                return f.getValue();
-        }
-        return null;
+        int i = indexOf(header);
+        return i < 0 ? null : _fields[i].getValue();
     }
 
     @Override
     public HttpField getField(HttpHeader header)
     {
         // default impl overridden for efficiency
-        for (HttpField f : _fields)
-        {
-            if (f != null && f.getHeader() == header)
-                return f;
-        }
-        return null;
+        int i = indexOf(header);
+        return i < 0 ? null : _fields[i];
     }
 
     @Override
     public HttpField getField(String name)
     {
         // default impl overridden for efficiency
-        for (HttpField f : _fields)
+        int i = indexOf(name);
+        return i < 0 ? null : _fields[i];
+    }
+
+    private int indexOf(HttpHeader header)
+    {
+        if (header == null)
+            return -1;
+        if (_size < INDEX_MIN_SIZE)
         {
-            if (f != null && f.is(name))
-                return f;
+            for (int i = 0; i < _size; i++)
+            {
+                HttpField f = _fields[i];
+                if (f != null && f.getHeader() == header)
+                    return i;
+            }
+            return -1;
         }
-        return null;
+        return index().indexOf(_fields, header);
+    }
+
+    private int indexOf(String name)
+    {
+        if (name == null)
+            return -1;
+        if (_size < INDEX_MIN_SIZE)
+        {
+            for (int i = 0; i < _size; i++)
+            {
+                HttpField f = _fields[i];
+                if (f != null && f.is(name))
+                    return i;
+            }
+            return -1;
+        }
+        return index().indexOf(_fields, name);
+    }
+
+    private Index index()
+    {
+        // Racing threads build equivalent indexes, which are safely published by their final fields.
+        Index index = _index;
+        if (index == null)
+            _index = index = new Index(_fields, _size);
+        return index;
+    }
+
+    /**
+     * The same case-insensitive hash as {@link HttpField#nameHashCode()}.
+     */
+    private static int nameHash(String name)
+    {
+        int h = 0;
+        for (int i = 0; i < name.length(); i++)
+        {
+            char c = name.charAt(i);
+            if ((c >= 'a' && c <= 'z'))
+                c -= 0x20;
+            h = 31 * h + c;
+        }
+        return h;
     }
 
     @Override
@@ -147,7 +220,7 @@ class ImmutableHttpFields implements HttpFields
     @Override
     public Stream<HttpField> stream()
     {
-        return Arrays.stream(_fields).filter(Objects::nonNull);
+        return Arrays.stream(_fields, 0, _size).filter(Objects::nonNull);
     }
 
     @Override
@@ -156,6 +229,84 @@ class ImmutableHttpFields implements HttpFields
         return asString();
     }
 
+    /**
+     * <p>An open addressed index of the field names, with a bitmap of the known headers present.</p>
+     * <p>Fields are inserted in order with linear probing, so the first field found while
+     * probing for a name is the first field with that name.</p>
+     */
+    private static class Index
+    {
+        private final long[] _headers = new long[(HEADERS.length + 63) / 64];
+        private final int[] _hashes;
+        private final int[] _slots;
+        private final int _mask;
+
+        private Index(HttpField[] fields, int size)
+        {
+            int capacity = 4;
+            while (capacity < size * 2)
+            {
+                capacity <<= 1;
+            }
+            _hashes = new int[size];
+            _slots = new int[capacity];
+            _mask = capacity - 1;
+
+            for (int i = 0; i < size; i++)
+            {
+                HttpField field = fields[i];
+                if (field == null)
+                    continue;
+                HttpHeader header = field.getHeader();
+                if (header != null)
+                    _headers[header.ordinal() >> 6] |= 1L << header.ordinal();
+                int hash = field.nameHashCode();
+                _hashes[i] = hash;
+                int slot = spread(hash) & _mask;
+                while (_slots[slot] != 0)
+                {
+                    slot = (slot + 1) & _mask;
+                }
+                // Slots hold the field index + 1, so that 0 is an empty slot.
+                _slots[slot] = i + 1;
+            }
+        }
+
+        private int indexOf(HttpField[] fields, HttpHeader header)
+        {
+            int ordinal = header.ordinal();
+            if ((_headers[ordinal >> 6] & (1L << ordinal)) == 0)
+                return -1;
+            int hash = HEADER_HASHES[ordinal];
+            for (int slot = spread(hash) & _mask; ; slot = (slot + 1) & _mask)
+            {
+                int i = _slots[slot] - 1;
+                if (i < 0)
+                    return -1;
+                if (_hashes[i] == hash && fields[i].getHeader() == header)
+                    return i;
+            }
+        }
+
+        private int indexOf(HttpField[] fields, String name)
+        {
+            int hash = nameHash(name);
+            for (int slot = spread(hash) & _mask; ; slot = (slot + 1) & _mask)
+            {
+                int i = _slots[slot] - 1;
+                if (i < 0)
+                    return -1;
+                if (_hashes[i] == hash && fields[i].is(name))
+                    return i;
+            }
+        }
+
+        private static int spread(int hash)
+        {
+            return hash ^ (hash >>> 16);
+        }
+    }
+
     private class Listerator implements ListIterator<HttpField>
     {
         private int _index;
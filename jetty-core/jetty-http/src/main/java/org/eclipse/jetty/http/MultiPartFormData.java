@@ -15,8 +15,8 @@ package org.eclipse.jetty.http;
 
 import java.io.Closeable;
 import java.nio.ByteBuffer;
+import java.nio.channels.FileChannel;
 import java.nio.channels.NonWritableChannelException;
-import java.nio.channels.SeekableByteChannel;
 import java.nio.charset.Charset;
 import java.nio.file.Files;
 import java.nio.file.Path;
@@ -443,7 +443,7 @@ public class MultiPartFormData
             private long fileSize;
             private long memoryFileSize;
             private Path filePath;
-            private SeekableByteChannel fileChannel;
+            private FileChannel fileChannel;
             private Throwable failure;
 
             @Override
@@ -472,18 +472,25 @@ public class MultiPartFormData
                                 // Must save to disk.
                                 if (ensureFileChannel())
                                 {
-                                    // Write existing memory chunks.
+                                    // Write existing memory chunks and this chunk with one gathering write.
                                     List<Content.Chunk> partChunks;
                                     try (AutoLock ignored = lock.lock())
                                     {
                                         partChunks = List.copyOf(this.partChunks);
                                     }
-                                    for (Content.Chunk c : partChunks)
+                                    ByteBuffer[] buffers = new ByteBuffer[partChunks.size() + 1];
+                                    for (int i = 0; i < partChunks.size(); i++)
                                     {
-                                        write(c.getByteBuffer());
+                                        buffers[i] = partChunks.get(i).getByteBuffer();
                                     }
+                                    buffers[partChunks.size()] = buffer;
+                                    write(buffers);
+                                }
+                                else
+                                {
+                                    // Write the chunk directly from the parsed buffer.
+                                    write(buffer);
                                 }
-                                write(buffer);
                                 if (chunk.isLast())
                                     close();
                             }
@@ -509,15 +516,19 @@ public class MultiPartFormData
                 }
             }
 
-            private void write(ByteBuffer buffer) throws Exception
+            private void write(ByteBuffer... buffers) throws Exception
             {
-                int remaining = buffer.remaining();
+                long remaining = 0;
+                for (ByteBuffer buffer : buffers)
+                {
+                    remaining += buffer.remaining();
+                }
                 while (remaining > 0)
                 {
-                    SeekableByteChannel channel = fileChannel();
+                    FileChannel channel = fileChannel();
                     if (channel == null)
                         throw new IllegalStateException();
-                    int written = channel.write(buffer);
+                    long written = channel.write(buffers);
                     if (written == 0)
                         throw new NonWritableChannelException();
                     remaining -= written;
@@ -666,7 +677,7 @@ public class MultiPartFormData
                 delete();
             }
 
-            private SeekableByteChannel fileChannel()
+            private FileChannel fileChannel()
             {
                 try (AutoLock ignored = lock.lock())
                 {
@@ -723,7 +734,7 @@ public class MultiPartFormData
                     Files.createDirectories(directory);
                     String fileName = "MultiPart";
                     filePath = Files.createTempFile(directory, fileName, "");
-                    fileChannel = Files.newByteChannel(filePath, StandardOpenOption.WRITE, StandardOpenOption.APPEND);
+                    fileChannel = FileChannel.open(filePath, StandardOpenOption.WRITE, StandardOpenOption.APPEND);
                 }
                 catch (Throwable x)
                 {
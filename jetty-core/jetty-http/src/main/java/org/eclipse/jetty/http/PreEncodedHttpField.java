@@ -115,6 +115,15 @@ public class PreEncodedHttpField extends HttpField
         return _encodedFields.get(version).length;
     }
 
+    /**
+     * @param version the version of HTTP
+     * @return the encoded bytes of this field, or null if no encoder was found for the version
+     */
+    byte[] getEncodedField(HttpVersion version)
+    {
+        return _encodedFields.get(version);
+    }
+
     @Override
     public boolean contains(String search)
     {
@@ -0,0 +1,212 @@
+//
+// ========================================================================
+// Copyright (c) 1995 Mort Bay Consulting Pty Ltd and others.
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License v. 2.0 which is available at
+// https://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+// ========================================================================
+//
+
+package org.eclipse.jetty.http;
+
+import java.io.ByteArrayOutputStream;
+import java.nio.ByteBuffer;
+import java.util.Arrays;
+import java.util.EnumMap;
+import java.util.ListIterator;
+
+/**
+ * <p>A template of response fields that are pre-encoded as a whole.</p>
+ * <p>Responses often share most of their fields, for example {@code Server},
+ * {@code Content-Type}, {@code Cache-Control} and security policy fields.
+ * Such fields can be registered once as a {@link PreEncodedHttpFields}, that
+ * pre-encodes each field as a {@link PreEncodedHttpField}, and the whole
+ * template for each version of HTTP whose encoding does not depend on
+ * connection state:</p>
+ * <pre>{@code
+ * static final PreEncodedHttpFields API_FIELDS = new PreEncodedHttpFields(HttpFields.build()
+ *     .put(HttpHeader.CONTENT_TYPE, "application/json")
+ *     .put(HttpHeader.CACHE_CONTROL, "no-store"));
+ *
+ * // For each response.
+ * response.getHeaders().add(API_FIELDS).put(HttpHeader.ETAG, etag);
+ * }</pre>
+ * <p>While the fields of a template are present in order and unmodified in the fields of
+ * a response, they are generated with a single copy of the template encoding by
+ * {@link HttpGenerator} for HTTP/1 and by the QPACK encoder for HTTP/3.
+ * The HPACK encoder encodes each pre-encoded field, because HPACK encodings refer to the
+ * dynamic table of the connection.  If the fields of a response are modified, the remaining
+ * fields of the template are still generated as {@link PreEncodedHttpField}s.</p>
+ * <p>The framing fields {@code Content-Length}, {@code Transfer-Encoding} and
+ * {@code Connection} are specific to each response and cannot be part of a template.</p>
+ */
+public class PreEncodedHttpFields implements HttpFields
+{
+    private final Field[] _fields;
+    private final HttpFields _immutable;
+    private final EnumMap<HttpVersion, byte[]> _encoded = new EnumMap<>(HttpVersion.class);
+
+    /**
+     * @param fields the fields of the template
+     * @throws IllegalArgumentException if the fields contain a framing field
+     */
+    public PreEncodedHttpFields(HttpFields fields)
+    {
+        _fields = new Field[fields.size()];
+        int i = 0;
+        for (HttpField field : fields)
+        {
+            HttpHeader header = field.getHeader();
+            if (header == HttpHeader.CONTENT_LENGTH || header == HttpHeader.TRANSFER_ENCODING || header == HttpHeader.CONNECTION)
+                throw new IllegalArgumentException("Framing field in template: " + field);
+            _fields[i] = new Field(this, i, header, field.getName(), field.getValue() == null ? "" : field.getValue());
+            i++;
+        }
+        _immutable = HttpFields.from(_fields);
+
+        for (HttpVersion version : HttpVersion.values())
+        {
+            ByteArrayOutputStream out = new ByteArrayOutputStream();
+            boolean encoded = true;
+            for (Field field : _fields)
+            {
+                byte[] bytes = field.getEncodedField(version);
+                if (bytes == null)
+                {
+                    encoded = false;
+                    break;
+                }
+                out.writeBytes(bytes);
+            }
+            if (encoded)
+                _encoded.put(version, out.toByteArray());
+        }
+        // HPACK encodings are only valid if the dynamic table of the encoder is updated accordingly.
+        _encoded.remove(HttpVersion.HTTP_2);
+    }
+
+    /**
+     * <p>Finds the template whose fields are, in order, the fields at the given index.</p>
+     *
+     * @param fields the fields, typically of a response
+     * @param index the index of the field that may be the first field of a template
+     * @return the template, or null if the fields at the index are not the fields of a template
+     */
+    public static PreEncodedHttpFields getTemplate(HttpFields fields, int index)
+    {
+        PreEncodedHttpFields template = getTemplate(fields.getField(index));
+        if (template == null)
+            return null;
+        Field[] templateFields = template._fields;
+        if (index + templateFields.length > fields.size())
+            return null;
+        for (int i = 1; i < templateFields.length; i++)
+        {
+            if (fields.getField(index + i) != templateFields[i])
+                return null;
+        }
+        return template;
+    }
+
+    /**
+     * <p>Finds the template whose first field is the given field.</p>
+     * <p>The following fields must then be compared, by identity, with the
+     * {@link #getField(int) fields} of the template to know whether the
+     * whole template is present.</p>
+     *
+     * @param field the field that may be the first field of a template
+     * @return the template, or null if the field is not the first field of a template
+     */
+    public static PreEncodedHttpFields getTemplate(HttpField field)
+    {
+        return field instanceof Field first && first._index == 0 ? first._template : null;
+    }
+
+    /**
+     * @param version the version of HTTP
+     * @return whether the whole template is pre-encoded for the version
+     */
+    public boolean isPreEncoded(HttpVersion version)
+    {
+        return _encoded.containsKey(version == HttpVersion.HTTP_1_1 ? HttpVersion.HTTP_1_0 : version);
+    }
+
+    /**
+     * <p>Puts the encoding of all the fields of this template.</p>
+     *
+     * @param bufferInFillMode the buffer to put the encoded fields into
+     * @param version the version of HTTP, for which the template must be {@link #isPreEncoded(HttpVersion) pre-encoded}
+     */
+    public void putTo(ByteBuffer bufferInFillMode, HttpVersion version)
+    {
+        bufferInFillMode.put(_encoded.get(version == HttpVersion.HTTP_1_1 ? HttpVersion.HTTP_1_0 : version));
+    }
+
+    /**
+     * @param version the version of HTTP, for which the template must be {@link #isPreEncoded(HttpVersion) pre-encoded}
+     * @return the length in bytes of the encoding of all the fields of this template
+     */
+    public int getEncodedLength(HttpVersion version)
+    {
+        return _encoded.get(version == HttpVersion.HTTP_1_1 ? HttpVersion.HTTP_1_0 : version).length;
+    }
+
+    @Override
+    public HttpField getField(int index)
+    {
+        return _fields[index];
+    }
+
+    @Override
+    public int size()
+    {
+        return _fields.length;
+    }
+
+    @Override
+    public ListIterator<HttpField> listIterator(int index)
+    {
+        return _immutable.listIterator(index);
+    }
+
+    @Override
+    public HttpFields asImmutable()
+    {
+        return this;
+    }
+
+    @Override
+    public int hashCode()
+    {
+        return Arrays.hashCode(_fields);
+    }
+
+    @Override
+    public boolean equals(Object obj)
+    {
+        return obj instanceof PreEncodedHttpFields that && Arrays.equals(_fields, that._fields);
+    }
+
+    @Override
+    public String toString()
+    {
+        return _immutable.toString();
+    }
+
+    private static class Field extends PreEncodedHttpField
+    {
+        private final PreEncodedHttpFields _template;
+        private final int _index;
+
+        private Field(PreEncodedHttpFields template, int index, HttpHeader header, String name, String value)
+        {
+            super(header, name, value);
+            _template = template;
+            _index = index;
+        }
+    }
+}
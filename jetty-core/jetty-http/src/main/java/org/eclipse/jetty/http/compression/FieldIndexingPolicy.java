@@ -0,0 +1,108 @@
+//
+// ========================================================================
+// Copyright (c) 1995 Mort Bay Consulting Pty Ltd and others.
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License v. 2.0 which is available at
+// https://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+// ========================================================================
+//
+
+package org.eclipse.jetty.http.compression;
+
+import java.util.EnumSet;
+import java.util.LinkedHashMap;
+import java.util.Map;
+
+import org.eclipse.jetty.http.HttpField;
+import org.eclipse.jetty.http.HttpHeader;
+
+/**
+ * <p>Decides which fields an HPACK or QPACK encoder inserts into its dynamic table.</p>
+ * <p>A policy instance is used by a single encoder, so by a single connection, and
+ * is called with the encoder lock held, so implementations need not be thread-safe.</p>
+ */
+public interface FieldIndexingPolicy
+{
+    /**
+     * <p>The headers that are never indexed, whatever the policy, as their values are sensitive.</p>
+     * <p>The {@code Cookie} request header is not in this set: like any other field,
+     * it is only indexed if the policy decides so.</p>
+     */
+    EnumSet<HttpHeader> NEVER_INDEX = EnumSet.of(
+        HttpHeader.AUTHORIZATION,
+        HttpHeader.PROXY_AUTHORIZATION,
+        HttpHeader.SET_COOKIE,
+        HttpHeader.SET_COOKIE2);
+
+    /**
+     * <p>Called when encoding a field that could be inserted into the dynamic table.</p>
+     *
+     * @param field the field being encoded
+     * @return whether the field should be inserted into the dynamic table
+     */
+    boolean shouldIndex(HttpField field);
+
+    /**
+     * <p>A policy that indexes a field once it has been encoded a minimum number of times.</p>
+     * <p>Fields with values that change on every message, such as request ids or dates,
+     * are not indexed and so do not evict the fields that are reused, such as the fields
+     * of a proxy that fans out requests over a few connections.
+     * The number of fields tracked is bounded, the least recently encoded being forgotten first.</p>
+     */
+    class Adaptive implements FieldIndexingPolicy
+    {
+        private final Map<HttpField, Integer> _occurrences;
+        private final int _minOccurrences;
+
+        /**
+         * @param minOccurrences the number of times a field is encoded before it is indexed
+         */
+        public Adaptive(int minOccurrences)
+        {
+            this(minOccurrences, 512);
+        }
+
+        /**
+         * @param minOccurrences the number of times a field is encoded before it is indexed
+         * @param maxTrackedFields the max number of distinct fields tracked
+         */
+        public Adaptive(int minOccurrences, int maxTrackedFields)
+        {
+            _minOccurrences = Math.max(1, minOccurrences);
+            _occurrences = new LinkedHashMap<>(16, 0.75F, true)
+            {
+                @Override
+                protected boolean removeEldestEntry(Map.Entry<HttpField, Integer> eldest)
+                {
+                    return size() > maxTrackedFields;
+                }
+            };
+        }
+
+        public int getMinOccurrences()
+        {
+            return _minOccurrences;
+        }
+
+        @Override
+        public boolean shouldIndex(HttpField field)
+        {
+            if (NEVER_INDEX.contains(field.getHeader()))
+                return false;
+            if (_minOccurrences == 1)
+                return true;
+            int occurrences = _occurrences.merge(field, 1, Integer::sum);
+            return occurrences >= _minOccurrences;
+        }
+
+        @Override
+        public String toString()
+        {
+            return String.format("%s@%x[min=%d,tracked=%d]", getClass().getSimpleName(), hashCode(), _minOccurrences, _occurrences.size());
+        }
+    }
+}
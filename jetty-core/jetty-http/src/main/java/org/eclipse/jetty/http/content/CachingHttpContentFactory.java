@@ -16,13 +16,14 @@ package org.eclipse.jetty.http.content;
 import java.io.IOException;
 import java.nio.ByteBuffer;
 import java.time.Instant;
+import java.util.HashMap;
+import java.util.Map;
 import java.util.Set;
-import java.util.SortedSet;
-import java.util.TreeSet;
 import java.util.concurrent.ConcurrentHashMap;
 import java.util.concurrent.ConcurrentMap;
 import java.util.concurrent.atomic.AtomicBoolean;
 import java.util.concurrent.atomic.AtomicLong;
+import java.util.concurrent.atomic.LongAdder;
 
 import org.eclipse.jetty.http.CompressedContentFormat;
 import org.eclipse.jetty.http.HttpField;
@@ -35,7 +36,11 @@ import org.eclipse.jetty.io.Retainable;
 import org.eclipse.jetty.io.RetainableByteBuffer;
 import org.eclipse.jetty.util.NanoTime;
 import org.eclipse.jetty.util.StringUtil;
+import org.eclipse.jetty.util.annotation.ManagedAttribute;
+import org.eclipse.jetty.util.annotation.ManagedObject;
+import org.eclipse.jetty.util.annotation.ManagedOperation;
 import org.eclipse.jetty.util.resource.Resource;
+import org.eclipse.jetty.util.thread.AutoLock;
 import org.slf4j.Logger;
 import org.slf4j.LoggerFactory;
 
@@ -45,10 +50,17 @@ import org.slf4j.LoggerFactory;
  * using it as a caching authority. Only HttpContent instances whose path is not a directory are cached.
  * </p>
  * <p>
- * No eviction is done by this {@link HttpContent.Factory}, once an entry is in the cache it is always
+ * No validation is done by this {@link HttpContent.Factory}, once an entry is in the cache it is always
  * assumed to be valid. This class can be extended to implement the validation behaviours on
  * {@link CachingHttpContent} which allow entries to be evicted once they become invalid.
  * </p>
+ * <p>
+ * When the cache is full, entries are evicted with a W-TinyLFU policy: new entries enter a small LRU
+ * window, and must then have been accessed more frequently than the entry they would replace to be
+ * admitted to a segmented LRU main space. Access frequencies are approximated by a compact frequency
+ * sketch, so that a scan of rarely accessed paths does not evict frequently accessed ones.
+ * Eviction is O(1) amortized, and a cache hit only updates the policy if its lock is not contended.
+ * </p>
  * <br>
  * The default values for the cache are:
  * <ul>
@@ -58,16 +70,31 @@ import org.slf4j.LoggerFactory;
  * </ul>
  * @see ValidatingCachingHttpContentFactory
  */
+@ManagedObject("Caching HttpContent Factory")
 public class CachingHttpContentFactory implements HttpContent.Factory
 {
     private static final Logger LOG = LoggerFactory.getLogger(CachingHttpContentFactory.class);
     private static final int DEFAULT_MAX_CACHED_FILE_SIZE = 128 * 1024 * 1024;
     private static final int DEFAULT_MAX_CACHED_FILES = 2048;
     private static final long DEFAULT_MAX_CACHE_SIZE = 256 * 1024 * 1024;
+    // The percentage of the cache capacity used by the admission window.
+    private static final int WINDOW_PERCENT = 1;
+    // The percentage of the main space capacity used by the protected segment.
+    private static final int PROTECTED_PERCENT = 80;
 
     private final HttpContent.Factory _authority;
     private final ConcurrentHashMap<String, CachingHttpContent> _cache = new ConcurrentHashMap<>();
     private final AtomicLong _cachedSize = new AtomicLong();
+    private final AutoLock _lock = new AutoLock();
+    private final Map<String, Node> _nodes = new HashMap<>();
+    private final Segment _window = new Segment();
+    private final Segment _probation = new Segment();
+    private final Segment _protected = new Segment();
+    private final FrequencySketch _sketch = new FrequencySketch();
+    private final LongAdder _hits = new LongAdder();
+    private final LongAdder _misses = new LongAdder();
+    private final LongAdder _admissionRejects = new LongAdder();
+    private final LongAdder _evictions = new LongAdder();
     private final ByteBufferPool _bufferPool;
     private int _maxCachedFileSize = DEFAULT_MAX_CACHED_FILE_SIZE;
     private int _maxCachedFiles = DEFAULT_MAX_CACHED_FILES;
@@ -78,6 +105,7 @@ public class CachingHttpContentFactory implements HttpContent.Factory
     {
         _authority = authority;
         _bufferPool = bufferPool != null ? bufferPool : new ByteBufferPool.NonPooling();
+        _sketch.ensureCapacity(_maxCachedFiles);
     }
 
     protected ConcurrentMap<String, CachingHttpContent> getCache()
@@ -85,16 +113,52 @@ public class CachingHttpContentFactory implements HttpContent.Factory
         return _cache;
     }
 
+    @ManagedAttribute("The total size in bytes of the cached contents")
     public long getCachedSize()
     {
         return _cachedSize.get();
     }
 
+    @ManagedAttribute("The number of cached contents")
     public int getCachedFiles()
     {
         return _cache.size();
     }
 
+    @ManagedAttribute("The number of requests served from the cache")
+    public long getCacheHits()
+    {
+        return _hits.sum();
+    }
+
+    @ManagedAttribute("The number of requests not served from the cache")
+    public long getCacheMisses()
+    {
+        return _misses.sum();
+    }
+
+    @ManagedAttribute("The number of new contents not admitted to the cache because they were less frequently accessed than existing ones")
+    public long getAdmissionRejects()
+    {
+        return _admissionRejects.sum();
+    }
+
+    @ManagedAttribute("The number of contents evicted from the cache, including admission rejects")
+    public long getEvictions()
+    {
+        return _evictions.sum();
+    }
+
+    @ManagedOperation(value = "Resets the cache statistics", impact = "ACTION")
+    public void resetStatistics()
+    {
+        _hits.reset();
+        _misses.reset();
+        _admissionRejects.reset();
+        _evictions.reset();
+    }
+
+    @ManagedAttribute("The maximum size in bytes of a cached content")
     public int getMaxCachedFileSize()
     {
         return _maxCachedFileSize;
@@ -106,6 +170,7 @@ public class CachingHttpContentFactory implements HttpContent.Factory
         shrinkCache();
     }
 
+    @ManagedAttribute("The maximum total size in bytes of the cached contents")
     public long getMaxCacheSize()
     {
         return _maxCacheSize;
@@ -121,6 +186,7 @@ public class CachingHttpContentFactory implements HttpContent.Factory
      * Get the max number of cached files..
      * @return the max number of cached files.
      */
+    @ManagedAttribute("The maximum number of cached contents")
     public int getMaxCachedFiles()
     {
         return _maxCachedFiles;
@@ -148,45 +214,158 @@ public class CachingHttpContentFactory implements HttpContent.Factory
 
     private void shrinkCache()
     {
-        // While we need to shrink
-        int numCacheEntries = _cache.size();
-        while (numCacheEntries > 0 && (numCacheEntries > _maxCachedFiles || _cachedSize.get() > _maxCacheSize))
+        try (AutoLock ignored = _lock.lock())
         {
-            // Scan the entire cache and generate an ordered list by last accessed time.
-            SortedSet<CachingHttpContent> sorted = new TreeSet<>((c1, c2) ->
+            _sketch.ensureCapacity(_maxCachedFiles);
+            evict();
+        }
+    }
+
+    /**
+     * <p>Records a content just added to the cache in the admission window, then evicts.</p>
+     *
+     * @param content the content just added to the cache
+     */
+    private void admit(CachingHttpContent content)
+    {
+        try (AutoLock ignored = _lock.lock())
+        {
+            // The content may have been removed before we got the lock.
+            String key = content.getKey();
+            if (_cache.get(key) != content || _nodes.containsKey(key))
+                return;
+            Node node = new Node(key, content);
+            _nodes.put(key, node);
+            _sketch.increment(node._hash);
+            _window.addLast(node);
+            evict();
+        }
+    }
+
+    /**
+     * <p>Records a cache hit, unless another thread is updating the policy,
+     * in which case the hit is dropped rather than waiting.</p>
+     *
+     * @param content the content that was hit
+     */
+    private void access(CachingHttpContent content)
+    {
+        try (AutoLock lock = _lock.tryLock())
+        {
+            if (!lock.isHeldByCurrentThread())
+                return;
+            Node node = _nodes.get(content.getKey());
+            if (node == null || node._content != content)
+                return;
+            _sketch.increment(node._hash);
+            Segment segment = node._segment;
+            if (segment == _probation)
             {
-                long delta = NanoTime.elapsed(c2.getLastAccessedNanos(), c1.getLastAccessedNanos());
-                if (delta != 0)
-                    return delta < 0 ? -1 : 1;
+                // Promote to the protected segment, demoting its least recently used entries.
+                _probation.remove(node);
+                _protected.addLast(node);
+                while (_protected._head != _protected._tail && isOver(_protected, PROTECTED_PERCENT * (100 - WINDOW_PERCENT) / 100))
+                {
+                    Node demoted = _protected._head;
+                    _protected.remove(demoted);
+                    _probation.addLast(demoted);
+                }
+            }
+            else
+            {
+                segment.moveToLast(node);
+            }
+        }
+    }
+
+    private boolean isOver(Segment segment, int percent)
+    {
+        long maxFiles = Math.max(1, (long)_maxCachedFiles * percent / 100);
+        return segment._count > maxFiles || segment._weight > _maxCacheSize / 100 * percent;
+    }
+
+    private boolean isOverCapacity()
+    {
+        int count = _window._count + _probation._count + _protected._count;
+        long weight = _window._weight + _probation._weight + _protected._weight;
+        return count > _maxCachedFiles || weight > _maxCacheSize;
+    }
+
+    /**
+     * <p>Moves the entries that overflow the admission window to the probation segment,
+     * where they are candidates for admission, then evicts until the cache fits its capacity.</p>
+     * <p>A candidate is admitted only if it is more frequently accessed than the probation
+     * victim, and a large candidate must win against all the victims evicted to make room for it.</p>
+     *
+     */
+    private void evict()
+    {
+        assert _lock.isHeldByCurrentThread();
 
-                delta = c1.getContentLengthValue() - c2.getContentLengthValue();
-                if (delta != 0)
-                    return delta < 0 ? -1 : 1;
+        Node candidate = null;
+        while (_window._head != null && isOver(_window, WINDOW_PERCENT))
+        {
+            Node node = _window._head;
+            _window.remove(node);
+            _probation.addLast(node);
+            if (candidate == null)
+                candidate = node;
+        }
 
-                return c1.getKey().compareTo(c2.getKey());
-            });
-            sorted.addAll(_cache.values());
+        while (isOverCapacity())
+        {
+            Node victim = _probation._head;
+            if (victim == null)
+                victim = _protected._head;
+            if (victim == null)
+                victim = _window._head;
 
-            // TODO: Can we remove the buffers from the content before evicting.
-            // Invalidate least recently used first
-            for (CachingHttpContent content : sorted)
+            if (candidate != null && candidate != victim && victim._segment != _window)
             {
-                if (_cache.size() <= _maxCachedFiles && _cachedSize.get() <= _maxCacheSize)
-                    break;
-                removeFromCache(content);
+                int candidateFrequency = _sketch.frequency(candidate._hash);
+                int victimFrequency = _sketch.frequency(victim._hash);
+                if (candidateFrequency <= victimFrequency)
+                {
+                    Node rejected = candidate;
+                    candidate = candidate._next;
+                    _admissionRejects.increment();
+                    evictContent(rejected._content);
+                    continue;
+                }
             }
-
-            numCacheEntries = _cache.size();
+            else if (candidate == victim)
+            {
+                candidate = candidate._next;
+            }
+            evictContent(victim._content);
         }
     }
 
+    private void evictContent(CachingHttpContent content)
+    {
+        if (LOG.isDebugEnabled())
+            LOG.debug("evicting {}", content.getKey());
+        _evictions.increment();
+        removeFromCache(content);
+    }
+
     protected void removeFromCache(CachingHttpContent content)
     {
-        CachingHttpContent removed = _cache.remove(content.getKey());
-        if (removed != null)
+        try (AutoLock ignored = _lock.lock())
         {
-            removed.release();
-            _cachedSize.addAndGet(-removed.getBytesOccupied());
+            String key = content.getKey();
+            Node node = _nodes.get(key);
+            if (node != null && node._content == content)
+            {
+                _nodes.remove(key);
+                node._segment.remove(node);
+            }
+
+            if (_cache.remove(key, content))
+            {
+                content.release();
+                _cachedSize.addAndGet(-content.getBytesOccupied());
+            }
         }
     }
 
@@ -231,12 +410,17 @@ public class CachingHttpContentFactory implements HttpContent.Factory
             {
                 // If retain fails the CachingHttpContent was already evicted.
                 if (cachingHttpContent.retain())
+                {
+                    _hits.increment();
+                    access(cachingHttpContent);
                     return (cachingHttpContent instanceof NotFoundHttpContent) ? null : cachingHttpContent;
+                }
             }
             else
                 removeFromCache(cachingHttpContent);
         }
 
+        _misses.increment();
         HttpContent httpContent = _authority.getContent(path);
         if (!isCacheable(httpContent))
             return httpContent;
@@ -257,8 +441,8 @@ public class CachingHttpContentFactory implements HttpContent.Factory
 
         if (added.get())
         {
-            // We want to shrink cache only if we have just added an entry.
-            shrinkCache();
+            // We want to evict only if we have just added an entry.
+            admit(cachingHttpContent);
         }
         else if (httpContent != null)
         {
@@ -280,6 +464,169 @@ public class CachingHttpContentFactory implements HttpContent.Factory
         return new NotFoundHttpContent(p);
     }
 
+    private static class Node
+    {
+        private final String _key;
+        private final int _hash;
+        private final CachingHttpContent _content;
+        private final long _weight;
+        private Segment _segment;
+        private Node _prev;
+        private Node _next;
+
+        private Node(String key, CachingHttpContent content)
+        {
+            _key = key;
+            _hash = key.hashCode();
+            _content = content;
+            _weight = content.getBytesOccupied();
+        }
+
+        @Override
+        public String toString()
+        {
+            return _key;
+        }
+    }
+
+    /**
+     * <p>A doubly linked LRU list of {@link Node}s, least recently used first.</p>
+     */
+    private static class Segment
+    {
+        private Node _head;
+        private Node _tail;
+        private int _count;
+        private long _weight;
+
+        private void addLast(Node node)
+        {
+            node._segment = this;
+            node._prev = _tail;
+            node._next = null;
+            if (_tail == null)
+                _head = node;
+            else
+                _tail._next = node;
+            _tail = node;
+            _count++;
+            _weight += node._weight;
+        }
+
+        private void remove(Node node)
+        {
+            if (node._prev == null)
+                _head = node._next;
+            else
+                node._prev._next = node._next;
+            if (node._next == null)
+                _tail = node._prev;
+            else
+                node._next._prev = node._prev;
+            node._prev = null;
+            node._next = null;
+            node._segment = null;
+            _count--;
+            _weight -= node._weight;
+        }
+
+        private void moveToLast(Node node)
+        {
+            if (_tail != node)
+            {
+                remove(node);
+                addLast(node);
+            }
+        }
+    }
+
+    /**
+     * <p>A count-min sketch of 4-bit counters, 16 per {@code long}, that estimates the access
+     * frequency of keys in a recent sample. When the sample is complete, all the counters are
+     * halved so that the popularity of keys ages.</p>
+     */
+    private static class FrequencySketch
+    {
+        private static final long[] SEEDS = {0xC3A5C85C97CB3127L, 0xB492B66FBE98F273L, 0x9AE16A3B2F90404FL, 0xCBF29CE484222325L};
+        private static final long RESET_MASK = 0x7777777777777777L;
+
+        private long[] _table;
+        private int _sampleSize;
+        private int _size;
+
+        private void ensureCapacity(int maximumSize)
+        {
+            int maximum = Math.max(16, Math.min(maximumSize, 1 << 24));
+            int length = Integer.highestOneBit(maximum - 1) << 1;
+            if (_table != null && _table.length >= length)
+                return;
+            _table = new long[length];
+            _sampleSize = 10 * maximum;
+            _size = 0;
+        }
+
+        private int frequency(int item)
+        {
+            if (_table == null)
+                return 0;
+            int hash = spread(item);
+            int start = (hash & 3) << 2;
+            int frequency = Integer.MAX_VALUE;
+            for (int i = 0; i < 4; ++i)
+            {
+                int index = indexOf(hash, i);
+                int count = (int)((_table[index] >>> ((start + i) << 2)) & 0xF);
+                frequency = Math.min(frequency, count);
+            }
+            return frequency;
+        }
+
+        private void increment(int item)
+        {
+            if (_table == null)
+                return;
+            int hash = spread(item);
+            int start = (hash & 3) << 2;
+            boolean added = false;
+            for (int i = 0; i < 4; ++i)
+            {
+                int index = indexOf(hash, i);
+                int offset = (start + i) << 2;
+                long mask = 0xFL << offset;
+                if ((_table[index] & mask) != mask)
+                {
+                    _table[index] += 1L << offset;
+                    added = true;
+                }
+            }
+            if (added && ++_size == _sampleSize)
+                reset();
+        }
+
+        private void reset()
+        {
+            for (int i = 0; i < _table.length; ++i)
+            {
+                _table[i] = (_table[i] >>> 1) & RESET_MASK;
+            }
+            _size /= 2;
+        }
+
+        private int indexOf(int hash, int i)
+        {
+            long h = (hash + SEEDS[i]) * SEEDS[i];
+            h += h >>> 32;
+            return ((int)h) & (_table.length - 1);
+        }
+
+        private static int spread(int x)
+        {
+            x = ((x >>> 16) ^ x) * 0x45D9F3B;
+            x = ((x >>> 16) ^ x) * 0x45D9F3B;
+            return (x >>> 16) ^ x;
+        }
+    }
+
     protected interface CachingHttpContent extends HttpContent
     {
         long getLastAccessedNanos();
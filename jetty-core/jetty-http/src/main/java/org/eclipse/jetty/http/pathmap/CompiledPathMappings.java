@@ -0,0 +1,330 @@
+//
+// ========================================================================
+// Copyright (c) 1995 Mort Bay Consulting Pty Ltd and others.
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License v. 2.0 which is available at
+// https://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+// ========================================================================
+//
+
+package org.eclipse.jetty.http.pathmap;
+
+import java.util.ArrayList;
+import java.util.Collection;
+import java.util.HashMap;
+import java.util.List;
+import java.util.Map;
+
+import org.eclipse.jetty.util.Index;
+
+/**
+ * <p>An immutable, compiled form of the mappings of a {@link PathMappings}, used when the
+ * order of the mappings is significant.</p>
+ * <p>Each mapping is ranked by its position in the {@link PathMappings} search order and the
+ * best match is the matching mapping with the lowest rank, which is the same mapping that
+ * would be found by trying each mapping in turn.  Rather than evaluating each mapping, the
+ * servlet and uri-template mappings are compiled into a trie of path segments that is walked
+ * once per lookup, servlet suffix mappings are looked up for each extension of the path, and
+ * only the remaining mappings (typically regular expressions) with a literal prefix matching
+ * the path and a rank better than the best match found so far are evaluated.</p>
+ *
+ * @param <E> the type of mapping endpoint
+ */
+class CompiledPathMappings<E>
+{
+    private static final String REGEX_META = "\\^$.|?*+()[]{}";
+    private static final String REGEX_QUANTIFIERS = "?*+{";
+    private static final int NONE = Integer.MAX_VALUE;
+
+    private final List<MappedResource<E>> _mappings;
+    private final Node _root = new Node();
+    private final Index<Integer> _suffixes;
+    private final int _servletRoot;
+    private final int _servletDefault;
+    private final int[] _otherRanks;
+    private final String[] _otherPrefixes;
+
+    CompiledPathMappings(Collection<MappedResource<E>> mappings)
+    {
+        _mappings = new ArrayList<>(mappings);
+
+        Map<String, Integer> suffixes = new HashMap<>();
+        List<Integer> otherRanks = new ArrayList<>();
+        List<String> otherPrefixes = new ArrayList<>();
+        int servletRoot = NONE;
+        int servletDefault = NONE;
+        for (int rank = 0; rank < _mappings.size(); rank++)
+        {
+            PathSpec pathSpec = _mappings.get(rank).getPathSpec();
+            boolean compiled = false;
+            if (pathSpec instanceof ServletPathSpec)
+            {
+                switch (pathSpec.getGroup())
+                {
+                    case ROOT ->
+                    {
+                        servletRoot = Math.min(servletRoot, rank);
+                        compiled = true;
+                    }
+                    case DEFAULT ->
+                    {
+                        servletDefault = Math.min(servletDefault, rank);
+                        compiled = true;
+                    }
+                    case EXACT -> compiled = add(pathSpec.getDeclaration(), null, rank, false);
+                    case PREFIX_GLOB -> compiled = add(pathSpec.getPrefix(), null, rank, true);
+                    case SUFFIX_GLOB ->
+                    {
+                        if (pathSpec.getSuffix() != null)
+                        {
+                            suffixes.putIfAbsent(pathSpec.getSuffix(), rank);
+                            compiled = true;
+                        }
+                    }
+                    default ->
+                    {
+                    }
+                }
+            }
+            else if (pathSpec instanceof UriTemplatePathSpec uriTemplatePathSpec && uriTemplatePathSpec.getSegments() != null)
+            {
+                compiled = add(null, uriTemplatePathSpec.getSegments(), rank, false);
+            }
+
+            if (!compiled)
+            {
+                otherRanks.add(rank);
+                if (pathSpec instanceof RegexPathSpec regexPathSpec)
+                    otherPrefixes.add(literalPrefix(regexPathSpec.getPattern().pattern()));
+                else if (pathSpec instanceof UriTemplatePathSpec uriTemplatePathSpec)
+                    otherPrefixes.add(literalPrefix(uriTemplatePathSpec.getPattern().pattern()));
+                else
+                    otherPrefixes.add("");
+            }
+        }
+
+        _root.compile();
+        _suffixes = index(suffixes);
+        _servletRoot = servletRoot;
+        _servletDefault = servletDefault;
+        _otherRanks = otherRanks.stream().mapToInt(Integer::intValue).toArray();
+        _otherPrefixes = otherPrefixes.toArray(new String[0]);
+    }
+
+    /**
+     * @param path the path to match
+     * @return whether the path can be matched by {@link #getMatched(String)}, or must be
+     * matched by iterating over all mappings
+     */
+    boolean isCompilable(String path)
+    {
+        // Uri-template and regex mappings only match the path before any query.
+        return path.indexOf('?') < 0;
+    }
+
+    /**
+     * @param path the path to match, which must be {@link #isCompilable(String) compilable}
+     * @return the best match for the path, or null if no mapping matches
+     */
+    MatchedResource<E> getMatched(String path)
+    {
+        int rank = getBestRank(path);
+        if (rank == NONE)
+            return null;
+        MappedResource<E> mapping = _mappings.get(rank);
+        if (mapping.getPathSpec() instanceof ServletPathSpec && mapping.getPathSpec().getGroup() == PathSpecGroup.EXACT)
+            return mapping.getPreMatched();
+        MatchedPath matchedPath = mapping.getPathSpec().matched(path);
+        if (matchedPath == null)
+            return null;
+        return new MatchedResource<>(mapping.getResource(), mapping.getPathSpec(), matchedPath);
+    }
+
+    /**
+     * @param path the path to test, which must be {@link #isCompilable(String) compilable}
+     * @return whether any mapping matches the path
+     */
+    boolean test(String path)
+    {
+        return getBestRank(path) != NONE;
+    }
+
+    private int getBestRank(String path)
+    {
+        int best = _servletDefault;
+
+        if (_servletRoot < best && "/".equals(path))
+            best = _servletRoot;
+
+        // Walk the servlet and uri-template mappings one path segment at a time.
+        if (_root.minRank < best)
+        {
+            if (path.isEmpty())
+                best = Math.min(best, _root.prefixRank);
+            else if (path.charAt(0) == '/')
+                best = _root.walk(path, 0, best);
+        }
+
+        // Try each extension of the path against the servlet suffix mappings.
+        if (!_suffixes.isEmpty())
+        {
+            int i = -1;
+            while ((i = path.indexOf('.', i + 1)) >= 0)
+            {
+                Integer suffix = _suffixes.get(path, i + 1, path.length() - i - 1);
+                if (suffix != null && suffix < best)
+                    best = suffix;
+            }
+        }
+
+        // Only evaluate the other mappings that could improve on the best match.
+        for (int i = 0; i < _otherRanks.length; i++)
+        {
+            int rank = _otherRanks[i];
+            if (rank >= best)
+                break;
+            if (path.startsWith(_otherPrefixes[i]) && _mappings.get(rank).getPathSpec().matches(path))
+                return rank;
+        }
+
+        return best;
+    }
+
+    private boolean add(String path, String[] segments, int rank, boolean prefix)
+    {
+        if (segments == null)
+        {
+            if (path == null)
+                return false;
+            if (path.isEmpty())
+            {
+                if (!prefix)
+                    return false;
+                _root.add(new String[0], 0, rank, true);
+                return true;
+            }
+            if (path.charAt(0) != '/')
+                return false;
+            segments = path.substring(1).split("/", -1);
+        }
+        _root.add(segments, 0, rank, prefix);
+        return true;
+    }
+
+    private static <V> Index<V> index(Map<String, V> entries)
+    {
+        Index.Builder<V> builder = new Index.Builder<V>().caseSensitive(true);
+        if (!entries.isEmpty())
+            builder.withAll(() -> entries);
+        return builder.build();
+    }
+
+    /**
+     * <p>The literal prefix that any path matching the given regex must start with.</p>
+     *
+     * @param regex the regex
+     * @return the literal prefix, possibly empty
+     */
+    static String literalPrefix(String regex)
+    {
+        // Alternatives may have different prefixes.
+        if (regex.indexOf('|') >= 0)
+            return "";
+
+        int start = regex.startsWith("^") ? 1 : 0;
+        int end = start;
+        while (end < regex.length() && REGEX_META.indexOf(regex.charAt(end)) < 0)
+        {
+            end++;
+        }
+
+        // A quantifier applies to the preceding character, which is therefore optional or repeated.
+        if (end < regex.length() && end > start && REGEX_QUANTIFIERS.indexOf(regex.charAt(end)) >= 0)
+            end--;
+
+        return regex.substring(start, end);
+    }
+
+    private static class Node
+    {
+        private Map<String, Node> children = new HashMap<>();
+        private Index<Node> literals;
+        private Node variable;
+        private int terminalRank = NONE;
+        private int prefixRank = NONE;
+        private int minRank = NONE;
+
+        private void add(String[] segments, int index, int rank, boolean prefix)
+        {
+            minRank = Math.min(minRank, rank);
+            if (index == segments.length)
+            {
+                if (prefix)
+                    prefixRank = Math.min(prefixRank, rank);
+                else
+                    terminalRank = Math.min(terminalRank, rank);
+                return;
+            }
+
+            String segment = segments[index];
+            Node child;
+            if (segment == null)
+            {
+                if (variable == null)
+                    variable = new Node();
+                child = variable;
+            }
+            else
+            {
+                child = children.computeIfAbsent(segment, s -> new Node());
+            }
+            child.add(segments, index + 1, rank, prefix);
+        }
+
+        private void compile()
+        {
+            for (Node child : children.values())
+            {
+                child.compile();
+            }
+            if (variable != null)
+                variable.compile();
+            literals = index(children);
+            children = null;
+        }
+
+        /**
+         * @param path the path to match
+         * @param offset the offset of the {@code /} before the next segment, or the path length if all segments are consumed
+         * @param best the best rank found so far
+         * @return the best rank found
+         */
+        private int walk(String path, int offset, int best)
+        {
+            // A servlet prefix matches at a segment boundary.
+            if (prefixRank < best)
+                best = prefixRank;
+
+            if (offset == path.length())
+                return Math.min(best, terminalRank);
+
+            int start = offset + 1;
+            int end = path.indexOf('/', start);
+            if (end < 0)
+                end = path.length();
+
+            Node literal = literals.get(path, start, end - start);
+            if (literal != null && literal.minRank < best)
+                best = literal.walk(path, end, best);
+
+            if (variable != null && end > start && variable.minRank < best)
+                best = variable.walk(path, end, best);
+
+            return best;
+        }
+    }
+}
@@ -68,6 +68,11 @@ public class PathMappings<E> extends AbstractMap<PathSpec, E> implements Iterabl
 
     private MappedResource<E> _servletRoot;
     private MappedResource<E> _servletDefault;
+    /**
+     * The compiled form of the mappings used when _orderIsSignificant is true, built on first use
+     * after the mappings are modified.
+     */
+    private volatile CompiledPathMappings<E> _compiled;
 
     @Override
     public Set<Entry<PathSpec, E>> entrySet()
@@ -111,6 +116,7 @@ public class PathMappings<E> extends AbstractMap<PathSpec, E> implements Iterabl
         _orderIsSignificant = false;
         _servletRoot = null;
         _servletDefault = null;
+        _compiled = null;
     }
 
     public Stream<MappedResource<E>> streamResources()
@@ -120,6 +126,7 @@ public class PathMappings<E> extends AbstractMap<PathSpec, E> implements Iterabl
 
     public boolean removeIf(Predicate<MappedResource<E>> predicate)
     {
+        _compiled = null;
         return _mappings.removeIf(predicate);
     }
 
@@ -247,9 +254,13 @@ public class PathMappings<E> extends AbstractMap<PathSpec, E> implements Iterabl
             }
         }
 
-        // If order is significant, then we need to match by iterating over all mappings.
+        // If order is significant, then we need to match against all the other mappings.
         if (_orderIsSignificant)
         {
+            CompiledPathMappings<E> compiled = getCompiled();
+            if (compiled.isCompilable(path))
+                return compiled.test(path);
+
             for (MappedResource<E> mr : _mappings)
             {
                 if (mr.getPathSpec() instanceof ServletPathSpec)
@@ -264,8 +275,9 @@ public class PathMappings<E> extends AbstractMap<PathSpec, E> implements Iterabl
 
     /**
      * <p>Find the best single match for a path.</p>
-     * <p>The match may be found by optimized direct lookups when possible, otherwise all mappings
-     * are iterated over and the first match returned</p>
+     * <p>The match may be found by optimized direct lookups when possible, otherwise the first
+     * match in the order of the mappings is found by a compiled form of
+     * the mappings, falling back to iterating over all mappings</p>
      * @param path The path to match
      * @return A {@link MatchedResource} instance or null if no mappings matched.
      * @see #getMatchedIteratively(String)
@@ -275,9 +287,14 @@ public class PathMappings<E> extends AbstractMap<PathSpec, E> implements Iterabl
         if (_mappings.isEmpty())
             return null;
 
-        // If order is significant, then we need to match by iterating over all mappings.
+        // If order is significant, then we need to find the first match of all mappings.
         if (_orderIsSignificant)
+        {
+            CompiledPathMappings<E> compiled = getCompiled();
+            if (compiled.isCompilable(path))
+                return compiled.getMatched(path);
             return getMatchedIteratively(path);
+        }
 
         // Otherwise, we can try optimized matches against each group
 
@@ -329,6 +346,17 @@ public class PathMappings<E> extends AbstractMap<PathSpec, E> implements Iterabl
         return null;
     }
 
+    private CompiledPathMappings<E> getCompiled()
+    {
+        CompiledPathMappings<E> compiled = _compiled;
+        if (compiled == null)
+        {
+            compiled = new CompiledPathMappings<>(_mappings);
+            _compiled = compiled;
+        }
+        return compiled;
+    }
+
     /**
      * <p>Iterate over all mappings, returning the first that matches.</p>
      * @param path The path to match.
@@ -469,6 +497,7 @@ public class PathMappings<E> extends AbstractMap<PathSpec, E> implements Iterabl
         E old = remove(pathSpec);
         MappedResource<E> entry = new MappedResource<>(pathSpec, resource);
         _mappings.add(entry);
+        _compiled = null;
         if (LOG.isDebugEnabled())
             LOG.debug("Added {} replacing {} to {}", entry, old, this);
 
@@ -570,6 +599,7 @@ public class PathMappings<E> extends AbstractMap<PathSpec, E> implements Iterabl
             {
                 removed = entry.getResource();
                 iter.remove();
+                _compiled = null;
                 break;
             }
         }
@@ -47,6 +47,10 @@ public class UriTemplatePathSpec extends AbstractPathSpec
      * Allowed Symbols in a URI Template variable
      */
     private static final String VARIABLE_SYMBOLS = "-._";
+    /**
+     * Symbols that, left unescaped in a literal segment, are interpreted by the regex
+     */
+    private static final String REGEX_SYMBOLS = "^$|?+()";
     private static final Set<String> FORBIDDEN_SEGMENTS;
 
     static
@@ -67,6 +71,11 @@ public class UriTemplatePathSpec extends AbstractPathSpec
      * The logical (simplified) declaration
      */
     private final String _logicalDeclaration;
+    /**
+     * The literal path segments, with null for variable segments, or null
+     * if the declaration can only be matched by the regex
+     */
+    private final String[] _segments;
 
     public UriTemplatePathSpec(String rawSpec)
     {
@@ -81,6 +90,7 @@ public class UriTemplatePathSpec extends AbstractPathSpec
             _pattern = Pattern.compile("^/$");
             _variables = new String[0];
             _logicalDeclaration = "/";
+            _segments = new String[]{""};
             return;
         }
 
@@ -103,6 +113,8 @@ public class UriTemplatePathSpec extends AbstractPathSpec
         List<String> varNames = new ArrayList<>();
         // split up into path segments (ignoring the first slash that will always be empty)
         String[] segments = rawSpec.substring(1).split("/");
+        List<String> literalSegments = new ArrayList<>();
+        boolean segmentMatching = true;
         char[] segmentSignature = new char[segments.length];
         StringBuilder logicalSignature = new StringBuilder();
         int pathDepth = segments.length;
@@ -127,6 +139,7 @@ public class UriTemplatePathSpec extends AbstractPathSpec
                 logicalSignature.append("/*");
                 // valid variable name
                 varNames.add(variable);
+                literalSegments.add(null);
                 // build regex
                 regex.append("/([^/]+)");
             }
@@ -150,6 +163,12 @@ public class UriTemplatePathSpec extends AbstractPathSpec
                 // valid path segment
                 segmentSignature[i] = 'e'; // exact
                 logicalSignature.append('/').append(segment);
+                literalSegments.add(segment);
+                for (int j = 0; j < segment.length(); j++)
+                {
+                    if (REGEX_SYMBOLS.indexOf(segment.charAt(j)) >= 0)
+                        segmentMatching = false;
+                }
                 // build regex
                 regex.append('/');
                 // escape regex special characters
@@ -168,6 +187,7 @@ public class UriTemplatePathSpec extends AbstractPathSpec
         {
             regex.append('/');
             logicalSignature.append('/');
+            literalSegments.add("");
         }
 
         regex.append('$');
@@ -197,6 +217,7 @@ public class UriTemplatePathSpec extends AbstractPathSpec
         _pattern = pattern;
         _variables = variables;
         _logicalDeclaration = logicalSignature.toString();
+        _segments = segmentMatching ? literalSegments.toArray(new String[0]) : null;
 
         if (LOG.isDebugEnabled())
         {
@@ -294,6 +315,21 @@ public class UriTemplatePathSpec extends AbstractPathSpec
 
     public Map<String, String> getPathParams(String path)
     {
+        if (_segments != null)
+        {
+            int[] offsets = matchSegments(path);
+            if (offsets == null)
+                return null;
+            if (_group == PathSpecGroup.EXACT)
+                return Collections.emptyMap();
+            Map<String, String> ret = new HashMap<>();
+            for (int i = 0; i < _variables.length; i++)
+            {
+                ret.put(_variables[i], path.substring(offsets[2 * i], offsets[2 * i + 1]));
+            }
+            return ret;
+        }
+
         Matcher matcher = getMatcher(path);
         if (matcher.matches())
         {
@@ -310,6 +346,60 @@ public class UriTemplatePathSpec extends AbstractPathSpec
         return null;
     }
 
+    /**
+     * <p>The literal path segments of this spec, with {@code null} for the variable segments.</p>
+     * <p>The path segments of a spec ending with {@code /} end with the empty segment.</p>
+     *
+     * @return the path segments, or null if this spec can only be matched by its {@link #getPattern() pattern}
+     */
+    String[] getSegments()
+    {
+        return _segments;
+    }
+
+    /**
+     * <p>Match the path segment by segment, equivalently to the {@link #getPattern() pattern}.</p>
+     *
+     * @param path the path to match
+     * @return the start and end offsets in the path of each variable, or null if the path does not match
+     */
+    private int[] matchSegments(String path)
+    {
+        int end = path.indexOf('?');
+        if (end < 0)
+            end = path.length();
+        if (end == 0 || path.charAt(0) != '/')
+            return null;
+
+        int[] offsets = new int[2 * _variables.length];
+        int variable = 0;
+        int start = 1;
+        for (int i = 0; i < _segments.length; i++)
+        {
+            // Only the last segment may extend to the end of the path.
+            int slash = path.indexOf('/', start);
+            int segmentEnd = (slash < 0 || slash > end) ? end : slash;
+            boolean last = i == _segments.length - 1;
+            if (last != (segmentEnd == end))
+                return null;
+
+            String segment = _segments[i];
+            if (segment == null)
+            {
+                if (segmentEnd == start)
+                    return null;
+                offsets[variable++] = start;
+                offsets[variable++] = segmentEnd;
+            }
+            else if (segment.length() != segmentEnd - start || !path.startsWith(segment, start))
+            {
+                return null;
+            }
+            start = segmentEnd + 1;
+        }
+        return offsets;
+    }
+
     protected Matcher getMatcher(String path)
     {
         int idx = path.indexOf('?');
@@ -346,6 +436,12 @@ public class UriTemplatePathSpec extends AbstractPathSpec
     @Override
     public String getPathInfo(String path)
     {
+        if (_segments != null)
+        {
+            MatchedPath matched = matched(path);
+            return matched == null ? null : matched.getPathInfo();
+        }
+
         // Path Info only valid for PREFIX_GLOB types
         if (_group == PathSpecGroup.PREFIX_GLOB)
         {
@@ -368,6 +464,12 @@ public class UriTemplatePathSpec extends AbstractPathSpec
     @Override
     public String getPathMatch(String path)
     {
+        if (_segments != null)
+        {
+            MatchedPath matched = matched(path);
+            return matched == null ? null : matched.getPathMatch();
+        }
+
         Matcher matcher = getMatcher(path);
         if (matcher.matches())
         {
@@ -412,12 +514,30 @@ public class UriTemplatePathSpec extends AbstractPathSpec
     @Override
     public boolean matches(final String path)
     {
+        if (_segments != null)
+            return matchSegments(path) != null;
         return getMatcher(path).matches();
     }
 
     @Override
     public MatchedPath matched(String path)
     {
+        if (_segments != null)
+        {
+            int[] offsets = matchSegments(path);
+            if (offsets == null)
+                return null;
+            if (_group == PathSpecGroup.PREFIX_GLOB && offsets.length > 0)
+            {
+                // Same split as the regex: the path up to the first variable, and the first variable.
+                int idx = offsets[0];
+                if (path.charAt(idx - 1) == '/')
+                    idx--;
+                return MatchedPath.from(path.substring(0, idx), path.substring(offsets[0], offsets[1]));
+            }
+            return MatchedPath.from(path, null);
+        }
+
         Matcher matcher = getMatcher(path);
         if (matcher.matches())
         {
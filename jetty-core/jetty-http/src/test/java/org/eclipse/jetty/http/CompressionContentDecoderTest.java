@@ -0,0 +1,130 @@
+//
+// ========================================================================
+// Copyright (c) 1995 Mort Bay Consulting Pty Ltd and others.
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License v. 2.0 which is available at
+// https://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+// ========================================================================
+//
+
+package org.eclipse.jetty.http;
+
+import java.io.ByteArrayOutputStream;
+import java.io.IOException;
+import java.nio.ByteBuffer;
+import java.nio.charset.StandardCharsets;
+import java.util.zip.GZIPOutputStream;
+
+import org.eclipse.jetty.io.RetainableByteBuffer;
+import org.eclipse.jetty.util.BufferUtil;
+import org.eclipse.jetty.util.compression.Compression;
+import org.eclipse.jetty.util.compression.GzipCompression;
+import org.junit.jupiter.api.Test;
+import org.junit.jupiter.params.ParameterizedTest;
+import org.junit.jupiter.params.provider.ValueSource;
+
+import static org.hamcrest.MatcherAssert.assertThat;
+import static org.hamcrest.Matchers.instanceOf;
+import static org.hamcrest.Matchers.is;
+import static org.junit.jupiter.api.Assertions.assertThrows;
+import static org.junit.jupiter.api.Assertions.assertTrue;
+
+public class CompressionContentDecoderTest
+{
+    private static byte[] gzip(String content) throws IOException
+    {
+        ByteArrayOutputStream bytes = new ByteArrayOutputStream();
+        try (GZIPOutputStream output = new GZIPOutputStream(bytes))
+        {
+            output.write(content.getBytes(StandardCharsets.UTF_8));
+        }
+        return bytes.toByteArray();
+    }
+
+    @ParameterizedTest
+    @ValueSource(ints = {Integer.MAX_VALUE, 7, 1})
+    public void testGzipMultipleMembers(int chunkSize) throws Exception
+    {
+        // SPEC: RFC 1952, the members of a gzip stream are decoded one after the other.
+        ByteArrayOutputStream members = new ByteArrayOutputStream();
+        members.write(gzip("Hello "));
+        members.write(gzip("World"));
+        ByteBuffer compressed = ByteBuffer.wrap(members.toByteArray());
+
+        CompressionContentDecoder decoder = new CompressionContentDecoder(new GzipCompression(), null, 1024);
+        StringBuilder result = new StringBuilder();
+        while (compressed.hasRemaining())
+        {
+            ByteBuffer chunk = compressed.slice(compressed.position(), Math.min(chunkSize, compressed.remaining()));
+            compressed.position(compressed.position() + chunk.remaining());
+            RetainableByteBuffer decoded = decoder.decode(chunk);
+            result.append(BufferUtil.toString(decoded.getByteBuffer(), StandardCharsets.UTF_8));
+            decoded.release();
+        }
+        assertThat(result.toString(), is("Hello World"));
+        assertTrue(decoder.isFinished());
+        decoder.destroy();
+    }
+
+    @Test
+    public void testDecoderWithoutProgressFails()
+    {
+        Compression compression = new Compression("stuck")
+        {
+            @Override
+            public Encoder newEncoder()
+            {
+                throw new UnsupportedOperationException();
+            }
+
+            @Override
+            public Decoder newDecoder()
+            {
+                // A decoder that never consumes its input nor produces output.
+                return new Decoder()
+                {
+                    private ByteBuffer input;
+
+                    @Override
+                    public void setInput(ByteBuffer input)
+                    {
+                        this.input = input;
+                    }
+
+                    @Override
+                    public boolean needsInput()
+                    {
+                        return input == null;
+                    }
+
+                    @Override
+                    public boolean isFinished()
+                    {
+                        return false;
+                    }
+
+                    @Override
+                    public int decode(ByteBuffer output)
+                    {
+                        return 0;
+                    }
+
+                    @Override
+                    public void release()
+                    {
+                    }
+                };
+            }
+        };
+
+        CompressionContentDecoder decoder = new CompressionContentDecoder(compression, null, 1024);
+        ByteBuffer compressed = ByteBuffer.wrap("compressed".getBytes(StandardCharsets.UTF_8));
+        RuntimeException failure = assertThrows(RuntimeException.class, () -> decoder.decode(compressed));
+        assertThat(failure.getCause(), instanceOf(IOException.class));
+        decoder.destroy();
+    }
+}
@@ -276,6 +276,40 @@ public class HttpFieldsTest
         check.accept(mutable);
     }
 
+    @ParameterizedTest
+    @ValueSource(ints = {1, 7, 8, 50})
+    public void testImmutableLookup(int extra)
+    {
+        HttpFields.Mutable mutable = HttpFields.build();
+        for (int i = 0; i < extra; i++)
+        {
+            mutable.add("X-Extra-" + i, Integer.toString(i));
+        }
+        mutable.add(HttpHeader.ACCEPT, "text/html");
+        mutable.add("content-type", "text/plain");
+        mutable.add(new HttpField(null, "Host", "first"));
+        mutable.add(HttpHeader.HOST, "second");
+        mutable.add(HttpHeader.ACCEPT, "text/xml");
+        HttpFields fields = mutable.asImmutable();
+
+        assertThat(fields.size(), is(extra + 5));
+        assertThat(fields.get(HttpHeader.ACCEPT), is("text/html"));
+        assertThat(fields.get("ACCEPT"), is("text/html"));
+        assertThat(fields.get(HttpHeader.CONTENT_TYPE), is("text/plain"));
+        assertThat(fields.getField("Content-Type").getValue(), is("text/plain"));
+        assertThat(fields.get("host"), is("first"));
+        assertThat(fields.get(HttpHeader.HOST), is("second"));
+        assertThat(fields.get("x-extra-0"), is("0"));
+        assertThat(fields.get("X-Extra-" + (extra - 1)), is(Integer.toString(extra - 1)));
+        assertTrue(fields.contains(HttpHeader.ACCEPT));
+        assertTrue(fields.contains("HOST"));
+        assertFalse(fields.contains(HttpHeader.ETAG));
+        assertFalse(fields.contains("X-Missing"));
+        assertNull(fields.getField(HttpHeader.ETAG));
+        assertNull(fields.get("X-Missing"));
+        assertNull(fields.get((String)null));
+    }
+
     @ParameterizedTest
     @MethodSource("mutables")
     public void testMutable(HttpFields.Mutable mutable)
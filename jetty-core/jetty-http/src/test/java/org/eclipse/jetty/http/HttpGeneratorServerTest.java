@@ -106,6 +106,46 @@ public class HttpGeneratorServerTest
         assertThat(response, containsString("\r\n0123456789"));
     }
 
+    @Test
+    public void testPreEncodedTemplate() throws Exception
+    {
+        PreEncodedHttpFields template = new PreEncodedHttpFields(HttpFields.build()
+            .add(HttpHeader.CONTENT_TYPE, "application/json")
+            .add(HttpHeader.CACHE_CONTROL, "no-store")
+            .add("X-Custom", "value"));
+        assertThrows(IllegalArgumentException.class, () -> new PreEncodedHttpFields(HttpFields.build().add(HttpHeader.CONTENT_LENGTH, "10")));
+
+        HttpFields.Mutable templated = HttpFields.build().add(template).add(HttpHeader.ETAG, "\"tag\"");
+        assertSame(template, PreEncodedHttpFields.getTemplate(templated, 0));
+        assertEquals(null, PreEncodedHttpFields.getTemplate(templated, 1));
+        HttpFields.Mutable plain = HttpFields.build()
+            .add(HttpHeader.CONTENT_TYPE, "application/json")
+            .add(HttpHeader.CACHE_CONTROL, "no-store")
+            .add("X-Custom", "value")
+            .add(HttpHeader.ETAG, "\"tag\"");
+        assertEquals(generateHeader(plain), generateHeader(templated));
+
+        // Modifying a template field generates the remaining fields individually.
+        templated.remove(HttpHeader.CACHE_CONTROL);
+        plain.remove(HttpHeader.CACHE_CONTROL);
+        assertEquals(null, PreEncodedHttpFields.getTemplate(templated, 0));
+        assertEquals(generateHeader(plain), generateHeader(templated));
+    }
+
+    private String generateHeader(HttpFields fields) throws Exception
+    {
+        ByteBuffer header = BufferUtil.allocate(8096);
+        ByteBuffer content = BufferUtil.toBuffer("0123456789");
+        HttpGenerator gen = new HttpGenerator();
+        MetaData.Response info = new MetaData.Response(200, null, HttpVersion.HTTP_1_1, fields, 10);
+        HttpGenerator.Result result = gen.generateResponse(info, false, header, null, content, true);
+        assertEquals(HttpGenerator.Result.FLUSH, result);
+        String response = BufferUtil.toString(header);
+        assertThat(response, containsString("Content-Type: application/json\r\n"));
+        assertThat(response, containsString("Content-Length: 10\r\n"));
+        return response;
+    }
+
     @Test
     public void testHeaderOverflow() throws Exception
     {
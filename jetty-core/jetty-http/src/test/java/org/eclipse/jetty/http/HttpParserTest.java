@@ -41,6 +41,7 @@ import static org.hamcrest.MatcherAssert.assertThat;
 import static org.hamcrest.Matchers.contains;
 import static org.hamcrest.Matchers.containsString;
 import static org.hamcrest.Matchers.empty;
+import static org.hamcrest.Matchers.greaterThanOrEqualTo;
 import static org.hamcrest.Matchers.is;
 import static org.hamcrest.Matchers.notNullValue;
 import static org.hamcrest.Matchers.nullValue;
@@ -1093,6 +1094,44 @@ public class HttpParserTest
         }
     }
 
+    @ParameterizedTest
+    @ValueSource(booleans = {true, false})
+    public void testLongURIAndFieldsSplitParse(boolean direct)
+    {
+        String uri = "/path/" + "segment/".repeat(8) + "?query=" + "v".repeat(21);
+        String name = "X-Long-Header-Name-With-Many-Characters";
+        String cookie = "a=" + "0123456789abcdef".repeat(8) + "; b=" + "x".repeat(37) + "; c=%3D~!";
+        String request = "GET " + uri + " HTTP/1.1\r\n" +
+            "Host: localhost\r\n" +
+            "Cookie: " + cookie + "    \r\n" +
+            name + ":  v a l u e  \t \r\n" +
+            "\r\n";
+
+        for (int split = 1; split < request.length(); split++)
+        {
+            init();
+            ByteBuffer buffer = direct ? BufferUtil.toDirectBuffer(request) : BufferUtil.toBuffer(request);
+            HttpParser.RequestHandler handler = new Handler();
+            HttpParser parser = new HttpParser(handler);
+
+            buffer.limit(split);
+            parser.parseNext(buffer);
+            buffer.limit(buffer.capacity());
+            parseAll(parser, buffer);
+
+            assertEquals("GET", _methodOrVersion);
+            assertEquals(uri, _uriOrStatus);
+            assertEquals("HTTP/1.1", _versionOrReason);
+            assertEquals("Host", _hdr[0]);
+            assertEquals("localhost", _val[0]);
+            assertEquals("Cookie", _hdr[1]);
+            assertEquals(cookie, _val[1]);
+            assertEquals(name, _hdr[2]);
+            assertEquals("v a l u e", _val[2]);
+            assertEquals(2, _headers);
+        }
+    }
+
     @ParameterizedTest
     @ValueSource(strings = {"\r\n", "\n"})
     public void testChunkParse(String eoln)
@@ -2493,6 +2532,44 @@ public class HttpParserTest
         assertSame(field, _fields.get(0));
     }
 
+    @Test
+    @SuppressWarnings("ReferenceEquality")
+    public void testLearnedField()
+    {
+        String request =
+            "GET / HTTP/1.1\r\n" +
+                "Host: localhost\r\n" +
+                "X-Client: fleet-agent/1.2\r\n" +
+                "X-Request-Id: %d\r\n" +
+                "\r\n";
+
+        HttpParser.RequestHandler handler = new Handler();
+        HttpParser parser = new HttpParser(handler);
+
+        // The first sight of a custom field is not cached.
+        parseAll(parser, BufferUtil.toBuffer(String.format(request, 1)));
+        assertNull(parser.getFieldCache().get("X-Client: fleet-agent/1.2"));
+
+        // The second sight of the same field is cached.
+        parseAll(parser, BufferUtil.toBuffer(String.format(request, 2)));
+        HttpField learned = parser.getFieldCache().get("X-Client: fleet-agent/1.2");
+        assertNotNull(learned);
+        assertSame(learned, _fields.get(1));
+        assertNull(parser.getFieldCache().get("X-Request-Id: 2"));
+        long misses = parser.getHeaderCacheMisses();
+
+        // Subsequent messages reuse the cached fields.
+        parseAll(parser, BufferUtil.toBuffer(String.format(request, 3)));
+        assertSame(learned, _fields.get(1));
+        assertEquals("3", _fields.get(2).getValue());
+        assertEquals(misses + 1, parser.getHeaderCacheMisses());
+        assertThat(parser.getHeaderCacheHits(), greaterThanOrEqualTo(2L));
+
+        // Learned fields only match exactly.
+        parseAll(parser, BufferUtil.toBuffer(String.format(request, 4).replace("fleet-agent", "FLEET-AGENT")));
+        assertEquals("FLEET-AGENT/1.2", _fields.get(1).getValue());
+    }
+
     @ParameterizedTest
     @ValueSource(strings = {"\r\n", "\n"})
     public void testParseRequest(String eoln)
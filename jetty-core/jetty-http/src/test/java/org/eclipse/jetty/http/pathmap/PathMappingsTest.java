@@ -623,4 +623,80 @@ public class PathMappingsTest
                 "default"
             ));
     }
+
+    @Test
+    public void testCompiledMatchesFirstMatch()
+    {
+        PathMappings<String> p = new PathMappings<>();
+        p.put(new ServletPathSpec(""), "root");
+        p.put(new ServletPathSpec("/"), "default");
+        p.put(new ServletPathSpec("/exact"), "exact");
+        p.put(new ServletPathSpec("/a/*"), "a");
+        p.put(new ServletPathSpec("/a/b/*"), "ab");
+        p.put(new ServletPathSpec("*.do"), "do");
+        p.put(new UriTemplatePathSpec("/a/{x}/c"), "axc");
+        p.put(new UriTemplatePathSpec("/a/b/{y}"), "aby");
+        p.put(new UriTemplatePathSpec("/{x}/{y}/"), "xy");
+        p.put(new UriTemplatePathSpec("/users/{id}"), "user");
+        p.put(new UriTemplatePathSpec("/users/me"), "me");
+        p.put(new RegexPathSpec("^/a/b+/d$"), "abd");
+        p.put(new RegexPathSpec("^/users/[0-9]+$"), "userNumber");
+        p.put(new RegexPathSpec("^(/cat|/dog)/.*$"), "pet");
+        p.put(new RegexPathSpec("^/entrance/cam$"), "entranceCam");
+
+        String[] paths = {
+            "", "/", "//", "/exact", "/exact/", "/a", "/a/", "/a/x/c", "/a/b/c", "/a/b", "/a/b/", "/a/bbb/d",
+            "/a/b/d", "/a//c", "/x/y/", "/x//", "/users/42", "/users/me", "/users/", "/dog/x", "/cat", "/foo.do",
+            "/a/foo.do", ".do", "/x.do/y", "/entrance/cam", "/entrance/cam/", "nopath", "/users/42?q=1"
+        };
+
+        for (String path : paths)
+        {
+            MatchedResource<String> expected = null;
+            for (MappedResource<String> mapping : p)
+            {
+                MatchedPath matchedPath = mapping.getPathSpec().matched(path);
+                if (matchedPath != null)
+                {
+                    expected = new MatchedResource<>(mapping.getResource(), mapping.getPathSpec(), matchedPath);
+                    break;
+                }
+            }
+
+            MatchedResource<String> actual = p.getMatched(path);
+            String msg = String.format(".getMatched(\"%s\")", path);
+            if (expected == null)
+            {
+                assertThat(msg, actual, nullValue());
+                assertFalse(p.test(path), msg);
+            }
+            else
+            {
+                assertThat(msg, actual, notNullValue());
+                assertThat(msg, actual.getPathSpec(), is(expected.getPathSpec()));
+                assertThat(msg, actual.getPathMatch(), is(expected.getPathMatch()));
+                assertThat(msg, actual.getPathInfo(), is(expected.getPathInfo()));
+                assertTrue(p.test(path), msg);
+            }
+        }
+
+        // Modifications are seen by the next match.
+        assertMatch(p, "/users/me", "me");
+        p.remove(new UriTemplatePathSpec("/users/me"));
+        assertMatch(p, "/users/me", "user");
+        p.put(new ServletPathSpec("/users/me"), "servletMe");
+        assertMatch(p, "/users/me", "servletMe");
+    }
+
+    @Test
+    public void testCompiledLiteralPrefix()
+    {
+        assertThat(CompiledPathMappings.literalPrefix("^/entrance/cam$"), is("/entrance/cam"));
+        assertThat(CompiledPathMappings.literalPrefix("^/a/b+/d$"), is("/a/"));
+        assertThat(CompiledPathMappings.literalPrefix("/a/.*"), is("/a/"));
+        assertThat(CompiledPathMappings.literalPrefix("^/users/[0-9]+$"), is("/users/"));
+        assertThat(CompiledPathMappings.literalPrefix("^(/cat|/dog)/.*$"), is(""));
+        assertThat(CompiledPathMappings.literalPrefix("^/a|^/b"), is(""));
+        assertThat(CompiledPathMappings.literalPrefix("^/a\\.b$"), is("/a"));
+    }
 }
@@ -111,7 +111,10 @@ public class HTTP2Client extends ContainerLifeCycle
     private int maxSettingsKeys = SettingsFrame.DEFAULT_MAX_KEYS;
     private int maxDecoderTableCapacity = HpackContext.DEFAULT_MAX_TABLE_CAPACITY;
     private int maxEncoderTableCapacity = HpackContext.DEFAULT_MAX_TABLE_CAPACITY;
+    private int aggregationSize = 16 * 1024;
+    private long maxCoalesceDelay;
     private int maxHeaderBlockFragment = 0;
+    private int fieldIndexingMinOccurrences;
     private int maxResponseHeadersSize = 8 * 1024;
     private FlowControlStrategy.Factory flowControlStrategyFactory = () -> new BufferingFlowControlStrategy(0.5F);
     private long streamIdleTimeout;
@@ -334,6 +337,42 @@ public class HTTP2Client extends ContainerLifeCycle
         this.maxEncoderTableCapacity = maxEncoderTableCapacity;
     }
 
+    @ManagedAttribute("The size of the buffers that aggregate small frames before a TCP write")
+    public int getAggregationSize()
+    {
+        return aggregationSize;
+    }
+
+    /**
+     * <p>Sets the size of the buffers that aggregate small frames, possibly
+     * of different streams, before they are written.</p>
+     * <p>Setting this value to {@code 0} disables the aggregation.</p>
+     *
+     * @param aggregationSize the size of the aggregation buffers in bytes
+     */
+    public void setAggregationSize(int aggregationSize)
+    {
+        this.aggregationSize = aggregationSize;
+    }
+
+    @ManagedAttribute("The max time in microseconds spent coalescing frames before a TCP write")
+    public long getMaxCoalesceDelay()
+    {
+        return maxCoalesceDelay;
+    }
+
+    /**
+     * <p>Sets the max time spent coalescing, in the same write, the frames
+     * that are queued while the previous frames are being generated.</p>
+     * <p>Setting this value to {@code 0} disables coalescing.</p>
+     *
+     * @param maxCoalesceDelay the max coalesce delay in microseconds
+     */
+    public void setMaxCoalesceDelay(long maxCoalesceDelay)
+    {
+        this.maxCoalesceDelay = maxCoalesceDelay;
+    }
+
     @ManagedAttribute("The HPACK decoder dynamic table maximum capacity")
     public int getMaxDecoderTableCapacity()
     {
@@ -356,6 +395,31 @@ public class HTTP2Client extends ContainerLifeCycle
         this.maxHeaderBlockFragment = maxHeaderBlockFragment;
     }
 
+    @ManagedAttribute("The min occurrences of a field before the HPACK encoder indexes it, or 0 for the default heuristics")
+    public int getFieldIndexingMinOccurrences()
+    {
+        return fieldIndexingMinOccurrences;
+    }
+
+    /**
+     * <p>Sets the number of times a field must be encoded before the HPACK encoder
+     * inserts it into the dynamic table.</p>
+     * <p>The default value is {@code 0}, which means that the HPACK encoder uses its
+     * default heuristics and indexes any field that is not known to vary frequently.</p>
+     * <p>A value greater than {@code 0} configures an adaptive indexing policy that
+     * indexes only fields that are repeated across streams, so that fields that are
+     * never referenced again do not evict the ones that are.
+     * Whatever the value, {@code Authorization}, {@code Proxy-Authorization},
+     * {@code Set-Cookie} and {@code Set-Cookie2} are never indexed.</p>
+     *
+     * @param fieldIndexingMinOccurrences the min occurrences of a field before it is indexed
+     * @see org.eclipse.jetty.http.compression.FieldIndexingPolicy.Adaptive
+     */
+    public void setFieldIndexingMinOccurrences(int fieldIndexingMinOccurrences)
+    {
+        this.fieldIndexingMinOccurrences = fieldIndexingMinOccurrences;
+    }
+
     @ManagedAttribute("The max size of response headers")
     public int getMaxResponseHeadersSize()
     {
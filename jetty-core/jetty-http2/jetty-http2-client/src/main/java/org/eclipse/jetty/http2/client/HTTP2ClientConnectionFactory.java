@@ -17,6 +17,7 @@ import java.util.HashMap;
 import java.util.List;
 import java.util.Map;
 
+import org.eclipse.jetty.http.compression.FieldIndexingPolicy;
 import org.eclipse.jetty.http2.FlowControlStrategy;
 import org.eclipse.jetty.http2.HTTP2Connection;
 import org.eclipse.jetty.http2.HTTP2Session;
@@ -54,6 +55,8 @@ public class HTTP2ClientConnectionFactory implements ClientConnectionFactory
         Promise<Session> sessionPromise = (Promise<Session>)context.get(SESSION_PROMISE_CONTEXT_KEY);
 
         Generator generator = new Generator(bufferPool, client.isUseOutputDirectByteBuffers(), client.getMaxHeaderBlockFragment());
+        if (client.getFieldIndexingMinOccurrences() > 0)
+            generator.getHpackEncoder().setIndexingPolicy(new FieldIndexingPolicy.Adaptive(client.getFieldIndexingMinOccurrences()));
         FlowControlStrategy flowControl = client.getFlowControlStrategyFactory().newFlowControlStrategy();
 
         Parser parser = new Parser(bufferPool, client.getMaxResponseHeadersSize());
@@ -63,6 +66,8 @@ public class HTTP2ClientConnectionFactory implements ClientConnectionFactory
         HTTP2ClientSession session = new HTTP2ClientSession(client.getScheduler(), endPoint, parser, generator, listener, flowControl);
         session.setMaxRemoteStreams(client.getMaxConcurrentPushedStreams());
         session.setMaxEncoderTableCapacity(client.getMaxEncoderTableCapacity());
+        session.setAggregationSize(client.getAggregationSize());
+        session.setMaxCoalesceDelay(client.getMaxCoalesceDelay());
         long streamIdleTimeout = client.getStreamIdleTimeout();
         if (streamIdleTimeout > 0)
             session.setStreamIdleTimeout(streamIdleTimeout);
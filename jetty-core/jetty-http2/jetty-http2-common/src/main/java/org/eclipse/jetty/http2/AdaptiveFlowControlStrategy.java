@@ -0,0 +1,700 @@
+//
+// ========================================================================
+// Copyright (c) 1995 Mort Bay Consulting Pty Ltd and others.
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License v. 2.0 which is available at
+// https://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+// ========================================================================
+//
+
+package org.eclipse.jetty.http2;
+
+import java.io.IOException;
+import java.util.ArrayDeque;
+import java.util.ArrayList;
+import java.util.Deque;
+import java.util.List;
+import java.util.Map;
+import java.util.concurrent.ConcurrentHashMap;
+import java.util.concurrent.ThreadLocalRandom;
+import java.util.concurrent.TimeUnit;
+import java.util.concurrent.atomic.AtomicInteger;
+import java.util.concurrent.atomic.AtomicLong;
+
+import org.eclipse.jetty.http2.api.Session;
+import org.eclipse.jetty.http2.api.Stream;
+import org.eclipse.jetty.http2.frames.PingFrame;
+import org.eclipse.jetty.http2.frames.SettingsFrame;
+import org.eclipse.jetty.http2.frames.WindowUpdateFrame;
+import org.eclipse.jetty.util.Callback;
+import org.eclipse.jetty.util.NanoTime;
+import org.eclipse.jetty.util.annotation.ManagedAttribute;
+import org.eclipse.jetty.util.annotation.ManagedObject;
+import org.eclipse.jetty.util.component.Dumpable;
+import org.eclipse.jetty.util.component.DumpableCollection;
+import org.eclipse.jetty.util.thread.AutoLock;
+import org.slf4j.Logger;
+import org.slf4j.LoggerFactory;
+
+/**
+ * <p>A flow control strategy that sizes the receive windows from an estimate
+ * of the bandwidth-delay product of the connection.</p>
+ * <p>When data is received, and no estimation is in progress, a PING frame is
+ * sent to the other peer, and the bytes received until the PING reply arrives
+ * are counted: that count is a sample of the bandwidth-delay product, and the
+ * time taken by the PING reply is a sample of the round-trip time.
+ * If the PING reply does not arrive within {@link Factory#getPingTimeout()},
+ * the sample is discarded and a new PING is sent when more data is received.</p>
+ * <p>When a sample is close to the current session receive window, the window
+ * is limiting the throughput of the connection, so the session receive window
+ * is enlarged (by sending a {@code WINDOW_UPDATE} frame in excess of the data
+ * consumed), up to {@link Factory#getMaxSessionRecvWindow()}; the stream receive
+ * windows follow the session receive window (by sending a {@code SETTINGS} frame
+ * with a new {@code INITIAL_WINDOW_SIZE}), up to {@link Factory#getMaxStreamRecvWindow()}.</p>
+ * <p>When consecutive samples are much smaller than the current session receive
+ * window, the windows are shrunk back towards their initial values, by withholding
+ * part of the window updates for the data consumed.</p>
+ * <p>The memory committed by enlarging the session receive window beyond its
+ * initial value is reserved from a memory budget shared by all the strategies
+ * created by the same {@link Factory}, and released when the window shrinks
+ * or the session is terminated, so that the total memory that peers may make
+ * this side buffer is bounded.</p>
+ * <p>Applications should configure small initial receive windows (for example,
+ * the default of 64 KiB) and let the strategy enlarge them on the connections
+ * that need it.</p>
+ * <p>Typical usage:</p>
+ * <pre>{@code
+ * AdaptiveFlowControlStrategy.Factory flowControl = new AdaptiveFlowControlStrategy.Factory(256 * 1024 * 1024);
+ *
+ * HTTP2Client http2Client = new HTTP2Client();
+ * http2Client.setInitialSessionRecvWindow(FlowControlStrategy.DEFAULT_WINDOW_SIZE);
+ * http2Client.setInitialStreamRecvWindow(FlowControlStrategy.DEFAULT_WINDOW_SIZE);
+ * http2Client.setFlowControlStrategyFactory(flowControl);
+ *
+ * HTTP2ServerConnectionFactory http2 = new HTTP2ServerConnectionFactory();
+ * http2.setFlowControlStrategyFactory(flowControl);
+ * }</pre>
+ * <p>The recent changes of the windows are recorded, and are available via
+ * {@link #getTrajectory()} and in the {@link #dump() dump}.</p>
+ */
+@ManagedObject
+public class AdaptiveFlowControlStrategy extends AbstractFlowControlStrategy
+{
+    private static final Logger LOG = LoggerFactory.getLogger(AdaptiveFlowControlStrategy.class);
+    private static final long PING_MASK = 0xFF_FF_FF_FF_00_00_00_00L;
+
+    private final AutoLock lock = new AutoLock();
+    private final Deque<Adjustment> trajectory = new ArrayDeque<>();
+    private final AtomicInteger sessionLevel = new AtomicInteger();
+    private final AtomicInteger sessionWindow = new AtomicInteger(DEFAULT_WINDOW_SIZE);
+    private final AtomicInteger sessionDebt = new AtomicInteger();
+    private final AtomicLong pendingSessionUpdates = new AtomicLong();
+    private final AtomicLong reservedMemory = new AtomicLong();
+    private final Map<Stream, AtomicInteger> streamLevels = new ConcurrentHashMap<>();
+    private final Factory factory;
+    private final long created;
+    // The random high 32 bits of the PING payload identify the PING frames sent by this strategy.
+    private final long pingPrefix = ThreadLocalRandom.current().nextLong() & PING_MASK;
+    private volatile int initialSessionWindow = DEFAULT_WINDOW_SIZE;
+    private volatile int initialStreamWindow = DEFAULT_WINDOW_SIZE;
+    private volatile int requestedStreamWindow;
+    private volatile long roundTripTime;
+    private volatile long bandwidth;
+    private volatile boolean pinging;
+    private long maxBandwidth;
+    private long pingSequence;
+    private long pingPayload;
+    private long pingNanoTime;
+    private int sampleBytes;
+    private int smallSamples;
+
+    public AdaptiveFlowControlStrategy()
+    {
+        this(new Factory());
+    }
+
+    public AdaptiveFlowControlStrategy(Factory factory)
+    {
+        this(DEFAULT_WINDOW_SIZE, factory);
+    }
+
+    public AdaptiveFlowControlStrategy(int initialStreamSendWindow, Factory factory)
+    {
+        super(initialStreamSendWindow);
+        this.factory = factory;
+        this.created = NanoTime.now();
+        this.pingNanoTime = created - TimeUnit.MILLISECONDS.toNanos(factory.getMinPingInterval());
+    }
+
+    @ManagedAttribute(value = "The current target of the session receive window", readonly = true)
+    public int getSessionRecvWindowTarget()
+    {
+        return sessionWindow.get();
+    }
+
+    @ManagedAttribute(value = "The smoothed round-trip time in microseconds", readonly = true)
+    public long getRoundTripTime()
+    {
+        return TimeUnit.NANOSECONDS.toMicros(roundTripTime);
+    }
+
+    @ManagedAttribute(value = "The last bandwidth sample in bytes per second", readonly = true)
+    public long getBandwidth()
+    {
+        return bandwidth;
+    }
+
+    @ManagedAttribute(value = "The memory reserved from the shared budget in bytes", readonly = true)
+    public long getReservedMemory()
+    {
+        return reservedMemory.get();
+    }
+
+    @ManagedAttribute(value = "The recent changes of the receive windows", readonly = true)
+    public List<String> getTrajectory()
+    {
+        try (AutoLock ignored = lock.lock())
+        {
+            List<String> result = new ArrayList<>(trajectory.size());
+            trajectory.forEach(adjustment -> result.add(adjustment.toString()));
+            return result;
+        }
+    }
+
+    @Override
+    public void onStreamCreated(Stream stream)
+    {
+        super.onStreamCreated(stream);
+        streamLevels.put(stream, new AtomicInteger());
+    }
+
+    @Override
+    public void onStreamDestroyed(Stream stream)
+    {
+        streamLevels.remove(stream);
+        super.onStreamDestroyed(stream);
+    }
+
+    @Override
+    public void updateInitialStreamWindow(Session session, int initialStreamWindow, boolean local)
+    {
+        // Track the values configured by the application, as they are the lower bound when shrinking.
+        if (local && initialStreamWindow != requestedStreamWindow)
+            this.initialStreamWindow = initialStreamWindow;
+        super.updateInitialStreamWindow(session, initialStreamWindow, local);
+    }
+
+    @Override
+    public void onDataReceived(Session session, Stream stream, int length)
+    {
+        super.onDataReceived(session, stream, length);
+
+        if (length <= 0)
+            return;
+
+        // This method and onPingReply() are called by the
+        // parser thread, so the sampling state is not shared.
+        long now = NanoTime.now();
+        if (pinging)
+        {
+            if (NanoTime.elapsed(pingNanoTime, now) < TimeUnit.MILLISECONDS.toNanos(factory.getPingTimeout()))
+            {
+                sampleBytes += length;
+                return;
+            }
+            // The PING reply was lost or is too late, discard the sample.
+            if (LOG.isDebugEnabled())
+                LOG.debug("Timed out ping {} for {}", pingSequence, session);
+            pinging = false;
+        }
+
+        if (NanoTime.elapsed(pingNanoTime, now) < TimeUnit.MILLISECONDS.toNanos(factory.getMinPingInterval()))
+            return;
+
+        pinging = true;
+        pingNanoTime = now;
+        sampleBytes = length;
+        pingPayload = pingPrefix | (++pingSequence & ~PING_MASK);
+        if (LOG.isDebugEnabled())
+            LOG.debug("Sampling bandwidth-delay product with ping {} for {}", pingSequence, session);
+        session.ping(new PingFrame(pingPayload, false), Callback.from(() -> {}, x -> pinging = false));
+    }
+
+    @Override
+    public boolean onPingReply(Session session, PingFrame frame)
+    {
+        long payload = frame.getPayloadAsLong();
+        if ((payload & PING_MASK) != pingPrefix)
+            return false;
+
+        // A reply to a PING that failed to be sent or that timed out is ignored.
+        if (pinging && payload == pingPayload)
+        {
+            long rtt = Math.max(1, NanoTime.since(pingNanoTime));
+            int bytes = sampleBytes;
+            pinging = false;
+            sample(session, bytes, rtt);
+        }
+        return true;
+    }
+
+    /**
+     * <p>Updates the receive windows from a sample of the bandwidth-delay product.</p>
+     *
+     * @param session the session
+     * @param bytes the bytes received during the round-trip
+     * @param rtt the round-trip time in nanoseconds
+     */
+    protected void sample(Session session, int bytes, long rtt)
+    {
+        long srtt = roundTripTime;
+        srtt = srtt == 0 ? rtt : (7 * srtt + rtt) / 8;
+        roundTripTime = srtt;
+        long bandwidth = bytes * TimeUnit.SECONDS.toNanos(1) / rtt;
+        this.bandwidth = bandwidth;
+
+        int target = sessionWindow.get();
+        int newTarget = target;
+        if (bytes >= target * 2L / 3 && bandwidth >= maxBandwidth)
+        {
+            // The window limits the throughput, enlarge it.
+            smallSamples = 0;
+            maxBandwidth = bandwidth;
+            newTarget = (int)Math.min(factory.getMaxSessionRecvWindow(), Math.max(target, 2L * bytes));
+        }
+        else if (bytes < target / 4)
+        {
+            // The window is larger than needed, shrink it
+            // only after a few samples to avoid oscillations.
+            if (++smallSamples >= factory.getShrinkSamples())
+            {
+                smallSamples = 0;
+                maxBandwidth = bandwidth;
+                newTarget = Math.max(initialSessionWindow, Math.max(2 * bytes, target / 2));
+            }
+        }
+        else
+        {
+            smallSamples = 0;
+        }
+
+        if (LOG.isDebugEnabled())
+            LOG.debug("Sampled {} bytes in {} us, bandwidth {} B/s, session recv window target {} -> {} for {}",
+                bytes, TimeUnit.NANOSECONDS.toMicros(rtt), bandwidth, target, newTarget, session);
+
+        boolean changed;
+        if (newTarget > target)
+            changed = grow(session, newTarget - target);
+        else if (newTarget < target)
+            changed = shrink(target - newTarget);
+        else
+            changed = false;
+        if (!changed)
+            return;
+
+        int streamWindow = updateStreamWindow(session, sessionWindow.get());
+        record(new Adjustment(NanoTime.millisSince(created), TimeUnit.NANOSECONDS.toMicros(srtt), bytes, bandwidth, sessionWindow.get(), streamWindow));
+    }
+
+    private boolean grow(Session session, int delta)
+    {
+        // Window withheld by a previous shrink has already been granted to the
+        // other peer, so it can be taken back without sending a window update.
+        int repaid = takeDebt(delta);
+        int grant = (int)factory.reserve(delta - repaid);
+        reservedMemory.addAndGet(grant);
+        sessionWindow.addAndGet(repaid + grant);
+        if (grant > 0)
+        {
+            pendingSessionUpdates.addAndGet(grant);
+            updateRecvWindow(session, grant);
+            sendWindowUpdate(session, null, List.of(new WindowUpdateFrame(0, grant)));
+        }
+        return repaid + grant > 0;
+    }
+
+    private boolean shrink(int delta)
+    {
+        // Window updates cannot be negative, so the excess
+        // is withheld from the updates of the data consumed.
+        sessionWindow.addAndGet(-delta);
+        sessionDebt.addAndGet(delta);
+        return true;
+    }
+
+    private int takeDebt(int max)
+    {
+        while (true)
+        {
+            int debt = sessionDebt.get();
+            int taken = Math.min(debt, max);
+            if (taken <= 0 || sessionDebt.compareAndSet(debt, debt - taken))
+                return Math.max(0, taken);
+        }
+    }
+
+    private void releaseMemory(long bytes)
+    {
+        while (true)
+        {
+            long reserved = reservedMemory.get();
+            long released = Math.min(reserved, bytes);
+            if (released <= 0)
+                return;
+            if (reservedMemory.compareAndSet(reserved, reserved - released))
+            {
+                factory.release(released);
+                return;
+            }
+        }
+    }
+
+    private int updateStreamWindow(Session session, int sessionWindow)
+    {
+        int streamWindow = Math.max(initialStreamWindow, Math.min(factory.getMaxStreamRecvWindow(), sessionWindow));
+        int requested = requestedStreamWindow;
+        int current = requested > 0 ? requested : getInitialStreamRecvWindow();
+        if (streamWindow != current)
+        {
+            requestedStreamWindow = streamWindow;
+            if (LOG.isDebugEnabled())
+                LOG.debug("Updating initial stream recv window {} -> {} for {}", current, streamWindow, session);
+            // The new value is applied locally when the SETTINGS frame is sent.
+            session.settings(new SettingsFrame(Map.of(SettingsFrame.INITIAL_WINDOW_SIZE, streamWindow), false), Callback.NOOP);
+        }
+        return streamWindow;
+    }
+
+    private void record(Adjustment adjustment)
+    {
+        try (AutoLock ignored = lock.lock())
+        {
+            while (trajectory.size() >= factory.getTrajectoryLength())
+            {
+                if (trajectory.pollFirst() == null)
+                    break;
+            }
+            if (factory.getTrajectoryLength() > 0)
+                trajectory.addLast(adjustment);
+        }
+    }
+
+    @Override
+    public void onDataConsumed(Session session, Stream stream, int length)
+    {
+        if (length <= 0)
+            return;
+
+        float ratio = factory.getBufferRatio();
+
+        int level = sessionLevel.addAndGet(length);
+        int maxLevel = (int)(sessionWindow.get() * ratio);
+        if (level > maxLevel)
+        {
+            if (sessionLevel.compareAndSet(level, 0))
+            {
+                int withheld = takeDebt(level);
+                releaseMemory(withheld);
+                int update = level - withheld;
+                if (update > 0)
+                {
+                    pendingSessionUpdates.addAndGet(update);
+                    updateRecvWindow(session, update);
+                    if (LOG.isDebugEnabled())
+                        LOG.debug("Data consumed, {} bytes, updated session recv window by {}/{} withheld {} for {}", length, update, maxLevel, withheld, session);
+                    sendWindowUpdate(session, null, List.of(new WindowUpdateFrame(0, update)));
+                }
+                else
+                {
+                    if (LOG.isDebugEnabled())
+                        LOG.debug("Data consumed, {} bytes, withheld session recv window update {}/{} for {}", length, withheld, maxLevel, session);
+                }
+            }
+            else
+            {
+                if (LOG.isDebugEnabled())
+                    LOG.debug("Data consumed, {} bytes, concurrent session recv window level {}/{} for {}", length, sessionLevel, maxLevel, session);
+            }
+        }
+        else
+        {
+            if (LOG.isDebugEnabled())
+                LOG.debug("Data consumed, {} bytes, session recv window level {}/{} for {}", length, level, maxLevel, session);
+        }
+
+        if (stream != null)
+        {
+            if (stream.isRemotelyClosed())
+            {
+                if (LOG.isDebugEnabled())
+                    LOG.debug("Data consumed, {} bytes, ignoring update stream recv window for remotely closed {}", length, stream);
+            }
+            else
+            {
+                AtomicInteger streamLevel = streamLevels.get(stream);
+                if (streamLevel != null)
+                {
+                    level = streamLevel.addAndGet(length);
+                    maxLevel = (int)(getInitialStreamRecvWindow() * ratio);
+                    if (level > maxLevel)
+                    {
+                        level = streamLevel.getAndSet(0);
+                        updateRecvWindow(stream, level);
+                        if (LOG.isDebugEnabled())
+                            LOG.debug("Data consumed, {} bytes, updated stream recv window by {}/{} for {}", length, level, maxLevel, stream);
+                        sendWindowUpdate(session, stream, List.of(new WindowUpdateFrame(stream.getId(), level)));
+                    }
+                    else
+                    {
+                        if (LOG.isDebugEnabled())
+                            LOG.debug("Data consumed, {} bytes, stream recv window level {}/{} for {}", length, level, maxLevel, stream);
+                    }
+                }
+            }
+        }
+    }
+
+    @Override
+    public void windowUpdate(Session session, Stream stream, WindowUpdateFrame frame)
+    {
+        super.windowUpdate(session, stream, frame);
+
+        if (frame.getStreamId() == 0)
+        {
+            // Session window updates not sent by this strategy, for example
+            // the one that sets the initial session receive window, enlarge
+            // both the current and the initial session receive window.
+            long pending = pendingSessionUpdates.addAndGet(-frame.getWindowDelta());
+            if (pending < 0)
+            {
+                pendingSessionUpdates.addAndGet(-pending);
+                sessionWindow.addAndGet((int)-pending);
+                initialSessionWindow += (int)-pending;
+            }
+        }
+    }
+
+    @Override
+    public void onSessionTerminated(Session session)
+    {
+        long reserved = reservedMemory.getAndSet(0);
+        if (reserved > 0)
+            factory.release(reserved);
+    }
+
+    @Override
+    public void reset()
+    {
+        super.reset();
+        try (AutoLock ignored = lock.lock())
+        {
+            trajectory.clear();
+        }
+    }
+
+    @Override
+    public void dump(Appendable out, String indent) throws IOException
+    {
+        Dumpable.dumpObjects(out, indent, this, new DumpableCollection("trajectory", getTrajectory()));
+    }
+
+    @Override
+    public String toString()
+    {
+        return String.format("%s@%x[sessionWindow=%d,streamWindow=%d,rtt=%dus,bandwidth=%dB/s,reserved=%d,sessionStallTime=%dms,streamsStallTime=%dms]",
+            getClass().getSimpleName(),
+            hashCode(),
+            getSessionRecvWindowTarget(),
+            getInitialStreamRecvWindow(),
+            getRoundTripTime(),
+            getBandwidth(),
+            getReservedMemory(),
+            getSessionStallTime(),
+            getStreamsStallTime());
+    }
+
+    private record Adjustment(long time, long rtt, int bytes, long bandwidth, int sessionWindow, int streamWindow)
+    {
+        @Override
+        public String toString()
+        {
+            return String.format("+%dms rtt=%dus sample=%dB bandwidth=%dB/s sessionWindow=%d streamWindow=%d", time, rtt, bytes, bandwidth, sessionWindow, streamWindow);
+        }
+    }
+
+    /**
+     * <p>A {@link FlowControlStrategy.Factory} for {@link AdaptiveFlowControlStrategy}
+     * that holds the configuration and the memory budget shared by the strategies
+     * it creates.</p>
+     * <p>The same factory instance may be configured on both {@code HTTP2Client}
+     * and the server connection factories to share the memory budget.</p>
+     */
+    @ManagedObject
+    public static class Factory implements FlowControlStrategy.Factory
+    {
+        private final AtomicLong reservedMemory = new AtomicLong();
+        private final long maxMemory;
+        private float bufferRatio = 0.5F;
+        private int maxSessionRecvWindow = 64 * 1024 * 1024;
+        private int maxStreamRecvWindow = 32 * 1024 * 1024;
+        private long minPingInterval = 100;
+        private long pingTimeout = 10_000;
+        private int shrinkSamples = 4;
+        private int trajectoryLength = 32;
+
+        /**
+         * <p>Creates a factory with a memory budget of a quarter of the max heap.</p>
+         */
+        public Factory()
+        {
+            this(Runtime.getRuntime().maxMemory() / 4);
+        }
+
+        /**
+         * @param maxMemory the max memory in bytes that all the strategies may reserve
+         * to enlarge the session receive windows beyond their initial value
+         */
+        public Factory(long maxMemory)
+        {
+            this.maxMemory = maxMemory;
+        }
+
+        @Override
+        public FlowControlStrategy newFlowControlStrategy()
+        {
+            return new AdaptiveFlowControlStrategy(this);
+        }
+
+        @ManagedAttribute(value = "The max memory in bytes that can be reserved to enlarge receive windows", readonly = true)
+        public long getMaxMemory()
+        {
+            return maxMemory;
+        }
+
+        @ManagedAttribute(value = "The memory in bytes reserved to enlarge receive windows", readonly = true)
+        public long getReservedMemory()
+        {
+            return reservedMemory.get();
+        }
+
+        @ManagedAttribute("The ratio between the receive buffer and the consume buffer")
+        public float getBufferRatio()
+        {
+            return bufferRatio;
+        }
+
+        public void setBufferRatio(float bufferRatio)
+        {
+            this.bufferRatio = bufferRatio;
+        }
+
+        @ManagedAttribute("The max size of the session receive window")
+        public int getMaxSessionRecvWindow()
+        {
+            return maxSessionRecvWindow;
+        }
+
+        public void setMaxSessionRecvWindow(int maxSessionRecvWindow)
+        {
+            this.maxSessionRecvWindow = maxSessionRecvWindow;
+        }
+
+        @ManagedAttribute("The max size of the stream receive windows")
+        public int getMaxStreamRecvWindow()
+        {
+            return maxStreamRecvWindow;
+        }
+
+        public void setMaxStreamRecvWindow(int maxStreamRecvWindow)
+        {
+            this.maxStreamRecvWindow = maxStreamRecvWindow;
+        }
+
+        @ManagedAttribute("The min interval in milliseconds between PING frames sent to sample the bandwidth-delay product")
+        public long getMinPingInterval()
+        {
+            return minPingInterval;
+        }
+
+        /**
+         * <p>Sets the min interval between PING frames sent to sample the bandwidth-delay product.</p>
+         * <p>The interval should be large enough to not trip the PING rate control of the other peer.</p>
+         *
+         * @param minPingInterval the min interval in milliseconds
+         */
+        public void setMinPingInterval(long minPingInterval)
+        {
+            this.minPingInterval = minPingInterval;
+        }
+
+        @ManagedAttribute("The timeout in milliseconds to wait for the reply to a PING frame sent to sample the bandwidth-delay product")
+        public long getPingTimeout()
+        {
+            return pingTimeout;
+        }
+
+        /**
+         * <p>Sets the timeout to wait for the reply to a PING frame sent to sample the bandwidth-delay product.</p>
+         * <p>When the timeout elapses, the sample is discarded so that the sampling does not stop
+         * if the PING reply is lost.</p>
+         *
+         * @param pingTimeout the ping timeout in milliseconds
+         */
+        public void setPingTimeout(long pingTimeout)
+        {
+            this.pingTimeout = pingTimeout;
+        }
+
+        @ManagedAttribute("The number of consecutive small samples that shrink the receive windows")
+        public int getShrinkSamples()
+        {
+            return shrinkSamples;
+        }
+
+        public void setShrinkSamples(int shrinkSamples)
+        {
+            this.shrinkSamples = shrinkSamples;
+        }
+
+        @ManagedAttribute("The number of window changes recorded by each strategy")
+        public int getTrajectoryLength()
+        {
+            return trajectoryLength;
+        }
+
+        public void setTrajectoryLength(int trajectoryLength)
+        {
+            this.trajectoryLength = trajectoryLength;
+        }
+
+        long reserve(long bytes)
+        {
+            if (bytes <= 0)
+                return 0;
+            while (true)
+            {
+                long reserved = reservedMemory.get();
+                long reserve = Math.min(bytes, maxMemory - reserved);
+                if (reserve <= 0)
+                    return 0;
+                if (reservedMemory.compareAndSet(reserved, reserved + reserve))
+                    return reserve;
+            }
+        }
+
+        void release(long bytes)
+        {
+            reservedMemory.addAndGet(-bytes);
+        }
+
+        @Override
+        public String toString()
+        {
+            return String.format("%s@%x[reserved=%d/%d]", getClass().getSimpleName(), hashCode(), getReservedMemory(), getMaxMemory());
+        }
+    }
+}
@@ -15,6 +15,7 @@ package org.eclipse.jetty.http2;
 
 import org.eclipse.jetty.http2.api.Session;
 import org.eclipse.jetty.http2.api.Stream;
+import org.eclipse.jetty.http2.frames.PingFrame;
 import org.eclipse.jetty.http2.frames.WindowUpdateFrame;
 
 public interface FlowControlStrategy
@@ -39,6 +40,31 @@ public interface FlowControlStrategy
 
     public void onDataSent(Stream stream, int length);
 
+    /**
+     * <p>Invoked when a PING reply is received.</p>
+     * <p>Strategies that send PING frames, for example to measure the round-trip
+     * time, can recognize and consume the replies to their own PING frames.</p>
+     *
+     * @param session the session
+     * @param frame the PING reply frame
+     * @return whether the PING reply was consumed by this strategy, in which
+     * case it is not notified to the application
+     */
+    public default boolean onPingReply(Session session, PingFrame frame)
+    {
+        return false;
+    }
+
+    /**
+     * <p>Invoked when the session is terminated, so that the resources
+     * associated with the session can be released.</p>
+     *
+     * @param session the terminated session
+     */
+    public default void onSessionTerminated(Session session)
+    {
+    }
+
     public interface Factory
     {
         public FlowControlStrategy newFlowControlStrategy();
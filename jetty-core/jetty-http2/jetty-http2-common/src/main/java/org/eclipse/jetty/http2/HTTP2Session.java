@@ -106,6 +106,8 @@ public abstract class HTTP2Session extends ContainerLifeCycle implements Session
     private long streamIdleTimeout;
     private int initialSessionRecvWindow;
     private int writeThreshold;
+    private int aggregationSize;
+    private long maxCoalesceDelay;
     private int maxEncoderTableCapacity;
     private boolean pushEnabled;
     private boolean connectProtocolEnabled;
@@ -125,6 +127,7 @@ public abstract class HTTP2Session extends ContainerLifeCycle implements Session
         this.sendWindow.set(FlowControlStrategy.DEFAULT_WINDOW_SIZE);
         this.recvWindow.set(FlowControlStrategy.DEFAULT_WINDOW_SIZE);
         this.writeThreshold = 32 * 1024;
+        this.aggregationSize = 16 * 1024;
         this.pushEnabled = true; // SPEC: by default, push is enabled.
         installBean(flowControl);
         installBean(flusher);
@@ -210,6 +213,49 @@ public abstract class HTTP2Session extends ContainerLifeCycle implements Session
         this.writeThreshold = writeThreshold;
     }
 
+    @ManagedAttribute("The size of the buffers that aggregate small frames before a TCP write")
+    public int getAggregationSize()
+    {
+        return aggregationSize;
+    }
+
+    /**
+     * <p>Sets the size of the buffers that aggregate small frames, possibly of
+     * different streams, before they are written.</p>
+     * <p>Aggregating small frames reduces the number of buffers of a write, and the
+     * number of TLS records when the connection is encrypted.
+     * The default value is the max size of a TLS record; a value of {@code 0}
+     * disables the aggregation.</p>
+     *
+     * @param aggregationSize the size of the aggregation buffers in bytes
+     */
+    public void setAggregationSize(int aggregationSize)
+    {
+        this.aggregationSize = aggregationSize;
+    }
+
+    @ManagedAttribute("The max time in microseconds spent coalescing frames before a TCP write")
+    public long getMaxCoalesceDelay()
+    {
+        return maxCoalesceDelay;
+    }
+
+    /**
+     * <p>Sets the max time spent coalescing, in the same write, the frames that
+     * are queued while the previous frames are being generated.</p>
+     * <p>Coalescing stops when the {@link #getWriteThreshold() write threshold}
+     * is reached, or when there are no more queued frames, so this is an upper
+     * bound on the latency added to the first frame of the write.
+     * The default value of {@code 0} disables coalescing, so that only the frames
+     * queued at the beginning of a write are written.</p>
+     *
+     * @param maxCoalesceDelay the max coalesce delay in microseconds
+     */
+    public void setMaxCoalesceDelay(long maxCoalesceDelay)
+    {
+        this.maxCoalesceDelay = maxCoalesceDelay;
+    }
+
     @ManagedAttribute("The HPACK encoder dynamic table maximum capacity")
     public int getMaxEncoderTableCapacity()
     {
@@ -472,7 +518,8 @@ public abstract class HTTP2Session extends ContainerLifeCycle implements Session
 
         if (frame.isReply())
         {
-            notifyPing(this, frame);
+            if (!flowControl.onPingReply(this, frame))
+                notifyPing(this, frame);
         }
         else
         {
@@ -1093,6 +1140,7 @@ public abstract class HTTP2Session extends ContainerLifeCycle implements Session
     {
         flusher.terminate(cause);
         streamTimeouts.destroy();
+        flowControl.onSessionTerminated(this);
         disconnect();
     }
 
@@ -1270,6 +1318,38 @@ public abstract class HTTP2Session extends ContainerLifeCycle implements Session
             return false;
         }
 
+        public HTTP2Stream getStream()
+        {
+            return stream;
+        }
+
+        /**
+         * @return the RFC 9218 urgency used to schedule this entry, or {@code -1}
+         * for the entries that are written before the stream content, such as
+         * control frames or the HEADERS frames that open streams
+         */
+        public int getUrgency()
+        {
+            if (stream == null)
+                return -1;
+            return switch (frame.getType())
+            {
+                case DATA -> stream.getUrgency();
+                case HEADERS -> stream.isCommitted() ? stream.getUrgency() : -1;
+                default -> -1;
+            };
+        }
+
+        /**
+         * @return whether this entry must not be written before the
+         * stream content queued before it, such as GOAWAY or RST_STREAM
+         */
+        public boolean isOrdered()
+        {
+            FrameType type = frame.getType();
+            return type == FrameType.GO_AWAY || type == FrameType.RST_STREAM;
+        }
+
         @Override
         public void failed(Throwable x)
         {
@@ -57,6 +57,11 @@ import org.slf4j.LoggerFactory;
 public class HTTP2Stream implements Stream, Attachable, Closeable, Callback, Dumpable, CyclicTimeouts.Expirable
 {
     private static final Logger LOG = LoggerFactory.getLogger(HTTP2Stream.class);
+    /**
+     * <p>The default RFC 9218 urgency of a stream.</p>
+     */
+    public static final int DEFAULT_URGENCY = 3;
+    private static final String PRIORITY = "priority";
 
     private final AutoLock lock = new AutoLock();
     private final Deque<Data> dataQueue = new ArrayDeque<>(1);
@@ -81,6 +86,9 @@ public class HTTP2Stream implements Stream, Attachable, Closeable, Callback, Dum
     private boolean committed;
     private long idleTimeout;
     private long expireNanoTime = Long.MAX_VALUE;
+    private volatile int urgency = DEFAULT_URGENCY;
+    // Streams without priority signals are interleaved with other streams.
+    private volatile boolean incremental = true;
 
     public HTTP2Stream(HTTP2Session session, int streamId, MetaData.Request request, boolean local)
     {
@@ -90,6 +98,45 @@ public class HTTP2Stream implements Stream, Attachable, Closeable, Callback, Dum
         this.local = local;
         this.dataLength = -1;
         this.dataStalled = true;
+        HttpFields fields = request == null ? null : request.getHttpFields();
+        String priority = fields == null ? null : fields.get(PRIORITY);
+        if (priority != null)
+            parsePriority(priority);
+    }
+
+    private void parsePriority(String value)
+    {
+        // RFC 9218 structured field dictionary, for example "u=5, i".
+        int urgency = DEFAULT_URGENCY;
+        boolean incremental = false;
+        for (String member : value.split(","))
+        {
+            int semicolon = member.indexOf(';');
+            if (semicolon >= 0)
+                member = member.substring(0, semicolon);
+            int equals = member.indexOf('=');
+            String key = (equals < 0 ? member : member.substring(0, equals)).trim();
+            String item = equals < 0 ? "?1" : member.substring(equals + 1).trim();
+            if ("u".equals(key))
+            {
+                try
+                {
+                    int u = Integer.parseInt(item);
+                    if (u >= 0 && u <= 7)
+                        urgency = u;
+                }
+                catch (NumberFormatException x)
+                {
+                    if (LOG.isDebugEnabled())
+                        LOG.debug("Ignoring invalid urgency {} for {}", item, this);
+                }
+            }
+            else if ("i".equals(key))
+            {
+                incremental = "?1".equals(item);
+            }
+        }
+        setPriority(urgency, incremental);
     }
 
     @Override
@@ -268,6 +315,42 @@ public class HTTP2Stream implements Stream, Attachable, Closeable, Callback, Dum
         committed = true;
     }
 
+    /**
+     * @return the RFC 9218 urgency of this stream, from {@code 0} (most urgent) to {@code 7}
+     */
+    public int getUrgency()
+    {
+        return urgency;
+    }
+
+    /**
+     * @return whether the content of this stream is interleaved with the content
+     * of other streams with the same urgency, as defined by RFC 9218
+     */
+    public boolean isIncremental()
+    {
+        return incremental;
+    }
+
+    /**
+     * <p>Sets the RFC 9218 priority parameters of this stream, used to choose
+     * which streams have their frames written first.</p>
+     * <p>The parameters are initialized from the {@code priority} request header,
+     * if present; streams without priority signals have the default urgency and
+     * are incremental.</p>
+     *
+     * @param urgency the urgency, from {@code 0} (most urgent) to {@code 7}
+     * @param incremental whether the content of this stream can be interleaved
+     * with the content of other streams with the same urgency
+     */
+    public void setPriority(int urgency, boolean incremental)
+    {
+        if (urgency < 0 || urgency > 7)
+            throw new IllegalArgumentException("Invalid urgency " + urgency);
+        this.urgency = urgency;
+        this.incremental = incremental;
+    }
+
     public boolean isCommitted()
     {
         return committed;
@@ -66,6 +66,11 @@ public class Generator
         return bufferPool;
     }
 
+    public boolean isUseDirectByteBuffers()
+    {
+        return headerGenerator.isUseDirectByteBuffers();
+    }
+
     public HpackEncoder getHpackEncoder()
     {
         return hpackEncoder;
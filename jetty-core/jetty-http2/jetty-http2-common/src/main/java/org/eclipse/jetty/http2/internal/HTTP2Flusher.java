@@ -24,15 +24,20 @@ import java.util.Iterator;
 import java.util.List;
 import java.util.Queue;
 import java.util.Set;
+import java.util.concurrent.TimeUnit;
 
 import org.eclipse.jetty.http2.FlowControlStrategy;
 import org.eclipse.jetty.http2.HTTP2Session;
 import org.eclipse.jetty.http2.HTTP2Stream;
 import org.eclipse.jetty.http2.frames.WindowUpdateFrame;
+import org.eclipse.jetty.http2.generator.Generator;
 import org.eclipse.jetty.http2.hpack.HpackException;
 import org.eclipse.jetty.io.ByteBufferPool;
 import org.eclipse.jetty.io.EofException;
+import org.eclipse.jetty.io.RetainableByteBuffer;
+import org.eclipse.jetty.util.BufferUtil;
 import org.eclipse.jetty.util.IteratingCallback;
+import org.eclipse.jetty.util.NanoTime;
 import org.eclipse.jetty.util.component.Dumpable;
 import org.eclipse.jetty.util.thread.AutoLock;
 import org.eclipse.jetty.util.thread.Invocable;
@@ -49,6 +54,7 @@ public class HTTP2Flusher extends IteratingCallback implements Dumpable
     private final Deque<HTTP2Session.Entry> entries = new ArrayDeque<>();
     private final Queue<HTTP2Session.Entry> pendingEntries = new ArrayDeque<>();
     private final Collection<HTTP2Session.Entry> processedEntries = new ArrayList<>();
+    private final List<RetainableByteBuffer> aggregates = new ArrayList<>();
     private final HTTP2Session session;
     private final ByteBufferPool.Accumulator accumulator;
     private InvocationType invocationType = InvocationType.NON_BLOCKING;
@@ -160,23 +166,7 @@ public class HTTP2Flusher extends IteratingCallback implements Dumpable
         if (LOG.isDebugEnabled())
             LOG.debug("Flushing {}", session);
 
-        try (AutoLock ignored = lock.lock())
-        {
-            if (terminated != null)
-                throw terminated;
-
-            WindowEntry windowEntry;
-            while ((windowEntry = windows.poll()) != null)
-            {
-                windowEntry.perform();
-            }
-
-            HTTP2Session.Entry entry;
-            while ((entry = entries.poll()) != null)
-            {
-                pendingEntries.offer(entry);
-            }
-        }
+        collect();
 
         if (pendingEntries.isEmpty())
         {
@@ -185,92 +175,139 @@ public class HTTP2Flusher extends IteratingCallback implements Dumpable
             return Action.IDLE;
         }
 
+        long begin = NanoTime.now();
+        int writeThreshold = session.getWriteThreshold();
         while (true)
         {
             boolean progress = false;
 
-            if (pendingEntries.isEmpty())
+            if (pendingEntries.isEmpty() && !coalesce(begin))
                 break;
 
-            Iterator<HTTP2Session.Entry> pending = pendingEntries.iterator();
-            while (pending.hasNext())
+            // Entries are processed by increasing urgency: less urgent
+            // entries are only processed when more urgent entries cannot
+            // make progress, for example because they are flow control stalled.
+            int urgencies = 0;
+            for (HTTP2Session.Entry entry : pendingEntries)
             {
-                HTTP2Session.Entry entry = pending.next();
-                if (LOG.isDebugEnabled())
-                    LOG.debug("Processing {}", entry);
+                urgencies |= 1 << (entry.getUrgency() + 1);
+            }
 
-                // If the stream has been reset or removed,
-                // don't send the frame and fail it here.
-                if (entry.shouldBeDropped())
+            while (urgencies != 0)
+            {
+                int urgency = Integer.numberOfTrailingZeros(urgencies) - 1;
+                urgencies &= urgencies - 1;
+
+                // SPEC: RFC 9218, non-incremental streams of the same
+                // urgency are written one at a time, in arrival order.
+                HTTP2Stream exclusive = null;
+                boolean generated = false;
+                boolean contentBefore = false;
+                Iterator<HTTP2Session.Entry> pending = pendingEntries.iterator();
+                while (pending.hasNext())
                 {
+                    HTTP2Session.Entry entry = pending.next();
+                    if (entry.getUrgency() != urgency)
+                    {
+                        if (urgency < 0 && !contentBefore)
+                            contentBefore = canProgress(entry);
+                        continue;
+                    }
+
+                    // Entries such as GOAWAY and RST_STREAM must not overtake
+                    // the stream content queued before them, and neither
+                    // must the control frames queued after them.
+                    if (contentBefore && entry.isOrdered())
+                        break;
+
+                    HTTP2Stream stream = entry.getStream();
+                    boolean sequential = urgency >= 0 && stream != null && !stream.isIncremental();
+                    if (sequential && exclusive != null && exclusive != stream)
+                        continue;
+
                     if (LOG.isDebugEnabled())
-                        LOG.debug("Dropped {}", entry);
-                    entry.failed(new EofException("dropped"));
-                    pending.remove();
-                    continue;
-                }
+                        LOG.debug("Processing {}", entry);
 
-                try
-                {
-                    if (entry.generate(accumulator))
+                    // If the stream has been reset or removed,
+                    // don't send the frame and fail it here.
+                    if (entry.shouldBeDropped())
                     {
                         if (LOG.isDebugEnabled())
-                            LOG.debug("Generated {} frame bytes for {}", entry.getFrameBytesGenerated(), entry);
-
+                            LOG.debug("Dropped {}", entry);
+                        entry.failed(new EofException("dropped"));
+                        pending.remove();
+                        // Dropping may unblock the ordered entries queued after this one.
                         progress = true;
-
-                        // We use ArrayList contains() + add() instead of HashSet add()
-                        // because that is faster for collections of size up to 250 entries.
-                        if (!processedEntries.contains(entry))
-                        {
-                            processedEntries.add(entry);
-                            invocationType = Invocable.combine(invocationType, Invocable.getInvocationType(entry.getCallback()));
-                        }
-
-                        if (entry.getDataBytesRemaining() == 0)
-                            pending.remove();
+                        continue;
                     }
-                    else
+
+                    try
                     {
-                        if (session.getSendWindow() <= 0 && stalledEntry == null)
+                        if (entry.generate(accumulator))
                         {
-                            stalledEntry = entry;
                             if (LOG.isDebugEnabled())
-                                LOG.debug("Flow control stalled at {}", entry);
-                            // Continue to process control frames.
+                                LOG.debug("Generated {} frame bytes for {}", entry.getFrameBytesGenerated(), entry);
+
+                            progress = true;
+                            generated = true;
+                            if (sequential)
+                                exclusive = stream;
+
+                            // We use ArrayList contains() + add() instead of HashSet add()
+                            // because that is faster for collections of size up to 250 entries.
+                            if (!processedEntries.contains(entry))
+                            {
+                                processedEntries.add(entry);
+                                invocationType = Invocable.combine(invocationType, Invocable.getInvocationType(entry.getCallback()));
+                            }
+
+                            if (entry.getDataBytesRemaining() == 0)
+                                pending.remove();
+                        }
+                        else
+                        {
+                            if (session.getSendWindow() <= 0 && stalledEntry == null)
+                            {
+                                stalledEntry = entry;
+                                if (LOG.isDebugEnabled())
+                                    LOG.debug("Flow control stalled at {}", entry);
+                                // Continue to process control frames.
+                            }
                         }
                     }
+                    catch (HpackException.StreamException failure)
+                    {
+                        if (LOG.isDebugEnabled())
+                            LOG.debug("Failure generating {}", entry, failure);
+                        entry.failed(failure);
+                        pending.remove();
+                    }
+                    catch (Throwable failure)
+                    {
+                        // Failure to generate the entry is catastrophic.
+                        if (LOG.isDebugEnabled())
+                            LOG.debug("Failure generating {}", entry, failure);
+                        failed(failure);
+                        return Action.SUCCEEDED;
+                    }
                 }
-                catch (HpackException.StreamException failure)
-                {
-                    if (LOG.isDebugEnabled())
-                        LOG.debug("Failure generating {}", entry, failure);
-                    entry.failed(failure);
-                    pending.remove();
-                }
-                catch (Throwable failure)
-                {
-                    // Failure to generate the entry is catastrophic.
-                    if (LOG.isDebugEnabled())
-                        LOG.debug("Failure generating {}", entry, failure);
-                    failed(failure);
-                    return Action.SUCCEEDED;
-                }
-            }
-
-            if (!progress)
-                break;
 
-            if (stalledEntry != null)
-                break;
+                if (generated)
+                    break;
+            }
 
-            int writeThreshold = session.getWriteThreshold();
             if (accumulator.getTotalLength() >= writeThreshold)
             {
                 if (LOG.isDebugEnabled())
                     LOG.debug("Write threshold {} exceeded", writeThreshold);
                 break;
             }
+
+            if (stalledEntry != null)
+                break;
+
+            if (!progress && !coalesce(begin))
+                break;
         }
 
         List<ByteBuffer> byteBuffers = accumulator.getByteBuffers();
@@ -280,19 +317,141 @@ public class HTTP2Flusher extends IteratingCallback implements Dumpable
             return Action.IDLE;
         }
 
+        // Compute the length before aggregation, which consumes the generated buffers.
+        long totalLength = LOG.isDebugEnabled() ? accumulator.getTotalLength() : -1;
+        ByteBuffer[] buffers = aggregate(byteBuffers);
+
         if (LOG.isDebugEnabled())
-            LOG.debug("Writing {} buffers ({} bytes) - entries processed/pending {}/{}: {}/{}",
-                byteBuffers.size(),
-                accumulator.getTotalLength(),
+            LOG.debug("Writing {} buffers ({} bytes, {} aggregated) - entries processed/pending {}/{}: {}/{}",
+                buffers.length,
+                totalLength,
+                aggregates.size(),
                 processedEntries.size(),
                 pendingEntries.size(),
                 processedEntries,
                 pendingEntries);
 
-        session.getEndPoint().write(this, byteBuffers.toArray(EMPTY_BYTE_BUFFERS));
+        session.getEndPoint().write(this, buffers);
         return Action.SCHEDULED;
     }
 
+    /**
+     * @param entry a stream content entry
+     * @return whether the entry can be generated, that is it is not flow control stalled
+     */
+    private boolean canProgress(HTTP2Session.Entry entry)
+    {
+        if (entry.getDataBytesRemaining() == 0)
+            return true;
+        HTTP2Stream stream = entry.getStream();
+        return session.getSendWindow() > 0 && (stream == null || stream.getSendWindow() > 0);
+    }
+
+    /**
+     * <p>Moves the queued entries to the pending entries.</p>
+     *
+     * @return whether there were queued entries
+     * @throws Throwable if this flusher has been terminated
+     */
+    private boolean collect() throws Throwable
+    {
+        try (AutoLock ignored = lock.lock())
+        {
+            if (terminated != null)
+                throw terminated;
+
+            WindowEntry windowEntry;
+            while ((windowEntry = windows.poll()) != null)
+            {
+                windowEntry.perform();
+            }
+
+            boolean collected = !entries.isEmpty();
+            HTTP2Session.Entry entry;
+            while ((entry = entries.poll()) != null)
+            {
+                pendingEntries.offer(entry);
+            }
+            return collected;
+        }
+    }
+
+    /**
+     * <p>Collects the entries queued after this cycle began at the given time,
+     * so that they are written together with the entries already generated.</p>
+     *
+     * @param begin the time this cycle began
+     * @return whether new entries have been collected, within the coalesce delay budget
+     * @throws Throwable if this flusher has been terminated
+     */
+    private boolean coalesce(long begin) throws Throwable
+    {
+        long maxCoalesceDelay = session.getMaxCoalesceDelay();
+        if (maxCoalesceDelay <= 0)
+            return false;
+        if (NanoTime.since(begin) >= TimeUnit.MICROSECONDS.toNanos(maxCoalesceDelay))
+            return false;
+        return collect();
+    }
+
+    /**
+     * <p>Copies runs of small buffers into pooled aggregation buffers,
+     * so that the write has fewer and larger buffers.</p>
+     *
+     * @param byteBuffers the generated buffers
+     * @return the buffers to write
+     */
+    private ByteBuffer[] aggregate(List<ByteBuffer> byteBuffers)
+    {
+        int aggregationSize = session.getAggregationSize();
+        int size = byteBuffers.size();
+        if (aggregationSize <= 0 || size < 2)
+            return byteBuffers.toArray(EMPTY_BYTE_BUFFERS);
+
+        // Buffers larger than this are written as they are,
+        // since the cost of copying them exceeds the gain.
+        int maxCopySize = aggregationSize / 4;
+        List<ByteBuffer> result = new ArrayList<>(size);
+        ByteBuffer aggregate = null;
+        int position = 0;
+        for (int i = 0; i < size; ++i)
+        {
+            ByteBuffer byteBuffer = byteBuffers.get(i);
+            int remaining = byteBuffer.remaining();
+            if (aggregate != null && (remaining > maxCopySize || remaining > aggregate.remaining()))
+            {
+                BufferUtil.flipToFlush(aggregate, position);
+                result.add(aggregate);
+                aggregate = null;
+            }
+
+            if (aggregate == null && remaining <= maxCopySize && i + 1 < size)
+            {
+                // Only aggregate runs of at least two small buffers.
+                int next = byteBuffers.get(i + 1).remaining();
+                if (next <= maxCopySize && remaining + next <= aggregationSize)
+                {
+                    Generator generator = session.getGenerator();
+                    RetainableByteBuffer buffer = generator.getByteBufferPool().acquire(aggregationSize, generator.isUseDirectByteBuffers());
+                    aggregates.add(buffer);
+                    aggregate = buffer.getByteBuffer();
+                    position = BufferUtil.flipToFill(aggregate);
+                }
+            }
+
+            if (aggregate != null)
+                aggregate.put(byteBuffer);
+            else
+                result.add(byteBuffer);
+        }
+        if (aggregate != null)
+        {
+            BufferUtil.flipToFlush(aggregate, position);
+            result.add(aggregate);
+        }
+        return result.toArray(EMPTY_BYTE_BUFFERS);
+    }
+
     public void onFlushed(long bytes) throws IOException
     {
         // A single EndPoint write may be flushed multiple times (for example with SSL).
@@ -319,6 +478,7 @@ public class HTTP2Flusher extends IteratingCallback implements Dumpable
     private void finish()
     {
         accumulator.release();
+        releaseAggregates();
 
         processedEntries.forEach(HTTP2Session.Entry::succeeded);
         processedEntries.clear();
@@ -349,6 +509,7 @@ public class HTTP2Flusher extends IteratingCallback implements Dumpable
     protected void onCompleteFailure(Throwable x)
     {
         accumulator.release();
+        releaseAggregates();
 
         Throwable closed;
         Set<HTTP2Session.Entry> allEntries;
@@ -378,6 +539,12 @@ public class HTTP2Flusher extends IteratingCallback implements Dumpable
             session.onWriteFailure(x);
     }
 
+    private void releaseAggregates()
+    {
+        aggregates.forEach(RetainableByteBuffer::release);
+        aggregates.clear();
+    }
+
     public void terminate(Throwable cause)
     {
         Throwable closed;
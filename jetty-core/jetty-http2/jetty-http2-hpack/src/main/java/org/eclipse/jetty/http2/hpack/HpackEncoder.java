@@ -28,6 +28,7 @@ import org.eclipse.jetty.http.HttpStatus;
 import org.eclipse.jetty.http.HttpVersion;
 import org.eclipse.jetty.http.MetaData;
 import org.eclipse.jetty.http.PreEncodedHttpField;
+import org.eclipse.jetty.http.compression.FieldIndexingPolicy;
 import org.eclipse.jetty.http.compression.HuffmanEncoder;
 import org.eclipse.jetty.http.compression.NBitIntegerEncoder;
 import org.eclipse.jetty.http.compression.NBitStringEncoder;
@@ -100,6 +101,7 @@ public class HpackEncoder
     private int _headerListSize;
     private boolean _validateEncoding = true;
     private boolean _maxDynamicTableSizeSent = false;
+    private FieldIndexingPolicy _indexingPolicy;
 
     public HpackEncoder()
     {
@@ -163,6 +165,24 @@ public class HpackEncoder
         return _context;
     }
 
+    public FieldIndexingPolicy getIndexingPolicy()
+    {
+        return _indexingPolicy;
+    }
+
+    /**
+     * <p>Sets the policy that decides which fields are inserted into the dynamic table.</p>
+     * <p>By default the policy is {@code null} and static heuristics are used: most fields
+     * are indexed the first time they are encoded, except for headers with frequently changing
+     * values such as {@code ETag} or {@code Last-Modified}.</p>
+     *
+     * @param indexingPolicy the indexing policy, or {@code null} to use the static heuristics
+     */
+    public void setIndexingPolicy(FieldIndexingPolicy indexingPolicy)
+    {
+        _indexingPolicy = indexingPolicy;
+    }
+
     public boolean isValidateEncoding()
     {
         return _validateEncoding;
@@ -357,6 +377,14 @@ public class HpackEncoder
                     if (_debug)
                         encoding = indexed ? "PreEncodedIdx" : "PreEncoded";
                 }
+                else if (_indexingPolicy != null)
+                {
+                    indexed = fieldSize < _context.getMaxDynamicTableSize() && _indexingPolicy.shouldIndex(field);
+                    encodeName(buffer, indexed ? (byte)0x40 : (byte)0x00, indexed ? 6 : 4, field.getName(), name);
+                    encodeValue(buffer, true, field.getValue());
+                    if (_debug)
+                        encoding = "Lit" + (name == null ? "HuffN" : "IdxN") + "HuffV" + (indexed ? "Idx" : "!Idx") + "Policy";
+                }
                 else if (name == null && fieldSize < _context.getMaxDynamicTableSize())
                 {
                     // unknown name and value that will fit in dynamic table, so let's index
@@ -394,6 +422,15 @@ public class HpackEncoder
                     if (_debug)
                         encoding = indexed ? "PreEncodedIdx" : "PreEncoded";
                 }
+                else if (_indexingPolicy != null && !NEVER_INDEX.contains(header))
+                {
+                    indexed = fieldSize < _context.getMaxDynamicTableSize() && _indexingPolicy.shouldIndex(field);
+                    boolean huffman = !DO_NOT_HUFFMAN.contains(header);
+                    encodeName(buffer, indexed ? (byte)0x40 : (byte)0x00, indexed ? 6 : 4, header.asString(), name);
+                    encodeValue(buffer, huffman, field.getValue());
+                    if (_debug)
+                        encoding = "Lit" + (name == null ? "HuffN" : "IdxN") + (huffman ? "HuffV" : "LitV") + (indexed ? "Idx" : "!Idx") + "Policy";
+                }
                 else if (DO_NOT_INDEX.contains(header))
                 {
                     // Non indexed field
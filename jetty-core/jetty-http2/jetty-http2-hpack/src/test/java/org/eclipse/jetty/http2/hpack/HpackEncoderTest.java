@@ -20,6 +20,7 @@ import org.eclipse.jetty.http.HttpFields;
 import org.eclipse.jetty.http.HttpHeader;
 import org.eclipse.jetty.http.HttpVersion;
 import org.eclipse.jetty.http.MetaData;
+import org.eclipse.jetty.http.compression.FieldIndexingPolicy;
 import org.eclipse.jetty.http.compression.NBitIntegerDecoder;
 import org.eclipse.jetty.util.BufferUtil;
 import org.hamcrest.Matchers;
@@ -195,6 +196,41 @@ public class HpackEncoderTest
         assertThat(ctx.getDynamicTableSize(), Matchers.is(dynamicTableSize));
     }
 
+    @Test
+    public void testAdaptiveIndexingPolicy()
+    {
+        HpackEncoder encoder = newHpackEncoder(38 * 5);
+        encoder.setIndexingPolicy(new FieldIndexingPolicy.Adaptive(2));
+        HpackContext ctx = encoder.getHpackContext();
+        ctx.resize(encoder.getMaxTableCapacity());
+
+        ByteBuffer buffer = BufferUtil.allocate(4096);
+
+        // The first occurrence of a field is not indexed.
+        int pos = BufferUtil.flipToFill(buffer);
+        encoder.encode(buffer, new HttpField("x-name", "value"));
+        encoder.encode(buffer, new HttpField(HttpHeader.ACCEPT, "text/plain"));
+        BufferUtil.flipToFlush(buffer, pos);
+        assertThat(ctx.getDynamicTableSize(), is(0));
+
+        // The second occurrence is indexed.
+        pos = BufferUtil.flipToFill(buffer);
+        encoder.encode(buffer, new HttpField("x-name", "value"));
+        encoder.encode(buffer, new HttpField(HttpHeader.ACCEPT, "text/plain"));
+        BufferUtil.flipToFlush(buffer, pos);
+        assertThat(ctx.size(), is(2));
+        assertThat(ctx.get(new HttpField("x-name", "value")), Matchers.notNullValue());
+
+        // Sensitive fields are never indexed.
+        pos = BufferUtil.flipToFill(buffer);
+        for (int i = 0; i < 3; i++)
+        {
+            encoder.encode(buffer, new HttpField(HttpHeader.AUTHORIZATION, "secret"));
+        }
+        BufferUtil.flipToFlush(buffer, pos);
+        assertThat(ctx.size(), is(2));
+    }
+
     @Test
     public void testNeverIndexSetCookie() throws Exception
     {
@@ -23,6 +23,7 @@ import java.util.concurrent.CompletableFuture;
 import java.util.concurrent.ConcurrentHashMap;
 import java.util.concurrent.atomic.AtomicReference;
 
+import org.eclipse.jetty.http.compression.FieldIndexingPolicy;
 import org.eclipse.jetty.http2.BufferingFlowControlStrategy;
 import org.eclipse.jetty.http2.FlowControlStrategy;
 import org.eclipse.jetty.http2.HTTP2Connection;
@@ -66,10 +67,13 @@ public abstract class AbstractHTTP2ServerConnectionFactory extends AbstractConne
     private final HttpConfiguration httpConfiguration;
     private int maxDecoderTableCapacity = HpackContext.DEFAULT_MAX_TABLE_CAPACITY;
     private int maxEncoderTableCapacity = HpackContext.DEFAULT_MAX_TABLE_CAPACITY;
+    private int aggregationSize = 16 * 1024;
+    private long maxCoalesceDelay;
     private int initialSessionRecvWindow = 1024 * 1024;
     private int initialStreamRecvWindow = 512 * 1024;
     private int maxConcurrentStreams = 128;
     private int maxHeaderBlockFragment = 0;
+    private int fieldIndexingMinOccurrences;
     private int maxFrameSize = Frame.DEFAULT_MAX_SIZE;
     private int maxSettingsKeys = SettingsFrame.DEFAULT_MAX_KEYS;
     private boolean connectProtocolEnabled = true;
@@ -117,6 +121,42 @@ public abstract class AbstractHTTP2ServerConnectionFactory extends AbstractConne
         this.maxEncoderTableCapacity = maxEncoderTableCapacity;
     }
 
+    @ManagedAttribute("The size of the buffers that aggregate small frames before a TCP write")
+    public int getAggregationSize()
+    {
+        return aggregationSize;
+    }
+
+    /**
+     * <p>Sets the size of the buffers that aggregate small frames, possibly
+     * of different streams, before they are written.</p>
+     * <p>Setting this value to {@code 0} disables the aggregation.</p>
+     *
+     * @param aggregationSize the size of the aggregation buffers in bytes
+     */
+    public void setAggregationSize(int aggregationSize)
+    {
+        this.aggregationSize = aggregationSize;
+    }
+
+    @ManagedAttribute("The max time in microseconds spent coalescing frames before a TCP write")
+    public long getMaxCoalesceDelay()
+    {
+        return maxCoalesceDelay;
+    }
+
+    /**
+     * <p>Sets the max time spent coalescing, in the same write, the frames
+     * that are queued while the previous frames are being generated.</p>
+     * <p>Setting this value to {@code 0} disables coalescing.</p>
+     *
+     * @param maxCoalesceDelay the max coalesce delay in microseconds
+     */
+    public void setMaxCoalesceDelay(long maxCoalesceDelay)
+    {
+        this.maxCoalesceDelay = maxCoalesceDelay;
+    }
+
     @ManagedAttribute("The HPACK decoder dynamic table maximum capacity")
     public int getMaxDecoderTableCapacity()
     {
@@ -172,6 +212,31 @@ public abstract class AbstractHTTP2ServerConnectionFactory extends AbstractConne
         this.maxHeaderBlockFragment = maxHeaderBlockFragment;
     }
 
+    @ManagedAttribute("The min occurrences of a field before the HPACK encoder indexes it, or 0 for the default heuristics")
+    public int getFieldIndexingMinOccurrences()
+    {
+        return fieldIndexingMinOccurrences;
+    }
+
+    /**
+     * <p>Sets the number of times a field must be encoded before the HPACK encoder
+     * inserts it into the dynamic table.</p>
+     * <p>The default value is {@code 0}, which means that the HPACK encoder uses its
+     * default heuristics and indexes any field that is not known to vary frequently.</p>
+     * <p>A value greater than {@code 0} configures an adaptive indexing policy that
+     * indexes only fields that are repeated across streams, so that fields that are
+     * never referenced again do not evict the ones that are.
+     * Whatever the value, {@code Authorization}, {@code Proxy-Authorization},
+     * {@code Set-Cookie} and {@code Set-Cookie2} are never indexed.</p>
+     *
+     * @param fieldIndexingMinOccurrences the min occurrences of a field before it is indexed
+     * @see FieldIndexingPolicy.Adaptive
+     */
+    public void setFieldIndexingMinOccurrences(int fieldIndexingMinOccurrences)
+    {
+        this.fieldIndexingMinOccurrences = fieldIndexingMinOccurrences;
+    }
+
     public FlowControlStrategy.Factory getFlowControlStrategyFactory()
     {
         return flowControlStrategyFactory;
@@ -303,6 +368,8 @@ public abstract class AbstractHTTP2ServerConnectionFactory extends AbstractConne
         ServerSessionListener listener = newSessionListener(connector, endPoint);
 
         Generator generator = new Generator(connector.getByteBufferPool(), isUseOutputDirectByteBuffers(), getMaxHeaderBlockFragment());
+        if (getFieldIndexingMinOccurrences() > 0)
+            generator.getHpackEncoder().setIndexingPolicy(new FieldIndexingPolicy.Adaptive(getFieldIndexingMinOccurrences()));
         FlowControlStrategy flowControl = getFlowControlStrategyFactory().newFlowControlStrategy();
 
         ServerParser parser = newServerParser(connector, getRateControlFactory().newRateControl(endPoint));
@@ -323,6 +390,8 @@ public abstract class AbstractHTTP2ServerConnectionFactory extends AbstractConne
         session.setStreamIdleTimeout(streamIdleTimeout);
         session.setInitialSessionRecvWindow(getInitialSessionRecvWindow());
         session.setWriteThreshold(getHttpConfiguration().getOutputBufferSize());
+        session.setAggregationSize(getAggregationSize());
+        session.setMaxCoalesceDelay(getMaxCoalesceDelay());
         session.setConnectProtocolEnabled(isConnectProtocolEnabled());
 
         HTTP2Connection connection = new HTTP2ServerConnection(connector,
@@ -0,0 +1,300 @@
+//
+// ========================================================================
+// Copyright (c) 1995 Mort Bay Consulting Pty Ltd and others.
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License v. 2.0 which is available at
+// https://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+// ========================================================================
+//
+
+package org.eclipse.jetty.http2.tests;
+
+import java.nio.ByteBuffer;
+import java.util.Map;
+import java.util.Random;
+import java.util.concurrent.CountDownLatch;
+import java.util.concurrent.TimeUnit;
+import java.util.concurrent.atomic.AtomicBoolean;
+import java.util.concurrent.atomic.AtomicInteger;
+import java.util.concurrent.atomic.AtomicReference;
+
+import org.eclipse.jetty.http.HttpFields;
+import org.eclipse.jetty.http.HttpVersion;
+import org.eclipse.jetty.http.MetaData;
+import org.eclipse.jetty.http2.AdaptiveFlowControlStrategy;
+import org.eclipse.jetty.http2.ErrorCode;
+import org.eclipse.jetty.http2.FlowControlStrategy;
+import org.eclipse.jetty.http2.HTTP2Session;
+import org.eclipse.jetty.http2.api.Session;
+import org.eclipse.jetty.http2.api.Stream;
+import org.eclipse.jetty.http2.api.server.ServerSessionListener;
+import org.eclipse.jetty.http2.frames.DataFrame;
+import org.eclipse.jetty.http2.frames.HeadersFrame;
+import org.eclipse.jetty.http2.frames.PingFrame;
+import org.eclipse.jetty.http2.frames.ResetFrame;
+import org.eclipse.jetty.util.Callback;
+import org.eclipse.jetty.util.Promise;
+import org.junit.jupiter.api.Test;
+
+import static org.awaitility.Awaitility.await;
+import static org.hamcrest.MatcherAssert.assertThat;
+import static org.hamcrest.Matchers.empty;
+import static org.hamcrest.Matchers.greaterThan;
+import static org.hamcrest.Matchers.hasSize;
+import static org.hamcrest.Matchers.is;
+import static org.junit.jupiter.api.Assertions.assertArrayEquals;
+import static org.junit.jupiter.api.Assertions.assertEquals;
+import static org.junit.jupiter.api.Assertions.assertTrue;
+
+public class AdaptiveFlowControlStrategyTest extends AbstractTest
+{
+    private AdaptiveFlowControlStrategy.Factory clientFlowControl;
+
+    @Override
+    protected void prepareClient()
+    {
+        super.prepareClient();
+        http2Client.setFlowControlStrategyFactory(clientFlowControl);
+    }
+
+    private static AdaptiveFlowControlStrategy.Factory newSamplingFactory(long maxMemory)
+    {
+        return new AdaptiveFlowControlStrategy.Factory(maxMemory)
+        {
+            @Override
+            public FlowControlStrategy newFlowControlStrategy()
+            {
+                return new SamplingFlowControlStrategy(this);
+            }
+        };
+    }
+
+    @Test
+    public void testWindowsGrowAndShrink() throws Exception
+    {
+        clientFlowControl = newSamplingFactory(1024 * 1024);
+        AtomicReference<HTTP2Session> serverSessionRef = new AtomicReference<>();
+        start(new ServerSessionListener()
+        {
+            @Override
+            public Map<Integer, Integer> onPreface(Session session)
+            {
+                serverSessionRef.set((HTTP2Session)session);
+                return null;
+            }
+        });
+
+        HTTP2Session clientSession = (HTTP2Session)newClientSession(new Session.Listener() {});
+        SamplingFlowControlStrategy flowControl = (SamplingFlowControlStrategy)clientSession.getFlowControlStrategy();
+        int initialWindow = FlowControlStrategy.DEFAULT_WINDOW_SIZE;
+        assertEquals(initialWindow, flowControl.getSessionRecvWindowTarget());
+
+        // A sample as large as the window means that the window limits the throughput.
+        flowControl.sampleMillis(clientSession, initialWindow, 10);
+
+        int grownWindow = 2 * initialWindow;
+        assertEquals(grownWindow, flowControl.getSessionRecvWindowTarget());
+        assertEquals(grownWindow, clientSession.getRecvWindow());
+        assertEquals(grownWindow - initialWindow, flowControl.getReservedMemory());
+        assertEquals(grownWindow - initialWindow, clientFlowControl.getReservedMemory());
+        await().atMost(5, TimeUnit.SECONDS).until(flowControl::getInitialStreamRecvWindow, is(grownWindow));
+        await().atMost(5, TimeUnit.SECONDS).until(() -> serverSessionRef.get().getSendWindow(), is(grownWindow));
+
+        // Small samples shrink the window back to its initial value.
+        for (int i = 0; i < clientFlowControl.getShrinkSamples(); ++i)
+        {
+            flowControl.sampleMillis(clientSession, 1024, 10);
+        }
+
+        assertEquals(initialWindow, flowControl.getSessionRecvWindowTarget());
+        await().atMost(5, TimeUnit.SECONDS).until(flowControl::getInitialStreamRecvWindow, is(initialWindow));
+        assertThat(flowControl.getTrajectory(), hasSize(2));
+
+        // The memory is released when the session is terminated.
+        clientSession.close(ErrorCode.NO_ERROR.code, null, Callback.NOOP);
+        await().atMost(5, TimeUnit.SECONDS).until(clientFlowControl::getReservedMemory, is(0L));
+    }
+
+    @Test
+    public void testMemoryBudgetIsShared() throws Exception
+    {
+        int maxMemory = 1024;
+        clientFlowControl = newSamplingFactory(maxMemory);
+        start(new ServerSessionListener() {});
+
+        HTTP2Session clientSession1 = (HTTP2Session)newClientSession(new Session.Listener() {});
+        SamplingFlowControlStrategy flowControl1 = (SamplingFlowControlStrategy)clientSession1.getFlowControlStrategy();
+        flowControl1.sampleMillis(clientSession1, FlowControlStrategy.DEFAULT_WINDOW_SIZE, 10);
+
+        assertEquals(FlowControlStrategy.DEFAULT_WINDOW_SIZE + maxMemory, flowControl1.getSessionRecvWindowTarget());
+        assertEquals(maxMemory, clientFlowControl.getReservedMemory());
+
+        // The budget is exhausted, so the other session cannot grow.
+        HTTP2Session clientSession2 = (HTTP2Session)newClientSession(new Session.Listener() {});
+        SamplingFlowControlStrategy flowControl2 = (SamplingFlowControlStrategy)clientSession2.getFlowControlStrategy();
+        flowControl2.sampleMillis(clientSession2, FlowControlStrategy.DEFAULT_WINDOW_SIZE, 10);
+
+        assertEquals(FlowControlStrategy.DEFAULT_WINDOW_SIZE, flowControl2.getSessionRecvWindowTarget());
+        assertThat(flowControl2.getTrajectory(), empty());
+        assertEquals(maxMemory, clientFlowControl.getReservedMemory());
+    }
+
+    @Test
+    public void testServerSendsBigContent() throws Exception
+    {
+        clientFlowControl = new AdaptiveFlowControlStrategy.Factory();
+        clientFlowControl.setMinPingInterval(0);
+        byte[] data = new byte[4 * 1024 * 1024];
+        new Random().nextBytes(data);
+
+        start(new ServerSessionListener()
+        {
+            @Override
+            public Stream.Listener onNewStream(Stream stream, HeadersFrame requestFrame)
+            {
+                MetaData.Response metaData = new MetaData.Response(200, null, HttpVersion.HTTP_2, HttpFields.EMPTY);
+                HeadersFrame responseFrame = new HeadersFrame(stream.getId(), metaData, null, false);
+                stream.headers(responseFrame)
+                    .thenAccept(s -> s.data(new DataFrame(s.getId(), ByteBuffer.wrap(data), true)));
+                return null;
+            }
+        });
+
+        AtomicInteger pings = new AtomicInteger();
+        Session session = newClientSession(new Session.Listener()
+        {
+            @Override
+            public void onPing(Session session, PingFrame frame)
+            {
+                pings.incrementAndGet();
+            }
+        });
+        MetaData.Request metaData = newRequest("GET", HttpFields.EMPTY);
+        HeadersFrame requestFrame = new HeadersFrame(metaData, null, true);
+        byte[] bytes = new byte[data.length];
+        CountDownLatch latch = new CountDownLatch(1);
+        session.newStream(requestFrame, new Promise.Adapter<>(), new Stream.Listener()
+        {
+            private int received;
+
+            @Override
+            public void onDataAvailable(Stream stream)
+            {
+                Stream.Data data = stream.readData();
+                DataFrame frame = data.frame();
+                int remaining = frame.remaining();
+                frame.getByteBuffer().get(bytes, received, remaining);
+                this.received += remaining;
+                data.release();
+                if (frame.isEndStream())
+                    latch.countDown();
+                else
+                    stream.demand();
+            }
+        });
+
+        assertTrue(latch.await(15, TimeUnit.SECONDS));
+        assertArrayEquals(data, bytes);
+        // The PING replies to the strategy PINGs are not notified to the application.
+        assertEquals(0, pings.get());
+    }
+
+    @Test
+    public void testLostPingReplyDoesNotStopSampling() throws Exception
+    {
+        AtomicBoolean dropped = new AtomicBoolean();
+        AtomicInteger samples = new AtomicInteger();
+        clientFlowControl = new AdaptiveFlowControlStrategy.Factory()
+        {
+            @Override
+            public FlowControlStrategy newFlowControlStrategy()
+            {
+                return new AdaptiveFlowControlStrategy(this)
+                {
+                    @Override
+                    public boolean onPingReply(Session session, PingFrame frame)
+                    {
+                        // Simulate the loss of the first PING reply.
+                        if (dropped.compareAndSet(false, true))
+                            return true;
+                        return super.onPingReply(session, frame);
+                    }
+
+                    @Override
+                    protected void sample(Session session, int bytes, long rtt)
+                    {
+                        samples.incrementAndGet();
+                        super.sample(session, bytes, rtt);
+                    }
+                };
+            }
+        };
+        clientFlowControl.setMinPingInterval(0);
+        clientFlowControl.setPingTimeout(100);
+
+        int chunks = 20;
+        start(new ServerSessionListener()
+        {
+            @Override
+            public Stream.Listener onNewStream(Stream stream, HeadersFrame requestFrame)
+            {
+                MetaData.Response metaData = new MetaData.Response(200, null, HttpVersion.HTTP_2, HttpFields.EMPTY);
+                stream.headers(new HeadersFrame(stream.getId(), metaData, null, false)).thenAccept(s -> new Thread(() ->
+                {
+                    try
+                    {
+                        for (int i = 0; i < chunks; ++i)
+                        {
+                            Thread.sleep(50);
+                            s.data(new DataFrame(s.getId(), ByteBuffer.allocate(1024), i == chunks - 1)).get(5, TimeUnit.SECONDS);
+                        }
+                    }
+                    catch (Throwable x)
+                    {
+                        s.reset(new ResetFrame(s.getId(), ErrorCode.INTERNAL_ERROR.code), Callback.NOOP);
+                    }
+                }).start());
+                return null;
+            }
+        });
+
+        Session session = newClientSession(new Session.Listener() {});
+        MetaData.Request metaData = newRequest("GET", HttpFields.EMPTY);
+        CountDownLatch latch = new CountDownLatch(1);
+        session.newStream(new HeadersFrame(metaData, null, true), new Promise.Adapter<>(), new Stream.Listener()
+        {
+            @Override
+            public void onDataAvailable(Stream stream)
+            {
+                Stream.Data data = stream.readData();
+                data.release();
+                if (data.frame().isEndStream())
+                    latch.countDown();
+                else
+                    stream.demand();
+            }
+        });
+
+        assertTrue(latch.await(15, TimeUnit.SECONDS));
+        assertTrue(dropped.get());
+        // The strategy gave up on the lost PING reply and sampled again.
+        assertThat(samples.get(), greaterThan(0));
+    }
+
+    private static class SamplingFlowControlStrategy extends AdaptiveFlowControlStrategy
+    {
+        private SamplingFlowControlStrategy(AdaptiveFlowControlStrategy.Factory factory)
+        {
+            super(factory);
+        }
+
+        private void sampleMillis(Session session, int bytes, long rttMillis)
+        {
+            sample(session, bytes, TimeUnit.MILLISECONDS.toNanos(rttMillis));
+        }
+    }
+}
@@ -15,9 +15,13 @@ package org.eclipse.jetty.http2.tests;
 
 import java.util.concurrent.CountDownLatch;
 import java.util.concurrent.TimeUnit;
+import java.util.concurrent.atomic.AtomicReference;
 
 import org.eclipse.jetty.http.HttpFields;
 import org.eclipse.jetty.http.MetaData;
+import org.eclipse.jetty.http.compression.FieldIndexingPolicy;
+import org.eclipse.jetty.http2.HTTP2Connection;
+import org.eclipse.jetty.http2.HTTP2Session;
 import org.eclipse.jetty.http2.api.Session;
 import org.eclipse.jetty.http2.api.Stream;
 import org.eclipse.jetty.http2.frames.HeadersFrame;
@@ -28,9 +32,13 @@ import org.eclipse.jetty.server.Request;
 import org.eclipse.jetty.server.Response;
 import org.eclipse.jetty.util.Callback;
 import org.eclipse.jetty.util.Promise;
+import org.junit.jupiter.api.Test;
 import org.junit.jupiter.params.ParameterizedTest;
 import org.junit.jupiter.params.provider.CsvSource;
 
+import static org.hamcrest.MatcherAssert.assertThat;
+import static org.hamcrest.Matchers.instanceOf;
+import static org.hamcrest.Matchers.nullValue;
 import static org.junit.jupiter.api.Assertions.assertEquals;
 import static org.junit.jupiter.api.Assertions.assertTrue;
 
@@ -182,4 +190,50 @@ public class DynamicTableTest extends AbstractTest
 
         assertTrue(latch.await(5, TimeUnit.SECONDS));
     }
+
+    @Test
+    public void testFieldIndexingMinOccurrences() throws Exception
+    {
+        AtomicReference<FieldIndexingPolicy> serverPolicy = new AtomicReference<>();
+        start(new Handler.Abstract()
+        {
+            @Override
+            public boolean handle(Request request, Response response, Callback callback)
+            {
+                HTTP2Connection connection = (HTTP2Connection)request.getConnectionMetaData().getConnection();
+                serverPolicy.set(connection.getSession().getGenerator().getHpackEncoder().getIndexingPolicy());
+                callback.succeeded();
+                return true;
+            }
+        });
+        connector.getConnectionFactory(AbstractHTTP2ServerConnectionFactory.class).setFieldIndexingMinOccurrences(3);
+        http2Client.setFieldIndexingMinOccurrences(2);
+
+        Session session = newClientSession(new Session.Listener() {});
+        MetaData.Request metaData = newRequest("GET", HttpFields.EMPTY);
+        HeadersFrame frame = new HeadersFrame(metaData, null, true);
+        CountDownLatch latch = new CountDownLatch(1);
+        session.newStream(frame, new Promise.Adapter<>(), new Stream.Listener()
+        {
+            @Override
+            public void onHeaders(Stream stream, HeadersFrame frame)
+            {
+                MetaData.Response response = (MetaData.Response)frame.getMetaData();
+                assertEquals(200, response.getStatus());
+                latch.countDown();
+            }
+        });
+        assertTrue(latch.await(5, TimeUnit.SECONDS));
+
+        FieldIndexingPolicy clientPolicy = ((HTTP2Session)session).getGenerator().getHpackEncoder().getIndexingPolicy();
+        assertThat(clientPolicy, instanceOf(FieldIndexingPolicy.Adaptive.class));
+        assertEquals(2, ((FieldIndexingPolicy.Adaptive)clientPolicy).getMinOccurrences());
+        assertThat(serverPolicy.get(), instanceOf(FieldIndexingPolicy.Adaptive.class));
+        assertEquals(3, ((FieldIndexingPolicy.Adaptive)serverPolicy.get()).getMinOccurrences());
+
+        // The default keeps the static heuristics of the encoder.
+        http2Client.setFieldIndexingMinOccurrences(0);
+        Session defaultSession = newClientSession(new Session.Listener() {});
+        assertThat(((HTTP2Session)defaultSession).getGenerator().getHpackEncoder().getIndexingPolicy(), nullValue());
+    }
 }
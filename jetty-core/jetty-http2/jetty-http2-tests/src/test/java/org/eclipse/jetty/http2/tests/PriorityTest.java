@@ -13,15 +13,24 @@
 
 package org.eclipse.jetty.http2.tests;
 
+import java.nio.ByteBuffer;
+import java.util.List;
+import java.util.concurrent.BlockingQueue;
+import java.util.concurrent.CopyOnWriteArrayList;
 import java.util.concurrent.CountDownLatch;
+import java.util.concurrent.LinkedBlockingDeque;
 import java.util.concurrent.TimeUnit;
 
 import org.eclipse.jetty.http.HttpFields;
+import org.eclipse.jetty.http.HttpStatus;
 import org.eclipse.jetty.http.HttpVersion;
 import org.eclipse.jetty.http.MetaData;
+import org.eclipse.jetty.http2.HTTP2Session;
+import org.eclipse.jetty.http2.HTTP2Stream;
 import org.eclipse.jetty.http2.api.Session;
 import org.eclipse.jetty.http2.api.Stream;
 import org.eclipse.jetty.http2.api.server.ServerSessionListener;
+import org.eclipse.jetty.http2.frames.DataFrame;
 import org.eclipse.jetty.http2.frames.HeadersFrame;
 import org.eclipse.jetty.http2.frames.PriorityFrame;
 import org.eclipse.jetty.util.Callback;
@@ -29,7 +38,10 @@ import org.eclipse.jetty.util.FuturePromise;
 import org.eclipse.jetty.util.Promise;
 import org.junit.jupiter.api.Test;
 
+import static org.hamcrest.MatcherAssert.assertThat;
+import static org.hamcrest.Matchers.lessThan;
 import static org.junit.jupiter.api.Assertions.assertEquals;
+import static org.junit.jupiter.api.Assertions.assertFalse;
 import static org.junit.jupiter.api.Assertions.assertNotNull;
 import static org.junit.jupiter.api.Assertions.assertTrue;
 
@@ -179,4 +191,130 @@ public class PriorityTest extends AbstractTest
 
         assertTrue(latch.await(5, TimeUnit.SECONDS));
     }
+
+    @Test
+    public void testPriorityHeaderSetsStreamUrgency() throws Exception
+    {
+        BlockingQueue<HTTP2Stream> serverStreams = new LinkedBlockingDeque<>();
+        start(new ServerSessionListener()
+        {
+            @Override
+            public Stream.Listener onNewStream(Stream stream, HeadersFrame frame)
+            {
+                serverStreams.offer((HTTP2Stream)stream);
+                MetaData.Response metaData = new MetaData.Response(200, null, HttpVersion.HTTP_2, HttpFields.EMPTY);
+                stream.headers(new HeadersFrame(stream.getId(), metaData, null, true), Callback.NOOP);
+                return null;
+            }
+        });
+
+        Session session = newClientSession(new Session.Listener() {});
+
+        session.newStream(new HeadersFrame(newRequest("GET", HttpFields.EMPTY), null, true), new Promise.Adapter<>(), null);
+        HTTP2Stream stream = serverStreams.poll(5, TimeUnit.SECONDS);
+        assertNotNull(stream);
+        assertEquals(HTTP2Stream.DEFAULT_URGENCY, stream.getUrgency());
+        assertTrue(stream.isIncremental());
+
+        HttpFields fields = HttpFields.build().put("priority", "u=1, i");
+        session.newStream(new HeadersFrame(newRequest("GET", fields), null, true), new Promise.Adapter<>(), null);
+        stream = serverStreams.poll(5, TimeUnit.SECONDS);
+        assertNotNull(stream);
+        assertEquals(1, stream.getUrgency());
+        assertTrue(stream.isIncremental());
+
+        fields = HttpFields.build().put("priority", "u=5");
+        session.newStream(new HeadersFrame(newRequest("GET", fields), null, true), new Promise.Adapter<>(), null);
+        stream = serverStreams.poll(5, TimeUnit.SECONDS);
+        assertNotNull(stream);
+        assertEquals(5, stream.getUrgency());
+        assertFalse(stream.isIncremental());
+    }
+
+    @Test
+    public void testMoreUrgentStreamIsWrittenFirst() throws Exception
+    {
+        CountDownLatch serverStreamsLatch = new CountDownLatch(2);
+        List<Stream> serverStreams = new CopyOnWriteArrayList<>();
+        start(new ServerSessionListener()
+        {
+            @Override
+            public Stream.Listener onNewStream(Stream stream, HeadersFrame frame)
+            {
+                serverStreams.add(stream);
+                serverStreamsLatch.countDown();
+                return null;
+            }
+        });
+
+        Session session = newClientSession(new Session.Listener() {});
+
+        BlockingQueue<Stream.Data> dataQueue = new LinkedBlockingDeque<>();
+        Stream.Listener streamListener = new Stream.Listener()
+        {
+            @Override
+            public void onDataAvailable(Stream stream)
+            {
+                Stream.Data data = stream.readData();
+                dataQueue.offer(data);
+                if (!data.frame().isEndStream())
+                    stream.demand();
+            }
+        };
+
+        HttpFields lowFields = HttpFields.build().put("priority", "u=7");
+        FuturePromise<Stream> lowPromise = new FuturePromise<>();
+        session.newStream(new HeadersFrame(newRequest("GET", lowFields), null, true), lowPromise, streamListener);
+        lowPromise.get(5, TimeUnit.SECONDS);
+
+        HttpFields highFields = HttpFields.build().put("priority", "u=0");
+        FuturePromise<Stream> highPromise = new FuturePromise<>();
+        session.newStream(new HeadersFrame(newRequest("GET", highFields), null, true), highPromise, streamListener);
+        highPromise.get(5, TimeUnit.SECONDS);
+
+        assertTrue(serverStreamsLatch.await(5, TimeUnit.SECONDS));
+        Stream lowStream = serverStreams.get(0);
+        Stream highStream = serverStreams.get(1);
+        int length = 2 * ((HTTP2Session)lowStream.getSession()).updateSendWindow(0);
+
+        MetaData.Response lowResponse = new MetaData.Response(HttpStatus.OK_200, null, HttpVersion.HTTP_2, HttpFields.EMPTY);
+        lowStream.headers(new HeadersFrame(lowStream.getId(), lowResponse, null, false), Callback.NOOP);
+        MetaData.Response highResponse = new MetaData.Response(HttpStatus.OK_200, null, HttpVersion.HTTP_2, HttpFields.EMPTY);
+        highStream.headers(new HeadersFrame(highStream.getId(), highResponse, null, false), new Callback()
+        {
+            @Override
+            public void succeeded()
+            {
+                // Write data for both streams from within the callback so that
+                // they get queued together, with the less urgent stream first.
+                lowStream.data(new DataFrame(lowStream.getId(), ByteBuffer.allocate(length), true), NOOP);
+                highStream.data(new DataFrame(highStream.getId(), ByteBuffer.allocate(length), true), NOOP);
+            }
+        });
+
+        int lowBytes = 0;
+        while (true)
+        {
+            Stream.Data data = dataQueue.poll(5, TimeUnit.SECONDS);
+            assertNotNull(data);
+            DataFrame frame = data.frame();
+            boolean high = frame.getStreamId() == highStream.getId();
+            boolean last = frame.isEndStream();
+            if (!high)
+                lowBytes += frame.remaining();
+            data.release();
+            if (high)
+            {
+                if (last)
+                    break;
+            }
+            else
+            {
+                assertFalse(last);
+            }
+        }
+
+        // The less urgent stream only gets the flow control window left over by the more urgent stream.
+        assertThat(lowBytes, lessThan(length / 2));
+    }
 }
@@ -13,6 +13,9 @@
 
 package org.eclipse.jetty.http3;
 
+import java.util.List;
+
+import org.eclipse.jetty.http.HttpField;
 import org.eclipse.jetty.util.annotation.ManagedAttribute;
 import org.eclipse.jetty.util.annotation.ManagedObject;
 
@@ -32,6 +35,8 @@ public class HTTP3Configuration
     private int maxEncoderTableCapacity = 64 * 1024;
     private int maxRequestHeadersSize = 8 * 1024;
     private int maxResponseHeadersSize = 8 * 1024;
+    private int fieldIndexingMinOccurrences;
+    private List<HttpField> encoderTableFields = List.of();
 
     @ManagedAttribute("The stream idle timeout in milliseconds")
     public long getStreamIdleTimeout()
@@ -221,4 +226,46 @@ public class HTTP3Configuration
     {
         this.maxResponseHeadersSize = maxResponseHeadersSize;
     }
+
+    @ManagedAttribute("The min occurrences of a field before the QPACK encoder indexes it, or 0 for the default heuristics")
+    public int getFieldIndexingMinOccurrences()
+    {
+        return fieldIndexingMinOccurrences;
+    }
+
+    /**
+     * <p>Sets the number of times a field must be encoded before the QPACK encoder
+     * inserts it into the dynamic table.</p>
+     * <p>The default value is {@code 0}, which means that the QPACK encoder uses its
+     * default heuristics and indexes any field that is not known to vary frequently.</p>
+     * <p>A value greater than {@code 0} configures an adaptive indexing policy that
+     * indexes only fields that are repeated across streams, which avoids filling the
+     * dynamic table (and blocking streams) with fields that are never referenced again.</p>
+     *
+     * @param fieldIndexingMinOccurrences the min occurrences of a field before it is indexed
+     * @see org.eclipse.jetty.http.compression.FieldIndexingPolicy.Adaptive
+     */
+    public void setFieldIndexingMinOccurrences(int fieldIndexingMinOccurrences)
+    {
+        this.fieldIndexingMinOccurrences = fieldIndexingMinOccurrences;
+    }
+
+    public List<HttpField> getEncoderTableFields()
+    {
+        return encoderTableFields;
+    }
+
+    /**
+     * <p>Sets the fields that the QPACK encoder inserts into the dynamic table
+     * as soon as the table capacity has been negotiated via the SETTINGS frame.</p>
+     * <p>Pre-populating the dynamic table is useful for long-lived connections,
+     * for example to upstream servers, where the same fields are sent by most
+     * requests, so that even the first requests can reference them.</p>
+     *
+     * @param encoderTableFields the fields to insert into the encoder dynamic table
+     */
+    public void setEncoderTableFields(List<HttpField> encoderTableFields)
+    {
+        this.encoderTableFields = encoderTableFields == null ? List.of() : List.copyOf(encoderTableFields);
+    }
 }
@@ -19,13 +19,17 @@ import java.nio.ByteBuffer;
 import java.util.ArrayList;
 import java.util.EnumSet;
 import java.util.HashMap;
+import java.util.Iterator;
 import java.util.List;
 import java.util.Map;
 
 import org.eclipse.jetty.http.HttpField;
 import org.eclipse.jetty.http.HttpHeader;
+import org.eclipse.jetty.http.HttpVersion;
 import org.eclipse.jetty.http.MetaData;
 import org.eclipse.jetty.http.PreEncodedHttpField;
+import org.eclipse.jetty.http.PreEncodedHttpFields;
+import org.eclipse.jetty.http.compression.FieldIndexingPolicy;
 import org.eclipse.jetty.http.compression.NBitIntegerEncoder;
 import org.eclipse.jetty.http3.qpack.internal.EncodableEntry;
 import org.eclipse.jetty.http3.qpack.internal.QpackContext;
@@ -99,6 +103,7 @@ public class QpackEncoder implements Dumpable
     private int _blockedStreams;
     private int _maxHeadersSize;
     private int _maxTableCapacity;
+    private FieldIndexingPolicy _indexingPolicy;
 
     public QpackEncoder(Instruction.Handler handler)
     {
@@ -122,6 +127,30 @@ public class QpackEncoder implements Dumpable
         _maxBlockedStreams = maxBlockedStreams;
     }
 
+    public FieldIndexingPolicy getIndexingPolicy()
+    {
+        return _indexingPolicy;
+    }
+
+    /**
+     * <p>Sets the policy that decides which fields are inserted into the dynamic table.</p>
+     * <p>By default the policy is {@code null} and all fields are inserted, except those
+     * with a header in {@link #DO_NOT_INDEX}.</p>
+     * <p>Whatever the policy, a field inserted into the dynamic table is only referenced
+     * before its insertion is acknowledged if that blocks at most
+     * {@link #getMaxBlockedStreams()} streams; otherwise the field is encoded literally
+     * and referenced by later field sections.</p>
+     *
+     * @param indexingPolicy the indexing policy, or {@code null} to use {@link #DO_NOT_INDEX}
+     */
+    public void setIndexingPolicy(FieldIndexingPolicy indexingPolicy)
+    {
+        try (AutoLock ignored = lock.lock())
+        {
+            _indexingPolicy = indexingPolicy;
+        }
+    }
+
     public int getMaxHeadersSize()
     {
         return _maxHeadersSize;
@@ -218,16 +247,48 @@ public class QpackEncoder implements Dumpable
 
             try
             {
-                int requiredInsertCount = 0;
-                for (HttpField field : new Http3Fields(metadata))
+                Iterator<HttpField> iterator = new Http3Fields(metadata).iterator();
+                HttpField next = iterator.hasNext() ? iterator.next() : null;
+                while (next != null)
                 {
-                    EncodableEntry entry = encode(streamInfo, field);
-                    encodableEntries.add(entry);
+                    HttpField field = next;
+                    next = iterator.hasNext() ? iterator.next() : null;
+
+                    PreEncodedHttpFields template = PreEncodedHttpFields.getTemplate(field);
+                    if (template == null || !template.isPreEncoded(HttpVersion.HTTP_3))
+                    {
+                        encodableEntries.add(encode(streamInfo, field));
+                        continue;
+                    }
+
+                    // Match the following fields with the template without copying them.
+                    int matched = 1;
+                    while (matched < template.size() && next == template.getField(matched))
+                    {
+                        ++matched;
+                        next = iterator.hasNext() ? iterator.next() : null;
+                    }
+
+                    if (matched == template.size())
+                    {
+                        // Copy the encoding of the whole template.
+                        encodableEntries.add(EncodableEntry.getPreEncodedEntry(template));
+                    }
+                    else
+                    {
+                        // The fields were modified, encode the matched fields one by one.
+                        for (int i = 0; i < matched; ++i)
+                        {
+                            encodableEntries.add(encode(streamInfo, template.getField(i)));
+                        }
+                    }
+                }
 
-                    // Update the required InsertCount.
-                    int entryRequiredInsertCount = entry.getRequiredInsertCount();
-                    if (entryRequiredInsertCount > requiredInsertCount)
-                        requiredInsertCount = entryRequiredInsertCount;
+                // Update the required InsertCount.
+                int requiredInsertCount = 0;
+                for (EncodableEntry entry : encodableEntries)
+                {
+                    requiredInsertCount = Math.max(requiredInsertCount, entry.getRequiredInsertCount());
                 }
 
                 // We should not expect section acknowledgements for 0 required insert count.
@@ -318,7 +379,9 @@ public class QpackEncoder implements Dumpable
                 field = new HttpField(field.getHeader(), field.getName(), "");
 
             // If we should not index this entry or there is no room to insert it, then just return false.
-            boolean canCreateEntry = shouldIndex(field) && dynamicTable.canInsert(field);
+            // An explicit insert is not subject to the indexing policy, except for sensitive fields.
+            boolean indexable = _indexingPolicy == null ? shouldIndex(field) : !FieldIndexingPolicy.NEVER_INDEX.contains(field.getHeader());
+            boolean canCreateEntry = indexable && dynamicTable.canInsert(field);
             if (!canCreateEntry)
                 return false;
 
@@ -371,6 +434,9 @@ public class QpackEncoder implements Dumpable
 
     protected boolean shouldIndex(HttpField httpField)
     {
+        FieldIndexingPolicy indexingPolicy = _indexingPolicy;
+        if (indexingPolicy != null)
+            return indexingPolicy.shouldIndex(httpField);
         return !DO_NOT_INDEX.contains(httpField.getHeader());
     }
 
@@ -389,27 +455,25 @@ public class QpackEncoder implements Dumpable
         if (field instanceof PreEncodedHttpField)
             return EncodableEntry.getPreEncodedEntry((PreEncodedHttpField)field);
 
-        boolean canCreateEntry = shouldIndex(field) && dynamicTable.canInsert(field);
-
+        // Look up the tables first, so that the indexing policy
+        // is not consulted for fields that are referenced as is.
         Entry entry = _context.get(field);
         if (referenceEntry(entry, streamInfo))
-        {
             return EncodableEntry.getReferencedEntry(entry);
-        }
-        else
-        {
-            // Should we duplicate this entry.
-            if (entry != null && canCreateEntry)
-            {
-                int index = _context.indexOf(entry);
-                Entry newEntry = new Entry(field);
-                dynamicTable.add(newEntry);
-                _instructions.add(new DuplicateInstruction(index));
 
-                // Should we reference this entry and risk blocking.
-                if (referenceEntry(newEntry, streamInfo))
-                    return EncodableEntry.getReferencedEntry(newEntry);
-            }
+        boolean canCreateEntry = shouldIndex(field) && dynamicTable.canInsert(field);
+
+        // Should we duplicate this entry.
+        if (entry != null && canCreateEntry)
+        {
+            int index = _context.indexOf(entry);
+            Entry newEntry = new Entry(field);
+            dynamicTable.add(newEntry);
+            _instructions.add(new DuplicateInstruction(index));
+
+            // Should we reference this entry and risk blocking.
+            if (referenceEntry(newEntry, streamInfo))
+                return EncodableEntry.getReferencedEntry(newEntry);
         }
 
         boolean huffman = shouldHuffmanEncode(field);
@@ -19,6 +19,7 @@ import java.util.Objects;
 import org.eclipse.jetty.http.HttpField;
 import org.eclipse.jetty.http.HttpVersion;
 import org.eclipse.jetty.http.PreEncodedHttpField;
+import org.eclipse.jetty.http.PreEncodedHttpFields;
 import org.eclipse.jetty.http.compression.NBitIntegerEncoder;
 import org.eclipse.jetty.http.compression.NBitStringEncoder;
 import org.eclipse.jetty.http3.qpack.internal.table.Entry;
@@ -45,6 +46,11 @@ public abstract class EncodableEntry
         return new PreEncodedEntry(httpField);
     }
 
+    public static EncodableEntry getPreEncodedEntry(PreEncodedHttpFields httpFields)
+    {
+        return new PreEncodedFieldsEntry(httpFields);
+    }
+
     public abstract void encode(ByteBuffer buffer, int base);
 
     public abstract int getRequiredSize(int base);
@@ -277,4 +283,33 @@ public abstract class EncodableEntry
             return 0;
         }
     }
+
+    private static class PreEncodedFieldsEntry extends EncodableEntry
+    {
+        private final PreEncodedHttpFields _httpFields;
+
+        public PreEncodedFieldsEntry(PreEncodedHttpFields httpFields)
+        {
+            _httpFields = httpFields;
+        }
+
+        @Override
+        public void encode(ByteBuffer buffer, int base)
+        {
+            _httpFields.putTo(buffer, HttpVersion.HTTP_3);
+        }
+
+        @Override
+        public int getRequiredSize(int base)
+        {
+            return _httpFields.getEncodedLength(HttpVersion.HTTP_3);
+        }
+
+        @Override
+        public int getRequiredInsertCount()
+        {
+            // Pre-encoded fields only reference the static table.
+            return 0;
+        }
+    }
 }
@@ -0,0 +1,135 @@
+//
+// ========================================================================
+// Copyright (c) 1995 Mort Bay Consulting Pty Ltd and others.
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License v. 2.0 which is available at
+// https://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+// ========================================================================
+//
+
+package org.eclipse.jetty.http3.qpack;
+
+import java.nio.ByteBuffer;
+import java.util.ArrayList;
+import java.util.List;
+
+import org.eclipse.jetty.http.HttpField;
+import org.eclipse.jetty.http.HttpHeader;
+import org.eclipse.jetty.http.MetaData;
+import org.eclipse.jetty.http.compression.FieldIndexingPolicy;
+import org.eclipse.jetty.http3.qpack.internal.instruction.LiteralNameEntryInstruction;
+import org.eclipse.jetty.http3.qpack.internal.instruction.SetCapacityInstruction;
+import org.eclipse.jetty.util.NanoTime;
+import org.junit.jupiter.api.BeforeEach;
+import org.junit.jupiter.api.Test;
+
+import static org.eclipse.jetty.http3.qpack.QpackTestUtil.encode;
+import static org.eclipse.jetty.http3.qpack.QpackTestUtil.toBuffer;
+import static org.eclipse.jetty.http3.qpack.QpackTestUtil.toMetaData;
+import static org.hamcrest.MatcherAssert.assertThat;
+import static org.hamcrest.Matchers.contains;
+import static org.hamcrest.Matchers.equalTo;
+import static org.hamcrest.Matchers.instanceOf;
+import static org.junit.jupiter.api.Assertions.assertFalse;
+import static org.junit.jupiter.api.Assertions.assertNull;
+import static org.junit.jupiter.api.Assertions.assertTrue;
+
+public class IndexingPolicyTest
+{
+    private QpackEncoder _encoder;
+    private QpackDecoder _decoder;
+    private TestDecoderHandler _decoderHandler;
+    private TestEncoderHandler _encoderHandler;
+
+    @BeforeEach
+    public void before() throws Exception
+    {
+        _encoderHandler = new TestEncoderHandler();
+        _decoderHandler = new TestDecoderHandler();
+        _encoder = new QpackEncoder(_encoderHandler);
+        _decoder = new QpackDecoder(_decoderHandler);
+        _decoder.setBeginNanoTimeSupplier(NanoTime::now);
+
+        _encoder.setMaxBlockedStreams(16);
+        _decoder.setMaxBlockedStreams(16);
+        int capacity = 1024;
+        _encoder.setMaxTableCapacity(capacity);
+        _encoder.setTableCapacity(capacity);
+        _decoder.setMaxTableCapacity(capacity);
+
+        Instruction instruction = _encoderHandler.getInstruction();
+        assertThat(instruction, instanceOf(SetCapacityInstruction.class));
+        _decoder.parseInstructions(toBuffer(instruction));
+    }
+
+    @Test
+    public void testAdaptivePolicyIndexesRepeatedFields() throws Exception
+    {
+        _encoder.setIndexingPolicy(new FieldIndexingPolicy.Adaptive(2));
+        HttpField field = new HttpField("x-tenant", "acme");
+
+        // The first occurrence is encoded as a literal, without inserting into the table.
+        ByteBuffer buffer = encode(_encoder, 0, toMetaData("GET", "/", "http", field));
+        assertNull(_encoderHandler.getInstruction());
+        assertTrue(_decoder.decode(0, buffer, _decoderHandler));
+        MetaData metaData = _decoderHandler.getMetaData();
+        assertThat(metaData.getHttpFields().get("x-tenant"), equalTo("acme"));
+
+        // The second occurrence inserts the field into the table.
+        buffer = encode(_encoder, 4, toMetaData("GET", "/", "http", field));
+        Instruction instruction = _encoderHandler.getInstruction();
+        assertThat(instruction, instanceOf(LiteralNameEntryInstruction.class));
+        assertNull(_encoderHandler.getInstruction());
+        _decoder.parseInstructions(toBuffer(instruction));
+        assertTrue(_decoder.decode(4, buffer, _decoderHandler));
+        metaData = _decoderHandler.getMetaData();
+        assertThat(metaData.getHttpFields().get("x-tenant"), equalTo("acme"));
+
+        // Subsequent occurrences reference the existing entry.
+        encode(_encoder, 8, toMetaData("GET", "/", "http", field));
+        assertNull(_encoderHandler.getInstruction());
+    }
+
+    @Test
+    public void testAdaptivePolicyNeverIndexesSensitiveFields() throws Exception
+    {
+        _encoder.setIndexingPolicy(new FieldIndexingPolicy.Adaptive(1));
+        HttpField field = new HttpField(HttpHeader.AUTHORIZATION, "Basic secret");
+
+        for (int i = 0; i < 3; i++)
+        {
+            encode(_encoder, i * 4L, toMetaData("GET", "/", "http", field));
+            assertNull(_encoderHandler.getInstruction());
+        }
+        assertFalse(_encoder.insert(field));
+    }
+
+    @Test
+    public void testPolicyNotConsultedForStaticTableFields() throws Exception
+    {
+        List<String> consulted = new ArrayList<>();
+        _encoder.setIndexingPolicy(field ->
+        {
+            consulted.add(field.getName());
+            return false;
+        });
+
+        // All the fields but x-tenant are fully matched in the static table.
+        HttpField accept = new HttpField(HttpHeader.ACCEPT, "*/*");
+        HttpField tenant = new HttpField("x-tenant", "acme");
+        encode(_encoder, 0, toMetaData("GET", "/", "http", accept, tenant));
+        assertThat(consulted, contains("x-tenant"));
+    }
+
+    @Test
+    public void testExplicitInsertBypassesPolicy()
+    {
+        _encoder.setIndexingPolicy(new FieldIndexingPolicy.Adaptive(100));
+        assertTrue(_encoder.insert(new HttpField("x-upstream", "backend-1")));
+        assertThat(_encoderHandler.getInstruction(), instanceOf(LiteralNameEntryInstruction.class));
+    }
+}
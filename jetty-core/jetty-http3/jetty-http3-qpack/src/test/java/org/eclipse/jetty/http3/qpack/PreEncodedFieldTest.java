@@ -16,11 +16,20 @@ package org.eclipse.jetty.http3.qpack;
 import java.nio.ByteBuffer;
 
 import org.eclipse.jetty.http.HttpField;
+import org.eclipse.jetty.http.HttpFields;
+import org.eclipse.jetty.http.HttpHeader;
 import org.eclipse.jetty.http.HttpVersion;
+import org.eclipse.jetty.http.MetaData;
 import org.eclipse.jetty.http.PreEncodedHttpField;
+import org.eclipse.jetty.http.PreEncodedHttpFields;
 import org.eclipse.jetty.http3.qpack.internal.EncodableEntry;
 import org.eclipse.jetty.util.BufferUtil;
+import org.eclipse.jetty.util.NanoTime;
 import org.junit.jupiter.api.Test;
+import org.junit.jupiter.params.ParameterizedTest;
+import org.junit.jupiter.params.provider.ValueSource;
+
+import static org.junit.jupiter.api.Assertions.assertEquals;
 
 public class PreEncodedFieldTest
 {
@@ -44,6 +53,39 @@ public class PreEncodedFieldTest
         assertEqual(buffer, encodedEntry);
     }
 
+    @ParameterizedTest
+    @ValueSource(booleans = {false, true})
+    public void testPreEncodedFieldsTemplate(boolean modified) throws Exception
+    {
+        PreEncodedHttpFields template = new PreEncodedHttpFields(HttpFields.build()
+            .put(HttpHeader.CONTENT_TYPE, "application/json")
+            .put(HttpHeader.CACHE_CONTROL, "no-store")
+            .put("X-Custom", "value"));
+        HttpFields.Mutable fields = HttpFields.build().add(template).put(HttpHeader.ETAG, "\"1\"");
+        // A modified template is encoded field by field.
+        if (modified)
+            fields.remove("X-Custom");
+
+        QpackEncoder encoder = new QpackEncoder(new TestEncoderHandler());
+        ByteBuffer buffer = BufferUtil.allocate(1024);
+        BufferUtil.clearToFill(buffer);
+        encoder.encode(buffer, 0, new MetaData.Response(200, null, HttpVersion.HTTP_3, fields));
+        BufferUtil.flipToFlush(buffer, 0);
+
+        TestDecoderHandler decoderHandler = new TestDecoderHandler();
+        QpackDecoder decoder = new QpackDecoder(decoderHandler);
+        decoder.setBeginNanoTimeSupplier(NanoTime::now);
+        decoder.decode(0, buffer, decoderHandler);
+
+        HttpFields decoded = decoderHandler.getMetaData().getHttpFields();
+        assertEquals(fields.size(), decoded.size());
+        for (int i = 0; i < fields.size(); ++i)
+        {
+            assertEquals(fields.getField(i).getName(), decoded.getField(i).getName());
+            assertEquals(fields.getField(i).getValue(), decoded.getField(i).getValue());
+        }
+    }
+
     public void assertEqual(ByteBuffer b1, ByteBuffer b2)
     {
         if (b1 == null || b2 == null)
@@ -17,6 +17,7 @@ import java.util.HashMap;
 import java.util.Map;
 import java.util.concurrent.CompletableFuture;
 
+import org.eclipse.jetty.http.compression.FieldIndexingPolicy;
 import org.eclipse.jetty.http3.ControlFlusher;
 import org.eclipse.jetty.http3.DecoderStreamConnection;
 import org.eclipse.jetty.http3.EncoderStreamConnection;
@@ -68,6 +69,8 @@ public class ServerHTTP3Session extends ServerProtocolSession
         InstructionFlusher encoderInstructionFlusher = new InstructionFlusher(quicSession, encoderEndPoint, EncoderStreamConnection.STREAM_TYPE);
         encoder = new QpackEncoder(new InstructionHandler(encoderInstructionFlusher));
         encoder.setMaxHeadersSize(configuration.getMaxResponseHeadersSize());
+        if (configuration.getFieldIndexingMinOccurrences() > 0)
+            encoder.setIndexingPolicy(new FieldIndexingPolicy.Adaptive(configuration.getFieldIndexingMinOccurrences()));
         addBean(encoder);
         if (LOG.isDebugEnabled())
             LOG.debug("created encoder stream #{} on {}", encoderStreamId, encoderEndPoint);
@@ -198,6 +201,9 @@ public class ServerHTTP3Session extends ServerProtocolSession
                     LOG.debug("ignored {} setting {}={}", Grease.isGreaseValue(key) ? "grease" : "unknown", key, value);
             }
         });
+
+        // Pre-populate the dynamic table, now that its capacity is known.
+        configuration.getEncoderTableFields().forEach(encoder::insert);
     }
 
     private void failControlStream(Throwable failure)
@@ -25,6 +25,8 @@ import java.util.concurrent.ConcurrentHashMap;
 import java.util.concurrent.CopyOnWriteArrayList;
 import java.util.concurrent.ThreadLocalRandom;
 import java.util.concurrent.atomic.AtomicBoolean;
+import java.util.concurrent.atomic.AtomicInteger;
+import java.util.concurrent.atomic.AtomicReferenceArray;
 import java.util.concurrent.atomic.LongAdder;
 import java.util.function.Consumer;
 import java.util.function.IntUnaryOperator;
@@ -35,11 +37,13 @@ import org.eclipse.jetty.io.internal.QueuedPool;
 import org.eclipse.jetty.util.BufferUtil;
 import org.eclipse.jetty.util.ConcurrentPool;
 import org.eclipse.jetty.util.Pool;
+import org.eclipse.jetty.util.ProcessorUtils;
 import org.eclipse.jetty.util.annotation.ManagedAttribute;
 import org.eclipse.jetty.util.annotation.ManagedObject;
 import org.eclipse.jetty.util.annotation.ManagedOperation;
 import org.eclipse.jetty.util.component.Dumpable;
 import org.eclipse.jetty.util.component.DumpableCollection;
+import org.eclipse.jetty.util.statistic.HistogramStatistic;
 import org.slf4j.Logger;
 import org.slf4j.LoggerFactory;
 
@@ -66,6 +70,7 @@ public class ArrayByteBufferPool implements ByteBufferPool, Dumpable
     private final long _maxDirectMemory;
     private final IntUnaryOperator _bucketIndexFor;
     private final AtomicBoolean _evictor = new AtomicBoolean(false);
+    private final HistogramStatistic _acquireSizes = new HistogramStatistic();
     private boolean _statisticsEnabled;
 
     /**
@@ -132,6 +137,25 @@ public class ArrayByteBufferPool implements ByteBufferPool, Dumpable
      * @param bucketCapacity a {@link IntUnaryOperator} that takes a bucket index and returns a capacity
      */
     protected ArrayByteBufferPool(int minCapacity, int factor, int maxCapacity, int maxBucketSize, long maxHeapMemory, long maxDirectMemory, IntUnaryOperator bucketIndexFor, IntUnaryOperator bucketCapacity)
+    {
+        this(minCapacity, factor, maxCapacity, maxBucketSize, maxHeapMemory, maxDirectMemory, bucketIndexFor, bucketCapacity, 0, 0);
+    }
+
+    /**
+     * Creates a new ArrayByteBufferPool with the given configuration.
+     *
+     * @param minCapacity the minimum ByteBuffer capacity
+     * @param factor the capacity factor
+     * @param maxCapacity the maximum ByteBuffer capacity
+     * @param maxBucketSize the maximum number of ByteBuffers for each bucket
+     * @param maxHeapMemory the max heap memory in bytes, -1 for unlimited memory or 0 to use default heuristic
+     * @param maxDirectMemory the max direct memory in bytes, -1 for unlimited memory or 0 to use default heuristic
+     * @param bucketIndexFor a {@link IntUnaryOperator} that takes a capacity and returns a bucket index
+     * @param bucketCapacity a {@link IntUnaryOperator} that takes a bucket index and returns a capacity
+     * @param shards the number of front cache shards for each bucket, or 0 to disable sharding
+     * @param shardCapacity the maximum number of ByteBuffers held by each front cache shard
+     */
+    protected ArrayByteBufferPool(int minCapacity, int factor, int maxCapacity, int maxBucketSize, long maxHeapMemory, long maxDirectMemory, IntUnaryOperator bucketIndexFor, IntUnaryOperator bucketCapacity, int shards, int shardCapacity)
     {
         if (minCapacity <= 0)
             minCapacity = 0;
@@ -153,8 +177,8 @@ public class ArrayByteBufferPool implements ByteBufferPool, Dumpable
         for (int i = 0; i < directArray.length; i++)
         {
             int capacity = Math.min(bucketCapacity.applyAsInt(i), maxCapacity);
-            directArray[i] = new RetainedBucket(capacity, maxBucketSize);
-            indirectArray[i] = new RetainedBucket(capacity, maxBucketSize);
+            directArray[i] = new RetainedBucket(capacity, maxBucketSize, shards, shardCapacity);
+            indirectArray[i] = new RetainedBucket(capacity, maxBucketSize, shards, shardCapacity);
         }
 
         _minCapacity = minCapacity;
@@ -186,6 +210,39 @@ public class ArrayByteBufferPool implements ByteBufferPool, Dumpable
         _statisticsEnabled = enabled;
     }
 
+    /**
+     * @return the statistic of the sizes passed to {@link #acquire(int, boolean)},
+     * recorded only when {@link #isStatisticsEnabled() statistics are enabled}
+     */
+    public HistogramStatistic getAcquireSizeStatistic()
+    {
+        return _acquireSizes;
+    }
+
+    @ManagedAttribute("The mean acquired buffer size")
+    public double getAcquireSizeMean()
+    {
+        return _acquireSizes.getMean();
+    }
+
+    @ManagedAttribute("The median acquired buffer size")
+    public long getAcquireSizeP50()
+    {
+        return _acquireSizes.getValueAtPercentile(50);
+    }
+
+    @ManagedAttribute("The 99th percentile of the acquired buffer size")
+    public long getAcquireSizeP99()
+    {
+        return _acquireSizes.getValueAtPercentile(99);
+    }
+
+    @ManagedAttribute("The max acquired buffer size")
+    public long getAcquireSizeMax()
+    {
+        return _acquireSizes.getMax();
+    }
+
     @ManagedAttribute("The minimum pooled buffer capacity")
     public int getMinCapacity()
     {
@@ -198,9 +255,18 @@ public class ArrayByteBufferPool implements ByteBufferPool, Dumpable
         return _maxCapacity;
     }
 
+    @ManagedAttribute("The number of front cache shards for each bucket")
+    public int getShards()
+    {
+        return _direct.length == 0 ? 0 : _direct[0].getShards();
+    }
+
     @Override
     public RetainableByteBuffer acquire(int size, boolean direct)
     {
+        if (isStatisticsEnabled())
+            _acquireSizes.record(size);
+
         RetainedBucket bucket = bucketFor(size, direct);
 
         // No bucket, return non-pooled.
@@ -209,8 +275,8 @@ public class ArrayByteBufferPool implements ByteBufferPool, Dumpable
 
         bucket.recordAcquire();
 
-        // Try to acquire a pooled entry.
-        Pool.Entry<RetainableByteBuffer> entry = bucket.getPool().acquire();
+        // Try to acquire a pooled entry, from the front cache first.
+        Pool.Entry<RetainableByteBuffer> entry = bucket.acquire();
         if (entry != null)
         {
             bucket.recordPooled();
@@ -258,7 +324,7 @@ public class ArrayByteBufferPool implements ByteBufferPool, Dumpable
 
         // Release the buffer and check the memory 1% of the times.
         int used = ((Buffer)buffer).use();
-        if (entry.release())
+        if (bucket.release(entry))
         {
             if (used % 100 == 0)
                checkMaxMemory(bucket, buffer.isDirect());
@@ -352,6 +418,24 @@ public class ArrayByteBufferPool implements ByteBufferPool, Dumpable
         return Arrays.stream(buckets).mapToLong(bucket -> bucket.getPool().size()).sum();
     }
 
+    @ManagedAttribute("The number of direct ByteBuffers held by the front cache shards")
+    public long getShardedDirectByteBufferCount()
+    {
+        return getShardedByteBufferCount(true);
+    }
+
+    @ManagedAttribute("The number of heap ByteBuffers held by the front cache shards")
+    public long getShardedHeapByteBufferCount()
+    {
+        return getShardedByteBufferCount(false);
+    }
+
+    private long getShardedByteBufferCount(boolean direct)
+    {
+        RetainedBucket[] buckets = direct ? _direct : _indirect;
+        return Arrays.stream(buckets).mapToLong(RetainedBucket::getShardedCount).sum();
+    }
+
     @ManagedAttribute("The number of pooled direct ByteBuffers that are available")
     public long getAvailableDirectByteBufferCount()
     {
@@ -367,7 +451,7 @@ public class ArrayByteBufferPool implements ByteBufferPool, Dumpable
     private long getAvailableByteBufferCount(boolean direct)
     {
         RetainedBucket[] buckets = direct ? _direct : _indirect;
-        return Arrays.stream(buckets).mapToLong(bucket -> bucket.getPool().getIdleCount()).sum();
+        return Arrays.stream(buckets).mapToLong(RetainedBucket::getIdleCount).sum();
     }
 
     @ManagedAttribute("The bytes retained by direct ByteBuffers")
@@ -386,7 +470,7 @@ public class ArrayByteBufferPool implements ByteBufferPool, Dumpable
     {
         long size = 0;
         for (RetainedBucket bucket : direct ? _direct : _indirect)
-            size += (long)bucket.getPool().getIdleCount() * bucket.getCapacity();
+            size += (long)bucket.getIdleCount() * bucket.getCapacity();
         return size;
     }
 
@@ -422,6 +506,7 @@ public class ArrayByteBufferPool implements ByteBufferPool, Dumpable
             out,
             indent,
             this,
+            Dumpable.named("acquireSizes", _acquireSizes),
             DumpableCollection.fromArray("direct", _direct),
             DumpableCollection.fromArray("indirect", _indirect));
     }
@@ -429,10 +514,11 @@ public class ArrayByteBufferPool implements ByteBufferPool, Dumpable
     @Override
     public String toString()
     {
-        return String.format("%s{min=%d,max=%d,buckets=%d,heap=%d/%d,direct=%d/%d}",
+        return String.format("%s{min=%d,max=%d,buckets=%d,shards=%d,heap=%d/%d,direct=%d/%d}",
             super.toString(),
             _minCapacity, _maxCapacity,
             _direct.length,
+            getShards(),
             getHeapMemory(), _maxHeapMemory,
             getDirectMemory(), _maxDirectMemory);
     }
@@ -445,10 +531,13 @@ public class ArrayByteBufferPool implements ByteBufferPool, Dumpable
         private final LongAdder _evicts = new LongAdder();
         private final LongAdder _removes = new LongAdder();
         private final LongAdder _releases = new LongAdder();
+        private final LongAdder _shardHits = new LongAdder();
         private final Pool<RetainableByteBuffer> _pool;
+        private final Shard[] _shards;
+        private final int _batch;
         private final int _capacity;
 
-        private RetainedBucket(int capacity, int poolSize)
+        private RetainedBucket(int capacity, int poolSize, int shards, int shardCapacity)
         {
             if (poolSize <= ConcurrentPool.OPTIMAL_MAX_SIZE)
                 _pool = new ConcurrentPool<>(ConcurrentPool.StrategyType.THREAD_ID, poolSize, e -> 1);
@@ -457,9 +546,141 @@ public class ArrayByteBufferPool implements ByteBufferPool, Dumpable
                     new ConcurrentPool<>(ConcurrentPool.StrategyType.THREAD_ID, ConcurrentPool.OPTIMAL_MAX_SIZE, e -> 1),
                     new QueuedPool<>(poolSize - ConcurrentPool.OPTIMAL_MAX_SIZE)
                 );
+            if (shards > 0 && shardCapacity > 0)
+            {
+                _shards = new Shard[shards];
+                for (int i = 0; i < shards; ++i)
+                {
+                    _shards[i] = new Shard(shardCapacity);
+                }
+            }
+            else
+            {
+                _shards = null;
+            }
+            _batch = Math.max(1, shardCapacity / 2);
             _capacity = capacity;
         }
 
+        private int getShards()
+        {
+            return _shards == null ? 0 : _shards.length;
+        }
+
+        private Shard shard()
+        {
+            return _shards[(int)(Thread.currentThread().getId() % _shards.length)];
+        }
+
+        /**
+         * <p>Acquires an entry from the front cache shard of the current thread,
+         * or from the shared pool, in which case the shard is also filled with
+         * a batch of idle entries so that the next acquires do not contend.</p>
+         *
+         * @return an acquired entry, or null if none is available
+         */
+        private Pool.Entry<RetainableByteBuffer> acquire()
+        {
+            if (_shards == null)
+                return _pool.acquire();
+
+            Shard shard = shard();
+            Pool.Entry<RetainableByteBuffer> entry = shard.poll();
+            if (entry != null)
+            {
+                if (isStatisticsEnabled())
+                    _shardHits.increment();
+                return entry;
+            }
+
+            entry = _pool.acquire();
+            if (entry == null)
+                return null;
+
+            for (int i = 1; i < _batch; ++i)
+            {
+                Pool.Entry<RetainableByteBuffer> fill = _pool.acquire();
+                if (fill == null)
+                    break;
+                if (!shard.offer(fill))
+                {
+                    releaseToPool(fill);
+                    break;
+                }
+            }
+            return entry;
+        }
+
+        /**
+         * <p>Releases an entry into the front cache shard of the current thread,
+         * or into the shared pool, in which case a batch of entries is also
+         * drained from the full shard back into the shared pool.</p>
+         *
+         * @param entry the entry to release
+         * @return whether the entry has been released
+         */
+        private boolean release(Pool.Entry<RetainableByteBuffer> entry)
+        {
+            if (_shards == null)
+                return entry.release();
+
+            Shard shard = shard();
+            if (shard.offer(entry))
+                return true;
+
+            for (int i = 1; i < _batch; ++i)
+            {
+                Pool.Entry<RetainableByteBuffer> drain = shard.poll();
+                if (drain == null)
+                    break;
+                releaseToPool(drain);
+            }
+            return entry.release();
+        }
+
+        private void releaseToPool(Pool.Entry<RetainableByteBuffer> entry)
+        {
+            if (!entry.release())
+            {
+                recordRemove();
+                entry.remove();
+            }
+        }
+
+        private Pool.Entry<RetainableByteBuffer> pollShards()
+        {
+            if (_shards == null)
+                return null;
+            int length = _shards.length;
+            int index = ThreadLocalRandom.current().nextInt(length);
+            for (int c = 0; c < length; ++c)
+            {
+                Pool.Entry<RetainableByteBuffer> entry = _shards[index++].poll();
+                if (entry != null)
+                    return entry;
+                if (index == length)
+                    index = 0;
+            }
+            return null;
+        }
+
+        private int getShardedCount()
+        {
+            if (_shards == null)
+                return 0;
+            int count = 0;
+            for (Shard shard : _shards)
+            {
+                count += shard.size();
+            }
+            return count;
+        }
+
+        private int getIdleCount()
+        {
+            return _pool.getIdleCount() + getShardedCount();
+        }
+
         public void recordAcquire()
         {
             if (isStatisticsEnabled())
@@ -508,11 +729,15 @@ public class ArrayByteBufferPool implements ByteBufferPool, Dumpable
 
         private int evict()
         {
-            Pool.Entry<RetainableByteBuffer> entry;
-            if (_pool instanceof BucketCompoundPool compound)
-                entry = compound.evict();
-            else
-                entry = _pool.acquire();
+            // Evict from the front cache shards first, as they hold idle entries.
+            Pool.Entry<RetainableByteBuffer> entry = pollShards();
+            if (entry == null)
+            {
+                if (_pool instanceof BucketCompoundPool compound)
+                    entry = compound.evict();
+                else
+                    entry = _pool.acquire();
+            }
 
             if (entry == null)
                 return 0;
@@ -531,6 +756,14 @@ public class ArrayByteBufferPool implements ByteBufferPool, Dumpable
             _evicts.reset();
             _removes.reset();
             _releases.reset();
+            _shardHits.reset();
+            while (true)
+            {
+                Pool.Entry<RetainableByteBuffer> entry = pollShards();
+                if (entry == null)
+                    break;
+                entry.remove();
+            }
             getPool().stream().forEach(Pool.Entry::remove);
         }
 
@@ -549,11 +782,15 @@ public class ArrayByteBufferPool implements ByteBufferPool, Dumpable
             long pooled = _pooled.longValue();
             long acquires = _acquires.longValue();
             float hitRatio = acquires == 0 ? Float.NaN : pooled * 100F / acquires;
-            return String.format("%s{capacity=%d,in-use=%d/%d,pooled/acquires=%d/%d(%.3f%%),non-pooled/evicts/removes/releases=%d/%d/%d/%d}",
+            int sharded = getShardedCount();
+            return String.format("%s{capacity=%d,in-use=%d/%d,sharded=%d/%d,shard-hits=%d,pooled/acquires=%d/%d(%.3f%%),non-pooled/evicts/removes/releases=%d/%d/%d/%d}",
                 super.toString(),
                 getCapacity(),
-                inUse,
+                inUse - sharded,
                 entries,
+                sharded,
+                getShards(),
+                _shardHits.longValue(),
                 pooled,
                 acquires,
                 hitRatio,
@@ -564,6 +801,60 @@ public class ArrayByteBufferPool implements ByteBufferPool, Dumpable
             );
         }
 
+        /**
+         * <p>A small, lock-free, front cache of idle entries, selected by thread affinity.</p>
+         * <p>The entries held by a shard are acquired from the shared pool, so that
+         * they cannot be acquired by other threads that are not mapped to this shard.</p>
+         */
+        private static class Shard
+        {
+            private final AtomicReferenceArray<Pool.Entry<RetainableByteBuffer>> _entries;
+            private final AtomicInteger _size = new AtomicInteger();
+
+            private Shard(int capacity)
+            {
+                _entries = new AtomicReferenceArray<>(capacity);
+            }
+
+            private Pool.Entry<RetainableByteBuffer> poll()
+            {
+                if (_size.get() == 0)
+                    return null;
+                int length = _entries.length();
+                for (int i = 0; i < length; ++i)
+                {
+                    Pool.Entry<RetainableByteBuffer> entry = _entries.get(i);
+                    if (entry != null && _entries.compareAndSet(i, entry, null))
+                    {
+                        _size.decrementAndGet();
+                        return entry;
+                    }
+                }
+                return null;
+            }
+
+            private boolean offer(Pool.Entry<RetainableByteBuffer> entry)
+            {
+                int length = _entries.length();
+                if (_size.get() >= length)
+                    return false;
+                for (int i = 0; i < length; ++i)
+                {
+                    if (_entries.get(i) == null && _entries.compareAndSet(i, null, entry))
+                    {
+                        _size.incrementAndGet();
+                        return true;
+                    }
+                }
+                return false;
+            }
+
+            private int size()
+            {
+                return _size.get();
+            }
+        }
+
         private static class BucketCompoundPool extends CompoundPool<RetainableByteBuffer>
         {
             private BucketCompoundPool(ConcurrentPool<RetainableByteBuffer> concurrentBucket, QueuedPool<RetainableByteBuffer> queuedBucket)
@@ -643,6 +934,52 @@ public class ArrayByteBufferPool implements ByteBufferPool, Dumpable
         }
     }
 
+    /**
+     * <p>A variant of the {@link ArrayByteBufferPool} that puts a small
+     * front cache in front of each bucket, sharded by thread affinity.</p>
+     * <p>Threads that repeatedly acquire and release buffers, such as
+     * selector threads, mostly hit their own shard, and only fill
+     * their shard from, or drain their shard to, the shared bucket
+     * in batches, reducing contention on the shared bucket.</p>
+     * <p>Buffers held by the shards are accounted as idle memory,
+     * so that {@code maxHeapMemory} and {@code maxDirectMemory}
+     * apply as for the non-sharded variant.</p>
+     */
+    public static class Sharded extends ArrayByteBufferPool
+    {
+        static final int DEFAULT_SHARD_CAPACITY = 8;
+
+        public Sharded()
+        {
+            this(0, -1, -1, Integer.MAX_VALUE, 0L, 0L, -1, -1);
+        }
+
+        /**
+         * @param minCapacity the minimum ByteBuffer capacity
+         * @param factor the capacity factor
+         * @param maxCapacity the maximum ByteBuffer capacity
+         * @param maxBucketSize the maximum number of ByteBuffers for each bucket
+         * @param maxHeapMemory the max heap memory in bytes, -1 for unlimited memory or 0 to use default heuristic
+         * @param maxDirectMemory the max direct memory in bytes, -1 for unlimited memory or 0 to use default heuristic
+         * @param shards the number of shards, or a non-positive value to use the number of available processors
+         * @param shardCapacity the max number of ByteBuffers for each shard, or a non-positive value to use the default
+         */
+        public Sharded(int minCapacity, int factor, int maxCapacity, int maxBucketSize, long maxHeapMemory, long maxDirectMemory, int shards, int shardCapacity)
+        {
+            super(minCapacity,
+                factor,
+                maxCapacity,
+                maxBucketSize,
+                maxHeapMemory,
+                maxDirectMemory,
+                null,
+                null,
+                shards > 0 ? shards : ProcessorUtils.availableProcessors(),
+                shardCapacity > 0 ? shardCapacity : DEFAULT_SHARD_CAPACITY
+            );
+        }
+    }
+
     /**
      * <p>A variant of {@link ArrayByteBufferPool} that tracks buffer
      * acquires/releases, useful to identify buffer leaks.</p>
@@ -26,6 +26,7 @@ import java.nio.channels.NetworkChannel;
 import java.nio.channels.SelectableChannel;
 import java.nio.channels.SelectionKey;
 import java.nio.channels.SocketChannel;
+import java.nio.channels.spi.SelectorProvider;
 import java.nio.file.Path;
 import java.time.Duration;
 import java.util.Map;
@@ -108,6 +109,7 @@ public class ClientConnector extends ContainerLifeCycle
     private boolean reusePort;
     private int receiveBufferSize = -1;
     private int sendBufferSize = -1;
+    private SelectorProvider selectorProvider = SelectorProvider.provider();
 
     public ClientConnector()
     {
@@ -385,6 +387,31 @@ public class ClientConnector extends ContainerLifeCycle
         this.sendBufferSize = sendBufferSize;
     }
 
+    /**
+     * @return the {@link SelectorProvider} used to open the selectors and the TCP/IP channels
+     */
+    @ManagedAttribute("The SelectorProvider")
+    public SelectorProvider getSelectorProvider()
+    {
+        return selectorProvider;
+    }
+
+    /**
+     * <p>Sets the {@link SelectorProvider} used to open the selectors and the
+     * {@link Transport#TCP_IP} channels, to plug in an alternative, possibly
+     * native, selector implementation in place of the JVM default.</p>
+     * <p>Channels created by other {@link Transport}s must be opened by the
+     * same {@link SelectorProvider}.</p>
+     *
+     * @param selectorProvider the {@link SelectorProvider}, or null for the JVM default
+     */
+    public void setSelectorProvider(SelectorProvider selectorProvider)
+    {
+        if (isStarted())
+            throw new IllegalStateException(getState());
+        this.selectorProvider = selectorProvider == null ? SelectorProvider.provider() : selectorProvider;
+    }
+
     @Override
     protected void doStart() throws Exception
     {
@@ -402,6 +429,7 @@ public class ClientConnector extends ContainerLifeCycle
             setSslContextFactory(newSslContextFactory());
         selectorManager = newSelectorManager();
         selectorManager.setConnectTimeout(getConnectTimeout().toMillis());
+        selectorManager.setSelectorProvider(getSelectorProvider());
         addBean(selectorManager);
         super.doStart();
     }
@@ -438,7 +466,10 @@ public class ClientConnector extends ContainerLifeCycle
                 address = transport.getSocketAddress();
             context.putIfAbsent(REMOTE_SOCKET_ADDRESS_CONTEXT_KEY, address);
 
-            channel = transport.newSelectableChannel();
+            if (transport == Transport.TCP_IP)
+                channel = getSelectorProvider().openSocketChannel();
+            else
+                channel = transport.newSelectableChannel();
             configure(channel);
 
             if (channel instanceof NetworkChannel networkChannel)
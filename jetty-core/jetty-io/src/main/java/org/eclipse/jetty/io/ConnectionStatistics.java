@@ -26,8 +26,8 @@ import org.eclipse.jetty.util.annotation.ManagedOperation;
 import org.eclipse.jetty.util.component.AbstractLifeCycle;
 import org.eclipse.jetty.util.component.Dumpable;
 import org.eclipse.jetty.util.statistic.CounterStatistic;
+import org.eclipse.jetty.util.statistic.HistogramStatistic;
 import org.eclipse.jetty.util.statistic.RateCounter;
-import org.eclipse.jetty.util.statistic.SampleStatistic;
 
 /**
  * <p>A {@link Connection.Listener} that tracks connection statistics.</p>
@@ -160,6 +160,12 @@ public class ConnectionStatistics extends AbstractLifeCycle implements Connectio
         return _stats.getConnectionDurationStdDev();
     }
 
+    @ManagedAttribute("The 99th percentile of the duration of a connection in ms")
+    public long getConnectionDurationP99()
+    {
+        return _stats.getConnectionDurationP99();
+    }
+
     @ManagedAttribute("The total number of connections opened")
     public long getConnectionsTotal()
     {
@@ -225,7 +231,7 @@ public class ConnectionStatistics extends AbstractLifeCycle implements Connectio
     public static class Stats implements Dumpable
     {
         private final CounterStatistic _connections = new CounterStatistic();
-        private final SampleStatistic _connectionsDuration = new SampleStatistic();
+        private final HistogramStatistic _connectionsDuration = new HistogramStatistic();
         private final LongAdder _bytesIn = new LongAdder();
         private final RateCounter _bytesInRate = new RateCounter();
         private final LongAdder _bytesOut = new LongAdder();
@@ -299,6 +305,16 @@ public class ConnectionStatistics extends AbstractLifeCycle implements Connectio
             return _connectionsDuration.getStdDev();
         }
 
+        public long getConnectionDurationP99()
+        {
+            return _connectionsDuration.getValueAtPercentile(99);
+        }
+
+        public HistogramStatistic getConnectionDurationStatistic()
+        {
+            return _connectionsDuration;
+        }
+
         public long getConnectionsTotal()
         {
             return _connections.getTotal();
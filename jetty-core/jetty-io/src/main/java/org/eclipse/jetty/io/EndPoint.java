@@ -18,6 +18,7 @@ import java.io.IOException;
 import java.net.InetSocketAddress;
 import java.net.SocketAddress;
 import java.nio.ByteBuffer;
+import java.nio.channels.FileChannel;
 import java.nio.channels.ReadPendingException;
 import java.nio.channels.WritePendingException;
 import java.security.cert.X509Certificate;
@@ -318,6 +319,35 @@ public interface EndPoint extends Closeable
         write(callback, buffers);
     }
 
+    /**
+     * @return whether this EndPoint supports {@link #transfer(Callback, FileChannel, long, long, ByteBuffer...)},
+     * which is typically only the case for EndPoints that write the bytes unmodified to a network channel.
+     */
+    default boolean isTransferSupported()
+    {
+        return false;
+    }
+
+    /**
+     * <p>Writes the given buffers followed by the given region of a file, and invokes the callback
+     * methods when either all the data has been written or an error occurs.</p>
+     * <p>The region of the file is written without being copied to user space buffers when the
+     * platform supports it, for example via {@link FileChannel#transferTo(long, long, java.nio.channels.WritableByteChannel)}.
+     * The file channel is not closed by this method.</p>
+     *
+     * @param callback the callback to call when an error occurs or the write completed
+     * @param file the file to write the region of
+     * @param position the position within the file of the region
+     * @param length the length of the region
+     * @param buffers zero or more {@link ByteBuffer}s to be written before the file region
+     * @throws WritePendingException if another write operation is concurrent.
+     * @see #isTransferSupported()
+     */
+    default void transfer(Callback callback, FileChannel file, long position, long length, ByteBuffer... buffers) throws WritePendingException
+    {
+        throw new UnsupportedOperationException();
+    }
+
     /**
      * @return the {@link Connection} associated with this EndPoint
      * @see #setConnection(Connection)
@@ -26,9 +26,9 @@ import java.time.ZonedDateTime;
 import java.time.format.DateTimeFormatter;
 import java.util.ArrayDeque;
 import java.util.ArrayList;
+import java.util.Arrays;
 import java.util.Collections;
 import java.util.Deque;
-import java.util.Iterator;
 import java.util.List;
 import java.util.Locale;
 import java.util.Objects;
@@ -38,17 +38,20 @@ import java.util.concurrent.Executor;
 import java.util.concurrent.RejectedExecutionException;
 import java.util.concurrent.TimeUnit;
 import java.util.concurrent.atomic.AtomicBoolean;
+import java.util.function.Consumer;
 
 import org.eclipse.jetty.util.IO;
+import org.eclipse.jetty.util.NanoTime;
 import org.eclipse.jetty.util.annotation.ManagedAttribute;
 import org.eclipse.jetty.util.annotation.ManagedOperation;
 import org.eclipse.jetty.util.component.ContainerLifeCycle;
 import org.eclipse.jetty.util.component.Dumpable;
 import org.eclipse.jetty.util.component.DumpableCollection;
-import org.eclipse.jetty.util.statistic.SampleStatistic;
+import org.eclipse.jetty.util.statistic.HistogramStatistic;
 import org.eclipse.jetty.util.thread.AutoLock;
 import org.eclipse.jetty.util.thread.ExecutionStrategy;
 import org.eclipse.jetty.util.thread.Scheduler;
+import org.eclipse.jetty.util.thread.WorkStealingThreadPool;
 import org.eclipse.jetty.util.thread.strategy.AdaptiveExecutionStrategy;
 import org.slf4j.Logger;
 import org.slf4j.LoggerFactory;
@@ -58,6 +61,9 @@ import org.slf4j.LoggerFactory;
  * <p>{@link ManagedSelector} runs the select loop, which waits on {@link Selector#select()} until events
  * happen for registered channels. When events happen, it notifies the {@link EndPoint} associated
  * with the channel.</p>
+ * <p>Selected keys are collected into a reusable array via {@link Selector#select(Consumer)},
+ * rather than via the {@link Selector#selectedKeys() selected-key set}, so that each select
+ * cycle does not add and remove keys from a {@link Set}, nor allocates an {@link java.util.Iterator}.</p>
  */
 public class ManagedSelector extends ContainerLifeCycle implements Dumpable
 {
@@ -84,10 +90,13 @@ public class ManagedSelector extends ContainerLifeCycle implements Dumpable
     private final SelectorManager _selectorManager;
     private final int _id;
     private final ExecutionStrategy _strategy;
+    private final Executor _groupExecutor;
     private Selector _selector;
     private Deque<SelectorUpdate> _updates = new ArrayDeque<>();
     private Deque<SelectorUpdate> _updateable = new ArrayDeque<>();
-    private final SampleStatistic _keyStats = new SampleStatistic();
+    private final HistogramStatistic _keyStats = new HistogramStatistic();
+    private final HistogramStatistic _dispatchStats = new HistogramStatistic();
+    private final SelectedKeys _selectedKeys = new SelectedKeys();
 
     public ManagedSelector(SelectorManager selectorManager, int id)
     {
@@ -95,7 +104,9 @@ public class ManagedSelector extends ContainerLifeCycle implements Dumpable
         _id = id;
         SelectorProducer producer = new SelectorProducer();
         Executor executor = selectorManager.getExecutor();
-        _strategy = new AdaptiveExecutionStrategy(producer, executor);
+        // Pin this selector, and the tasks it produces, to a group of workers.
+        _groupExecutor = executor instanceof WorkStealingThreadPool pool ? pool.getExecutor(id) : null;
+        _strategy = new AdaptiveExecutionStrategy(producer, _groupExecutor == null ? executor : _groupExecutor);
         installBean(_strategy, true);
     }
 
@@ -116,7 +127,10 @@ public class ManagedSelector extends ContainerLifeCycle implements Dumpable
 
         // The normal strategy obtains the produced task, schedules
         // a new thread to produce more, runs the task and then exits.
-        _selectorManager.execute(_strategy::produce);
+        if (_groupExecutor != null)
+            _groupExecutor.execute(_strategy::produce);
+        else
+            _selectorManager.execute(_strategy::produce);
 
         // Set started only if we really are started
         Start start = new Start();
@@ -164,21 +178,69 @@ public class ManagedSelector extends ContainerLifeCycle implements Dumpable
         return _keyStats.getMax();
     }
 
+    @ManagedAttribute(value = "99th percentile of the number of selected keys", readonly = true)
+    public long getSelectedKeysP99()
+    {
+        return _keyStats.getValueAtPercentile(99);
+    }
+
     @ManagedAttribute(value = "Total number of select() calls", readonly = true)
     public long getSelectCount()
     {
         return _keyStats.getCount();
     }
 
+    @ManagedAttribute(value = "Mean delay from select() wakeup to task production (in ns)", readonly = true)
+    public double getSelectToDispatchMean()
+    {
+        return _dispatchStats.getMean();
+    }
+
+    @ManagedAttribute(value = "99th percentile of the delay from select() wakeup to task production (in ns)", readonly = true)
+    public long getSelectToDispatchP99()
+    {
+        return _dispatchStats.getValueAtPercentile(99);
+    }
+
+    @ManagedAttribute(value = "99.9th percentile of the delay from select() wakeup to task production (in ns)", readonly = true)
+    public long getSelectToDispatchP999()
+    {
+        return _dispatchStats.getValueAtPercentile(99.9);
+    }
+
+    @ManagedAttribute(value = "Max delay from select() wakeup to task production (in ns)", readonly = true)
+    public long getSelectToDispatchMax()
+    {
+        return _dispatchStats.getMax();
+    }
+
+    /**
+     * @return the statistic of the number of keys selected by each {@code select()}
+     */
+    public HistogramStatistic getSelectedKeysStatistic()
+    {
+        return _keyStats;
+    }
+
+    /**
+     * @return the statistic of the delay, in nanoseconds, from when {@code select()}
+     * returns to when the task for a selected key is produced
+     */
+    public HistogramStatistic getSelectToDispatchStatistic()
+    {
+        return _dispatchStats;
+    }
+
     @ManagedOperation(value = "Resets the statistics", impact = "ACTION")
     public void resetStats()
     {
         _keyStats.reset();
+        _dispatchStats.reset();
     }
 
     protected int nioSelect(Selector selector, boolean now) throws IOException
     {
-        return now ? selector.selectNow() : selector.select();
+        return now ? selector.selectNow(_selectedKeys) : selector.select(_selectedKeys);
     }
 
     protected int select(Selector selector) throws IOException
@@ -471,12 +533,16 @@ public class ManagedSelector extends ContainerLifeCycle implements Dumpable
                 keys = Collections.singletonList("No dump keys retrieved");
 
             dumpObjects(out, indent,
+                Dumpable.named("selectedKeys", _keyStats),
+                Dumpable.named("selectToDispatch", _dispatchStats),
                 new DumpableCollection("updates @ " + updatesAt, updates),
                 new DumpableCollection("keys @ " + keysAt, keys));
         }
         else
         {
-            dumpObjects(out, indent);
+            dumpObjects(out, indent,
+                Dumpable.named("selectedKeys", _keyStats),
+                Dumpable.named("selectToDispatch", _dispatchStats));
         }
     }
 
@@ -488,7 +554,7 @@ public class ManagedSelector extends ContainerLifeCycle implements Dumpable
             super.toString(),
             _id,
             selector != null && selector.isOpen() ? selector.keys().size() : -1,
-            selector != null && selector.isOpen() ? selector.selectedKeys().size() : -1,
+            selector != null && selector.isOpen() ? _selectedKeys.size() : -1,
             getActionSize(),
             getSelectCount(),
             getAverageSelectedKeys(),
@@ -525,10 +591,50 @@ public class ManagedSelector extends ContainerLifeCycle implements Dumpable
         void replaceKey(SelectionKey newKey);
     }
 
+    /**
+     * <p>The keys selected by a select cycle, collected in a reusable array.</p>
+     * <p>This class is only accessed by the thread that is producing.</p>
+     */
+    private static class SelectedKeys implements Consumer<SelectionKey>
+    {
+        private SelectionKey[] _keys = new SelectionKey[64];
+        private int _size;
+
+        @Override
+        public void accept(SelectionKey key)
+        {
+            if (_size == _keys.length)
+                _keys = Arrays.copyOf(_keys, _size * 2);
+            _keys[_size++] = key;
+        }
+
+        private void addAll(Set<SelectionKey> keys)
+        {
+            keys.forEach(this);
+            keys.clear();
+        }
+
+        private SelectionKey get(int index)
+        {
+            return _keys[index];
+        }
+
+        private int size()
+        {
+            return _size;
+        }
+
+        private void clear()
+        {
+            Arrays.fill(_keys, 0, _size, null);
+            _size = 0;
+        }
+    }
+
     private class SelectorProducer implements ExecutionStrategy.Producer
     {
-        private Set<SelectionKey> _keys = Collections.emptySet();
-        private Iterator<SelectionKey> _cursor = Collections.emptyIterator();
+        private int _cursor;
+        private long _selectedNanoTime;
 
         @Override
         public Runnable produce()
@@ -614,8 +720,13 @@ public class ManagedSelector extends ContainerLifeCycle implements Dumpable
                     selector = _selector;
                     if (selector != null)
                     {
+                        // Subclasses that override nioSelect() may have used the selected-key set.
+                        Set<SelectionKey> selectedKeySet = selector.selectedKeys();
+                        if (!selectedKeySet.isEmpty())
+                            _selectedKeys.addAll(selectedKeySet);
+
                         if (LOG.isDebugEnabled())
-                            LOG.debug("Selector {} woken up from select, {}/{}/{} selected", selector, selected, selector.selectedKeys().size(), selector.keys().size());
+                            LOG.debug("Selector {} woken up from select, {}/{}/{} selected", selector, selected, _selectedKeys.size(), selector.keys().size());
 
                         int updates;
                         try (AutoLock l = _lock.lock())
@@ -625,11 +736,13 @@ public class ManagedSelector extends ContainerLifeCycle implements Dumpable
                             updates = _updates.size();
                         }
 
-                        _keys = selector.selectedKeys();
-                        int selectedKeys = _keys.size();
+                        int selectedKeys = _selectedKeys.size();
                         if (selectedKeys > 0)
+                        {
                             _keyStats.record(selectedKeys);
-                        _cursor = selectedKeys > 0 ? _keys.iterator() : Collections.emptyIterator();
+                            _selectedNanoTime = NanoTime.now();
+                        }
+                        _cursor = 0;
                         if (LOG.isDebugEnabled())
                             LOG.debug("Selector {} processing {} keys, {} updates", selector, selectedKeys, updates);
 
@@ -660,9 +773,9 @@ public class ManagedSelector extends ContainerLifeCycle implements Dumpable
 
         private Runnable processSelected()
         {
-            while (_cursor.hasNext())
+            while (_cursor < _selectedKeys.size())
             {
-                SelectionKey key = _cursor.next();
+                SelectionKey key = _selectedKeys.get(_cursor++);
                 Object attachment = key.attachment();
                 SelectableChannel channel = key.channel();
                 if (key.isValid())
@@ -676,7 +789,10 @@ public class ManagedSelector extends ContainerLifeCycle implements Dumpable
                             // Try to produce a task
                             Runnable task = ((Selectable)attachment).onSelected();
                             if (task != null)
+                            {
+                                _dispatchStats.record(NanoTime.since(_selectedNanoTime));
                                 return task;
+                            }
                         }
                         else if (key.isConnectable())
                         {
@@ -714,13 +830,15 @@ public class ManagedSelector extends ContainerLifeCycle implements Dumpable
             // Do update keys for only previously selected keys.
             // This will update only those keys whose selection did not cause an
             // updateKeys update to be submitted.
-            for (SelectionKey key : _keys)
+            int size = _selectedKeys.size();
+            for (int i = 0; i < size; ++i)
             {
-                Object attachment = key.attachment();
+                Object attachment = _selectedKeys.get(i).attachment();
                 if (attachment instanceof Selectable)
                     ((Selectable)attachment).updateKey();
             }
-            _keys.clear();
+            _selectedKeys.clear();
+            _cursor = 0;
         }
 
         @Override
@@ -46,6 +46,13 @@ public class NetworkTrafficSocketChannelEndPoint extends SocketChannelEndPoint
         return read;
     }
 
+    @Override
+    public boolean isTransferSupported()
+    {
+        // Transferred file regions would not be notified to the listener.
+        return false;
+    }
+
     @Override
     public boolean flush(ByteBuffer... buffers) throws IOException
     {
@@ -22,6 +22,7 @@ import java.nio.channels.SelectionKey;
 import java.nio.channels.Selector;
 import java.nio.channels.ServerSocketChannel;
 import java.nio.channels.SocketChannel;
+import java.nio.channels.spi.SelectorProvider;
 import java.util.Arrays;
 import java.util.EventListener;
 import java.util.List;
@@ -62,6 +63,7 @@ public abstract class SelectorManager extends ContainerLifeCycle implements Dump
     private final IntUnaryOperator _selectorIndexUpdate;
     private final List<AcceptListener> _acceptListeners = new CopyOnWriteArrayList<>();
     private long _connectTimeout = DEFAULT_CONNECT_TIMEOUT;
+    private SelectorProvider _selectorProvider = SelectorProvider.provider();
     private ThreadPoolBudget.Lease _lease;
 
     private static int defaultSelectors(Executor executor)
@@ -129,6 +131,30 @@ public abstract class SelectorManager extends ContainerLifeCycle implements Dump
         _connectTimeout = milliseconds;
     }
 
+    /**
+     * @return the {@link SelectorProvider} used to open {@link Selector}s
+     */
+    @ManagedAttribute("The SelectorProvider")
+    public SelectorProvider getSelectorProvider()
+    {
+        return _selectorProvider;
+    }
+
+    /**
+     * <p>Sets the {@link SelectorProvider} used to open {@link Selector}s.</p>
+     * <p>This allows to plug in an alternative, possibly native, selector
+     * implementation; the {@link SelectableChannel}s registered with this
+     * {@link SelectorManager} must be opened by the same {@link SelectorProvider}.</p>
+     *
+     * @param selectorProvider the {@link SelectorProvider}, or null for the JVM default
+     */
+    public void setSelectorProvider(SelectorProvider selectorProvider)
+    {
+        if (isRunning())
+            throw new IllegalStateException(getState());
+        _selectorProvider = selectorProvider == null ? SelectorProvider.provider() : selectorProvider;
+    }
+
     /**
      * Executes the given task in a different thread.
      *
@@ -269,7 +295,7 @@ public abstract class SelectorManager extends ContainerLifeCycle implements Dump
 
     protected Selector newSelector() throws IOException
     {
-        return Selector.open();
+        return getSelectorProvider().openSelector();
     }
 
     @Override
@@ -16,10 +16,13 @@ package org.eclipse.jetty.io;
 import java.io.IOException;
 import java.net.SocketAddress;
 import java.nio.ByteBuffer;
+import java.nio.channels.FileChannel;
 import java.nio.channels.SelectionKey;
 import java.nio.channels.SocketChannel;
+import java.nio.channels.WritePendingException;
 
 import org.eclipse.jetty.util.BufferUtil;
+import org.eclipse.jetty.util.Callback;
 import org.eclipse.jetty.util.thread.Scheduler;
 import org.slf4j.Logger;
 import org.slf4j.LoggerFactory;
@@ -31,6 +34,8 @@ public class SocketChannelEndPoint extends SelectableChannelEndPoint
 {
     private static final Logger LOG = LoggerFactory.getLogger(SocketChannelEndPoint.class);
 
+    private Transfer _transfer;
+
     public SocketChannelEndPoint(SocketChannel channel, ManagedSelector selector, SelectionKey key, Scheduler scheduler)
     {
         super(scheduler, channel, selector, key);
@@ -126,6 +131,103 @@ public class SocketChannelEndPoint extends SelectableChannelEndPoint
                 return false;
         }
 
+        // Once the buffers are flushed, flush any file region being transferred.
+        Transfer transfer = _transfer;
+        if (transfer == null)
+            return true;
+        if (!transfer.flush())
+            return false;
+        _transfer = null;
         return true;
     }
+
+    @Override
+    public boolean isTransferSupported()
+    {
+        return true;
+    }
+
+    /**
+     * <p>Writes the buffers and then the file region with {@link FileChannel#transferTo(long, long, java.nio.channels.WritableByteChannel)},
+     * so that the kernel can send the file content directly to the socket.</p>
+     * <p>The file region is flushed by {@link #flush(ByteBuffer...)} after the buffers, so partial
+     * transfers are completed by the {@link WriteFlusher} when the socket becomes writable again.</p>
+     */
+    @Override
+    public void transfer(Callback callback, FileChannel file, long position, long length, ByteBuffer... buffers) throws WritePendingException
+    {
+        // Reject before publishing the transfer, otherwise a write
+        // in progress could flush the file region as its own.
+        if (_transfer != null || !getWriteFlusher().isIdle())
+            throw new WritePendingException();
+        Transfer transfer = new Transfer(file, position, length);
+        _transfer = transfer;
+        try
+        {
+            write(new Callback.Nested(callback)
+            {
+                @Override
+                public void failed(Throwable x)
+                {
+                    if (_transfer == transfer)
+                        _transfer = null;
+                    super.failed(x);
+                }
+            }, buffers);
+        }
+        catch (WritePendingException x)
+        {
+            if (_transfer == transfer)
+                _transfer = null;
+            throw x;
+        }
+    }
+
+    private class Transfer
+    {
+        private final FileChannel _file;
+        private long _position;
+        private long _remaining;
+
+        private Transfer(FileChannel file, long position, long length)
+        {
+            _file = file;
+            _position = position;
+            _remaining = length;
+        }
+
+        private boolean flush() throws IOException
+        {
+            while (_remaining > 0)
+            {
+                long transferred;
+                try
+                {
+                    transferred = _file.transferTo(_position, _remaining, getChannel());
+                }
+                catch (IOException e)
+                {
+                    throw new EofException(e);
+                }
+
+                if (LOG.isDebugEnabled())
+                    LOG.debug("transferred {}/{} {}", transferred, _remaining, SocketChannelEndPoint.this);
+
+                if (transferred <= 0)
+                {
+                    // The file may have been truncated, which must not be mistaken for a full socket buffer.
+                    if (_position >= _file.size())
+                        throw new EofException("File truncated at " + _position);
+                    return false;
+                }
+
+                _position += transferred;
+                _remaining -= transferred;
+                notIdle();
+                if (getConnection() instanceof WriteFlusher.Listener listener)
+                    listener.onFlushed(transferred);
+            }
+            return true;
+        }
+    }
 }
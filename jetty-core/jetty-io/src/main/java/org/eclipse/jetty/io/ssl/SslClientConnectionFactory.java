@@ -46,6 +46,7 @@ public class SslClientConnectionFactory implements ClientConnectionFactory
     private boolean _directBuffersForEncryption = true;
     private boolean _directBuffersForDecryption = true;
     private boolean _requireCloseMessage;
+    private int _maxRecordsPerFill = 1;
 
     public SslClientConnectionFactory(SslContextFactory.Client sslContextFactory, ByteBufferPool byteBufferPool, Executor executor, ClientConnectionFactory connectionFactory)
     {
@@ -113,6 +114,24 @@ public class SslClientConnectionFactory implements ClientConnectionFactory
         _requireCloseMessage = requireCloseMessage;
     }
 
+    /**
+     * @return the max number of TLS records that may be unwrapped by a single fill
+     * @see SslConnection#getMaxRecordsPerFill()
+     */
+    public int getMaxRecordsPerFill()
+    {
+        return _maxRecordsPerFill;
+    }
+
+    /**
+     * @param maxRecordsPerFill the max number of TLS records that may be unwrapped by a single fill
+     * @see SslConnection#setMaxRecordsPerFill(int)
+     */
+    public void setMaxRecordsPerFill(int maxRecordsPerFill)
+    {
+        _maxRecordsPerFill = maxRecordsPerFill;
+    }
+
     @Override
     public org.eclipse.jetty.io.Connection newConnection(EndPoint endPoint, Map<String, Object> context) throws IOException
     {
@@ -159,6 +178,7 @@ public class SslClientConnectionFactory implements ClientConnectionFactory
             sslConnection.setRenegotiationAllowed(_sslContextFactory.isRenegotiationAllowed());
             sslConnection.setRenegotiationLimit(_sslContextFactory.getRenegotiationLimit());
             sslConnection.setRequireCloseMessage(isRequireCloseMessage());
+            sslConnection.setMaxRecordsPerFill(getMaxRecordsPerFill());
             ContainerLifeCycle client = (ContainerLifeCycle)context.get(ClientConnectionFactory.CLIENT_CONTEXT_KEY);
             if (client != null)
                 client.getBeans(SslHandshakeListener.class).forEach(sslConnection::addHandshakeListener);
@@ -125,6 +125,7 @@ public class SslConnection extends AbstractConnection implements Connection.Upgr
     private int _renegotiationLimit = -1;
     private boolean _closedOutbound;
     private boolean _requireCloseMessage;
+    private int _maxRecordsPerFill = 1;
     private FlushState _flushState = FlushState.IDLE;
     private FillState _fillState = FillState.IDLE;
     private boolean _underflown;
@@ -288,6 +289,33 @@ public class SslConnection extends AbstractConnection implements Connection.Upgr
         _requireCloseMessage = requireCloseMessage;
     }
 
+    /**
+     * @return the max number of TLS records that may be unwrapped by a single fill
+     * @see #setMaxRecordsPerFill(int)
+     */
+    public int getMaxRecordsPerFill()
+    {
+        return _maxRecordsPerFill;
+    }
+
+    /**
+     * <p>Sets the max number of TLS records that may be unwrapped by a single fill.</p>
+     * <p>When greater than {@code 1}, once the handshake is complete the encrypted
+     * and decrypted input buffers are sized to hold that many records, so that a single
+     * network read may read multiple records, and all the complete records are unwrapped
+     * into the same decrypted buffer before returning to the application, reducing
+     * the number of calls to {@link SslEndPoint#fill(ByteBuffer)} per byte of application data,
+     * at the cost of larger transient buffers.</p>
+     *
+     * @param maxRecordsPerFill the max number of TLS records that may be unwrapped by a single fill
+     */
+    public void setMaxRecordsPerFill(int maxRecordsPerFill)
+    {
+        if (maxRecordsPerFill <= 0)
+            throw new IllegalArgumentException("Invalid max records per fill " + maxRecordsPerFill);
+        _maxRecordsPerFill = maxRecordsPerFill;
+    }
+
     private boolean isHandshakeInitial()
     {
         return _handshake.get() == HandshakeState.INITIAL;
@@ -325,10 +353,19 @@ public class SslConnection extends AbstractConnection implements Connection.Upgr
         return Math.max(hsSize, size);
     }
 
+    private int getRecordsPerFill()
+    {
+        // Only batch records once the handshake is complete,
+        // as handshake messages must be processed one at a time.
+        if (_maxRecordsPerFill > 1 && isHandshakeSucceeded() && _sslEngine.getHandshakeStatus() == HandshakeStatus.NOT_HANDSHAKING)
+            return _maxRecordsPerFill;
+        return 1;
+    }
+
     private void acquireEncryptedInput()
     {
         if (_encryptedInput == null)
-            _encryptedInput = _bufferPool.acquire(getPacketBufferSize(), _encryptedDirectBuffers);
+            _encryptedInput = _bufferPool.acquire(getPacketBufferSize() * getRecordsPerFill(), _encryptedDirectBuffers);
     }
 
     private void acquireEncryptedOutput()
@@ -703,7 +740,7 @@ public class SslConnection extends AbstractConnection implements Connection.Upgr
                                 }
                                 else
                                 {
-                                    _decryptedInput = _bufferPool.acquire(appBufferSize, _decryptedDirectBuffers);
+                                    _decryptedInput = _bufferPool.acquire(appBufferSize * getRecordsPerFill(), _decryptedDirectBuffers);
                                     appIn = _decryptedInput.getByteBuffer();
                                 }
                             }
@@ -825,8 +862,11 @@ public class SslConnection extends AbstractConnection implements Connection.Upgr
                                     // another call to fill() or flush().
                                     if (unwrapResult.bytesProduced() > 0)
                                     {
+                                        int produced = unwrapResult.bytesProduced();
+                                        if (unwrapResult.getHandshakeStatus() == HandshakeStatus.NOT_HANDSHAKING)
+                                            produced += unwrapRecords(appIn, appBufferSize);
                                         if (appIn == buffer)
-                                            return filled = unwrapResult.bytesProduced();
+                                            return filled = produced;
                                         return filled = BufferUtil.append(buffer, _decryptedInput.getByteBuffer());
                                     }
 
@@ -871,6 +911,51 @@ public class SslConnection extends AbstractConnection implements Connection.Upgr
             }
         }
 
+        /**
+         * <p>Unwraps the complete records that are available in the encrypted input buffer,
+         * after the first one, as long as the application buffer has space for them.</p>
+         *
+         * @param appIn the application buffer, in flush mode
+         * @param appBufferSize the max size of a decrypted record
+         * @return the number of bytes produced
+         * @throws SSLException if the unwrap fails
+         */
+        private int unwrapRecords(ByteBuffer appIn, int appBufferSize) throws SSLException
+        {
+            int produced = 0;
+            for (int records = getRecordsPerFill(); records > 1; --records)
+            {
+                ByteBuffer encryptedInput = _encryptedInput.getByteBuffer();
+                if (!encryptedInput.hasRemaining() || BufferUtil.space(appIn) < appBufferSize)
+                    break;
+
+                int pos = BufferUtil.flipToFill(appIn);
+                SSLEngineResult unwrapResult;
+                try
+                {
+                    unwrapResult = SslConnection.this.unwrap(_sslEngine, encryptedInput, appIn);
+                }
+                finally
+                {
+                    BufferUtil.flipToFlush(appIn, pos);
+                }
+                if (LOG.isDebugEnabled())
+                    LOG.debug("unwrap record {} encryptedBuffer={} appBuffer={}",
+                        StringUtil.replace(unwrapResult.toString(), '\n', ' '),
+                        _encryptedInput,
+                        BufferUtil.toDetailString(appIn));
+
+                produced += unwrapResult.bytesProduced();
+                // Stop at incomplete records, at the close message, or at handshake
+                // messages; they are processed by the next call to fill().
+                if (unwrapResult.getStatus() != Status.OK ||
+                    unwrapResult.getHandshakeStatus() != HandshakeStatus.NOT_HANDSHAKING ||
+                    unwrapResult.bytesProduced() == 0)
+                    break;
+            }
+            return produced;
+        }
+
         @Override
         protected void needsFillInterest()
         {
@@ -364,6 +364,87 @@ public class ArrayByteBufferPoolTest
         assertThat(pool.getHeapMemory(), is(0L));
     }
 
+    @Test
+    public void testShardedAcquireRelease()
+    {
+        ArrayByteBufferPool pool = new ArrayByteBufferPool.Sharded(0, 10, 20, Integer.MAX_VALUE, -1L, -1L, 1, 4);
+        assertThat(pool.getShards(), is(1));
+
+        RetainableByteBuffer buf1 = pool.acquire(10, true);
+        buf1.release();
+        // The first release of a new buffer goes to the shared bucket.
+        assertThat(pool.getShardedDirectByteBufferCount(), is(0L));
+        assertThat(pool.getAvailableDirectByteBufferCount(), is(1L));
+
+        RetainableByteBuffer buf2 = pool.acquire(10, true);
+        assertThat(buf2.getByteBuffer(), sameInstance(buf1.getByteBuffer()));
+        buf2.release();
+        // Subsequent releases go to the front cache shard.
+        assertThat(pool.getShardedDirectByteBufferCount(), is(1L));
+        assertThat(pool.getAvailableDirectByteBufferCount(), is(1L));
+        assertThat(pool.getDirectByteBufferCount(), is(1L));
+        assertThat(pool.getDirectMemory(), is(10L));
+
+        RetainableByteBuffer buf3 = pool.acquire(10, true);
+        assertThat(buf3.getByteBuffer(), sameInstance(buf1.getByteBuffer()));
+        assertThat(pool.getShardedDirectByteBufferCount(), is(0L));
+        assertThat(pool.getAvailableDirectByteBufferCount(), is(0L));
+        buf3.release();
+
+        pool.clear();
+
+        assertThat(pool.getShardedDirectByteBufferCount(), is(0L));
+        assertThat(pool.getDirectByteBufferCount(), is(0L));
+        assertThat(pool.getDirectMemory(), is(0L));
+    }
+
+    @Test
+    public void testShardedFillsInBatches()
+    {
+        ArrayByteBufferPool pool = new ArrayByteBufferPool.Sharded(0, 10, 20, Integer.MAX_VALUE, -1L, -1L, 1, 4);
+
+        List<RetainableByteBuffer> buffers = new ArrayList<>();
+        for (int i = 0; i < 6; i++)
+            buffers.add(pool.acquire(10, true));
+        buffers.forEach(RetainableByteBuffer::release);
+        assertThat(pool.getAvailableDirectByteBufferCount(), is(6L));
+        assertThat(pool.getShardedDirectByteBufferCount(), is(0L));
+
+        // Acquiring from an empty shard fills it with a batch from the shared bucket.
+        RetainableByteBuffer buffer = pool.acquire(10, true);
+        assertThat(pool.getShardedDirectByteBufferCount(), is(1L));
+        assertThat(pool.getAvailableDirectByteBufferCount(), is(5L));
+
+        buffer.release();
+        assertThat(pool.getShardedDirectByteBufferCount(), is(2L));
+        assertThat(pool.getAvailableDirectByteBufferCount(), is(6L));
+        assertThat(pool.getDirectMemory(), is(60L));
+    }
+
+    @Test
+    public void testShardedMaxMemoryEviction()
+    {
+        ArrayByteBufferPool pool = new ArrayByteBufferPool.Sharded(0, 10, 20, Integer.MAX_VALUE, 40, 40, 2, 4);
+
+        List<RetainableByteBuffer> buffers = new ArrayList<>();
+        for (int t = 0; t < 2; t++)
+        {
+            for (int i = 0; i < 200; i++)
+                buffers.add(pool.acquire(10 + i / 10, true));
+
+            long maxSize = 0;
+            for (RetainableByteBuffer buffer : buffers)
+            {
+                buffer.release();
+                maxSize = Math.max(pool.getDirectMemory(), maxSize);
+            }
+            buffers.clear();
+
+            // Test that size is never too much over target max, including the shards.
+            assertThat(maxSize, lessThan(100L));
+        }
+    }
+
     @Test
     public void testQuadraticPool()
     {
@@ -15,13 +15,19 @@ package org.eclipse.jetty.io;
 
 import java.io.IOException;
 import java.net.InetSocketAddress;
+import java.net.ProtocolFamily;
 import java.net.SocketAddress;
+import java.nio.channels.DatagramChannel;
+import java.nio.channels.Pipe;
 import java.nio.channels.SelectableChannel;
 import java.nio.channels.SelectionKey;
 import java.nio.channels.ServerSocketChannel;
 import java.nio.channels.SocketChannel;
+import java.nio.channels.spi.AbstractSelector;
+import java.nio.channels.spi.SelectorProvider;
 import java.util.concurrent.CountDownLatch;
 import java.util.concurrent.TimeUnit;
+import java.util.concurrent.atomic.AtomicInteger;
 
 import org.eclipse.jetty.util.Callback;
 import org.eclipse.jetty.util.thread.QueuedThreadPool;
@@ -30,6 +36,7 @@ import org.junit.jupiter.api.AfterEach;
 import org.junit.jupiter.api.BeforeEach;
 import org.junit.jupiter.api.Test;
 
+import static org.junit.jupiter.api.Assertions.assertEquals;
 import static org.junit.jupiter.api.Assertions.assertFalse;
 import static org.junit.jupiter.api.Assertions.assertTrue;
 
@@ -152,4 +159,82 @@ public class SelectorManagerTest
             selectorManager.stop();
         }
     }
+
+    @Test
+    public void testSelectorProvider() throws Exception
+    {
+        SelectorProvider provider = SelectorProvider.provider();
+        AtomicInteger selectors = new AtomicInteger();
+        SelectorProvider countingProvider = new SelectorProvider()
+        {
+            @Override
+            public DatagramChannel openDatagramChannel() throws IOException
+            {
+                return provider.openDatagramChannel();
+            }
+
+            @Override
+            public DatagramChannel openDatagramChannel(ProtocolFamily family) throws IOException
+            {
+                return provider.openDatagramChannel(family);
+            }
+
+            @Override
+            public Pipe openPipe() throws IOException
+            {
+                return provider.openPipe();
+            }
+
+            @Override
+            public AbstractSelector openSelector() throws IOException
+            {
+                selectors.incrementAndGet();
+                return provider.openSelector();
+            }
+
+            @Override
+            public ServerSocketChannel openServerSocketChannel() throws IOException
+            {
+                return provider.openServerSocketChannel();
+            }
+
+            @Override
+            public SocketChannel openSocketChannel() throws IOException
+            {
+                return provider.openSocketChannel();
+            }
+        };
+
+        SelectorManager selectorManager = new SelectorManager(executor, scheduler, 2)
+        {
+            @Override
+            protected EndPoint newEndPoint(SelectableChannel channel, ManagedSelector selector, SelectionKey key)
+            {
+                return new SocketChannelEndPoint((SocketChannel)channel, selector, key, getScheduler());
+            }
+
+            @Override
+            public Connection newConnection(SelectableChannel channel, EndPoint endpoint, Object attachment)
+            {
+                return new AbstractConnection(endpoint, executor)
+                {
+                    @Override
+                    public void onFillable()
+                    {
+                    }
+                };
+            }
+        };
+        selectorManager.setSelectorProvider(countingProvider);
+        selectorManager.start();
+        try
+        {
+            assertEquals(countingProvider, selectorManager.getSelectorProvider());
+            assertEquals(2, selectors.get());
+        }
+        finally
+        {
+            selectorManager.stop();
+        }
+    }
 }
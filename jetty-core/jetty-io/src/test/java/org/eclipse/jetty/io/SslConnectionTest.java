@@ -29,6 +29,7 @@ import java.util.concurrent.CountDownLatch;
 import java.util.concurrent.TimeUnit;
 import java.util.concurrent.atomic.AtomicBoolean;
 import java.util.concurrent.atomic.AtomicInteger;
+import java.util.concurrent.atomic.AtomicReference;
 import javax.net.ssl.SSLEngine;
 import javax.net.ssl.SSLException;
 import javax.net.ssl.SSLSocket;
@@ -49,6 +50,7 @@ import org.slf4j.LoggerFactory;
 
 import static org.hamcrest.MatcherAssert.assertThat;
 import static org.hamcrest.Matchers.is;
+import static org.junit.jupiter.api.Assertions.assertArrayEquals;
 import static org.junit.jupiter.api.Assertions.assertEquals;
 import static org.junit.jupiter.api.Assertions.assertNull;
 import static org.junit.jupiter.api.Assertions.assertThrows;
@@ -66,6 +68,7 @@ public class SslConnectionTest
     protected volatile EndPoint _lastEndp;
     private volatile boolean _testFill = true;
     private volatile boolean _onXWriteThenShutdown = false;
+    private volatile int _maxRecordsPerFill = 1;
 
     private volatile FutureCallback _writeCallback;
     protected ServerSocketChannel _connector;
@@ -90,6 +93,7 @@ public class SslConnectionTest
             SslConnection sslConnection = new SslConnection(_bufferPool, getExecutor(), _sslCtxFactory, endpoint, engine);
             sslConnection.setRenegotiationAllowed(_sslCtxFactory.isRenegotiationAllowed());
             sslConnection.setRenegotiationLimit(_sslCtxFactory.getRenegotiationLimit());
+            sslConnection.setMaxRecordsPerFill(_maxRecordsPerFill);
             SslConnection.SslEndPoint sslEndPoint = sslConnection.getSslEndPoint();
             Connection appConnection = new TestConnection(sslEndPoint);
             sslEndPoint.setConnection(appConnection);
@@ -563,4 +567,59 @@ public class SslConnectionTest
             }
         }
     }
+
+    @Test
+    public void testManyRecordsPerFill() throws Exception
+    {
+        _maxRecordsPerFill = 4;
+        startSSL();
+        try (Socket client = newClient())
+        {
+            client.setSoTimeout(10000);
+            try (SocketChannel server = _connector.accept())
+            {
+                server.configureBlocking(false);
+                _manager.accept(server);
+
+                // Write many records at once, so that the server reads many records per fill.
+                byte[] data = new byte[256 * 1024];
+                for (int i = 0; i < data.length; ++i)
+                {
+                    data[i] = (byte)('A' + i % 26);
+                }
+
+                CountDownLatch latch = new CountDownLatch(1);
+                AtomicReference<Throwable> failure = new AtomicReference<>();
+                byte[] echo = new byte[data.length];
+                new Thread(() ->
+                {
+                    try
+                    {
+                        int offset = 0;
+                        while (offset < echo.length)
+                        {
+                            int read = client.getInputStream().read(echo, offset, echo.length - offset);
+                            if (read < 0)
+                                break;
+                            offset += read;
+                        }
+                        if (offset == echo.length)
+                            latch.countDown();
+                    }
+                    catch (IOException e)
+                    {
+                        failure.set(e);
+                        latch.countDown();
+                    }
+                }).start();
+
+                client.getOutputStream().write(data);
+                client.getOutputStream().flush();
+
+                assertTrue(latch.await(20, TimeUnit.SECONDS));
+                assertNull(failure.get());
+                assertArrayEquals(data, echo);
+            }
+        }
+    }
 }
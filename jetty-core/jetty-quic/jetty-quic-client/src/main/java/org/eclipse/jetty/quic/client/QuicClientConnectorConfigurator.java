@@ -84,6 +84,8 @@ public class QuicClientConnectorConfigurator extends ClientConnector.Configurato
         quicConfig.setOutputBufferSize(initQuicConfig.getOutputBufferSize());
         quicConfig.setUseInputDirectByteBuffers(initQuicConfig.isUseInputDirectByteBuffers());
         quicConfig.setUseOutputDirectByteBuffers(initQuicConfig.isUseOutputDirectByteBuffers());
+        quicConfig.setMaxReceiveBurst(initQuicConfig.getMaxReceiveBurst());
+        quicConfig.setMaxSendBurst(initQuicConfig.getMaxSendBurst());
         quicConfig.setProtocols(initQuicConfig.getProtocols());
         quicConfig.setDisableActiveMigration(initQuicConfig.isDisableActiveMigration());
         quicConfig.setMaxBidirectionalRemoteStreams(initQuicConfig.getMaxBidirectionalRemoteStreams());
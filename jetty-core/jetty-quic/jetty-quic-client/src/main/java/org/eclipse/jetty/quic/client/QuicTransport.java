@@ -59,6 +59,8 @@ public class QuicTransport extends Transport.Wrapper
         connection.setOutputBufferSize(quicConfiguration.getOutputBufferSize());
         connection.setUseInputDirectByteBuffers(quicConfiguration.isUseInputDirectByteBuffers());
         connection.setUseOutputDirectByteBuffers(quicConfiguration.isUseOutputDirectByteBuffers());
+        connection.setMaxReceiveBurst(quicConfiguration.getMaxReceiveBurst());
+        connection.setMaxSendBurst(quicConfiguration.getMaxSendBurst());
         quicConfiguration.getEventListeners().forEach(connection::addEventListener);
         return connection;
     }
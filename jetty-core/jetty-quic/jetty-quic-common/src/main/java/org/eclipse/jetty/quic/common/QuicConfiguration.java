@@ -34,6 +34,8 @@ public class QuicConfiguration extends ContainerLifeCycle
     private int outputBufferSize = 2048;
     private boolean useInputDirectByteBuffers = true;
     private boolean useOutputDirectByteBuffers = true;
+    private int maxReceiveBurst = 16;
+    private int maxSendBurst = 16;
     private List<String> protocols = List.of();
     private boolean disableActiveMigration;
     private int maxBidirectionalRemoteStreams;
@@ -84,6 +86,26 @@ public class QuicConfiguration extends ContainerLifeCycle
         this.useOutputDirectByteBuffers = useOutputDirectByteBuffers;
     }
 
+    public int getMaxReceiveBurst()
+    {
+        return maxReceiveBurst;
+    }
+
+    public void setMaxReceiveBurst(int maxReceiveBurst)
+    {
+        this.maxReceiveBurst = maxReceiveBurst;
+    }
+
+    public int getMaxSendBurst()
+    {
+        return maxSendBurst;
+    }
+
+    public void setMaxSendBurst(int maxSendBurst)
+    {
+        this.maxSendBurst = maxSendBurst;
+    }
+
     public List<String> getProtocols()
     {
         return protocols;
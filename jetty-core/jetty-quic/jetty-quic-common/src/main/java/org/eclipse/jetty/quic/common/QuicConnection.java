@@ -18,6 +18,7 @@ import java.net.InetSocketAddress;
 import java.net.SocketAddress;
 import java.nio.ByteBuffer;
 import java.util.ArrayDeque;
+import java.util.ArrayList;
 import java.util.Collection;
 import java.util.EventListener;
 import java.util.List;
@@ -27,6 +28,7 @@ import java.util.concurrent.CopyOnWriteArrayList;
 import java.util.concurrent.Executor;
 import java.util.concurrent.TimeoutException;
 import java.util.concurrent.atomic.AtomicBoolean;
+import java.util.stream.Stream;
 
 import org.eclipse.jetty.io.AbstractConnection;
 import org.eclipse.jetty.io.ByteBufferPool;
@@ -41,6 +43,7 @@ import org.eclipse.jetty.util.IteratingCallback;
 import org.eclipse.jetty.util.component.LifeCycle;
 import org.eclipse.jetty.util.thread.AutoLock;
 import org.eclipse.jetty.util.thread.ExecutionStrategy;
+import org.eclipse.jetty.util.thread.Invocable;
 import org.eclipse.jetty.util.thread.Scheduler;
 import org.eclipse.jetty.util.thread.strategy.AdaptiveExecutionStrategy;
 import org.slf4j.Logger;
@@ -68,6 +71,8 @@ public abstract class QuicConnection extends AbstractConnection
     private int outputBufferSize = 2048;
     private boolean useInputDirectByteBuffers = true;
     private boolean useOutputDirectByteBuffers = true;
+    private int maxReceiveBurst = 16;
+    private int maxSendBurst = 16;
 
     protected QuicConnection(Executor executor, Scheduler scheduler, ByteBufferPool bufferPool, EndPoint endPoint)
     {
@@ -117,6 +122,48 @@ public abstract class QuicConnection extends AbstractConnection
         this.useOutputDirectByteBuffers = useOutputDirectByteBuffers;
     }
 
+    /**
+     * @return the max number of datagrams received before returning the tasks they produced
+     * @see #setMaxReceiveBurst(int)
+     */
+    public int getMaxReceiveBurst()
+    {
+        return maxReceiveBurst;
+    }
+
+    /**
+     * <p>Sets the max number of datagrams that are received and fed to their sessions
+     * before returning the tasks they produced.</p>
+     * <p>Receiving bursts of datagrams feeds the QUIC implementation with multiple packets
+     * per session before the session processes them.</p>
+     *
+     * @param maxReceiveBurst the max number of datagrams received before returning the tasks they produced
+     */
+    public void setMaxReceiveBurst(int maxReceiveBurst)
+    {
+        this.maxReceiveBurst = Math.max(1, maxReceiveBurst);
+    }
+
+    /**
+     * @return the max number of queued datagrams to the same address written at once
+     * @see #setMaxSendBurst(int)
+     */
+    public int getMaxSendBurst()
+    {
+        return maxSendBurst;
+    }
+
+    /**
+     * <p>Sets the max number of queued datagrams to the same address that are written
+     * at once, reducing the per-datagram write overhead.</p>
+     *
+     * @param maxSendBurst the max number of queued datagrams to the same address written at once
+     */
+    public void setMaxSendBurst(int maxSendBurst)
+    {
+        this.maxSendBurst = Math.max(1, maxSendBurst);
+    }
+
     public Collection<QuicSession> getQuicSessions()
     {
         return List.copyOf(sessions.values());
@@ -221,10 +268,15 @@ public abstract class QuicConnection extends AbstractConnection
 
         RetainableByteBuffer buffer = bufferPool.acquire(getInputBufferSize(), isUseInputDirectByteBuffers());
         ByteBuffer cipherBuffer = buffer.getByteBuffer();
+        Burst burst = new Burst();
         try
         {
             while (true)
             {
+                // Return the tasks produced by a complete burst.
+                if (burst.isComplete())
+                    return burst.complete(buffer);
+
                 BufferUtil.clear(cipherBuffer);
                 SocketAddress remoteAddress = getEndPoint().receive(cipherBuffer);
                 int fill = remoteAddress == EndPoint.EOF ? -1 : cipherBuffer.remaining();
@@ -232,16 +284,21 @@ public abstract class QuicConnection extends AbstractConnection
                     LOG.debug("filled cipher buffer with {} byte(s)", fill);
                 if (fill < 0)
                 {
+                    if (burst.hasTasks())
+                        return burst.complete(buffer);
                     buffer.release();
                     getEndPoint().shutdownOutput();
                     return null;
                 }
                 if (fill == 0)
                 {
+                    if (burst.hasTasks())
+                        return burst.complete(buffer);
                     buffer.release();
                     fillInterested();
                     return null;
                 }
+                burst.received();
 
                 if (LOG.isDebugEnabled())
                     LOG.debug("peer IP address: {}, ciphertext packet size: {}", remoteAddress, cipherBuffer.remaining());
@@ -276,11 +333,7 @@ public abstract class QuicConnection extends AbstractConnection
                         Runnable task = session.pollTask();
                         if (LOG.isDebugEnabled())
                             LOG.debug("processing creation task {} on {}", task, session);
-                        if (task != null)
-                        {
-                            buffer.release();
-                            return task;
-                        }
+                        burst.add(task);
                     }
                     else
                     {
@@ -290,12 +343,7 @@ public abstract class QuicConnection extends AbstractConnection
                     continue;
                 }
 
-                Runnable task = process(session, remoteAddress, cipherBuffer);
-                if (task != null)
-                {
-                    buffer.release();
-                    return task;
-                }
+                burst.add(process(session, remoteAddress, cipherBuffer));
             }
         }
         catch (Throwable x)
@@ -304,7 +352,7 @@ public abstract class QuicConnection extends AbstractConnection
                 LOG.debug("receiveAndProcess() failure", x);
             buffer.release();
             onFailure(x);
-            return null;
+            return burst.complete(null);
         }
     }
 
@@ -333,6 +381,59 @@ public abstract class QuicConnection extends AbstractConnection
         sessions.values().forEach(session -> outwardClose(session, failure));
     }
 
+    /**
+     * <p>The tasks produced by a burst of received datagrams.</p>
+     * <p>The first task is returned to the execution strategy, while
+     * the tasks of other sessions are executed by the executor.</p>
+     */
+    private class Burst
+    {
+        private Runnable task;
+        private List<Runnable> others;
+        private int datagrams;
+
+        private void received()
+        {
+            ++datagrams;
+        }
+
+        private void add(Runnable task)
+        {
+            if (task == null || task == this.task)
+                return;
+            if (this.task == null)
+            {
+                this.task = task;
+                return;
+            }
+            if (others == null)
+                others = new ArrayList<>();
+            if (!others.contains(task))
+                others.add(task);
+        }
+
+        private boolean hasTasks()
+        {
+            return task != null;
+        }
+
+        private boolean isComplete()
+        {
+            return task != null && datagrams >= getMaxReceiveBurst();
+        }
+
+        private Runnable complete(RetainableByteBuffer buffer)
+        {
+            if (buffer != null)
+                buffer.release();
+            if (others != null)
+                others.forEach(getExecutor()::execute);
+            if (LOG.isDebugEnabled())
+                LOG.debug("received burst of {} datagram(s) producing {} task(s)", datagrams, (task == null ? 0 : 1) + (others == null ? 0 : others.size()));
+            return task;
+        }
+    }
+
     private class QuicProducer implements ExecutionStrategy.Producer
     {
         @Override
@@ -342,11 +443,16 @@ public abstract class QuicConnection extends AbstractConnection
         }
     }
 
+    /**
+     * <p>Flushes the queued datagrams, writing at once the consecutive
+     * datagrams queued to the same address, up to {@link #getMaxSendBurst()}.</p>
+     */
     private class Flusher extends IteratingCallback
     {
         private final AutoLock lock = new AutoLock();
         private final ArrayDeque<Entry> queue = new ArrayDeque<>();
-        private Entry entry;
+        private final List<Entry> entries = new ArrayList<>();
+        private InvocationType invocationType = InvocationType.BLOCKING;
 
         public void offer(Callback callback, SocketAddress address, ByteBuffer[] buffers)
         {
@@ -362,33 +468,68 @@ public abstract class QuicConnection extends AbstractConnection
         {
             try (AutoLock l = lock.lock())
             {
-                entry = queue.poll();
+                Entry entry = queue.poll();
+                if (entry != null)
+                {
+                    entries.add(entry);
+                    int maxSendBurst = getMaxSendBurst();
+                    while (entries.size() < maxSendBurst)
+                    {
+                        Entry next = queue.peek();
+                        if (next == null || !next.address.equals(entry.address))
+                            break;
+                        entries.add(queue.poll());
+                    }
+                }
             }
-            if (entry == null)
+            if (entries.isEmpty())
                 return Action.IDLE;
 
-            getEndPoint().write(this, entry.address, entry.buffers);
+            SocketAddress address = entries.get(0).address;
+            ByteBuffer[] buffers;
+            InvocationType invocationType = entries.get(0).callback.getInvocationType();
+            if (entries.size() == 1)
+            {
+                buffers = entries.get(0).buffers;
+            }
+            else
+            {
+                buffers = entries.stream()
+                    .flatMap(entry -> Stream.of(entry.buffers))
+                    .toArray(ByteBuffer[]::new);
+                for (int i = 1; i < entries.size(); ++i)
+                {
+                    invocationType = Invocable.combine(invocationType, entries.get(i).callback.getInvocationType());
+                }
+            }
+            this.invocationType = invocationType;
+
+            if (LOG.isDebugEnabled())
+                LOG.debug("writing {} datagram(s) to {}", buffers.length, address);
+            getEndPoint().write(this, address, buffers);
             return Action.SCHEDULED;
         }
 
         @Override
         public void succeeded()
         {
-            entry.callback.succeeded();
+            entries.forEach(entry -> entry.callback.succeeded());
+            entries.clear();
             super.succeeded();
         }
 
         @Override
         public void failed(Throwable x)
         {
-            entry.callback.failed(x);
+            entries.forEach(entry -> entry.callback.failed(x));
+            entries.clear();
             super.failed(x);
         }
 
         @Override
         public InvocationType getInvocationType()
         {
-            return entry.callback.getInvocationType();
+            return invocationType;
         }
 
         @Override
@@ -69,6 +69,8 @@ public class QuicServerConnectionFactory extends AbstractConnectionFactory
         connection.setOutputBufferSize(quicConfiguration.getOutputBufferSize());
         connection.setUseInputDirectByteBuffers(quicConfiguration.isUseInputDirectByteBuffers());
         connection.setUseOutputDirectByteBuffers(quicConfiguration.isUseOutputDirectByteBuffers());
+        connection.setMaxReceiveBurst(quicConfiguration.getMaxReceiveBurst());
+        connection.setMaxSendBurst(quicConfiguration.getMaxSendBurst());
         return connection;
     }
 }
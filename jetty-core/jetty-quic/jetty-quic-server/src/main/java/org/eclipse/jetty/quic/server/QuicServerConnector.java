@@ -15,12 +15,15 @@ package org.eclipse.jetty.quic.server;
 
 import java.io.IOException;
 import java.net.InetSocketAddress;
+import java.net.StandardSocketOptions;
 import java.nio.channels.DatagramChannel;
 import java.nio.channels.SelectableChannel;
 import java.nio.channels.SelectionKey;
 import java.nio.file.Files;
 import java.nio.file.Path;
+import java.util.ArrayList;
 import java.util.EventListener;
+import java.util.List;
 import java.util.concurrent.CompletableFuture;
 import java.util.concurrent.Executor;
 
@@ -39,6 +42,8 @@ import org.eclipse.jetty.server.Server;
 import org.eclipse.jetty.util.IO;
 import org.eclipse.jetty.util.ssl.SslContextFactory;
 import org.eclipse.jetty.util.thread.Scheduler;
+import org.slf4j.Logger;
+import org.slf4j.LoggerFactory;
 
 /**
  * <p>A server side network connector that uses a {@link DatagramChannel} to listen on a network port for QUIC traffic.</p>
@@ -46,14 +51,25 @@ import org.eclipse.jetty.util.thread.Scheduler;
  * The protocol is negotiated during the connection establishment by {@link QuicSession}, and for each QUIC stream
  * managed by a {@link QuicSession} a {@link ConnectionFactory} is used to create a {@link Connection} for the
  * correspondent {@link QuicStreamEndPoint}.</p>
+ * <p>This connector may listen on the network port with multiple {@link DatagramChannel}s bound with
+ * {@link StandardSocketOptions#SO_REUSEPORT}, each served by its own selector, so that the kernel
+ * spreads the received datagrams across them.
+ * The kernel picks the {@link DatagramChannel} by hashing the datagram 4-tuple, so a QUIC connection
+ * that migrates to a different remote address may be received by another {@link DatagramChannel}
+ * that does not know the QUIC connection; therefore connection migration is not supported when
+ * multiple {@link DatagramChannel}s are used.</p>
  *
  * @see ServerQuicConfiguration
  */
 public class QuicServerConnector extends AbstractNetworkConnector
 {
+    private static final Logger LOG = LoggerFactory.getLogger(QuicServerConnector.class);
+
     private final QuicSessionContainer container = new QuicSessionContainer();
     private final ServerDatagramSelectorManager selectorManager;
     private final QuicServerConnectionFactory connectionFactory;
+    private final int channels;
+    private final List<DatagramChannel> datagramChannels = new ArrayList<>();
     private volatile DatagramChannel datagramChannel;
     private volatile int localPort = -1;
 
@@ -90,9 +106,27 @@ public class QuicServerConnector extends AbstractNetworkConnector
     }
 
     public QuicServerConnector(Server server, Executor executor, Scheduler scheduler, ByteBufferPool bufferPool, ServerQuicConfiguration quicConfiguration, ConnectionFactory... factories)
+    {
+        this(server, executor, scheduler, bufferPool, 1, quicConfiguration, factories);
+    }
+
+    /**
+     * @param server the {@link Server}
+     * @param executor the {@link Executor}
+     * @param scheduler the {@link Scheduler}
+     * @param bufferPool the {@link ByteBufferPool}
+     * @param channels the number of {@link DatagramChannel}s bound to the network port with
+     * {@link StandardSocketOptions#SO_REUSEPORT}, or 1 to use a single {@link DatagramChannel}
+     * @param quicConfiguration the {@link ServerQuicConfiguration}
+     * @param factories the {@link ConnectionFactory}s of the protocols transported by QUIC
+     */
+    public QuicServerConnector(Server server, Executor executor, Scheduler scheduler, ByteBufferPool bufferPool, int channels, ServerQuicConfiguration quicConfiguration, ConnectionFactory... factories)
     {
         super(server, executor, scheduler, bufferPool, 0, factories);
-        this.selectorManager = new ServerDatagramSelectorManager(getExecutor(), getScheduler(), 1);
+        if (channels < 1)
+            throw new IllegalArgumentException("Invalid number of channels: " + channels);
+        this.channels = channels;
+        this.selectorManager = new ServerDatagramSelectorManager(getExecutor(), getScheduler(), channels);
         this.connectionFactory = new QuicServerConnectionFactory(quicConfiguration);
     }
 
@@ -101,6 +135,14 @@ public class QuicServerConnector extends AbstractNetworkConnector
         return connectionFactory.getQuicConfiguration();
     }
 
+    /**
+     * @return the number of {@link DatagramChannel}s listening on the network port
+     */
+    public int getChannels()
+    {
+        return channels;
+    }
+
     @Override
     public int getLocalPort()
     {
@@ -160,7 +202,7 @@ public class QuicServerConnector extends AbstractNetworkConnector
         addBean(container);
         addBean(selectorManager);
         addBean(connectionFactory);
-        addBean(datagramChannel);
+        datagramChannels.forEach(this::addBean);
 
         for (EventListener l : getBeans(SelectorManager.SelectorManagerListener.class))
             selectorManager.addEventListener(l);
@@ -169,7 +211,7 @@ public class QuicServerConnector extends AbstractNetworkConnector
 
         super.doStart();
 
-        selectorManager.accept(datagramChannel);
+        datagramChannels.forEach(selectorManager::accept);
     }
 
     private Path findPemWorkDirectory()
@@ -192,21 +234,80 @@ public class QuicServerConnector extends AbstractNetworkConnector
     {
         if (datagramChannel == null)
         {
-            datagramChannel = openDatagramChannel();
-            datagramChannel.configureBlocking(false);
-            localPort = datagramChannel.socket().getLocalPort();
-            if (localPort <= 0)
-                throw new IOException("DatagramChannel not bound");
+            boolean reusePort = channels > 1;
+            if (reusePort && !isReusePortSupported())
+            {
+                LOG.warn("SO_REUSEPORT not supported, using 1 DatagramChannel instead of {}", channels);
+                reusePort = false;
+            }
+            DatagramChannel channel = openDatagramChannel(getPort(), reusePort);
+            datagramChannels.add(channel);
+            try
+            {
+                channel.configureBlocking(false);
+                localPort = channel.socket().getLocalPort();
+                if (localPort <= 0)
+                    throw new IOException("DatagramChannel not bound");
+                if (reusePort)
+                {
+                    // Bind the other channels to the actual port, in case the configured port is 0.
+                    for (int i = 1; i < channels; ++i)
+                    {
+                        DatagramChannel other = openDatagramChannel(localPort, true);
+                        datagramChannels.add(other);
+                        other.configureBlocking(false);
+                    }
+                }
+            }
+            catch (Throwable x)
+            {
+                datagramChannels.forEach(IO::close);
+                datagramChannels.clear();
+                throw x;
+            }
+            datagramChannel = channel;
             super.open();
         }
     }
 
+    /**
+     * @return a bound {@link DatagramChannel}
+     * @throws IOException if the channel cannot be opened or bound
+     * @deprecated use {@link #openDatagramChannel(int, boolean)} instead
+     */
+    @Deprecated(since = "12.0.8", forRemoval = true)
     protected DatagramChannel openDatagramChannel() throws IOException
     {
-        InetSocketAddress bindAddress = getHost() == null ? new InetSocketAddress(getPort()) : new InetSocketAddress(getHost(), getPort());
+        return openDatagramChannel(getPort(), false);
+    }
+
+    private static boolean isReusePortSupported() throws IOException
+    {
+        try (DatagramChannel channel = DatagramChannel.open())
+        {
+            return channel.supportedOptions().contains(StandardSocketOptions.SO_REUSEPORT);
+        }
+    }
+
+    /**
+     * <p>Opens a {@link DatagramChannel} bound to the configured host and the given port.</p>
+     * <p>When this connector uses more than one channel, this method is called once
+     * per channel with {@code reusePort=true}, first with the configured port and
+     * then with the actual local port of the first channel.</p>
+     *
+     * @param port the port to bind to
+     * @param reusePort whether {@link StandardSocketOptions#SO_REUSEPORT} must be enabled
+     * @return a bound {@link DatagramChannel}
+     * @throws IOException if the channel cannot be opened or bound
+     */
+    protected DatagramChannel openDatagramChannel(int port, boolean reusePort) throws IOException
+    {
+        InetSocketAddress bindAddress = getHost() == null ? new InetSocketAddress(port) : new InetSocketAddress(getHost(), port);
         DatagramChannel datagramChannel = DatagramChannel.open();
         try
         {
+            if (reusePort)
+                datagramChannel.setOption(StandardSocketOptions.SO_REUSEPORT, true);
             datagramChannel.bind(bindAddress);
             return datagramChannel;
         }
@@ -229,7 +330,8 @@ public class QuicServerConnector extends AbstractNetworkConnector
     {
         super.doStop();
 
-        removeBean(datagramChannel);
+        datagramChannels.forEach(this::removeBean);
+        datagramChannels.clear();
         datagramChannel = null;
 
         for (EventListener l : getBeans(EventListener.class))
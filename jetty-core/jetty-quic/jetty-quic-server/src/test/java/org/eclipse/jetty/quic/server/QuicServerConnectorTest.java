@@ -13,6 +13,10 @@
 
 package org.eclipse.jetty.quic.server;
 
+import java.net.StandardSocketOptions;
+import java.nio.channels.DatagramChannel;
+import java.util.Collection;
+
 import org.eclipse.jetty.http.HttpCompliance;
 import org.eclipse.jetty.http.HttpHeader;
 import org.eclipse.jetty.io.Content;
@@ -22,13 +26,64 @@ import org.eclipse.jetty.server.HttpConnectionFactory;
 import org.eclipse.jetty.server.Request;
 import org.eclipse.jetty.server.Response;
 import org.eclipse.jetty.server.Server;
+import org.eclipse.jetty.toolchain.test.jupiter.WorkDir;
+import org.eclipse.jetty.toolchain.test.jupiter.WorkDirExtension;
 import org.eclipse.jetty.util.Callback;
 import org.eclipse.jetty.util.ssl.SslContextFactory;
 import org.junit.jupiter.api.Disabled;
 import org.junit.jupiter.api.Test;
+import org.junit.jupiter.api.extension.ExtendWith;
+
+import static org.hamcrest.MatcherAssert.assertThat;
+import static org.hamcrest.Matchers.greaterThan;
+import static org.hamcrest.Matchers.is;
+import static org.junit.jupiter.api.Assertions.assertEquals;
+import static org.junit.jupiter.api.Assertions.assertTrue;
+import static org.junit.jupiter.api.Assumptions.assumeTrue;
 
+@ExtendWith(WorkDirExtension.class)
 public class QuicServerConnectorTest
 {
+    public WorkDir workDir;
+
+    @Test
+    public void testReusePortChannels() throws Exception
+    {
+        try (DatagramChannel channel = DatagramChannel.open())
+        {
+            assumeTrue(channel.supportedOptions().contains(StandardSocketOptions.SO_REUSEPORT));
+        }
+
+        SslContextFactory.Server sslContextFactory = new SslContextFactory.Server();
+        sslContextFactory.setKeyStorePath("src/test/resources/keystore.p12");
+        sslContextFactory.setKeyStorePassword("storepwd");
+
+        Server server = new Server();
+        ServerQuicConfiguration quicConfig = new ServerQuicConfiguration(sslContextFactory, workDir.getEmptyPathDir());
+        int channels = 4;
+        QuicServerConnector connector = new QuicServerConnector(server, null, null, null, channels, quicConfig, new HttpConnectionFactory());
+        server.addConnector(connector);
+
+        try
+        {
+            server.start();
+
+            int localPort = connector.getLocalPort();
+            assertThat(localPort, greaterThan(0));
+            Collection<DatagramChannel> datagramChannels = connector.getBeans(DatagramChannel.class);
+            assertEquals(channels, datagramChannels.size());
+            for (DatagramChannel datagramChannel : datagramChannels)
+            {
+                assertTrue(datagramChannel.isOpen());
+                assertThat(datagramChannel.socket().getLocalPort(), is(localPort));
+            }
+        }
+        finally
+        {
+            server.stop();
+        }
+    }
+
     @Disabled
     @Test
     public void testSmall() throws Exception
@@ -0,0 +1,27 @@
+# DO NOT EDIT THIS FILE - See: https://eclipse.dev/jetty/documentation/
+
+[description]
+Enable a first level session cache that keeps only the recently used
+sessions on-heap, and holds the serialized data of the evicted sessions
+in off-heap memory.
+
+[tags]
+session
+
+[provides]
+session-cache
+
+[depends]
+sessions
+
+[xml]
+etc/sessions/session-cache-offheap.xml
+
+[ini-template]
+#jetty.session.evictionPolicy=1800
+#jetty.session.saveOnInactiveEviction=false
+#jetty.session.saveOnCreate=false
+#jetty.session.removeUnloadableSessions=false
+#jetty.session.flushOnResponseCommit=false
+#jetty.session.invalidateOnShutdown=false
+#jetty.session.maxOffHeapBytes=-1
@@ -28,6 +28,15 @@ db-connection-type?=datasource
 #jetty.session.gracePeriod.seconds=3600
 #jetty.session.savePeriod.seconds=0
 
+## Queue and coalesce the stores for this period before flushing them as JDBC batches (0 to store immediately)
+#jetty.session.jdbc.writeBehind.ms=0
+
+## Write the attribute map only when the session attributes changed
+#jetty.session.jdbc.partialUpdates=false
+
+## Max number of expired sessions selected per query (0 for unlimited)
+#jetty.session.jdbc.expiryPageSize=0
+
 #jetty.session.jdbc.blobType=
 #jetty.session.jdbc.longType=
 #jetty.session.jdbc.stringType=
@@ -0,0 +1,414 @@
+//
+// ========================================================================
+// Copyright (c) 1995 Mort Bay Consulting Pty Ltd and others.
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License v. 2.0 which is available at
+// https://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+// ========================================================================
+//
+
+package org.eclipse.jetty.server;
+
+import java.io.IOException;
+import java.nio.ByteBuffer;
+import java.nio.channels.Channels;
+import java.nio.channels.FileChannel;
+import java.nio.channels.GatheringByteChannel;
+import java.nio.channels.WritableByteChannel;
+import java.nio.charset.StandardCharsets;
+import java.nio.file.OpenOption;
+import java.nio.file.Path;
+import java.nio.file.StandardOpenOption;
+import java.util.concurrent.TimeUnit;
+import java.util.concurrent.atomic.AtomicInteger;
+import java.util.concurrent.atomic.AtomicLong;
+import java.util.concurrent.atomic.AtomicReferenceArray;
+import java.util.concurrent.atomic.LongAdder;
+import java.util.concurrent.locks.LockSupport;
+
+import org.eclipse.jetty.io.RetainableByteBuffer;
+import org.eclipse.jetty.util.annotation.ManagedAttribute;
+import org.eclipse.jetty.util.annotation.ManagedObject;
+import org.eclipse.jetty.util.annotation.ManagedOperation;
+import org.eclipse.jetty.util.component.AbstractLifeCycle;
+import org.slf4j.Logger;
+import org.slf4j.LoggerFactory;
+
+/**
+ * <p>A {@link RequestLog.BufferWriter} that queues encoded log entries in a bounded,
+ * lock-free ring that is drained by a single writer thread.</p>
+ * <p>The writer thread takes up to {@link #getMaxBatchSize()} entries at a time and
+ * writes them to the file with a single gathering write, then releases the buffers.</p>
+ * <p>When the ring is full, the {@link OverflowPolicy} decides whether the logging
+ * thread waits for space or the entry is dropped and counted.</p>
+ * <p>Unlike {@link RequestLogWriter}, this writer does not roll over the log file.</p>
+ */
+@ManagedObject("Request Log writer which batches encoded entries to file")
+public class BatchingRequestLogWriter extends AbstractLifeCycle implements RequestLog.BufferWriter
+{
+    private static final Logger LOG = LoggerFactory.getLogger(BatchingRequestLogWriter.class);
+    private static final byte[] LINE_SEPARATOR = System.lineSeparator().getBytes(StandardCharsets.UTF_8);
+    private static final long IDLE_PARK_NANOS = TimeUnit.MILLISECONDS.toNanos(100);
+    private static final long FULL_PARK_NANOS = TimeUnit.MICROSECONDS.toNanos(50);
+
+    /**
+     * <p>What to do with a log entry when the ring is full.</p>
+     */
+    public enum OverflowPolicy
+    {
+        /**
+         * The logging thread waits until the writer thread makes space.
+         */
+        BLOCK,
+        /**
+         * The entry is discarded and counted in {@link #getDroppedCount()}.
+         */
+        DROP
+    }
+
+    private final AtomicLong _head = new AtomicLong();
+    private final AtomicLong _tail = new AtomicLong();
+    private final AtomicInteger _producers = new AtomicInteger();
+    private final LongAdder _written = new LongAdder();
+    private final LongAdder _dropped = new LongAdder();
+    private String _filename;
+    private boolean _append = true;
+    private int _capacity = 4096;
+    private int _maxBatchSize = 256;
+    private OverflowPolicy _overflowPolicy = OverflowPolicy.DROP;
+    private transient AtomicReferenceArray<RetainableByteBuffer> _ring;
+    private transient int _mask;
+    private transient WritableByteChannel _channel;
+    private transient boolean _closeChannel;
+    private transient Thread _thread;
+    private volatile boolean _parked;
+    private volatile boolean _stopping;
+
+    public BatchingRequestLogWriter()
+    {
+        this(null);
+    }
+
+    public BatchingRequestLogWriter(String filename)
+    {
+        setFilename(filename);
+    }
+
+    /**
+     * @param filename the log file name, or null to write to {@link System#err}
+     */
+    public void setFilename(String filename)
+    {
+        if (filename != null)
+        {
+            filename = filename.trim();
+            if (filename.length() == 0)
+                filename = null;
+        }
+        _filename = filename;
+    }
+
+    @ManagedAttribute("filename")
+    public String getFileName()
+    {
+        return _filename;
+    }
+
+    /**
+     * @param append true to append to an existing log file, false to truncate it on start
+     */
+    public void setAppend(boolean append)
+    {
+        _append = append;
+    }
+
+    @ManagedAttribute("if request log file will be appended after restart")
+    public boolean isAppend()
+    {
+        return _append;
+    }
+
+    /**
+     * @param capacity the maximum number of queued entries, rounded up to a power of 2
+     */
+    public void setCapacity(int capacity)
+    {
+        if (isRunning())
+            throw new IllegalStateException(getState());
+        if (capacity <= 0)
+            throw new IllegalArgumentException("Invalid capacity " + capacity);
+        _capacity = capacity == 1 ? 1 : Integer.highestOneBit(capacity - 1) << 1;
+    }
+
+    @ManagedAttribute("The maximum number of queued entries")
+    public int getCapacity()
+    {
+        return _capacity;
+    }
+
+    /**
+     * @param maxBatchSize the maximum number of entries written by a single gathering write
+     */
+    public void setMaxBatchSize(int maxBatchSize)
+    {
+        if (isRunning())
+            throw new IllegalStateException(getState());
+        if (maxBatchSize <= 0)
+            throw new IllegalArgumentException("Invalid max batch size " + maxBatchSize);
+        _maxBatchSize = maxBatchSize;
+    }
+
+    @ManagedAttribute("The maximum number of entries written by a single gathering write")
+    public int getMaxBatchSize()
+    {
+        return _maxBatchSize;
+    }
+
+    public void setOverflowPolicy(OverflowPolicy overflowPolicy)
+    {
+        _overflowPolicy = overflowPolicy == null ? OverflowPolicy.DROP : overflowPolicy;
+    }
+
+    @ManagedAttribute("What to do when the queue is full")
+    public OverflowPolicy getOverflowPolicy()
+    {
+        return _overflowPolicy;
+    }
+
+    @ManagedAttribute("The number of queued entries")
+    public int getQueueSize()
+    {
+        return (int)(_tail.get() - _head.get());
+    }
+
+    @ManagedAttribute("The number of entries written")
+    public long getWrittenCount()
+    {
+        return _written.sum();
+    }
+
+    @ManagedAttribute("The number of entries dropped because the queue was full")
+    public long getDroppedCount()
+    {
+        return _dropped.sum();
+    }
+
+    @ManagedOperation(value = "Resets the statistics", impact = "ACTION")
+    public void resetStatistics()
+    {
+        _written.reset();
+        _dropped.reset();
+    }
+
+    @Override
+    public void write(String requestEntry) throws IOException
+    {
+        byte[] bytes = requestEntry.getBytes(StandardCharsets.UTF_8);
+        ByteBuffer buffer = ByteBuffer.allocate(bytes.length + LINE_SEPARATOR.length);
+        buffer.put(bytes).put(LINE_SEPARATOR).flip();
+        write(RetainableByteBuffer.wrap(buffer));
+    }
+
+    @Override
+    public void write(RetainableByteBuffer requestEntry) throws IOException
+    {
+        // The writer thread does not exit while producers are in this method,
+        // so an entry is either published before it drains or refused here.
+        _producers.incrementAndGet();
+        try
+        {
+            publish(requestEntry);
+        }
+        finally
+        {
+            _producers.decrementAndGet();
+        }
+    }
+
+    private void publish(RetainableByteBuffer requestEntry)
+    {
+        AtomicReferenceArray<RetainableByteBuffer> ring = _ring;
+        if (ring == null || _stopping)
+        {
+            requestEntry.release();
+            return;
+        }
+
+        long tail;
+        while (true)
+        {
+            tail = _tail.get();
+            if (tail - _head.get() < _capacity)
+            {
+                if (_tail.compareAndSet(tail, tail + 1))
+                    break;
+                continue;
+            }
+
+            if (_overflowPolicy == OverflowPolicy.DROP || _stopping)
+            {
+                _dropped.increment();
+                requestEntry.release();
+                return;
+            }
+            LockSupport.unpark(_thread);
+            LockSupport.parkNanos(FULL_PARK_NANOS);
+        }
+
+        // The slot was claimed, publish the entry for the writer thread.
+        ring.lazySet((int)tail & _mask, requestEntry);
+        if (_parked)
+            LockSupport.unpark(_thread);
+    }
+
+    @Override
+    protected void doStart() throws Exception
+    {
+        if (_filename != null)
+        {
+            OpenOption[] options = _append
+                ? new OpenOption[]{StandardOpenOption.CREATE, StandardOpenOption.WRITE, StandardOpenOption.APPEND}
+                : new OpenOption[]{StandardOpenOption.CREATE, StandardOpenOption.WRITE, StandardOpenOption.TRUNCATE_EXISTING};
+            _channel = FileChannel.open(Path.of(_filename), options);
+            _closeChannel = true;
+            LOG.info("Opened {}", _filename);
+        }
+        else
+        {
+            _channel = Channels.newChannel(System.err);
+        }
+        _ring = new AtomicReferenceArray<>(_capacity);
+        _mask = _capacity - 1;
+        _head.set(0);
+        _tail.set(0);
+        _stopping = false;
+        _thread = new Thread(this::run, "BatchingRequestLogWriter@" + Integer.toString(hashCode(), 16));
+        _thread.setDaemon(true);
+        _thread.start();
+        super.doStart();
+    }
+
+    @Override
+    protected void doStop() throws Exception
+    {
+        _stopping = true;
+        LockSupport.unpark(_thread);
+        _thread.join();
+        _thread = null;
+        super.doStop();
+
+        if (_closeChannel)
+        {
+            try
+            {
+                _channel.close();
+            }
+            catch (IOException e)
+            {
+                LOG.trace("IGNORED", e);
+            }
+        }
+        _channel = null;
+        _closeChannel = false;
+        _ring = null;
+    }
+
+    private void run()
+    {
+        RetainableByteBuffer[] batch = new RetainableByteBuffer[Math.min(_maxBatchSize, _capacity)];
+        ByteBuffer[] buffers = new ByteBuffer[batch.length];
+        while (true)
+        {
+            int count = take(batch, buffers);
+            if (count > 0)
+            {
+                flush(batch, buffers, count);
+                continue;
+            }
+
+            if (_stopping)
+            {
+                // Producers may still be publishing entries in claimed slots,
+                // and those that have not yet seen the stop may still claim one.
+                if (_producers.get() == 0 && _head.get() == _tail.get())
+                    return;
+                Thread.onSpinWait();
+                continue;
+            }
+
+            _parked = true;
+            if (_head.get() == _tail.get())
+                LockSupport.parkNanos(IDLE_PARK_NANOS);
+            _parked = false;
+        }
+    }
+
+    private int take(RetainableByteBuffer[] batch, ByteBuffer[] buffers)
+    {
+        AtomicReferenceArray<RetainableByteBuffer> ring = _ring;
+        long head = _head.get();
+        int count = 0;
+        while (count < batch.length)
+        {
+            int index = (int)(head + count) & _mask;
+            RetainableByteBuffer entry = ring.get(index);
+            // A null entry is either the end of the queue or a slot claimed but not yet published.
+            if (entry == null)
+                break;
+            ring.lazySet(index, null);
+            batch[count] = entry;
+            buffers[count] = entry.getByteBuffer();
+            ++count;
+        }
+        if (count > 0)
+            _head.lazySet(head + count);
+        return count;
+    }
+
+    private void flush(RetainableByteBuffer[] batch, ByteBuffer[] buffers, int count)
+    {
+        try
+        {
+            if (_channel instanceof GatheringByteChannel gathering)
+            {
+                int offset = 0;
+                while (offset < count)
+                {
+                    gathering.write(buffers, offset, count - offset);
+                    while (offset < count && !buffers[offset].hasRemaining())
+                    {
+                        ++offset;
+                    }
+                }
+            }
+            else
+            {
+                for (int i = 0; i < count; ++i)
+                {
+                    while (buffers[i].hasRemaining())
+                    {
+                        _channel.write(buffers[i]);
+                    }
+                }
+            }
+            _written.add(count);
+        }
+        catch (Throwable x)
+        {
+            LOG.warn("Failed to write log", x);
+        }
+        finally
+        {
+            for (int i = 0; i < count; ++i)
+            {
+                batch[i].release();
+                batch[i] = null;
+                buffers[i] = null;
+            }
+        }
+    }
+}
@@ -16,6 +16,7 @@ package org.eclipse.jetty.server;
 import java.lang.invoke.MethodHandle;
 import java.lang.invoke.MethodHandles;
 import java.lang.invoke.MethodType;
+import java.nio.ByteBuffer;
 import java.security.Principal;
 import java.util.ArrayList;
 import java.util.Collections;
@@ -33,6 +34,8 @@ import org.eclipse.jetty.http.HttpCookie;
 import org.eclipse.jetty.http.HttpFields;
 import org.eclipse.jetty.http.QuotedCSV;
 import org.eclipse.jetty.http.pathmap.PathMappings;
+import org.eclipse.jetty.io.RetainableByteBuffer;
+import org.eclipse.jetty.util.BufferUtil;
 import org.eclipse.jetty.util.DateCache;
 import org.eclipse.jetty.util.NanoTime;
 import org.eclipse.jetty.util.StringUtil;
@@ -308,6 +311,7 @@ public class CustomRequestLog extends ContainerLifeCycle implements RequestLog
     public static final String EXTENDED_NCSA_FORMAT = NCSA_FORMAT + " \"%{Referer}i\" \"%{User-Agent}i\"";
     public static final String LOG_DETAIL = CustomRequestLog.class.getName() + ".logDetail";
     private static final Logger LOG = LoggerFactory.getLogger(CustomRequestLog.class);
+    private static final String LINE_SEPARATOR = System.lineSeparator();
     private static final ThreadLocal<StringBuilder> _buffers = ThreadLocal.withInitial(() -> new StringBuilder(256));
 
     private final RequestLog.Writer _requestLogWriter;
@@ -380,8 +384,31 @@ public class CustomRequestLog extends ContainerLifeCycle implements RequestLog
 
             _logHandle.invoke(sb, request, response);
 
-            String log = sb.toString();
-            _requestLogWriter.write(log);
+            if (_requestLogWriter instanceof RequestLog.BufferWriter bufferWriter)
+            {
+                // Encode directly into a pooled buffer, avoiding the String and byte[] copies.
+                sb.append(LINE_SEPARATOR);
+                RetainableByteBuffer buffer = request.getComponents().getByteBufferPool().acquire(BufferUtil.utf8Length(sb), true);
+                try
+                {
+                    ByteBuffer byteBuffer = buffer.getByteBuffer();
+                    int pos = BufferUtil.flipToFill(byteBuffer);
+                    BufferUtil.putUtf8(byteBuffer, sb);
+                    BufferUtil.flipToFlush(byteBuffer, pos);
+                }
+                catch (Throwable x)
+                {
+                    buffer.release();
+                    throw x;
+                }
+                // The writer now owns the buffer and releases it.
+                bufferWriter.write(buffer);
+            }
+            else
+            {
+                String log = sb.toString();
+                _requestLogWriter.write(log);
+            }
         }
         catch (Throwable e)
         {
@@ -57,6 +57,7 @@ public interface Deployable
     String CONTAINER_SCAN_JARS = "jetty.deploy.containerScanJarPattern";
     String CONTEXT_PATH = "jetty.deploy.contextPath";
     String DEFAULTS_DESCRIPTOR = "jetty.deploy.defaultsDescriptor";
+    String DEPENDS_ON = "jetty.deploy.dependsOn";
     String ENVIRONMENT = "environment";
     String EXTRACT_WARS = "jetty.deploy.extractWars";
     String PARENT_LOADER_PRIORITY = "jetty.deploy.parentLoaderPriority";
@@ -14,12 +14,15 @@
 package org.eclipse.jetty.server;
 
 import java.util.Objects;
+import java.util.concurrent.atomic.LongAdder;
 
 import org.eclipse.jetty.http.ComplianceViolation;
 import org.eclipse.jetty.http.HttpVersion;
 import org.eclipse.jetty.io.Connection;
 import org.eclipse.jetty.io.EndPoint;
 import org.eclipse.jetty.server.internal.HttpConnection;
+import org.eclipse.jetty.util.annotation.ManagedAttribute;
+import org.eclipse.jetty.util.annotation.ManagedOperation;
 import org.eclipse.jetty.util.annotation.Name;
 import org.slf4j.Logger;
 import org.slf4j.LoggerFactory;
@@ -34,6 +37,20 @@ public class HttpConnectionFactory extends AbstractConnectionFactory implements
 {
     private static final Logger LOG = LoggerFactory.getLogger(HttpConnectionFactory.class);
     private final HttpConfiguration _config;
+    private final LongAdder _headerCacheHits = new LongAdder();
+    private final LongAdder _headerCacheMisses = new LongAdder();
+    private final Connection.Listener _headerCacheListener = new Connection.Listener()
+    {
+        @Override
+        public void onClosed(Connection connection)
+        {
+            if (connection instanceof HttpConnection httpConnection)
+            {
+                _headerCacheHits.add(httpConnection.getParser().getHeaderCacheHits());
+                _headerCacheMisses.add(httpConnection.getParser().getHeaderCacheMisses());
+            }
+        }
+    };
     private boolean _useInputDirectByteBuffers;
     private boolean _useOutputDirectByteBuffers;
 
@@ -98,12 +115,40 @@ public class HttpConnectionFactory extends AbstractConnectionFactory implements
         _useOutputDirectByteBuffers = useOutputDirectByteBuffers;
     }
 
+    /**
+     * @return the number of request header fields, parsed on closed connections, that reused a cached field instance
+     * @see HttpConfiguration#getHeaderCacheSize()
+     */
+    @ManagedAttribute("The number of parsed header fields that reused a cached field on closed connections")
+    public long getHeaderCacheHits()
+    {
+        return _headerCacheHits.sum();
+    }
+
+    /**
+     * @return the number of request header fields, parsed on closed connections, that allocated a new field instance
+     * @see HttpConfiguration#getHeaderCacheSize()
+     */
+    @ManagedAttribute("The number of parsed header fields that allocated a new field on closed connections")
+    public long getHeaderCacheMisses()
+    {
+        return _headerCacheMisses.sum();
+    }
+
+    @ManagedOperation(value = "Resets the header cache statistics", impact = "ACTION")
+    public void resetHeaderCacheStatistics()
+    {
+        _headerCacheHits.reset();
+        _headerCacheMisses.reset();
+    }
+
     @Override
     public Connection newConnection(Connector connector, EndPoint endPoint)
     {
         HttpConnection connection = new HttpConnection(_config, connector, endPoint);
         connection.setUseInputDirectByteBuffers(isUseInputDirectByteBuffers());
         connection.setUseOutputDirectByteBuffers(isUseOutputDirectByteBuffers());
+        connection.addEventListener(_headerCacheListener);
         return configure(connection, connector, endPoint);
     }
 }
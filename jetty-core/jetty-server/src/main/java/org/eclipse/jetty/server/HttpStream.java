@@ -14,6 +14,7 @@
 package org.eclipse.jetty.server;
 
 import java.nio.ByteBuffer;
+import java.nio.channels.FileChannel;
 
 import org.eclipse.jetty.http.HttpFields;
 import org.eclipse.jetty.http.MetaData;
@@ -82,6 +83,34 @@ public interface HttpStream extends Callback
      */
     void send(MetaData.Request request, MetaData.Response response, boolean last, ByteBuffer content, Callback callback);
 
+    /**
+     * @return whether this stream supports {@link #transfer(MetaData.Request, MetaData.Response, boolean, FileChannel, long, long, Callback)}.
+     * {@link Wrapper}s do not support transfers unless they override this method, so that they cannot be bypassed.
+     */
+    default boolean isTransferSupported()
+    {
+        return false;
+    }
+
+    /**
+     * <p>Send response meta-data and/or a region of a file as data, with the same semantic as
+     * {@link #send(MetaData.Request, MetaData.Response, boolean, ByteBuffer, Callback)}, but
+     * possibly without copying the file content through user space buffers.</p>
+     * @param request The request metadata for which the response should be sent.
+     * @param response The response metadata to be sent or null if the response is already committed by a previous call
+     *                 to send.
+     * @param last True if this will be the last call to send and the response can be completed.
+     * @param file The file containing the content to send.
+     * @param position The position within the file of the content to send.
+     * @param length The length of the content to send.
+     * @param callback The callback to invoke when the send is completed successfully or in failure.
+     * @see #isTransferSupported()
+     */
+    default void transfer(MetaData.Request request, MetaData.Response response, boolean last, FileChannel file, long position, long length, Callback callback)
+    {
+        callback.failed(new UnsupportedOperationException());
+    }
+
     /**
      * <p>Pushes the given {@code resource} to the client.</p>
      *
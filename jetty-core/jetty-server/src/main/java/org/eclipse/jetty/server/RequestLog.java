@@ -15,6 +15,8 @@ package org.eclipse.jetty.server;
 
 import java.io.IOException;
 
+import org.eclipse.jetty.io.RetainableByteBuffer;
+
 /**
  * TODO
  * @see Server#setRequestLog(RequestLog)
@@ -35,6 +37,24 @@ public interface RequestLog
         void write(String requestEntry) throws IOException;
     }
 
+    /**
+     * <p>A {@link Writer} that accepts log entries already encoded to bytes,
+     * so that the entry is never materialized as a {@code String}.</p>
+     */
+    interface BufferWriter extends Writer
+    {
+        /**
+         * <p>Writes an encoded log entry.</p>
+         * <p>The buffer, in flush mode, contains the UTF-8 bytes of the entry
+         * terminated by the line separator; ownership of the buffer is passed
+         * to this writer, that must release it once written or discarded.</p>
+         *
+         * @param requestEntry the encoded log entry
+         * @throws IOException if the entry cannot be written
+         */
+        void write(RetainableByteBuffer requestEntry) throws IOException;
+    }
+
     class Collection implements RequestLog
     {
         private final RequestLog[] _logs;
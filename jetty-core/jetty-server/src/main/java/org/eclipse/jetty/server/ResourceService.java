@@ -15,8 +15,12 @@ package org.eclipse.jetty.server;
 
 import java.io.IOException;
 import java.nio.ByteBuffer;
+import java.nio.channels.FileChannel;
 import java.nio.charset.Charset;
 import java.nio.charset.StandardCharsets;
+import java.nio.file.FileSystems;
+import java.nio.file.Path;
+import java.nio.file.StandardOpenOption;
 import java.util.ArrayList;
 import java.util.Collection;
 import java.util.Collections;
@@ -45,7 +49,9 @@ import org.eclipse.jetty.http.content.PreCompressedHttpContent;
 import org.eclipse.jetty.io.Content;
 import org.eclipse.jetty.io.IOResources;
 import org.eclipse.jetty.server.handler.ContextHandler;
+import org.eclipse.jetty.server.internal.HttpChannelState;
 import org.eclipse.jetty.util.Callback;
+import org.eclipse.jetty.util.IO;
 import org.eclipse.jetty.util.URIUtil;
 import org.slf4j.Logger;
 import org.slf4j.LoggerFactory;
@@ -70,6 +76,7 @@ public class ResourceService
     private int _encodingCacheSize = 100;
     private boolean _dirAllowed = true;
     private boolean _acceptRanges = true;
+    private boolean _fileTransfer = true;
     private HttpField _cacheControl;
 
     public ResourceService()
@@ -681,7 +688,8 @@ public class ResourceService
             response.getHeaders().put(HttpHeader.CONTENT_RANGE, range.toHeaderValue(contentLength));
 
             // TODO use a buffer pool
-            IOResources.copy(content.getResource(), response, null, 0, false, range.first(), range.getLength(), callback);
+            if (!transfer(response, content, range.first(), range.getLength(), callback))
+                IOResources.copy(content.getResource(), response, null, 0, false, range.first(), range.getLength(), callback);
             return;
         }
 
@@ -707,7 +715,7 @@ public class ResourceService
             {
                 response.write(true, buffer, callback);
             }
-            else
+            else if (!transfer(response, content, 0, content.getContentLengthValue(), callback))
             {
                 IOResources.copy(
                     content.getResource(),
@@ -724,6 +732,48 @@ public class ResourceService
         }
     }
 
+    /**
+     * <p>Writes a region of the file of the content directly from the file to the connection,
+     * when the file transfer mode is enabled, the response wrappers pass the content through
+     * unmodified (for example it is not compressed) and the connection supports it (for example
+     * it is not TLS).</p>
+     *
+     * @return true if the region is being written, false if it must be written with buffers
+     * @see #isFileTransfer()
+     */
+    private boolean transfer(Response response, HttpContent content, long position, long length, Callback callback)
+    {
+        if (!isFileTransfer() || length < 0)
+            return false;
+        Response original = response;
+        while (original instanceof Response.Wrapper wrapper)
+        {
+            if (!wrapper.isContentPassThrough())
+                return false;
+            original = wrapper.getWrapped();
+        }
+        if (!(original instanceof HttpChannelState.ChannelResponse channelResponse) || !channelResponse.isTransferSupported())
+            return false;
+        Path path = content.getResource().getPath();
+        if (path == null || path.getFileSystem() != FileSystems.getDefault())
+            return false;
+
+        FileChannel file;
+        try
+        {
+            file = FileChannel.open(path, StandardOpenOption.READ);
+        }
+        catch (Throwable x)
+        {
+            if (LOG.isDebugEnabled())
+                LOG.debug("Cannot transfer {}", path, x);
+            return false;
+        }
+
+        channelResponse.transfer(true, file, position, length, Callback.from(callback, () -> IO.close(file)));
+        return true;
+    }
+
     protected void putHeaders(Response response, HttpContent content, long contentLength)
     {
         // TODO it is very inefficient to do many put's to a HttpFields, as each put is a full iteration.
@@ -785,6 +835,16 @@ public class ResourceService
         return _acceptRanges;
     }
 
+    /**
+     * @return If true, file content that is not cached in memory is written directly from the file to the
+     * connection with {@link FileChannel#transferTo(long, long, java.nio.channels.WritableByteChannel)}
+     * when the connection supports it.
+     */
+    public boolean isFileTransfer()
+    {
+        return _fileTransfer;
+    }
+
     /**
      * @return If true, directory listings are returned if no welcome target is found. Else 403 Forbidden.
      */
@@ -836,6 +896,15 @@ public class ResourceService
         _cacheControl = new PreEncodedHttpField(HttpHeader.CACHE_CONTROL, cacheControl);
     }
 
+    /**
+     * @param fileTransfer If true, file content that is not cached in memory is written directly from the file
+     * to the connection when the connection supports it.
+     */
+    public void setFileTransfer(boolean fileTransfer)
+    {
+        _fileTransfer = fileTransfer;
+    }
+
     /**
      * @param dirAllowed If true, directory listings are returned if no welcome target is found. Else 403 Forbidden.
      */
@@ -665,6 +665,22 @@ public interface Response extends Content.Sink
 
     class Wrapper implements Response
     {
+        private static final ClassValue<Boolean> WRITE_OVERRIDDEN = new ClassValue<>()
+        {
+            @Override
+            protected Boolean computeValue(Class<?> type)
+            {
+                try
+                {
+                    return type.getMethod("write", boolean.class, ByteBuffer.class, Callback.class).getDeclaringClass() != Wrapper.class;
+                }
+                catch (NoSuchMethodException x)
+                {
+                    return true;
+                }
+            }
+        };
+
         private final Request _request;
         private final Response _wrapped;
 
@@ -679,6 +695,22 @@ public interface Response extends Content.Sink
             return _wrapped;
         }
 
+        /**
+         * <p>Returns whether the content written to this wrapper reaches the wrapped
+         * response unmodified, so that it may be written directly to the wrapped response,
+         * bypassing {@link #write(boolean, ByteBuffer, Callback)}, for example to transfer
+         * a file directly to the connection.</p>
+         * <p>By default, this is {@code true} only if {@link #write(boolean, ByteBuffer, Callback)}
+         * is not overridden; wrappers that override it without modifying or accounting
+         * the content may override this method to return {@code true}.</p>
+         *
+         * @return whether the content written to this wrapper is passed through unmodified
+         */
+        public boolean isContentPassThrough()
+        {
+            return !WRITE_OVERRIDDEN.get(getClass());
+        }
+
         @Override
         public Request getRequest()
         {
@@ -26,6 +26,7 @@ import java.nio.channels.SelectableChannel;
 import java.nio.channels.SelectionKey;
 import java.nio.channels.ServerSocketChannel;
 import java.nio.channels.SocketChannel;
+import java.nio.channels.spi.SelectorProvider;
 import java.util.EventListener;
 import java.util.concurrent.Executor;
 import java.util.concurrent.atomic.AtomicReference;
@@ -336,7 +337,7 @@ public class ServerConnector extends AbstractNetworkConnector
         if (serverChannel == null)
         {
             InetSocketAddress bindAddress = getHost() == null ? new InetSocketAddress(getPort()) : new InetSocketAddress(getHost(), getPort());
-            serverChannel = ServerSocketChannel.open();
+            serverChannel = getSelectorProvider().openServerSocketChannel();
             setSocketOption(serverChannel, StandardSocketOptions.SO_REUSEADDR, getReuseAddress());
             setSocketOption(serverChannel, StandardSocketOptions.SO_REUSEPORT, isReusePort());
             try
@@ -478,6 +479,27 @@ public class ServerConnector extends AbstractNetworkConnector
         _reuseAddress = reuseAddress;
     }
 
+    /**
+     * @return the {@link SelectorProvider} used to open the accept channel and the selectors
+     */
+    @ManagedAttribute("The SelectorProvider")
+    public SelectorProvider getSelectorProvider()
+    {
+        return _manager.getSelectorProvider();
+    }
+
+    /**
+     * <p>Sets the {@link SelectorProvider} used to open the accept channel and the selectors.</p>
+     * <p>This allows to plug in an alternative, possibly native, selector implementation
+     * in place of the JVM default, while the {@link ManagedSelector} select loop is retained.</p>
+     *
+     * @param selectorProvider the {@link SelectorProvider}, or null for the JVM default
+     */
+    public void setSelectorProvider(SelectorProvider selectorProvider)
+    {
+        _manager.setSelectorProvider(selectorProvider);
+    }
+
     /**
      * @return whether it is allowed to bind multiple server sockets to the same host and port
      */
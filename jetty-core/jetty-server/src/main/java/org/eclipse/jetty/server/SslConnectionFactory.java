@@ -40,6 +40,7 @@ public class SslConnectionFactory extends AbstractConnectionFactory implements C
     private boolean _directBuffersForEncryption = false;
     private boolean _directBuffersForDecryption = false;
     private boolean _ensureSecureRequestCustomizer = true;
+    private int _maxRecordsPerFill = 1;
 
     public SslConnectionFactory()
     {
@@ -84,6 +85,24 @@ public class SslConnectionFactory extends AbstractConnectionFactory implements C
         return _directBuffersForEncryption;
     }
 
+    /**
+     * @return the max number of TLS records that may be unwrapped by a single fill
+     * @see SslConnection#getMaxRecordsPerFill()
+     */
+    public int getMaxRecordsPerFill()
+    {
+        return _maxRecordsPerFill;
+    }
+
+    /**
+     * @param maxRecordsPerFill the max number of TLS records that may be unwrapped by a single fill
+     * @see SslConnection#setMaxRecordsPerFill(int)
+     */
+    public void setMaxRecordsPerFill(int maxRecordsPerFill)
+    {
+        _maxRecordsPerFill = maxRecordsPerFill;
+    }
+
     public String getNextProtocol()
     {
         return _nextProtocol;
@@ -153,6 +172,7 @@ public class SslConnectionFactory extends AbstractConnectionFactory implements C
         SslConnection sslConnection = newSslConnection(connector, endPoint, engine);
         sslConnection.setRenegotiationAllowed(_sslContextFactory.isRenegotiationAllowed());
         sslConnection.setRenegotiationLimit(_sslContextFactory.getRenegotiationLimit());
+        sslConnection.setMaxRecordsPerFill(getMaxRecordsPerFill());
         configure(sslConnection, connector, endPoint);
 
         ConnectionFactory next = connector.getConnectionFactory(_nextProtocol);
@@ -25,6 +25,7 @@ import java.util.Set;
 import java.util.concurrent.ConcurrentHashMap;
 import java.util.concurrent.ConcurrentMap;
 import java.util.concurrent.Executor;
+import java.util.concurrent.atomic.LongAdder;
 
 import org.eclipse.jetty.http.HttpFields;
 import org.eclipse.jetty.http.HttpHeader;
@@ -45,6 +46,7 @@ import org.eclipse.jetty.server.HttpStream;
 import org.eclipse.jetty.server.Request;
 import org.eclipse.jetty.server.Response;
 import org.eclipse.jetty.server.TunnelSupport;
+import org.eclipse.jetty.util.BufferUtil;
 import org.eclipse.jetty.util.Callback;
 import org.eclipse.jetty.util.HostPort;
 import org.eclipse.jetty.util.IteratingCallback;
@@ -663,6 +665,8 @@ public class ConnectHandler extends Handler.Wrapper
         private final IteratingCallback pipe = new ProxyIteratingCallback();
         private final ByteBufferPool bufferPool;
         private final ConcurrentMap<String, Object> context;
+        private final LongAdder bytesIn = new LongAdder();
+        private final LongAdder bytesOut = new LongAdder();
         private TunnelConnection connection;
 
         protected TunnelConnection(EndPoint endPoint, Executor executor, ByteBufferPool bufferPool, ConcurrentMap<String, Object> context)
@@ -698,6 +702,18 @@ public class ConnectHandler extends Handler.Wrapper
             pipe.iterate();
         }
 
+        @Override
+        public long getBytesIn()
+        {
+            return bytesIn.sum();
+        }
+
+        @Override
+        public long getBytesOut()
+        {
+            return bytesOut.sum();
+        }
+
         protected abstract int read(EndPoint endPoint, ByteBuffer buffer) throws IOException;
 
         protected abstract void write(EndPoint endPoint, ByteBuffer buffer, Callback callback);
@@ -718,6 +734,15 @@ public class ConnectHandler extends Handler.Wrapper
                 endPoint.getRemoteSocketAddress());
         }
 
+        /**
+         * <p>Relays the bytes read from this connection's endpoint to the other connection's endpoint.</p>
+         * <p>The same pooled buffer is filled and then written as is for as long as bytes are
+         * flowing, so a busy tunnel acquires a single buffer per direction rather than one per
+         * read; the buffer is only returned to the pool when the read side goes idle or the
+         * tunnel is closed, so that idle tunnels do not hold on to memory.
+         * The next read is only attempted once the write has completed, which preserves the
+         * backpressure of the slower side.</p>
+         */
         private class ProxyIteratingCallback extends IteratingCallback
         {
             private RetainableByteBuffer buffer;
@@ -726,25 +751,28 @@ public class ConnectHandler extends Handler.Wrapper
             @Override
             protected Action process()
             {
-                buffer = bufferPool.acquire(getInputBufferSize(), true);
+                if (buffer == null)
+                    buffer = bufferPool.acquire(getInputBufferSize(), true);
                 try
                 {
                     ByteBuffer byteBuffer = buffer.getByteBuffer();
+                    BufferUtil.clear(byteBuffer);
                     int filled = this.filled = read(getEndPoint(), byteBuffer);
                     if (filled > 0)
                     {
+                        bytesIn.add(filled);
                         write(connection.getEndPoint(), byteBuffer, this);
                         return Action.SCHEDULED;
                     }
                     else if (filled == 0)
                     {
-                        buffer.release();
+                        release();
                         fillInterested();
                         return Action.IDLE;
                     }
                     else
                     {
-                        buffer.release();
+                        release();
                         connection.getEndPoint().shutdownOutput();
                         return Action.SUCCEEDED;
                     }
@@ -753,7 +781,7 @@ public class ConnectHandler extends Handler.Wrapper
                 {
                     if (LOG.isDebugEnabled())
                         LOG.debug("Could not fill {}", TunnelConnection.this, x);
-                    buffer.release();
+                    release();
                     disconnect(x);
                     return Action.SUCCEEDED;
                 }
@@ -764,7 +792,7 @@ public class ConnectHandler extends Handler.Wrapper
             {
                 if (LOG.isDebugEnabled())
                     LOG.debug("Wrote {} bytes {}", filled, TunnelConnection.this);
-                buffer.release();
+                connection.bytesOut.add(filled);
                 super.succeeded();
             }
 
@@ -778,10 +806,19 @@ public class ConnectHandler extends Handler.Wrapper
             {
                 if (LOG.isDebugEnabled())
                     LOG.debug("Failed to write {} bytes {}", filled, TunnelConnection.this, x);
-                buffer.release();
+                release();
                 disconnect(x);
             }
 
+            private void release()
+            {
+                if (buffer != null)
+                {
+                    buffer.release();
+                    buffer = null;
+                }
+            }
+
             private void disconnect(Throwable x)
             {
                 TunnelConnection.this.close(x);
@@ -30,6 +30,13 @@ public class ContextResponse extends Response.Wrapper
         _context = context;
     }
 
+    @Override
+    public boolean isContentPassThrough()
+    {
+        // Only the callbacks are scoped, the content is not modified.
+        return true;
+    }
+
     @Override
     public void write(boolean last, ByteBuffer content, Callback callback)
     {
@@ -14,16 +14,17 @@
 package org.eclipse.jetty.server.handler;
 
 import java.time.Duration;
-import java.util.Comparator;
+import java.util.Arrays;
 import java.util.Iterator;
-import java.util.Map;
+import java.util.List;
 import java.util.Queue;
-import java.util.Set;
-import java.util.concurrent.ConcurrentHashMap;
 import java.util.concurrent.ConcurrentLinkedQueue;
-import java.util.concurrent.ConcurrentSkipListSet;
+import java.util.concurrent.TimeUnit;
 import java.util.concurrent.TimeoutException;
+import java.util.concurrent.atomic.AtomicBoolean;
 import java.util.concurrent.atomic.AtomicInteger;
+import java.util.concurrent.atomic.AtomicLong;
+import java.util.concurrent.atomic.LongAdder;
 
 import org.eclipse.jetty.http.HttpStatus;
 import org.eclipse.jetty.io.CyclicTimeouts;
@@ -35,6 +36,8 @@ import org.eclipse.jetty.util.NanoTime;
 import org.eclipse.jetty.util.ProcessorUtils;
 import org.eclipse.jetty.util.annotation.ManagedAttribute;
 import org.eclipse.jetty.util.annotation.ManagedObject;
+import org.eclipse.jetty.util.annotation.ManagedOperation;
+import org.eclipse.jetty.util.statistic.HistogramStatistic;
 import org.eclipse.jetty.util.thread.Scheduler;
 import org.eclipse.jetty.util.thread.ThreadPool;
 import org.slf4j.Logger;
@@ -67,6 +70,23 @@ import org.slf4j.LoggerFactory;
  * priority, followed by requests performed by admin users, etc.
  * so that regardless of the load, "ping" and "admin" requests will
  * always be able to access the web application.</p>
+ * <p>Priorities are clamped to the range {@code 0-}{@link #getMaxPriority()},
+ * by default {@code 0-10}, and each priority level has its own lock-free queue;
+ * applications that use higher priorities must {@link #setMaxPriority(int) raise the max priority},
+ * otherwise the requests with those priorities are resumed in the order they were suspended.
+ * By default, the highest priority queue is always resumed first; with
+ * {@link #setWeightedFair(boolean) weighted fair} resumption, priority levels
+ * are instead resumed in proportion to their {@link #getWeight(int) weight},
+ * so that low priority requests are not starved under sustained load.</p>
+ * <p>In addition to the static {@link #setMaxSuspend(Duration) max suspend time},
+ * suspended requests may be failed adaptively with a CoDel algorithm: if the
+ * time requests of a priority level stay suspended remains above
+ * {@link #setTargetSuspend(Duration) the target} for at least
+ * {@link #setTargetSuspendInterval(Duration) an interval}, requests resumed
+ * from that level are failed at an increasing rate, until the time
+ * requests stay suspended falls below the target again.</p>
+ * <p>The time requests stay suspended is recorded per priority level,
+ * see {@link #getSuspendStatistic(int)}.</p>
  */
 @ManagedObject
 public class QoSHandler extends ConditionalHandler.Abstract
@@ -75,11 +95,19 @@ public class QoSHandler extends ConditionalHandler.Abstract
     private static final String EXPIRED_ATTRIBUTE_NAME = QoSHandler.class.getName() + ".expired";
 
     private final AtomicInteger state = new AtomicInteger();
-    private final Map<Integer, Queue<Entry>> queues = new ConcurrentHashMap<>();
-    private final Set<Integer> priorities = new ConcurrentSkipListSet<>(Comparator.reverseOrder());
+    private final AtomicLong turns = new AtomicLong();
+    private final LongAdder expired = new LongAdder();
+    private final LongAdder dropped = new LongAdder();
+    private final AtomicBoolean clampWarned = new AtomicBoolean();
+    private Level[] levels = new Level[0];
+    private int[] schedule = new int[0];
     private CyclicTimeouts<Entry> timeouts;
     private int maxRequests;
+    private int maxPriority = 10;
+    private boolean weightedFair;
     private Duration maxSuspend = Duration.ZERO;
+    private Duration targetSuspend = Duration.ZERO;
+    private Duration targetSuspendInterval = Duration.ofMillis(100);
 
     public QoSHandler()
     {
@@ -140,6 +168,112 @@ public class QoSHandler extends ConditionalHandler.Abstract
         this.maxSuspend = maxSuspend;
     }
 
+    /**
+     * @return the max priority, higher priorities are clamped to this value
+     */
+    @ManagedAttribute(value = "The maximum priority", readonly = true)
+    public int getMaxPriority()
+    {
+        return maxPriority;
+    }
+
+    /**
+     * <p>Sets the max priority, by default {@code 10}.</p>
+     * <p>Priorities returned by {@link #getPriority(Request)} that are
+     * greater than the max priority are clamped to the max priority,
+     * so that the requests with those priorities are not resumed in
+     * priority order among themselves; a warning is logged the first
+     * time a priority is clamped.</p>
+     *
+     * @param maxPriority the max priority
+     */
+    public void setMaxPriority(int maxPriority)
+    {
+        if (isStarted())
+            throw new IllegalStateException("Cannot change maxPriority: " + this);
+        if (maxPriority < 0)
+            throw new IllegalArgumentException("Invalid maxPriority " + maxPriority);
+        this.maxPriority = maxPriority;
+    }
+
+    /**
+     * @return whether suspended requests are resumed in proportion to the
+     * weight of their priority, rather than strictly by highest priority
+     */
+    @ManagedAttribute("Whether suspended requests are resumed weighted fair rather than by strict priority")
+    public boolean isWeightedFair()
+    {
+        return weightedFair;
+    }
+
+    /**
+     * <p>Sets whether suspended requests are resumed in proportion to the
+     * {@link #getWeight(int) weight} of their priority.</p>
+     * <p>When {@code false}, the default, the suspended request with the
+     * highest priority is always resumed first.</p>
+     *
+     * @param weightedFair whether to resume suspended requests weighted fair
+     */
+    public void setWeightedFair(boolean weightedFair)
+    {
+        this.weightedFair = weightedFair;
+    }
+
+    /**
+     * @return the target time requests stay suspended
+     * @see #setTargetSuspend(Duration)
+     */
+    public Duration getTargetSuspend()
+    {
+        return targetSuspend;
+    }
+
+    /**
+     * <p>Sets the target time requests stay suspended.</p>
+     * <p>When the time requests of a priority level stay suspended
+     * remains above the target for at least the
+     * {@link #setTargetSuspendInterval(Duration) interval}, the
+     * requests resumed from that level are failed with an HTTP status
+     * of {@code 503 Service Unavailable} at an increasing rate.</p>
+     * <p>{@link Duration#ZERO}, the default, disables the adaptive failure
+     * of suspended requests.</p>
+     *
+     * @param targetSuspend the target time requests stay suspended
+     */
+    public void setTargetSuspend(Duration targetSuspend)
+    {
+        if (isStarted())
+            throw new IllegalStateException("Cannot change targetSuspend: " + this);
+        if (targetSuspend.isNegative())
+            throw new IllegalArgumentException("Invalid targetSuspend duration");
+        this.targetSuspend = targetSuspend;
+    }
+
+    /**
+     * @return the interval the target suspend time must be
+     * exceeded before suspended requests are failed
+     * @see #setTargetSuspend(Duration)
+     */
+    public Duration getTargetSuspendInterval()
+    {
+        return targetSuspendInterval;
+    }
+
+    /**
+     * @param targetSuspendInterval the interval the target suspend time must be
+     * exceeded before suspended requests are failed, typically in the order of
+     * the processing time of a request
+     * @see #setTargetSuspend(Duration)
+     */
+    public void setTargetSuspendInterval(Duration targetSuspendInterval)
+    {
+        if (isStarted())
+            throw new IllegalStateException("Cannot change targetSuspendInterval: " + this);
+        if (targetSuspendInterval.isNegative() || targetSuspendInterval.isZero())
+            throw new IllegalArgumentException("Invalid targetSuspendInterval duration");
+        this.targetSuspendInterval = targetSuspendInterval;
+    }
+
     @ManagedAttribute("The number of suspended requests")
     public long getSuspendedRequestCount()
     {
@@ -147,6 +281,53 @@ public class QoSHandler extends ConditionalHandler.Abstract
         return Math.max(0, -permits);
     }
 
+    @ManagedAttribute("The number of suspended requests that expired the max suspend time")
+    public long getExpiredRequestCount()
+    {
+        return expired.sum();
+    }
+
+    @ManagedAttribute("The number of suspended requests failed because the target suspend time was exceeded")
+    public long getDroppedRequestCount()
+    {
+        return dropped.sum();
+    }
+
+    /**
+     * <p>Returns the statistic of the time, in nanoseconds, that the
+     * requests of the given priority stayed suspended before being resumed.</p>
+     *
+     * @param priority the priority
+     * @return the suspend time statistic of the given priority,
+     * or {@code null} if this handler is not started
+     */
+    public HistogramStatistic getSuspendStatistic(int priority)
+    {
+        Level[] levels = this.levels;
+        if (levels.length == 0)
+            return null;
+        return levels[clamp(priority, levels.length - 1)].statistic;
+    }
+
+    @ManagedAttribute("The suspend time statistics per priority")
+    public List<String> getSuspendStatistics()
+    {
+        return Arrays.stream(levels)
+            .map(Level::toString)
+            .toList();
+    }
+
+    @ManagedOperation(value = "Resets the statistics", impact = "ACTION")
+    public void resetStatistics()
+    {
+        expired.reset();
+        dropped.reset();
+        for (Level level : levels)
+        {
+            level.statistic.reset();
+        }
+    }
+
     @Override
     protected void doStart() throws Exception
     {
@@ -165,8 +346,17 @@ public class QoSHandler extends ConditionalHandler.Abstract
         }
         state.set(maxRequests);
 
+        int maxPriority = getMaxPriority();
+        Level[] levels = new Level[maxPriority + 1];
+        for (int priority = 0; priority < levels.length; ++priority)
+        {
+            levels[priority] = new Level(priority);
+        }
+        this.levels = levels;
+        schedule = newSchedule(levels);
+
         if (LOG.isDebugEnabled())
-            LOG.debug("{} initialized maxRequests={}", this, maxRequests);
+            LOG.debug("{} initialized maxRequests={} maxPriority={}", this, maxRequests, maxPriority);
 
         super.doStart();
     }
@@ -177,6 +367,31 @@ public class QoSHandler extends ConditionalHandler.Abstract
         super.doStop();
         removeBean(timeouts);
         timeouts.destroy();
+        // Keep the levels, so that late resumes or suspends find them.
+        for (Level level : levels)
+        {
+            failAllSuspended(level);
+        }
+    }
+
+    private void failAllSuspended(Level level)
+    {
+        while (true)
+        {
+            Entry entry = level.queue.poll();
+            if (entry == null)
+                return;
+            failStopped(entry);
+        }
+    }
+
+    private void failStopped(Entry entry)
+    {
+        state.getAndIncrement();
+        if (LOG.isDebugEnabled())
+            LOG.debug("{} stopped, failing {}", this, entry.request);
+        entry.request.setAttribute(EXPIRED_ATTRIBUTE_NAME, true);
+        failSuspended(entry.request, entry.response, entry.callback, HttpStatus.SERVICE_UNAVAILABLE_503, null);
     }
 
     @Override
@@ -232,7 +447,8 @@ public class QoSHandler extends ConditionalHandler.Abstract
      * a value greater than or equal to {@code 0}.</p>
      * <p>Priority {@code 0} is the lowest priority.</p>
      * <p>The set of returned priorities should be stable over
-     * time, typically constrained in the range {@code 0-10}.</p>
+     * time, typically constrained in the range {@code 0-10};
+     * priorities greater than {@link #getMaxPriority()} are clamped.</p>
      *
      * @param request the suspended request to compute the priority for
      * @return the priority of the given suspended request, a value {@code >= 0}
@@ -242,6 +458,22 @@ public class QoSHandler extends ConditionalHandler.Abstract
         return 0;
     }
 
+    /**
+     * <p>Returns the weight of the given priority, used when
+     * {@link #setWeightedFair(boolean) weighted fair} resumption is enabled.</p>
+     * <p>A priority level with twice the weight of another is resumed twice as often,
+     * when both have suspended requests.
+     * The default weight is {@code priority + 1}.</p>
+     * <p>This method is called only when this handler is started.</p>
+     *
+     * @param priority the priority, between {@code 0} and {@link #getMaxPriority()}
+     * @return the weight of the given priority, a value {@code >= 1}
+     */
+    protected int getWeight(int priority)
+    {
+        return priority + 1;
+    }
+
     /**
      * <p>Fails the given suspended request/response with the given error code and failure.</p>
      * <p>This method is called only for suspended requests, in case of timeout while suspended,
@@ -268,21 +500,66 @@ public class QoSHandler extends ConditionalHandler.Abstract
 
     private void suspend(Request request, Response response, Callback callback)
     {
-        int priority = Math.max(0, getPriority(request));
+        Level[] levels = this.levels;
+        if (!isStarted() || levels.length == 0)
+        {
+            // Like a suspend immediately followed by an expiration.
+            state.getAndIncrement();
+            notAvailable(response, callback);
+            return;
+        }
+        int requestPriority = getPriority(request);
+        int priority = clamp(requestPriority, levels.length - 1);
+        if (requestPriority > priority && clampWarned.compareAndSet(false, true))
+            LOG.warn("Priority {} clamped to maxPriority {} in {}", requestPriority, priority, this);
         if (LOG.isDebugEnabled())
             LOG.debug("{} suspending priority={} {}", this, priority, request);
-        Entry entry = new Entry(request, response, callback, priority);
-        queues.compute(priority, (k, v) ->
+        Entry entry = new Entry(request, response, callback, levels[priority]);
+        entry.level.queue.offer(entry);
+        // The handler may have been stopped concurrently, after the suspended requests were failed.
+        if (!isStarted())
         {
-            if (v == null)
+            if (entry.level.queue.remove(entry))
+                failStopped(entry);
+            return;
+        }
+        timeouts.schedule(entry);
+    }
+
+    private static int clamp(int priority, int maxPriority)
+    {
+        return Math.min(Math.max(0, priority), maxPriority);
+    }
+
+    /**
+     * <p>Computes the order in which priority levels are visited first
+     * for weighted fair resumption, using the smooth weighted round-robin
+     * algorithm, so that levels are interleaved rather than visited in bursts.</p>
+     */
+    private int[] newSchedule(Level[] levels)
+    {
+        int[] weights = new int[levels.length];
+        int total = 0;
+        for (int priority = 0; priority < levels.length; ++priority)
+        {
+            weights[priority] = Math.max(1, getWeight(priority));
+            total += weights[priority];
+        }
+        int[] current = new int[levels.length];
+        int[] schedule = new int[total];
+        for (int turn = 0; turn < total; ++turn)
+        {
+            int selected = 0;
+            for (int priority = 0; priority < levels.length; ++priority)
             {
-                priorities.add(priority);
-                v = new ConcurrentLinkedQueue<>();
+                current[priority] += weights[priority];
+                if (current[priority] > current[selected])
+                    selected = priority;
             }
-            v.offer(entry);
-            return v;
-        });
-        timeouts.schedule(entry);
+            current[selected] -= total;
+            schedule[turn] = selected;
+        }
+        return schedule;
     }
 
     private void resume(Throwable x)
@@ -298,34 +575,66 @@ public class QoSHandler extends ConditionalHandler.Abstract
 
         while (true)
         {
-            if (resumeSuspended())
+            Entry entry = pollSuspended();
+            if (entry == null)
+            {
+                // The suspended requests have been failed by doStop().
+                if (!isStarted())
+                    return;
+                // Found no suspended requests yet, but there will be.
+                // This covers the small race window in handle(), where
+                // the state is updated and then the request suspended.
+                Thread.onSpinWait();
+                continue;
+            }
+
+            long now = NanoTime.now();
+            long suspendNanos = NanoTime.elapsed(entry.suspendNanoTime, now);
+            entry.level.statistic.record(suspendNanos);
+            if (!entry.level.codel.shouldDrop(suspendNanos, now, entry.level.queue.isEmpty()))
+            {
+                if (LOG.isDebugEnabled())
+                    LOG.debug("{} resuming {}", this, entry.request);
+                // Always dispatch to avoid StackOverflowError.
+                getServer().getThreadPool().execute(entry);
                 return;
+            }
+
+            // The request was suspended for too long, fail it.
+            // Failing it is like an expiration: the permit is
+            // available again, possibly for another suspended request.
+            dropped.increment();
+            if (LOG.isDebugEnabled())
+                LOG.debug("{} dropping after {} ms {}", this, TimeUnit.NANOSECONDS.toMillis(suspendNanos), entry.request);
+            entry.request.setAttribute(EXPIRED_ATTRIBUTE_NAME, true);
+            getServer().getThreadPool().execute(() ->
+                failSuspended(entry.request, entry.response, entry.callback, HttpStatus.SERVICE_UNAVAILABLE_503, new TimeoutException()));
 
-            // Found no suspended requests yet, but there will be.
-            // This covers the small race window in handle(), where
-            // the state is updated and then the request suspended.
-            Thread.onSpinWait();
+            permits = state.getAndIncrement();
+            if (permits >= 0)
+                return;
         }
     }
 
-    private boolean resumeSuspended()
+    private Entry pollSuspended()
     {
-        for (Integer priority : priorities)
+        Level[] levels = this.levels;
+        if (weightedFair)
         {
-            Queue<Entry> queue = queues.get(priority);
-            if (queue == null)
-                return false;
-            Entry entry = queue.poll();
+            // Start from the level scheduled for this turn.
+            int[] schedule = this.schedule;
+            int priority = schedule[(int)(turns.getAndIncrement() % schedule.length)];
+            Entry entry = levels[priority].queue.poll();
             if (entry != null)
-            {
-                if (LOG.isDebugEnabled())
-                    LOG.debug("{} resuming {}", this, entry.request);
-                // Always dispatch to avoid StackOverflowError.
-                getServer().getThreadPool().execute(entry);
-                return true;
-            }
+                return entry;
         }
-        return false;
+        for (int priority = levels.length - 1; priority >= 0; --priority)
+        {
+            Entry entry = levels[priority].queue.poll();
+            if (entry != null)
+                return entry;
+        }
+        return null;
     }
 
     private class Entry implements CyclicTimeouts.Expirable, Runnable
@@ -333,17 +642,19 @@ public class QoSHandler extends ConditionalHandler.Abstract
         private final Request request;
         private final Response response;
         private final Callback callback;
-        private final int priority;
+        private final Level level;
+        private final long suspendNanoTime;
         private final long expireNanoTime;
 
-        private Entry(Request request, Response response, Callback callback, int priority)
+        private Entry(Request request, Response response, Callback callback, Level level)
         {
             this.request = request;
             this.response = response;
             this.callback = callback;
-            this.priority = priority;
+            this.level = level;
+            this.suspendNanoTime = NanoTime.now();
             Duration maxSuspend = getMaxSuspend();
-            long suspendNanos = NanoTime.now() + maxSuspend.toNanos();
+            long suspendNanos = suspendNanoTime + maxSuspend.toNanos();
             if (suspendNanos == Long.MAX_VALUE)
                 --suspendNanos;
             this.expireNanoTime = maxSuspend.isZero() ? Long.MAX_VALUE : suspendNanos;
@@ -358,11 +669,12 @@ public class QoSHandler extends ConditionalHandler.Abstract
         private void expire()
         {
             // The request timed out, therefore it never acquired a permit.
-            boolean removed = queues.get(priority).remove(this);
+            boolean removed = level.queue.remove(this);
             if (removed)
             {
                 // See correspondent state machine logic in handle() and resume().
                 state.getAndIncrement();
+                expired.increment();
                 if (LOG.isDebugEnabled())
                     LOG.debug("{} timeout {}", QoSHandler.this, request);
                 request.setAttribute(EXPIRED_ATTRIBUTE_NAME, true);
@@ -401,8 +713,8 @@ public class QoSHandler extends ConditionalHandler.Abstract
         protected Iterator<Entry> iterator()
         {
             // Use Java streams as this is called infrequently.
-            return queues.values().stream()
-                .flatMap(Queue::stream)
+            return Arrays.stream(levels)
+                .flatMap(level -> level.queue.stream())
                 .iterator();
         }
 
@@ -413,4 +725,96 @@ public class QoSHandler extends ConditionalHandler.Abstract
             return false;
         }
     }
+
+    private class Level
+    {
+        private final Queue<Entry> queue = new ConcurrentLinkedQueue<>();
+        private final HistogramStatistic statistic = new HistogramStatistic();
+        private final CoDel codel = new CoDel(getTargetSuspend().toNanos(), getTargetSuspendInterval().toNanos());
+        private final int priority;
+
+        private Level(int priority)
+        {
+            this.priority = priority;
+        }
+
+        @Override
+        public String toString()
+        {
+            return String.format("%s@%x[priority=%d,suspended=%d,%s]",
+                getClass().getSimpleName(), hashCode(), priority, queue.size(), statistic);
+        }
+    }
+
+    /**
+     * <p>The CoDel (controlled delay) algorithm, see RFC 8289.</p>
+     * <p>The fields are updated by concurrent resuming threads without
+     * locking; a lost update only makes the drop rate slightly imprecise.</p>
+     */
+    private static class CoDel
+    {
+        private final long target;
+        private final long interval;
+        private volatile long firstAboveTime;
+        private volatile long dropNext;
+        private volatile int count;
+        private volatile boolean dropping;
+
+        private CoDel(long target, long interval)
+        {
+            this.target = target;
+            this.interval = interval;
+        }
+
+        private boolean shouldDrop(long suspendNanos, long now, boolean empty)
+        {
+            if (target == 0)
+                return false;
+
+            if (suspendNanos < target || empty)
+            {
+                // Below the target, or the last suspended request, stop dropping.
+                firstAboveTime = 0;
+                dropping = false;
+                return false;
+            }
+
+            long firstAboveTime = this.firstAboveTime;
+            if (firstAboveTime == 0)
+            {
+                this.firstAboveTime = orNonZero(now + interval);
+                return false;
+            }
+            if (NanoTime.isBefore(now, firstAboveTime))
+                return false;
+
+            // Above the target for at least an interval.
+            if (!dropping)
+            {
+                dropping = true;
+                // Restart from a drop rate close to the previous one, if it was recent.
+                int count = this.count;
+                this.count = count > 2 && NanoTime.elapsed(dropNext, now) < 16 * interval ? count - 2 : 1;
+                dropNext = orNonZero(now + controlLaw());
+                return true;
+            }
+            if (NanoTime.isBeforeOrSame(dropNext, now))
+            {
+                ++count;
+                dropNext = orNonZero(now + controlLaw());
+                return true;
+            }
+            return false;
+        }
+
+        private long controlLaw()
+        {
+            return (long)(interval / Math.sqrt(count));
+        }
+
+        private static long orNonZero(long nanoTime)
+        {
+            return nanoTime == 0 ? 1 : nanoTime;
+        }
+    }
 }
@@ -101,7 +101,10 @@ public class ResourceHandler extends Handler.Wrapper
 
         _byteBufferPool = getByteBufferPool(context);
         ResourceService resourceService = getResourceService();
-        resourceService.setHttpContentFactory(newHttpContentFactory());
+        HttpContent.Factory contentFactory = newHttpContentFactory();
+        // Make the factory, and so its cache statistics, visible to JMX.
+        updateBean(resourceService.getHttpContentFactory(), contentFactory);
+        resourceService.setHttpContentFactory(contentFactory);
         resourceService.setWelcomeFactory(setupWelcomeFactory());
         if (getStyleSheet() == null)
             setStyleSheet(getServer().getDefaultStyleSheet());
@@ -230,6 +233,14 @@ public class ResourceHandler extends Handler.Wrapper
         return _resourceService.isAcceptRanges();
     }
 
+    /**
+     * @return If true, file content that is not cached in memory is written directly from the file to the connection
+     */
+    public boolean isFileTransfer()
+    {
+        return _resourceService.isFileTransfer();
+    }
+
     /**
      * @return If true, directory listings are returned if no welcome file is found. Else 403 Forbidden.
      */
@@ -272,6 +283,14 @@ public class ResourceHandler extends Handler.Wrapper
         _resourceService.setAcceptRanges(acceptRanges);
     }
 
+    /**
+     * @param fileTransfer If true, file content that is not cached in memory is written directly from the file to the connection
+     */
+    public void setFileTransfer(boolean fileTransfer)
+    {
+        _resourceService.setFileTransfer(fileTransfer);
+    }
+
     /**
      * @param base The resourceBase to server content from. If null the
      * context resource base is used.
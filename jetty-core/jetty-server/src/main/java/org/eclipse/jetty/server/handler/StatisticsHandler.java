@@ -31,14 +31,17 @@ import org.eclipse.jetty.util.annotation.ManagedAttribute;
 import org.eclipse.jetty.util.annotation.ManagedOperation;
 import org.eclipse.jetty.util.component.Dumpable;
 import org.eclipse.jetty.util.statistic.CounterStatistic;
-import org.eclipse.jetty.util.statistic.SampleStatistic;
+import org.eclipse.jetty.util.statistic.HistogramStatistic;
 
 public class StatisticsHandler extends EventsHandler
 {
     private final CounterStatistic _requestStats = new CounterStatistic(); // how many requests are being handled (full lifecycle)
-    private final SampleStatistic _requestTimeStats = new SampleStatistic(); // latencies of requests (full lifecycle)
+    private final HistogramStatistic _requestTimeStats = new HistogramStatistic(); // latencies of requests (full lifecycle)
     private final CounterStatistic _handleStats = new CounterStatistic(); // how many requests are in handle()
-    private final SampleStatistic _handleTimeStats = new SampleStatistic(); // latencies of requests in handle()
+    private final HistogramStatistic _handleTimeStats = new HistogramStatistic(); // latencies of requests in handle()
+    private final HistogramStatistic _requestSizeStats = new HistogramStatistic(); // bytes read per request
+    private final HistogramStatistic _responseSizeStats = new HistogramStatistic(); // bytes written per response
+    private final String _sizesAttribute = StatisticsHandler.class.getName() + ".sizes@" + Integer.toHexString(hashCode());
     private final LongAdder _failures = new LongAdder();
     private final LongAdder _handlingFailures = new LongAdder();
     private final LongAdder _responses1xx = new LongAdder();
@@ -69,6 +72,7 @@ public class StatisticsHandler extends EventsHandler
     @Override
     protected void onBeforeHandling(Request request)
     {
+        request.setAttribute(_sizesAttribute, new Sizes());
         _requestStats.increment();
         _handleStats.increment();
     }
@@ -86,7 +90,12 @@ public class StatisticsHandler extends EventsHandler
     protected void onRequestRead(Request request, Content.Chunk chunk)
     {
         if (chunk != null)
-            _bytesRead.add(chunk.remaining());
+        {
+            int length = chunk.remaining();
+            _bytesRead.add(length);
+            if (request.getAttribute(_sizesAttribute) instanceof Sizes sizes)
+                sizes.read += length;
+        }
     }
 
     @Override
@@ -94,7 +103,11 @@ public class StatisticsHandler extends EventsHandler
     {
         int length = BufferUtil.length(content);
         if (length > 0)
+        {
             _bytesWritten.add(length);
+            if (request.getAttribute(_sizesAttribute) instanceof Sizes sizes)
+                sizes.written += length;
+        }
     }
 
     @Override
@@ -103,6 +116,11 @@ public class StatisticsHandler extends EventsHandler
         if (failure != null)
             _failures.increment();
         _requestTimeStats.record(NanoTime.since(request.getBeginNanoTime()));
+        if (request.getAttribute(_sizesAttribute) instanceof Sizes sizes)
+        {
+            _requestSizeStats.record(sizes.read);
+            _responseSizeStats.record(sizes.written);
+        }
         _requestStats.decrement();
         switch (status / 100)
         {
@@ -122,6 +140,8 @@ public class StatisticsHandler extends EventsHandler
             Dumpable.named("requestTimeStats", _requestTimeStats),
             Dumpable.named("handleStats", _handleStats),
             Dumpable.named("handleTimeStats", _handleTimeStats),
+            Dumpable.named("requestSizeStats", _requestSizeStats),
+            Dumpable.named("responseSizeStats", _responseSizeStats),
             Dumpable.named("failures", _failures),
             Dumpable.named("handlingFailures", _handlingFailures),
             Dumpable.named("1xxResponses", _responses1xx),
@@ -142,6 +162,8 @@ public class StatisticsHandler extends EventsHandler
         _requestTimeStats.reset();
         _handleStats.reset();
         _handleTimeStats.reset();
+        _requestSizeStats.reset();
+        _responseSizeStats.reset();
         _failures.reset();
         _handlingFailures.reset();
         _responses1xx.reset();
@@ -205,6 +227,32 @@ public class StatisticsHandler extends EventsHandler
         return _requestTimeStats.getStdDev();
     }
 
+    @ManagedAttribute("median request execution time (in ns)")
+    public long getRequestTimeP50()
+    {
+        return _requestTimeStats.getValueAtPercentile(50);
+    }
+
+    @ManagedAttribute("99th percentile request execution time (in ns)")
+    public long getRequestTimeP99()
+    {
+        return _requestTimeStats.getValueAtPercentile(99);
+    }
+
+    @ManagedAttribute("99.9th percentile request execution time (in ns)")
+    public long getRequestTimeP999()
+    {
+        return _requestTimeStats.getValueAtPercentile(99.9);
+    }
+
+    /**
+     * @return the statistic of the request execution time (in ns), for percentiles and interval snapshots
+     */
+    public HistogramStatistic getRequestTimeStatistic()
+    {
+        return _requestTimeStats;
+    }
+
     @ManagedAttribute("total number of calls to handle()")
     public int getHandleTotal()
     {
@@ -247,6 +295,20 @@ public class StatisticsHandler extends EventsHandler
         return _handleTimeStats.getStdDev();
     }
 
+    @ManagedAttribute("99th percentile handle() execution time (in ns)")
+    public long getHandleTimeP99()
+    {
+        return _handleTimeStats.getValueAtPercentile(99);
+    }
+
+    /**
+     * @return the statistic of the handle() execution time (in ns), for percentiles and interval snapshots
+     */
+    public HistogramStatistic getHandleTimeStatistic()
+    {
+        return _handleTimeStats;
+    }
+
     @ManagedAttribute("number of failed requests")
     public int getFailures()
     {
@@ -301,12 +363,76 @@ public class StatisticsHandler extends EventsHandler
         return _bytesWritten.longValue();
     }
 
+    @ManagedAttribute("mean request content size (in bytes)")
+    public double getRequestSizeMean()
+    {
+        return _requestSizeStats.getMean();
+    }
+
+    @ManagedAttribute("99th percentile request content size (in bytes)")
+    public long getRequestSizeP99()
+    {
+        return _requestSizeStats.getValueAtPercentile(99);
+    }
+
+    @ManagedAttribute("maximum request content size (in bytes)")
+    public long getRequestSizeMax()
+    {
+        return _requestSizeStats.getMax();
+    }
+
+    /**
+     * @return the statistic of the request content size (in bytes)
+     */
+    public HistogramStatistic getRequestSizeStatistic()
+    {
+        return _requestSizeStats;
+    }
+
+    @ManagedAttribute("mean response content size (in bytes)")
+    public double getResponseSizeMean()
+    {
+        return _responseSizeStats.getMean();
+    }
+
+    @ManagedAttribute("99th percentile response content size (in bytes)")
+    public long getResponseSizeP99()
+    {
+        return _responseSizeStats.getValueAtPercentile(99);
+    }
+
+    @ManagedAttribute("maximum response content size (in bytes)")
+    public long getResponseSizeMax()
+    {
+        return _responseSizeStats.getMax();
+    }
+
+    /**
+     * @return the statistic of the response content size (in bytes)
+     */
+    public HistogramStatistic getResponseSizeStatistic()
+    {
+        return _responseSizeStats;
+    }
+
     @ManagedAttribute("duration for which statistics have been collected")
     public Duration getStatisticsDuration()
     {
         return Duration.ofNanos(NanoTime.since(_startTime));
     }
 
+    /**
+     * <p>The content sizes of a request and its response.</p>
+     * <p>The fields are plain because reads are serialized by the {@link Content.Source}
+     * contract, writes are serialized by the {@link Response} contract, and the completion
+     * of the request happens after both.</p>
+     */
+    private static class Sizes
+    {
+        private long read;
+        private long written;
+    }
+
     /**
      * Checks that the wrapped handler can read/write at a minimal rate of N bytes per second.
      * When reading or writing does not conform to the specified rates, this handler prevents
@@ -14,11 +14,27 @@
 package org.eclipse.jetty.server.handler.gzip;
 
 import org.eclipse.jetty.server.Request;
+import org.eclipse.jetty.util.compression.Compression;
 import org.eclipse.jetty.util.compression.DeflaterPool;
+import org.eclipse.jetty.util.compression.GzipCompression;
 
 public interface GzipFactory
 {
     DeflaterPool.Entry getDeflaterEntry(Request request, long contentLength);
 
+    /**
+     * @param compression the negotiated compression, or null for gzip with {@link #getDeflaterEntry(Request, long)}
+     * @param request the request
+     * @param contentLength the response content length, or -1 if unknown
+     * @return an encoder for the response content, or null if the response must not be compressed
+     */
+    default Compression.Encoder getEncoder(Compression compression, Request request, long contentLength)
+    {
+        if (compression != null)
+            return compression.newEncoder();
+        DeflaterPool.Entry entry = getDeflaterEntry(request, contentLength);
+        return entry == null ? null : GzipCompression.newEncoder(entry);
+    }
+
     boolean isMimeTypeDeflatable(String mimetype);
 }
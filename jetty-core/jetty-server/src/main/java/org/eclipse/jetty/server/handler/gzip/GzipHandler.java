@@ -13,10 +13,13 @@
 
 package org.eclipse.jetty.server.handler.gzip;
 
+import java.util.ArrayList;
+import java.util.List;
 import java.util.ListIterator;
 import java.util.Set;
 import java.util.zip.Deflater;
 
+import org.eclipse.jetty.http.CompressedContentFormat;
 import org.eclipse.jetty.http.EtagUtils;
 import org.eclipse.jetty.http.HttpField;
 import org.eclipse.jetty.http.HttpFields;
@@ -24,6 +27,7 @@ import org.eclipse.jetty.http.HttpHeader;
 import org.eclipse.jetty.http.HttpMethod;
 import org.eclipse.jetty.http.MimeTypes;
 import org.eclipse.jetty.http.PreEncodedHttpField;
+import org.eclipse.jetty.http.QuotedQualityCSV;
 import org.eclipse.jetty.http.pathmap.PathSpecSet;
 import org.eclipse.jetty.server.Handler;
 import org.eclipse.jetty.server.Request;
@@ -33,7 +37,9 @@ import org.eclipse.jetty.util.AsciiLowerCaseSet;
 import org.eclipse.jetty.util.Callback;
 import org.eclipse.jetty.util.IncludeExclude;
 import org.eclipse.jetty.util.StringUtil;
+import org.eclipse.jetty.util.compression.Compression;
 import org.eclipse.jetty.util.compression.DeflaterPool;
+import org.eclipse.jetty.util.compression.GzipCompression;
 import org.eclipse.jetty.util.compression.InflaterPool;
 import org.slf4j.Logger;
 import org.slf4j.LoggerFactory;
@@ -58,6 +64,13 @@ public class GzipHandler extends Handler.Wrapper implements GzipFactory
     private final IncludeExclude<String> _paths = new IncludeExclude<>(PathSpecSet.class);
     private final IncludeExclude<String> _mimeTypes = new IncludeExclude<>(AsciiLowerCaseSet.class);
     private HttpField _vary = new PreEncodedHttpField(HttpHeader.VARY, HttpHeader.ACCEPT_ENCODING.asString());
+    private final List<Compression> _compressions = new ArrayList<>();
+    private boolean _useProvidedCompressions = true;
+    private List<Compression> _providedCompressions;
+    private GzipCompression _gzipCompression;
+    private List<Compression> _negotiable = List.of();
+    private List<String> _encodings = List.of();
+    private List<CompressedContentFormat> _formats = List.of(CompressedContentFormat.GZIP);
 
     /**
      * Instantiates a new GzipHandler.
@@ -115,6 +128,23 @@ public class GzipHandler extends Handler.Wrapper implements GzipFactory
             addBean(_deflaterPool);
         }
 
+        // The built-in gzip shares the pools above, so it needs not be started.
+        _gzipCompression = new GzipCompression(_deflaterPool, _inflaterPool);
+        if (_useProvidedCompressions && _providedCompressions == null)
+        {
+            _providedCompressions = Compression.getProvidedCompressions();
+            _providedCompressions.forEach(this::addBean);
+        }
+
+        // Configured compressions are preferred, then gzip, then the provided ones.
+        List<Compression> negotiable = new ArrayList<>(_compressions);
+        negotiable.add(_gzipCompression);
+        if (_useProvidedCompressions)
+            negotiable.addAll(_providedCompressions);
+        _negotiable = List.copyOf(negotiable);
+        _encodings = _negotiable.stream().map(Compression::getEncoding).distinct().toList();
+        _formats = _encodings.stream().map(GzipHandler::toFormat).toList();
+
         super.doStart();
     }
 
@@ -128,6 +158,73 @@ public class GzipHandler extends Handler.Wrapper implements GzipFactory
 
         removeBean(_deflaterPool);
         _deflaterPool = null;
+
+        _gzipCompression = null;
+    }
+
+    /**
+     * @return the compressions, other than the built-in gzip, that can be negotiated
+     */
+    public List<Compression> getCompressions()
+    {
+        return List.copyOf(_compressions);
+    }
+
+    /**
+     * <p>Sets the compressions, other than the built-in gzip, that can be negotiated
+     * from the {@code Accept-Encoding} request header, in order of server preference.</p>
+     * <p>These compressions are preferred over gzip when the client accepts them with the same quality.</p>
+     *
+     * @param compressions the compressions that can be negotiated
+     */
+    public void setCompressions(List<Compression> compressions)
+    {
+        if (isRunning())
+            throw new IllegalStateException(getState());
+        _compressions.forEach(this::removeBean);
+        _compressions.clear();
+        compressions.forEach(this::addCompression);
+    }
+
+    /**
+     * @param compression a compression that can be negotiated, in order of server preference
+     * @see #setCompressions(List)
+     */
+    public void addCompression(Compression compression)
+    {
+        if (isRunning())
+            throw new IllegalStateException(getState());
+        _compressions.add(compression);
+        addBean(compression);
+    }
+
+    /**
+     * @return whether the compressions provided as {@link java.util.ServiceLoader} services can be negotiated
+     */
+    public boolean isUseProvidedCompressions()
+    {
+        return _useProvidedCompressions;
+    }
+
+    /**
+     * @param useProvidedCompressions whether the compressions provided as {@link java.util.ServiceLoader}
+     * services, such as {@code br} or {@code zstd}, can be negotiated
+     * @see Compression#getProvidedCompressions()
+     */
+    public void setUseProvidedCompressions(boolean useProvidedCompressions)
+    {
+        if (isRunning())
+            throw new IllegalStateException(getState());
+        _useProvidedCompressions = useProvidedCompressions;
+    }
+
+    static CompressedContentFormat toFormat(String encoding)
+    {
+        if (GZIP.equalsIgnoreCase(encoding))
+            return CompressedContentFormat.GZIP;
+        if (CompressedContentFormat.BR.getEncoding().equalsIgnoreCase(encoding))
+            return CompressedContentFormat.BR;
+        return new CompressedContentFormat(encoding, "." + encoding);
     }
 
     /**
@@ -396,6 +493,63 @@ public class GzipHandler extends Handler.Wrapper implements GzipFactory
         return _deflaterPool.acquire();
     }
 
+    @Override
+    public Compression.Encoder getEncoder(Compression compression, Request request, long contentLength)
+    {
+        if (compression == null || compression == _gzipCompression)
+            return GzipFactory.super.getEncoder(null, request, contentLength);
+
+        if (contentLength >= 0 && contentLength < _minGzipSize)
+        {
+            if (LOG.isDebugEnabled())
+                LOG.debug("{} excluded minGzipSize {}", this, request);
+            return null;
+        }
+
+        return compression.newEncoder();
+    }
+
+    /**
+     * @param encoding a content coding name
+     * @return the first negotiable compression for the given content coding, or null
+     */
+    private Compression getCompression(String encoding)
+    {
+        for (Compression compression : _negotiable)
+        {
+            if (compression.getEncoding().equalsIgnoreCase(encoding))
+                return compression;
+        }
+        return null;
+    }
+
+    /**
+     * <p>The {@code *} coding only matches the codings not explicitly listed,
+     * so that a coding excluded with {@code q=0} is never selected.</p>
+     *
+     * @param acceptEncoding the values of the {@code Accept-Encoding} request headers
+     * @return the negotiable compression with the highest quality, or null
+     */
+    private Compression negotiate(AcceptEncoding acceptEncoding)
+    {
+        for (String encoding : acceptEncoding)
+        {
+            if ("*".equals(encoding))
+            {
+                for (Compression compression : _negotiable)
+                {
+                    if (!acceptEncoding.isListed(compression.getEncoding()))
+                        return compression;
+                }
+                continue;
+            }
+            Compression compression = getCompression(encoding);
+            if (compression != null)
+                return compression;
+        }
+        return null;
+    }
+
     /**
      * Get the current filter list of excluded HTTP methods
      *
@@ -550,8 +704,10 @@ public class GzipHandler extends Handler.Wrapper implements GzipFactory
 
         // Look for inflate and deflate headers
         HttpFields fields = request.getHeaders();
-        boolean inflatable = false;
+        boolean negotiate = _negotiable.size() > 1;
+        Compression inflation = null;
         boolean deflatable = false;
+        AcceptEncoding acceptEncoding = null;
         boolean etagMatches = false;
         boolean seenContentEncoding = false;
         for (ListIterator<HttpField> i = fields.listIterator(fields.size()); i.hasPrevious();)
@@ -564,19 +720,42 @@ public class GzipHandler extends Handler.Wrapper implements GzipFactory
             {
                 case CONTENT_ENCODING ->
                 {
-                    inflatable |= !seenContentEncoding && field.containsLast("gzip");
+                    if (!seenContentEncoding)
+                    {
+                        if (!negotiate)
+                            inflation = field.containsLast(GZIP) ? _gzipCompression : null;
+                        else
+                            inflation = getCompression(lastEncoding(field.getValue()));
+                    }
                     seenContentEncoding = true;
                 }
-                case ACCEPT_ENCODING -> deflatable = field.contains("gzip");
+                case ACCEPT_ENCODING ->
+                {
+                    if (!negotiate)
+                    {
+                        deflatable = field.contains(GZIP);
+                    }
+                    else
+                    {
+                        if (acceptEncoding == null)
+                            acceptEncoding = new AcceptEncoding(_encodings);
+                        acceptEncoding.addValue(field.getValue());
+                    }
+                }
                 case IF_MATCH, IF_NONE_MATCH -> etagMatches |= field.getValue().contains(EtagUtils.ETAG_SEPARATOR);
             }
         }
 
+        Compression deflation = deflatable ? _gzipCompression : null;
+        if (acceptEncoding != null)
+            deflation = negotiate(acceptEncoding);
+
         // We need to wrap the request IFF we are inflating or have seen etags with compression separators
+        boolean inflatable = inflation != null;
         if (inflatable && tryInflate || etagMatches)
         {
             // Wrap the request to update the fields and do any inflation
-            request = new GzipRequest(request, inflatable && tryInflate ? getInflateBufferSize() : -1);
+            request = new GzipRequest(request, inflatable && tryInflate ? getInflateBufferSize() : -1, inflation, _formats);
         }
 
         if (tryDeflate && _vary != null)
@@ -586,12 +765,17 @@ public class GzipHandler extends Handler.Wrapper implements GzipFactory
         }
 
         // Wrap the response and callback IFF we can be deflated and will try to deflate
-        if (deflatable && tryDeflate)
+        if (deflation != null && tryDeflate)
         {
-            GzipResponseAndCallback gzipResponseAndCallback = new GzipResponseAndCallback(this, request, response, callback);
+            GzipResponseAndCallback gzipResponseAndCallback = new GzipResponseAndCallback(this, request, response, callback, deflation);
             response = gzipResponseAndCallback;
             callback = gzipResponseAndCallback;
         }
+        else if (request instanceof GzipRequest gzipRequest)
+        {
+            // Without a response wrapper, the request must be destroyed on completion.
+            callback = Callback.from(callback, gzipRequest::destroy);
+        }
 
         // Call handle() with the possibly wrapped request, response and callback
         if (next.handle(request, response, callback))
@@ -603,6 +787,12 @@ public class GzipHandler extends Handler.Wrapper implements GzipFactory
         return false;
     }
 
+    private static String lastEncoding(String value)
+    {
+        int comma = value.lastIndexOf(',');
+        return (comma < 0 ? value : value.substring(comma + 1)).trim();
+    }
+
     protected boolean isMimeTypeDeflatable(MimeTypes mimeTypes, String requestURI)
     {
         // Exclude non-compressible mime-types known from URI extension
@@ -894,4 +1084,30 @@ public class GzipHandler extends Handler.Wrapper implements GzipFactory
     {
         return String.format("%s@%x{%s,min=%s,inflate=%s}", getClass().getSimpleName(), hashCode(), getState(), _minGzipSize, _inflateBufferSize);
     }
+
+    /**
+     * <p>The {@code Accept-Encoding} values, that also records the codings
+     * explicitly listed, including those with {@code q=0}.</p>
+     */
+    private static class AcceptEncoding extends QuotedQualityCSV
+    {
+        private final Set<String> _listed = new AsciiLowerCaseSet();
+
+        private AcceptEncoding(List<String> preferredOrder)
+        {
+            super(preferredOrder);
+        }
+
+        @Override
+        protected void parsedValue(StringBuilder buffer)
+        {
+            super.parsedValue(buffer);
+            _listed.add(buffer.toString());
+        }
+
+        private boolean isListed(String encoding)
+        {
+            return _listed.contains(encoding);
+        }
+    }
 }
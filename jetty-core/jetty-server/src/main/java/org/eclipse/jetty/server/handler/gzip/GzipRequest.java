@@ -14,9 +14,11 @@
 package org.eclipse.jetty.server.handler.gzip;
 
 import java.nio.ByteBuffer;
+import java.util.List;
 import java.util.ListIterator;
 
 import org.eclipse.jetty.http.CompressedContentFormat;
+import org.eclipse.jetty.http.CompressionContentDecoder;
 import org.eclipse.jetty.http.GZIPContentDecoder;
 import org.eclipse.jetty.http.HttpField;
 import org.eclipse.jetty.http.HttpFields;
@@ -28,6 +30,9 @@ import org.eclipse.jetty.io.RetainableByteBuffer;
 import org.eclipse.jetty.io.content.ContentSourceTransformer;
 import org.eclipse.jetty.server.Components;
 import org.eclipse.jetty.server.Request;
+import org.eclipse.jetty.util.component.Destroyable;
+import org.eclipse.jetty.util.compression.Compression;
+import org.eclipse.jetty.util.compression.GzipCompression;
 import org.eclipse.jetty.util.compression.InflaterPool;
 
 public class GzipRequest extends Request.Wrapper
@@ -38,24 +43,44 @@ public class GzipRequest extends Request.Wrapper
     private static final InflaterPool __inflaterPool = new InflaterPool(-1, true);
 
     private final HttpFields _fields;
-    private Decoder _decoder;
+    private ChunkDecoder _decoder;
     private GzipTransformer _gzipTransformer;
 
     public GzipRequest(Request request, int inflateBufferSize)
+    {
+        this(request, inflateBufferSize, null, List.of(CompressedContentFormat.GZIP));
+    }
+
+    /**
+     * @param request the request to wrap
+     * @param inflateBufferSize the size of the inflation buffer, or 0 or less for no inflation
+     * @param inflation the {@link Compression} that decodes the request content, or null for gzip
+     * @param formats the formats whose suffixes are stripped from conditional request etags
+     */
+    public GzipRequest(Request request, int inflateBufferSize, Compression inflation, List<CompressedContentFormat> formats)
     {
         super(request);
-        _fields = updateRequestFields(request, inflateBufferSize > 0);
+        String encoding = inflation == null ? GzipHandler.GZIP : inflation.getEncoding();
+        _fields = updateRequestFields(request, inflateBufferSize > 0, encoding, formats);
 
         if (inflateBufferSize > 0)
         {
             Components components = getComponents();
-            _decoder = new Decoder(__inflaterPool, components.getByteBufferPool(), inflateBufferSize);
+            if (inflation == null)
+                _decoder = new Decoder(__inflaterPool, components.getByteBufferPool(), inflateBufferSize);
+            else if (inflation instanceof GzipCompression gzip)
+                _decoder = new Decoder(gzip.getInflaterPool(), components.getByteBufferPool(), inflateBufferSize);
+            else
+                _decoder = new CompressionDecoder(inflation, components.getByteBufferPool(), inflateBufferSize);
             _gzipTransformer = new GzipTransformer(getWrapped(), _decoder);
         }
     }
 
-    private HttpFields updateRequestFields(Request request, boolean inflatable)
+    private HttpFields updateRequestFields(Request request, boolean inflatable, String encoding, List<CompressedContentFormat> formats)
     {
+        HttpField xContentEncoding = GzipHandler.GZIP.equalsIgnoreCase(encoding)
+            ? X_CE_GZIP
+            : new PreEncodedHttpField(X_CE_GZIP.getName(), encoding);
         HttpFields fields = request.getHeaders();
         HttpFields.Mutable newFields = HttpFields.build(fields);
         boolean contentEncodingSeen = false;
@@ -77,23 +102,27 @@ public class GzipRequest extends Request.Wrapper
                     {
                         contentEncodingSeen = true;
 
-                        if (field.getValue().equalsIgnoreCase("gzip"))
+                        if (field.getValue().equalsIgnoreCase(encoding))
                         {
-                            i.set(X_CE_GZIP);
+                            i.set(xContentEncoding);
                         }
-                        else if (field.containsLast("gzip"))
+                        else if (field.containsLast(encoding))
                         {
                             String v = field.getValue();
                             v = v.substring(0, v.lastIndexOf(','));
                             i.set(new HttpField(HttpHeader.CONTENT_ENCODING, v));
-                            i.add(X_CE_GZIP);
+                            i.add(xContentEncoding);
                         }
                     }
                 }
                 case IF_MATCH, IF_NONE_MATCH ->
                 {
                     String etags = field.getValue();
-                    String etagsNoSuffix = CompressedContentFormat.GZIP.stripSuffixes(etags);
+                    String etagsNoSuffix = etags;
+                    for (CompressedContentFormat format : formats)
+                    {
+                        etagsNoSuffix = format.stripSuffixes(etagsNoSuffix);
+                    }
                     if (!etagsNoSuffix.equals(etags))
                     {
                         i.set(new HttpField(field.getHeader(), etagsNoSuffix));
@@ -139,14 +168,15 @@ public class GzipRequest extends Request.Wrapper
     {
         if (_decoder != null)
             _decoder.destroy();
+        _decoder = null;
     }
 
     static class GzipTransformer extends ContentSourceTransformer
     {
-        private final Decoder _decoder;
+        private final ChunkDecoder _decoder;
         private Content.Chunk _chunk;
 
-        GzipTransformer(Content.Source source, Decoder decoder)
+        GzipTransformer(Content.Source source, ChunkDecoder decoder)
         {
             super(source);
             _decoder = decoder;
@@ -193,7 +223,12 @@ public class GzipRequest extends Request.Wrapper
         }
     }
 
-    static class Decoder extends GZIPContentDecoder
+    interface ChunkDecoder extends Destroyable
+    {
+        RetainableByteBuffer decode(Content.Chunk chunk);
+    }
+
+    static class Decoder extends GZIPContentDecoder implements ChunkDecoder
     {
         private RetainableByteBuffer _decoded;
 
@@ -202,6 +237,42 @@ public class GzipRequest extends Request.Wrapper
             super(inflaterPool, bufferPool, bufferSize);
         }
 
+        @Override
+        public RetainableByteBuffer decode(Content.Chunk chunk)
+        {
+            decodeChunks(chunk.getByteBuffer());
+            RetainableByteBuffer decoded = _decoded;
+            _decoded = null;
+            return decoded;
+        }
+
+        @Override
+        protected boolean decodedChunk(RetainableByteBuffer decoded)
+        {
+            // Retain the chunk because it is stored for later use.
+            decoded.retain();
+            _decoded = decoded;
+            return true;
+        }
+
+        @Override
+        public void decodeChunks(ByteBuffer compressed)
+        {
+            _decoded = null;
+            super.decodeChunks(compressed);
+        }
+    }
+
+    static class CompressionDecoder extends CompressionContentDecoder implements ChunkDecoder
+    {
+        private RetainableByteBuffer _decoded;
+
+        CompressionDecoder(Compression compression, ByteBufferPool bufferPool, int bufferSize)
+        {
+            super(compression, bufferPool, bufferSize);
+        }
+
+        @Override
         public RetainableByteBuffer decode(Content.Chunk chunk)
         {
             decodeChunks(chunk.getByteBuffer());
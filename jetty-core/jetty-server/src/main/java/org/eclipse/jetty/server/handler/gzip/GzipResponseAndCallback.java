@@ -14,12 +14,10 @@
 package org.eclipse.jetty.server.handler.gzip;
 
 import java.nio.ByteBuffer;
-import java.nio.ByteOrder;
 import java.nio.channels.WritePendingException;
 import java.util.concurrent.atomic.AtomicReference;
-import java.util.zip.CRC32;
-import java.util.zip.Deflater;
 
+import org.eclipse.jetty.http.CompressedContentFormat;
 import org.eclipse.jetty.http.HttpField;
 import org.eclipse.jetty.http.HttpFields;
 import org.eclipse.jetty.http.HttpHeader;
@@ -30,24 +28,17 @@ import org.eclipse.jetty.server.Response;
 import org.eclipse.jetty.util.BufferUtil;
 import org.eclipse.jetty.util.Callback;
 import org.eclipse.jetty.util.IteratingNestedCallback;
-import org.eclipse.jetty.util.compression.DeflaterPool;
+import org.eclipse.jetty.util.compression.Compression;
 import org.eclipse.jetty.util.thread.Invocable;
 import org.slf4j.Logger;
 import org.slf4j.LoggerFactory;
 
-import static org.eclipse.jetty.http.CompressedContentFormat.GZIP;
-
 public class GzipResponseAndCallback extends Response.Wrapper implements Callback, Invocable
 {
     private static final Logger LOG = LoggerFactory.getLogger(GzipResponseAndCallback.class);
 
-    // Per RFC-1952 this is the "unknown" OS value byte.
-    private static final byte OS_UNKNOWN = (byte)0xFF;
-    private static final byte[] GZIP_HEADER = new byte[]{
-        (byte)0x1f, (byte)0x8b, Deflater.DEFLATED, 0, 0, 0, 0, 0, 0, OS_UNKNOWN
-    };
-    // Per RFC-1952, the GZIP trailer is 8 bytes
-    private static final int GZIP_TRAILER_SIZE = 8;
+    // Per RFC-1952, the GZIP header is 10 bytes and the GZIP trailer is 8 bytes.
+    private static final int MIN_BUFFER_SIZE = 10 + 8;
 
     private enum GZState
     {
@@ -66,21 +57,36 @@ public class GzipResponseAndCallback extends Response.Wrapper implements Callbac
     }
 
     private final AtomicReference<GZState> _state = new AtomicReference<>(GZState.MIGHT_COMPRESS);
-    private final CRC32 _crc = new CRC32();
     private final Callback _callback;
     private final GzipFactory _factory;
+    private final Compression _compression;
+    private final CompressedContentFormat _format;
     private final int _bufferSize;
     private final boolean _syncFlush;
-    private DeflaterPool.Entry _deflaterEntry;
+    private Compression.Encoder _encoder;
     private RetainableByteBuffer _buffer;
     private boolean _last;
 
     public GzipResponseAndCallback(GzipHandler handler, Request request, Response response, Callback callback)
+    {
+        this(handler, request, response, callback, null);
+    }
+
+    /**
+     * @param handler the handler
+     * @param request the request
+     * @param response the response to wrap
+     * @param callback the callback to wrap
+     * @param compression the compression negotiated for the response, or null for gzip
+     */
+    public GzipResponseAndCallback(GzipHandler handler, Request request, Response response, Callback callback, Compression compression)
     {
         super(request, response);
         _callback = callback;
         _factory = handler;
-        _bufferSize = Math.max(GZIP_HEADER.length + GZIP_TRAILER_SIZE, request.getConnectionMetaData().getHttpConfiguration().getOutputBufferSize());
+        _compression = compression;
+        _format = compression == null ? CompressedContentFormat.GZIP : GzipHandler.toFormat(compression.getEncoding());
+        _bufferSize = Math.max(MIN_BUFFER_SIZE, request.getConnectionMetaData().getHttpConfiguration().getOutputBufferSize());
         _syncFlush = handler.isSyncFlush();
     }
 
@@ -143,14 +149,6 @@ public class GzipResponseAndCallback extends Response.Wrapper implements Callbac
         }
     }
 
-    private void addTrailer(ByteBuffer outputBuffer)
-    {
-        if (LOG.isDebugEnabled())
-            LOG.debug("addTrailer: _crc={}, _totalIn={})", _crc.getValue(), _deflaterEntry.get().getTotalIn());
-        outputBuffer.putInt((int)_crc.getValue());
-        outputBuffer.putInt(_deflaterEntry.get().getTotalIn());
-    }
-
     private void gzip(boolean complete, final Callback callback, ByteBuffer content)
     {
         if (content != null || complete)
@@ -182,7 +180,7 @@ public class GzipResponseAndCallback extends Response.Wrapper implements Callbac
                 String responseEtag = fields.get(HttpHeader.ETAG);
                 if (requestEtags != null && responseEtag != null)
                 {
-                    String responseEtagGzip = etagGzip(responseEtag);
+                    String responseEtagGzip = _format.etag(responseEtag);
                     if (requestEtags.contains(responseEtagGzip))
                         fields.put(HttpHeader.ETAG, responseEtagGzip);
                 }
@@ -235,27 +233,26 @@ public class GzipResponseAndCallback extends Response.Wrapper implements Callbac
             if (contentLength < 0 && last)
                 contentLength = BufferUtil.length(content);
 
-            _deflaterEntry = _factory.getDeflaterEntry(request, contentLength);
-            if (_deflaterEntry == null)
+            _encoder = _factory.getEncoder(_compression, request, contentLength);
+            if (_encoder == null)
             {
                 if (LOG.isDebugEnabled())
-                    LOG.debug("{} exclude no deflater", this);
+                    LOG.debug("{} exclude no encoder", this);
                 _state.set(GZState.NOT_COMPRESSING);
                 super.write(last, content, callback);
                 return;
             }
 
-            fields.put(GZIP.getContentEncoding());
-            _crc.reset();
+            fields.put(_format.getContentEncoding());
 
             // Adjust headers
             fields.remove(HttpHeader.CONTENT_LENGTH);
             String etag = fields.get(HttpHeader.ETAG);
             if (etag != null)
-                fields.put(HttpHeader.ETAG, etagGzip(etag));
+                fields.put(HttpHeader.ETAG, _format.etag(etag));
 
             if (LOG.isDebugEnabled())
-                LOG.debug("{} compressing {}", this, _deflaterEntry);
+                LOG.debug("{} compressing {}", this, _encoder);
             _state.set(GZState.COMPRESSING);
 
             if (BufferUtil.isEmpty(content))
@@ -274,11 +271,6 @@ public class GzipResponseAndCallback extends Response.Wrapper implements Callbac
         }
     }
 
-    private String etagGzip(String etag)
-    {
-        return GZIP.etag(etag);
-    }
-
     public void noCompression()
     {
         while (true)
@@ -311,11 +303,7 @@ public class GzipResponseAndCallback extends Response.Wrapper implements Callbac
             _last = complete;
 
             if (_content != null)
-            {
-                _crc.update(_content.slice());
-                Deflater deflater = _deflaterEntry.get();
-                deflater.setInput(_content);
-            }
+                _encoder.setInput(_content);
 
             if (LOG.isDebugEnabled())
                 LOG.debug("GzipBufferCB(complete={}, callback={}, content={})", complete, callback, BufferUtil.toDetailString(content));
@@ -324,10 +312,10 @@ public class GzipResponseAndCallback extends Response.Wrapper implements Callbac
         @Override
         protected void onCompleteFailure(Throwable x)
         {
-            if (_deflaterEntry != null)
+            if (_encoder != null)
             {
-                _deflaterEntry.release();
-                _deflaterEntry = null;
+                _encoder.release();
+                _encoder = null;
             }
             super.onCompleteFailure(x);
         }
@@ -354,12 +342,7 @@ public class GzipResponseAndCallback extends Response.Wrapper implements Callbac
             if (_buffer == null)
             {
                 _buffer = getRequest().getComponents().getByteBufferPool().acquire(_bufferSize, false);
-                ByteBuffer byteBuffer = _buffer.getByteBuffer();
-                // Per RFC-1952, GZIP is LITTLE_ENDIAN
-                byteBuffer.order(ByteOrder.LITTLE_ENDIAN);
-                BufferUtil.flipToFill(byteBuffer);
-                // Add GZIP Header
-                byteBuffer.put(GZIP_HEADER, 0, GZIP_HEADER.length);
+                BufferUtil.flipToFill(_buffer.getByteBuffer());
             }
             else
             {
@@ -367,22 +350,20 @@ public class GzipResponseAndCallback extends Response.Wrapper implements Callbac
                 BufferUtil.clearToFill(_buffer.getByteBuffer());
             }
 
-            Deflater deflater = _deflaterEntry.get();
-
             return switch (gzstate)
             {
-                case COMPRESSING -> compressing(deflater, _buffer.getByteBuffer());
-                case FINISHING -> finishing(deflater, _buffer.getByteBuffer());
+                case COMPRESSING -> compressing(_encoder, _buffer.getByteBuffer());
+                case FINISHING -> finishing(_encoder, _buffer.getByteBuffer());
                 default -> throw new IllegalStateException("Unexpected state [" + _state.get() + "]");
             };
         }
 
         private void cleanup()
         {
-            if (_deflaterEntry != null)
+            if (_encoder != null)
             {
-                _deflaterEntry.release();
-                _deflaterEntry = null;
+                _encoder.release();
+                _encoder = null;
             }
 
             if (_buffer != null)
@@ -392,25 +373,20 @@ public class GzipResponseAndCallback extends Response.Wrapper implements Callbac
             }
         }
 
-        private int getFlushMode()
-        {
-            return _syncFlush ? Deflater.SYNC_FLUSH : Deflater.NO_FLUSH;
-        }
-
         /**
          * This method is called directly from {@link #process()} to perform the compressing of
          * the content this {@link GzipBufferCB} represents.
          */
-        private Action compressing(Deflater deflater, ByteBuffer outputBuffer)
+        private Action compressing(Compression.Encoder encoder, ByteBuffer outputBuffer) throws Exception
         {
             if (LOG.isDebugEnabled())
-                LOG.debug("compressing() deflater={}, outputBuffer={}", deflater, BufferUtil.toDetailString(outputBuffer));
+                LOG.debug("compressing() encoder={}, outputBuffer={}", encoder, BufferUtil.toDetailString(outputBuffer));
 
-            if (!deflater.finished())
+            if (!encoder.isFinished())
             {
-                if (!deflater.needsInput())
+                if (!encoder.needsInput())
                 {
-                    int len = deflater.deflate(outputBuffer, getFlushMode());
+                    int len = encoder.encode(outputBuffer, _syncFlush);
                     if (len > 0)
                     {
                         BufferUtil.flipToFlush(outputBuffer, 0);
@@ -423,8 +399,8 @@ public class GzipResponseAndCallback extends Response.Wrapper implements Callbac
             if (_last)
             {
                 _state.set(GZState.FINISHING);
-                deflater.finish();
-                return finishing(deflater, outputBuffer);
+                encoder.finish();
+                return finishing(encoder, outputBuffer);
             }
 
             BufferUtil.flipToFlush(outputBuffer, 0);
@@ -434,7 +410,7 @@ public class GzipResponseAndCallback extends Response.Wrapper implements Callbac
                 return Action.SCHEDULED;
             }
 
-            // the content held by GzipBufferCB is fully consumed as input to the Deflater instance, we are done
+            // the content held by GzipBufferCB is fully consumed as input to the encoder, we are done
             if (BufferUtil.isEmpty(_content))
                 return Action.SUCCEEDED;
 
@@ -443,44 +419,32 @@ public class GzipResponseAndCallback extends Response.Wrapper implements Callbac
         }
 
         /**
-         * This method is called by {@link #compressing(Deflater, ByteBuffer)}, once the last chunk is compressed;
+         * This method is called by {@link #compressing(Compression.Encoder, ByteBuffer)}, once the last chunk is compressed;
          * or directly from {@link #process()} if an earlier call to this method was unable to complete.
          */
-        private Action finishing(Deflater deflater, ByteBuffer outputBuffer)
+        private Action finishing(Compression.Encoder encoder, ByteBuffer outputBuffer) throws Exception
         {
             if (LOG.isDebugEnabled())
-                LOG.debug("finishing() deflater={}, outputBuffer={}", deflater, BufferUtil.toDetailString(outputBuffer));
-            if (!deflater.finished())
-            {
-                int len = deflater.deflate(outputBuffer, getFlushMode());
-                // try to preserve single write if possible (header + compressed content + trailer)
-                if (deflater.finished() && outputBuffer.remaining() >= GZIP_TRAILER_SIZE)
-                {
-                    _state.set(GZState.FINISHED);
-                    addTrailer(outputBuffer);
-                    BufferUtil.flipToFlush(outputBuffer, 0);
-                    write(true, outputBuffer);
-                    return Action.SCHEDULED;
-                }
-
-                if (len > 0)
-                {
-                    BufferUtil.flipToFlush(outputBuffer, 0);
-                    write(false, outputBuffer);
-                    return Action.SCHEDULED;
-                }
-
-                // No progress made on deflate, deflater not finished, we shouldn't be able to reach this.
-                throw new AssertionError("No progress on deflate made for " + this);
-            }
-            else
+                LOG.debug("finishing() encoder={}, outputBuffer={}", encoder, BufferUtil.toDetailString(outputBuffer));
+            int len = encoder.encode(outputBuffer, _syncFlush);
+            // try to preserve single write if possible (header + compressed content + trailer)
+            if (encoder.isFinished())
             {
                 _state.set(GZState.FINISHED);
-                addTrailer(outputBuffer);
                 BufferUtil.flipToFlush(outputBuffer, 0);
                 write(true, outputBuffer);
                 return Action.SCHEDULED;
             }
+
+            if (len > 0)
+            {
+                BufferUtil.flipToFlush(outputBuffer, 0);
+                write(false, outputBuffer);
+                return Action.SCHEDULED;
+            }
+
+            // No progress made on encode, encoder not finished, we shouldn't be able to reach this.
+            throw new AssertionError("No progress on encode made for " + this);
         }
 
         private void write(boolean last, ByteBuffer outputBuffer)
@@ -493,12 +457,12 @@ public class GzipResponseAndCallback extends Response.Wrapper implements Callbac
         @Override
         public String toString()
         {
-            return String.format("%s[content=%s last=%b buffer=%s deflate=%s %s]",
+            return String.format("%s[content=%s last=%b buffer=%s encoder=%s %s]",
                 super.toString(),
                 BufferUtil.toDetailString(_content),
                 _last,
                 _buffer,
-                _deflaterEntry,
+                _encoder,
                 _state.get());
         }
     }
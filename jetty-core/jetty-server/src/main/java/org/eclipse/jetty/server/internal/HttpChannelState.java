@@ -15,6 +15,7 @@ package org.eclipse.jetty.server.internal;
 
 import java.io.IOException;
 import java.nio.ByteBuffer;
+import java.nio.channels.FileChannel;
 import java.nio.channels.WritePendingException;
 import java.util.ArrayList;
 import java.util.HashMap;
@@ -1172,8 +1173,44 @@ public class HttpChannelState implements HttpChannel, Components
         @Override
         public void write(boolean last, ByteBuffer content, Callback callback)
         {
-            long length = BufferUtil.length(content);
+            write(last, content, null, 0, BufferUtil.length(content), callback);
+        }
 
+        /**
+         * @return whether {@link #transfer(boolean, FileChannel, long, long, Callback)} can be used
+         * to write file content on the underlying {@link HttpStream}.
+         */
+        public boolean isTransferSupported()
+        {
+            try (AutoLock ignored = _request._lock.lock())
+            {
+                HttpChannelState httpChannelState = _request._httpChannelState;
+                HttpStream stream = httpChannelState == null ? null : httpChannelState._stream;
+                return stream != null && stream.isTransferSupported();
+            }
+        }
+
+        /**
+         * <p>Writes a region of a file as response content, with the same semantic as
+         * {@link #write(boolean, ByteBuffer, Callback)}, but possibly without copying the
+         * file content through user space buffers.</p>
+         * <p>The {@code Content-Length} of the response must be known, either because it is already
+         * committed or because it is set in the response headers.</p>
+         *
+         * @param last whether this is the last write of the response
+         * @param file the file to write the region of
+         * @param position the position within the file of the region
+         * @param length the length of the region
+         * @param callback the callback to notify when the write completes
+         * @see #isTransferSupported()
+         */
+        public void transfer(boolean last, FileChannel file, long position, long length, Callback callback)
+        {
+            write(last, null, Objects.requireNonNull(file), position, length, callback);
+        }
+
+        private void write(boolean last, ByteBuffer content, FileChannel file, long position, long length, Callback callback)
+        {
             HttpChannelState httpChannelState;
             HttpStream stream;
             Throwable writeFailure;
@@ -1191,7 +1228,7 @@ public class HttpChannelState implements HttpChannel, Components
                         if (_writeCallback instanceof InterimCallback interimCallback)
                         {
                             // Do this write after the interim callback.
-                            interimCallback.whenComplete((v, t) -> write(last, content, callback));
+                            interimCallback.whenComplete((v, t) -> write(last, content, file, position, length, callback));
                             return;
                         }
                         writeFailure = new WritePendingException();
@@ -1201,7 +1238,9 @@ public class HttpChannelState implements HttpChannel, Components
                         long committedContentLength = httpChannelState._committedContentLength;
                         long contentLength = committedContentLength >= 0 ? committedContentLength : getHeaders().getLongField(HttpHeader.CONTENT_LENGTH);
 
-                        if (contentLength >= 0 && totalWritten != contentLength)
+                        if (file != null && contentLength < 0)
+                            writeFailure = new IllegalStateException("Unknown content-length for file transfer");
+                        else if (contentLength >= 0 && totalWritten != contentLength)
                         {
                             // If the content length were not compatible with what was written, then we need to abort.
                             String lengthError = null;
@@ -1245,6 +1284,14 @@ public class HttpChannelState implements HttpChannel, Components
                     responseMetaData = lockedPrepareResponse(httpChannelState, last);
             }
 
+            if (file != null)
+            {
+                if (LOG.isDebugEnabled())
+                    LOG.debug("transferring last={} {}@{}+{} {}", last, file, position, length, this);
+                stream.transfer(_request._metaData, responseMetaData, last, file, position, length, this);
+                return;
+            }
+
             if (LOG.isDebugEnabled())
                 LOG.debug("writing last={} {} {}", last, BufferUtil.toDetailString(content), this);
             stream.send(_request._metaData, responseMetaData, last, content, this);
@@ -15,6 +15,7 @@ package org.eclipse.jetty.server.internal;
 
 import java.io.IOException;
 import java.nio.ByteBuffer;
+import java.nio.channels.FileChannel;
 import java.nio.channels.WritePendingException;
 import java.util.List;
 import java.util.Objects;
@@ -706,6 +707,9 @@ public class HttpConnection extends AbstractMetaDataConnection implements Runnab
         private Callback _callback;
         private RetainableByteBuffer _header;
         private RetainableByteBuffer _chunk;
+        private FileChannel _file;
+        private long _filePosition;
+        private long _fileLength;
         private boolean _shutdownOut;
 
         private SendCallback()
@@ -729,6 +733,7 @@ public class HttpConnection extends AbstractMetaDataConnection implements Runnab
                 _lastContent = last;
                 _callback = callback;
                 _header = null;
+                _file = null;
                 if (getConnector().isShutdown())
                     _generator.setPersistent(false);
                 return true;
@@ -743,6 +748,16 @@ public class HttpConnection extends AbstractMetaDataConnection implements Runnab
             }
         }
 
+        private boolean reset(MetaData.Request request, MetaData.Response response, FileChannel file, long position, long length, boolean last, Callback callback)
+        {
+            if (!reset(request, response, null, last, callback))
+                return false;
+            _file = file;
+            _filePosition = position;
+            _fileLength = length;
+            return true;
+        }
+
         @Override
         public Action process() throws Exception
         {
@@ -801,6 +816,23 @@ public class HttpConnection extends AbstractMetaDataConnection implements Runnab
                             if (_chunk != null)
                                 _chunk.clear();
                             BufferUtil.clear(_content);
+                            _file = null;
+                        }
+
+                        if (_file != null)
+                        {
+                            // The file region is transferred once, after any header, by the EndPoint.
+                            if (_generator.isChunking())
+                                throw new IllegalStateException("Cannot transfer chunked content");
+                            FileChannel file = _file;
+                            _file = null;
+                            boolean hasHeader = BufferUtil.hasContent(headerByteBuffer);
+                            HttpConnection.this.bytesOut.add(_fileLength + (hasHeader ? _header.remaining() : 0));
+                            if (hasHeader)
+                                getEndPoint().transfer(this, file, _filePosition, _fileLength, headerByteBuffer);
+                            else
+                                getEndPoint().transfer(this, file, _filePosition, _fileLength);
+                            return Action.SCHEDULED;
                         }
 
                         int gatherWrite = 0;
@@ -883,6 +915,7 @@ public class HttpConnection extends AbstractMetaDataConnection implements Runnab
             _callback = null;
             _info = null;
             _content = null;
+            _file = null;
             releaseHeader();
             releaseChunk();
             return complete;
@@ -1398,7 +1431,40 @@ public class HttpConnection extends AbstractMetaDataConnection implements Runnab
                     return;
                 }
             }
-            else if (_generator.isCommitted())
+            else
+            {
+                prepareCommit(response, callback);
+            }
+
+            if (_sendCallback.reset(_request, response, content, last, callback))
+                _sendCallback.iterate();
+        }
+
+        @Override
+        public boolean isTransferSupported()
+        {
+            return getEndPoint().isTransferSupported();
+        }
+
+        @Override
+        public void transfer(MetaData.Request request, MetaData.Response response, boolean last, FileChannel file, long position, long length, Callback callback)
+        {
+            if (length <= 0)
+            {
+                send(request, response, last, null, callback);
+                return;
+            }
+
+            if (response != null)
+                prepareCommit(response, callback);
+
+            if (_sendCallback.reset(_request, response, file, position, length, last, callback))
+                _sendCallback.iterate();
+        }
+
+        private void prepareCommit(MetaData.Response response, Callback callback)
+        {
+            if (_generator.isCommitted())
             {
                 callback.failed(new IllegalStateException("Committed"));
             }
@@ -1415,9 +1481,6 @@ public class HttpConnection extends AbstractMetaDataConnection implements Runnab
                     _generator.setPersistent(false);
                 }
             }
-
-            if (_sendCallback.reset(_request, response, content, last, callback))
-                _sendCallback.iterate();
         }
 
         @Override
@@ -0,0 +1,147 @@
+//
+// ========================================================================
+// Copyright (c) 1995 Mort Bay Consulting Pty Ltd and others.
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License v. 2.0 which is available at
+// https://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+// ========================================================================
+//
+
+package org.eclipse.jetty.server;
+
+import java.io.OutputStream;
+import java.net.Socket;
+import java.nio.charset.StandardCharsets;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.util.HashSet;
+import java.util.List;
+import java.util.Set;
+import java.util.concurrent.CountDownLatch;
+import java.util.concurrent.TimeUnit;
+import java.util.concurrent.atomic.AtomicReference;
+
+import org.eclipse.jetty.http.HttpStatus;
+import org.eclipse.jetty.http.HttpTester;
+import org.eclipse.jetty.toolchain.test.jupiter.WorkDir;
+import org.eclipse.jetty.toolchain.test.jupiter.WorkDirExtension;
+import org.eclipse.jetty.util.Callback;
+import org.eclipse.jetty.util.NanoTime;
+import org.eclipse.jetty.util.component.LifeCycle;
+import org.junit.jupiter.api.AfterEach;
+import org.junit.jupiter.api.Test;
+import org.junit.jupiter.api.extension.ExtendWith;
+
+import static org.hamcrest.MatcherAssert.assertThat;
+import static org.hamcrest.Matchers.is;
+import static org.hamcrest.Matchers.nullValue;
+import static org.junit.jupiter.api.Assertions.assertEquals;
+import static org.junit.jupiter.api.Assertions.assertTrue;
+
+@ExtendWith(WorkDirExtension.class)
+public class BatchingRequestLogWriterTest
+{
+    private Server _server;
+
+    @AfterEach
+    public void dispose()
+    {
+        LifeCycle.stop(_server);
+    }
+
+    @Test
+    public void testConcurrentWrites(WorkDir workDir) throws Exception
+    {
+        Path logFile = workDir.getEmptyPathDir().resolve("request.log");
+        BatchingRequestLogWriter writer = new BatchingRequestLogWriter(logFile.toString());
+        writer.setCapacity(64);
+        writer.setMaxBatchSize(8);
+        writer.setOverflowPolicy(BatchingRequestLogWriter.OverflowPolicy.BLOCK);
+        writer.start();
+
+        int threads = 4;
+        int entries = 1000;
+        CountDownLatch latch = new CountDownLatch(threads);
+        AtomicReference<Throwable> failure = new AtomicReference<>();
+        for (int t = 0; t < threads; ++t)
+        {
+            int thread = t;
+            new Thread(() ->
+            {
+                try
+                {
+                    for (int i = 0; i < entries; ++i)
+                    {
+                        writer.write("entry \u20ac " + thread + "/" + i);
+                    }
+                }
+                catch (Throwable x)
+                {
+                    failure.compareAndSet(null, x);
+                }
+                finally
+                {
+                    latch.countDown();
+                }
+            }).start();
+        }
+        assertTrue(latch.await(10, TimeUnit.SECONDS));
+        assertThat(failure.get(), nullValue());
+        writer.stop();
+
+        List<String> lines = Files.readAllLines(logFile, StandardCharsets.UTF_8);
+        assertThat(lines.size(), is(threads * entries));
+        Set<String> unique = new HashSet<>(lines);
+        assertThat(unique.size(), is(threads * entries));
+        assertTrue(unique.contains("entry \u20ac 3/999"));
+        assertThat(writer.getWrittenCount(), is((long)threads * entries));
+        assertThat(writer.getDroppedCount(), is(0L));
+    }
+
+    @Test
+    public void testCustomRequestLogEncodesIntoBuffers(WorkDir workDir) throws Exception
+    {
+        Path logFile = workDir.getEmptyPathDir().resolve("request.log");
+        BatchingRequestLogWriter writer = new BatchingRequestLogWriter(logFile.toString());
+
+        _server = new Server();
+        ServerConnector connector = new ServerConnector(_server);
+        _server.addConnector(connector);
+        _server.setRequestLog(new CustomRequestLog(writer, "%m %U %s %{X-Name}o"));
+        _server.setHandler(new Handler.Abstract()
+        {
+            @Override
+            public boolean handle(Request request, Response response, Callback callback)
+            {
+                response.getHeaders().put("X-Name", "caf\u00e9");
+                callback.succeeded();
+                return true;
+            }
+        });
+        _server.start();
+
+        try (Socket socket = new Socket("localhost", connector.getLocalPort()))
+        {
+            OutputStream output = socket.getOutputStream();
+            output.write("GET /path HTTP/1.0\r\n\r\n".getBytes(StandardCharsets.UTF_8));
+            output.flush();
+            HttpTester.Response response = HttpTester.parseResponse(HttpTester.from(socket.getInputStream()));
+            assertEquals(HttpStatus.OK_200, response.getStatus());
+        }
+
+        // The entry may be logged after the response is received.
+        long end = NanoTime.now() + TimeUnit.SECONDS.toNanos(5);
+        while (writer.getWrittenCount() == 0 && NanoTime.until(end) > 0)
+        {
+            Thread.sleep(10);
+        }
+        _server.stop();
+
+        List<String> lines = Files.readAllLines(logFile, StandardCharsets.UTF_8);
+        assertThat(lines, is(List.of("GET /path 200 caf\u00e9")));
+    }
+}
@@ -0,0 +1,131 @@
+//
+// ========================================================================
+// Copyright (c) 1995 Mort Bay Consulting Pty Ltd and others.
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License v. 2.0 which is available at
+// https://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+// ========================================================================
+//
+
+package org.eclipse.jetty.server.handler;
+
+import java.io.InputStream;
+import java.io.OutputStream;
+import java.net.ServerSocket;
+import java.net.Socket;
+import java.nio.charset.StandardCharsets;
+import java.util.Arrays;
+import java.util.concurrent.ConcurrentMap;
+import java.util.concurrent.TimeUnit;
+import java.util.concurrent.atomic.AtomicReference;
+
+import org.eclipse.jetty.http.HttpStatus;
+import org.eclipse.jetty.http.HttpTester;
+import org.eclipse.jetty.io.EndPoint;
+import org.eclipse.jetty.server.Server;
+import org.eclipse.jetty.server.ServerConnector;
+import org.junit.jupiter.api.AfterEach;
+import org.junit.jupiter.api.BeforeEach;
+import org.junit.jupiter.api.Test;
+
+import static org.awaitility.Awaitility.await;
+import static org.hamcrest.Matchers.is;
+import static org.junit.jupiter.api.Assertions.assertArrayEquals;
+import static org.junit.jupiter.api.Assertions.assertEquals;
+import static org.junit.jupiter.api.Assertions.assertNotNull;
+
+public class ConnectHandlerTest
+{
+    private final AtomicReference<ConnectHandler.DownstreamConnection> downstream = new AtomicReference<>();
+    private final AtomicReference<ConnectHandler.UpstreamConnection> upstream = new AtomicReference<>();
+    private Server proxy;
+    private ServerConnector proxyConnector;
+
+    @BeforeEach
+    public void prepare() throws Exception
+    {
+        proxy = new Server();
+        proxyConnector = new ServerConnector(proxy);
+        proxy.addConnector(proxyConnector);
+        proxy.setHandler(new ConnectHandler()
+        {
+            @Override
+            protected DownstreamConnection newDownstreamConnection(EndPoint endPoint, ConcurrentMap<String, Object> context)
+            {
+                DownstreamConnection connection = super.newDownstreamConnection(endPoint, context);
+                downstream.set(connection);
+                return connection;
+            }
+
+            @Override
+            protected UpstreamConnection newUpstreamConnection(EndPoint endPoint, ConnectContext connectContext)
+            {
+                UpstreamConnection connection = super.newUpstreamConnection(endPoint, connectContext);
+                upstream.set(connection);
+                return connection;
+            }
+        });
+        proxy.start();
+    }
+
+    @AfterEach
+    public void dispose() throws Exception
+    {
+        proxy.stop();
+    }
+
+    @Test
+    public void testTunnelBytesInAndOut() throws Exception
+    {
+        byte[] clientBytes = new byte[3 * 1024];
+        Arrays.fill(clientBytes, (byte)'C');
+        byte[] serverBytes = new byte[5 * 1024];
+        Arrays.fill(serverBytes, (byte)'S');
+
+        try (ServerSocket server = new ServerSocket(0))
+        {
+            String hostPort = "localhost:" + server.getLocalPort();
+            String request = """
+                CONNECT %s HTTP/1.1\r
+                Host: %s\r
+                \r
+                """.formatted(hostPort, hostPort);
+            try (Socket client = new Socket("localhost", proxyConnector.getLocalPort()))
+            {
+                client.setSoTimeout(5000);
+                OutputStream clientOutput = client.getOutputStream();
+                clientOutput.write(request.getBytes(StandardCharsets.UTF_8));
+                clientOutput.flush();
+
+                try (Socket serverSocket = server.accept())
+                {
+                    serverSocket.setSoTimeout(5000);
+
+                    HttpTester.Response response = HttpTester.parseResponse(HttpTester.from(client.getInputStream()));
+                    assertNotNull(response);
+                    assertEquals(HttpStatus.OK_200, response.getStatus());
+
+                    clientOutput.write(clientBytes);
+                    clientOutput.flush();
+                    assertArrayEquals(clientBytes, serverSocket.getInputStream().readNBytes(clientBytes.length));
+
+                    OutputStream serverOutput = serverSocket.getOutputStream();
+                    serverOutput.write(serverBytes);
+                    serverOutput.flush();
+                    InputStream clientInput = client.getInputStream();
+                    assertArrayEquals(serverBytes, clientInput.readNBytes(serverBytes.length));
+
+                    // The counters are updated when the writes complete.
+                    await().atMost(5, TimeUnit.SECONDS).until(() -> downstream.get().getBytesIn(), is((long)clientBytes.length));
+                    await().atMost(5, TimeUnit.SECONDS).until(() -> upstream.get().getBytesOut(), is((long)clientBytes.length));
+                    await().atMost(5, TimeUnit.SECONDS).until(() -> upstream.get().getBytesIn(), is((long)serverBytes.length));
+                    await().atMost(5, TimeUnit.SECONDS).until(() -> downstream.get().getBytesOut(), is((long)serverBytes.length));
+                }
+            }
+        }
+    }
+}
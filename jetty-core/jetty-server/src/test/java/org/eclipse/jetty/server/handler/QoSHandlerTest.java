@@ -16,6 +16,7 @@ package org.eclipse.jetty.server.handler;
 import java.time.Duration;
 import java.util.ArrayList;
 import java.util.List;
+import java.util.concurrent.CopyOnWriteArrayList;
 import java.util.concurrent.TimeUnit;
 import java.util.stream.IntStream;
 
@@ -279,6 +280,114 @@ public class QoSHandlerTest
         assertEquals(HttpStatus.OK_200, response.getStatus());
     }
 
+    @ParameterizedTest
+    @ValueSource(ints = {-1, 20})
+    public void testPriorityAboveMaxPriority(int maxPriority) throws Exception
+    {
+        QoSHandler qosHandler = new QoSHandler()
+        {
+            @Override
+            protected int getPriority(Request request)
+            {
+                return (int)request.getHeaders().getLongField("Priority");
+            }
+        };
+        // By default priorities above 10 are clamped, so they are resumed in suspend order.
+        if (maxPriority >= 0)
+            qosHandler.setMaxPriority(maxPriority);
+        qosHandler.setMaxRequestCount(1);
+        qosHandler.setMaxSuspend(Duration.ofSeconds(5));
+        List<Callback> callbacks = new CopyOnWriteArrayList<>();
+        qosHandler.setHandler(new Handler.Abstract()
+        {
+            @Override
+            public boolean handle(Request request, Response response, Callback callback)
+            {
+                callbacks.add(callback);
+                return true;
+            }
+        });
+        start(qosHandler);
+
+        LocalConnector.LocalEndPoint endPoint0 = connector.executeRequest("""
+            GET /0 HTTP/1.1
+            Host: localhost
+                            
+            """);
+        await().atMost(5, TimeUnit.SECONDS).until(callbacks::size, is(1));
+
+        LocalConnector.LocalEndPoint endPoint15 = connector.executeRequest("""
+            GET /15 HTTP/1.1
+            Host: localhost
+            Priority: 15
+                            
+            """);
+        await().atMost(5, TimeUnit.SECONDS).until(qosHandler::getSuspendedRequestCount, is(1L));
+        LocalConnector.LocalEndPoint endPoint20 = connector.executeRequest("""
+            GET /20 HTTP/1.1
+            Host: localhost
+            Priority: 20
+                            
+            """);
+        await().atMost(5, TimeUnit.SECONDS).until(qosHandler::getSuspendedRequestCount, is(2L));
+
+        callbacks.remove(0).succeeded();
+        assertEquals(HttpStatus.OK_200, HttpTester.parseResponse(endPoint0.getResponse(false, 5, TimeUnit.SECONDS)).getStatus());
+
+        LocalConnector.LocalEndPoint first = maxPriority < 0 ? endPoint15 : endPoint20;
+        LocalConnector.LocalEndPoint second = maxPriority < 0 ? endPoint20 : endPoint15;
+        await().atMost(5, TimeUnit.SECONDS).until(callbacks::size, is(1));
+        callbacks.remove(0).succeeded();
+        assertEquals(HttpStatus.OK_200, HttpTester.parseResponse(first.getResponse(false, 5, TimeUnit.SECONDS)).getStatus());
+
+        await().atMost(5, TimeUnit.SECONDS).until(callbacks::size, is(1));
+        callbacks.remove(0).succeeded();
+        assertEquals(HttpStatus.OK_200, HttpTester.parseResponse(second.getResponse(false, 5, TimeUnit.SECONDS)).getStatus());
+    }
+
+    @Test
+    public void testStopFailsSuspendedRequests() throws Exception
+    {
+        QoSHandler qosHandler = new QoSHandler();
+        qosHandler.setMaxRequestCount(1);
+        List<Callback> callbacks = new CopyOnWriteArrayList<>();
+        qosHandler.setHandler(new Handler.Abstract()
+        {
+            @Override
+            public boolean handle(Request request, Response response, Callback callback)
+            {
+                callbacks.add(callback);
+                return true;
+            }
+        });
+        start(qosHandler);
+
+        LocalConnector.LocalEndPoint endPoint0 = connector.executeRequest("""
+            GET /0 HTTP/1.1
+            Host: localhost
+                            
+            """);
+        await().atMost(5, TimeUnit.SECONDS).until(callbacks::size, is(1));
+        LocalConnector.LocalEndPoint endPoint1 = connector.executeRequest("""
+            GET /1 HTTP/1.1
+            Host: localhost
+                            
+            """);
+        await().atMost(5, TimeUnit.SECONDS).until(qosHandler::getSuspendedRequestCount, is(1L));
+
+        qosHandler.stop();
+
+        // The suspended request is failed when the handler is stopped.
+        HttpTester.Response response1 = HttpTester.parseResponse(endPoint1.getResponse(false, 5, TimeUnit.SECONDS));
+        assertEquals(HttpStatus.SERVICE_UNAVAILABLE_503, response1.getStatus());
+        assertThat(qosHandler.getSuspendedRequestCount(), is(0L));
+
+        // Completing the request that holds the permit does not try to resume anything.
+        callbacks.remove(0).succeeded();
+        HttpTester.Response response0 = HttpTester.parseResponse(endPoint0.getResponse(false, 5, TimeUnit.SECONDS));
+        assertEquals(HttpStatus.OK_200, response0.getStatus());
+    }
+
     @ParameterizedTest
     @ValueSource(booleans = {true, false})
     public void testConcurrentRequests(boolean async) throws Exception
@@ -407,4 +516,121 @@ public class QoSHandlerTest
         assertEquals(HttpStatus.OK_200, response.getStatus());
     }
 
+    @Test
+    public void testWeightedFairPriority() throws Exception
+    {
+        QoSHandler qosHandler = new QoSHandler()
+        {
+            @Override
+            protected int getPriority(Request request)
+            {
+                return (int)request.getHeaders().getLongField("Priority");
+            }
+        };
+        qosHandler.setMaxRequestCount(1);
+        qosHandler.setMaxPriority(1);
+        qosHandler.setWeightedFair(true);
+        List<String> paths = new CopyOnWriteArrayList<>();
+        List<Callback> callbacks = new CopyOnWriteArrayList<>();
+        qosHandler.setHandler(new Handler.Abstract()
+        {
+            @Override
+            public boolean handle(Request request, Response response, Callback callback)
+            {
+                paths.add(request.getHttpURI().getPath());
+                callbacks.add(callback);
+                return true;
+            }
+        });
+        start(qosHandler);
+
+        List<LocalConnector.LocalEndPoint> endPoints = new ArrayList<>();
+        endPoints.add(connector.executeRequest("""
+            GET /first HTTP/1.1
+            Host: localhost
+                            
+            """));
+        await().atMost(5, TimeUnit.SECONDS).until(callbacks::size, is(1));
+
+        // Suspend 2 low priority and 2 high priority requests.
+        for (String path : List.of("/low0:0", "/low1:0", "/high0:1", "/high1:1"))
+        {
+            String[] parts = path.split(":");
+            endPoints.add(connector.executeRequest("""
+                GET %s HTTP/1.1
+                Host: localhost
+                Priority: %s
+                                
+                """.formatted(parts[0], parts[1])));
+            long suspended = endPoints.size() - 1;
+            await().atMost(5, TimeUnit.SECONDS).until(qosHandler::getSuspendedRequestCount, is(suspended));
+        }
+
+        for (int i = 0; i < endPoints.size(); ++i)
+        {
+            await().atMost(5, TimeUnit.SECONDS).until(callbacks::size, is(i + 1));
+            callbacks.get(i).succeeded();
+            HttpTester.Response response = HttpTester.parseResponse(endPoints.get(i).getResponse(false, 5, TimeUnit.SECONDS));
+            assertEquals(HttpStatus.OK_200, response.getStatus());
+        }
+
+        // With weights 1 and 2, the low priority requests are interleaved
+        // with the high priority requests rather than resumed last.
+        assertThat(paths, is(List.of("/first", "/high0", "/low0", "/high1", "/low1")));
+        assertThat(qosHandler.getSuspendStatistic(0).getCount(), is(2L));
+        assertThat(qosHandler.getSuspendStatistic(1).getCount(), is(2L));
+    }
+
+    @Test
+    public void testTargetSuspendDropsRequests() throws Exception
+    {
+        QoSHandler qosHandler = new QoSHandler();
+        qosHandler.setMaxRequestCount(1);
+        qosHandler.setTargetSuspend(Duration.ofMillis(1));
+        qosHandler.setTargetSuspendInterval(Duration.ofMillis(1));
+        List<Callback> callbacks = new CopyOnWriteArrayList<>();
+        qosHandler.setHandler(new Handler.Abstract()
+        {
+            @Override
+            public boolean handle(Request request, Response response, Callback callback)
+            {
+                callbacks.add(callback);
+                return true;
+            }
+        });
+        start(qosHandler);
+
+        List<LocalConnector.LocalEndPoint> endPoints = new ArrayList<>();
+        for (int i = 0; i < 4; ++i)
+        {
+            endPoints.add(connector.executeRequest("""
+                GET /%d HTTP/1.1
+                Host: localhost
+                                
+                """.formatted(i)));
+            if (i == 0)
+                await().atMost(5, TimeUnit.SECONDS).until(callbacks::size, is(1));
+            else
+                await().atMost(5, TimeUnit.SECONDS).until(qosHandler::getSuspendedRequestCount, is((long)i));
+        }
+
+        // Let the suspended requests exceed the target.
+        Thread.sleep(50);
+
+        // The first resumed request starts the interval above target.
+        callbacks.get(0).succeeded();
+        assertEquals(HttpStatus.OK_200, HttpTester.parseResponse(endPoints.get(0).getResponse(false, 5, TimeUnit.SECONDS)).getStatus());
+        await().atMost(5, TimeUnit.SECONDS).until(callbacks::size, is(2));
+        Thread.sleep(10);
+
+        // After the interval, the next suspended request is dropped,
+        // but the last suspended request is always resumed.
+        callbacks.get(1).succeeded();
+        assertEquals(HttpStatus.OK_200, HttpTester.parseResponse(endPoints.get(1).getResponse(false, 5, TimeUnit.SECONDS)).getStatus());
+        assertEquals(HttpStatus.SERVICE_UNAVAILABLE_503, HttpTester.parseResponse(endPoints.get(2).getResponse(false, 5, TimeUnit.SECONDS)).getStatus());
+        await().atMost(5, TimeUnit.SECONDS).until(callbacks::size, is(3));
+        callbacks.get(2).succeeded();
+        assertEquals(HttpStatus.OK_200, HttpTester.parseResponse(endPoints.get(3).getResponse(false, 5, TimeUnit.SECONDS)).getStatus());
+        assertThat(qosHandler.getDroppedRequestCount(), is(1L));
+    }
 }
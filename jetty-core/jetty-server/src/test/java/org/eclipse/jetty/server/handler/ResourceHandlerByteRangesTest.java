@@ -18,6 +18,8 @@ import java.nio.ByteBuffer;
 import java.nio.channels.SocketChannel;
 import java.nio.file.Files;
 import java.nio.file.Path;
+import java.util.Arrays;
+import java.util.concurrent.atomic.AtomicLong;
 
 import org.eclipse.jetty.http.HttpHeader;
 import org.eclipse.jetty.http.HttpHeaderValue;
@@ -28,17 +30,21 @@ import org.eclipse.jetty.http.MultiPart;
 import org.eclipse.jetty.http.MultiPartByteRanges;
 import org.eclipse.jetty.http.content.HttpContent;
 import org.eclipse.jetty.http.content.ResourceHttpContent;
+import org.eclipse.jetty.http.content.ResourceHttpContentFactory;
 import org.eclipse.jetty.io.ByteBufferPool;
 import org.eclipse.jetty.io.Content;
 import org.eclipse.jetty.io.IOResources;
 import org.eclipse.jetty.io.content.ByteBufferContentSource;
 import org.eclipse.jetty.server.Handler;
+import org.eclipse.jetty.server.Request;
 import org.eclipse.jetty.server.ResourceService;
+import org.eclipse.jetty.server.Response;
 import org.eclipse.jetty.server.Server;
 import org.eclipse.jetty.server.ServerConnector;
 import org.eclipse.jetty.toolchain.test.FS;
 import org.eclipse.jetty.toolchain.test.MavenTestingUtils;
 import org.eclipse.jetty.util.BufferUtil;
+import org.eclipse.jetty.util.Callback;
 import org.eclipse.jetty.util.component.LifeCycle;
 import org.eclipse.jetty.util.resource.FileSystemPool;
 import org.eclipse.jetty.util.resource.Resource;
@@ -54,6 +60,7 @@ import org.junit.jupiter.params.provider.ValueSource;
 import static org.hamcrest.MatcherAssert.assertThat;
 import static org.hamcrest.Matchers.empty;
 import static org.hamcrest.Matchers.startsWith;
+import static org.junit.jupiter.api.Assertions.assertArrayEquals;
 import static org.junit.jupiter.api.Assertions.assertEquals;
 import static org.junit.jupiter.api.Assertions.assertNotNull;
 
@@ -350,6 +357,125 @@ public class ResourceHandlerByteRangesTest
         }
     }
 
+    @ParameterizedTest
+    @ValueSource(booleans = {true, false})
+    public void testLargeFileRangeTransfer(boolean fileTransfer) throws Exception
+    {
+        Path dir = MavenTestingUtils.getTargetTestingPath(ResourceHandlerByteRangesTest.class.getSimpleName());
+        Path largeFile = dir.resolve("large.bin");
+        byte[] bytes = new byte[4 * 1024 * 1024 + 17];
+        for (int i = 0; i < bytes.length; i++)
+        {
+            bytes[i] = (byte)rangeChars.charAt(i % rangeChars.length());
+        }
+        Files.write(largeFile, bytes);
+
+        ResourceHandler handler = new ResourceHandler()
+        {
+            @Override
+            protected HttpContent.Factory newHttpContentFactory()
+            {
+                // Do not cache, so that the content is written from the file.
+                return new ResourceHttpContentFactory(getBaseResource(), getMimeTypes());
+            }
+        };
+        handler.setBaseResource(ResourceFactory.of(handler).newResource(dir));
+        handler.setFileTransfer(fileTransfer);
+        changeHandler(handler);
+
+        try (SocketChannel socket = SocketChannel.open(new InetSocketAddress("localhost", connector.getLocalPort())))
+        {
+            socket.write(BufferUtil.toBuffer("""
+                GET /large.bin HTTP/1.1\r
+                Host: local\r
+                \r
+                GET /large.bin HTTP/1.1\r
+                Host: local\r
+                Range: bytes=1000000-3000000\r
+                Connection: close\r
+                \r
+                """));
+
+            HttpTester.Input input = HttpTester.from(socket);
+            HttpTester.Response response = HttpTester.parseResponse(input);
+            assertNotNull(response);
+            assertEquals(HttpStatus.OK_200, response.getStatus());
+            assertArrayEquals(bytes, response.getContentBytes());
+
+            response = HttpTester.parseResponse(input);
+            assertNotNull(response);
+            assertEquals(HttpStatus.PARTIAL_CONTENT_206, response.getStatus());
+            assertEquals("bytes 1000000-3000000/" + bytes.length, response.get(HttpHeader.CONTENT_RANGE));
+            assertArrayEquals(Arrays.copyOfRange(bytes, 1000000, 3000001), response.getContentBytes());
+        }
+    }
+
+    @ParameterizedTest
+    @ValueSource(booleans = {true, false})
+    public void testFileTransferInsideContextHandler(boolean fileTransfer) throws Exception
+    {
+        Path dir = MavenTestingUtils.getTargetTestingPath(ResourceHandlerByteRangesTest.class.getSimpleName());
+        Path largeFile = dir.resolve("large.bin");
+        byte[] bytes = new byte[1024 * 1024];
+        Arrays.fill(bytes, (byte)'x');
+        Files.write(largeFile, bytes);
+
+        ResourceHandler resourceHandler = new ResourceHandler()
+        {
+            @Override
+            protected HttpContent.Factory newHttpContentFactory()
+            {
+                // Do not cache, so that the content is written from the file.
+                return new ResourceHttpContentFactory(getBaseResource(), getMimeTypes());
+            }
+        };
+        resourceHandler.setBaseResource(ResourceFactory.of(resourceHandler).newResource(dir));
+        resourceHandler.setFileTransfer(fileTransfer);
+
+        // Records the content written through Response.write(), which a file transfer bypasses.
+        AtomicLong written = new AtomicLong();
+        Handler.Wrapper recorder = new Handler.Wrapper(resourceHandler)
+        {
+            @Override
+            public boolean handle(Request request, Response response, Callback callback) throws Exception
+            {
+                Response wrapped = new Response.Wrapper(request, response)
+                {
+                    @Override
+                    public boolean isContentPassThrough()
+                    {
+                        return true;
+                    }
+
+                    @Override
+                    public void write(boolean last, ByteBuffer byteBuffer, Callback callback)
+                    {
+                        written.addAndGet(BufferUtil.length(byteBuffer));
+                        super.write(last, byteBuffer, callback);
+                    }
+                };
+                return super.handle(request, wrapped, callback);
+            }
+        };
+        changeHandler(new ContextHandler(recorder, "/ctx"));
+
+        try (SocketChannel socket = SocketChannel.open(new InetSocketAddress("localhost", connector.getLocalPort())))
+        {
+            socket.write(BufferUtil.toBuffer("""
+                GET /ctx/large.bin HTTP/1.1\r
+                Host: local\r
+                Connection: close\r
+                \r
+                """));
+
+            HttpTester.Response response = HttpTester.parseResponse(HttpTester.from(socket));
+            assertNotNull(response);
+            assertEquals(HttpStatus.OK_200, response.getStatus());
+            assertArrayEquals(bytes, response.getContentBytes());
+        }
+        assertEquals(fileTransfer ? 0 : bytes.length, written.get());
+    }
+
     @Test
     public void testTwoRanges() throws Exception
     {
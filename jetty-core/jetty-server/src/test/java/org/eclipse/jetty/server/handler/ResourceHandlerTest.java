@@ -93,7 +93,9 @@ import static org.hamcrest.Matchers.containsString;
 import static org.hamcrest.Matchers.empty;
 import static org.hamcrest.Matchers.endsWith;
 import static org.hamcrest.Matchers.equalTo;
+import static org.hamcrest.Matchers.greaterThan;
 import static org.hamcrest.Matchers.is;
+import static org.hamcrest.Matchers.lessThanOrEqualTo;
 import static org.hamcrest.Matchers.not;
 import static org.hamcrest.Matchers.notNullValue;
 import static org.hamcrest.Matchers.nullValue;
@@ -1344,6 +1346,54 @@ public class ResourceHandlerTest
         assertThat(contentFactory.getCachedSize(), is(oneOf(expectedSizeBig, expectedSizeSimple)));
     }
 
+    @Test
+    public void testCachingScanResistant() throws Exception
+    {
+        int maxCachedFiles = 4;
+        int scanned = 20;
+        Files.writeString(docRoot.resolve("hot.txt"), "hot text", UTF_8);
+        for (int i = 0; i < scanned; i++)
+        {
+            Files.writeString(docRoot.resolve("scan" + i + ".txt"), "scan text " + i, UTF_8);
+        }
+        CachingHttpContentFactory contentFactory = (CachingHttpContentFactory)_rootResourceHandler.getHttpContentFactory();
+        contentFactory.setMaxCachedFiles(maxCachedFiles);
+
+        String hotRequest = """
+            GET /context/hot.txt HTTP/1.1\r
+            Host: local\r
+            Connection: close\r
+            \r
+            """;
+        for (int i = 0; i < 10; i++)
+        {
+            HttpTester.Response response = HttpTester.parseResponse(_local.getResponse(hotRequest));
+            assertThat(response.getStatus(), is(HttpStatus.OK_200));
+            assertThat(response.getContent(), equalTo("hot text"));
+        }
+
+        // A scan of paths accessed only once must not evict the frequently accessed path.
+        for (int i = 0; i < scanned; i++)
+        {
+            HttpTester.Response response = HttpTester.parseResponse(_local.getResponse("""
+                GET /context/scan%d.txt HTTP/1.1\r
+                Host: local\r
+                Connection: close\r
+                \r
+                """.formatted(i)));
+            assertThat(response.getStatus(), is(HttpStatus.OK_200));
+            assertThat(response.getContent(), equalTo("scan text " + i));
+        }
+
+        assertThat(contentFactory.getCachedFiles(), lessThanOrEqualTo(maxCachedFiles));
+        assertThat(contentFactory.getAdmissionRejects(), greaterThan(0L));
+
+        long hits = contentFactory.getCacheHits();
+        HttpTester.Response response = HttpTester.parseResponse(_local.getResponse(hotRequest));
+        assertThat(response.getStatus(), is(HttpStatus.OK_200));
+        assertThat(contentFactory.getCacheHits(), greaterThan(hits));
+    }
+
     @Test
     public void testCachingNotFoundNotCached() throws Exception
     {
@@ -241,6 +241,36 @@ public class StatisticsHandlerTest
         assertThat(exceptionRef.get().getMessage(), startsWith("write rate is too low"));
     }
 
+    @Test
+    public void testRequestAndResponseSizes() throws Exception
+    {
+        AtomicReference<String> content = new AtomicReference<>();
+        _statsHandler.setHandler(new Handler.Abstract()
+        {
+            @Override
+            public boolean handle(Request request, Response response, Callback callback) throws Exception
+            {
+                content.set(Content.Source.asString(request));
+                response.write(true, ByteBuffer.wrap("hello world".getBytes(StandardCharsets.UTF_8)), callback);
+                return true;
+            }
+        });
+        _server.start();
+
+        String request = """
+            POST / HTTP/1.1\r
+            Host: localhost\r
+            Content-Length: 5\r
+            \r
+            abcde""";
+        String response = _connector.getResponse(request);
+        assertThat(response, startsWith("HTTP/1.1 200 "));
+        assertThat(content.get(), is("abcde"));
+
+        await().atMost(5, TimeUnit.SECONDS).until(_statsHandler::getRequestSizeMax, equalTo(5L));
+        await().atMost(5, TimeUnit.SECONDS).until(_statsHandler::getResponseSizeMax, equalTo(11L));
+    }
+
     @Test
     public void testTwoRequestsSerially() throws Exception
     {
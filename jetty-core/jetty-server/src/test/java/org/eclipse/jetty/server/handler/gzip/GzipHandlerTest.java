@@ -71,6 +71,7 @@ import org.eclipse.jetty.util.Fields;
 import org.eclipse.jetty.util.IO;
 import org.eclipse.jetty.util.StringUtil;
 import org.eclipse.jetty.util.component.LifeCycle;
+import org.eclipse.jetty.util.compression.DeflateCompression;
 import org.hamcrest.MatcherAssert;
 import org.hamcrest.Matchers;
 import org.junit.jupiter.api.AfterEach;
@@ -301,6 +302,70 @@ public class GzipHandlerTest
         assertEquals(CONTENT, testOut.toString(StandardCharsets.UTF_8));
     }
 
+    @ParameterizedTest
+    @ValueSource(strings = {"gzip;q=0.5, deflate", "deflate, gzip", "gzip, deflate", "deflate;q=0.5, gzip"})
+    public void testNegotiatedCompression(String acceptEncoding) throws Exception
+    {
+        _gzipHandler.addCompression(new DeflateCompression());
+        _contextHandler.setHandler(new TestHandler());
+        _server.start();
+
+        HttpTester.Request request = HttpTester.newRequest();
+        request.setMethod("GET");
+        request.setURI("/ctx/content");
+        request.setVersion("HTTP/1.0");
+        request.setHeader("Host", "tester");
+        request.setHeader("accept-encoding", acceptEncoding);
+
+        HttpTester.Response response = HttpTester.parseResponse(_connector.getResponse(request.generate()));
+
+        assertThat(response.getStatus(), is(200));
+        // Configured compressions are preferred over gzip for equal qualities.
+        boolean deflate = !acceptEncoding.startsWith("deflate;q=0.5");
+        String encoding = deflate ? "deflate" : "gzip";
+        assertThat(response.get("Content-Encoding"), is(encoding));
+        assertThat(response.get("ETag"), is(String.format("W/\"%x" + new CompressedContentFormat(encoding, null).getEtagSuffix() + "\"", CONTENT.hashCode())));
+
+        ByteArrayInputStream compressed = new ByteArrayInputStream(response.getContentBytes());
+        InputStream testIn = deflate ? new InflaterInputStream(compressed) : new GZIPInputStream(compressed);
+        ByteArrayOutputStream testOut = new ByteArrayOutputStream();
+        IO.copy(testIn, testOut);
+        assertEquals(CONTENT, testOut.toString(StandardCharsets.UTF_8));
+    }
+
+    @ParameterizedTest
+    @ValueSource(strings = {"deflate;q=0, *", "DEFLATE;q=0, *;q=0.5", "*, deflate;q=0", "gzip;q=0, deflate;q=0, *"})
+    public void testWildcardDoesNotMatchExcludedCompression(String acceptEncoding) throws Exception
+    {
+        _gzipHandler.addCompression(new DeflateCompression());
+        _contextHandler.setHandler(new TestHandler());
+        _server.start();
+
+        HttpTester.Request request = HttpTester.newRequest();
+        request.setMethod("GET");
+        request.setURI("/ctx/content");
+        request.setVersion("HTTP/1.0");
+        request.setHeader("Host", "tester");
+        request.setHeader("accept-encoding", acceptEncoding);
+
+        HttpTester.Response response = HttpTester.parseResponse(_connector.getResponse(request.generate()));
+
+        assertThat(response.getStatus(), is(200));
+        // The wildcard only matches the codings that are not explicitly listed.
+        if (acceptEncoding.startsWith("gzip;q=0"))
+        {
+            assertNull(response.get("Content-Encoding"));
+            assertEquals(CONTENT, response.getContent());
+        }
+        else
+        {
+            assertThat(response.get("Content-Encoding"), is("gzip"));
+            ByteArrayOutputStream testOut = new ByteArrayOutputStream();
+            IO.copy(new GZIPInputStream(new ByteArrayInputStream(response.getContentBytes())), testOut);
+            assertEquals(CONTENT, testOut.toString(StandardCharsets.UTF_8));
+        }
+    }
+
     /**
      * Test a HEAD request (that is not processed by GZIP) then a GET request (which is compressed)
      */
@@ -24,12 +24,21 @@ import java.sql.PreparedStatement;
 import java.sql.ResultSet;
 import java.sql.SQLException;
 import java.sql.Statement;
+import java.util.ArrayList;
 import java.util.HashSet;
+import java.util.LinkedHashMap;
+import java.util.List;
+import java.util.Map;
 import java.util.Set;
+import java.util.concurrent.TimeUnit;
 
+import org.eclipse.jetty.util.NanoTime;
 import org.eclipse.jetty.util.StringUtil;
 import org.eclipse.jetty.util.annotation.ManagedAttribute;
 import org.eclipse.jetty.util.annotation.ManagedObject;
+import org.eclipse.jetty.util.thread.AutoLock;
+import org.eclipse.jetty.util.thread.ScheduledExecutorScheduler;
+import org.eclipse.jetty.util.thread.Scheduler;
 import org.slf4j.Logger;
 import org.slf4j.LoggerFactory;
 
@@ -37,6 +46,13 @@ import org.slf4j.LoggerFactory;
  * JDBCSessionDataStore
  *
  * Session data stored in database
+ * <p>
+ * By default every store is written to the database before returning.
+ * With a non zero {@link #setWriteBehindMs(long) write behind} period,
+ * stores are instead queued and coalesced per session id, and the queue
+ * is flushed as JDBC batches at the end of the period. Loads, existence
+ * and expiry checks flush the queued stores first, so that they always
+ * observe the latest stored state.
  */
 @ManagedObject
 public class JDBCSessionDataStore extends ObjectStreamSessionDataStore
@@ -52,6 +68,17 @@ public class JDBCSessionDataStore extends ObjectStreamSessionDataStore
     protected DatabaseAdaptor _dbAdaptor;
     protected SessionTableSchema _sessionTableSchema;
     protected boolean _schemaProvided;
+    protected long _writeBehindMs = 0;
+    protected boolean _partialUpdates = false;
+    protected int _expiryPageSize = 0;
+
+    private final AutoLock _lock = new AutoLock();
+    private final AutoLock _flushLock = new AutoLock();
+    private final Map<String, PendingStore> _pendingStores = new LinkedHashMap<>();
+    private Scheduler _scheduler;
+    private Scheduler.Task _flushTask;
+    private volatile long _lastFlushLag;
+    private volatile long _maxFlushLag;
 
     private static final ByteArrayInputStream EMPTY = new ByteArrayInputStream(new byte[0]);
 
@@ -312,14 +339,31 @@ public class JDBCSessionDataStore extends ObjectStreamSessionDataStore
                 " values (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)";
         }
 
-        public PreparedStatement getUpdateSessionStatement(Connection connection, String id, SessionContext context)
-            throws SQLException
+        public String getUpdateSessionStatementAsString()
         {
-            String s = "update " + getSchemaTableName() +
+            return "update " + getSchemaTableName() +
                 " set " + getLastNodeColumn() + " = ?, " + getAccessTimeColumn() + " = ?, " +
                 getLastAccessTimeColumn() + " = ?, " + getLastSavedTimeColumn() + " = ?, " + getExpiryTimeColumn() + " = ?, " +
                 getMaxIntervalColumn() + " = ?, " + getMapColumn() + " = ? where " + getIdColumn() + " = ? and " + getContextPathColumn() +
                 " = ? and " + getVirtualHostColumn() + " = ?";
+        }
+
+        /**
+         * @return the update statement that leaves the attribute map column untouched
+         */
+        public String getUpdateSessionMetaDataStatementAsString()
+        {
+            return "update " + getSchemaTableName() +
+                " set " + getLastNodeColumn() + " = ?, " + getAccessTimeColumn() + " = ?, " +
+                getLastAccessTimeColumn() + " = ?, " + getLastSavedTimeColumn() + " = ?, " + getExpiryTimeColumn() + " = ?, " +
+                getMaxIntervalColumn() + " = ? where " + getIdColumn() + " = ? and " + getContextPathColumn() +
+                " = ? and " + getVirtualHostColumn() + " = ?";
+        }
+
+        public PreparedStatement getUpdateSessionStatement(Connection connection, String id, SessionContext context)
+            throws SQLException
+        {
+            String s = getUpdateSessionStatementAsString();
 
             String cp = context.getCanonicalContextPath();
             if (_dbAdaptor.isEmptyStringNull() && StringUtil.isBlank(cp))
@@ -355,6 +399,50 @@ public class JDBCSessionDataStore extends ObjectStreamSessionDataStore
             return statement;
         }
 
+        /**
+         * Get a statement that selects one page of the sessions for the context that expired
+         * at or before the given time, ordered by expiry time and id. The page starts after
+         * the given expiry time and id, so that successive pages are selected by keyset
+         * rather than by offset.
+         *
+         * @param connection the connection to the database
+         * @param canonicalContextPath the canonical context path
+         * @param vhost the virtual host
+         * @param expiry the upper limit of the expiry times
+         * @param afterExpiry the expiry time of the last session of the previous page, or 0
+         * @param afterId the id of the last session of the previous page, or the empty string
+         * @param pageSize the max number of sessions in the page
+         * @return the statement
+         * @throws SQLException if unable to prepare the statement
+         */
+        public PreparedStatement getExpiredSessionsPageStatement(Connection connection, String canonicalContextPath, String vhost, long expiry,
+                                                                 long afterExpiry, String afterId, int pageSize)
+            throws SQLException
+        {
+            if (_dbAdaptor == null)
+                throw new IllegalStateException("No DB adaptor");
+
+            String cp = canonicalContextPath;
+            if (_dbAdaptor.isEmptyStringNull() && StringUtil.isBlank(cp))
+                cp = NULL_CONTEXT_PATH;
+
+            PreparedStatement statement = connection.prepareStatement("select " + getIdColumn() + ", " + getExpiryTimeColumn() +
+                " from " + getSchemaTableName() + " where " + getContextPathColumn() + " = ? and " +
+                getVirtualHostColumn() + " = ? and " +
+                getExpiryTimeColumn() + " >0 and " + getExpiryTimeColumn() + " <= ? and (" +
+                getExpiryTimeColumn() + " > ? or (" + getExpiryTimeColumn() + " = ? and " + getIdColumn() + " > ?))" +
+                " order by " + getExpiryTimeColumn() + ", " + getIdColumn());
+
+            statement.setString(1, cp);
+            statement.setString(2, vhost);
+            statement.setLong(3, expiry);
+            statement.setLong(4, afterExpiry);
+            statement.setLong(5, afterExpiry);
+            statement.setString(6, afterId);
+            statement.setMaxRows(pageSize);
+            return statement;
+        }
+
         public PreparedStatement getMyExpiredSessionsStatement(Connection connection, SessionContext sessionContext, long expiry)
             throws SQLException
         {
@@ -431,11 +519,7 @@ public class JDBCSessionDataStore extends ObjectStreamSessionDataStore
             if (_dbAdaptor.isEmptyStringNull() && StringUtil.isBlank(cp))
                 cp = NULL_CONTEXT_PATH;
 
-            String s = "update " + getSchemaTableName() +
-                " set " + getLastNodeColumn() + " = ?, " + getAccessTimeColumn() + " = ?, " +
-                getLastAccessTimeColumn() + " = ?, " + getLastSavedTimeColumn() + " = ?, " + getExpiryTimeColumn() + " = ?, " +
-                getMaxIntervalColumn() + " = ?, " + getMapColumn() + " = ? where " + getIdColumn() + " = ? and " + getContextPathColumn() +
-                " = ? and " + getVirtualHostColumn() + " = ?";
+            String s = getUpdateSessionStatementAsString();
 
             PreparedStatement statement = connection.prepareStatement(s);
             statement.setString(8, id);
@@ -608,6 +692,12 @@ public class JDBCSessionDataStore extends ObjectStreamSessionDataStore
         if (_dbAdaptor == null)
             throw new IllegalStateException("No jdbc config");
 
+        if (_writeBehindMs > 0)
+        {
+            _scheduler = new ScheduledExecutorScheduler(String.format("Session-WriteBehind-%x", hashCode()), false);
+            addBean(_scheduler, true);
+        }
+
         initialize();
         super.doStart();
     }
@@ -615,7 +705,27 @@ public class JDBCSessionDataStore extends ObjectStreamSessionDataStore
     @Override
     protected void doStop() throws Exception
     {
+        try
+        {
+            flush();
+        }
+        catch (Exception e)
+        {
+            LOG.warn("Unable to flush {} queued session stores", getPendingStoreCount(), e);
+        }
+
         super.doStop();
+
+        try (AutoLock l = _lock.lock())
+        {
+            _pendingStores.clear();
+            _flushTask = null;
+        }
+        if (_scheduler != null)
+        {
+            removeBean(_scheduler);
+            _scheduler = null;
+        }
         _initialized = false;
         if (!_schemaProvided)
             _sessionTableSchema = null;
@@ -643,6 +753,8 @@ public class JDBCSessionDataStore extends ObjectStreamSessionDataStore
     @Override
     public SessionData doLoad(String id) throws Exception
     {
+        flush(id);
+
         try (Connection connection = _dbAdaptor.getConnection();
              PreparedStatement statement = _sessionTableSchema.getLoadStatement(connection, id, _context);
              ResultSet result = statement.executeQuery())
@@ -683,6 +795,23 @@ public class JDBCSessionDataStore extends ObjectStreamSessionDataStore
 
     @Override
     public boolean delete(String id) throws Exception
+    {
+        if (_writeBehindMs <= 0)
+            return doDelete(id);
+
+        // Prevent a concurrent flush from writing the session after the delete.
+        try (AutoLock fl = _flushLock.lock())
+        {
+            boolean pending;
+            try (AutoLock l = _lock.lock())
+            {
+                pending = _pendingStores.remove(id) != null;
+            }
+            return doDelete(id) || pending;
+        }
+    }
+
+    private boolean doDelete(String id) throws Exception
     {
         try (Connection connection = _dbAdaptor.getConnection();
              PreparedStatement statement = _sessionTableSchema.getDeleteStatement(connection, id, _context))
@@ -702,10 +831,22 @@ public class JDBCSessionDataStore extends ObjectStreamSessionDataStore
         if (data == null || id == null)
             return;
 
-        if (lastSaveTime <= 0)
+        if (_writeBehindMs > 0)
+        {
+            // Serialize now, as the session may be modified before the flush.
+            boolean insert = lastSaveTime <= 0;
+            byte[] attributes = (insert || !_partialUpdates || data.isDirty()) ? serializeAttributes(data) : null;
+            enqueue(new PendingStore(id, insert, data.getLastNode(), data.getAccessed(), data.getLastAccessed(), data.getCreated(),
+                data.getCookieSet(), data.getLastSaved(), data.getExpiry(), data.getMaxInactiveMs(), attributes, NanoTime.now()));
+        }
+        else if (lastSaveTime <= 0)
         {
             doInsert(id, data);
         }
+        else if (_partialUpdates && !data.isDirty())
+        {
+            doUpdateMetaData(id, data);
+        }
         else
         {
             doUpdate(id, data);
@@ -790,11 +931,243 @@ public class JDBCSessionDataStore extends ObjectStreamSessionDataStore
         }
     }
 
+    /**
+     * Update the session metadata, leaving the attribute map untouched.
+     *
+     * @param id the session id
+     * @param data the session data
+     * @throws Exception if unable to update the session
+     */
+    protected void doUpdateMetaData(String id, SessionData data)
+        throws Exception
+    {
+        try (Connection connection = _dbAdaptor.getConnection())
+        {
+            connection.setAutoCommit(true);
+            try (PreparedStatement statement = connection.prepareStatement(_sessionTableSchema.getUpdateSessionMetaDataStatementAsString()))
+            {
+                statement.setString(1, data.getLastNode()); //should be my node id
+                statement.setLong(2, data.getAccessed()); //accessTime
+                statement.setLong(3, data.getLastAccessed()); //lastAccessTime
+                statement.setLong(4, data.getLastSaved()); //last saved time
+                statement.setLong(5, data.getExpiry());
+                statement.setLong(6, data.getMaxInactiveMs());
+                statement.setString(7, id);
+                statement.setString(8, getContextPathValue());
+                statement.setString(9, _context.getVhost());
+
+                statement.executeUpdate();
+
+                if (LOG.isDebugEnabled())
+                    LOG.debug("Updated session metadata {}", data);
+            }
+        }
+    }
+
+    /**
+     * Write the queued session stores to the database as JDBC batches.
+     * <p>
+     * If the write fails, the stores are queued again, unless they have
+     * been superseded by more recent stores of the same sessions.
+     *
+     * @throws Exception if unable to write the queued session stores
+     */
+    public void flush() throws Exception
+    {
+        try (AutoLock fl = _flushLock.lock())
+        {
+            List<PendingStore> stores;
+            try (AutoLock l = _lock.lock())
+            {
+                if (_pendingStores.isEmpty())
+                    return;
+                stores = new ArrayList<>(_pendingStores.values());
+                _pendingStores.clear();
+            }
+            write(stores);
+        }
+    }
+
+    private void flush(String id) throws Exception
+    {
+        if (_writeBehindMs <= 0)
+            return;
+
+        // Taking the flush lock also waits for a concurrent flush of the session.
+        try (AutoLock fl = _flushLock.lock())
+        {
+            PendingStore store;
+            try (AutoLock l = _lock.lock())
+            {
+                store = _pendingStores.remove(id);
+            }
+            if (store != null)
+                write(List.of(store));
+        }
+    }
+
+    private void flushQuietly()
+    {
+        try
+        {
+            flush();
+        }
+        catch (Exception e)
+        {
+            LOG.warn("Unable to flush queued session stores", e);
+        }
+    }
+
+    private void enqueue(PendingStore store)
+    {
+        try (AutoLock l = _lock.lock())
+        {
+            _pendingStores.merge(store.id(), store, PendingStore::coalesce);
+            if (_flushTask == null)
+                _flushTask = _scheduler.schedule(this::onFlushTimeout, _writeBehindMs, TimeUnit.MILLISECONDS);
+        }
+        if (LOG.isDebugEnabled())
+            LOG.debug("Queued store of session {}", store.id());
+    }
+
+    private void onFlushTimeout()
+    {
+        try (AutoLock l = _lock.lock())
+        {
+            _flushTask = null;
+        }
+        _context.run(this::flushQuietly);
+    }
+
+    private void write(List<PendingStore> stores) throws Exception
+    {
+        long oldest = stores.stream().mapToLong(PendingStore::queued).min().orElseThrow();
+        try
+        {
+            try (Connection connection = _dbAdaptor.getConnection())
+            {
+                connection.setAutoCommit(false);
+                try (PreparedStatement inserts = connection.prepareStatement(_sessionTableSchema.getInsertSessionStatementAsString());
+                     PreparedStatement updates = connection.prepareStatement(_sessionTableSchema.getUpdateSessionStatementAsString());
+                     PreparedStatement metaDataUpdates = connection.prepareStatement(_sessionTableSchema.getUpdateSessionMetaDataStatementAsString()))
+                {
+                    int insertCount = 0;
+                    int updateCount = 0;
+                    int metaDataUpdateCount = 0;
+                    String cp = getContextPathValue();
+                    String vhost = _context.getVhost();
+                    for (PendingStore store : stores)
+                    {
+                        if (store.insert())
+                        {
+                            inserts.setString(1, store.id());
+                            inserts.setString(2, cp);
+                            inserts.setString(3, vhost);
+                            inserts.setString(4, store.lastNode());
+                            inserts.setLong(5, store.accessed());
+                            inserts.setLong(6, store.lastAccessed());
+                            inserts.setLong(7, store.created());
+                            inserts.setLong(8, store.cookieSet());
+                            inserts.setLong(9, store.lastSaved());
+                            inserts.setLong(10, store.expiry());
+                            inserts.setLong(11, store.maxInactiveMs());
+                            inserts.setBinaryStream(12, new ByteArrayInputStream(store.attributes()), store.attributes().length);
+                            inserts.addBatch();
+                            ++insertCount;
+                        }
+                        else
+                        {
+                            PreparedStatement statement = store.attributes() == null ? metaDataUpdates : updates;
+                            statement.setString(1, store.lastNode());
+                            statement.setLong(2, store.accessed());
+                            statement.setLong(3, store.lastAccessed());
+                            statement.setLong(4, store.lastSaved());
+                            statement.setLong(5, store.expiry());
+                            statement.setLong(6, store.maxInactiveMs());
+                            int index = 7;
+                            if (store.attributes() == null)
+                            {
+                                ++metaDataUpdateCount;
+                            }
+                            else
+                            {
+                                statement.setBinaryStream(index++, new ByteArrayInputStream(store.attributes()), store.attributes().length);
+                                ++updateCount;
+                            }
+                            statement.setString(index++, store.id());
+                            statement.setString(index++, cp);
+                            statement.setString(index, vhost);
+                            statement.addBatch();
+                        }
+                    }
+
+                    if (insertCount > 0)
+                        inserts.executeBatch();
+                    if (updateCount > 0)
+                        updates.executeBatch();
+                    if (metaDataUpdateCount > 0)
+                        metaDataUpdates.executeBatch();
+                    connection.commit();
+
+                    if (LOG.isDebugEnabled())
+                        LOG.debug("Flushed {} inserts, {} updates, {} metadata updates", insertCount, updateCount, metaDataUpdateCount);
+                }
+                catch (Exception e)
+                {
+                    connection.rollback();
+                    throw e;
+                }
+            }
+        }
+        catch (Exception e)
+        {
+            requeue(stores);
+            throw e;
+        }
+
+        long lag = NanoTime.millisSince(oldest);
+        _lastFlushLag = lag;
+        if (lag > _maxFlushLag)
+            _maxFlushLag = lag;
+    }
+
+    private void requeue(List<PendingStore> stores)
+    {
+        try (AutoLock l = _lock.lock())
+        {
+            for (PendingStore store : stores)
+            {
+                _pendingStores.merge(store.id(), store, (newer, failed) -> failed.coalesce(newer));
+            }
+            if (_flushTask == null && _scheduler != null && _scheduler.isRunning())
+                _flushTask = _scheduler.schedule(this::onFlushTimeout, _writeBehindMs, TimeUnit.MILLISECONDS);
+        }
+    }
+
+    private byte[] serializeAttributes(SessionData data) throws Exception
+    {
+        try (ByteArrayOutputStream baos = new ByteArrayOutputStream())
+        {
+            serializeAttributes(data, baos);
+            return baos.toByteArray();
+        }
+    }
+
+    private String getContextPathValue()
+    {
+        String cp = _context.getCanonicalContextPath();
+        if (_dbAdaptor.isEmptyStringNull() && StringUtil.isBlank(cp))
+            cp = NULL_CONTEXT_PATH;
+        return cp;
+    }
+
     @Override
     public Set<String> doCheckExpired(Set<String> candidates, long time)
     {
         if (LOG.isDebugEnabled())
             LOG.debug("Getting expired sessions at time {}", time);
+
+        flushQuietly();
         
         Set<String> expiredSessionKeys = new HashSet<>();
         try (Connection connection = _dbAdaptor.getConnection())
@@ -876,6 +1249,11 @@ public class JDBCSessionDataStore extends ObjectStreamSessionDataStore
     @Override
     public Set<String> doGetExpired(long timeLimit)
     {
+        flushQuietly();
+
+        if (_expiryPageSize > 0)
+            return doGetExpiredByPage(timeLimit);
+
         Set<String> expired = new HashSet<>();
         
         //Get sessions for my context but managed by any node that expired at or before the timeLimit   
@@ -910,6 +1288,49 @@ public class JDBCSessionDataStore extends ObjectStreamSessionDataStore
         } 
     }
 
+    private Set<String> doGetExpiredByPage(long timeLimit)
+    {
+        Set<String> expired = new HashSet<>();
+
+        //Get sessions for my context but managed by any node that expired at or before the timeLimit,
+        //one page at a time to bound the size of each result set
+        try (Connection connection = _dbAdaptor.getConnection())
+        {
+            connection.setAutoCommit(true);
+            if (LOG.isDebugEnabled())
+                LOG.debug("{}- Searching by pages of {} for sessions for context {} expired before {}", _context.getWorkerName(), _expiryPageSize, _context.getCanonicalContextPath(), timeLimit);
+
+            long afterExpiry = 0;
+            String afterId = "";
+            while (true)
+            {
+                int rows = 0;
+                try (PreparedStatement selectExpiredSessions = _sessionTableSchema.getExpiredSessionsPageStatement(connection, _context.getCanonicalContextPath(),
+                    _context.getVhost(), timeLimit, afterExpiry, afterId, _expiryPageSize);
+                     ResultSet result = selectExpiredSessions.executeQuery())
+                {
+                    while (result.next())
+                    {
+                        ++rows;
+                        afterId = result.getString(_sessionTableSchema.getIdColumn());
+                        afterExpiry = result.getLong(_sessionTableSchema.getExpiryTimeColumn());
+                        expired.add(afterId);
+                        if (LOG.isDebugEnabled())
+                            LOG.debug("{}- Found expired sessionId={} for context={} expiry={}",
+                                _context.getWorkerName(), afterId, _context.getCanonicalContextPath(), afterExpiry);
+                    }
+                }
+                if (rows < _expiryPageSize)
+                    return expired;
+            }
+        }
+        catch (Exception e)
+        {
+            LOG.warn("Error finding sessions expired before {}", timeLimit, e);
+            return expired; //return whatever we got
+        }
+    }
+
     @Override
     public void doCleanOrphans(long time)
     {
@@ -950,10 +1371,110 @@ public class JDBCSessionDataStore extends ObjectStreamSessionDataStore
         return true;
     }
 
+    @ManagedAttribute(value = "ms during which stores are queued before being flushed, or 0 to store immediately", readonly = true)
+    public long getWriteBehindMs()
+    {
+        return _writeBehindMs;
+    }
+
+    /**
+     * Set the period during which stores are queued and coalesced per
+     * session id, before being flushed to the database as JDBC batches.
+     * <p>
+     * By default the value is 0, which means that every store is written
+     * to the database before returning. A non zero value trades the
+     * durability of the most recent stores, which are lost if the server
+     * crashes before they are flushed, for fewer database round trips.
+     *
+     * @param writeBehindMs the write behind period in ms, or 0 to store immediately
+     */
+    public void setWriteBehindMs(long writeBehindMs)
+    {
+        checkStarted();
+        _writeBehindMs = writeBehindMs;
+    }
+
+    @ManagedAttribute(value = "is the attribute map written only when attributes changed", readonly = true)
+    public boolean isPartialUpdates()
+    {
+        return _partialUpdates;
+    }
+
+    /**
+     * Set whether updates of sessions whose attributes did not change only
+     * write the session metadata, leaving the attribute map untouched.
+     * <p>
+     * By default the value is false, and every update serializes and writes
+     * the whole attribute map, so that changes made to mutable attribute
+     * values without calling setAttribute are also stored.
+     *
+     * @param partialUpdates true to write the attribute map only when attributes changed
+     */
+    public void setPartialUpdates(boolean partialUpdates)
+    {
+        checkStarted();
+        _partialUpdates = partialUpdates;
+    }
+
+    @ManagedAttribute(value = "max number of expired sessions selected per query, or 0 for unlimited", readonly = true)
+    public int getExpiryPageSize()
+    {
+        return _expiryPageSize;
+    }
+
+    /**
+     * Set the max number of sessions selected per query when searching
+     * for expired sessions. The search pages through the expired sessions
+     * ordered by expiry time and id, so that the cost of each query does
+     * not depend on the number of sessions already selected.
+     *
+     * @param expiryPageSize the page size, or 0 to select all the expired sessions with a single query
+     */
+    public void setExpiryPageSize(int expiryPageSize)
+    {
+        checkStarted();
+        _expiryPageSize = expiryPageSize;
+    }
+
+    @ManagedAttribute(value = "number of queued stores", readonly = true)
+    public int getPendingStoreCount()
+    {
+        try (AutoLock l = _lock.lock())
+        {
+            return _pendingStores.size();
+        }
+    }
+
+    @ManagedAttribute(value = "age in ms of the oldest queued store", readonly = true)
+    public long getWriteBehindLag()
+    {
+        try (AutoLock l = _lock.lock())
+        {
+            return _pendingStores.values().stream()
+                .mapToLong(store -> NanoTime.millisSince(store.queued()))
+                .max()
+                .orElse(0);
+        }
+    }
+
+    @ManagedAttribute(value = "age in ms of the oldest store written by the last flush", readonly = true)
+    public long getLastFlushLag()
+    {
+        return _lastFlushLag;
+    }
+
+    @ManagedAttribute(value = "max age in ms of the oldest store written by a flush", readonly = true)
+    public long getMaxFlushLag()
+    {
+        return _maxFlushLag;
+    }
+
     @Override
     public boolean doExists(String id)
         throws Exception
     {
+        flush(id);
+
         try (Connection connection = _dbAdaptor.getConnection())
         {
             connection.setAutoCommit(true);
@@ -980,4 +1501,18 @@ public class JDBCSessionDataStore extends ObjectStreamSessionDataStore
             }
         }
     }
+
+    /**
+     * A queued store, with the session attributes already serialized,
+     * or null if only the session metadata needs to be written.
+     */
+    private record PendingStore(String id, boolean insert, String lastNode, long accessed, long lastAccessed, long created,
+                                long cookieSet, long lastSaved, long expiry, long maxInactiveMs, byte[] attributes, long queued)
+    {
+        private PendingStore coalesce(PendingStore newer)
+        {
+            return new PendingStore(id, insert || newer.insert, newer.lastNode, newer.accessed, newer.lastAccessed, newer.created,
+                newer.cookieSet, newer.lastSaved, newer.expiry, newer.maxInactiveMs, newer.attributes == null ? attributes : newer.attributes, queued);
+        }
+    }
 }
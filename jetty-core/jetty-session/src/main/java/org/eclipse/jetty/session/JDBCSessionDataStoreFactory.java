@@ -29,6 +29,10 @@ public class JDBCSessionDataStoreFactory extends AbstractSessionDataStoreFactory
      */
     JDBCSessionDataStore.SessionTableSchema _schema;
 
+    private long _writeBehindMs;
+    private boolean _partialUpdates;
+    private int _expiryPageSize;
+
     @Override
     public SessionDataStore getSessionDataStore(SessionManager manager)
     {
@@ -37,6 +41,9 @@ public class JDBCSessionDataStoreFactory extends AbstractSessionDataStoreFactory
         ds.setSessionTableSchema(_schema);
         ds.setGracePeriodSec(getGracePeriodSec());
         ds.setSavePeriodSec(getSavePeriodSec());
+        ds.setWriteBehindMs(getWriteBehindMs());
+        ds.setPartialUpdates(isPartialUpdates());
+        ds.setExpiryPageSize(getExpiryPageSize());
         return ds;
     }
 
@@ -57,4 +64,46 @@ public class JDBCSessionDataStoreFactory extends AbstractSessionDataStoreFactory
     {
         _schema = schema;
     }
+
+    public long getWriteBehindMs()
+    {
+        return _writeBehindMs;
+    }
+
+    /**
+     * @param writeBehindMs the write behind period in ms, or 0 to store immediately
+     * @see JDBCSessionDataStore#setWriteBehindMs(long)
+     */
+    public void setWriteBehindMs(long writeBehindMs)
+    {
+        _writeBehindMs = writeBehindMs;
+    }
+
+    public boolean isPartialUpdates()
+    {
+        return _partialUpdates;
+    }
+
+    /**
+     * @param partialUpdates true to write the attribute map only when attributes changed
+     * @see JDBCSessionDataStore#setPartialUpdates(boolean)
+     */
+    public void setPartialUpdates(boolean partialUpdates)
+    {
+        _partialUpdates = partialUpdates;
+    }
+
+    public int getExpiryPageSize()
+    {
+        return _expiryPageSize;
+    }
+
+    /**
+     * @param expiryPageSize the max number of expired sessions selected per query, or 0 for unlimited
+     * @see JDBCSessionDataStore#setExpiryPageSize(int)
+     */
+    public void setExpiryPageSize(int expiryPageSize)
+    {
+        _expiryPageSize = expiryPageSize;
+    }
 }
@@ -0,0 +1,628 @@
+//
+// ========================================================================
+// Copyright (c) 1995 Mort Bay Consulting Pty Ltd and others.
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License v. 2.0 which is available at
+// https://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+// ========================================================================
+//
+
+package org.eclipse.jetty.session;
+
+import java.io.ByteArrayInputStream;
+import java.io.ByteArrayOutputStream;
+import java.io.DataInputStream;
+import java.io.DataOutputStream;
+import java.io.IOException;
+import java.io.ObjectOutputStream;
+import java.nio.ByteBuffer;
+import java.util.HashMap;
+import java.util.HashSet;
+import java.util.Map;
+import java.util.Set;
+import java.util.concurrent.ConcurrentHashMap;
+import java.util.concurrent.ConcurrentMap;
+import java.util.concurrent.atomic.AtomicLong;
+import java.util.function.Function;
+
+import org.eclipse.jetty.io.ByteBufferInputStream;
+import org.eclipse.jetty.util.ClassLoadingObjectInputStream;
+import org.eclipse.jetty.util.annotation.ManagedAttribute;
+import org.eclipse.jetty.util.annotation.ManagedObject;
+import org.eclipse.jetty.util.annotation.ManagedOperation;
+import org.eclipse.jetty.util.thread.AutoLock;
+import org.slf4j.Logger;
+import org.slf4j.LoggerFactory;
+
+/**
+ * OffHeapSessionCache
+ *
+ * A session cache that keeps only the recently used sessions on-heap as {@link ManagedSession}s.
+ * <p>
+ * When a session is evicted, according to the eviction policy, its data is serialized into
+ * a direct (off-heap) buffer rather than just dropped, so that a subsequent request can
+ * re-activate the session without loading it from the {@link SessionDataStore}. Attribute
+ * values of a re-activated session are only deserialized when they are first accessed.
+ * This is suited to large numbers of mostly idle sessions, whose object graphs would
+ * otherwise be retained on the heap and inflate the garbage collection pauses.
+ * <p>
+ * In a cluster, the copies held by this cache become stale when another node modifies
+ * a session. An {@link InvalidationPublisher} is notified every time this node writes,
+ * deletes or renews a session, and the messages received from the other nodes must be
+ * passed to {@link #onInvalidation(String)}, which drops the local copies so that the
+ * next request loads the session from the store.
+ */
+@ManagedObject
+public class OffHeapSessionCache extends DefaultSessionCache
+{
+    private static final Logger LOG = LoggerFactory.getLogger(OffHeapSessionCache.class);
+
+    /**
+     * The serialized data of the evicted sessions, the first 8 bytes of each buffer being the expiry time
+     */
+    private final ConcurrentMap<String, ByteBuffer> _offHeap = new ConcurrentHashMap<>();
+    private final AtomicLong _offHeapBytes = new AtomicLong();
+    private long _maxOffHeapBytes = -1;
+    private InvalidationPublisher _invalidationPublisher;
+
+    /**
+     * A publisher of the ids of the sessions modified by this node,
+     * typically implemented over a cluster messaging system.
+     */
+    @FunctionalInterface
+    public interface InvalidationPublisher
+    {
+        /**
+         * @param id the id of the session that was modified, deleted or renewed by this node
+         */
+        void publish(String id);
+    }
+
+    /**
+     * @param manager The SessionHandler related to this SessionCache
+     */
+    public OffHeapSessionCache(SessionManager manager)
+    {
+        super(manager);
+    }
+
+    /**
+     * @return the number of sessions held off-heap
+     */
+    @ManagedAttribute(value = "sessions held off-heap", readonly = true)
+    public int getOffHeapSessions()
+    {
+        return _offHeap.size();
+    }
+
+    /**
+     * @return the number of bytes held off-heap
+     */
+    @ManagedAttribute(value = "bytes held off-heap", readonly = true)
+    public long getOffHeapBytes()
+    {
+        return _offHeapBytes.get();
+    }
+
+    @ManagedAttribute(value = "max bytes held off-heap, or -1 for unlimited")
+    public long getMaxOffHeapBytes()
+    {
+        return _maxOffHeapBytes;
+    }
+
+    /**
+     * @param maxOffHeapBytes the max number of bytes held off-heap, beyond which
+     * evicted sessions are only kept in the SessionDataStore, or -1 for unlimited
+     */
+    public void setMaxOffHeapBytes(long maxOffHeapBytes)
+    {
+        _maxOffHeapBytes = maxOffHeapBytes;
+    }
+
+    public InvalidationPublisher getInvalidationPublisher()
+    {
+        return _invalidationPublisher;
+    }
+
+    /**
+     * @param invalidationPublisher the publisher notified of the sessions modified by this node, or null
+     */
+    public void setInvalidationPublisher(InvalidationPublisher invalidationPublisher)
+    {
+        _invalidationPublisher = invalidationPublisher;
+    }
+
+    /**
+     * Handle a message from another node that a session was modified, deleted or renewed there.
+     * <p>
+     * The off-heap copy of the session is dropped, as is the on-heap session if it is not in use
+     * by a request, so that the next request loads the session from the SessionDataStore.
+     *
+     * @param id the id of the session modified by another node
+     */
+    @ManagedOperation(value = "drop the local copies of a session modified by another node", impact = "ACTION")
+    public void onInvalidation(String id)
+    {
+        if (id == null)
+            return;
+
+        removeOffHeap(id);
+
+        ManagedSession session = doGet(id);
+        if (session == null)
+            return;
+
+        try (AutoLock lock = session.lock())
+        {
+            if (session.getRequests() <= 0 && session.isResident())
+            {
+                if (LOG.isDebugEnabled())
+                    LOG.debug("Dropping session {} modified by another node", id);
+                doDelete(id);
+                session.setResident(false);
+            }
+        }
+    }
+
+    @Override
+    protected ManagedSession doComputeIfAbsent(String id, Function<String, ManagedSession> mappingFunction)
+    {
+        return super.doComputeIfAbsent(id, k ->
+        {
+            ManagedSession session = activate(k);
+            return session != null ? session : mappingFunction.apply(k);
+        });
+    }
+
+    @Override
+    public boolean exists(String id) throws Exception
+    {
+        //a session only held off-heap may be unknown to the SessionDataStore
+        if (doGet(id) == null)
+        {
+            ByteBuffer buffer = _offHeap.get(id);
+            if (buffer != null)
+            {
+                long expiry = buffer.getLong(0);
+                if (expiry <= 0 || expiry > System.currentTimeMillis())
+                    return true;
+            }
+        }
+        return super.exists(id);
+    }
+
+    @Override
+    public ManagedSession doDelete(String id)
+    {
+        ManagedSession session = super.doDelete(id);
+        removeOffHeap(id);
+        return session;
+    }
+
+    @Override
+    public void commit(ManagedSession session) throws Exception
+    {
+        if (session == null)
+            return;
+
+        boolean written;
+        try (AutoLock lock = session.lock())
+        {
+            boolean dirty = session.getSessionData().isDirty();
+            super.commit(session);
+            written = dirty && !session.getSessionData().isDirty();
+        }
+        if (written)
+            publish(session.getId());
+    }
+
+    @Override
+    public void release(ManagedSession session) throws Exception
+    {
+        if (session == null || session.getId() == null)
+        {
+            super.release(session);
+            return;
+        }
+
+        boolean written;
+        try (AutoLock lock = session.lock())
+        {
+            boolean dirty = session.getSessionData().isDirty();
+            super.release(session);
+            written = dirty && !session.getSessionData().isDirty();
+
+            //keep the session that was evicted on exit off-heap
+            if (!session.isResident() && session.isValid() && session.getRequests() <= 0)
+                passivate(session);
+        }
+        if (written)
+            publish(session.getId());
+    }
+
+    @Override
+    public void checkInactiveSession(ManagedSession session)
+    {
+        if (session == null)
+            return;
+
+        try (AutoLock lock = session.lock())
+        {
+            boolean resident = session.isResident();
+            super.checkInactiveSession(session);
+
+            //keep the session that was evicted for inactivity off-heap
+            if (resident && !session.isResident() && session.isValid())
+                passivate(session);
+        }
+    }
+
+    @Override
+    public ManagedSession delete(String id) throws Exception
+    {
+        ManagedSession session = super.delete(id);
+        publish(id);
+        return session;
+    }
+
+    @Override
+    protected void renewSessionId(ManagedSession session, String newId, String newExtendedId) throws Exception
+    {
+        if (session == null)
+            return;
+
+        String oldId = session.getId();
+        super.renewSessionId(session, newId, newExtendedId);
+        publish(oldId);
+    }
+
+    @Override
+    public Set<String> checkExpiration(Set<String> candidates)
+    {
+        Set<String> expired = super.checkExpiration(candidates);
+        if (!isStarted())
+            return expired;
+
+        //sessions only held off-heap, and maybe unknown to the SessionDataStore, may also have expired
+        long now = System.currentTimeMillis();
+        Set<String> result = null;
+        for (Map.Entry<String, ByteBuffer> entry : _offHeap.entrySet())
+        {
+            String id = entry.getKey();
+            long expiry = entry.getValue().getLong(0);
+            if (expiry > 0 && expiry <= now && (expired == null || !expired.contains(id)) && doGet(id) == null)
+            {
+                if (result == null)
+                    result = expired == null ? new HashSet<>() : new HashSet<>(expired);
+                result.add(id);
+            }
+        }
+        return result == null ? expired : result;
+    }
+
+    @Override
+    public void shutdown()
+    {
+        super.shutdown();
+
+        if (isInvalidateOnShutdown())
+        {
+            for (String id : _offHeap.keySet())
+            {
+                try
+                {
+                    ManagedSession session = getAndEnter(id, false);
+                    if (session != null)
+                        session.invalidate();
+                }
+                catch (Exception e)
+                {
+                    LOG.trace("IGNORED", e);
+                }
+            }
+        }
+
+        //the session data store already has the data of the sessions held off-heap
+        _offHeap.clear();
+        _offHeapBytes.set(0);
+    }
+
+    private void publish(String id)
+    {
+        InvalidationPublisher publisher = _invalidationPublisher;
+        if (publisher == null || id == null)
+            return;
+        try
+        {
+            publisher.publish(id);
+        }
+        catch (Throwable x)
+        {
+            LOG.warn("Unable to publish invalidation of session {}", id, x);
+        }
+    }
+
+    private void removeOffHeap(String id)
+    {
+        ByteBuffer buffer = _offHeap.remove(id);
+        if (buffer != null)
+            _offHeapBytes.addAndGet(-buffer.capacity());
+    }
+
+    /**
+     * Atomically account for the given number of bytes, unless that would exceed the max off-heap bytes.
+     *
+     * @param bytes the number of bytes to hold off-heap
+     * @return whether the bytes have been accounted for
+     */
+    private boolean reserveOffHeap(long bytes)
+    {
+        long max = getMaxOffHeapBytes();
+        if (max < 0)
+        {
+            _offHeapBytes.addAndGet(bytes);
+            return true;
+        }
+        while (true)
+        {
+            long held = _offHeapBytes.get();
+            if (held + bytes > max)
+                return false;
+            if (_offHeapBytes.compareAndSet(held, held + bytes))
+                return true;
+        }
+    }
+
+    /**
+     * Serialize the data of an evicted session into an off-heap buffer.
+     *
+     * @param session the session evicted from the on-heap cache
+     */
+    private void passivate(ManagedSession session)
+    {
+        String id = session.getId();
+        //drop the copy from a previous eviction first: it is stale if this session could not
+        //be held off-heap again, and its bytes must not count against the new copy
+        //(the attribute values not yet deserialized still reference its memory)
+        removeOffHeap(id);
+        try
+        {
+            byte[] bytes = serialize(session.getSessionData());
+            if (!reserveOffHeap(bytes.length))
+            {
+                if (LOG.isDebugEnabled())
+                    LOG.debug("No off-heap space for session {}, {} bytes held", id, _offHeapBytes.get());
+                return;
+            }
+            ByteBuffer buffer = ByteBuffer.allocateDirect(bytes.length);
+            buffer.put(bytes).flip();
+            ByteBuffer old = _offHeap.put(id, buffer.asReadOnlyBuffer());
+            if (old != null)
+                _offHeapBytes.addAndGet(-old.capacity());
+            if (LOG.isDebugEnabled())
+                LOG.debug("Session {} held off-heap in {} bytes", id, bytes.length);
+        }
+        catch (IOException e)
+        {
+            //the session remains available from the SessionDataStore
+            if (LOG.isDebugEnabled())
+                LOG.debug("Unable to hold session {} off-heap", id, e);
+        }
+    }
+
+    /**
+     * Re-activate a session from its off-heap data.
+     *
+     * @param id the session id
+     * @return the re-activated session, or null if the session is not held off-heap
+     */
+    private ManagedSession activate(String id)
+    {
+        ByteBuffer buffer = _offHeap.get(id);
+        if (buffer == null)
+            return null;
+
+        try
+        {
+            SessionData data = deserialize(id, buffer.duplicate());
+            //the off-heap data is kept until the session is evicted again or deleted,
+            //as the attribute values are read from it on demand
+            data.setLastNode(_context.getWorkerName());
+            ManagedSession session = newSession(data);
+            try (AutoLock lock = session.lock())
+            {
+                session.setResident(true);
+            }
+            if (LOG.isDebugEnabled())
+                LOG.debug("Session {} re-activated from off-heap", id);
+            return session;
+        }
+        catch (IOException e)
+        {
+            LOG.warn("Unable to re-activate session {} from off-heap", id, e);
+            removeOffHeap(id);
+            return null;
+        }
+    }
+
+    private static byte[] serialize(SessionData data) throws IOException
+    {
+        ByteArrayOutputStream bytes = new ByteArrayOutputStream();
+        try (DataOutputStream out = new DataOutputStream(bytes))
+        {
+            out.writeLong(data.getExpiry());
+            out.writeLong(data.getMaxInactiveMs());
+            out.writeLong(data.getCreated());
+            out.writeLong(data.getCookieSet());
+            out.writeLong(data.getAccessed());
+            out.writeLong(data.getLastAccessed());
+            out.writeLong(data.getLastSaved());
+            out.writeUTF(data.getContextPath());
+            out.writeUTF(data.getVhost());
+            out.writeBoolean(data.getLastNode() != null);
+            if (data.getLastNode() != null)
+                out.writeUTF(data.getLastNode());
+
+            //each attribute value is serialized on its own, so that it can be deserialized on its own
+            Map<String, Object> attributes;
+            Map<String, ByteBuffer> serialized = new HashMap<>();
+            if (data instanceof OffHeapSessionData offHeapData)
+            {
+                //the attribute values that were never accessed are copied without being deserialized
+                serialized.putAll(offHeapData._serialized);
+                attributes = offHeapData.getResolvedAttributes();
+                serialized.keySet().removeAll(attributes.keySet());
+            }
+            else
+            {
+                attributes = data.getAllAttributes();
+            }
+
+            out.writeInt(attributes.size() + serialized.size());
+            for (Map.Entry<String, ByteBuffer> entry : serialized.entrySet())
+            {
+                ByteBuffer value = entry.getValue().duplicate();
+                byte[] array = new byte[value.remaining()];
+                value.get(array);
+                out.writeUTF(entry.getKey());
+                out.writeInt(array.length);
+                out.write(array);
+            }
+            ByteArrayOutputStream value = new ByteArrayOutputStream();
+            for (Map.Entry<String, Object> entry : attributes.entrySet())
+            {
+                value.reset();
+                try (ObjectOutputStream oos = new ObjectOutputStream(value))
+                {
+                    oos.writeObject(entry.getValue());
+                }
+                out.writeUTF(entry.getKey());
+                out.writeInt(value.size());
+                value.writeTo(out);
+            }
+        }
+        return bytes.toByteArray();
+    }
+
+    private static SessionData deserialize(String id, ByteBuffer buffer) throws IOException
+    {
+        DataInputStream in = new DataInputStream(new ByteBufferInputStream(buffer));
+        long expiry = in.readLong();
+        long maxInactiveMs = in.readLong();
+        long created = in.readLong();
+        long cookieSet = in.readLong();
+        long accessed = in.readLong();
+        long lastAccessed = in.readLong();
+        long lastSaved = in.readLong();
+        String contextPath = in.readUTF();
+        String vhost = in.readUTF();
+        String lastNode = in.readBoolean() ? in.readUTF() : null;
+
+        OffHeapSessionData data = new OffHeapSessionData(id, contextPath, vhost, created, accessed, lastAccessed, maxInactiveMs);
+        data.setExpiry(expiry);
+        data.setCookieSet(cookieSet);
+        data.setLastSaved(lastSaved);
+        data.setLastNode(lastNode);
+
+        int attributes = in.readInt();
+        for (int i = 0; i < attributes; i++)
+        {
+            String name = in.readUTF();
+            int length = in.readInt();
+            //the value stays off-heap until it is accessed
+            ByteBuffer value = buffer.slice(buffer.position(), length);
+            buffer.position(buffer.position() + length);
+            data._serialized.put(name, value);
+        }
+        data.clean();
+        return data;
+    }
+
+    /**
+     * SessionData whose attribute values are deserialized from off-heap memory on first access.
+     */
+    private static class OffHeapSessionData extends SessionData
+    {
+        private final Map<String, ByteBuffer> _serialized = new ConcurrentHashMap<>();
+
+        private OffHeapSessionData(String id, String cpath, String vhost, long created, long accessed, long lastAccessed, long maxInactiveMs)
+        {
+            super(id, cpath, vhost, created, accessed, lastAccessed, maxInactiveMs);
+        }
+
+        private Map<String, Object> getResolvedAttributes()
+        {
+            return super.getAllAttributes();
+        }
+
+        private void resolve(String name)
+        {
+            ByteBuffer value = _serialized.remove(name);
+            if (value == null)
+                return;
+
+            byte[] bytes = new byte[value.remaining()];
+            value.get(bytes);
+            try (ClassLoadingObjectInputStream in = new ClassLoadingObjectInputStream(new ByteArrayInputStream(bytes)))
+            {
+                Object object = in.readObject();
+                if (object != null)
+                    _attributes.putIfAbsent(name, object);
+            }
+            catch (IOException | ClassNotFoundException e)
+            {
+                throw new IllegalStateException("Unable to deserialize attribute " + name + " of session " + getId(), e);
+            }
+        }
+
+        private void resolveAll()
+        {
+            for (String name : _serialized.keySet())
+            {
+                resolve(name);
+            }
+        }
+
+        @Override
+        public Object getAttribute(String name)
+        {
+            resolve(name);
+            return super.getAttribute(name);
+        }
+
+        @Override
+        public Set<String> getKeys()
+        {
+            if (_serialized.isEmpty())
+                return super.getKeys();
+            Set<String> keys = new HashSet<>(super.getKeys());
+            keys.addAll(_serialized.keySet());
+            return keys;
+        }
+
+        @Override
+        public Object setAttribute(String name, Object value)
+        {
+            resolve(name);
+            return super.setAttribute(name, value);
+        }
+
+        @Override
+        public void clearAllAttributes()
+        {
+            _serialized.clear();
+            super.clearAllAttributes();
+        }
+
+        @Override
+        public Map<String, Object> getAllAttributes()
+        {
+            resolveAll();
+            return super.getAllAttributes();
+        }
+    }
+}
@@ -0,0 +1,42 @@
+//
+// ========================================================================
+// Copyright (c) 1995 Mort Bay Consulting Pty Ltd and others.
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License v. 2.0 which is available at
+// https://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+// ========================================================================
+//
+
+package org.eclipse.jetty.session;
+
+/**
+ * OffHeapSessionCacheFactory
+ *
+ * Factory for creating new OffHeapSessionCaches.
+ */
+public class OffHeapSessionCacheFactory extends AbstractSessionCacheFactory
+{
+    long _maxOffHeapBytes = -1;
+
+    public long getMaxOffHeapBytes()
+    {
+        return _maxOffHeapBytes;
+    }
+
+    public void setMaxOffHeapBytes(long maxOffHeapBytes)
+    {
+        _maxOffHeapBytes = maxOffHeapBytes;
+    }
+
+    @Override
+    public SessionCache newSessionCache(SessionManager manager)
+    {
+        OffHeapSessionCache cache = new OffHeapSessionCache(manager);
+        cache.setMaxOffHeapBytes(getMaxOffHeapBytes());
+        return cache;
+    }
+}
@@ -68,9 +68,10 @@ public class SessionData implements Serializable
     public static void serializeAttributes(SessionData data, java.io.ObjectOutputStream out)
         throws IOException
     {
-        int entries = data._attributes.size();
+        Map<String, Object> attributes = data.getAllAttributes();
+        int entries = attributes.size();
         out.writeObject(entries);
-        for (Entry<String, Object> entry : data._attributes.entrySet())
+        for (Entry<String, Object> entry : attributes.entrySet())
         {
             out.writeUTF(entry.getKey());
 
@@ -201,6 +201,9 @@ public class JdbcTestHelper
                 ds.setSessionTableSchema(_schema);
                 ds.setGracePeriodSec(getGracePeriodSec());
                 ds.setSavePeriodSec(getSavePeriodSec());
+                ds.setWriteBehindMs(getWriteBehindMs());
+                ds.setPartialUpdates(isPartialUpdates());
+                ds.setExpiryPageSize(getExpiryPageSize());
                 return ds;
             }
         };
@@ -0,0 +1,291 @@
+//
+// ========================================================================
+// Copyright (c) 1995 Mort Bay Consulting Pty Ltd and others.
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License v. 2.0 which is available at
+// https://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+// ========================================================================
+//
+
+package org.eclipse.jetty.session;
+
+import java.io.IOException;
+import java.io.ObjectInputStream;
+import java.io.Serializable;
+import java.util.List;
+import java.util.concurrent.CopyOnWriteArrayList;
+import java.util.concurrent.TimeUnit;
+import java.util.concurrent.atomic.AtomicInteger;
+
+import org.eclipse.jetty.server.Server;
+import org.junit.jupiter.api.Test;
+import org.junit.jupiter.params.ParameterizedTest;
+import org.junit.jupiter.params.provider.ValueSource;
+
+import static org.hamcrest.MatcherAssert.assertThat;
+import static org.hamcrest.Matchers.containsInAnyOrder;
+import static org.hamcrest.Matchers.hasItem;
+import static org.junit.jupiter.api.Assertions.assertEquals;
+import static org.junit.jupiter.api.Assertions.assertFalse;
+import static org.junit.jupiter.api.Assertions.assertNotNull;
+import static org.junit.jupiter.api.Assertions.assertNotSame;
+import static org.junit.jupiter.api.Assertions.assertNull;
+import static org.junit.jupiter.api.Assertions.assertTrue;
+
+/**
+ * OffHeapSessionCacheTest
+ */
+public class OffHeapSessionCacheTest extends AbstractSessionCacheTest
+{
+    public static class CountingValue implements Serializable
+    {
+        private static final long serialVersionUID = 1L;
+        static final AtomicInteger READS = new AtomicInteger();
+
+        private final String _value;
+
+        public CountingValue(String value)
+        {
+            _value = value;
+        }
+
+        private void readObject(ObjectInputStream in) throws IOException, ClassNotFoundException
+        {
+            in.defaultReadObject();
+            READS.incrementAndGet();
+        }
+
+        @Override
+        public String toString()
+        {
+            return _value;
+        }
+    }
+
+    @Override
+    public AbstractSessionCacheFactory newSessionCacheFactory(int evictionPolicy, boolean saveOnCreate,
+                                                              boolean saveOnInactiveEvict, boolean removeUnloadableSessions,
+                                                              boolean flushOnResponseCommit)
+    {
+        OffHeapSessionCacheFactory factory = new OffHeapSessionCacheFactory();
+        factory.setEvictionPolicy(evictionPolicy);
+        factory.setSaveOnCreate(saveOnCreate);
+        factory.setSaveOnInactiveEviction(saveOnInactiveEvict);
+        factory.setRemoveUnloadableSessions(removeUnloadableSessions);
+        factory.setFlushOnResponseCommit(flushOnResponseCommit);
+        return factory;
+    }
+
+    @Override
+    public void checkSessionBeforeShutdown(String id,
+                                           TestableSessionDataStore store,
+                                           SessionCache cache,
+                                           TestableSessionManager sessionManager) throws Exception
+    {
+        assertTrue(store.exists(id));
+        assertTrue(cache.contains(id));
+        assertFalse(sessionManager._sessionDestroyedListenersCalled.contains(id));
+        assertTrue(sessionManager._sessionPassivationListenersCalled.contains(id));
+        assertTrue(sessionManager._sessionActivationListenersCalled.contains(id));
+    }
+
+    @Override
+    public void checkSessionAfterShutdown(String id,
+                                          TestableSessionDataStore store,
+                                          SessionCache cache,
+                                          TestableSessionManager sessionManager) throws Exception
+    {
+        if (cache.isInvalidateOnShutdown())
+        {
+            //should have been invalidated and removed
+            assertFalse(store.exists(id));
+            assertFalse(cache.contains(id));
+            assertTrue(sessionManager._sessionDestroyedListenersCalled.contains(id));
+        }
+        else
+        {
+            //Session should still exist, but not be in the cache
+            assertTrue(store.exists(id));
+            assertFalse(cache.contains(id));
+            long passivateCount = sessionManager._sessionPassivationListenersCalled.stream().filter(s -> s.equals(id)).count();
+            long activateCount = sessionManager._sessionActivationListenersCalled.stream().filter(s -> s.equals(id)).count();
+            assertEquals(2, passivateCount);
+            assertEquals(1, activateCount); //no re-activate on shutdown
+        }
+    }
+
+    /**
+     * Test that an evicted session is re-activated from off-heap memory,
+     * without loading it from the store, and that its attribute values
+     * are only deserialized when accessed.
+     */
+    @Test
+    public void testEvictedSessionReactivatedFromOffHeap() throws Exception
+    {
+        Server server = new Server();
+
+        TestableSessionManager sessionManager = new TestableSessionManager();
+        sessionManager.setServer(server);
+        AbstractSessionCacheFactory cacheFactory = newSessionCacheFactory(SessionCache.EVICT_ON_SESSION_EXIT, false, false, false, false);
+        OffHeapSessionCache cache = (OffHeapSessionCache)cacheFactory.getSessionCache(sessionManager);
+
+        TestableSessionDataStore store = new TestableSessionDataStore();
+        cache.setSessionDataStore(store);
+        sessionManager.setSessionCache(cache);
+        server.addBean(sessionManager);
+        server.start();
+
+        long now = System.currentTimeMillis();
+        SessionData data = store.newSessionData("1234", now - 20, now - 10, now - 20, TimeUnit.MINUTES.toMillis(10));
+        data.setExpiry(now + TimeUnit.DAYS.toMillis(1));
+        data.setAttribute("one", new CountingValue("1"));
+        data.setAttribute("two", new CountingValue("2"));
+        ManagedSession session = cache.newSession(data);
+        cache.add("1234", session);
+
+        //releasing the session evicts it from the heap
+        cache.release(session);
+        assertFalse(session.isResident());
+        assertFalse(cache.contains("1234"));
+        assertEquals(1, cache.getOffHeapSessions());
+        assertTrue(cache.getOffHeapBytes() > 0);
+
+        //the session is known and re-activated without the store
+        store._map.clear();
+        assertTrue(cache.exists("1234"));
+        CountingValue.READS.set(0);
+        ManagedSession reactivated = cache.get("1234");
+        assertNotNull(reactivated);
+        assertNotSame(session, reactivated);
+        assertTrue(reactivated.isResident());
+        assertEquals(data.getExpiry(), reactivated.getSessionData().getExpiry());
+        assertThat(reactivated.getAttributeNameSet(), containsInAnyOrder("one", "two"));
+        assertEquals(0, CountingValue.READS.get());
+
+        assertEquals("1", reactivated.getAttribute("one").toString());
+        assertEquals(1, CountingValue.READS.get());
+        assertEquals("1", reactivated.getAttribute("one").toString());
+        assertEquals(1, CountingValue.READS.get());
+
+        //evicting again does not deserialize the attribute that was never accessed
+        cache.release(reactivated);
+        assertEquals(1, CountingValue.READS.get());
+        assertEquals(1, cache.getOffHeapSessions());
+
+        reactivated = cache.get("1234");
+        assertEquals("2", reactivated.getAttribute("two").toString());
+        assertEquals(2, CountingValue.READS.get());
+    }
+
+    /**
+     * Test that a re-activated session that cannot be held off-heap again,
+     * because the off-heap budget is full or an attribute is not serializable,
+     * does not leave its stale off-heap copy behind.
+     */
+    @ParameterizedTest
+    @ValueSource(booleans = {true, false})
+    public void testStaleOffHeapCopyDroppedWhenNotPassivated(boolean serializable) throws Exception
+    {
+        Server server = new Server();
+
+        TestableSessionManager sessionManager = new TestableSessionManager();
+        sessionManager.setServer(server);
+        AbstractSessionCacheFactory cacheFactory = newSessionCacheFactory(SessionCache.EVICT_ON_SESSION_EXIT, false, false, false, false);
+        OffHeapSessionCache cache = (OffHeapSessionCache)cacheFactory.getSessionCache(sessionManager);
+
+        TestableSessionDataStore store = new TestableSessionDataStore();
+        cache.setSessionDataStore(store);
+        sessionManager.setSessionCache(cache);
+        server.addBean(sessionManager);
+        server.start();
+
+        long now = System.currentTimeMillis();
+        SessionData data = store.newSessionData("1234", now - 20, now - 10, now - 20, TimeUnit.MINUTES.toMillis(10));
+        data.setExpiry(now + TimeUnit.DAYS.toMillis(1));
+        data.setAttribute("name", "v1");
+        ManagedSession session = cache.newSession(data);
+        cache.add("1234", session);
+        cache.release(session);
+        assertEquals(1, cache.getOffHeapSessions());
+
+        //re-activate and modify the session, so that its new state does not fit off-heap
+        ManagedSession reactivated = cache.get("1234");
+        Object value;
+        if (serializable)
+        {
+            cache.setMaxOffHeapBytes(cache.getOffHeapBytes());
+            value = "v2".repeat(100);
+        }
+        else
+        {
+            value = new Object();
+        }
+        reactivated.setAttribute("name", value);
+        cache.release(reactivated);
+        assertFalse(cache.contains("1234"));
+        assertEquals(0, cache.getOffHeapSessions());
+        assertEquals(0, cache.getOffHeapBytes());
+
+        //the next request loads the modified session from the store
+        ManagedSession loaded = cache.get("1234");
+        assertNotNull(loaded);
+        assertEquals(value, loaded.getAttribute("name"));
+    }
+
+    /**
+     * Test that writes are published to the other nodes, and that
+     * the invalidations from the other nodes drop the local copies.
+     */
+    @Test
+    public void testInvalidation() throws Exception
+    {
+        Server server = new Server();
+
+        TestableSessionManager sessionManager = new TestableSessionManager();
+        sessionManager.setServer(server);
+        AbstractSessionCacheFactory cacheFactory = newSessionCacheFactory(SessionCache.NEVER_EVICT, false, false, false, false);
+        OffHeapSessionCache cache = (OffHeapSessionCache)cacheFactory.getSessionCache(sessionManager);
+        List<String> published = new CopyOnWriteArrayList<>();
+        cache.setInvalidationPublisher(published::add);
+
+        TestableSessionDataStore store = new TestableSessionDataStore();
+        cache.setSessionDataStore(store);
+        sessionManager.setSessionCache(cache);
+        server.addBean(sessionManager);
+        server.start();
+
+        long now = System.currentTimeMillis();
+        SessionData data = store.newSessionData("1234", now - 20, now - 10, now - 20, TimeUnit.MINUTES.toMillis(10));
+        data.setExpiry(now + TimeUnit.DAYS.toMillis(1));
+        data.setAttribute("name", "value");
+        ManagedSession session = cache.newSession(data);
+        cache.add("1234", session);
+
+        //the write of the modified session is published
+        cache.release(session);
+        assertThat(published, hasItem("1234"));
+        assertTrue(cache.contains("1234"));
+
+        //an invalidation from another node drops the idle session
+        cache.onInvalidation("1234");
+        assertFalse(cache.contains("1234"));
+        assertFalse(session.isResident());
+
+        //the next request loads the session from the store
+        store._map.clear();
+        assertNull(cache.get("1234"));
+
+        //an invalidation does not drop a session in use
+        SessionData data2 = store.newSessionData("5678", now - 20, now - 10, now - 20, TimeUnit.MINUTES.toMillis(10));
+        data2.setExpiry(now + TimeUnit.DAYS.toMillis(1));
+        ManagedSession session2 = cache.newSession(data2);
+        cache.add("5678", session2);
+        cache.onInvalidation("5678");
+        assertTrue(cache.contains("5678"));
+        assertTrue(session2.isResident());
+    }
+}
@@ -13,16 +13,23 @@
 
 package org.eclipse.jetty.test.client.transport;
 
+import java.io.InputStream;
+import java.io.OutputStream;
 import java.util.concurrent.Executor;
 import java.util.concurrent.TimeUnit;
 
 import org.eclipse.jetty.client.ContentResponse;
+import org.eclipse.jetty.client.StringRequestContent;
+import org.eclipse.jetty.http.HttpMethod;
 import org.eclipse.jetty.http.HttpStatus;
+import org.eclipse.jetty.io.Content;
 import org.eclipse.jetty.server.Handler;
 import org.eclipse.jetty.server.Request;
 import org.eclipse.jetty.server.Response;
 import org.eclipse.jetty.util.Callback;
 import org.eclipse.jetty.util.VirtualThreads;
+import org.eclipse.jetty.util.thread.QueuedThreadPool;
+import org.eclipse.jetty.util.thread.ReservedThreadExecutor;
 import org.eclipse.jetty.util.thread.ThreadPool;
 import org.junit.jupiter.api.Assumptions;
 import org.junit.jupiter.api.condition.DisabledForJreRange;
@@ -31,6 +38,7 @@ import org.junit.jupiter.params.ParameterizedTest;
 import org.junit.jupiter.params.provider.MethodSource;
 
 import static org.junit.jupiter.api.Assertions.assertEquals;
+import static org.junit.jupiter.api.Assertions.assertNull;
 
 @DisabledForJreRange(max = JRE.JAVA_18)
 public class VirtualThreadsTest extends AbstractTest
@@ -71,4 +79,51 @@ public class VirtualThreadsTest extends AbstractTest
 
         assertEquals(HttpStatus.OK_200, response.getStatus(), " for transport " + transport);
     }
+
+    @ParameterizedTest
+    @MethodSource("transports")
+    public void testBlockingReadWriteOnVirtualThread(Transport transport) throws Exception
+    {
+        // No virtual thread support in FCGI server-side.
+        Assumptions.assumeTrue(transport != Transport.FCGI);
+        Assumptions.assumeTrue(VirtualThreads.areSupported());
+
+        prepareServer(transport, new Handler.Abstract()
+        {
+            @Override
+            public boolean handle(Request request, Response response, Callback callback) throws Exception
+            {
+                if (!VirtualThreads.isVirtualThread())
+                {
+                    Response.writeError(request, response, callback, HttpStatus.NOT_IMPLEMENTED_501);
+                    return true;
+                }
+                try (InputStream input = Content.Source.asInputStream(request);
+                     OutputStream output = Content.Sink.asOutputStream(response))
+                {
+                    input.transferTo(output);
+                }
+                callback.succeeded();
+                return true;
+            }
+        });
+        QueuedThreadPool threadPool = (QueuedThreadPool)server.getThreadPool();
+        // Explicitly configured reserved threads are not used with virtual threads.
+        threadPool.setReservedThreads(4);
+        threadPool.setVirtualThreadsExecutor(VirtualThreads.getDefaultVirtualThreadsExecutor());
+        server.start();
+        startClient(transport);
+
+        assertNull(threadPool.getBean(ReservedThreadExecutor.class));
+
+        String content = "0123456789".repeat(1024);
+        ContentResponse response = client.newRequest(newURI(transport))
+            .method(HttpMethod.POST)
+            .body(new StringRequestContent(content))
+            .timeout(5, TimeUnit.SECONDS)
+            .send();
+
+        assertEquals(HttpStatus.OK_200, response.getStatus(), " for transport " + transport);
+        assertEquals(content, response.getContentAsString());
+    }
 }
@@ -37,5 +37,6 @@ module org.eclipse.jetty.util
     exports org.eclipse.jetty.util.thread;
     exports org.eclipse.jetty.util.thread.strategy;
 
+    uses org.eclipse.jetty.util.compression.Compression;
     uses org.eclipse.jetty.util.security.CredentialProvider;
 }
@@ -1038,6 +1038,86 @@ public class BufferUtil
         }
     }
 
+    /**
+     * @param chars the characters to measure
+     * @return the number of bytes of the UTF-8 encoding of the characters,
+     * where an unpaired surrogate is encoded as {@code '?'}
+     */
+    public static int utf8Length(CharSequence chars)
+    {
+        int length = chars.length();
+        int bytes = length;
+        for (int i = 0; i < length; ++i)
+        {
+            char c = chars.charAt(i);
+            if (c < 0x80)
+                continue;
+            if (c < 0x800)
+            {
+                bytes += 1;
+            }
+            else if (Character.isHighSurrogate(c) && i + 1 < length && Character.isLowSurrogate(chars.charAt(i + 1)))
+            {
+                // 4 bytes for 2 chars.
+                bytes += 2;
+                ++i;
+            }
+            else if (!Character.isSurrogate(c))
+            {
+                bytes += 2;
+            }
+        }
+        return bytes;
+    }
+
+    /**
+     * <p>Puts the UTF-8 encoding of characters into a buffer in fill mode,
+     * without the intermediate {@code String} and {@code byte[]} of {@link String#getBytes(Charset)}.</p>
+     * <p>An unpaired surrogate is encoded as {@code '?'}.</p>
+     *
+     * @param buffer the buffer to put the bytes into, which must have at least
+     * {@link #utf8Length(CharSequence)} bytes remaining
+     * @param chars the characters to encode
+     */
+    public static void putUtf8(ByteBuffer buffer, CharSequence chars)
+    {
+        int length = chars.length();
+        for (int i = 0; i < length; ++i)
+        {
+            char c = chars.charAt(i);
+            if (c < 0x80)
+            {
+                buffer.put((byte)c);
+            }
+            else if (c < 0x800)
+            {
+                buffer.put((byte)(0xC0 | (c >> 6)));
+                buffer.put((byte)(0x80 | (c & 0x3F)));
+            }
+            else if (Character.isSurrogate(c))
+            {
+                if (Character.isHighSurrogate(c) && i + 1 < length && Character.isLowSurrogate(chars.charAt(i + 1)))
+                {
+                    int codePoint = Character.toCodePoint(c, chars.charAt(++i));
+                    buffer.put((byte)(0xF0 | (codePoint >> 18)));
+                    buffer.put((byte)(0x80 | ((codePoint >> 12) & 0x3F)));
+                    buffer.put((byte)(0x80 | ((codePoint >> 6) & 0x3F)));
+                    buffer.put((byte)(0x80 | (codePoint & 0x3F)));
+                }
+                else
+                {
+                    buffer.put((byte)'?');
+                }
+            }
+            else
+            {
+                buffer.put((byte)(0xE0 | (c >> 12)));
+                buffer.put((byte)(0x80 | ((c >> 6) & 0x3F)));
+                buffer.put((byte)(0x80 | (c & 0x3F)));
+            }
+        }
+    }
+
     public static ByteBuffer toBuffer(int value)
     {
         ByteBuffer buf = ByteBuffer.allocate(32);
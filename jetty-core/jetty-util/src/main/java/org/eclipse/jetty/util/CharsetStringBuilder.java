@@ -156,6 +156,28 @@ public interface CharsetStringBuilder
             _builder.append((char)(0xff & b));
         }
 
+        @Override
+        public void append(byte[] b, int offset, int length)
+        {
+            int end = offset + length;
+            for (int i = offset; i < end; i++)
+            {
+                _builder.append((char)(0xff & b[i]));
+            }
+        }
+
+        @Override
+        public void append(ByteBuffer buf)
+        {
+            int position = buf.position();
+            int limit = buf.limit();
+            for (int i = position; i < limit; i++)
+            {
+                _builder.append((char)(0xff & buf.get(i)));
+            }
+            buf.position(limit);
+        }
+
         @Override
         public void append(char c)
         {
@@ -201,6 +223,37 @@ public interface CharsetStringBuilder
             _builder.append((char)b);
         }
 
+        @Override
+        public void append(byte[] b, int offset, int length)
+        {
+            int end = offset + length;
+            int ascii = StringUtil.indexOfNonAscii(b, offset, end);
+            for (int i = offset; i < ascii; i++)
+            {
+                _builder.append((char)b[i]);
+            }
+            if (ascii != end)
+                throw new IllegalArgumentException();
+        }
+
+        @Override
+        public void append(ByteBuffer buf)
+        {
+            int position = buf.position();
+            int limit = buf.limit();
+            int end = StringUtil.indexOfNonAscii(buf, position, limit);
+            for (int i = position; i < end; i++)
+            {
+                _builder.append((char)buf.get(i));
+            }
+            if (end != limit)
+            {
+                buf.position(end + 1);
+                throw new IllegalArgumentException();
+            }
+            buf.position(end);
+        }
+
         @Override
         public void append(char c)
         {
@@ -24,6 +24,7 @@ import java.util.concurrent.atomic.AtomicInteger;
 import java.util.concurrent.atomic.LongAdder;
 import java.util.function.Predicate;
 import java.util.function.ToIntFunction;
+import java.util.function.ToLongFunction;
 import java.util.stream.Stream;
 
 import org.eclipse.jetty.util.annotation.ManagedAttribute;
@@ -258,6 +259,80 @@ public class ConcurrentPool<P> implements Pool<P>, Dumpable
         return null;
     }
 
+    /**
+     * <p>Acquires an entry using the <em>power of two choices</em> algorithm.</p>
+     * <p>Two distinct entries are picked at random, and an attempt is made to
+     * acquire the one with the lower cost first, then the other one.
+     * If neither can be acquired, this method falls back to {@link #acquire()}.</p>
+     * <p>Entries that are not yet enabled have the highest cost.</p>
+     *
+     * @param cost the function that computes the cost of a pooled object, lower is better
+     * @return an entry from the pool or null if none is available
+     */
+    public Entry<P> acquire(ToLongFunction<P> cost)
+    {
+        if (terminated)
+            return null;
+
+        int size = entries.size();
+        if (size > 1)
+        {
+            ThreadLocalRandom random = ThreadLocalRandom.current();
+            int index1 = random.nextInt(size);
+            int index2 = random.nextInt(size - 1);
+            if (index2 >= index1)
+                ++index2;
+            ConcurrentEntry<P> entry1 = entryAt(index1);
+            ConcurrentEntry<P> entry2 = entryAt(index2);
+            long cost1 = costOf(entry1, cost);
+            long cost2 = costOf(entry2, cost);
+            if (cost2 < cost1)
+            {
+                ConcurrentEntry<P> swap = entry1;
+                entry1 = entry2;
+                entry2 = swap;
+            }
+            if (entry1 != null && entry1.tryAcquire())
+            {
+                if (LOG.isDebugEnabled())
+                    LOG.debug("returning entry {} for {}", entry1, this);
+                return entry1;
+            }
+            if (entry2 != null && entry2.tryAcquire())
+            {
+                if (LOG.isDebugEnabled())
+                    LOG.debug("returning entry {} for {}", entry2, this);
+                return entry2;
+            }
+        }
+
+        return acquire();
+    }
+
+    private ConcurrentEntry<P> entryAt(int index)
+    {
+        try
+        {
+            Holder<P> holder = entries.get(index);
+            return holder == null ? null : (ConcurrentEntry<P>)holder.getEntry();
+        }
+        catch (IndexOutOfBoundsException x)
+        {
+            LOG.trace("IGNORED", x);
+            return null;
+        }
+    }
+
+    private static <P> long costOf(ConcurrentEntry<P> entry, ToLongFunction<P> cost)
+    {
+        if (entry == null)
+            return Long.MAX_VALUE;
+        P pooled = entry.getPooled();
+        if (pooled == null)
+            return Long.MAX_VALUE;
+        return cost.applyAsLong(pooled);
+    }
+
     private int startIndex(int size)
     {
         return switch (strategyType)
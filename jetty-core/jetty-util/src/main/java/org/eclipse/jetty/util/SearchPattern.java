@@ -13,15 +13,23 @@
 
 package org.eclipse.jetty.util;
 
+import java.lang.invoke.MethodHandles;
+import java.lang.invoke.VarHandle;
 import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
 import java.nio.charset.StandardCharsets;
 import java.util.Arrays;
 
 /**
  * <p>Fast search for patterns within strings, arrays of
  * bytes and {@code ByteBuffer}s.</p>
- * <p>Uses an implementation of the Boyer–Moore–Horspool
- * algorithm with a 256 character alphabet.</p>
+ * <p>Full matches are searched 8 candidate positions at a time,
+ * reading the data a {@code long} word at a time and filtering the
+ * candidates on the first and last bytes of the pattern, with SWAR
+ * (SIMD within a register) arithmetic, before verifying the rest
+ * of the pattern.  An implementation of the Boyer–Moore–Horspool
+ * algorithm with a 256 character alphabet is used for the tail of
+ * the data that is too short to be read as words.</p>
  *
  * <p>The algorithm has an average-case complexity of O(n)
  * on random text and O(nm) in the worst case, where
@@ -30,8 +38,14 @@ import java.util.Arrays;
 public class SearchPattern
 {
     private static final int ALPHABET_SIZE = 256;
+    private static final VarHandle ARRAY_WORD = MethodHandles.byteArrayViewVarHandle(long[].class, ByteOrder.LITTLE_ENDIAN);
+    private static final VarHandle BUFFER_WORD = MethodHandles.byteBufferViewVarHandle(long[].class, ByteOrder.LITTLE_ENDIAN);
+    private static final long ONES = 0x0101010101010101L;
+    private static final long LOW_BITS = 0x7F7F7F7F7F7F7F7FL;
     private final int[] table = new int[ALPHABET_SIZE];
     private final byte[] pattern;
+    private final long firstBytes;
+    private final long lastBytes;
 
     /**
      * <p>Creates a {@code SearchPattern} instance which can be used
@@ -73,6 +87,20 @@ public class SearchPattern
         {
             table[0xff & pattern[i]] = pattern.length - 1 - i;
         }
+
+        // The first and last bytes of the pattern, repeated in each byte of a word.
+        firstBytes = (0xFFL & pattern[0]) * ONES;
+        lastBytes = (0xFFL & pattern[pattern.length - 1]) * ONES;
+    }
+
+    /**
+     * @param word the word to test
+     * @return a word with the high bit set in each byte that is zero in the given word, and all other bits clear
+     */
+    private static long zeroBytes(long word)
+    {
+        // Adding 0x7F to the low 7 bits carries into the high bit of all the non-zero bytes.
+        return ~(((word & LOW_BITS) + LOW_BITS) | word | LOW_BITS);
     }
 
     /**
@@ -96,7 +124,24 @@ public class SearchPattern
     {
         validateArgs(data, offset, length);
 
+        int last = pattern.length - 1;
         int skip = offset;
+
+        // Filter 8 candidates at a time while the words of their first and last bytes are in the data.
+        int wordLimit = offset + length - last - Long.BYTES;
+        while (skip <= wordLimit)
+        {
+            long candidates = zeroBytes(((long)ARRAY_WORD.get(data, skip) ^ firstBytes) | ((long)ARRAY_WORD.get(data, skip + last) ^ lastBytes));
+            while (candidates != 0)
+            {
+                int candidate = skip + (Long.numberOfTrailingZeros(candidates) >>> 3);
+                if (last <= 1 || Arrays.equals(data, candidate + 1, candidate + last, pattern, 1, last))
+                    return candidate;
+                candidates &= candidates - 1;
+            }
+            skip += Long.BYTES;
+        }
+
         while (skip <= offset + length - pattern.length)
         {
             for (int i = pattern.length - 1; data[skip + i] == pattern[i]; i--)
@@ -123,8 +168,34 @@ public class SearchPattern
      */
     public int match(ByteBuffer buffer)
     {
+        if (buffer.hasArray())
+        {
+            int offset = buffer.arrayOffset() + buffer.position();
+            int index = match(buffer.array(), offset, buffer.remaining());
+            return index < 0 ? -1 : index - offset;
+        }
+
+        int position = buffer.position();
         int remaining = buffer.remaining();
+        int last = getLength() - 1;
         int cursor = 0;
+
+        // Filter 8 candidates at a time while the words of their first and last bytes are in the buffer.
+        int wordLimit = remaining - last - Long.BYTES;
+        while (cursor <= wordLimit)
+        {
+            int index = position + cursor;
+            long candidates = zeroBytes(((long)BUFFER_WORD.get(buffer, index) ^ firstBytes) | ((long)BUFFER_WORD.get(buffer, index + last) ^ lastBytes));
+            while (candidates != 0)
+            {
+                int candidate = cursor + (Long.numberOfTrailingZeros(candidates) >>> 3);
+                if (matches(buffer, position + candidate))
+                    return candidate;
+                candidates &= candidates - 1;
+            }
+            cursor += Long.BYTES;
+        }
+
         while (remaining - cursor >= getLength())
         {
             int i = getLength() - 1;
@@ -139,6 +210,17 @@ public class SearchPattern
         return -1;
     }
 
+    private boolean matches(ByteBuffer buffer, int index)
+    {
+        // The first and last bytes have already been matched.
+        for (int i = getLength() - 2; i > 0; --i)
+        {
+            if (buffer.get(index + i) != pattern[i])
+                return false;
+        }
+        return true;
+    }
+
     /**
      * Search for a partial match of the pattern at the end of the data.
      *
@@ -14,6 +14,10 @@
 package org.eclipse.jetty.util;
 
 import java.io.UnsupportedEncodingException;
+import java.lang.invoke.MethodHandles;
+import java.lang.invoke.VarHandle;
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
 import java.nio.charset.Charset;
 import java.nio.charset.StandardCharsets;
 import java.util.ArrayList;
@@ -35,6 +39,10 @@ public class StringUtil
     public static final String CRLF = "\r\n";
     public static final String DEFAULT_DELIMS = ",;";
 
+    private static final VarHandle LONG_ARRAY_VIEW = MethodHandles.byteArrayViewVarHandle(long[].class, ByteOrder.nativeOrder());
+    private static final long HIGH_BITS = 0x8080808080808080L;
+    private static final long LOW_BITS = 0x0101010101010101L;
+
     // @checkstyle-disable-check : IllegalTokenTextCheck
     private static final char[] LOWERCASES =
     {
@@ -1167,6 +1175,116 @@ public class StringUtil
         return object == null ? null : String.valueOf(object);
     }
 
+    /**
+     * <p>Finds the index of the first byte that is not US-ASCII (i.e. has its high bit set),
+     * examining 8 bytes at a time.</p>
+     *
+     * @param bytes the bytes to scan
+     * @param offset the index to start scanning from
+     * @param end the index to stop scanning at (exclusive)
+     * @return the index of the first non US-ASCII byte, or {@code end} if all bytes are US-ASCII
+     */
+    public static int indexOfNonAscii(byte[] bytes, int offset, int end)
+    {
+        int i = offset;
+        while (i + Long.BYTES <= end)
+        {
+            long word = (long)LONG_ARRAY_VIEW.get(bytes, i);
+            if ((word & HIGH_BITS) != 0)
+                break;
+            i += Long.BYTES;
+        }
+        while (i < end && bytes[i] >= 0)
+        {
+            i++;
+        }
+        return i;
+    }
+
+    /**
+     * <p>Finds the index of the first byte that is not US-ASCII (i.e. has its high bit set),
+     * examining 8 bytes at a time.</p>
+     * <p>The buffer position and limit are not modified.</p>
+     *
+     * @param buffer the buffer to scan
+     * @param offset the absolute index to start scanning from
+     * @param end the absolute index to stop scanning at (exclusive)
+     * @return the index of the first non US-ASCII byte, or {@code end} if all bytes are US-ASCII
+     */
+    public static int indexOfNonAscii(ByteBuffer buffer, int offset, int end)
+    {
+        int i = offset;
+        while (i + Long.BYTES <= end)
+        {
+            if ((buffer.getLong(i) & HIGH_BITS) != 0)
+                break;
+            i += Long.BYTES;
+        }
+        while (i < end && buffer.get(i) >= 0)
+        {
+            i++;
+        }
+        return i;
+    }
+
+    /**
+     * <p>Finds the index of the first byte that is not a printable US-ASCII character,
+     * that is a byte outside of the range {@code 0x20} (space) to {@code 0x7E} ({@code ~}),
+     * examining 8 bytes at a time.</p>
+     * <p>The buffer position and limit are not modified.</p>
+     *
+     * @param buffer the buffer to scan
+     * @param offset the absolute index to start scanning from
+     * @param end the absolute index to stop scanning at (exclusive)
+     * @return the index of the first non printable byte, or {@code end} if all bytes are printable
+     */
+    public static int indexOfNonPrintableAscii(ByteBuffer buffer, int offset, int end)
+    {
+        return indexOfAsciiOutside(buffer, offset, end, 0x20);
+    }
+
+    /**
+     * <p>Finds the index of the first byte that is not a visible US-ASCII character,
+     * that is a byte outside of the range {@code 0x21} ({@code !}) to {@code 0x7E} ({@code ~}),
+     * examining 8 bytes at a time.</p>
+     * <p>The buffer position and limit are not modified.</p>
+     *
+     * @param buffer the buffer to scan
+     * @param offset the absolute index to start scanning from
+     * @param end the absolute index to stop scanning at (exclusive)
+     * @return the index of the first non visible byte, or {@code end} if all bytes are visible
+     */
+    public static int indexOfNonVisibleAscii(ByteBuffer buffer, int offset, int end)
+    {
+        return indexOfAsciiOutside(buffer, offset, end, 0x21);
+    }
+
+    private static int indexOfAsciiOutside(ByteBuffer buffer, int offset, int end, int min)
+    {
+        long minBits = LOW_BITS * min;
+        int i = offset;
+        while (i + Long.BYTES <= end)
+        {
+            long word = buffer.getLong(i);
+            // A byte is less than min if subtracting min borrows into its high bit;
+            // a byte is greater than 0x7E if adding 0x01 carries into its high bit,
+            // or if its high bit is already set.
+            long less = (word - minBits) & ~word;
+            long more = (word + LOW_BITS) | word;
+            if (((less | more) & HIGH_BITS) != 0)
+                break;
+            i += Long.BYTES;
+        }
+        while (i < end)
+        {
+            byte b = buffer.get(i);
+            if (b < min || b == 0x7F)
+                break;
+            i++;
+        }
+        return i;
+    }
+
     public static String randomAlphaNumeric(int digits)
     {
         String source = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz";
@@ -176,6 +176,19 @@ public class Utf8StringBuilder implements CharsetStringBuilder
         {
             while (buf.remaining() > 0)
             {
+                // Fast path for runs of US-ASCII bytes between complete sequences.
+                if (_state == UTF8_ACCEPT)
+                {
+                    int position = buf.position();
+                    int end = StringUtil.indexOfNonAscii(buf, position, buf.limit());
+                    for (int i = position; i < end; i++)
+                    {
+                        bufferAppend((char)buf.get(i));
+                    }
+                    buf.position(end);
+                    if (end == buf.limit())
+                        break;
+                }
                 appendByte(buf.get());
             }
         }
@@ -197,9 +210,21 @@ public class Utf8StringBuilder implements CharsetStringBuilder
         try
         {
             int end = offset + length;
-            for (int i = offset; i < end; i++)
+            int i = offset;
+            while (i < end)
             {
-                appendByte(b[i]);
+                // Fast path for runs of US-ASCII bytes between complete sequences.
+                if (_state == UTF8_ACCEPT)
+                {
+                    int ascii = StringUtil.indexOfNonAscii(b, i, end);
+                    while (i < ascii)
+                    {
+                        bufferAppend((char)b[i++]);
+                    }
+                    if (i == end)
+                        break;
+                }
+                appendByte(b[i++]);
             }
         }
         catch (IOException e)
@@ -18,6 +18,7 @@ import java.util.EventListener;
 import java.util.List;
 import java.util.concurrent.CopyOnWriteArrayList;
 
+import org.eclipse.jetty.util.NanoTime;
 import org.eclipse.jetty.util.TypeUtil;
 import org.eclipse.jetty.util.Uptime;
 import org.eclipse.jetty.util.annotation.ManagedAttribute;
@@ -52,6 +53,8 @@ public abstract class AbstractLifeCycle implements LifeCycle
     private final List<EventListener> _eventListener = new CopyOnWriteArrayList<>();
     private final AutoLock _lock = new AutoLock();
     private volatile State _state = State.STOPPED;
+    private volatile long _startingNanoTime;
+    private volatile long _startDuration = -1;
 
     /**
      * Method to override to start the lifecycle
@@ -226,6 +229,16 @@ public abstract class AbstractLifeCycle implements LifeCycle
         return _state.toString();
     }
 
+    /**
+     * @return the time in milliseconds taken by the last start of this lifecycle,
+     * including the start of any children, or -1 if it has never been started
+     */
+    @ManagedAttribute(value = "Time in ms taken by the last start", readonly = true)
+    public long getStartDuration()
+    {
+        return _startDuration;
+    }
+
     public static String getState(LifeCycle lc)
     {
         if (lc instanceof AbstractLifeCycle)
@@ -246,8 +259,9 @@ public abstract class AbstractLifeCycle implements LifeCycle
         if (_state == State.STARTING)
         {
             _state = State.STARTED;
+            _startDuration = NanoTime.millisSince(_startingNanoTime);
             if (LOG.isDebugEnabled())
-                LOG.debug("STARTED @{}ms {}", Uptime.getUptime(), this);
+                LOG.debug("STARTED @{}ms in {}ms {}", Uptime.getUptime(), _startDuration, this);
             for (EventListener listener : _eventListener)
                 if (listener instanceof Listener)
                     ((Listener)listener).lifeCycleStarted(this);
@@ -258,6 +272,7 @@ public abstract class AbstractLifeCycle implements LifeCycle
     {
         if (LOG.isDebugEnabled())
             LOG.debug("STARTING {}", this);
+        _startingNanoTime = NanoTime.now();
         _state = State.STARTING;
         for (EventListener listener : _eventListener)
             if (listener instanceof Listener)
@@ -119,7 +119,14 @@ public interface Dumpable
             }
 
             if (o instanceof LifeCycle)
-                out.append(s).append(" - ").append((AbstractLifeCycle.getState((LifeCycle)o))).append("\n");
+            {
+                String state = AbstractLifeCycle.getState((LifeCycle)o);
+                out.append(s).append(" - ").append(state);
+                // Report slow starts, so that the dump shows where the startup time is spent.
+                if (o instanceof AbstractLifeCycle lifeCycle && AbstractLifeCycle.STARTED.equals(state) && lifeCycle.getStartDuration() > 0)
+                    out.append(" in ").append(Long.toString(lifeCycle.getStartDuration())).append("ms");
+                out.append("\n");
+            }
             else
                 out.append(s).append("\n");
         }
@@ -0,0 +1,152 @@
+//
+// ========================================================================
+// Copyright (c) 1995 Mort Bay Consulting Pty Ltd and others.
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License v. 2.0 which is available at
+// https://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+// ========================================================================
+//
+
+package org.eclipse.jetty.util.compression;
+
+import java.io.IOException;
+import java.nio.ByteBuffer;
+import java.util.List;
+import java.util.ServiceLoader;
+
+import org.eclipse.jetty.util.TypeUtil;
+import org.eclipse.jetty.util.annotation.ManagedAttribute;
+import org.eclipse.jetty.util.annotation.ManagedObject;
+import org.eclipse.jetty.util.component.ContainerLifeCycle;
+
+/**
+ * <p>A content coding, such as {@code gzip}, that compresses and decompresses bytes with
+ * {@link Encoder} and {@link Decoder} instances, typically pooled with a {@link CompressionPool}.</p>
+ * <p>Jetty provides {@link GzipCompression} and {@link DeflateCompression}; other codings, such as
+ * {@code br} or {@code zstd} that need a native or third party library, may be provided as
+ * {@link ServiceLoader} services and are then found by {@link #getProvidedCompressions()}.</p>
+ * <p>A {@code Compression} should be started, so that its pools are started, before acquiring
+ * encoders or decoders.</p>
+ */
+@ManagedObject
+public abstract class Compression extends ContainerLifeCycle
+{
+    private final String _encoding;
+
+    protected Compression(String encoding)
+    {
+        _encoding = encoding;
+    }
+
+    /**
+     * @return the content coding name, as used in the {@code Accept-Encoding} and {@code Content-Encoding} headers
+     */
+    @ManagedAttribute("The content coding name")
+    public String getEncoding()
+    {
+        return _encoding;
+    }
+
+    /**
+     * @return an encoder, that must be released with {@link Encoder#release()} when no longer used
+     */
+    public abstract Encoder newEncoder();
+
+    /**
+     * @return a decoder, that must be released with {@link Decoder#release()} when no longer used
+     */
+    public abstract Decoder newDecoder();
+
+    /**
+     * @return new instances of the {@code Compression}s provided as {@link ServiceLoader} services
+     */
+    public static List<Compression> getProvidedCompressions()
+    {
+        return TypeUtil.serviceStream(ServiceLoader.load(Compression.class)).toList();
+    }
+
+    @Override
+    public String toString()
+    {
+        return String.format("%s@%x{%s,%s}", getClass().getSimpleName(), hashCode(), getState(), _encoding);
+    }
+
+    /**
+     * <p>A streaming compressor, with the same usage pattern as {@link java.util.zip.Deflater}.</p>
+     */
+    public interface Encoder
+    {
+        /**
+         * @param input the bytes to compress, that are consumed by subsequent calls
+         * to {@link #encode(ByteBuffer, boolean)} until {@link #needsInput()} returns true
+         */
+        void setInput(ByteBuffer input);
+
+        /**
+         * @return whether the input has been consumed and more input can be set
+         */
+        boolean needsInput();
+
+        /**
+         * <p>Indicates that no more input will be set, so that the encoding can be completed.</p>
+         */
+        void finish();
+
+        /**
+         * @return whether all the encoded bytes, including any trailer, have been produced
+         */
+        boolean isFinished();
+
+        /**
+         * @param output the buffer, in fill mode, to put the encoded bytes into
+         * @param flush whether all the input consumed so far must be encoded before returning,
+         * so that it can be decoded by the remote peer
+         * @return the number of bytes put into the output buffer
+         * @throws IOException if the bytes cannot be encoded
+         */
+        int encode(ByteBuffer output, boolean flush) throws IOException;
+
+        /**
+         * <p>Releases this encoder, possibly to a pool.</p>
+         */
+        void release();
+    }
+
+    /**
+     * <p>A streaming decompressor, with the same usage pattern as {@link java.util.zip.Inflater}.</p>
+     */
+    public interface Decoder
+    {
+        /**
+         * @param input the bytes to decompress, that are consumed by subsequent calls
+         * to {@link #decode(ByteBuffer)} until {@link #needsInput()} returns true
+         */
+        void setInput(ByteBuffer input);
+
+        /**
+         * @return whether the input has been consumed and more input can be set
+         */
+        boolean needsInput();
+
+        /**
+         * @return whether the end of the encoded stream has been decoded
+         */
+        boolean isFinished();
+
+        /**
+         * @param output the buffer, in fill mode, to put the decoded bytes into
+         * @return the number of bytes put into the output buffer
+         * @throws IOException if the bytes are not a valid encoding
+         */
+        int decode(ByteBuffer output) throws IOException;
+
+        /**
+         * <p>Releases this decoder, possibly to a pool.</p>
+         */
+        void release();
+    }
+}
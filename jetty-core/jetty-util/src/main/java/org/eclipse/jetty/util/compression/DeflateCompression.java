@@ -0,0 +1,201 @@
+//
+// ========================================================================
+// Copyright (c) 1995 Mort Bay Consulting Pty Ltd and others.
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License v. 2.0 which is available at
+// https://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+// ========================================================================
+//
+
+package org.eclipse.jetty.util.compression;
+
+import java.io.IOException;
+import java.nio.ByteBuffer;
+import java.util.zip.DataFormatException;
+import java.util.zip.Deflater;
+import java.util.zip.Inflater;
+import java.util.zip.ZipException;
+
+/**
+ * <p>The {@code deflate} content coding, that is the zlib format of RFC 1950,
+ * implemented with pooled {@link Deflater} and {@link Inflater} instances.</p>
+ */
+public class DeflateCompression extends Compression
+{
+    public static final String DEFLATE = "deflate";
+
+    private final DeflaterPool _deflaterPool;
+    private final InflaterPool _inflaterPool;
+
+    public DeflateCompression()
+    {
+        this(new DeflaterPool(CompressionPool.DEFAULT_CAPACITY, Deflater.DEFAULT_COMPRESSION, false),
+            new InflaterPool(CompressionPool.DEFAULT_CAPACITY, false));
+    }
+
+    /**
+     * @param deflaterPool the pool of {@link Deflater}s, which must not use the {@code nowrap} mode
+     * @param inflaterPool the pool of {@link Inflater}s, which must not use the {@code nowrap} mode
+     */
+    public DeflateCompression(DeflaterPool deflaterPool, InflaterPool inflaterPool)
+    {
+        this(DEFLATE, deflaterPool, inflaterPool);
+    }
+
+    protected DeflateCompression(String encoding, DeflaterPool deflaterPool, InflaterPool inflaterPool)
+    {
+        super(encoding);
+        _deflaterPool = deflaterPool;
+        _inflaterPool = inflaterPool;
+        addBean(_deflaterPool);
+        addBean(_inflaterPool);
+    }
+
+    public DeflaterPool getDeflaterPool()
+    {
+        return _deflaterPool;
+    }
+
+    public InflaterPool getInflaterPool()
+    {
+        return _inflaterPool;
+    }
+
+    @Override
+    public Encoder newEncoder()
+    {
+        return new DeflaterEncoder(_deflaterPool.acquire());
+    }
+
+    @Override
+    public Decoder newDecoder()
+    {
+        return new InflaterDecoder(_inflaterPool.acquire());
+    }
+
+    /**
+     * <p>An {@link Encoder} that delegates to a pooled {@link Deflater}.</p>
+     */
+    protected static class DeflaterEncoder implements Encoder
+    {
+        private final DeflaterPool.Entry _entry;
+        protected final Deflater _deflater;
+
+        protected DeflaterEncoder(DeflaterPool.Entry entry)
+        {
+            _entry = entry;
+            _deflater = entry.get();
+        }
+
+        @Override
+        public void setInput(ByteBuffer input)
+        {
+            _deflater.setInput(input);
+        }
+
+        @Override
+        public boolean needsInput()
+        {
+            return _deflater.needsInput();
+        }
+
+        @Override
+        public void finish()
+        {
+            _deflater.finish();
+        }
+
+        @Override
+        public boolean isFinished()
+        {
+            return _deflater.finished();
+        }
+
+        @Override
+        public int encode(ByteBuffer output, boolean flush) throws IOException
+        {
+            if (_deflater.finished())
+                return 0;
+            return _deflater.deflate(output, flush ? Deflater.SYNC_FLUSH : Deflater.NO_FLUSH);
+        }
+
+        @Override
+        public void release()
+        {
+            _entry.release();
+        }
+
+        @Override
+        public String toString()
+        {
+            return String.format("%s@%x{in=%d,out=%d}", getClass().getSimpleName(), hashCode(), _deflater.getBytesRead(), _deflater.getBytesWritten());
+        }
+    }
+
+    /**
+     * <p>A {@link Decoder} that delegates to a pooled {@link Inflater}.</p>
+     */
+    protected static class InflaterDecoder implements Decoder
+    {
+        private final InflaterPool.Entry _entry;
+        protected final Inflater _inflater;
+
+        protected InflaterDecoder(InflaterPool.Entry entry)
+        {
+            _entry = entry;
+            _inflater = entry.get();
+        }
+
+        @Override
+        public void setInput(ByteBuffer input)
+        {
+            _inflater.setInput(input);
+        }
+
+        @Override
+        public boolean needsInput()
+        {
+            return _inflater.needsInput();
+        }
+
+        @Override
+        public boolean isFinished()
+        {
+            return _inflater.finished();
+        }
+
+        @Override
+        public int decode(ByteBuffer output) throws IOException
+        {
+            if (_inflater.finished())
+                return 0;
+            try
+            {
+                int decoded = _inflater.inflate(output);
+                if (decoded == 0 && _inflater.needsDictionary())
+                    throw new ZipException("Preset dictionary not supported");
+                return decoded;
+            }
+            catch (DataFormatException x)
+            {
+                throw new ZipException(x.getMessage());
+            }
+        }
+
+        @Override
+        public void release()
+        {
+            _entry.release();
+        }
+
+        @Override
+        public String toString()
+        {
+            return String.format("%s@%x{in=%d,out=%d}", getClass().getSimpleName(), hashCode(), _inflater.getBytesRead(), _inflater.getBytesWritten());
+        }
+    }
+}
@@ -0,0 +1,297 @@
+//
+// ========================================================================
+// Copyright (c) 1995 Mort Bay Consulting Pty Ltd and others.
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License v. 2.0 which is available at
+// https://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+// ========================================================================
+//
+
+package org.eclipse.jetty.util.compression;
+
+import java.io.IOException;
+import java.nio.ByteBuffer;
+import java.util.zip.CRC32;
+import java.util.zip.Deflater;
+import java.util.zip.ZipException;
+
+/**
+ * <p>The {@code gzip} content coding of RFC 1952, implemented by framing
+ * the raw deflate format of pooled {@code nowrap} deflaters and inflaters
+ * with the gzip header and trailer.</p>
+ */
+public class GzipCompression extends DeflateCompression
+{
+    public static final String GZIP = "gzip";
+
+    private static final byte[] HEADER = {0x1F, (byte)0x8B, Deflater.DEFLATED, 0, 0, 0, 0, 0, 0, (byte)0xFF};
+    private static final int TRAILER_LENGTH = 8;
+    private static final int FHCRC = 0x02;
+    private static final int FEXTRA = 0x04;
+    private static final int FNAME = 0x08;
+    private static final int FCOMMENT = 0x10;
+
+    public GzipCompression()
+    {
+        this(new DeflaterPool(CompressionPool.DEFAULT_CAPACITY, Deflater.DEFAULT_COMPRESSION, true),
+            new InflaterPool(CompressionPool.DEFAULT_CAPACITY, true));
+    }
+
+    /**
+     * @param deflaterPool the pool of {@link Deflater}s, which must use the {@code nowrap} mode
+     * @param inflaterPool the pool of {@link java.util.zip.Inflater}s, which must use the {@code nowrap} mode
+     */
+    public GzipCompression(DeflaterPool deflaterPool, InflaterPool inflaterPool)
+    {
+        super(GZIP, deflaterPool, inflaterPool);
+    }
+
+    @Override
+    public Encoder newEncoder()
+    {
+        return newEncoder(getDeflaterPool().acquire());
+    }
+
+    @Override
+    public Decoder newDecoder()
+    {
+        return new GzipDecoder(getInflaterPool().acquire());
+    }
+
+    /**
+     * @param entry a pooled {@code nowrap} deflater
+     * @return a gzip encoder that releases the given entry when it is released
+     */
+    public static Encoder newEncoder(DeflaterPool.Entry entry)
+    {
+        return new GzipEncoder(entry);
+    }
+
+    private static class GzipEncoder extends DeflaterEncoder
+    {
+        private final CRC32 _crc = new CRC32();
+        private int _header;
+        private int _trailer;
+
+        private GzipEncoder(DeflaterPool.Entry entry)
+        {
+            super(entry);
+        }
+
+        @Override
+        public void setInput(ByteBuffer input)
+        {
+            _crc.update(input.slice());
+            super.setInput(input);
+        }
+
+        @Override
+        public boolean isFinished()
+        {
+            return _trailer == TRAILER_LENGTH;
+        }
+
+        @Override
+        public int encode(ByteBuffer output, boolean flush) throws IOException
+        {
+            int start = output.position();
+            while (_header < HEADER.length && output.hasRemaining())
+            {
+                output.put(HEADER[_header++]);
+            }
+            if (_header < HEADER.length)
+                return output.position() - start;
+
+            super.encode(output, flush);
+
+            if (_deflater.finished())
+            {
+                long crc = _crc.getValue();
+                long size = _deflater.getBytesRead();
+                while (_trailer < TRAILER_LENGTH && output.hasRemaining())
+                {
+                    long value = _trailer < 4 ? crc : size;
+                    output.put((byte)(value >>> (8 * (_trailer % 4))));
+                    ++_trailer;
+                }
+            }
+            return output.position() - start;
+        }
+    }
+
+    private static class GzipDecoder extends InflaterDecoder
+    {
+        private final CRC32 _crc = new CRC32();
+        private final byte[] _bytes = new byte[HEADER.length];
+        private ByteBuffer _input;
+        private State _state = State.HEADER;
+        private int _count;
+        private int _flags;
+        private int _length;
+
+        private GzipDecoder(InflaterPool.Entry entry)
+        {
+            super(entry);
+        }
+
+        @Override
+        public void setInput(ByteBuffer input)
+        {
+            _input = input;
+            // SPEC: RFC 1952, a gzip stream may have multiple members.
+            if (_state == State.FINISHED && input.hasRemaining())
+                _state = State.HEADER;
+            if (_state == State.DATA)
+                super.setInput(input);
+        }
+
+        @Override
+        public boolean needsInput()
+        {
+            return _input == null || !_input.hasRemaining();
+        }
+
+        @Override
+        public boolean isFinished()
+        {
+            return _state == State.FINISHED;
+        }
+
+        @Override
+        public int decode(ByteBuffer output) throws IOException
+        {
+            while (true)
+            {
+                switch (_state)
+                {
+                    case HEADER ->
+                    {
+                        if (!fill(HEADER.length))
+                            return 0;
+                        if ((_bytes[0] & 0xFF) != 0x1F || (_bytes[1] & 0xFF) != 0x8B)
+                            throw new ZipException("Invalid gzip bytes");
+                        if (_bytes[2] != Deflater.DEFLATED)
+                            throw new ZipException("Invalid gzip compression method");
+                        _flags = _bytes[3] & 0xFF;
+                        _crc.reset();
+                        _state = State.EXTRA_LENGTH;
+                    }
+                    case EXTRA_LENGTH ->
+                    {
+                        if ((_flags & FEXTRA) == 0)
+                        {
+                            _state = State.NAME;
+                            continue;
+                        }
+                        if (!fill(2))
+                            return 0;
+                        _length = (_bytes[0] & 0xFF) | ((_bytes[1] & 0xFF) << 8);
+                        _state = State.EXTRA;
+                    }
+                    case EXTRA ->
+                    {
+                        int skip = Math.min(_length, _input == null ? 0 : _input.remaining());
+                        if (skip > 0)
+                            _input.position(_input.position() + skip);
+                        _length -= skip;
+                        if (_length > 0)
+                            return 0;
+                        _state = State.NAME;
+                    }
+                    case NAME ->
+                    {
+                        if ((_flags & FNAME) != 0 && !skipZeroTerminated())
+                            return 0;
+                        _state = State.COMMENT;
+                    }
+                    case COMMENT ->
+                    {
+                        if ((_flags & FCOMMENT) != 0 && !skipZeroTerminated())
+                            return 0;
+                        _state = State.HCRC;
+                    }
+                    case HCRC ->
+                    {
+                        if ((_flags & FHCRC) != 0 && !fill(2))
+                            return 0;
+                        _state = State.DATA;
+                        if (_input != null)
+                            super.setInput(_input);
+                    }
+                    case DATA ->
+                    {
+                        int start = output.position();
+                        int decoded = super.decode(output);
+                        if (decoded > 0)
+                        {
+                            ByteBuffer produced = output.duplicate();
+                            produced.limit(output.position());
+                            produced.position(start);
+                            _crc.update(produced);
+                        }
+                        if (!_inflater.finished())
+                            return decoded;
+                        _state = State.TRAILER;
+                        if (decoded > 0)
+                            return decoded;
+                    }
+                    case TRAILER ->
+                    {
+                        if (!fill(TRAILER_LENGTH))
+                            return 0;
+                        if (getInt(0) != (int)_crc.getValue())
+                            throw new ZipException("Invalid gzip CRC");
+                        if (getInt(4) != (int)_inflater.getBytesWritten())
+                            throw new ZipException("Invalid gzip size");
+                        _inflater.reset();
+                        // SPEC: RFC 1952, another member may follow.
+                        _state = _input != null && _input.hasRemaining() ? State.HEADER : State.FINISHED;
+                    }
+                    case FINISHED ->
+                    {
+                        return 0;
+                    }
+                }
+            }
+        }
+
+        private boolean fill(int length)
+        {
+            while (_count < length)
+            {
+                if (_input == null || !_input.hasRemaining())
+                    return false;
+                _bytes[_count++] = _input.get();
+            }
+            _count = 0;
+            return true;
+        }
+
+        private boolean skipZeroTerminated()
+        {
+            while (_input != null && _input.hasRemaining())
+            {
+                if (_input.get() == 0)
+                    return true;
+            }
+            return false;
+        }
+
+        private int getInt(int offset)
+        {
+            return (_bytes[offset] & 0xFF) |
+                ((_bytes[offset + 1] & 0xFF) << 8) |
+                ((_bytes[offset + 2] & 0xFF) << 16) |
+                ((_bytes[offset + 3] & 0xFF) << 24);
+        }
+
+        private enum State
+        {
+            HEADER, EXTRA_LENGTH, EXTRA, NAME, COMMENT, HCRC, DATA, TRAILER, FINISHED
+        }
+    }
+}
@@ -0,0 +1,323 @@
+//
+// ========================================================================
+// Copyright (c) 1995 Mort Bay Consulting Pty Ltd and others.
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License v. 2.0 which is available at
+// https://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+// ========================================================================
+//
+
+package org.eclipse.jetty.util.statistic;
+
+import java.io.IOException;
+import java.util.concurrent.atomic.AtomicLongArray;
+import java.util.concurrent.atomic.AtomicReferenceArray;
+
+import org.eclipse.jetty.util.ProcessorUtils;
+import org.eclipse.jetty.util.TypeUtil;
+import org.eclipse.jetty.util.component.Dumpable;
+import org.eclipse.jetty.util.thread.AutoLock;
+
+/**
+ * <p>Statistics on a sampled value that, in addition to those of {@link SampleStatistic},
+ * provides the distribution of the samples, so that percentiles such as the p99 or
+ * the p999 can be reported.</p>
+ * <p>Samples are counted in a log-linear histogram, in the style of the
+ * <a href="https://hdrhistogram.github.io/HdrHistogram/">HdrHistogram</a>:
+ * every power of 2 range of values is split in {@code 2^precision} linear buckets,
+ * so that the value reported for a percentile has a relative error of at most
+ * {@code 2^-precision}, for any value from {@code 0} to {@link Long#MAX_VALUE}.</p>
+ * <p>The bucket counters are sharded across recording threads, to reduce the
+ * contention of concurrent recordings; the shards are allocated lazily and
+ * merged when a {@link Snapshot} is taken.</p>
+ * <p>A {@link #snapshot() snapshot} reports the distribution of all the samples
+ * since the last {@link #reset()}, while an {@link #intervalSnapshot() interval
+ * snapshot} reports the distribution of the samples recorded since the previous
+ * interval snapshot.</p>
+ */
+public class HistogramStatistic extends SampleStatistic implements Dumpable
+{
+    private static final int MAX_SHARDS = 8;
+
+    private final AutoLock _lock = new AutoLock();
+    private final int _precision;
+    private final int _length;
+    private final AtomicReferenceArray<AtomicLongArray> _shards;
+    private final int _mask;
+    private long[] _intervalCounts;
+    private long _intervalTotal;
+
+    public HistogramStatistic()
+    {
+        this(5);
+    }
+
+    /**
+     * @param precision the number of bits of precision of the recorded values,
+     * between {@code 1} and {@code 10}, where the relative error is {@code 2^-precision}
+     */
+    public HistogramStatistic(int precision)
+    {
+        this(precision, Math.min(MAX_SHARDS, ProcessorUtils.availableProcessors()));
+    }
+
+    /**
+     * @param precision the number of bits of precision of the recorded values,
+     * between {@code 1} and {@code 10}, where the relative error is {@code 2^-precision}
+     * @param shards the max number of shards to spread concurrent recordings
+     */
+    public HistogramStatistic(int precision, int shards)
+    {
+        if (precision < 1 || precision > 10)
+            throw new IllegalArgumentException("Invalid precision " + precision);
+        if (shards < 1)
+            throw new IllegalArgumentException("Invalid shards " + shards);
+        _precision = precision;
+        _length = (Long.SIZE - precision) << precision;
+        shards = TypeUtil.ceilToNextPowerOfTwo(shards);
+        _shards = new AtomicReferenceArray<>(shards);
+        _mask = shards - 1;
+        _intervalCounts = new long[_length];
+    }
+
+    /**
+     * @return the number of bits of precision of the recorded values
+     */
+    public int getPrecision()
+    {
+        return _precision;
+    }
+
+    @Override
+    public void reset()
+    {
+        try (AutoLock ignored = _lock.lock())
+        {
+            super.reset();
+            for (int i = 0; i < _shards.length(); ++i)
+            {
+                _shards.set(i, null);
+            }
+            _intervalCounts = new long[_length];
+            _intervalTotal = 0;
+        }
+    }
+
+    @Override
+    public void record(long sample)
+    {
+        super.record(sample);
+        shard().incrementAndGet(index(Math.max(0, sample)));
+    }
+
+    private AtomicLongArray shard()
+    {
+        int index = (int)Thread.currentThread().getId() & _mask;
+        AtomicLongArray shard = _shards.get(index);
+        if (shard == null)
+        {
+            _shards.compareAndSet(index, null, new AtomicLongArray(_length));
+            shard = _shards.get(index);
+        }
+        return shard;
+    }
+
+    private int index(long value)
+    {
+        int bits = Long.SIZE - Long.numberOfLeadingZeros(value);
+        if (bits <= _precision)
+            return (int)value;
+        // Keep the most significant bit plus the precision bits.
+        int shift = bits - _precision - 1;
+        int subBucket = (int)(value >>> shift) - (1 << _precision);
+        return ((shift + 1) << _precision) + subBucket;
+    }
+
+    private long highestValue(int index)
+    {
+        int subBuckets = 1 << _precision;
+        if (index < subBuckets)
+            return index;
+        int shift = (index >>> _precision) - 1;
+        long lowest = (long)(subBuckets + (index & (subBuckets - 1))) << shift;
+        return lowest + (1L << shift) - 1;
+    }
+
+    private long[] counts()
+    {
+        long[] counts = new long[_length];
+        for (int s = 0; s < _shards.length(); ++s)
+        {
+            AtomicLongArray shard = _shards.get(s);
+            if (shard == null)
+                continue;
+            for (int i = 0; i < _length; ++i)
+            {
+                counts[i] += shard.get(i);
+            }
+        }
+        return counts;
+    }
+
+    /**
+     * @return a snapshot of the distribution of the samples recorded since the last {@link #reset()}
+     */
+    public Snapshot snapshot()
+    {
+        return new Snapshot(counts(), getTotal(), getMax());
+    }
+
+    /**
+     * <p>Returns a snapshot of the distribution of the samples recorded since the
+     * previous invocation of this method, or since the last {@link #reset()}.</p>
+     * <p>The max value of an interval snapshot is the highest value of the
+     * bucket of the max sample, rather than the exact max sample.</p>
+     *
+     * @return a snapshot of the samples recorded in the last interval
+     */
+    public Snapshot intervalSnapshot()
+    {
+        try (AutoLock ignored = _lock.lock())
+        {
+            long[] counts = counts();
+            long total = getTotal();
+            long[] interval = new long[_length];
+            long max = 0;
+            for (int i = 0; i < _length; ++i)
+            {
+                interval[i] = counts[i] - _intervalCounts[i];
+                if (interval[i] > 0)
+                    max = highestValue(i);
+            }
+            Snapshot snapshot = new Snapshot(interval, total - _intervalTotal, Math.min(max, getMax()));
+            _intervalCounts = counts;
+            _intervalTotal = total;
+            return snapshot;
+        }
+    }
+
+    /**
+     * @param percentile the percentile, between {@code 0} and {@code 100}
+     * @return the value at the given percentile of the samples recorded since the last {@link #reset()}
+     * @see Snapshot#getValueAtPercentile(double)
+     */
+    public long getValueAtPercentile(double percentile)
+    {
+        return snapshot().getValueAtPercentile(percentile);
+    }
+
+    @Override
+    public void dump(Appendable out, String indent) throws IOException
+    {
+        Dumpable.dumpObject(out, this);
+    }
+
+    @Override
+    public String toString()
+    {
+        Snapshot snapshot = snapshot();
+        return String.format("%s@%x{count=%d,max=%d,mean=%f,stddev=%f,p50=%d,p90=%d,p99=%d,p999=%d}",
+            getClass().getSimpleName(),
+            hashCode(),
+            snapshot.getCount(),
+            snapshot.getMax(),
+            getMean(),
+            getStdDev(),
+            snapshot.getValueAtPercentile(50),
+            snapshot.getValueAtPercentile(90),
+            snapshot.getValueAtPercentile(99),
+            snapshot.getValueAtPercentile(99.9));
+    }
+
+    /**
+     * <p>An immutable view of the distribution of recorded samples.</p>
+     */
+    public class Snapshot
+    {
+        private final long[] _counts;
+        private final long _count;
+        private final long _total;
+        private final long _max;
+
+        private Snapshot(long[] counts, long total, long max)
+        {
+            _counts = counts;
+            long count = 0;
+            for (long c : counts)
+            {
+                count += c;
+            }
+            _count = count;
+            _total = total;
+            _max = max;
+        }
+
+        /**
+         * @return the number of samples
+         */
+        public long getCount()
+        {
+            return _count;
+        }
+
+        /**
+         * @return the max sample, or zero if there are no samples
+         */
+        public long getMax()
+        {
+            return _max;
+        }
+
+        /**
+         * @return the average of the samples, or zero if there are no samples
+         */
+        public double getMean()
+        {
+            return _count > 0 ? (double)_total / _count : 0.0D;
+        }
+
+        /**
+         * <p>Returns the value below which the given percentage of samples fall.</p>
+         * <p>The value returned is the highest value that is equivalent,
+         * within the precision of the histogram, to the samples at the
+         * given percentile, and it is never greater than the {@link #getMax() max}.</p>
+         *
+         * @param percentile the percentile, between {@code 0} and {@code 100}
+         * @return the value at the given percentile, or zero if there are no samples
+         */
+        public long getValueAtPercentile(double percentile)
+        {
+            if (_count == 0)
+                return 0;
+            double clamped = Math.min(100.0D, Math.max(0.0D, percentile));
+            long rank = Math.max(1, (long)Math.ceil(clamped / 100.0D * _count));
+            long cumulative = 0;
+            for (int i = 0; i < _counts.length; ++i)
+            {
+                cumulative += _counts[i];
+                if (cumulative >= rank)
+                    return Math.min(highestValue(i), _max);
+            }
+            return _max;
+        }
+
+        @Override
+        public String toString()
+        {
+            return String.format("%s@%x{count=%d,max=%d,mean=%f,p50=%d,p90=%d,p99=%d,p999=%d}",
+                getClass().getSimpleName(),
+                hashCode(),
+                getCount(),
+                getMax(),
+                getMean(),
+                getValueAtPercentile(50),
+                getValueAtPercentile(90),
+                getValueAtPercentile(99),
+                getValueAtPercentile(99.9));
+        }
+    }
+}
@@ -21,7 +21,7 @@ import org.eclipse.jetty.util.annotation.ManagedAttribute;
 import org.eclipse.jetty.util.annotation.ManagedObject;
 import org.eclipse.jetty.util.annotation.ManagedOperation;
 import org.eclipse.jetty.util.statistic.CounterStatistic;
-import org.eclipse.jetty.util.statistic.SampleStatistic;
+import org.eclipse.jetty.util.statistic.HistogramStatistic;
 
 /**
  * <p>A {@link QueuedThreadPool} subclass that monitors its own activity by recording queue and task statistics.</p>
@@ -30,8 +30,8 @@ import org.eclipse.jetty.util.statistic.SampleStatistic;
 public class MonitoredQueuedThreadPool extends QueuedThreadPool
 {
     private final CounterStatistic queueStats = new CounterStatistic();
-    private final SampleStatistic queueLatencyStats = new SampleStatistic();
-    private final SampleStatistic taskLatencyStats = new SampleStatistic();
+    private final HistogramStatistic queueLatencyStats = new HistogramStatistic();
+    private final HistogramStatistic taskLatencyStats = new HistogramStatistic();
     private final CounterStatistic threadStats = new CounterStatistic();
 
     public MonitoredQueuedThreadPool()
@@ -145,6 +145,32 @@ public class MonitoredQueuedThreadPool extends QueuedThreadPool
         return queueLatencyStats.getMax();
     }
 
+    /**
+     * @return the 99th percentile of the time a task remains in the queue, in nanoseconds
+     */
+    @ManagedAttribute("the 99th percentile of the time a task remains in the queue, in nanoseconds")
+    public long getQueueLatencyP99()
+    {
+        return queueLatencyStats.getValueAtPercentile(99);
+    }
+
+    /**
+     * @return the 99.9th percentile of the time a task remains in the queue, in nanoseconds
+     */
+    @ManagedAttribute("the 99.9th percentile of the time a task remains in the queue, in nanoseconds")
+    public long getQueueLatencyP999()
+    {
+        return queueLatencyStats.getValueAtPercentile(99.9);
+    }
+
+    /**
+     * @return the statistic of the time tasks remain in the queue, in nanoseconds
+     */
+    public HistogramStatistic getQueueLatencyStatistic()
+    {
+        return queueLatencyStats;
+    }
+
     /**
      * @return the average task execution time, in nanoseconds
      */
@@ -162,4 +188,21 @@ public class MonitoredQueuedThreadPool extends QueuedThreadPool
     {
         return taskLatencyStats.getMax();
     }
+
+    /**
+     * @return the 99th percentile of the task execution time, in nanoseconds
+     */
+    @ManagedAttribute("the 99th percentile of the task execution time, in nanoseconds")
+    public long getTaskLatencyP99()
+    {
+        return taskLatencyStats.getValueAtPercentile(99);
+    }
+
+    /**
+     * @return the statistic of the task execution time, in nanoseconds
+     */
+    public HistogramStatistic getTaskLatencyStatistic()
+    {
+        return taskLatencyStats;
+    }
 }
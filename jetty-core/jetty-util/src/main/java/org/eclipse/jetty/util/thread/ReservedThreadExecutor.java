@@ -108,14 +108,15 @@ public class ReservedThreadExecutor extends ContainerLifeCycle implements TryExe
      * is calculated based on a heuristic from the number of available processors and
      * thread pool size.
      * @return the number of reserved threads that would be used by a ReservedThreadExecutor
-     * constructed with these arguments.
+     * constructed with these arguments, always 0 if the executor uses virtual threads,
+     * since blocking tasks are then consumed by virtual threads instead of reserved threads.
      */
     public static int reservedThreads(Executor executor, int capacity)
     {
-        if (capacity >= 0)
-            return capacity;
         if (VirtualThreads.isUseVirtualThreads(executor))
             return 0;
+        if (capacity >= 0)
+            return capacity;
         int cpus = ProcessorUtils.availableProcessors();
         if (executor instanceof ThreadPool.SizedThreadPool)
         {
@@ -0,0 +1,378 @@
+//
+// ========================================================================
+// Copyright (c) 1995 Mort Bay Consulting Pty Ltd and others.
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License v. 2.0 which is available at
+// https://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+// ========================================================================
+//
+
+package org.eclipse.jetty.util.thread;
+
+import java.io.IOException;
+import java.util.Queue;
+import java.util.concurrent.ConcurrentLinkedQueue;
+import java.util.concurrent.TimeUnit;
+import java.util.concurrent.atomic.AtomicInteger;
+import java.util.concurrent.atomic.LongAdder;
+import java.util.concurrent.locks.LockSupport;
+
+import org.eclipse.jetty.util.NanoTime;
+import org.eclipse.jetty.util.StringUtil;
+import org.eclipse.jetty.util.annotation.ManagedAttribute;
+import org.eclipse.jetty.util.annotation.ManagedObject;
+import org.eclipse.jetty.util.annotation.Name;
+import org.eclipse.jetty.util.component.AbstractLifeCycle;
+import org.eclipse.jetty.util.component.Dumpable;
+import org.slf4j.Logger;
+import org.slf4j.LoggerFactory;
+
+/**
+ * <p>A {@link Scheduler} based on a hashed timing wheel.</p>
+ * <p>The wheel is an array of buckets, each covering a tick of time.
+ * A task is placed in the bucket of the tick at which it expires, along with
+ * the number of wheel revolutions that must elapse before it expires.
+ * A single thread advances the wheel one tick at a time and runs the tasks
+ * of the current bucket that have no revolutions left.</p>
+ * <p>Scheduling and cancelling a task are O(1) operations that do not take
+ * any lock: scheduled tasks are queued and moved to their bucket by the wheel
+ * thread at the next tick, and cancelled tasks are unlinked from their bucket
+ * at the next tick.
+ * This makes this scheduler suitable for large numbers of timeouts that are
+ * mostly cancelled or rescheduled before they expire, such as the idle timeouts
+ * of many mostly idle connections, whose lazy rescheduling in {@code IdleTimeout}
+ * and {@code CyclicTimeout} already minimizes the scheduler traffic.</p>
+ * <p>Tasks never run before their delay has elapsed, but may run up to one
+ * {@link #getTickDuration() tick} late; tasks run by the wheel thread must
+ * therefore be quick, typically dispatching to an executor.</p>
+ */
+@ManagedObject
+public class TimingWheelScheduler extends AbstractLifeCycle implements Scheduler, Dumpable
+{
+    private static final Logger LOG = LoggerFactory.getLogger(TimingWheelScheduler.class);
+
+    private final Queue<WheelTask> scheduled = new ConcurrentLinkedQueue<>();
+    private final Queue<WheelTask> cancelled = new ConcurrentLinkedQueue<>();
+    private final LongAdder expired = new LongAdder();
+    private final AtomicInteger size = new AtomicInteger();
+    private final String name;
+    private final boolean daemon;
+    private final long tickNanos;
+    private final int wheelSize;
+    private Bucket[] wheel;
+    private long startNanoTime;
+    private long tick;
+    private volatile Thread thread;
+
+    public TimingWheelScheduler()
+    {
+        this(null, false);
+    }
+
+    public TimingWheelScheduler(String name, boolean daemon)
+    {
+        this(name, daemon, 50, 512);
+    }
+
+    /**
+     * @param name the name of the wheel thread, or null for automatic name
+     * @param daemon whether the wheel thread is daemon
+     * @param tickDuration the duration of a tick of the wheel, in milliseconds
+     * @param wheelSize the number of buckets of the wheel, rounded up to a power of 2
+     */
+    public TimingWheelScheduler(@Name("name") String name, @Name("daemon") boolean daemon, @Name("tickDuration") long tickDuration, @Name("wheelSize") int wheelSize)
+    {
+        if (tickDuration <= 0)
+            throw new IllegalArgumentException("Invalid tick duration " + tickDuration);
+        if (wheelSize <= 0 || wheelSize > 1 << 30)
+            throw new IllegalArgumentException("Invalid wheel size " + wheelSize);
+        this.name = StringUtil.isBlank(name) ? "Scheduler-" + hashCode() : name;
+        this.daemon = daemon;
+        this.tickNanos = TimeUnit.MILLISECONDS.toNanos(tickDuration);
+        int size = 1;
+        while (size < wheelSize)
+        {
+            size <<= 1;
+        }
+        this.wheelSize = size;
+    }
+
+    @ManagedAttribute("The name of the scheduler")
+    public String getName()
+    {
+        return name;
+    }
+
+    @ManagedAttribute("Whether the scheduler uses daemon threads")
+    public boolean isDaemon()
+    {
+        return daemon;
+    }
+
+    @ManagedAttribute("The duration in ms of a tick of the wheel")
+    public long getTickDuration()
+    {
+        return TimeUnit.NANOSECONDS.toMillis(tickNanos);
+    }
+
+    @ManagedAttribute("The number of buckets of the wheel")
+    public int getWheelSize()
+    {
+        return wheelSize;
+    }
+
+    @ManagedAttribute("The number of tasks scheduled and not yet expired or cancelled")
+    public int getSize()
+    {
+        return size.get();
+    }
+
+    @ManagedAttribute("The number of tasks that expired")
+    public long getExpiredCount()
+    {
+        return expired.sum();
+    }
+
+    @Override
+    protected void doStart() throws Exception
+    {
+        Bucket[] wheel = new Bucket[wheelSize];
+        for (int i = 0; i < wheel.length; ++i)
+        {
+            wheel[i] = new Bucket();
+        }
+        this.wheel = wheel;
+        this.startNanoTime = NanoTime.now();
+        this.tick = 1;
+        Thread thread = new Thread(this::run, name);
+        thread.setDaemon(daemon);
+        this.thread = thread;
+        super.doStart();
+        thread.start();
+    }
+
+    @Override
+    protected void doStop() throws Exception
+    {
+        Thread thread = this.thread;
+        this.thread = null;
+        if (thread != null)
+        {
+            LockSupport.unpark(thread);
+            if (thread != Thread.currentThread())
+                thread.join();
+        }
+        scheduled.clear();
+        cancelled.clear();
+        wheel = null;
+        size.set(0);
+        super.doStop();
+    }
+
+    @Override
+    public Task schedule(Runnable task, long delay, TimeUnit unit)
+    {
+        if (thread == null)
+            return () -> false;
+        // Clamp the delay so that the deadline cannot overflow, as ScheduledThreadPoolExecutor does.
+        long delayNanos = Math.min(Math.max(0, unit.toNanos(delay)), Long.MAX_VALUE >> 1);
+        WheelTask wheelTask = new WheelTask(task, NanoTime.now() + delayNanos);
+        size.incrementAndGet();
+        scheduled.offer(wheelTask);
+        return wheelTask;
+    }
+
+    private void run()
+    {
+        Thread thread = Thread.currentThread();
+        while (this.thread == thread)
+        {
+            long deadline = startNanoTime + tick * tickNanos;
+            long wait = deadline - NanoTime.now();
+            if (wait > 0)
+            {
+                LockSupport.parkNanos(this, wait);
+                continue;
+            }
+
+            removeCancelled();
+            addScheduled();
+            expire(wheel[(int)(tick & (wheelSize - 1))]);
+            ++tick;
+        }
+    }
+
+    private void removeCancelled()
+    {
+        while (true)
+        {
+            WheelTask task = cancelled.poll();
+            if (task == null)
+                return;
+            // The task may have been cancelled before it was added to a bucket.
+            if (task.bucket != null)
+                task.bucket.remove(task);
+        }
+    }
+
+    private void addScheduled()
+    {
+        while (true)
+        {
+            WheelTask task = scheduled.poll();
+            if (task == null)
+                return;
+            if (task.state.get() != WheelTask.SCHEDULED)
+                continue;
+            // Round the expiration tick up, so that tasks never expire early.
+            long elapsed = task.deadline - startNanoTime;
+            long expiration = elapsed <= 0 ? 0 : (elapsed + tickNanos - 1) / tickNanos;
+            expiration = Math.max(expiration, tick);
+            task.rounds = (expiration - tick) / wheelSize;
+            wheel[(int)(expiration & (wheelSize - 1))].add(task);
+        }
+    }
+
+    private void expire(Bucket bucket)
+    {
+        WheelTask task = bucket.head;
+        while (task != null)
+        {
+            WheelTask next = task.next;
+            if (task.rounds <= 0)
+            {
+                bucket.remove(task);
+                if (task.state.compareAndSet(WheelTask.SCHEDULED, WheelTask.EXPIRED))
+                {
+                    size.decrementAndGet();
+                    expired.increment();
+                    task.run();
+                }
+            }
+            else
+            {
+                --task.rounds;
+            }
+            task = next;
+        }
+    }
+
+    @Override
+    public void dump(Appendable out, String indent) throws IOException
+    {
+        Thread thread = this.thread;
+        if (thread == null)
+            Dumpable.dumpObject(out, this);
+        else
+            Dumpable.dumpObjects(out, indent, this, (Object[])thread.getStackTrace());
+    }
+
+    @Override
+    public String toString()
+    {
+        return String.format("%s@%x[%s,tick=%dms,wheel=%d,size=%d]",
+            getClass().getSimpleName(),
+            hashCode(),
+            getState(),
+            getTickDuration(),
+            getWheelSize(),
+            getSize());
+    }
+
+    /**
+     * <p>A doubly linked list of tasks, only accessed by the wheel thread.</p>
+     */
+    private static class Bucket
+    {
+        private WheelTask head;
+        private WheelTask tail;
+
+        private void add(WheelTask task)
+        {
+            task.bucket = this;
+            task.prev = tail;
+            if (tail == null)
+                head = task;
+            else
+                tail.next = task;
+            tail = task;
+        }
+
+        private void remove(WheelTask task)
+        {
+            if (task.bucket != this)
+                return;
+            WheelTask prev = task.prev;
+            WheelTask next = task.next;
+            if (prev == null)
+                head = next;
+            else
+                prev.next = next;
+            if (next == null)
+                tail = prev;
+            else
+                next.prev = prev;
+            task.bucket = null;
+            task.prev = null;
+            task.next = null;
+        }
+    }
+
+    private class WheelTask implements Task
+    {
+        private static final int SCHEDULED = 0;
+        private static final int EXPIRED = 1;
+        private static final int CANCELLED = 2;
+
+        private final AtomicInteger state = new AtomicInteger(SCHEDULED);
+        private final Runnable task;
+        private final long deadline;
+        // Fields below are only accessed by the wheel thread.
+        private long rounds;
+        private Bucket bucket;
+        private WheelTask prev;
+        private WheelTask next;
+
+        private WheelTask(Runnable task, long deadline)
+        {
+            this.task = task;
+            this.deadline = deadline;
+        }
+
+        @Override
+        public boolean cancel()
+        {
+            if (!state.compareAndSet(SCHEDULED, CANCELLED))
+                return false;
+            size.decrementAndGet();
+            cancelled.offer(this);
+            return true;
+        }
+
+        private void run()
+        {
+            try
+            {
+                task.run();
+            }
+            catch (Throwable x)
+            {
+                LOG.warn("Exception while executing task {}", task, x);
+            }
+        }
+
+        @Override
+        public String toString()
+        {
+            return String.format("%s.%s@%x[%s]",
+                TimingWheelScheduler.class.getSimpleName(),
+                WheelTask.class.getSimpleName(),
+                hashCode(),
+                task);
+        }
+    }
+}
@@ -0,0 +1,1004 @@
+//
+// ========================================================================
+// Copyright (c) 1995 Mort Bay Consulting Pty Ltd and others.
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License v. 2.0 which is available at
+// https://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+// ========================================================================
+//
+
+package org.eclipse.jetty.util.thread;
+
+import java.io.Closeable;
+import java.io.IOException;
+import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.List;
+import java.util.Queue;
+import java.util.Set;
+import java.util.concurrent.ConcurrentHashMap;
+import java.util.concurrent.ConcurrentLinkedDeque;
+import java.util.concurrent.ConcurrentLinkedQueue;
+import java.util.concurrent.Executor;
+import java.util.concurrent.RejectedExecutionException;
+import java.util.concurrent.TimeUnit;
+import java.util.concurrent.atomic.AtomicInteger;
+import java.util.concurrent.atomic.LongAdder;
+import java.util.concurrent.locks.LockSupport;
+
+import org.eclipse.jetty.util.NanoTime;
+import org.eclipse.jetty.util.VirtualThreads;
+import org.eclipse.jetty.util.annotation.ManagedAttribute;
+import org.eclipse.jetty.util.annotation.ManagedObject;
+import org.eclipse.jetty.util.annotation.Name;
+import org.eclipse.jetty.util.component.ContainerLifeCycle;
+import org.eclipse.jetty.util.component.DumpableCollection;
+import org.slf4j.Logger;
+import org.slf4j.LoggerFactory;
+
+/**
+ * <p>A {@link ThreadPool.SizedThreadPool} where each worker thread owns a deque of jobs
+ * and idle workers steal jobs from busy ones.</p>
+ * <p>A job executed by a worker of this pool is pushed to the head of that worker's deque
+ * and is normally run later by the same worker, while the data it touches is still in the
+ * caches of that CPU; other workers only take jobs from the tail of the deque when they run
+ * out of work. So that older jobs are not starved by a steady stream of new ones, a worker
+ * periodically takes the oldest job of its own deque instead of the newest. A job executed by any other thread is queued to the submission queue of a
+ * worker group. There is no queue shared by all the threads, so the head and the tail of
+ * a single queue do not become a point of contention when there are many threads.</p>
+ * <p>Workers are partitioned into {@link #setGroups(int) groups}: an idle worker looks for
+ * work in its own group before stealing from other groups.
+ * The JVM does not allow to bind threads to CPUs or NUMA nodes, so groups are a logical
+ * affinity; configuring one group per socket keeps related jobs on the same set of threads,
+ * that the operating system tends to schedule on the same CPUs.
+ * {@link #getExecutor(int)} returns an executor bound to a group, for example to pin a
+ * selector and the jobs it produces to a group.</p>
+ * <p>{@link #tryExecute(Runnable)} hands the task directly to an idle worker, preferably of
+ * the current group, so the idle workers act as the reserved threads used by
+ * {@link org.eclipse.jetty.util.thread.strategy.AdaptiveExecutionStrategy} to execute-produce-consume.
+ * Before running a {@link Invocable.InvocationType#BLOCKING blocking} job, a worker that has
+ * other jobs in its deque wakes up another worker to steal them, so they are not delayed
+ * for as long as the blocking job blocks.</p>
+ */
+@ManagedObject("A work stealing thread pool")
+public class WorkStealingThreadPool extends ContainerLifeCycle implements ThreadPool.SizedThreadPool, TryExecutor, VirtualThreads.Configurable
+{
+    private static final Logger LOG = LoggerFactory.getLogger(WorkStealingThreadPool.class);
+    private static final int ACTIVE = 0;
+    private static final int IDLE = 1;
+    private static final int CLAIMED = 2;
+    // Every so many polls, a worker takes the oldest job of its own deque rather than the newest.
+    private static final int OLDEST_JOB_INTERVAL = 32;
+
+    private final AtomicInteger _threads = new AtomicInteger();
+    private final AtomicInteger _idle = new AtomicInteger();
+    private final LongAdder _queued = new LongAdder();
+    private final Set<Worker> _workers = ConcurrentHashMap.newKeySet();
+    private final AutoLock.WithCondition _joinLock = new AutoLock.WithCondition();
+    private final ThreadPoolBudget _budget;
+    private volatile Group[] _workerGroups = new Group[0];
+    private String _name = "wstp" + hashCode();
+    private volatile int _minThreads;
+    private volatile int _maxThreads;
+    private volatile int _idleTimeout;
+    private int _groups = 1;
+    private int _priority = Thread.NORM_PRIORITY;
+    private boolean _daemon;
+    private long _stopTimeout = 5000;
+    private volatile boolean _active;
+    private Executor _virtualThreadsExecutor;
+
+    public WorkStealingThreadPool()
+    {
+        this(200);
+    }
+
+    public WorkStealingThreadPool(@Name("maxThreads") int maxThreads)
+    {
+        this(maxThreads, Math.min(8, maxThreads));
+    }
+
+    public WorkStealingThreadPool(@Name("maxThreads") int maxThreads, @Name("minThreads") int minThreads)
+    {
+        this(maxThreads, minThreads, 60000);
+    }
+
+    public WorkStealingThreadPool(@Name("maxThreads") int maxThreads, @Name("minThreads") int minThreads, @Name("idleTimeout") int idleTimeout)
+    {
+        if (maxThreads < minThreads)
+            throw new IllegalArgumentException("max threads (" + maxThreads + ") cannot be less than min threads (" + minThreads + ")");
+        _maxThreads = maxThreads;
+        _minThreads = minThreads;
+        _idleTimeout = idleTimeout;
+        _budget = new ThreadPoolBudget(this);
+    }
+
+    @Override
+    public ThreadPoolBudget getThreadPoolBudget()
+    {
+        return _budget;
+    }
+
+    /**
+     * @return the name of this thread pool
+     */
+    @ManagedAttribute("name of the thread pool")
+    public String getName()
+    {
+        return _name;
+    }
+
+    /**
+     * @param name the name of this thread pool, used to name threads
+     */
+    public void setName(String name)
+    {
+        if (isRunning())
+            throw new IllegalStateException(getState());
+        _name = name;
+    }
+
+    @Override
+    @ManagedAttribute("minimum number of threads in the pool")
+    public int getMinThreads()
+    {
+        return _minThreads;
+    }
+
+    @Override
+    public void setMinThreads(int minThreads)
+    {
+        _minThreads = minThreads;
+        if (_minThreads > _maxThreads)
+            _maxThreads = _minThreads;
+        if (isStarted())
+            ensureThreads();
+    }
+
+    @Override
+    @ManagedAttribute("maximum number of threads in the pool")
+    public int getMaxThreads()
+    {
+        return _maxThreads;
+    }
+
+    @Override
+    public void setMaxThreads(int maxThreads)
+    {
+        if (_budget != null)
+            _budget.check(maxThreads);
+        _maxThreads = maxThreads;
+        if (_minThreads > _maxThreads)
+            _minThreads = _maxThreads;
+    }
+
+    /**
+     * @return the maximum thread idle time in ms
+     */
+    @ManagedAttribute("maximum time a thread may be idle in ms")
+    public int getIdleTimeout()
+    {
+        return _idleTimeout;
+    }
+
+    /**
+     * <p>Sets the maximum thread idle time in ms.</p>
+     * <p>Threads that are idle for longer than this period may be stopped,
+     * as long as the pool has more than {@link #getMinThreads()} threads.</p>
+     *
+     * @param idleTimeout the maximum thread idle time in ms, or a non positive value to never stop idle threads
+     */
+    public void setIdleTimeout(int idleTimeout)
+    {
+        _idleTimeout = idleTimeout;
+    }
+
+    /**
+     * @return the number of worker groups
+     */
+    @ManagedAttribute("number of worker groups")
+    public int getGroups()
+    {
+        return _groups;
+    }
+
+    /**
+     * <p>Sets the number of worker groups, typically to the number of CPU sockets of the host.</p>
+     * <p>Idle workers look for work in their own group before stealing from other groups.</p>
+     *
+     * @param groups the number of worker groups
+     */
+    public void setGroups(int groups)
+    {
+        if (isRunning())
+            throw new IllegalStateException(getState());
+        if (groups < 1)
+            throw new IllegalArgumentException("groups (" + groups + ") must be positive");
+        _groups = groups;
+    }
+
+    public int getThreadsPriority()
+    {
+        return _priority;
+    }
+
+    public void setThreadsPriority(int priority)
+    {
+        _priority = priority;
+    }
+
+    /**
+     * @return whether this thread pool uses daemon threads
+     */
+    @ManagedAttribute("whether this thread pool uses daemon threads")
+    public boolean isDaemon()
+    {
+        return _daemon;
+    }
+
+    /**
+     * @param daemon whether this thread pool uses daemon threads
+     * @see Thread#setDaemon(boolean)
+     */
+    public void setDaemon(boolean daemon)
+    {
+        _daemon = daemon;
+    }
+
+    /**
+     * @return the time in ms to wait for the worker threads to exit when this pool is stopped
+     */
+    public long getStopTimeout()
+    {
+        return _stopTimeout;
+    }
+
+    /**
+     * @param stopTimeout the time in ms to wait for the worker threads to exit when this pool is stopped
+     */
+    public void setStopTimeout(long stopTimeout)
+    {
+        _stopTimeout = stopTimeout;
+    }
+
+    @Override
+    public Executor getVirtualThreadsExecutor()
+    {
+        return _virtualThreadsExecutor;
+    }
+
+    @Override
+    public void setVirtualThreadsExecutor(Executor executor)
+    {
+        try
+        {
+            VirtualThreads.Configurable.super.setVirtualThreadsExecutor(executor);
+            _virtualThreadsExecutor = executor;
+        }
+        catch (UnsupportedOperationException ignored)
+        {
+        }
+    }
+
+    @Override
+    @ManagedAttribute("number of threads in the pool")
+    public int getThreads()
+    {
+        return _threads.get();
+    }
+
+    @Override
+    @ManagedAttribute("number of idle threads in the pool")
+    public int getIdleThreads()
+    {
+        return _idle.get();
+    }
+
+    /**
+     * @return the number of jobs waiting to be run, in the submission queues and in the worker deques
+     */
+    @ManagedAttribute("number of jobs waiting for a thread")
+    public int getQueueSize()
+    {
+        return Math.max(0, _queued.intValue());
+    }
+
+    @Override
+    @ManagedAttribute(value = "thread pool is low on threads", readonly = true)
+    public boolean isLowOnThreads()
+    {
+        return getMaxThreads() - getThreads() + getIdleThreads() - getQueueSize() <= 0;
+    }
+
+    /**
+     * <p>Returns an executor that queues jobs to the given worker group, and that
+     * prefers the idle workers of that group for {@link TryExecutor#tryExecute(Runnable)}.</p>
+     * <p>Jobs executed by a worker of that group are still pushed to the worker's own deque.</p>
+     *
+     * @param group the group index, taken modulo the number of groups
+     * @return an executor bound to the given worker group
+     */
+    public TryExecutor getExecutor(int group)
+    {
+        return new GroupExecutor(group);
+    }
+
+    @Override
+    protected void doStart() throws Exception
+    {
+        int groups = Math.max(1, Math.min(_groups, _maxThreads));
+        Group[] workerGroups = new Group[groups];
+        for (int i = 0; i < groups; ++i)
+        {
+            workerGroups[i] = new Group(i);
+        }
+        _workerGroups = workerGroups;
+        _active = true;
+        try
+        {
+            super.doStart();
+            ensureThreads();
+        }
+        catch (Throwable x)
+        {
+            // Do not leave behind the workers already started.
+            stopWorkers();
+            throw x;
+        }
+    }
+
+    @Override
+    protected void doStop() throws Exception
+    {
+        if (LOG.isDebugEnabled())
+            LOG.debug("Stopping {}", this);
+
+        super.doStop();
+        stopWorkers();
+
+        if (_budget != null)
+            _budget.reset();
+
+        try (AutoLock.WithCondition l = _joinLock.lock())
+        {
+            l.signalAll();
+        }
+    }
+
+    private void stopWorkers()
+    {
+        _active = false;
+
+        // Idle workers notice that the pool is no longer running when woken up.
+        for (Worker worker : _workers)
+        {
+            LockSupport.unpark(worker);
+        }
+
+        long timeout = getStopTimeout();
+        if (timeout > 0)
+        {
+            long stopBy = NanoTime.now() + TimeUnit.MILLISECONDS.toNanos(timeout);
+            joinWorkers(stopBy);
+            for (Worker worker : _workers)
+            {
+                if (worker != Thread.currentThread())
+                    worker.interrupt();
+            }
+            joinWorkers(stopBy);
+            for (Worker worker : _workers)
+            {
+                if (worker != Thread.currentThread())
+                    LOG.warn("Couldn't stop {}", worker);
+            }
+        }
+
+        // Close any un-executed jobs.
+        for (Group group : _workerGroups)
+        {
+            close(group._jobs);
+            for (Worker worker : group._members)
+            {
+                close(worker._jobs);
+            }
+        }
+    }
+
+    private boolean isActive()
+    {
+        return _active && isRunning();
+    }
+
+    private void joinWorkers(long stopByNanos)
+    {
+        for (Worker worker : _workers)
+        {
+            if (worker == Thread.currentThread())
+                continue;
+            long canWait = NanoTime.millisUntil(stopByNanos);
+            if (canWait <= 0)
+                return;
+            try
+            {
+                worker.join(canWait);
+            }
+            catch (InterruptedException x)
+            {
+                LOG.trace("IGNORED", x);
+                return;
+            }
+        }
+    }
+
+    private void close(Queue<Runnable> jobs)
+    {
+        while (true)
+        {
+            Runnable job = jobs.poll();
+            if (job == null)
+                break;
+            _queued.decrement();
+            if (job instanceof Closeable closeable)
+            {
+                try
+                {
+                    closeable.close();
+                }
+                catch (Throwable t)
+                {
+                    LOG.warn("Unable to close job: {}", job, t);
+                }
+            }
+            else
+            {
+                LOG.warn("Stopped without executing or closing {}", job);
+            }
+        }
+    }
+
+    /**
+     * Blocks until the thread pool is {@link org.eclipse.jetty.util.component.LifeCycle} stopped.
+     */
+    @Override
+    public void join() throws InterruptedException
+    {
+        try (AutoLock.WithCondition l = _joinLock.lock())
+        {
+            while (isRunning())
+            {
+                l.await();
+            }
+        }
+
+        while (isStopping())
+        {
+            Thread.sleep(1);
+        }
+    }
+
+    @Override
+    public void execute(Runnable job)
+    {
+        execute(null, job);
+    }
+
+    private void execute(Group target, Runnable job)
+    {
+        Group[] groups = _workerGroups;
+        if (!isActive() || groups.length == 0)
+            throw new RejectedExecutionException(job.toString());
+
+        Worker worker = currentWorker();
+        Group group;
+        if (worker != null && (target == null || target == worker._group))
+        {
+            group = worker._group;
+            worker._jobs.offerFirst(job);
+        }
+        else
+        {
+            group = target == null ? groups[groupIndex(groups.length)] : target;
+            group._jobs.offer(job);
+        }
+        _queued.increment();
+
+        if (LOG.isDebugEnabled())
+            LOG.debug("queue {} to {} in {}", job, group, this);
+
+        signal(group);
+    }
+
+    @Override
+    public boolean tryExecute(Runnable task)
+    {
+        return tryExecute(null, task);
+    }
+
+    private boolean tryExecute(Group target, Runnable task)
+    {
+        Group[] groups = _workerGroups;
+        if (!isActive() || groups.length == 0)
+            return false;
+
+        Group group = target;
+        if (group == null)
+        {
+            Worker worker = currentWorker();
+            group = worker == null ? groups[groupIndex(groups.length)] : worker._group;
+        }
+        if (group.wakeIdle(task))
+            return true;
+        for (int i = 1; i < groups.length; ++i)
+        {
+            if (groups[(group._id + i) % groups.length].wakeIdle(task))
+                return true;
+        }
+        return false;
+    }
+
+    /**
+     * <p>Makes sure that a thread will look for the job just queued to the given group:
+     * an idle worker of the group is woken up, or else an idle worker of another
+     * group, or else a new worker is started in the group.</p>
+     */
+    private void signal(Group group)
+    {
+        if (group.wakeIdle(null))
+            return;
+        Group[] groups = _workerGroups;
+        if (_idle.get() > 0)
+        {
+            for (int i = 1; i < groups.length; ++i)
+            {
+                if (groups[(group._id + i) % groups.length].wakeIdle(null))
+                    return;
+            }
+        }
+        startWorker(group, null);
+    }
+
+    private void ensureThreads()
+    {
+        while (isActive() && _threads.get() < _minThreads)
+        {
+            Group[] groups = _workerGroups;
+            if (!startWorker(groups[_threads.get() % groups.length], null))
+                break;
+        }
+    }
+
+    private boolean startWorker(Group group, Runnable job)
+    {
+        while (true)
+        {
+            int threads = _threads.get();
+            if (threads >= _maxThreads)
+                return false;
+            if (_threads.compareAndSet(threads, threads + 1))
+                break;
+        }
+
+        boolean started = false;
+        try
+        {
+            Worker worker = PrivilegedThreadFactory.newThread(() -> newWorker(group, job));
+            if (LOG.isDebugEnabled())
+                LOG.debug("Starting {}", worker);
+            _workers.add(worker);
+            group.addMember(worker);
+            worker.start();
+            started = true;
+        }
+        finally
+        {
+            if (!started)
+                _threads.decrementAndGet();
+        }
+        return true;
+    }
+
+    private Worker newWorker(Group group, Runnable job)
+    {
+        Worker worker = new Worker(group, job);
+        worker.setDaemon(isDaemon());
+        worker.setPriority(getThreadsPriority());
+        worker.setName(_name + "-" + group._id + "-" + worker.getId());
+        worker.setContextClassLoader(getClass().getClassLoader());
+        return worker;
+    }
+
+    private Worker currentWorker()
+    {
+        return Thread.currentThread() instanceof Worker worker && worker.getPool() == this ? worker : null;
+    }
+
+    private static int groupIndex(int groups)
+    {
+        // Threads that are not workers of this pool always submit to the same group.
+        return groups == 1 ? 0 : (int)(Thread.currentThread().getId() % groups);
+    }
+
+    protected void runJob(Runnable job)
+    {
+        job.run();
+    }
+
+    protected void onJobFailure(Throwable x)
+    {
+        LOG.warn("Job failed", x);
+    }
+
+    @Override
+    public void dump(Appendable out, String indent) throws IOException
+    {
+        List<Object> threads = new ArrayList<>();
+        for (Worker worker : _workers)
+        {
+            threads.add(String.format("%d %s %s %s @ %s",
+                worker.getId(),
+                worker.getName(),
+                worker._state.get() == ACTIVE ? "ACTIVE" : "IDLE",
+                worker.getState(),
+                worker.getStackTrace().length > 0 ? worker.getStackTrace()[0] : "<no_stack_frames>"));
+        }
+        dumpObjects(out, indent,
+            new DumpableCollection("groups", Arrays.asList(_workerGroups)),
+            new DumpableCollection("threads", threads));
+    }
+
+    @Override
+    public String toString()
+    {
+        return String.format("%s[%s]@%x{%s,%d<=%d<=%d,i=%d,g=%d,q=%d}",
+            getClass().getSimpleName(),
+            _name,
+            hashCode(),
+            getState(),
+            getMinThreads(),
+            getThreads(),
+            getMaxThreads(),
+            getIdleThreads(),
+            getGroups(),
+            getQueueSize());
+    }
+
+    /**
+     * <p>A group of workers, with a submission queue for the jobs
+     * executed by threads that are not workers of the group.</p>
+     */
+    private class Group
+    {
+        private final int _id;
+        private final ConcurrentLinkedQueue<Runnable> _jobs = new ConcurrentLinkedQueue<>();
+        private final ConcurrentLinkedDeque<Worker> _idleWorkers = new ConcurrentLinkedDeque<>();
+        private final AutoLock _lock = new AutoLock();
+        private volatile Worker[] _members = new Worker[0];
+
+        private Group(int id)
+        {
+            _id = id;
+        }
+
+        private void addMember(Worker worker)
+        {
+            try (AutoLock l = _lock.lock())
+            {
+                Worker[] members = Arrays.copyOf(_members, _members.length + 1);
+                members[members.length - 1] = worker;
+                _members = members;
+            }
+        }
+
+        private void removeMember(Worker worker)
+        {
+            try (AutoLock l = _lock.lock())
+            {
+                _members = Arrays.stream(_members).filter(w -> w != worker).toArray(Worker[]::new);
+            }
+        }
+
+        /**
+         * @param job the job to hand to the worker, or null to have it look for a queued job
+         * @return whether an idle worker of this group was woken up
+         */
+        private boolean wakeIdle(Runnable job)
+        {
+            // The most recently idle worker is the most likely to still have warm caches.
+            Worker worker;
+            while ((worker = _idleWorkers.pollFirst()) != null)
+            {
+                if (worker.claim(job))
+                    return true;
+            }
+            return false;
+        }
+
+        /**
+         * @param thief the worker looking for a job
+         * @return a job from the submission queue, or stolen from the tail of a member's deque, or null
+         */
+        private Runnable poll(Worker thief)
+        {
+            Runnable job = _jobs.poll();
+            if (job != null)
+                return job;
+            Worker[] members = _members;
+            int length = members.length;
+            if (length == 0)
+                return null;
+            // Start from a different member for each thief to spread the steals.
+            int start = Math.floorMod(thief._seed++, length);
+            for (int i = 0; i < length; ++i)
+            {
+                Worker victim = members[(start + i) % length];
+                if (victim == thief)
+                    continue;
+                job = victim._jobs.pollLast();
+                if (job != null)
+                    return job;
+            }
+            return null;
+        }
+
+        @Override
+        public String toString()
+        {
+            return String.format("%s@%d{members=%d,idle=%d,queue=%d}", getClass().getSimpleName(), _id, _members.length, _idleWorkers.size(), _jobs.size());
+        }
+    }
+
+    private class GroupExecutor implements TryExecutor, VirtualThreads.Configurable
+    {
+        private final int _index;
+
+        private GroupExecutor(int index)
+        {
+            _index = index;
+        }
+
+        private Group getGroup()
+        {
+            Group[] groups = _workerGroups;
+            return groups.length == 0 ? null : groups[Math.floorMod(_index, groups.length)];
+        }
+
+        @Override
+        public void execute(Runnable job)
+        {
+            WorkStealingThreadPool.this.execute(getGroup(), job);
+        }
+
+        @Override
+        public boolean tryExecute(Runnable task)
+        {
+            return WorkStealingThreadPool.this.tryExecute(getGroup(), task);
+        }
+
+        @Override
+        public Executor getVirtualThreadsExecutor()
+        {
+            return WorkStealingThreadPool.this.getVirtualThreadsExecutor();
+        }
+
+        @Override
+        public String toString()
+        {
+            return String.format("%s@%x[%d]{%s}", getClass().getSimpleName(), hashCode(), _index, WorkStealingThreadPool.this);
+        }
+    }
+
+    private class Worker extends Thread
+    {
+        private final Group _group;
+        private final ConcurrentLinkedDeque<Runnable> _jobs = new ConcurrentLinkedDeque<>();
+        private final AtomicInteger _state = new AtomicInteger(ACTIVE);
+        private Runnable _handoff;
+        private int _seed;
+        private int _polls;
+
+        private Worker(Group group, Runnable job)
+        {
+            _group = group;
+            _handoff = job;
+            _seed = (int)getId();
+        }
+
+        private WorkStealingThreadPool getPool()
+        {
+            return WorkStealingThreadPool.this;
+        }
+
+        @Override
+        public void run()
+        {
+            if (LOG.isDebugEnabled())
+                LOG.debug("Worker started for {}", WorkStealingThreadPool.this);
+
+            boolean shrunk = false;
+            try
+            {
+                Runnable job = _handoff;
+                _handoff = null;
+                while (isActive())
+                {
+                    if (job == null)
+                        job = poll();
+                    if (job == null)
+                        job = idle();
+                    if (job == null)
+                    {
+                        if (shrink())
+                        {
+                            shrunk = true;
+                            break;
+                        }
+                        continue;
+                    }
+                    doRunJob(job);
+                    job = null;
+                }
+            }
+            finally
+            {
+                _workers.remove(this);
+                _group.removeMember(this);
+                if (!shrunk)
+                    _threads.decrementAndGet();
+                if (LOG.isDebugEnabled())
+                    LOG.debug("{} exited for {}", this, WorkStealingThreadPool.this);
+                // Give the jobs left in the deque to the other workers of the group.
+                Runnable job;
+                while ((job = _jobs.pollLast()) != null)
+                {
+                    _group._jobs.offer(job);
+                }
+                if (isActive() && !_group._jobs.isEmpty())
+                    signal(_group);
+                ensureThreads();
+            }
+        }
+
+        /**
+         * @return a job from this worker's deque, or from this worker's group, or from other groups, or null
+         */
+        private Runnable poll()
+        {
+            Runnable job = ++_polls % OLDEST_JOB_INTERVAL == 0 ? _jobs.pollLast() : _jobs.pollFirst();
+            if (job == null)
+                job = _group.poll(this);
+            if (job == null)
+            {
+                Group[] groups = _workerGroups;
+                for (int i = 1; i < groups.length && job == null; ++i)
+                {
+                    job = groups[(_group._id + i) % groups.length].poll(this);
+                }
+            }
+            if (job != null)
+                _queued.decrement();
+            return job;
+        }
+
+        /**
+         * <p>Parks this worker until it is handed a job, or it is woken up
+         * to look for queued jobs, or the idle timeout expires.</p>
+         *
+         * @return the job to run or null if the idle timeout expired or the pool is stopping
+         */
+        private Runnable idle()
+        {
+            while (true)
+            {
+                _state.set(IDLE);
+                _idle.incrementAndGet();
+                _group._idleWorkers.offerFirst(this);
+
+                // A job may have been queued before this worker became visible as idle.
+                Runnable job = poll();
+                if (job != null)
+                {
+                    if (unidle())
+                        return job;
+                    // Claimed concurrently, give the job back for another worker to run.
+                    _jobs.offerLast(job);
+                    _queued.increment();
+                }
+
+                int idleTimeout = getIdleTimeout();
+                long deadline = NanoTime.now() + TimeUnit.MILLISECONDS.toNanos(idleTimeout);
+                while (_state.get() != ACTIVE)
+                {
+                    long remaining = deadline - NanoTime.now();
+                    if (!isActive() || (idleTimeout > 0 && remaining <= 0))
+                    {
+                        if (unidle())
+                            return null;
+                        // Being claimed, wait for the handoff to complete.
+                        Thread.onSpinWait();
+                    }
+                    else if (idleTimeout > 0)
+                    {
+                        LockSupport.parkNanos(this, remaining);
+                    }
+                    else
+                    {
+                        LockSupport.park(this);
+                    }
+                }
+
+                Runnable handoff = _handoff;
+                _handoff = null;
+                if (!_jobs.isEmpty())
+                    signal(_group);
+                if (handoff == null)
+                    handoff = poll();
+                if (handoff != null || !isActive())
+                    return handoff;
+            }
+        }
+
+        /**
+         * @param job the job to run, or null to look for a queued job
+         * @return whether this idle worker has been claimed
+         */
+        private boolean claim(Runnable job)
+        {
+            if (!_state.compareAndSet(IDLE, CLAIMED))
+                return false;
+            _idle.decrementAndGet();
+            _handoff = job;
+            _state.set(ACTIVE);
+            LockSupport.unpark(this);
+            return true;
+        }
+
+        private boolean unidle()
+        {
+            if (!_state.compareAndSet(IDLE, ACTIVE))
+                return false;
+            _idle.decrementAndGet();
+            _group._idleWorkers.remove(this);
+            return true;
+        }
+
+        private boolean shrink()
+        {
+            if (!isActive())
+                return false;
+            while (true)
+            {
+                int threads = _threads.get();
+                if (threads <= _minThreads)
+                    return false;
+                if (_threads.compareAndSet(threads, threads - 1))
+                    return true;
+            }
+        }
+
+        private void doRunJob(Runnable job)
+        {
+            // Do not hold back the jobs queued behind a job that may block.
+            if (!_jobs.isEmpty() && Invocable.getInvocationType(job) == Invocable.InvocationType.BLOCKING)
+                signal(_group);
+            try
+            {
+                if (LOG.isDebugEnabled())
+                    LOG.debug("run {} in {}", job, WorkStealingThreadPool.this);
+                runJob(job);
+            }
+            catch (Throwable x)
+            {
+                onJobFailure(x);
+            }
+            finally
+            {
+                // Clear any thread interrupted status.
+                Thread.interrupted();
+            }
+        }
+    }
+}
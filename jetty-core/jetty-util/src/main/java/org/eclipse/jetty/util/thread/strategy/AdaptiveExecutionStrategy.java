@@ -63,13 +63,19 @@ import org.slf4j.LoggerFactory;
  *     <dt>EPC</dt>
  *     <dd>If the producing thread is not {@link Invocable.InvocationType#NON_BLOCKING}
  *     and a pending producer thread is available, either because there is already a pending producer
- *     or one is successfully started with {@link TryExecutor#tryExecute(Runnable)}.</dd>
+ *     or one is successfully started with {@link TryExecutor#tryExecute(Runnable)}, unless the
+ *     produced task is {@link Invocable.InvocationType#BLOCKING} and virtual threads are used.</dd>
  *     <dt>PIC</dt>
  *     <dd>If the produced task is {@link Invocable.InvocationType#EITHER} and EPC was not selected.</dd>
  *     <dt>PEC</dt>
  *     <dd>Otherwise.</dd>
  * </dl>
  *
+ * <p>When the executor is {@link VirtualThreads.Configurable configured} to use virtual threads,
+ * every {@link Invocable.InvocationType#BLOCKING} task is consumed in {@code PEC} mode by a new
+ * virtual thread, so that blocking tasks never hold a platform thread, and the producing
+ * platform thread continues to produce.</p>
+ *
  * <p>Because of the preference for {@code PC} mode, on a multicore machine with many
  * many {@link Invocable.InvocationType#NON_BLOCKING} tasks, multiple instances of the strategy may be
  * required to keep all CPUs on the system busy.</p>
@@ -364,6 +370,11 @@ public class AdaptiveExecutionStrategy extends ContainerLifeCycle implements Exe
             {
                 // The produced task may block.
 
+                // If virtual threads are available, the task is better consumed by a
+                // virtual thread than by a platform thread taken from the reserve.
+                if (_virtualExecutor != null)
+                    return SubStrategy.PRODUCE_EXECUTE_CONSUME;
+
                 // If the calling producing thread may also block
                 if (!nonBlocking)
                 {
@@ -17,6 +17,7 @@ import java.io.ByteArrayOutputStream;
 import java.io.IOException;
 import java.nio.BufferOverflowException;
 import java.nio.ByteBuffer;
+import java.nio.charset.StandardCharsets;
 import java.nio.file.Path;
 import java.util.Arrays;
 import java.util.concurrent.ThreadLocalRandom;
@@ -371,4 +372,29 @@ public class BufferUtilTest
             assertThat(BufferUtil.toMappedBuffer(jarResource), nullValue());
         }
     }
+
+    @Test
+    public void testPutUtf8()
+    {
+        String[] values = {"", "ascii only", "caf\u00e9", "\u20ac100", "emoji \uD83D\uDE00!", "mixed \u00e9\u20ac\uD83D\uDE00 end"};
+        for (String value : values)
+        {
+            byte[] expected = value.getBytes(StandardCharsets.UTF_8);
+            assertThat(BufferUtil.utf8Length(value), is(expected.length));
+            ByteBuffer buffer = BufferUtil.allocate(expected.length);
+            int pos = BufferUtil.flipToFill(buffer);
+            BufferUtil.putUtf8(buffer, new StringBuilder(value));
+            BufferUtil.flipToFlush(buffer, pos);
+            assertThat(BufferUtil.toString(buffer, StandardCharsets.UTF_8), is(value));
+        }
+
+        // An unpaired surrogate is replaced, as String.getBytes() does.
+        String broken = "a\uD83Db";
+        assertThat(BufferUtil.utf8Length(broken), is(3));
+        ByteBuffer buffer = BufferUtil.allocate(3);
+        int pos = BufferUtil.flipToFill(buffer);
+        BufferUtil.putUtf8(buffer, broken);
+        BufferUtil.flipToFlush(buffer, pos);
+        assertThat(BufferUtil.toString(buffer, StandardCharsets.UTF_8), is(new String(broken.getBytes(StandardCharsets.UTF_8), StandardCharsets.UTF_8)));
+    }
 }
@@ -15,6 +15,7 @@ package org.eclipse.jetty.util;
 
 import java.nio.ByteBuffer;
 import java.nio.charset.StandardCharsets;
+import java.util.Arrays;
 import java.util.concurrent.ThreadLocalRandom;
 
 import org.junit.jupiter.api.Test;
@@ -231,4 +232,48 @@ public class SearchPatternTest
         int partialMatch = pattern.endsWith(data, 0, length);
         System.err.println("match1: " + partialMatch);
     }
+
+    @Test
+    public void testMatchAgainstNaiveSearch()
+    {
+        ThreadLocalRandom random = ThreadLocalRandom.current();
+        for (int patternLength = 1; patternLength <= 24; patternLength++)
+        {
+            for (int run = 0; run < 50; run++)
+            {
+                // A small alphabet to have many partial matches.
+                byte[] data = new byte[random.nextInt(128)];
+                for (int i = 0; i < data.length; i++)
+                {
+                    data[i] = (byte)('a' + random.nextInt(3));
+                }
+                byte[] p = new byte[patternLength];
+                for (int i = 0; i < p.length; i++)
+                {
+                    p[i] = (byte)('a' + random.nextInt(3));
+                }
+                SearchPattern sp = SearchPattern.compile(p);
+
+                int offset = data.length == 0 ? 0 : random.nextInt(data.length);
+                int length = data.length - offset;
+                int expected = -1;
+                for (int i = offset; i <= offset + length - p.length && expected < 0; i++)
+                {
+                    if (Arrays.equals(data, i, i + p.length, p, 0, p.length))
+                        expected = i;
+                }
+                String msg = new String(p, StandardCharsets.US_ASCII) + " in " + new String(data, offset, length, StandardCharsets.US_ASCII);
+                assertEquals(expected, sp.match(data, offset, length), msg);
+
+                int expectedInBuffer = expected < 0 ? -1 : expected - offset;
+                ByteBuffer heap = ByteBuffer.wrap(data, offset, length);
+                assertEquals(expectedInBuffer, sp.match(heap), msg);
+                assertEquals(expectedInBuffer, sp.match(heap.asReadOnlyBuffer()), msg);
+                ByteBuffer direct = ByteBuffer.allocateDirect(data.length);
+                direct.put(data).flip().position(offset);
+                assertEquals(expectedInBuffer, sp.match(direct), msg);
+                assertEquals(offset, direct.position());
+            }
+        }
+    }
 }
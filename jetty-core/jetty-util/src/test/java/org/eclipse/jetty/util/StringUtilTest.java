@@ -13,6 +13,8 @@
 
 package org.eclipse.jetty.util;
 
+import java.nio.ByteBuffer;
+import java.nio.charset.StandardCharsets;
 import java.util.stream.Stream;
 
 import org.junit.jupiter.api.Test;
@@ -305,4 +307,54 @@ public class StringUtilTest
     {
         assertThat(StringUtil.toHexString(new byte[0]), is(""));
     }
+
+    @Test
+    public void testIndexOfNonAscii()
+    {
+        for (int length = 0; length < 40; length++)
+        {
+            byte[] bytes = "x".repeat(length).getBytes(StandardCharsets.US_ASCII);
+            assertEquals(length, StringUtil.indexOfNonAscii(bytes, 0, length));
+            assertEquals(length, StringUtil.indexOfNonAscii(ByteBuffer.wrap(bytes), 0, length));
+            for (int i = 0; i < length; i++)
+            {
+                bytes[i] = (byte)0xC3;
+                assertEquals(i, StringUtil.indexOfNonAscii(bytes, 0, length));
+                assertEquals(i, StringUtil.indexOfNonAscii(ByteBuffer.wrap(bytes), 0, length));
+                assertEquals(length, StringUtil.indexOfNonAscii(bytes, i + 1, length));
+                ByteBuffer direct = ByteBuffer.allocateDirect(length).put(bytes).flip();
+                assertEquals(i, StringUtil.indexOfNonAscii(direct, 0, length));
+                bytes[i] = 'x';
+            }
+        }
+    }
+
+    @Test
+    public void testIndexOfNonPrintableAscii()
+    {
+        byte[] nonPrintables = {0x00, 0x09, 0x0A, 0x0D, 0x1F, 0x7F, (byte)0x80, (byte)0xFF};
+        for (int length = 0; length < 40; length++)
+        {
+            byte[] bytes = new byte[length];
+            for (int i = 0; i < length; i++)
+            {
+                bytes[i] = (byte)(0x21 + i % (0x7F - 0x21));
+            }
+            assertEquals(length, StringUtil.indexOfNonPrintableAscii(ByteBuffer.wrap(bytes), 0, length));
+            for (int i = 0; i < length; i++)
+            {
+                byte printable = bytes[i];
+                for (byte nonPrintable : nonPrintables)
+                {
+                    bytes[i] = nonPrintable;
+                    assertEquals(i, StringUtil.indexOfNonPrintableAscii(ByteBuffer.wrap(bytes), 0, length));
+                    assertEquals(i, StringUtil.indexOfNonVisibleAscii(ByteBuffer.wrap(bytes), 0, length));
+                }
+                bytes[i] = ' ';
+                assertEquals(length, StringUtil.indexOfNonPrintableAscii(ByteBuffer.wrap(bytes), 0, length));
+                assertEquals(i, StringUtil.indexOfNonVisibleAscii(ByteBuffer.wrap(bytes), 0, length));
+                bytes[i] = printable;
+            }
+        }
+    }
 }
@@ -198,6 +198,32 @@ public class ContainerLifeCycleTest
         assertEquals(1, a1.destroyed.get());
     }
 
+    @Test
+    public void testDumpStartDuration() throws Exception
+    {
+        ContainerLifeCycle slow = new ContainerLifeCycle()
+        {
+            @Override
+            protected void doStart() throws Exception
+            {
+                Thread.sleep(50);
+                super.doStart();
+            }
+        };
+        ContainerLifeCycle a0 = new ContainerLifeCycle();
+        a0.addBean(slow);
+        assertEquals(-1, slow.getStartDuration());
+
+        a0.start();
+        assertThat(slow.getStartDuration(), Matchers.greaterThanOrEqualTo(50L));
+        assertThat(a0.getStartDuration(), Matchers.greaterThanOrEqualTo(slow.getStartDuration()));
+
+        String dump = a0.dump();
+        assertThat(dump, Matchers.containsString(" - STARTED in " + a0.getStartDuration() + "ms\n"));
+        assertThat(dump, Matchers.containsString("+= " + slow + " - STARTED in " + slow.getStartDuration() + "ms\n"));
+        a0.stop();
+    }
+
     @Test
     public void testDumpable() throws Exception
     {
@@ -0,0 +1,177 @@
+//
+// ========================================================================
+// Copyright (c) 1995 Mort Bay Consulting Pty Ltd and others.
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License v. 2.0 which is available at
+// https://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+// ========================================================================
+//
+
+package org.eclipse.jetty.util.compression;
+
+import java.io.ByteArrayInputStream;
+import java.io.ByteArrayOutputStream;
+import java.nio.ByteBuffer;
+import java.nio.charset.StandardCharsets;
+import java.util.Random;
+import java.util.stream.Stream;
+import java.util.zip.GZIPInputStream;
+import java.util.zip.GZIPOutputStream;
+import java.util.zip.ZipException;
+
+import org.eclipse.jetty.util.IO;
+import org.junit.jupiter.api.Test;
+import org.junit.jupiter.params.ParameterizedTest;
+import org.junit.jupiter.params.provider.MethodSource;
+
+import static org.junit.jupiter.api.Assertions.assertArrayEquals;
+import static org.junit.jupiter.api.Assertions.assertThrows;
+import static org.junit.jupiter.api.Assertions.assertTrue;
+
+public class CompressionTest
+{
+    public static Stream<Compression> compressions()
+    {
+        return Stream.of(new GzipCompression(), new DeflateCompression());
+    }
+
+    private static byte[] content(int size)
+    {
+        byte[] bytes = new byte[size];
+        Random random = new Random(size);
+        for (int i = 0; i < bytes.length; ++i)
+        {
+            // Compressible, but not trivially.
+            bytes[i] = (byte)('a' + random.nextInt(8));
+        }
+        return bytes;
+    }
+
+    private static byte[] encode(Compression compression, byte[] content, int outputSize) throws Exception
+    {
+        ByteArrayOutputStream result = new ByteArrayOutputStream();
+        ByteBuffer output = ByteBuffer.allocate(outputSize);
+        Compression.Encoder encoder = compression.newEncoder();
+        try
+        {
+            ByteBuffer input = ByteBuffer.wrap(content);
+            while (input.hasRemaining())
+            {
+                // Feed the content in small slices to exercise streaming.
+                ByteBuffer slice = input.slice();
+                slice.limit(Math.min(slice.remaining(), 1000));
+                input.position(input.position() + slice.remaining());
+                encoder.setInput(slice);
+                while (!encoder.needsInput())
+                {
+                    output.clear();
+                    encoder.encode(output, false);
+                    result.write(output.array(), 0, output.position());
+                }
+            }
+            encoder.finish();
+            while (!encoder.isFinished())
+            {
+                output.clear();
+                encoder.encode(output, false);
+                result.write(output.array(), 0, output.position());
+            }
+        }
+        finally
+        {
+            encoder.release();
+        }
+        return result.toByteArray();
+    }
+
+    private static byte[] decode(Compression compression, byte[] encoded, int inputSize, int outputSize) throws Exception
+    {
+        ByteArrayOutputStream result = new ByteArrayOutputStream();
+        ByteBuffer output = ByteBuffer.allocate(outputSize);
+        Compression.Decoder decoder = compression.newDecoder();
+        try
+        {
+            ByteBuffer input = ByteBuffer.wrap(encoded);
+            while (!decoder.isFinished())
+            {
+                if (decoder.needsInput())
+                {
+                    assertTrue(input.hasRemaining());
+                    ByteBuffer slice = input.slice();
+                    slice.limit(Math.min(slice.remaining(), inputSize));
+                    input.position(input.position() + slice.remaining());
+                    decoder.setInput(slice);
+                }
+                output.clear();
+                decoder.decode(output);
+                result.write(output.array(), 0, output.position());
+            }
+        }
+        finally
+        {
+            decoder.release();
+        }
+        return result.toByteArray();
+    }
+
+    @ParameterizedTest
+    @MethodSource("compressions")
+    public void testRoundTrip(Compression compression) throws Exception
+    {
+        compression.start();
+        try
+        {
+            for (int size : new int[]{0, 1, 100, 64 * 1024})
+            {
+                byte[] content = content(size);
+                byte[] encoded = encode(compression, content, 7);
+                assertArrayEquals(content, decode(compression, encoded, 1, 5));
+                assertArrayEquals(content, decode(compression, encoded, 4096, 4096));
+            }
+        }
+        finally
+        {
+            compression.stop();
+        }
+    }
+
+    @Test
+    public void testGzipInterop() throws Exception
+    {
+        GzipCompression gzip = new GzipCompression();
+        gzip.start();
+        try
+        {
+            byte[] content = content(10_000);
+
+            byte[] encoded = encode(gzip, content, 512);
+            assertArrayEquals(content, IO.readBytes(new GZIPInputStream(new ByteArrayInputStream(encoded))));
+
+            ByteArrayOutputStream bytes = new ByteArrayOutputStream();
+            try (GZIPOutputStream output = new GZIPOutputStream(bytes))
+            {
+                output.write(content);
+            }
+            assertArrayEquals(content, decode(gzip, bytes.toByteArray(), 13, 512));
+        }
+        finally
+        {
+            gzip.stop();
+        }
+    }
+
+    @Test
+    public void testGzipInvalidTrailer() throws Exception
+    {
+        GzipCompression gzip = new GzipCompression();
+        byte[] content = "the quick brown fox".getBytes(StandardCharsets.UTF_8);
+        byte[] encoded = encode(gzip, content, 512);
+        // Corrupt the CRC in the trailer.
+        encoded[encoded.length - 8] ^= 0x01;
+        assertThrows(ZipException.class, () -> decode(gzip, encoded, 512, 512));
+    }
+}
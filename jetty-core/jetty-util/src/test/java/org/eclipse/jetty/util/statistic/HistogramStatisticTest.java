@@ -0,0 +1,134 @@
+//
+// ========================================================================
+// Copyright (c) 1995 Mort Bay Consulting Pty Ltd and others.
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License v. 2.0 which is available at
+// https://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+// ========================================================================
+//
+
+package org.eclipse.jetty.util.statistic;
+
+import java.util.concurrent.CountDownLatch;
+import java.util.concurrent.ThreadLocalRandom;
+import java.util.concurrent.TimeUnit;
+
+import org.junit.jupiter.api.Test;
+
+import static org.hamcrest.MatcherAssert.assertThat;
+import static org.hamcrest.Matchers.greaterThanOrEqualTo;
+import static org.hamcrest.Matchers.is;
+import static org.hamcrest.Matchers.lessThanOrEqualTo;
+import static org.junit.jupiter.api.Assertions.assertTrue;
+
+public class HistogramStatisticTest
+{
+    @Test
+    public void testPercentiles()
+    {
+        HistogramStatistic histogram = new HistogramStatistic();
+        for (int i = 1; i <= 10_000; ++i)
+        {
+            histogram.record(i);
+        }
+
+        assertThat(histogram.getCount(), is(10_000L));
+        assertThat(histogram.getMax(), is(10_000L));
+        assertPercentile(histogram, 50, 5_000);
+        assertPercentile(histogram, 99, 9_900);
+        assertPercentile(histogram, 99.9, 9_990);
+        assertThat(histogram.getValueAtPercentile(100), is(10_000L));
+        assertThat(histogram.getValueAtPercentile(0), is(1L));
+    }
+
+    @Test
+    public void testSmallValuesAreExact()
+    {
+        HistogramStatistic histogram = new HistogramStatistic(5);
+        for (int i = 0; i < 32; ++i)
+        {
+            histogram.record(i);
+        }
+        for (int i = 0; i < 32; ++i)
+        {
+            assertThat(histogram.getValueAtPercentile((i + 1) * 100.0 / 32), is((long)i));
+        }
+    }
+
+    @Test
+    public void testLargeValues()
+    {
+        HistogramStatistic histogram = new HistogramStatistic();
+        histogram.record(Long.MAX_VALUE);
+        histogram.record(-1);
+        assertThat(histogram.getValueAtPercentile(100), is(Long.MAX_VALUE));
+        assertThat(histogram.getValueAtPercentile(50), is(0L));
+    }
+
+    @Test
+    public void testIntervalSnapshot()
+    {
+        HistogramStatistic histogram = new HistogramStatistic();
+        for (int i = 0; i < 100; ++i)
+        {
+            histogram.record(1_000);
+        }
+        HistogramStatistic.Snapshot first = histogram.intervalSnapshot();
+        assertThat(first.getCount(), is(100L));
+        assertThat(first.getMean(), is(1_000.0D));
+
+        for (int i = 0; i < 10; ++i)
+        {
+            histogram.record(10);
+        }
+        HistogramStatistic.Snapshot second = histogram.intervalSnapshot();
+        assertThat(second.getCount(), is(10L));
+        assertThat(second.getValueAtPercentile(99), is(10L));
+        assertThat(second.getMax(), is(10L));
+
+        // The cumulative snapshot still has all the samples.
+        HistogramStatistic.Snapshot all = histogram.snapshot();
+        assertThat(all.getCount(), is(110L));
+        assertThat(all.getMax(), is(1_000L));
+
+        histogram.reset();
+        assertThat(histogram.snapshot().getCount(), is(0L));
+        assertThat(histogram.intervalSnapshot().getCount(), is(0L));
+    }
+
+    @Test
+    public void testConcurrentRecording() throws Exception
+    {
+        HistogramStatistic histogram = new HistogramStatistic(5, 4);
+        int threads = 8;
+        int samples = 10_000;
+        CountDownLatch latch = new CountDownLatch(threads);
+        for (int t = 0; t < threads; ++t)
+        {
+            new Thread(() ->
+            {
+                for (int i = 0; i < samples; ++i)
+                {
+                    histogram.record(ThreadLocalRandom.current().nextLong(1_000_000));
+                }
+                latch.countDown();
+            }).start();
+        }
+        assertTrue(latch.await(10, TimeUnit.SECONDS));
+        assertThat(histogram.snapshot().getCount(), is((long)threads * samples));
+        assertThat(histogram.getValueAtPercentile(99), lessThanOrEqualTo(histogram.getMax()));
+    }
+
+    private static void assertPercentile(HistogramStatistic histogram, double percentile, long expected)
+    {
+        long value = histogram.getValueAtPercentile(percentile);
+        // The relative error is at most 2^-precision.
+        double error = Math.ceil(expected / (double)(1 << histogram.getPrecision()));
+        assertThat(value, greaterThanOrEqualTo(expected));
+        assertThat((double)value, lessThanOrEqualTo(expected + error));
+    }
+}
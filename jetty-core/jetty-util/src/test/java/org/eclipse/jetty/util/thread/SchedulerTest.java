@@ -15,17 +15,21 @@ package org.eclipse.jetty.util.thread;
 
 import java.util.ArrayList;
 import java.util.List;
+import java.util.concurrent.CopyOnWriteArrayList;
 import java.util.concurrent.CountDownLatch;
 import java.util.concurrent.TimeUnit;
 import java.util.concurrent.atomic.AtomicLong;
 import java.util.stream.Stream;
 
 import org.eclipse.jetty.logging.StacklessLogging;
+import org.eclipse.jetty.util.NanoTime;
 import org.hamcrest.Matchers;
 import org.junit.jupiter.api.AfterEach;
+import org.junit.jupiter.api.Test;
 import org.junit.jupiter.params.ParameterizedTest;
 import org.junit.jupiter.params.provider.MethodSource;
 
+import static org.awaitility.Awaitility.await;
 import static org.hamcrest.MatcherAssert.assertThat;
 import static org.hamcrest.Matchers.is;
 import static org.junit.jupiter.api.Assertions.assertEquals;
@@ -38,7 +42,8 @@ public class SchedulerTest
     {
         return Stream.of(
             TimerScheduler.class,
-            ScheduledExecutorScheduler.class
+            ScheduledExecutorScheduler.class,
+            TimingWheelScheduler.class
         );
     }
 
@@ -177,7 +182,7 @@ public class SchedulerTest
     public void testTaskThrowsException(Class<? extends Scheduler> impl) throws Exception
     {
         Scheduler scheduler = start(impl);
-        try (StacklessLogging ignore = new StacklessLogging(TimerScheduler.class))
+        try (StacklessLogging ignore = new StacklessLogging(TimerScheduler.class, TimingWheelScheduler.class))
         {
             long delay = 500;
             scheduler.schedule(new Runnable()
@@ -206,4 +211,57 @@ public class SchedulerTest
             assertTrue(latch.await(2 * delay, TimeUnit.MILLISECONDS));
         }
     }
+
+    @Test
+    public void testTimingWheelMultipleRevolutions() throws Exception
+    {
+        TimingWheelScheduler scheduler = new TimingWheelScheduler(null, false, 10, 4);
+        scheduler.start();
+        schedulers.add(scheduler);
+
+        int count = 16;
+        CountDownLatch latch = new CountDownLatch(count);
+        List<Long> early = new CopyOnWriteArrayList<>();
+        for (int i = 0; i < count; ++i)
+        {
+            // Delays span several revolutions of the wheel.
+            long delay = 15L * (i + 1);
+            long begin = NanoTime.now();
+            Scheduler.Task task = scheduler.schedule(() ->
+            {
+                long elapsed = NanoTime.millisSince(begin);
+                if (elapsed < delay)
+                    early.add(elapsed);
+                latch.countDown();
+            }, delay, TimeUnit.MILLISECONDS);
+            // Cancel every other task.
+            if (i % 2 == 1)
+            {
+                assertTrue(task.cancel());
+                assertFalse(task.cancel());
+                latch.countDown();
+            }
+        }
+
+        assertTrue(latch.await(5, TimeUnit.SECONDS));
+        assertTrue(early.isEmpty(), early.toString());
+        await().atMost(5, TimeUnit.SECONDS).until(scheduler::getSize, is(0));
+        assertEquals(count / 2, scheduler.getExpiredCount());
+    }
+
+    @Test
+    public void testTimingWheelHugeDelayDoesNotOverflow() throws Exception
+    {
+        TimingWheelScheduler scheduler = new TimingWheelScheduler(null, false, 10, 4);
+        scheduler.start();
+        schedulers.add(scheduler);
+
+        AtomicLong executed = new AtomicLong();
+        Scheduler.Task task = scheduler.schedule(executed::incrementAndGet, Long.MAX_VALUE, TimeUnit.MILLISECONDS);
+
+        Thread.sleep(200);
+        assertEquals(0, executed.get());
+        assertTrue(task.cancel());
+        await().atMost(5, TimeUnit.SECONDS).until(scheduler::getSize, is(0));
+    }
 }
@@ -0,0 +1,259 @@
+//
+// ========================================================================
+// Copyright (c) 1995 Mort Bay Consulting Pty Ltd and others.
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License v. 2.0 which is available at
+// https://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+// ========================================================================
+//
+
+package org.eclipse.jetty.util.thread;
+
+import java.util.concurrent.CountDownLatch;
+import java.util.concurrent.Executor;
+import java.util.concurrent.TimeUnit;
+import java.util.concurrent.atomic.AtomicBoolean;
+import java.util.concurrent.atomic.AtomicReference;
+
+import org.eclipse.jetty.util.component.LifeCycle;
+import org.eclipse.jetty.util.thread.ThreadPool.SizedThreadPool;
+import org.junit.jupiter.api.Test;
+
+import static org.awaitility.Awaitility.await;
+import static org.hamcrest.MatcherAssert.assertThat;
+import static org.hamcrest.Matchers.containsString;
+import static org.hamcrest.Matchers.is;
+import static org.junit.jupiter.api.Assertions.assertFalse;
+import static org.junit.jupiter.api.Assertions.assertNotSame;
+import static org.junit.jupiter.api.Assertions.assertTrue;
+
+public class WorkStealingThreadPoolTest extends AbstractThreadPoolTest
+{
+    @Override
+    protected SizedThreadPool newPool(int max)
+    {
+        return new WorkStealingThreadPool(max);
+    }
+
+    @Test
+    public void testExecuteFromWorkersAndOtherThreads() throws Exception
+    {
+        WorkStealingThreadPool pool = new WorkStealingThreadPool(8, 2);
+        pool.setGroups(2);
+        pool.start();
+        try
+        {
+            int jobs = 10_000;
+            CountDownLatch latch = new CountDownLatch(2 * jobs);
+            for (int i = 0; i < jobs; ++i)
+            {
+                // Each job executes another job from a worker thread.
+                pool.execute(() ->
+                {
+                    latch.countDown();
+                    pool.execute(latch::countDown);
+                });
+            }
+            assertTrue(latch.await(10, TimeUnit.SECONDS));
+            await().atMost(5, TimeUnit.SECONDS).until(pool::getQueueSize, is(0));
+        }
+        finally
+        {
+            LifeCycle.stop(pool);
+        }
+    }
+
+    @Test
+    public void testBlockingJobDoesNotHoldBackQueuedJobs() throws Exception
+    {
+        WorkStealingThreadPool pool = new WorkStealingThreadPool(2, 2);
+        pool.start();
+        try
+        {
+            await().atMost(5, TimeUnit.SECONDS).until(pool::getIdleThreads, is(2));
+
+            CountDownLatch blocking = new CountDownLatch(1);
+            CountDownLatch unblock = new CountDownLatch(1);
+            CountDownLatch queued = new CountDownLatch(1);
+            AtomicReference<Thread> blockingThread = new AtomicReference<>();
+            AtomicReference<Thread> queuedThread = new AtomicReference<>();
+            Runnable blockingJob = Invocable.from(Invocable.InvocationType.BLOCKING, () ->
+            {
+                blockingThread.set(Thread.currentThread());
+                blocking.countDown();
+                try
+                {
+                    unblock.await();
+                }
+                catch (InterruptedException x)
+                {
+                    throw new RuntimeException(x);
+                }
+            });
+            pool.execute(() ->
+            {
+                // Both jobs are queued to the deque of this worker, the blocking job at the head.
+                pool.execute(() ->
+                {
+                    queuedThread.set(Thread.currentThread());
+                    queued.countDown();
+                });
+                pool.execute(blockingJob);
+            });
+
+            assertTrue(blocking.await(5, TimeUnit.SECONDS));
+            // The queued job runs while the blocking job is still blocked.
+            assertTrue(queued.await(5, TimeUnit.SECONDS));
+            assertThat(unblock.getCount(), is(1L));
+            assertNotSame(blockingThread.get(), queuedThread.get());
+            unblock.countDown();
+        }
+        finally
+        {
+            LifeCycle.stop(pool);
+        }
+    }
+
+    @Test
+    public void testOldestJobNotStarved() throws Exception
+    {
+        WorkStealingThreadPool pool = new WorkStealingThreadPool(1, 1);
+        pool.start();
+        try
+        {
+            AtomicBoolean stop = new AtomicBoolean();
+            CountDownLatch oldest = new CountDownLatch(1);
+            Runnable resubmitting = new Runnable()
+            {
+                @Override
+                public void run()
+                {
+                    // Always pushed to the head of the deque of the only worker.
+                    if (!stop.get())
+                        pool.execute(this);
+                }
+            };
+            pool.execute(() ->
+            {
+                pool.execute(oldest::countDown);
+                pool.execute(resubmitting);
+            });
+
+            boolean ran = oldest.await(5, TimeUnit.SECONDS);
+            stop.set(true);
+            assertTrue(ran);
+        }
+        finally
+        {
+            LifeCycle.stop(pool);
+        }
+    }
+
+    @Test
+    public void testTryExecute() throws Exception
+    {
+        WorkStealingThreadPool pool = new WorkStealingThreadPool(2, 2);
+        pool.start();
+        try
+        {
+            await().atMost(5, TimeUnit.SECONDS).until(pool::getIdleThreads, is(2));
+
+            CountDownLatch blocked = new CountDownLatch(1);
+            CountDownLatch running = new CountDownLatch(2);
+            Runnable job = () ->
+            {
+                running.countDown();
+                try
+                {
+                    blocked.await();
+                }
+                catch (InterruptedException x)
+                {
+                    throw new RuntimeException(x);
+                }
+            };
+            assertTrue(pool.tryExecute(job));
+            assertTrue(pool.tryExecute(job));
+            assertTrue(running.await(5, TimeUnit.SECONDS));
+
+            // No idle thread is left to hand the task to.
+            assertFalse(pool.tryExecute(() -> {}));
+            blocked.countDown();
+        }
+        finally
+        {
+            LifeCycle.stop(pool);
+        }
+    }
+
+    @Test
+    public void testGroupExecutor() throws Exception
+    {
+        WorkStealingThreadPool pool = new WorkStealingThreadPool(4, 4);
+        pool.setName("test");
+        pool.setGroups(2);
+        pool.start();
+        try
+        {
+            await().atMost(5, TimeUnit.SECONDS).until(pool::getIdleThreads, is(4));
+
+            Executor executor = pool.getExecutor(1);
+            AtomicReference<String> thread = new AtomicReference<>();
+            CountDownLatch latch = new CountDownLatch(1);
+            executor.execute(() ->
+            {
+                thread.set(Thread.currentThread().getName());
+                latch.countDown();
+            });
+            assertTrue(latch.await(5, TimeUnit.SECONDS));
+            assertThat(thread.get(), containsString("test-1-"));
+        }
+        finally
+        {
+            LifeCycle.stop(pool);
+        }
+    }
+
+    @Test
+    public void testIdleThreadsShrink() throws Exception
+    {
+        WorkStealingThreadPool pool = new WorkStealingThreadPool(4, 1, 100);
+        pool.start();
+        try
+        {
+            CountDownLatch blocked = new CountDownLatch(1);
+            CountDownLatch running = new CountDownLatch(4);
+            AtomicBoolean interrupted = new AtomicBoolean();
+            for (int i = 0; i < 4; ++i)
+            {
+                pool.execute(() ->
+                {
+                    running.countDown();
+                    try
+                    {
+                        blocked.await();
+                    }
+                    catch (InterruptedException x)
+                    {
+                        interrupted.set(true);
+                    }
+                });
+            }
+            assertTrue(running.await(5, TimeUnit.SECONDS));
+            assertThat(pool.getThreads(), is(4));
+            assertTrue(pool.isLowOnThreads());
+
+            blocked.countDown();
+            await().atMost(5, TimeUnit.SECONDS).until(pool::getThreads, is(1));
+            assertFalse(interrupted.get());
+        }
+        finally
+        {
+            LifeCycle.stop(pool);
+        }
+    }
+}
@@ -0,0 +1,415 @@
+//
+// ========================================================================
+// Copyright (c) 1995 Mort Bay Consulting Pty Ltd and others.
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License v. 2.0 which is available at
+// https://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+// ========================================================================
+//
+
+package org.eclipse.jetty.websocket.core;
+
+import java.nio.ByteBuffer;
+import java.util.List;
+import java.util.Map;
+import java.util.concurrent.ConcurrentHashMap;
+import java.util.concurrent.atomic.AtomicInteger;
+import java.util.concurrent.atomic.AtomicLong;
+import java.util.concurrent.atomic.LongAdder;
+import java.util.zip.Deflater;
+
+import org.eclipse.jetty.io.ByteBufferPool;
+import org.eclipse.jetty.io.RetainableByteBuffer;
+import org.eclipse.jetty.util.BufferUtil;
+import org.eclipse.jetty.util.Callback;
+import org.eclipse.jetty.util.annotation.ManagedAttribute;
+import org.eclipse.jetty.util.annotation.ManagedObject;
+import org.eclipse.jetty.util.compression.DeflaterPool;
+import org.eclipse.jetty.websocket.core.internal.Generator;
+import org.eclipse.jetty.websocket.core.internal.PerMessageDeflateExtension;
+import org.slf4j.Logger;
+import org.slf4j.LoggerFactory;
+
+/**
+ * <p>Sends the same frame to many {@link CoreSession}s.</p>
+ * <p>Each broadcast frame is generated once into a pooled {@link RetainableByteBuffer} that is shared,
+ * read-only and reference counted, by the {@link PreEncodedFrame}s sent to every subscribed session.
+ * The buffer is released when the frame has been written to all of them.</p>
+ * <p>Sessions that negotiated {@code permessage-deflate} without outgoing context takeover are sent a
+ * second encoding, compressed once for all of them, instead of compressing the message again per session.
+ * Sessions with context takeover compress the shared payload themselves, as any other frame.</p>
+ * <p>A subscriber that does not keep up accumulates frames in its flusher. When
+ * {@link #setMaxBufferedBytes(long) maxBufferedBytes} is set, a subscriber with more than that many
+ * bytes pending is either skipped or closed, depending on the {@link SlowSubscriberPolicy}.</p>
+ */
+@ManagedObject("WebSocket Broadcaster")
+public class Broadcaster
+{
+    private static final Logger LOG = LoggerFactory.getLogger(Broadcaster.class);
+
+    /**
+     * What to do with a subscriber that has more than {@link #getMaxBufferedBytes()} bytes pending.
+     */
+    public enum SlowSubscriberPolicy
+    {
+        /**
+         * Do not send the frame to the subscriber.
+         */
+        DROP,
+        /**
+         * Close the subscriber session with {@link CloseStatus#TRY_AGAIN_LATER} and unsubscribe it.
+         */
+        CLOSE
+    }
+
+    private final Map<CoreSession, Subscriber> subscribers = new ConcurrentHashMap<>();
+    private final LongAdder broadcasts = new LongAdder();
+    private final LongAdder deflatedFrames = new LongAdder();
+    private final LongAdder dropped = new LongAdder();
+    private final LongAdder closed = new LongAdder();
+    private final Generator generator = new Generator();
+    private final ByteBufferPool bufferPool;
+    private final DeflaterPool deflaterPool;
+    private SlowSubscriberPolicy slowSubscriberPolicy = SlowSubscriberPolicy.DROP;
+    private long maxBufferedBytes = -1;
+    private boolean useDirectByteBuffers;
+
+    public Broadcaster(WebSocketComponents components)
+    {
+        this(components.getByteBufferPool(), components.getDeflaterPool());
+    }
+
+    public Broadcaster(ByteBufferPool bufferPool, DeflaterPool deflaterPool)
+    {
+        this.bufferPool = bufferPool;
+        this.deflaterPool = deflaterPool;
+    }
+
+    /**
+     * @param session the session to send broadcast frames to
+     * @return true if the session was subscribed, false if it already was
+     */
+    public boolean subscribe(CoreSession session)
+    {
+        return subscribers.putIfAbsent(session, new Subscriber(session)) == null;
+    }
+
+    /**
+     * @param session the session to stop sending broadcast frames to
+     * @return true if the session was unsubscribed, false if it was not subscribed
+     */
+    public boolean unsubscribe(CoreSession session)
+    {
+        return subscribers.remove(session) != null;
+    }
+
+    @ManagedAttribute("The number of subscribed sessions")
+    public int getSubscriberCount()
+    {
+        return subscribers.size();
+    }
+
+    @ManagedAttribute("The number of frames broadcast")
+    public long getBroadcastCount()
+    {
+        return broadcasts.longValue();
+    }
+
+    @ManagedAttribute("The number of frames sent with the shared deflated encoding")
+    public long getDeflatedCount()
+    {
+        return deflatedFrames.longValue();
+    }
+
+    @ManagedAttribute("The number of frames not sent to slow subscribers")
+    public long getDroppedCount()
+    {
+        return dropped.longValue();
+    }
+
+    @ManagedAttribute("The number of slow subscribers closed")
+    public long getClosedCount()
+    {
+        return closed.longValue();
+    }
+
+    @ManagedAttribute("The policy applied to subscribers with more than maxBufferedBytes pending")
+    public SlowSubscriberPolicy getSlowSubscriberPolicy()
+    {
+        return slowSubscriberPolicy;
+    }
+
+    public void setSlowSubscriberPolicy(SlowSubscriberPolicy slowSubscriberPolicy)
+    {
+        this.slowSubscriberPolicy = slowSubscriberPolicy;
+    }
+
+    @ManagedAttribute("The max number of bytes pending for a subscriber, or -1 for no limit")
+    public long getMaxBufferedBytes()
+    {
+        return maxBufferedBytes;
+    }
+
+    /**
+     * <p>Sets the max number of broadcast bytes that may be pending for a single subscriber.</p>
+     * <p>A frame is always sent to a subscriber that has nothing pending, even if it is larger than the limit.</p>
+     *
+     * @param maxBufferedBytes the max number of pending bytes, or -1 for no limit
+     */
+    public void setMaxBufferedBytes(long maxBufferedBytes)
+    {
+        this.maxBufferedBytes = maxBufferedBytes;
+    }
+
+    public boolean isUseDirectByteBuffers()
+    {
+        return useDirectByteBuffers;
+    }
+
+    public void setUseDirectByteBuffers(boolean useDirectByteBuffers)
+    {
+        this.useDirectByteBuffers = useDirectByteBuffers;
+    }
+
+    /**
+     * <p>Sends a frame to all the subscribed sessions.</p>
+     * <p>The frame payload is not consumed and may be reused once the callback is completed.
+     * The callback is succeeded when the frame has been sent, dropped or failed for every subscriber;
+     * sessions that fail to send the frame and whose output is closed are unsubscribed.</p>
+     *
+     * @param frame a whole message or a control frame, not masked
+     * @param callback the callback completed when the broadcast is done
+     */
+    public void broadcast(Frame frame, Callback callback)
+    {
+        if (!frame.isFin())
+            throw new IllegalArgumentException("Cannot broadcast a fragment: " + frame);
+        if (frame.isMasked())
+            throw new IllegalArgumentException("Cannot broadcast a masked frame: " + frame);
+
+        broadcasts.increment();
+        Broadcast broadcast = new Broadcast(frame, callback);
+        try
+        {
+            for (Subscriber subscriber : subscribers.values())
+            {
+                broadcast.send(subscriber);
+            }
+        }
+        finally
+        {
+            broadcast.complete();
+        }
+    }
+
+    private Encoding encode(Frame frame)
+    {
+        int payloadLength = frame.getPayloadLength();
+        RetainableByteBuffer buffer = bufferPool.acquire(Generator.MAX_HEADER_LENGTH + payloadLength, isUseDirectByteBuffers());
+        ByteBuffer byteBuffer = buffer.getByteBuffer();
+        generator.generateWholeFrame(frame, byteBuffer);
+        return new Encoding(buffer, frame.finRsvOp, byteBuffer.remaining() - payloadLength);
+    }
+
+    private Encoding deflate(Frame frame)
+    {
+        ByteBuffer payload = frame.getPayload();
+        int length = payload.remaining();
+        // The deflated size of incompressible data is bounded as for zlib deflateBound(), plus the SYNC_FLUSH marker.
+        int bound = length + (length >> 12) + (length >> 14) + (length >> 25) + 32;
+        RetainableByteBuffer compressed = bufferPool.acquire(bound, false);
+        DeflaterPool.Entry entry = deflaterPool.acquire();
+        try
+        {
+            Deflater deflater = entry.get();
+            deflater.setInput(payload.slice());
+            ByteBuffer output = compressed.getByteBuffer();
+            int position = BufferUtil.flipToFill(output);
+            while (deflater.deflate(output, Deflater.SYNC_FLUSH) > 0)
+            {
+                if (!output.hasRemaining())
+                    return null;
+            }
+            BufferUtil.flipToFlush(output, position);
+
+            // Drop the 0x00 0x00 0xFF 0xFF tail as required by RFC 7692 section 7.2.1.
+            if (PerMessageDeflateExtension.endsWithTail(output))
+                output.limit(output.limit() - 4);
+            if (!output.hasRemaining())
+                output = ByteBuffer.wrap(new byte[]{0x00});
+
+            Frame deflatedFrame = Frame.copyWithoutPayload(frame).setRsv1(true).setPayload(output);
+            return encode(deflatedFrame);
+        }
+        finally
+        {
+            entry.release();
+            compressed.release();
+        }
+    }
+
+    @Override
+    public String toString()
+    {
+        return String.format("%s@%x[subscribers=%d,policy=%s,maxBufferedBytes=%d]",
+            getClass().getSimpleName(),
+            hashCode(),
+            getSubscriberCount(),
+            getSlowSubscriberPolicy(),
+            getMaxBufferedBytes());
+    }
+
+    private static class Subscriber
+    {
+        private final AtomicLong buffered = new AtomicLong();
+        private final CoreSession session;
+        private final PerMessageDeflateExtension deflateExtension;
+
+        private Subscriber(CoreSession session)
+        {
+            this.session = session;
+            this.deflateExtension = findDeflateExtension(session);
+        }
+
+        private static PerMessageDeflateExtension findDeflateExtension(CoreSession session)
+        {
+            // Other extensions could transform the pre-deflated frame before it reaches permessage-deflate.
+            if (session instanceof WebSocketCoreSession coreSession)
+            {
+                List<Extension> extensions = coreSession.getExtensionStack().getExtensions();
+                if (extensions != null && extensions.size() == 1 && extensions.get(0) instanceof PerMessageDeflateExtension deflateExtension)
+                    return deflateExtension;
+            }
+            return null;
+        }
+    }
+
+    private record Encoding(RetainableByteBuffer buffer, byte finRsvOp, int headerLength)
+    {
+        private PreEncodedFrame newFrame()
+        {
+            buffer.retain();
+            return new PreEncodedFrame(finRsvOp, buffer.getByteBuffer(), headerLength);
+        }
+
+        private int size()
+        {
+            return buffer.remaining();
+        }
+    }
+
+    private class Broadcast
+    {
+        private final AtomicInteger pending = new AtomicInteger(1);
+        private final Frame frame;
+        private final Callback callback;
+        private Encoding plain;
+        private Encoding deflated;
+        private boolean deflateFailed;
+
+        private Broadcast(Frame frame, Callback callback)
+        {
+            this.frame = frame;
+            this.callback = callback;
+        }
+
+        private void send(Subscriber subscriber)
+        {
+            CoreSession session = subscriber.session;
+            if (!session.isOutputOpen())
+            {
+                unsubscribe(session);
+                return;
+            }
+
+            Encoding encoding = null;
+            if (subscriber.deflateExtension != null && subscriber.deflateExtension.isSharedDeflateCompatible(frame))
+                encoding = getDeflated();
+            boolean deflate = encoding != null;
+            if (encoding == null)
+                encoding = getPlain();
+
+            // Reserve the bytes atomically, as concurrent broadcasts may send to the same subscriber.
+            int size = encoding.size();
+            long maxBuffered = getMaxBufferedBytes();
+            while (true)
+            {
+                long buffered = subscriber.buffered.get();
+                if (maxBuffered >= 0 && buffered > 0 && buffered + size > maxBuffered)
+                {
+                    if (LOG.isDebugEnabled())
+                        LOG.debug("Slow subscriber buffered={} policy={} {}", buffered, getSlowSubscriberPolicy(), session);
+                    switch (getSlowSubscriberPolicy())
+                    {
+                        case CLOSE:
+                            closed.increment();
+                            unsubscribe(session);
+                            session.close(CloseStatus.TRY_AGAIN_LATER, "Slow subscriber", Callback.NOOP);
+                            break;
+                        case DROP:
+                        default:
+                            dropped.increment();
+                            break;
+                    }
+                    return;
+                }
+                if (subscriber.buffered.compareAndSet(buffered, buffered + size))
+                    break;
+            }
+
+            pending.incrementAndGet();
+            Encoding sent = encoding;
+            session.sendFrame(encoding.newFrame(), Callback.from(
+                () -> sent(subscriber, sent, null),
+                x -> sent(subscriber, sent, x)), false);
+            if (deflate)
+                deflatedFrames.increment();
+        }
+
+        private void sent(Subscriber subscriber, Encoding encoding, Throwable failure)
+        {
+            subscriber.buffered.addAndGet(-encoding.size());
+            encoding.buffer().release();
+            if (failure != null)
+            {
+                if (LOG.isDebugEnabled())
+                    LOG.debug("Failed broadcast to {}", subscriber.session, failure);
+                if (!subscriber.session.isOutputOpen())
+                    unsubscribe(subscriber.session);
+            }
+            complete();
+        }
+
+        private Encoding getPlain()
+        {
+            if (plain == null)
+                plain = encode(frame);
+            return plain;
+        }
+
+        private Encoding getDeflated()
+        {
+            if (deflated == null && !deflateFailed)
+            {
+                deflated = deflate(frame);
+                deflateFailed = deflated == null;
+            }
+            return deflated;
+        }
+
+        private void complete()
+        {
+            if (pending.decrementAndGet() > 0)
+                return;
+            if (plain != null)
+                plain.buffer().release();
+            if (deflated != null)
+                deflated.buffer().release();
+            callback.succeeded();
+        }
+    }
+}
@@ -0,0 +1,51 @@
+//
+// ========================================================================
+// Copyright (c) 1995 Mort Bay Consulting Pty Ltd and others.
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License v. 2.0 which is available at
+// https://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+// ========================================================================
+//
+
+package org.eclipse.jetty.websocket.core;
+
+import java.nio.ByteBuffer;
+
+/**
+ * <p>A {@link Frame} whose wire bytes, header and payload, have already been generated.</p>
+ * <p>Instances are created by a {@link Broadcaster}, one per session, as read-only views over
+ * a single encoded buffer that is shared by all the sessions the frame is broadcast to.
+ * The {@code FrameFlusher} writes the encoded bytes directly, unless the frame has been
+ * modified on its way through the extension stack (for example it was masked by a client
+ * session), in which case it is generated as a normal frame from its payload.</p>
+ */
+public class PreEncodedFrame extends Frame
+{
+    private final byte encodedFinRsvOp;
+    private final ByteBuffer encoded;
+    private final ByteBuffer encodedPayload;
+
+    PreEncodedFrame(byte finRsvOp, ByteBuffer encoded, int headerLength)
+    {
+        super(finRsvOp, null, null);
+        this.encodedFinRsvOp = finRsvOp;
+        this.encoded = encoded.asReadOnlyBuffer();
+        this.encodedPayload = this.encoded.slice(this.encoded.position() + headerLength, this.encoded.remaining() - headerLength);
+        this.payload = encodedPayload;
+    }
+
+    /**
+     * @return a view of the encoded frame to write, or null if this frame no longer matches its encoding
+     */
+    public ByteBuffer getEncoded()
+    {
+        if (finRsvOp != encodedFinRsvOp || mask != null || payload != encodedPayload ||
+            payload.position() != 0 || payload.limit() != payload.capacity())
+            return null;
+        return encoded.slice();
+    }
+}
@@ -34,6 +34,7 @@ import org.eclipse.jetty.websocket.core.exception.ProtocolException;
 import org.eclipse.jetty.websocket.core.exception.WebSocketTimeoutException;
 import org.eclipse.jetty.websocket.core.exception.WebSocketWriteTimeoutException;
 import org.eclipse.jetty.websocket.core.internal.FrameFlusher;
+import org.eclipse.jetty.websocket.core.internal.PerMessageDeflateExtension;
 import org.eclipse.jetty.websocket.core.internal.WebSocketSessionState;
 import org.eclipse.jetty.websocket.core.util.FragmentingFlusher;
 import org.eclipse.jetty.websocket.core.util.FrameValidation;
@@ -716,10 +717,28 @@ public class WebSocketCoreSession implements CoreSession, Dumpable
     {
         Dumpable.dumpObjects(out, indent, this,
             "subprotocol=" + negotiated.getSubProtocol(),
+            "nativeMemory=" + getNativeMemory(),
             negotiated.getExtensions(),
             handler);
     }
 
+    /**
+     * @return an estimate of the native memory held by the extensions of this session, such as compression
+     */
+    public long getNativeMemory()
+    {
+        long memory = 0;
+        List<Extension> extensions = negotiated.getExtensions().getExtensions();
+        if (extensions == null)
+            return memory;
+        for (Extension extension : extensions)
+        {
+            if (extension instanceof PerMessageDeflateExtension deflateExtension)
+                memory += deflateExtension.getNativeMemory();
+        }
+        return memory;
+    }
+
     @Override
     public List<ExtensionConfig> getNegotiatedExtensions()
     {
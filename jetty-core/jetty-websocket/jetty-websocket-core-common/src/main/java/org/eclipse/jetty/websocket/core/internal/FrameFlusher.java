@@ -37,6 +37,7 @@ import org.eclipse.jetty.util.thread.Scheduler;
 import org.eclipse.jetty.websocket.core.CloseStatus;
 import org.eclipse.jetty.websocket.core.Frame;
 import org.eclipse.jetty.websocket.core.OpCode;
+import org.eclipse.jetty.websocket.core.PreEncodedFrame;
 import org.eclipse.jetty.websocket.core.exception.WebSocketException;
 import org.eclipse.jetty.websocket.core.exception.WebSocketWriteTimeoutException;
 import org.slf4j.Logger;
@@ -234,6 +235,16 @@ public class FrameFlusher extends IteratingCallback
 
                 int batchSpace = batchBuffer == null ? bufferSize : BufferUtil.space(batchBuffer.getByteBuffer());
 
+                // Pre-encoded frames are shared with other sessions and written without copying.
+                ByteBuffer encoded = entry.frame instanceof PreEncodedFrame preEncoded ? preEncoded.getEncoded() : null;
+                if (encoded != null)
+                {
+                    buffers.add(encoded);
+                    flush = true;
+                    flushed = true;
+                    continue;
+                }
+
                 boolean batch = entry.batch &&
                     !entry.frame.isControlFrame() &&
                     entry.frame.getPayloadLength() < bufferSize / 4 &&
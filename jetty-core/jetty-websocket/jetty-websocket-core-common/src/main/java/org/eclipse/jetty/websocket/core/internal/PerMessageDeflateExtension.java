@@ -14,6 +14,7 @@
 package org.eclipse.jetty.websocket.core.internal;
 
 import java.nio.ByteBuffer;
+import java.util.Base64;
 import java.util.HashMap;
 import java.util.Map;
 import java.util.concurrent.atomic.AtomicReference;
@@ -27,9 +28,12 @@ import org.eclipse.jetty.util.Callback;
 import org.eclipse.jetty.util.compression.DeflaterPool;
 import org.eclipse.jetty.util.compression.InflaterPool;
 import org.eclipse.jetty.websocket.core.AbstractExtension;
+import org.eclipse.jetty.websocket.core.Behavior;
+import org.eclipse.jetty.websocket.core.CoreSession;
 import org.eclipse.jetty.websocket.core.ExtensionConfig;
 import org.eclipse.jetty.websocket.core.Frame;
 import org.eclipse.jetty.websocket.core.OpCode;
+import org.eclipse.jetty.websocket.core.PreEncodedFrame;
 import org.eclipse.jetty.websocket.core.WebSocketComponents;
 import org.eclipse.jetty.websocket.core.exception.BadPayloadException;
 import org.eclipse.jetty.websocket.core.exception.MessageTooLargeException;
@@ -44,6 +48,21 @@ import org.slf4j.LoggerFactory;
  * Per Message Deflate Compression extension for WebSocket.
  * <p>
  * Attempts to follow <a href="https://tools.ietf.org/html/rfc7692">Compression Extensions for WebSocket</a>
+ * <p>
+ * The following internal parameters, not sent to the peer, can be configured:
+ * <ul>
+ *     <li>{@code @deflate_buffer_size} and {@code @inflate_buffer_size}: the size of the buffers for the compressed and decompressed payloads.</li>
+ *     <li>{@code @deflate_threshold}: messages with a smaller payload are sent uncompressed, as compressing
+ *     small messages costs more CPU than the bytes it saves.</li>
+ *     <li>{@code @deflate_dictionary}: a base64 encoded preset dictionary, for example built from the messages of a
+ *     known JSON schema, used to start every compression context. This is not part of RFC 7692, so both peers
+ *     must be configured with the same dictionary.</li>
+ * </ul>
+ * <p>
+ * The {@link Deflater} cannot use a window smaller than 32 KB, so the {@code max_window_bits} parameter of the
+ * outgoing direction ({@code server_max_window_bits} for a server, {@code client_max_window_bits} for a client) is
+ * honoured by compressing only the messages that fit in the smaller window, along with the preset dictionary if any,
+ * without context takeover; the {@link Deflater} is then released between messages.
  */
 public class PerMessageDeflateExtension extends AbstractExtension implements DemandChain
 {
@@ -51,6 +70,10 @@ public class PerMessageDeflateExtension extends AbstractExtension implements Dem
     private static final ByteBuffer TAIL_BYTES_BUF = ByteBuffer.wrap(TAIL_BYTES);
     private static final Logger LOG = LoggerFactory.getLogger(PerMessageDeflateExtension.class);
     private static final int DEFAULT_BUF_SIZE = 8 * 1024;
+    private static final int MAX_WINDOW_BITS = 15;
+    // The native memory used by zlib with the maximum window and the default memLevel of 8, see zconf.h.
+    private static final int DEFLATER_NATIVE_MEMORY = (1 << (MAX_WINDOW_BITS + 2)) + (1 << (8 + 9));
+    private static final int INFLATER_NATIVE_MEMORY = 1 << MAX_WINDOW_BITS;
 
     private final OutgoingFlusher outgoingFlusher;
     private final IncomingFlusher incomingFlusher;
@@ -64,6 +87,11 @@ public class PerMessageDeflateExtension extends AbstractExtension implements Dem
     private int inflateBufferSize = DEFAULT_BUF_SIZE;
     private boolean incomingContextTakeover = true;
     private boolean outgoingContextTakeover = true;
+    private int deflateThreshold;
+    private int clientMaxWindowBits = MAX_WINDOW_BITS;
+    private int serverMaxWindowBits = MAX_WINDOW_BITS;
+    private int maxDeflateSize = -1;
+    private byte[] dictionary;
 
     public PerMessageDeflateExtension()
     {
@@ -108,10 +136,17 @@ public class PerMessageDeflateExtension extends AbstractExtension implements Dem
             switch (key)
             {
                 case "client_max_window_bits":
+                {
+                    // The Inflater accepts any window size, so a server does not limit
+                    // the window of the client, but a client honours the server limit.
+                    clientMaxWindowBits = toWindowBits(config, key);
+                    break;
+                }
                 case "server_max_window_bits":
                 {
-                    // Not supported by Jetty
-                    // Don't negotiate these parameters
+                    serverMaxWindowBits = toWindowBits(config, key);
+                    if (serverMaxWindowBits < MAX_WINDOW_BITS)
+                        paramsNegotiated.put("server_max_window_bits", Integer.toString(serverMaxWindowBits));
                     break;
                 }
                 case "client_no_context_takeover":
@@ -136,6 +171,16 @@ public class PerMessageDeflateExtension extends AbstractExtension implements Dem
                     inflateBufferSize = config.getParameter(key, DEFAULT_BUF_SIZE);
                     break;
                 }
+                case "@deflate_threshold":
+                {
+                    deflateThreshold = config.getParameter(key, 0);
+                    break;
+                }
+                case "@deflate_dictionary":
+                {
+                    dictionary = Base64.getDecoder().decode(config.getParameter(key, ""));
+                    break;
+                }
                 default:
                 {
                     throw new IllegalArgumentException();
@@ -149,6 +194,32 @@ public class PerMessageDeflateExtension extends AbstractExtension implements Dem
         super.init(configNegotiated, components);
     }
 
+    private static int toWindowBits(ExtensionConfig config, String key)
+    {
+        int windowBits = config.getParameter(key, MAX_WINDOW_BITS);
+        if (windowBits < 8 || windowBits > MAX_WINDOW_BITS)
+            throw new IllegalArgumentException("Invalid " + key + " " + windowBits);
+        return windowBits;
+    }
+
+    @Override
+    public void setCoreSession(CoreSession coreSession)
+    {
+        super.setCoreSession(coreSession);
+
+        // Only the window of the outgoing direction limits the Deflater.
+        int windowBits = coreSession.getBehavior() == Behavior.CLIENT ? clientMaxWindowBits : serverMaxWindowBits;
+        if (windowBits < MAX_WINDOW_BITS)
+        {
+            // Without context takeover, back references never point further than the
+            // start of the message, or of the preset dictionary, so messages that fit
+            // the window along with the dictionary are compliant.
+            int dictionaryLength = dictionary == null ? 0 : dictionary.length;
+            maxDeflateSize = Math.max(0, (1 << windowBits) - dictionaryLength);
+            outgoingContextTakeover = false;
+        }
+    }
+
     @Override
     public void close()
     {
@@ -187,20 +258,65 @@ public class PerMessageDeflateExtension extends AbstractExtension implements Dem
         return true;
     }
 
+    private boolean isDeflatable(Frame frame)
+    {
+        // The size of a fragmented message is not known when its first frame is sent.
+        if (!frame.isFin())
+            return maxDeflateSize < 0;
+        int length = frame.getPayloadLength();
+        return length >= deflateThreshold && (maxDeflateSize < 0 || length <= maxDeflateSize);
+    }
+
+    /**
+     * <p>Whether a compressed copy of the given whole message, deflated once with a fresh
+     * context and shared between sessions, can be sent as-is by this extension.</p>
+     * <p>This is only the case without outgoing context takeover and without a preset dictionary,
+     * so that every message is compressed independently of the previous ones.</p>
+     *
+     * @param frame the whole (FIN) data frame to send
+     * @return whether a shared deflated copy of the frame can be sent
+     * @see org.eclipse.jetty.websocket.core.Broadcaster
+     */
+    public boolean isSharedDeflateCompatible(Frame frame)
+    {
+        return !outgoingContextTakeover && dictionary == null && frame.isFin() && frame.isDataFrame() && isDeflatable(frame);
+    }
+
     public Deflater getDeflater()
     {
         if (deflaterHolder == null)
+        {
             deflaterHolder = getDeflaterPool().acquire();
+            if (dictionary != null)
+                deflaterHolder.get().setDictionary(dictionary);
+        }
         return deflaterHolder.get();
     }
 
     public Inflater getInflater()
     {
         if (inflaterHolder == null)
+        {
             inflaterHolder = getInflaterPool().acquire();
+            if (dictionary != null)
+                inflaterHolder.get().setDictionary(dictionary);
+        }
         return inflaterHolder.get();
     }
 
+    /**
+     * @return an estimate of the native memory of the {@link Deflater} and {@link Inflater} currently held
+     */
+    public long getNativeMemory()
+    {
+        long memory = 0;
+        if (deflaterHolder != null)
+            memory += DEFLATER_NATIVE_MEMORY;
+        if (inflaterHolder != null)
+            memory += INFLATER_NATIVE_MEMORY;
+        return memory;
+    }
+
     public void releaseInflater()
     {
         if (inflaterHolder != null)
@@ -222,16 +338,17 @@ public class PerMessageDeflateExtension extends AbstractExtension implements Dem
     @Override
     public String toString()
     {
-        return String.format("%s[requested=\"%s\", negotiated=\"%s\"]",
+        return String.format("%s[requested=\"%s\", negotiated=\"%s\", nativeMemory=%d]",
             getClass().getSimpleName(),
             configRequested.getParameterizedName(),
-            configNegotiated.getParameterizedName());
+            configNegotiated.getParameterizedName(),
+            getNativeMemory());
     }
 
     @Override
     protected void nextIncomingFrame(Frame frame, Callback callback)
     {
-        if (frame.isFin() && !incomingContextTakeover)
+        if (frame.isFin() && !frame.isControlFrame() && !incomingContextTakeover)
         {
             LOG.debug("Incoming Context Reset");
             releaseInflater();
@@ -242,7 +359,7 @@ public class PerMessageDeflateExtension extends AbstractExtension implements Dem
     @Override
     protected void nextOutgoingFrame(Frame frame, Callback callback, boolean batch)
     {
-        if (frame.isFin() && !outgoingContextTakeover)
+        if (frame.isFin() && !frame.isControlFrame() && !outgoingContextTakeover)
         {
             LOG.debug("Outgoing Context Reset");
             releaseDeflater();
@@ -267,6 +384,7 @@ public class PerMessageDeflateExtension extends AbstractExtension implements Dem
         private boolean _first;
         private Frame _frame;
         private boolean _batch;
+        private boolean _deflating;
 
         @Override
         protected boolean onFrame(Frame frame, Callback callback, boolean batch)
@@ -277,6 +395,22 @@ public class PerMessageDeflateExtension extends AbstractExtension implements Dem
                 return true;
             }
 
+            // Frames already compressed by a Broadcaster are sent as they are.
+            if (frame instanceof PreEncodedFrame && frame.isRsv1())
+            {
+                nextOutgoingFrame(frame, callback, batch);
+                return true;
+            }
+
+            // Whether to compress is decided by the first frame of each message.
+            if (frame.getOpCode() != OpCode.CONTINUATION)
+                _deflating = isDeflatable(frame);
+            if (!_deflating)
+            {
+                nextOutgoingFrame(frame, callback, batch);
+                return true;
+            }
+
             _first = true;
             _frame = frame;
             _batch = batch;
@@ -0,0 +1,218 @@
+//
+// ========================================================================
+// Copyright (c) 1995 Mort Bay Consulting Pty Ltd and others.
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License v. 2.0 which is available at
+// https://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+// ========================================================================
+//
+
+package org.eclipse.jetty.websocket.core;
+
+import java.net.URI;
+import java.util.ArrayList;
+import java.util.List;
+import java.util.Queue;
+import java.util.concurrent.ConcurrentLinkedQueue;
+import java.util.concurrent.CountDownLatch;
+import java.util.concurrent.TimeUnit;
+import java.util.zip.Deflater;
+
+import org.eclipse.jetty.io.ArrayByteBufferPool;
+import org.eclipse.jetty.server.Server;
+import org.eclipse.jetty.server.ServerConnector;
+import org.eclipse.jetty.util.Blocker;
+import org.eclipse.jetty.util.Callback;
+import org.eclipse.jetty.util.FutureCallback;
+import org.eclipse.jetty.util.compression.DeflaterPool;
+import org.eclipse.jetty.websocket.core.client.CoreClientUpgradeRequest;
+import org.eclipse.jetty.websocket.core.client.WebSocketCoreClient;
+import org.eclipse.jetty.websocket.core.server.WebSocketUpgradeHandler;
+import org.junit.jupiter.api.AfterEach;
+import org.junit.jupiter.api.BeforeEach;
+import org.junit.jupiter.api.Test;
+
+import static org.hamcrest.MatcherAssert.assertThat;
+import static org.hamcrest.Matchers.equalTo;
+import static org.hamcrest.Matchers.instanceOf;
+import static org.hamcrest.Matchers.is;
+import static org.hamcrest.Matchers.notNullValue;
+import static org.junit.jupiter.api.Assertions.assertFalse;
+import static org.junit.jupiter.api.Assertions.assertTrue;
+
+public class BroadcasterTest
+{
+    private Server _server;
+    private WebSocketComponents _components;
+    private WebSocketUpgradeHandler _upgradeHandler;
+    private WebSocketCoreClient _client;
+    private ServerConnector _serverConnector;
+
+    @BeforeEach
+    public void before() throws Exception
+    {
+        _server = new Server();
+        _serverConnector = new ServerConnector(_server);
+        _server.addConnector(_serverConnector);
+
+        _components = new WebSocketComponents();
+        _upgradeHandler = new WebSocketUpgradeHandler(_components);
+        _server.setHandler(_upgradeHandler);
+        _server.start();
+
+        _client = new WebSocketCoreClient();
+        _client.start();
+    }
+
+    @AfterEach
+    public void after() throws Exception
+    {
+        _client.stop();
+        _server.stop();
+    }
+
+    @Test
+    public void testBroadcast() throws Exception
+    {
+        Broadcaster broadcaster = new Broadcaster(_components);
+        CountDownLatch subscribed = new CountDownLatch(3);
+        _upgradeHandler.addMapping("/", (req, resp, cb) -> new TestMessageHandler()
+        {
+            @Override
+            public void onOpen(CoreSession coreSession, Callback callback)
+            {
+                super.onOpen(coreSession, callback);
+                broadcaster.subscribe(coreSession);
+                subscribed.countDown();
+            }
+        });
+
+        URI uri = URI.create("ws://localhost:" + _serverConnector.getLocalPort());
+        List<TestMessageHandler> clientHandlers = new ArrayList<>();
+        List<CoreSession> clientSessions = new ArrayList<>();
+        for (String extension : new String[]{null, "permessage-deflate; server_no_context_takeover", "permessage-deflate"})
+        {
+            TestMessageHandler clientHandler = new TestMessageHandler();
+            CoreClientUpgradeRequest upgradeRequest = CoreClientUpgradeRequest.from(_client, uri, clientHandler);
+            if (extension != null)
+                upgradeRequest.addExtensions(extension);
+            clientSessions.add(_client.connect(upgradeRequest).get(5, TimeUnit.SECONDS));
+            clientHandlers.add(clientHandler);
+        }
+        assertTrue(subscribed.await(5, TimeUnit.SECONDS));
+        assertThat(broadcaster.getSubscriberCount(), is(3));
+
+        String message = "Hello Subscribers ".repeat(32);
+        for (int i = 0; i < 2; i++)
+        {
+            try (Blocker.Callback callback = Blocker.callback())
+            {
+                broadcaster.broadcast(new Frame(OpCode.TEXT, message), callback);
+                callback.block();
+            }
+        }
+
+        for (TestMessageHandler clientHandler : clientHandlers)
+        {
+            assertThat(clientHandler.textMessages.poll(5, TimeUnit.SECONDS), equalTo(message));
+            assertThat(clientHandler.textMessages.poll(5, TimeUnit.SECONDS), equalTo(message));
+        }
+
+        // Only the session without context takeover used the shared deflated frame.
+        assertThat(broadcaster.getBroadcastCount(), is(2L));
+        assertThat(broadcaster.getDeflatedCount(), is(2L));
+
+        for (CoreSession clientSession : clientSessions)
+        {
+            clientSession.close(Callback.NOOP);
+        }
+    }
+
+    @Test
+    public void testSlowSubscriberDropped()
+    {
+        Broadcaster broadcaster = new Broadcaster(new ArrayByteBufferPool(), new DeflaterPool(0, Deflater.DEFAULT_COMPRESSION, true));
+        broadcaster.setMaxBufferedBytes(16);
+        broadcaster.setSlowSubscriberPolicy(Broadcaster.SlowSubscriberPolicy.DROP);
+        CapturingSession fast = new CapturingSession(true);
+        CapturingSession slow = new CapturingSession(false);
+        broadcaster.subscribe(fast);
+        broadcaster.subscribe(slow);
+
+        FutureCallback first = new FutureCallback();
+        broadcaster.broadcast(new Frame(OpCode.TEXT, "first message"), first);
+
+        // The broadcast completes only when the slow subscriber completes its write.
+        assertFalse(first.isDone());
+        Frame frame = slow.frames.poll();
+        assertThat(frame, instanceOf(PreEncodedFrame.class));
+        assertThat(((PreEncodedFrame)frame).getEncoded(), notNullValue());
+        assertThat(frame.getPayloadAsUTF8(), equalTo("first message"));
+
+        // The slow subscriber has a pending frame and the next one would exceed its limit.
+        FutureCallback second = new FutureCallback();
+        broadcaster.broadcast(new Frame(OpCode.TEXT, "second message"), second);
+        assertTrue(second.isDone());
+        assertThat(broadcaster.getDroppedCount(), is(1L));
+        assertThat(fast.frames.size(), is(2));
+        assertThat(slow.frames.size(), is(0));
+
+        slow.callbacks.poll().succeeded();
+        assertTrue(first.isDone());
+
+        broadcaster.broadcast(new Frame(OpCode.TEXT, "third message"), Callback.NOOP);
+        assertThat(slow.frames.poll().getPayloadAsUTF8(), equalTo("third message"));
+        assertThat(broadcaster.getSubscriberCount(), is(2));
+    }
+
+    @Test
+    public void testSlowSubscriberClosed()
+    {
+        Broadcaster broadcaster = new Broadcaster(new ArrayByteBufferPool(), new DeflaterPool(0, Deflater.DEFAULT_COMPRESSION, true));
+        broadcaster.setMaxBufferedBytes(16);
+        broadcaster.setSlowSubscriberPolicy(Broadcaster.SlowSubscriberPolicy.CLOSE);
+        CapturingSession slow = new CapturingSession(false);
+        broadcaster.subscribe(slow);
+
+        broadcaster.broadcast(new Frame(OpCode.TEXT, "first message"), Callback.NOOP);
+        broadcaster.broadcast(new Frame(OpCode.TEXT, "second message"), Callback.NOOP);
+
+        assertThat(slow.closeCode, is(CloseStatus.TRY_AGAIN_LATER));
+        assertThat(broadcaster.getClosedCount(), is(1L));
+        assertThat(broadcaster.getSubscriberCount(), is(0));
+    }
+
+    private static class CapturingSession extends CoreSession.Empty
+    {
+        private final Queue<Frame> frames = new ConcurrentLinkedQueue<>();
+        private final Queue<Callback> callbacks = new ConcurrentLinkedQueue<>();
+        private final boolean complete;
+        private volatile int closeCode;
+
+        private CapturingSession(boolean complete)
+        {
+            this.complete = complete;
+        }
+
+        @Override
+        public void sendFrame(Frame frame, Callback callback, boolean batch)
+        {
+            frames.offer(frame);
+            if (complete)
+                callback.succeeded();
+            else
+                callbacks.offer(callback);
+        }
+
+        @Override
+        public void close(int statusCode, String reason, Callback callback)
+        {
+            closeCode = statusCode;
+            callback.succeeded();
+        }
+    }
+}
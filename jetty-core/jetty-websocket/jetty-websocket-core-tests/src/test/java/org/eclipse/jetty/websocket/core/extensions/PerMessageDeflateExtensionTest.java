@@ -17,6 +17,7 @@ import java.io.IOException;
 import java.nio.ByteBuffer;
 import java.nio.charset.StandardCharsets;
 import java.util.ArrayList;
+import java.util.Base64;
 import java.util.Collections;
 import java.util.List;
 import java.util.concurrent.TimeUnit;
@@ -42,8 +43,10 @@ import org.eclipse.jetty.websocket.core.internal.PerMessageDeflateExtension;
 import org.junit.jupiter.api.Test;
 
 import static org.hamcrest.MatcherAssert.assertThat;
+import static org.hamcrest.Matchers.containsString;
 import static org.hamcrest.Matchers.instanceOf;
 import static org.hamcrest.Matchers.is;
+import static org.hamcrest.Matchers.lessThan;
 import static org.junit.jupiter.api.Assertions.assertThrows;
 
 /**
@@ -599,9 +602,153 @@ public class PerMessageDeflateExtensionTest extends AbstractExtensionTest
         tester.assertHasFrames("tora", "tora", "tora");
     }
 
+    @Test
+    public void testOutgoingMessageBelowThresholdNotCompressed()
+    {
+        PerMessageDeflateExtension ext = new PerMessageDeflateExtension();
+        ext.init(ExtensionConfig.parse("permessage-deflate; @deflate_threshold=64"), components);
+        ext.setCoreSession(newSession());
+        OutgoingFramesCapture capture = new OutgoingFramesCapture();
+        ext.setNextOutgoingFrames(capture);
+
+        String small = "Hello";
+        String large = "Hello World ".repeat(16);
+        ext.sendFrame(new Frame(OpCode.TEXT).setPayload(small), Callback.NOOP, false);
+        ext.sendFrame(new Frame(OpCode.TEXT).setPayload(large), Callback.NOOP, false);
+
+        capture.assertFrameCount(2);
+        Frame actual = capture.frames.poll();
+        assertThat("Frame.rsv1", actual.isRsv1(), is(false));
+        ByteBufferAssert.assertEquals("Frame.payload", BufferUtil.toBuffer(small, StandardCharsets.UTF_8), actual.getPayload().slice());
+
+        actual = capture.frames.poll();
+        assertThat("Frame.rsv1", actual.isRsv1(), is(true));
+        assertThat("Frame.payloadLength", actual.getPayloadLength(), lessThan(large.length()));
+    }
+
+    @Test
+    public void testServerMaxWindowBits()
+    {
+        PerMessageDeflateExtension ext = new PerMessageDeflateExtension();
+        ext.init(ExtensionConfig.parse("permessage-deflate; server_max_window_bits=10"), components);
+        ext.setCoreSession(newSession());
+        OutgoingFramesCapture capture = new OutgoingFramesCapture();
+        ext.setNextOutgoingFrames(capture);
+
+        assertThat(ext.getConfig().getParameterizedName(), containsString("server_max_window_bits=10"));
+
+        // Fits in the 1 KB window, so it is compressed.
+        ext.sendFrame(new Frame(OpCode.TEXT).setPayload("x".repeat(1024)), Callback.NOOP, false);
+        // Larger than the window, so it is not compressed.
+        ext.sendFrame(new Frame(OpCode.TEXT).setPayload("x".repeat(1025)), Callback.NOOP, false);
+
+        capture.assertFrameCount(2);
+        assertThat("Frame.rsv1", capture.frames.poll().isRsv1(), is(true));
+        assertThat("Frame.rsv1", capture.frames.poll().isRsv1(), is(false));
+
+        // There is no context takeover, so the Deflater is released between messages.
+        assertThat(ext.getNativeMemory(), is(0L));
+    }
+
+    @Test
+    public void testClientMaxWindowBits()
+    {
+        // The server response limits the window of the client compressor, not the one of the server.
+        PerMessageDeflateExtension ext = new PerMessageDeflateExtension();
+        ext.init(ExtensionConfig.parse("permessage-deflate; client_max_window_bits=10; server_max_window_bits=8"), components);
+        ext.setCoreSession(newSession(Behavior.CLIENT));
+        OutgoingFramesCapture capture = new OutgoingFramesCapture();
+        ext.setNextOutgoingFrames(capture);
+
+        ext.sendFrame(new Frame(OpCode.TEXT).setPayload("x".repeat(1024)), Callback.NOOP, false);
+        ext.sendFrame(new Frame(OpCode.TEXT).setPayload("x".repeat(1025)), Callback.NOOP, false);
+
+        capture.assertFrameCount(2);
+        assertThat("Frame.rsv1", capture.frames.poll().isRsv1(), is(true));
+        assertThat("Frame.rsv1", capture.frames.poll().isRsv1(), is(false));
+    }
+
+    @Test
+    public void testServerIgnoresClientMaxWindowBits()
+    {
+        PerMessageDeflateExtension ext = new PerMessageDeflateExtension();
+        ext.init(ExtensionConfig.parse("permessage-deflate; client_max_window_bits=8"), components);
+        ext.setCoreSession(newSession());
+        OutgoingFramesCapture capture = new OutgoingFramesCapture();
+        ext.setNextOutgoingFrames(capture);
+
+        ext.sendFrame(new Frame(OpCode.TEXT).setPayload("x".repeat(1024)), Callback.NOOP, false);
+
+        capture.assertFrameCount(1);
+        assertThat("Frame.rsv1", capture.frames.poll().isRsv1(), is(true));
+    }
+
+    @Test
+    public void testServerMaxWindowBitsWithPresetDictionary()
+    {
+        // Back references may point into the dictionary, so it takes room in the window.
+        ExtensionConfig config = ExtensionConfig.parse("permessage-deflate; server_max_window_bits=10");
+        config.setParameter("@deflate_dictionary", Base64.getEncoder().encodeToString("x".repeat(24).getBytes(StandardCharsets.UTF_8)));
+        PerMessageDeflateExtension ext = new PerMessageDeflateExtension();
+        ext.init(config, components);
+        ext.setCoreSession(newSession());
+        OutgoingFramesCapture capture = new OutgoingFramesCapture();
+        ext.setNextOutgoingFrames(capture);
+
+        ext.sendFrame(new Frame(OpCode.TEXT).setPayload("x".repeat(1000)), Callback.NOOP, false);
+        ext.sendFrame(new Frame(OpCode.TEXT).setPayload("x".repeat(1001)), Callback.NOOP, false);
+
+        capture.assertFrameCount(2);
+        assertThat("Frame.rsv1", capture.frames.poll().isRsv1(), is(true));
+        assertThat("Frame.rsv1", capture.frames.poll().isRsv1(), is(false));
+    }
+
+    @Test
+    public void testPresetDictionary()
+    {
+        String json = "{\"id\":12345,\"type\":\"quote\",\"symbol\":\"ACME\",\"price\":123.45,\"currency\":\"USD\"}";
+        String dictionary = Base64.getEncoder().encodeToString("{\"id\":,\"type\":\"quote\",\"symbol\":\"\",\"price\":,\"currency\":\"USD\"}".getBytes(StandardCharsets.UTF_8));
+
+        ExtensionConfig config = ExtensionConfig.parse("permessage-deflate");
+        config.setParameter("@deflate_dictionary", dictionary);
+
+        PerMessageDeflateExtension plain = new PerMessageDeflateExtension();
+        plain.init(ExtensionConfig.parse("permessage-deflate"), components);
+        plain.setCoreSession(newSession());
+        OutgoingFramesCapture plainCapture = new OutgoingFramesCapture();
+        plain.setNextOutgoingFrames(plainCapture);
+        plain.sendFrame(new Frame(OpCode.TEXT).setPayload(json), Callback.NOOP, false);
+
+        PerMessageDeflateExtension sender = new PerMessageDeflateExtension();
+        sender.init(config, components);
+        sender.setCoreSession(newSession());
+        OutgoingFramesCapture outgoing = new OutgoingFramesCapture();
+        sender.setNextOutgoingFrames(outgoing);
+        sender.sendFrame(new Frame(OpCode.TEXT).setPayload(json), Callback.NOOP, false);
+
+        Frame compressed = outgoing.frames.poll();
+        assertThat(compressed.getPayloadLength(), lessThan(plainCapture.frames.poll().getPayloadLength()));
+
+        WebSocketCoreSession coreSession = newSession(config);
+        PerMessageDeflateExtension receiver = (PerMessageDeflateExtension)coreSession.getExtensionStack().getExtensions().get(0);
+        IncomingFramesCapture incoming = new IncomingFramesCapture();
+        receiver.setNextIncomingFrames(incoming);
+        coreSession.demand();
+        receiver.onFrame(compressed, Callback.NOOP);
+
+        incoming.assertFrameCount(1);
+        Frame actual = incoming.frames.poll();
+        ByteBufferAssert.assertEquals("Frame.payload", BufferUtil.toBuffer(json, StandardCharsets.UTF_8), actual.getPayload().slice());
+    }
+
     private WebSocketCoreSession newSession()
     {
-        return newSession(null);
+        return newSession((ExtensionConfig)null);
+    }
+
+    private WebSocketCoreSession newSession(Behavior behavior)
+    {
+        return newSessionFromConfig(new ConfigurationCustomizer(), Collections.emptyList(), behavior);
     }
 
     private WebSocketCoreSession newSession(ExtensionConfig config)
@@ -611,10 +758,15 @@ public class PerMessageDeflateExtensionTest extends AbstractExtensionTest
 
     private WebSocketCoreSession newSessionFromConfig(ConfigurationCustomizer configuration, List<ExtensionConfig> configs)
     {
-        ExtensionStack exStack = new ExtensionStack(components, Behavior.SERVER);
+        return newSessionFromConfig(configuration, configs, Behavior.SERVER);
+    }
+
+    private WebSocketCoreSession newSessionFromConfig(ConfigurationCustomizer configuration, List<ExtensionConfig> configs, Behavior behavior)
+    {
+        ExtensionStack exStack = new ExtensionStack(components, behavior);
         exStack.negotiate(configs, configs);
         exStack.setLastDemand(() -> {}); // Never delegate to WebSocketConnection as it is null for this test.
-        WebSocketCoreSession coreSession = new WebSocketCoreSession(new TestMessageHandler(), Behavior.SERVER, Negotiated.from(exStack), components);
+        WebSocketCoreSession coreSession = new WebSocketCoreSession(new TestMessageHandler(), behavior, Negotiated.from(exStack), components);
         configuration.customize(configuration);
         return coreSession;
     }
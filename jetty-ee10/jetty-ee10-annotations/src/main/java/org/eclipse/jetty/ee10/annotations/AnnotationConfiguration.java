@@ -13,6 +13,7 @@
 
 package org.eclipse.jetty.ee10.annotations;
 
+import java.io.IOException;
 import java.net.URI;
 import java.util.ArrayList;
 import java.util.Arrays;
@@ -43,6 +44,7 @@ import org.eclipse.jetty.ee10.webapp.FragmentConfiguration;
 import org.eclipse.jetty.ee10.webapp.FragmentDescriptor;
 import org.eclipse.jetty.ee10.webapp.JettyWebXmlConfiguration;
 import org.eclipse.jetty.ee10.webapp.MetaInfConfiguration;
+import org.eclipse.jetty.ee10.webapp.ScanIndex;
 import org.eclipse.jetty.ee10.webapp.WebAppClassLoader;
 import org.eclipse.jetty.ee10.webapp.WebAppContext;
 import org.eclipse.jetty.ee10.webapp.WebDescriptor;
@@ -511,6 +513,9 @@ public class AnnotationConfiguration extends AbstractConfiguration
         if (target != null)
             javaPlatform = Integer.parseInt(target.toString());
         AnnotationParser parser = createAnnotationParser(javaPlatform);
+        ScanIndex scanIndex = ScanIndex.getScanIndex(context);
+        parser.setScanIndex(scanIndex);
+        parser.setJavaPlatform(javaPlatform);
         state._parserTasks = new ArrayList<>();
 
         if (LOG.isDebugEnabled())
@@ -572,6 +577,18 @@ public class AnnotationConfiguration extends AbstractConfiguration
         if (timeout)
             multiException.add(new Exception("Timeout scanning annotations"));
         multiException.ifExceptionThrow();
+
+        if (scanIndex != null)
+        {
+            try
+            {
+                scanIndex.save();
+            }
+            catch (IOException e)
+            {
+                LOG.warn("Unable to save {}", scanIndex, e);
+            }
+        }
     }
 
     /**
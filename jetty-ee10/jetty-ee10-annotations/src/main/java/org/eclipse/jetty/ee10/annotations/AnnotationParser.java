@@ -18,13 +18,18 @@ import java.io.InputStream;
 import java.net.URI;
 import java.nio.file.Files;
 import java.nio.file.Path;
+import java.util.ArrayList;
 import java.util.Arrays;
 import java.util.Collections;
+import java.util.HashSet;
+import java.util.Iterator;
+import java.util.List;
 import java.util.Map;
 import java.util.Optional;
 import java.util.Set;
 import java.util.concurrent.ConcurrentHashMap;
 
+import org.eclipse.jetty.ee10.webapp.ScanIndex;
 import org.eclipse.jetty.util.ExceptionUtil;
 import org.eclipse.jetty.util.FileID;
 import org.eclipse.jetty.util.StringUtil;
@@ -61,12 +66,15 @@ public class AnnotationParser
 {
     private static final Logger LOG = LoggerFactory.getLogger(AnnotationParser.class);
     private static final int ASM_VERSION = asmVersion();
+    private static final String SCAN_INDEX_TYPE = "classes";
 
     /**
      * Map of classnames scanned and the first location from which scan occurred
      */
     protected Map<String, URI> _parsedClassNames = new ConcurrentHashMap<>();
     private final int _asmVersion;
+    private ScanIndex _scanIndex;
+    private int _javaPlatform;
 
     /**
      * Determine the runtime version of asm.
@@ -535,6 +543,51 @@ public class AnnotationParser
         _asmVersion = asmVersion;
     }
 
+    /**
+     * @return the index of jars already parsed, or null if jars are always parsed
+     */
+    public ScanIndex getScanIndex()
+    {
+        return _scanIndex;
+    }
+
+    /**
+     * <p>Set the index of jars already parsed.</p>
+     * <p>The classes and annotations found in a jar are recorded in the index, so that they can
+     * be replayed to the handlers without parsing the jar again, until the jar changes.</p>
+     *
+     * @param scanIndex the index, or null to always parse jars
+     */
+    public void setScanIndex(ScanIndex scanIndex)
+    {
+        _scanIndex = scanIndex;
+    }
+
+    /**
+     * @return the java platform the jars are parsed for, or 0 for the runtime platform
+     */
+    public int getJavaPlatform()
+    {
+        return _javaPlatform;
+    }
+
+    /**
+     * <p>Set the java platform the jars are parsed for.</p>
+     * <p>The platform is part of the key of the {@link #getScanIndex() index} entries,
+     * so that the results recorded for one platform are not replayed for another.</p>
+     *
+     * @param javaPlatform the java platform, or 0 for the runtime platform
+     */
+    public void setJavaPlatform(int javaPlatform)
+    {
+        _javaPlatform = javaPlatform;
+    }
+
+    private String getScanIndexType()
+    {
+        return SCAN_INDEX_TYPE + ":" + _javaPlatform + ":" + _asmVersion;
+    }
+
     /**
      * Parse a resource
      *
@@ -638,8 +691,160 @@ public class AnnotationParser
         try (ResourceFactory.Closeable resourceFactory = ResourceFactory.closeable())
         {
             Resource insideJarResource = resourceFactory.newJarFileResource(jarResource.getURI());
-            parseDir(handlers, insideJarResource);
+
+            ScanIndex scanIndex = _scanIndex;
+            if (scanIndex == null)
+            {
+                parseDir(handlers, insideJarResource);
+                return;
+            }
+
+            String scanIndexType = getScanIndexType();
+            List<String> tokens = scanIndex.get(jarResource, scanIndexType);
+            if (tokens != null)
+            {
+                if (LOG.isDebugEnabled())
+                    LOG.debug("Replaying jar {} from {}", jarResource, scanIndex);
+                replay(handlers, insideJarResource, tokens);
+                return;
+            }
+
+            Recorder recorder = new Recorder();
+            Set<Handler> recording = new HashSet<>(handlers);
+            recording.add(recorder);
+            parseDir(recording, insideJarResource);
+            scanIndex.put(jarResource, scanIndexType, recorder._tokens);
+        }
+    }
+
+    /**
+     * Replay to the handlers the classes and annotations recorded by a {@link Recorder}.
+     *
+     * @param handlers the handlers to call back
+     * @param containingResource the mounted jar the tokens were recorded from
+     * @param tokens the recorded tokens
+     */
+    private void replay(Set<? extends Handler> handlers, Resource containingResource, List<String> tokens)
+    {
+        ClassInfo classInfo = null;
+        Iterator<String> i = tokens.iterator();
+        while (i.hasNext())
+        {
+            String token = i.next();
+            switch (token)
+            {
+                case "C" ->
+                {
+                    String className = i.next();
+                    int version = Integer.parseInt(i.next());
+                    int access = Integer.parseInt(i.next());
+                    String signature = i.next();
+                    String superName = i.next();
+                    String[] interfaces = nextArray(i);
+                    classInfo = new ClassInfo(containingResource, className, version, access, signature, superName, interfaces);
+                    for (Handler h : handlers)
+                    {
+                        h.handle(classInfo);
+                    }
+
+                    URI location = containingResource.resolve(className.replace('.', '/') + ".class").getURI();
+                    URI existing = _parsedClassNames.putIfAbsent(className, location);
+                    if (existing != null)
+                        LOG.warn("{} scanned from multiple locations: {}, {}", className, existing, location);
+                }
+                case "CA" ->
+                {
+                    String annotationName = i.next();
+                    for (Handler h : handlers)
+                    {
+                        h.handle(classInfo, annotationName);
+                    }
+                }
+                case "M" ->
+                {
+                    MethodInfo methodInfo = nextMethodInfo(i, classInfo);
+                    for (Handler h : handlers)
+                    {
+                        h.handle(methodInfo);
+                    }
+                }
+                case "MA" ->
+                {
+                    MethodInfo methodInfo = nextMethodInfo(i, classInfo);
+                    String annotationName = i.next();
+                    for (Handler h : handlers)
+                    {
+                        h.handle(methodInfo, annotationName);
+                    }
+                }
+                case "F" ->
+                {
+                    FieldInfo fieldInfo = nextFieldInfo(i, classInfo);
+                    for (Handler h : handlers)
+                    {
+                        h.handle(fieldInfo);
+                    }
+                }
+                case "FA" ->
+                {
+                    FieldInfo fieldInfo = nextFieldInfo(i, classInfo);
+                    String annotationName = i.next();
+                    for (Handler h : handlers)
+                    {
+                        h.handle(fieldInfo, annotationName);
+                    }
+                }
+                default -> throw new IllegalStateException("Invalid token " + token);
+            }
+        }
+    }
+
+    private static MethodInfo nextMethodInfo(Iterator<String> i, ClassInfo classInfo)
+    {
+        String methodName = i.next();
+        int access = Integer.parseInt(i.next());
+        String desc = i.next();
+        String signature = i.next();
+        String[] exceptions = nextArray(i);
+        return new MethodInfo(classInfo, methodName, access, desc, signature, exceptions);
+    }
+
+    private static FieldInfo nextFieldInfo(Iterator<String> i, ClassInfo classInfo)
+    {
+        String fieldName = i.next();
+        int access = Integer.parseInt(i.next());
+        String fieldType = i.next();
+        String signature = i.next();
+        Object value = toValue(i.next(), i.next());
+        return new FieldInfo(classInfo, fieldName, access, fieldType, signature, value);
+    }
+
+    private static String[] nextArray(Iterator<String> i)
+    {
+        int length = Integer.parseInt(i.next());
+        if (length < 0)
+            return null;
+        String[] array = new String[length];
+        for (int a = 0; a < length; a++)
+        {
+            array[a] = i.next();
         }
+        return array;
+    }
+
+    private static Object toValue(String type, String value)
+    {
+        if (type == null)
+            return null;
+        return switch (type)
+        {
+            case "S" -> value;
+            case "I" -> Integer.valueOf(value);
+            case "J" -> Long.valueOf(value);
+            case "F" -> Float.valueOf(value);
+            case "D" -> Double.valueOf(value);
+            default -> throw new IllegalStateException("Invalid value type " + type);
+        };
     }
 
     /**
@@ -673,6 +878,108 @@ public class AnnotationParser
         }
     }
     
+    /**
+     * A {@link Handler} that records, as a list of tokens, the classes and annotations
+     * parsed from a jar, so that they can be stored in a {@link ScanIndex} and replayed.
+     */
+    private static class Recorder implements Handler
+    {
+        private final List<String> _tokens = new ArrayList<>();
+
+        @Override
+        public void handle(ClassInfo classInfo)
+        {
+            _tokens.add("C");
+            _tokens.add(classInfo.getClassName());
+            _tokens.add(Integer.toString(classInfo.getVersion()));
+            _tokens.add(Integer.toString(classInfo.getAccess()));
+            _tokens.add(classInfo.getSignature());
+            _tokens.add(classInfo.getSuperName());
+            addArray(classInfo.getInterfaces());
+        }
+
+        @Override
+        public void handle(MethodInfo methodInfo)
+        {
+            _tokens.add("M");
+            addMethodInfo(methodInfo);
+        }
+
+        @Override
+        public void handle(FieldInfo fieldInfo)
+        {
+            _tokens.add("F");
+            addFieldInfo(fieldInfo);
+        }
+
+        @Override
+        public void handle(ClassInfo info, String annotationName)
+        {
+            _tokens.add("CA");
+            _tokens.add(annotationName);
+        }
+
+        @Override
+        public void handle(MethodInfo info, String annotationName)
+        {
+            _tokens.add("MA");
+            addMethodInfo(info);
+            _tokens.add(annotationName);
+        }
+
+        @Override
+        public void handle(FieldInfo info, String annotationName)
+        {
+            _tokens.add("FA");
+            addFieldInfo(info);
+            _tokens.add(annotationName);
+        }
+
+        private void addMethodInfo(MethodInfo info)
+        {
+            _tokens.add(info.getMethodName());
+            _tokens.add(Integer.toString(info.getAccess()));
+            _tokens.add(info.getDesc());
+            _tokens.add(info.getSignature());
+            addArray(info.getExceptions());
+        }
+
+        private void addFieldInfo(FieldInfo info)
+        {
+            _tokens.add(info.getFieldName());
+            _tokens.add(Integer.toString(info.getAccess()));
+            _tokens.add(info.getFieldType());
+            _tokens.add(info.getSignature());
+            Object value = info.getValue();
+            if (value == null)
+                _tokens.add(null);
+            else if (value instanceof String)
+                _tokens.add("S");
+            else if (value instanceof Integer)
+                _tokens.add("I");
+            else if (value instanceof Long)
+                _tokens.add("J");
+            else if (value instanceof Float)
+                _tokens.add("F");
+            else if (value instanceof Double)
+                _tokens.add("D");
+            else
+                throw new IllegalStateException("Invalid value " + value);
+            _tokens.add(value == null ? null : value.toString());
+        }
+
+        private void addArray(String[] array)
+        {
+            if (array == null)
+            {
+                _tokens.add("-1");
+                return;
+            }
+            _tokens.add(Integer.toString(array.length));
+            _tokens.addAll(Arrays.asList(array));
+        }
+    }
+
     /**
      * Useful mostly for testing to expose the list of parsed classes.
      * @return the map of classnames to their URIs
@@ -30,6 +30,7 @@ import java.util.Set;
 import java.util.concurrent.ConcurrentHashMap;
 import java.util.concurrent.CopyOnWriteArrayList;
 
+import org.eclipse.jetty.ee10.webapp.ScanIndex;
 import org.eclipse.jetty.toolchain.test.FS;
 import org.eclipse.jetty.toolchain.test.MavenTestingUtils;
 import org.eclipse.jetty.toolchain.test.jupiter.WorkDir;
@@ -44,12 +45,15 @@ import static org.hamcrest.MatcherAssert.assertThat;
 import static org.hamcrest.Matchers.contains;
 import static org.hamcrest.Matchers.containsInAnyOrder;
 import static org.hamcrest.Matchers.containsString;
+import static org.hamcrest.Matchers.empty;
 import static org.hamcrest.Matchers.in;
 import static org.hamcrest.Matchers.is;
+import static org.hamcrest.Matchers.not;
 import static org.hamcrest.Matchers.notNullValue;
 import static org.junit.jupiter.api.Assertions.assertEquals;
 import static org.junit.jupiter.api.Assertions.assertNotEquals;
 import static org.junit.jupiter.api.Assertions.assertNotNull;
+import static org.junit.jupiter.api.Assertions.assertTrue;
 
 @ExtendWith(WorkDirExtension.class)
 public class TestAnnotationParser
@@ -319,6 +323,91 @@ public class TestAnnotationParser
         }
     }
 
+    @Test
+    public void testScanIndexReplaysJar(WorkDir workDir) throws Exception
+    {
+        Path indexFile = workDir.getEmptyPathDir().resolve("scan.index");
+        Path jar = MavenTestingUtils.getTestResourcePathFile("jdk9/log4j-api-2.9.0.jar");
+
+        EventHandler parsed = new EventHandler();
+        AnnotationParser parser = new AnnotationParser();
+        ScanIndex scanIndex = new ScanIndex(indexFile);
+        parser.setScanIndex(scanIndex);
+        try (ResourceFactory.Closeable resourceFactory = ResourceFactory.closeable())
+        {
+            parser.parse(Collections.singleton(parsed), resourceFactory.newResource(jar));
+        }
+        scanIndex.save();
+        assertTrue(Files.exists(indexFile));
+
+        EventHandler replayed = new EventHandler();
+        AnnotationParser replayParser = new AnnotationParser();
+        ScanIndex loadedIndex = new ScanIndex(indexFile);
+        assertEquals(1, loadedIndex.size());
+        replayParser.setScanIndex(loadedIndex);
+        try (ResourceFactory.Closeable resourceFactory = ResourceFactory.closeable())
+        {
+            replayParser.parse(Collections.singleton(replayed), resourceFactory.newResource(jar));
+        }
+
+        assertThat(parsed.events, not(empty()));
+        assertThat(replayed.events, containsInAnyOrder(parsed.events.toArray()));
+        assertEquals(parser.getParsedClassNames().keySet(), replayParser.getParsedClassNames().keySet());
+    }
+
+    @Test
+    public void testScanIndexPrunesRemovedJars(WorkDir workDir) throws Exception
+    {
+        Path dir = workDir.getEmptyPathDir();
+        Path indexFile = dir.resolve("scan.index");
+        Path jar = Files.copy(MavenTestingUtils.getTestResourcePathFile("jdk9/log4j-api-2.9.0.jar"), dir.resolve("log4j-api.jar"));
+
+        AnnotationParser parser = new AnnotationParser();
+        ScanIndex scanIndex = new ScanIndex(indexFile);
+        parser.setScanIndex(scanIndex);
+        try (ResourceFactory.Closeable resourceFactory = ResourceFactory.closeable())
+        {
+            parser.parse(Collections.singleton(new EventHandler()), resourceFactory.newResource(jar));
+        }
+        scanIndex.save();
+        assertEquals(1, new ScanIndex(indexFile).size());
+
+        Files.delete(jar);
+        scanIndex.save();
+
+        assertEquals(0, scanIndex.size());
+        assertEquals(0, new ScanIndex(indexFile).size());
+    }
+
+    public static class EventHandler extends AnnotationParser.AbstractHandler
+    {
+        private final List<String> events = new CopyOnWriteArrayList<>();
+
+        @Override
+        public void handle(AnnotationParser.ClassInfo info)
+        {
+            events.add("class " + info.getClassName() + " " + info.getSuperName() + " " + Arrays.toString(info.getInterfaces()));
+        }
+
+        @Override
+        public void handle(AnnotationParser.ClassInfo info, String annotationName)
+        {
+            events.add("class " + info.getClassName() + " @" + annotationName);
+        }
+
+        @Override
+        public void handle(AnnotationParser.MethodInfo info, String annotationName)
+        {
+            events.add("method " + info.getClassInfo().getClassName() + "." + info.getMethodName() + info.getDesc() + " @" + annotationName);
+        }
+
+        @Override
+        public void handle(AnnotationParser.FieldInfo info, String annotationName)
+        {
+            events.add("field " + info.getClassInfo().getClassName() + "." + info.getFieldName() + "=" + info.getValue() + " @" + annotationName);
+        }
+    }
+
     private void copyClass(Class<?> clazz, Path outputDir) throws IOException, URISyntaxException
     {
         String classRef = TypeUtil.toClassReference(clazz);
@@ -0,0 +1,198 @@
+//
+// ========================================================================
+// Copyright (c) 1995 Mort Bay Consulting Pty Ltd and others.
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License v. 2.0 which is available at
+// https://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+// ========================================================================
+//
+
+package org.eclipse.jetty.ee10.session.jdbc;
+
+import java.util.Set;
+
+import org.eclipse.jetty.session.AbstractSessionDataStoreTest;
+import org.eclipse.jetty.session.JDBCSessionDataStore;
+import org.eclipse.jetty.session.JDBCSessionDataStoreFactory;
+import org.eclipse.jetty.session.JdbcTestHelper;
+import org.eclipse.jetty.session.SessionData;
+import org.eclipse.jetty.session.SessionDataStore;
+import org.eclipse.jetty.session.SessionDataStoreFactory;
+import org.junit.jupiter.api.AfterEach;
+import org.junit.jupiter.api.BeforeEach;
+import org.junit.jupiter.api.Test;
+import org.testcontainers.junit.jupiter.Testcontainers;
+
+import static org.hamcrest.MatcherAssert.assertThat;
+import static org.hamcrest.Matchers.containsInAnyOrder;
+import static org.junit.jupiter.api.Assertions.assertEquals;
+import static org.junit.jupiter.api.Assertions.assertFalse;
+import static org.junit.jupiter.api.Assertions.assertNotNull;
+import static org.junit.jupiter.api.Assertions.assertTrue;
+
+/**
+ * Run the SessionDataStore tests with write behind, partial updates
+ * and paginated expiry scans enabled.
+ */
+@Testcontainers(disabledWithoutDocker = true)
+public class JDBCSessionDataStoreWriteBehindTest extends AbstractSessionDataStoreTest
+{
+    // Long enough that the tests control when the stores are flushed.
+    public static final long WRITE_BEHIND_MS = 60_000;
+    public static final int EXPIRY_PAGE_SIZE = 2;
+
+    public JDBCSessionDataStoreWriteBehindTest() throws Exception
+    {
+        super();
+    }
+
+    private String sessionTableName;
+
+    @BeforeEach
+    public void setupSessionTableName() throws Exception
+    {
+        this.sessionTableName = getClass().getSimpleName() + "_" + System.nanoTime();
+        JdbcTestHelper.prepareTables(sessionTableName);
+    }
+
+    @AfterEach
+    public void tearDown() throws Exception
+    {
+        JdbcTestHelper.shutdown(sessionTableName);
+    }
+
+    @Override
+    public SessionDataStoreFactory createSessionDataStoreFactory()
+    {
+        JDBCSessionDataStoreFactory factory = (JDBCSessionDataStoreFactory)JdbcTestHelper.newSessionDataStoreFactory(sessionTableName, false);
+        factory.setWriteBehindMs(WRITE_BEHIND_MS);
+        factory.setPartialUpdates(true);
+        factory.setExpiryPageSize(EXPIRY_PAGE_SIZE);
+        return factory;
+    }
+
+    @Override
+    public void persistSession(SessionData data)
+        throws Exception
+    {
+        JdbcTestHelper.insertSession(data, sessionTableName, false);
+    }
+
+    @Override
+    public void persistUnreadableSession(SessionData data) throws Exception
+    {
+        JdbcTestHelper.insertUnreadableSession(data.getId(), data.getContextPath(), data.getVhost(), data.getLastNode(),
+            data.getCreated(), data.getAccessed(), data.getLastAccessed(),
+            data.getMaxInactiveMs(), data.getExpiry(), data.getCookieSet(),
+            data.getLastSaved(), sessionTableName);
+    }
+
+    @Override
+    public boolean checkSessionExists(SessionData data) throws Exception
+    {
+        flush();
+        return JdbcTestHelper.existsInSessionTable(data.getId(), false, sessionTableName);
+    }
+
+    @Override
+    public boolean checkSessionPersisted(SessionData data) throws Exception
+    {
+        flush();
+        ClassLoader old = Thread.currentThread().getContextClassLoader();
+        Thread.currentThread().setContextClassLoader(_contextClassLoader);
+        try
+        {
+            return JdbcTestHelper.checkSessionPersisted(data, sessionTableName, false);
+        }
+        finally
+        {
+            Thread.currentThread().setContextClassLoader(old);
+        }
+    }
+
+    private void flush() throws Exception
+    {
+        if (_sessionManager != null && _sessionManager.isStarted())
+            ((JDBCSessionDataStore)_sessionManager.getSessionCache().getSessionDataStore()).flush();
+    }
+
+    @Test
+    public void testStoresCoalesced() throws Exception
+    {
+        setUp();
+        _server.start();
+
+        JDBCSessionDataStore store = (JDBCSessionDataStore)_sessionManager.getSessionCache().getSessionDataStore();
+
+        long now = System.currentTimeMillis();
+        SessionData data = store.newSessionData("wb1", 100, now, now - 1, -1); //never expires
+        data.setLastNode(_sessionIdManager.getWorkerName());
+        data.setAttribute("a", "b");
+        store.store("wb1", data);
+
+        data.setAccessed(now + 1);
+        data.setAttribute("a", "c");
+        store.store("wb1", data);
+
+        //both stores are queued as a single insert
+        assertEquals(1, store.getPendingStoreCount());
+        assertFalse(JdbcTestHelper.existsInSessionTable("wb1", false, sessionTableName));
+
+        //loading flushes the queued store
+        SessionData loaded = store.load("wb1");
+        assertNotNull(loaded);
+        assertEquals("c", loaded.getAttribute("a"));
+        assertEquals(now + 1, loaded.getAccessed());
+        assertEquals(0, store.getPendingStoreCount());
+        assertTrue(checkSessionPersisted(data));
+    }
+
+    @Test
+    public void testStopFlushes() throws Exception
+    {
+        setUp();
+        _server.start();
+
+        SessionDataStore store = _sessionManager.getSessionCache().getSessionDataStore();
+
+        long now = System.currentTimeMillis();
+        SessionData data = store.newSessionData("wb2", 100, now, now - 1, -1); //never expires
+        data.setLastNode(_sessionIdManager.getWorkerName());
+        data.setAttribute("a", "b");
+        store.store("wb2", data);
+        assertFalse(JdbcTestHelper.existsInSessionTable("wb2", false, sessionTableName));
+
+        _server.stop();
+
+        assertTrue(JdbcTestHelper.existsInSessionTable("wb2", false, sessionTableName));
+    }
+
+    @Test
+    public void testGetExpiredByPage() throws Exception
+    {
+        setUp();
+        _server.start();
+
+        SessionDataStore store = _sessionManager.getSessionCache().getSessionDataStore();
+
+        //persist more expired sessions than fit in a page, some with the same expiry
+        for (int i = 0; i < 2 * EXPIRY_PAGE_SIZE + 1; ++i)
+        {
+            SessionData data = store.newSessionData("page" + i, 100, 101, 101, 10);
+            data.setLastNode(_sessionIdManager.getWorkerName());
+            data.setExpiry(RECENT_TIMESTAMP - (i / 2));
+            persistSession(data);
+        }
+
+        _server.stop();
+        _server.start();
+        store = _sessionManager.getSessionCache().getSessionDataStore();
+
+        Set<String> expiredIds = store.getExpired(Set.of());
+        assertThat(expiredIds, containsInAnyOrder("page0", "page1", "page2", "page3", "page4"));
+    }
+}
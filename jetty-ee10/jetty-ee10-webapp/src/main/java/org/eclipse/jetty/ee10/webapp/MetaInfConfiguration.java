@@ -308,7 +308,8 @@ public class MetaInfConfiguration extends AbstractConfiguration
     /**
      * Look into the jars to discover info in META-INF. If useCaches == true, then we will
      * cache the info discovered indexed by the jar in which it was discovered: this speeds
-     * up subsequent context deployments.
+     * up subsequent context deployments. If a {@link ScanIndex} is configured, the info is
+     * also persisted, so that unchanged jars are not scanned again after a restart.
      *
      * @param context the context for the scan
      * @param jars the jars resources to scan
@@ -345,6 +346,18 @@ public class MetaInfConfiguration extends AbstractConfiguration
             }
         }
 
+        //The results of the scans are read back from the caches to be indexed
+        ScanIndex scanIndex = ScanIndex.getScanIndex(context);
+        if (scanIndex != null)
+        {
+            if (metaInfResourceCache == null)
+                metaInfResourceCache = new ConcurrentHashMap<>();
+            if (metaInfFragmentCache == null)
+                metaInfFragmentCache = new ConcurrentHashMap<>();
+            if (metaInfTldCache == null)
+                metaInfTldCache = new ConcurrentHashMap<>();
+        }
+
         //Scan jars for META-INF information
         if (jars != null)
         {
@@ -352,6 +365,10 @@ public class MetaInfConfiguration extends AbstractConfiguration
             {
                 for (Resource dir : jars)
                 {
+                    Resource jar = dir;
+                    if (scanIndex != null && scanFromIndex(context, scanIndex, jar, scanTypes))
+                        continue;
+
                     try
                     {
                         //If not already a directory, convert by mounting as jar file
@@ -373,9 +390,102 @@ public class MetaInfConfiguration extends AbstractConfiguration
                         scanForFragment(context, dir, metaInfFragmentCache);
                     if (scanTypes.contains(METAINF_TLDS))
                         scanForTlds(context, dir, metaInfTldCache);
+
+                    if (scanIndex != null && jar != dir)
+                    {
+                        if (scanTypes.contains(METAINF_RESOURCES))
+                            scanIndex.put(jar, METAINF_RESOURCES, toURIs(metaInfResourceCache.get(dir)));
+                        if (scanTypes.contains(METAINF_FRAGMENTS))
+                            scanIndex.put(jar, METAINF_FRAGMENTS, toURIs(metaInfFragmentCache.get(dir)));
+                        if (scanTypes.contains(METAINF_TLDS))
+                            scanIndex.put(jar, METAINF_TLDS, metaInfTldCache.getOrDefault(dir, List.of()).stream().map(URL::toString).toList());
+                    }
                 }
             }
         }
+
+        if (scanIndex != null)
+        {
+            try
+            {
+                scanIndex.save();
+            }
+            catch (IOException e)
+            {
+                LOG.warn("Unable to save {}", scanIndex, e);
+            }
+        }
+    }
+
+    private static List<String> toURIs(Resource resource)
+    {
+        return resource == null ? List.of() : List.of(resource.getURI().toString());
+    }
+
+    /**
+     * Apply the META-INF info of a jar from the {@link ScanIndex}, without opening the jar.
+     *
+     * @param context the context for the scan
+     * @param scanIndex the index
+     * @param jar the jar
+     * @param scanTypes the type of things to look for in the jar
+     * @return true if the jar was indexed for all the scan types, false if it needs to be scanned
+     * @throws Exception if unable to apply the indexed info
+     */
+    @SuppressWarnings("unchecked")
+    protected boolean scanFromIndex(WebAppContext context, ScanIndex scanIndex, Resource jar, List<String> scanTypes) throws Exception
+    {
+        List<String> resources = scanTypes.contains(METAINF_RESOURCES) ? scanIndex.get(jar, METAINF_RESOURCES) : List.of();
+        List<String> fragments = scanTypes.contains(METAINF_FRAGMENTS) ? scanIndex.get(jar, METAINF_FRAGMENTS) : List.of();
+        List<String> tlds = scanTypes.contains(METAINF_TLDS) ? scanIndex.get(jar, METAINF_TLDS) : List.of();
+        if (resources == null || fragments == null || tlds == null)
+            return false;
+
+        if (LOG.isDebugEnabled())
+            LOG.debug("{} META-INF found in {}", jar, scanIndex);
+
+        for (String uri : resources)
+        {
+            Resource resourcesDir = context.getResourceFactory().newResource(URI.create(uri));
+            if (isEmptyResource(resourcesDir))
+                continue;
+            Set<Resource> dirs = (Set<Resource>)context.getAttribute(METAINF_RESOURCES);
+            if (dirs == null)
+            {
+                dirs = new HashSet<>();
+                context.setAttribute(METAINF_RESOURCES, dirs);
+            }
+            dirs.add(resourcesDir);
+        }
+
+        for (String uri : fragments)
+        {
+            Resource webFrag = context.getResourceFactory().newResource(URI.create(uri));
+            if (isEmptyFragment(webFrag))
+                continue;
+            Map<Resource, Resource> map = (Map<Resource, Resource>)context.getAttribute(METAINF_FRAGMENTS);
+            if (map == null)
+            {
+                map = new HashMap<>();
+                context.setAttribute(METAINF_FRAGMENTS, map);
+            }
+            map.put(jar, webFrag);
+        }
+
+        if (!tlds.isEmpty())
+        {
+            Collection<URL> metaInfTlds = (Collection<URL>)context.getAttribute(METAINF_TLDS);
+            if (metaInfTlds == null)
+            {
+                metaInfTlds = new HashSet<>();
+                context.setAttribute(METAINF_TLDS, metaInfTlds);
+            }
+            for (String url : tlds)
+            {
+                metaInfTlds.add(URI.create(url).toURL());
+            }
+        }
+        return true;
     }
 
     /**
@@ -0,0 +1,334 @@
+//
+// ========================================================================
+// Copyright (c) 1995 Mort Bay Consulting Pty Ltd and others.
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License v. 2.0 which is available at
+// https://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+// ========================================================================
+//
+
+package org.eclipse.jetty.ee10.webapp;
+
+import java.io.BufferedInputStream;
+import java.io.BufferedOutputStream;
+import java.io.DataInputStream;
+import java.io.DataOutputStream;
+import java.io.IOException;
+import java.nio.charset.StandardCharsets;
+import java.nio.file.Files;
+import java.nio.file.NoSuchFileException;
+import java.nio.file.Path;
+import java.nio.file.StandardCopyOption;
+import java.util.ArrayList;
+import java.util.Collections;
+import java.util.List;
+import java.util.Map;
+import java.util.concurrent.ConcurrentHashMap;
+import java.util.concurrent.atomic.AtomicBoolean;
+
+import org.eclipse.jetty.server.Server;
+import org.eclipse.jetty.util.FileID;
+import org.eclipse.jetty.util.resource.Resource;
+import org.eclipse.jetty.util.thread.AutoLock;
+import org.slf4j.Logger;
+import org.slf4j.LoggerFactory;
+
+/**
+ * <p>A persistent index of the results of scanning jars, so that a restart can skip scanning
+ * jars that have not changed.</p>
+ * <p>Results are stored per jar file and per type of scan as a list of strings, and are only
+ * returned while the jar still has the same last modified time and size as when it was scanned.
+ * The {@link MetaInfConfiguration} stores the {@code META-INF} resources, fragment and TLDs found in each jar,
+ * the annotation parser stores the class and annotation information of each jar.</p>
+ * <p>An index is used when the {@link #SCAN_INDEX} attribute is set on the context or the server, either to
+ * a {@code ScanIndex} instance or to the path of the index file, in which case a single instance is shared by
+ * all the contexts of the server.</p>
+ */
+public class ScanIndex
+{
+    private static final Logger LOG = LoggerFactory.getLogger(ScanIndex.class);
+    private static final int MAGIC = 0x4A534958;
+    private static final int VERSION = 1;
+    private static final AutoLock SERVER_LOCK = new AutoLock();
+
+    public static final String SCAN_INDEX = "org.eclipse.jetty.ee10.webapp.scanIndex";
+
+    private final AutoLock _lock = new AutoLock();
+    private final Map<Path, Entry> _entries = new ConcurrentHashMap<>();
+    private final AtomicBoolean _dirty = new AtomicBoolean();
+    private final Path _file;
+
+    /**
+     * Get the index to use for a context.
+     *
+     * @param context the context being deployed
+     * @return the index from the context or server {@link #SCAN_INDEX} attribute, or null if none is configured
+     */
+    public static ScanIndex getScanIndex(WebAppContext context)
+    {
+        Object index = context.getAttribute(SCAN_INDEX);
+        if (index instanceof ScanIndex scanIndex)
+            return scanIndex;
+        if (index != null)
+        {
+            ScanIndex scanIndex = new ScanIndex(Path.of(index.toString()));
+            context.setAttribute(SCAN_INDEX, scanIndex);
+            return scanIndex;
+        }
+
+        Server server = context.getServer();
+        if (server == null)
+            return null;
+        try (AutoLock ignored = SERVER_LOCK.lock())
+        {
+            index = server.getAttribute(SCAN_INDEX);
+            if (index == null || index instanceof ScanIndex)
+                return (ScanIndex)index;
+            // Replace the path by the index, so that it is shared by all the contexts.
+            ScanIndex scanIndex = new ScanIndex(Path.of(index.toString()));
+            server.setAttribute(SCAN_INDEX, scanIndex);
+            return scanIndex;
+        }
+    }
+
+    /**
+     * @param file the index file, loaded if it exists
+     */
+    public ScanIndex(Path file)
+    {
+        _file = file;
+        load();
+    }
+
+    public Path getPath()
+    {
+        return _file;
+    }
+
+    /**
+     * @return the number of jars indexed
+     */
+    public int size()
+    {
+        return _entries.size();
+    }
+
+    /**
+     * Get the indexed results of a type of scan of a jar.
+     *
+     * @param jar the jar
+     * @param type the type of scan
+     * @return the results, or null if the jar is not indexed for that type or has changed since
+     */
+    public List<String> get(Resource jar, String type)
+    {
+        Path path = toPath(jar);
+        if (path == null)
+            return null;
+        Entry entry = _entries.get(path);
+        if (entry == null)
+            return null;
+        if (!entry.matches(path))
+        {
+            if (LOG.isDebugEnabled())
+                LOG.debug("Changed since indexed {}", path);
+            _entries.remove(path, entry);
+            _dirty.set(true);
+            return null;
+        }
+        return entry.results.get(type);
+    }
+
+    /**
+     * Index the results of a type of scan of a jar.
+     *
+     * @param jar the jar
+     * @param type the type of scan
+     * @param results the results, which may contain nulls
+     */
+    public void put(Resource jar, String type, List<String> results)
+    {
+        Path path = toPath(jar);
+        if (path == null)
+            return;
+        try
+        {
+            long lastModified = Files.getLastModifiedTime(path).toMillis();
+            long size = Files.size(path);
+            Entry entry = _entries.compute(path, (p, e) -> e != null && e.lastModified == lastModified && e.size == size ? e : new Entry(lastModified, size));
+            entry.results.put(type, Collections.unmodifiableList(new ArrayList<>(results)));
+            _dirty.set(true);
+        }
+        catch (IOException x)
+        {
+            if (LOG.isDebugEnabled())
+                LOG.debug("Unable to index {}", path, x);
+        }
+    }
+
+    /**
+     * Save the index to its file, if it has changed since it was loaded or last saved.
+     * The jars that no longer exist are pruned from the index.
+     *
+     * @throws IOException if the index cannot be written
+     */
+    public void save() throws IOException
+    {
+        try (AutoLock ignored = _lock.lock())
+        {
+            // Do not keep the entries of the jars that have been removed or renamed.
+            if (_entries.keySet().removeIf(path -> !Files.isRegularFile(path)))
+                _dirty.set(true);
+            if (!_dirty.getAndSet(false))
+                return;
+
+            Path parent = _file.toAbsolutePath().getParent();
+            if (parent != null)
+                Files.createDirectories(parent);
+            Path tmp = _file.resolveSibling(_file.getFileName() + ".tmp");
+            try (DataOutputStream out = new DataOutputStream(new BufferedOutputStream(Files.newOutputStream(tmp))))
+            {
+                out.writeInt(MAGIC);
+                out.writeInt(VERSION);
+                List<Map.Entry<Path, Entry>> entries = new ArrayList<>(_entries.entrySet());
+                out.writeInt(entries.size());
+                for (Map.Entry<Path, Entry> e : entries)
+                {
+                    writeString(out, e.getKey().toString());
+                    Entry entry = e.getValue();
+                    out.writeLong(entry.lastModified);
+                    out.writeLong(entry.size);
+                    List<Map.Entry<String, List<String>>> results = new ArrayList<>(entry.results.entrySet());
+                    out.writeInt(results.size());
+                    for (Map.Entry<String, List<String>> r : results)
+                    {
+                        writeString(out, r.getKey());
+                        out.writeInt(r.getValue().size());
+                        for (String value : r.getValue())
+                        {
+                            writeString(out, value);
+                        }
+                    }
+                }
+            }
+            catch (IOException x)
+            {
+                _dirty.set(true);
+                throw x;
+            }
+            Files.move(tmp, _file, StandardCopyOption.REPLACE_EXISTING, StandardCopyOption.ATOMIC_MOVE);
+            if (LOG.isDebugEnabled())
+                LOG.debug("Saved {} jars to {}", _entries.size(), _file);
+        }
+    }
+
+    private void load()
+    {
+        try (DataInputStream in = new DataInputStream(new BufferedInputStream(Files.newInputStream(_file))))
+        {
+            if (in.readInt() != MAGIC || in.readInt() != VERSION)
+            {
+                LOG.info("Ignoring incompatible scan index {}", _file);
+                return;
+            }
+            int entries = in.readInt();
+            for (int i = 0; i < entries; i++)
+            {
+                Path path = Path.of(readString(in));
+                Entry entry = new Entry(in.readLong(), in.readLong());
+                int types = in.readInt();
+                for (int t = 0; t < types; t++)
+                {
+                    String type = readString(in);
+                    int count = in.readInt();
+                    List<String> results = new ArrayList<>(count);
+                    for (int r = 0; r < count; r++)
+                    {
+                        results.add(readString(in));
+                    }
+                    entry.results.put(type, Collections.unmodifiableList(results));
+                }
+                _entries.put(path, entry);
+            }
+            if (LOG.isDebugEnabled())
+                LOG.debug("Loaded {} jars from {}", _entries.size(), _file);
+        }
+        catch (NoSuchFileException x)
+        {
+            if (LOG.isDebugEnabled())
+                LOG.debug("No scan index {}", _file);
+        }
+        catch (Throwable x)
+        {
+            LOG.warn("Unable to load scan index {}", _file, x);
+            _entries.clear();
+        }
+    }
+
+    private static Path toPath(Resource jar)
+    {
+        if (jar == null)
+            return null;
+        Path path = jar.getPath();
+        if (path == null || !FileID.isJavaArchive(path) || !Files.isRegularFile(path))
+            return null;
+        return path.toAbsolutePath().normalize();
+    }
+
+    private static void writeString(DataOutputStream out, String value) throws IOException
+    {
+        if (value == null)
+        {
+            out.writeInt(-1);
+            return;
+        }
+        byte[] bytes = value.getBytes(StandardCharsets.UTF_8);
+        out.writeInt(bytes.length);
+        out.write(bytes);
+    }
+
+    private static String readString(DataInputStream in) throws IOException
+    {
+        int length = in.readInt();
+        if (length < 0)
+            return null;
+        byte[] bytes = new byte[length];
+        in.readFully(bytes);
+        return new String(bytes, StandardCharsets.UTF_8);
+    }
+
+    @Override
+    public String toString()
+    {
+        return String.format("%s@%x[%s,jars=%d]", getClass().getSimpleName(), hashCode(), _file, size());
+    }
+
+    private static class Entry
+    {
+        private final Map<String, List<String>> results = new ConcurrentHashMap<>();
+        private final long lastModified;
+        private final long size;
+
+        private Entry(long lastModified, long size)
+        {
+            this.lastModified = lastModified;
+            this.size = size;
+        }
+
+        private boolean matches(Path path)
+        {
+            try
+            {
+                return Files.getLastModifiedTime(path).toMillis() == lastModified && Files.size(path) == size;
+            }
+            catch (IOException x)
+            {
+                return false;
+            }
+        }
+    }
+}
@@ -13,112 +13,153 @@
 
 package org.eclipse.jetty.client.jmh;
 
+import java.util.concurrent.ThreadLocalRandom;
+import java.util.concurrent.TimeUnit;
+import java.util.concurrent.atomic.AtomicInteger;
+
+import org.eclipse.jetty.client.AbstractConnectionPool;
+import org.eclipse.jetty.client.Connection;
+import org.eclipse.jetty.client.HttpClient;
+import org.eclipse.jetty.client.LatencyAwareConnectionPool;
+import org.eclipse.jetty.client.MultiplexConnectionPool;
+import org.eclipse.jetty.client.Origin;
+import org.eclipse.jetty.client.RandomConnectionPool;
+import org.eclipse.jetty.client.Request;
+import org.eclipse.jetty.client.Response;
+import org.eclipse.jetty.client.RoundRobinConnectionPool;
+import org.eclipse.jetty.client.transport.HttpDestination;
+import org.eclipse.jetty.util.Attachable;
+import org.eclipse.jetty.util.Promise;
+import org.eclipse.jetty.util.component.LifeCycle;
+import org.openjdk.jmh.annotations.Benchmark;
+import org.openjdk.jmh.annotations.BenchmarkMode;
+import org.openjdk.jmh.annotations.Mode;
+import org.openjdk.jmh.annotations.OutputTimeUnit;
+import org.openjdk.jmh.annotations.Param;
 import org.openjdk.jmh.annotations.Scope;
+import org.openjdk.jmh.annotations.Setup;
 import org.openjdk.jmh.annotations.State;
-
+import org.openjdk.jmh.annotations.TearDown;
+import org.openjdk.jmh.annotations.Threads;
+import org.openjdk.jmh.infra.Blackhole;
+import org.openjdk.jmh.runner.Runner;
+import org.openjdk.jmh.runner.RunnerException;
+import org.openjdk.jmh.runner.options.Options;
+import org.openjdk.jmh.runner.options.OptionsBuilder;
+
+/**
+ * <p>Compares multiplexed connection pools when one of the connections is slow.</p>
+ * <p>Each benchmark invocation acquires a connection, simulates a request by
+ * consuming CPU while holding the connection, and releases it.
+ * The first connection created by the pool is {@code slowFactor} times slower
+ * than the others; the sampled time distribution shows how well each pool
+ * avoids the slow connection in its tail latency.</p>
+ */
 @State(Scope.Benchmark)
+@Threads(12)
 public class ConnectionPoolsBenchmark
 {
-    /** TODO
-    private ConnectionPool pool;
+    private static final int MAX_CONNECTIONS = 4;
+    private static final int MAX_MULTIPLEX = 8;
 
-    @Param({"round-robin", "cached/multiplex", "uncached/multiplex", "cached/duplex", "uncached/duplex"})
-    public static String POOL_TYPE;
+    public static void main(String[] args) throws RunnerException
+    {
+        Options opt = new OptionsBuilder()
+            .include(ConnectionPoolsBenchmark.class.getSimpleName())
+            .warmupIterations(3)
+            .measurementIterations(3)
+            .forks(1)
+            //.addProfiler(LinuxPerfProfiler.class)
+            .build();
+
+        new Runner(opt).run();
+    }
+
+    @Param({"multiplex", "random", "round-robin", "latency-aware"})
+    public String poolType;
+    @Param({"1", "20"})
+    public int slowFactor;
+
+    private final AtomicInteger connections = new AtomicInteger();
+    private HttpClient httpClient;
+    private AbstractConnectionPool pool;
 
     @Setup
     public void setUp() throws Exception
     {
-        HttpClient httpClient = new HttpClient()
+        httpClient = new HttpClient();
+        httpClient.start();
+        HttpDestination destination = new HttpDestination(httpClient, new Origin("http", "localhost", 8080))
         {
             @Override
-            protected void newConnection(HttpDestination destination, Promise<Connection> promise)
+            public void newConnection(Promise<Connection> promise)
             {
-                promise.succeeded(new MockConnection());
+                // Only the first connection is slow, replacements are not.
+                boolean slow = connections.getAndIncrement() == 0;
+                promise.succeeded(new MockConnection(slow ? slowFactor : 1));
             }
         };
-        HttpDestination httpDestination = new HttpDestination(httpClient, new Origin("http", "localhost", 8080), false)
-        {
-        };
 
-        HttpConversation httpConversation = new HttpConversation();
-        HttpRequest httpRequest = new HttpRequest(httpClient, httpConversation, new URI("http://localhost:8080")) {};
-        HttpExchange httpExchange = new HttpExchange(httpDestination, httpRequest, new ArrayList<>());
-        httpDestination.getHttpExchanges().add(httpExchange);
-
-        int initialConnections = 12;
-        int maxConnections = 100;
-        switch (POOL_TYPE)
+        pool = switch (poolType)
         {
-            case "uncached/duplex":
-                pool = new DuplexConnectionPool(httpDestination, maxConnections, false, Callback.NOOP);
-                pool.preCreateConnections(initialConnections).get();
-                break;
-            case "cached/duplex":
-                pool = new DuplexConnectionPool(httpDestination, maxConnections, true, Callback.NOOP);
-                pool.preCreateConnections(initialConnections).get();
-                break;
-            case "uncached/multiplex":
-                pool = new MultiplexConnectionPool(httpDestination, maxConnections, false, Callback.NOOP, 12);
-                pool.preCreateConnections(initialConnections).get();
-                break;
-            case "cached/multiplex":
-                pool = new MultiplexConnectionPool(httpDestination, maxConnections, true, Callback.NOOP, 12);
-                pool.preCreateConnections(initialConnections).get();
-                break;
-            case "round-robin":
-                pool = new RoundRobinConnectionPool(httpDestination, maxConnections, Callback.NOOP);
-                pool.preCreateConnections(maxConnections).get();
-                break;
-            default:
-                throw new AssertionError("Unknown pool type: " + POOL_TYPE);
-        }
+            case "multiplex" -> new MultiplexConnectionPool(destination, MAX_CONNECTIONS, MAX_MULTIPLEX);
+            case "random" -> new RandomConnectionPool(destination, MAX_CONNECTIONS, MAX_MULTIPLEX);
+            case "round-robin" -> new RoundRobinConnectionPool(destination, MAX_CONNECTIONS, MAX_MULTIPLEX);
+            case "latency-aware" -> new LatencyAwareConnectionPool(destination, MAX_CONNECTIONS, MAX_MULTIPLEX);
+            default -> throw new AssertionError("Unknown pool type: " + poolType);
+        };
+        LifeCycle.start(pool);
+        pool.preCreateConnections(MAX_CONNECTIONS).get();
     }
 
     @TearDown
-    public void tearDown()
+    public void tearDown() throws Exception
     {
-        pool.close();
+        LifeCycle.stop(pool);
         pool = null;
+        httpClient.stop();
+        httpClient = null;
     }
 
     @Benchmark
-    public void testPool()
+    @BenchmarkMode(Mode.SampleTime)
+    @OutputTimeUnit(TimeUnit.MICROSECONDS)
+    public void testRequestLatency()
     {
         Connection connection = pool.acquire(true);
-        if (connection == null && !POOL_TYPE.equals("round-robin"))
-            throw new AssertionError("from thread " + Thread.currentThread().getName());
-        Blackhole.consumeCPU(ThreadLocalRandom.current().nextInt(10, 20));
-        if (connection != null)
-            pool.release(connection);
-    }
-
-    public static void main(String[] args) throws RunnerException
-    {
-        Options opt = new OptionsBuilder()
-            .include(ConnectionPoolsBenchmark.class.getSimpleName())
-            .warmupIterations(3)
-            .measurementIterations(3)
-            .forks(1)
-            .threads(12)
-            //.addProfiler(LinuxPerfProfiler.class)
-            .build();
-
-        new Runner(opt).run();
+        if (connection == null)
+        {
+            // All connections are busy, simulate a queued request.
+            Blackhole.consumeCPU(ThreadLocalRandom.current().nextInt(10, 20));
+            return;
+        }
+        MockConnection mock = (MockConnection)connection;
+        Blackhole.consumeCPU(mock.factor * ThreadLocalRandom.current().nextInt(100, 200));
+        if (!pool.release(connection))
+            connection.close();
     }
 
-    static class MockConnection implements Connection, Attachable
+    private static class MockConnection implements Connection, Attachable
     {
+        private final int factor;
+        private volatile boolean closed;
         private Object attachment;
 
+        private MockConnection(int factor)
+        {
+            this.factor = factor;
+        }
+
         @Override
         public void close()
         {
+            closed = true;
         }
 
         @Override
         public boolean isClosed()
         {
-            return false;
+            return closed;
         }
 
         @Override
@@ -138,5 +179,4 @@ public class ConnectionPoolsBenchmark
             return attachment;
         }
     }
-        **/
 }
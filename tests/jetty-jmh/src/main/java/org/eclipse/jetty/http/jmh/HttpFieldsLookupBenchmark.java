@@ -0,0 +1,91 @@
+//
+// ========================================================================
+// Copyright (c) 1995 Mort Bay Consulting Pty Ltd and others.
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License v. 2.0 which is available at
+// https://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+// ========================================================================
+//
+
+package org.eclipse.jetty.http.jmh;
+
+import java.util.concurrent.TimeUnit;
+
+import org.eclipse.jetty.http.HttpFields;
+import org.eclipse.jetty.http.HttpHeader;
+import org.openjdk.jmh.annotations.Benchmark;
+import org.openjdk.jmh.annotations.BenchmarkMode;
+import org.openjdk.jmh.annotations.Measurement;
+import org.openjdk.jmh.annotations.Mode;
+import org.openjdk.jmh.annotations.Param;
+import org.openjdk.jmh.annotations.Scope;
+import org.openjdk.jmh.annotations.Setup;
+import org.openjdk.jmh.annotations.State;
+import org.openjdk.jmh.annotations.Threads;
+import org.openjdk.jmh.annotations.Warmup;
+import org.openjdk.jmh.infra.Blackhole;
+import org.openjdk.jmh.profile.GCProfiler;
+import org.openjdk.jmh.runner.Runner;
+import org.openjdk.jmh.runner.RunnerException;
+import org.openjdk.jmh.runner.options.Options;
+import org.openjdk.jmh.runner.options.OptionsBuilder;
+
+@State(Scope.Benchmark)
+@Threads(4)
+@Warmup(iterations = 5, time = 2000, timeUnit = TimeUnit.MILLISECONDS)
+@Measurement(iterations = 5, time = 2000, timeUnit = TimeUnit.MILLISECONDS)
+public class HttpFieldsLookupBenchmark
+{
+    @Param({"10", "40"})
+    int fields;
+
+    private HttpFields.Mutable _mutable;
+
+    @Setup
+    public void setUp()
+    {
+        _mutable = HttpFields.build();
+        for (int i = 0; i < fields - 4; i++)
+        {
+            _mutable.add("X-Header-" + i, "value" + i);
+        }
+        _mutable.add(HttpHeader.HOST, "localhost");
+        _mutable.add(HttpHeader.ACCEPT, "*/*");
+        _mutable.add(HttpHeader.USER_AGENT, "jmh");
+        _mutable.add(HttpHeader.ACCEPT_ENCODING, "gzip");
+    }
+
+    @Benchmark
+    @BenchmarkMode({Mode.Throughput})
+    public void testRequestLookups(Blackhole blackhole)
+    {
+        // A fresh immutable instance per request, as handed from the parser to the request metadata.
+        HttpFields headers = _mutable.asImmutable();
+        blackhole.consume(headers.getField(HttpHeader.HOST));
+        blackhole.consume(headers.getField(HttpHeader.FORWARDED));
+        blackhole.consume(headers.getField(HttpHeader.X_FORWARDED_FOR));
+        blackhole.consume(headers.getField(HttpHeader.ORIGIN));
+        blackhole.consume(headers.get(HttpHeader.ACCEPT_ENCODING));
+        blackhole.consume(headers.get(HttpHeader.AUTHORIZATION));
+        blackhole.consume(headers.contains(HttpHeader.CONTENT_TYPE));
+        blackhole.consume(headers.get("X-Header-0"));
+    }
+
+    public static void main(String[] args) throws RunnerException
+    {
+        Options opt = new OptionsBuilder()
+            .include(HttpFieldsLookupBenchmark.class.getSimpleName())
+            .warmupIterations(10)
+            .measurementIterations(10)
+            .addProfiler(GCProfiler.class)
+            .forks(1)
+            .threads(1)
+            .build();
+
+        new Runner(opt).run();
+    }
+}
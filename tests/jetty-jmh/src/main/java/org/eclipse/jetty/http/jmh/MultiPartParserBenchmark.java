@@ -0,0 +1,159 @@
+//
+// ========================================================================
+// Copyright (c) 1995 Mort Bay Consulting Pty Ltd and others.
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License v. 2.0 which is available at
+// https://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+// ========================================================================
+//
+
+package org.eclipse.jetty.http.jmh;
+
+import java.io.ByteArrayOutputStream;
+import java.nio.ByteBuffer;
+import java.nio.charset.StandardCharsets;
+import java.util.Random;
+import java.util.concurrent.TimeUnit;
+
+import org.eclipse.jetty.http.MultiPart;
+import org.eclipse.jetty.io.Content;
+import org.eclipse.jetty.util.SearchPattern;
+import org.openjdk.jmh.annotations.Benchmark;
+import org.openjdk.jmh.annotations.BenchmarkMode;
+import org.openjdk.jmh.annotations.Level;
+import org.openjdk.jmh.annotations.Measurement;
+import org.openjdk.jmh.annotations.Mode;
+import org.openjdk.jmh.annotations.OutputTimeUnit;
+import org.openjdk.jmh.annotations.Param;
+import org.openjdk.jmh.annotations.Scope;
+import org.openjdk.jmh.annotations.Setup;
+import org.openjdk.jmh.annotations.State;
+import org.openjdk.jmh.annotations.Threads;
+import org.openjdk.jmh.annotations.Warmup;
+import org.openjdk.jmh.infra.Blackhole;
+import org.openjdk.jmh.runner.Runner;
+import org.openjdk.jmh.runner.RunnerException;
+import org.openjdk.jmh.runner.options.Options;
+import org.openjdk.jmh.runner.options.OptionsBuilder;
+
+/**
+ * <p>Measures the throughput of parsing a multipart upload of a single 4 MiB
+ * file, read 16 KiB at a time; each operation is one upload.</p>
+ */
+@State(Scope.Benchmark)
+@Threads(1)
+@Warmup(iterations = 5, time = 2000, timeUnit = TimeUnit.MILLISECONDS)
+@Measurement(iterations = 5, time = 2000, timeUnit = TimeUnit.MILLISECONDS)
+public class MultiPartParserBenchmark
+{
+    private static final String BOUNDARY = "----WebKitFormBoundaryhXfFAMfUnUKhmqT8";
+    private static final int FILE_SIZE = 4 * 1024 * 1024;
+    private static final int CHUNK_SIZE = 16 * 1024;
+
+    @Param({"binary", "text"})
+    public String content;
+
+    @Param({"heap", "direct"})
+    public String buffers;
+
+    private ByteBuffer[] chunks;
+    private ByteBuffer upload;
+    private SearchPattern boundaryFinder;
+
+    @Setup(Level.Trial)
+    public void setUp()
+    {
+        Random random = new Random(42);
+        byte[] file = new byte[FILE_SIZE];
+        if ("binary".equals(content))
+        {
+            random.nextBytes(file);
+        }
+        else
+        {
+            // Lines of printable ASCII, with characters that also appear in the boundary.
+            String alphabet = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789-- ";
+            for (int i = 0; i < file.length; i++)
+            {
+                file[i] = (i % 80 == 79) ? (byte)'\n' : (byte)alphabet.charAt(random.nextInt(alphabet.length()));
+            }
+        }
+
+        ByteArrayOutputStream out = new ByteArrayOutputStream();
+        out.writeBytes(("--" + BOUNDARY + "\r\n" +
+            "Content-Disposition: form-data; name=\"file\"; filename=\"upload.bin\"\r\n" +
+            "Content-Type: application/octet-stream\r\n" +
+            "\r\n").getBytes(StandardCharsets.US_ASCII));
+        out.writeBytes(file);
+        out.writeBytes(("\r\n--" + BOUNDARY + "--\r\n").getBytes(StandardCharsets.US_ASCII));
+        byte[] bytes = out.toByteArray();
+
+        upload = toBuffer(bytes, 0, bytes.length);
+        chunks = new ByteBuffer[(bytes.length + CHUNK_SIZE - 1) / CHUNK_SIZE];
+        for (int i = 0; i < chunks.length; i++)
+        {
+            int offset = i * CHUNK_SIZE;
+            chunks[i] = toBuffer(bytes, offset, Math.min(CHUNK_SIZE, bytes.length - offset));
+        }
+        boundaryFinder = SearchPattern.compile("\n--" + BOUNDARY);
+    }
+
+    private ByteBuffer toBuffer(byte[] bytes, int offset, int length)
+    {
+        if ("heap".equals(buffers))
+            return ByteBuffer.wrap(bytes, offset, length).slice();
+        ByteBuffer buffer = ByteBuffer.allocateDirect(length);
+        buffer.put(bytes, offset, length).flip();
+        return buffer;
+    }
+
+    @Benchmark
+    @BenchmarkMode({Mode.Throughput})
+    @OutputTimeUnit(TimeUnit.SECONDS)
+    public long testParse()
+    {
+        long[] size = new long[1];
+        MultiPart.Parser parser = new MultiPart.Parser(BOUNDARY, new MultiPart.Parser.Listener()
+        {
+            @Override
+            public void onPartContent(Content.Chunk chunk)
+            {
+                size[0] += chunk.remaining();
+            }
+        });
+        for (int i = 0; i < chunks.length; i++)
+        {
+            parser.parse(Content.Chunk.from(chunks[i].slice(), i == chunks.length - 1));
+        }
+        return size[0];
+    }
+
+    @Benchmark
+    @BenchmarkMode({Mode.Throughput})
+    @OutputTimeUnit(TimeUnit.SECONDS)
+    public void testBoundarySearch(Blackhole blackhole)
+    {
+        // Search the whole upload as the parser does, from one boundary to the next.
+        ByteBuffer buffer = upload.slice();
+        int match;
+        while ((match = boundaryFinder.match(buffer)) >= 0)
+        {
+            blackhole.consume(match);
+            buffer.position(buffer.position() + match + boundaryFinder.getLength());
+        }
+    }
+
+    public static void main(String[] args) throws RunnerException
+    {
+        Options opt = new OptionsBuilder()
+            .include(MultiPartParserBenchmark.class.getSimpleName())
+            .forks(1)
+            .build();
+
+        new Runner(opt).run();
+    }
+}
@@ -0,0 +1,177 @@
+//
+// ========================================================================
+// Copyright (c) 1995 Mort Bay Consulting Pty Ltd and others.
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License v. 2.0 which is available at
+// https://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+// ========================================================================
+//
+
+package org.eclipse.jetty.http3.qpack.jmh;
+
+import java.nio.ByteBuffer;
+import java.util.ArrayList;
+import java.util.List;
+import java.util.concurrent.TimeUnit;
+
+import org.eclipse.jetty.http.HostPortHttpField;
+import org.eclipse.jetty.http.HttpFields;
+import org.eclipse.jetty.http.HttpHeader;
+import org.eclipse.jetty.http.HttpVersion;
+import org.eclipse.jetty.http.MetaData;
+import org.eclipse.jetty.http.compression.FieldIndexingPolicy;
+import org.eclipse.jetty.http3.qpack.Instruction;
+import org.eclipse.jetty.http3.qpack.QpackDecoder;
+import org.eclipse.jetty.http3.qpack.QpackEncoder;
+import org.eclipse.jetty.http3.qpack.QpackException;
+import org.eclipse.jetty.io.ByteBufferPool;
+import org.eclipse.jetty.util.BufferUtil;
+import org.eclipse.jetty.util.NanoTime;
+import org.openjdk.jmh.annotations.AuxCounters;
+import org.openjdk.jmh.annotations.Benchmark;
+import org.openjdk.jmh.annotations.BenchmarkMode;
+import org.openjdk.jmh.annotations.Level;
+import org.openjdk.jmh.annotations.Measurement;
+import org.openjdk.jmh.annotations.Mode;
+import org.openjdk.jmh.annotations.Param;
+import org.openjdk.jmh.annotations.Scope;
+import org.openjdk.jmh.annotations.Setup;
+import org.openjdk.jmh.annotations.State;
+import org.openjdk.jmh.annotations.Threads;
+import org.openjdk.jmh.annotations.Warmup;
+import org.openjdk.jmh.infra.Blackhole;
+import org.openjdk.jmh.runner.Runner;
+import org.openjdk.jmh.runner.RunnerException;
+import org.openjdk.jmh.runner.options.Options;
+import org.openjdk.jmh.runner.options.OptionsBuilder;
+
+/**
+ * <p>Measures the throughput of a QPACK encoder and decoder pair exchanging
+ * the encoder and decoder stream instructions, as they would on a single
+ * long-lived HTTP/3 connection.</p>
+ * <p>The auxiliary counters report the bytes of the encoded field sections and
+ * of the encoder stream instructions, to compare the compression obtained by
+ * the indexing policies.</p>
+ */
+@State(Scope.Thread)
+@Threads(1)
+@Warmup(iterations = 5, time = 2000, timeUnit = TimeUnit.MILLISECONDS)
+@Measurement(iterations = 5, time = 2000, timeUnit = TimeUnit.MILLISECONDS)
+public class QpackEncoderBenchmark
+{
+    @Param({"0", "2"})
+    int minOccurrences;
+
+    private final ByteBufferPool bufferPool = new ByteBufferPool.NonPooling();
+    private final ByteBuffer buffer = BufferUtil.allocate(16 * 1024);
+    private QpackEncoder encoder;
+    private QpackDecoder decoder;
+    private final List<Instruction> encoderInstructions = new ArrayList<>();
+    private final List<Instruction> decoderInstructions = new ArrayList<>();
+    private long streamId;
+
+    @Setup(Level.Iteration)
+    public void setUp() throws Exception
+    {
+        encoderInstructions.clear();
+        decoderInstructions.clear();
+        encoder = new QpackEncoder(encoderInstructions::addAll);
+        decoder = new QpackDecoder(decoderInstructions::addAll);
+        decoder.setBeginNanoTimeSupplier(NanoTime::now);
+        if (minOccurrences > 0)
+            encoder.setIndexingPolicy(new FieldIndexingPolicy.Adaptive(minOccurrences));
+
+        // Mimic the exchange of the SETTINGS frames.
+        int capacity = 4096;
+        encoder.setMaxBlockedStreams(16);
+        decoder.setMaxBlockedStreams(16);
+        decoder.setMaxTableCapacity(capacity);
+        encoder.setMaxTableCapacity(capacity);
+        encoder.setTableCapacity(capacity);
+        flushEncoderInstructions(null);
+        streamId = 0;
+    }
+
+    @AuxCounters(AuxCounters.Type.EVENTS)
+    @State(Scope.Thread)
+    public static class Bytes
+    {
+        public long fieldSection;
+        public long encoderStream;
+    }
+
+    @Benchmark
+    @BenchmarkMode({Mode.Throughput})
+    public void testEncodeDecode(Bytes bytes, Blackhole blackhole) throws Exception
+    {
+        MetaData.Request request = newRequest(streamId);
+
+        BufferUtil.clearToFill(buffer);
+        encoder.encode(buffer, streamId, request);
+        BufferUtil.flipToFlush(buffer, 0);
+        bytes.fieldSection += buffer.remaining();
+        flushEncoderInstructions(bytes);
+
+        decoder.decode(streamId, buffer, (id, metaData, wasBlocked) -> blackhole.consume(metaData));
+        if (!decoderInstructions.isEmpty())
+        {
+            encoder.parseInstructions(toBuffer(decoderInstructions));
+            decoderInstructions.clear();
+        }
+        streamId += 4;
+    }
+
+    private void flushEncoderInstructions(Bytes bytes) throws QpackException
+    {
+        if (encoderInstructions.isEmpty())
+            return;
+        ByteBuffer instructions = toBuffer(encoderInstructions);
+        encoderInstructions.clear();
+        if (bytes != null)
+            bytes.encoderStream += instructions.remaining();
+        decoder.parseInstructions(instructions);
+    }
+
+    private ByteBuffer toBuffer(List<Instruction> instructions)
+    {
+        ByteBufferPool.Accumulator accumulator = new ByteBufferPool.Accumulator();
+        instructions.forEach(instruction -> instruction.encode(bufferPool, accumulator));
+        ByteBuffer result = BufferUtil.allocate(Math.toIntExact(accumulator.getTotalLength()));
+        BufferUtil.clearToFill(result);
+        accumulator.getByteBuffers().forEach(result::put);
+        BufferUtil.flipToFlush(result, 0);
+        accumulator.release();
+        return result;
+    }
+
+    private static MetaData.Request newRequest(long streamId)
+    {
+        // The fields of a request forwarded to an upstream server: most are repeated
+        // by every request, while a few have values that change at every request.
+        HttpFields fields = HttpFields.build()
+            .put(HttpHeader.ACCEPT, "application/json")
+            .put(HttpHeader.ACCEPT_ENCODING, "gzip, deflate, br")
+            .put(HttpHeader.USER_AGENT, "Jetty HttpClient")
+            .put(HttpHeader.X_FORWARDED_PROTO, "https")
+            .put(HttpHeader.X_FORWARDED_HOST, "www.example.com")
+            .put(HttpHeader.X_FORWARDED_FOR, "10.0.0." + (streamId % 64))
+            .put("X-Request-Id", Long.toHexString(streamId * 0x9E3779B97F4A7C15L))
+            .put("X-Tenant", "tenant-" + (streamId % 8))
+            .asImmutable();
+        return new MetaData.Request("GET", "https", new HostPortHttpField("backend:8443"), "/api/items/" + streamId, HttpVersion.HTTP_3, fields, -1);
+    }
+
+    public static void main(String[] args) throws RunnerException
+    {
+        Options opt = new OptionsBuilder()
+            .include(QpackEncoderBenchmark.class.getSimpleName())
+            .forks(1)
+            .build();
+
+        new Runner(opt).run();
+    }
+}
@@ -0,0 +1,105 @@
+//
+// ========================================================================
+// Copyright (c) 1995 Mort Bay Consulting Pty Ltd and others.
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License v. 2.0 which is available at
+// https://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+// ========================================================================
+//
+
+package org.eclipse.jetty.io.jmh;
+
+import java.util.concurrent.ThreadLocalRandom;
+
+import org.eclipse.jetty.io.ArrayByteBufferPool;
+import org.eclipse.jetty.io.RetainableByteBuffer;
+import org.openjdk.jmh.annotations.Benchmark;
+import org.openjdk.jmh.annotations.BenchmarkMode;
+import org.openjdk.jmh.annotations.Mode;
+import org.openjdk.jmh.annotations.Param;
+import org.openjdk.jmh.annotations.Scope;
+import org.openjdk.jmh.annotations.Setup;
+import org.openjdk.jmh.annotations.State;
+import org.openjdk.jmh.annotations.TearDown;
+import org.openjdk.jmh.annotations.Threads;
+import org.openjdk.jmh.infra.Blackhole;
+import org.openjdk.jmh.runner.Runner;
+import org.openjdk.jmh.runner.RunnerException;
+import org.openjdk.jmh.runner.options.Options;
+import org.openjdk.jmh.runner.options.OptionsBuilder;
+import org.openjdk.jmh.runner.options.TimeValue;
+
+/**
+ * <p>Compares the shared and the sharded {@link ArrayByteBufferPool} when many
+ * threads concurrently acquire and release buffers of the same few capacities,
+ * as it happens with many HTTP/2 streams served by many selectors.</p>
+ */
+@State(Scope.Benchmark)
+@Threads(64)
+public class ArrayByteBufferPoolContentionBenchmark
+{
+    public static void main(String[] args) throws RunnerException
+    {
+        Options opt = new OptionsBuilder()
+            .include(ArrayByteBufferPoolContentionBenchmark.class.getSimpleName())
+            .warmupIterations(5)
+            .warmupTime(TimeValue.milliseconds(500))
+            .measurementIterations(10)
+            .measurementTime(TimeValue.milliseconds(500))
+            .forks(1)
+            .build();
+        new Runner(opt).run();
+    }
+
+    @Param({"false", "true"})
+    boolean sharded;
+    @Param({"0", "1048576"})
+    long maxMemory;
+    @Param({"true"})
+    boolean statisticsEnabled;
+
+    ArrayByteBufferPool pool;
+
+    @Setup
+    public void prepare()
+    {
+        if (sharded)
+            pool = new ArrayByteBufferPool.Sharded(0, 4096, 65536, Integer.MAX_VALUE, maxMemory, maxMemory, -1, -1);
+        else
+            pool = new ArrayByteBufferPool(0, 4096, 65536, Integer.MAX_VALUE, maxMemory, maxMemory);
+        pool.setStatisticsEnabled(statisticsEnabled);
+    }
+
+    @TearDown
+    public void dispose()
+    {
+        System.out.println(pool.dump());
+    }
+
+    @Benchmark
+    @BenchmarkMode({Mode.Throughput})
+    public void acquireReleaseSameCapacity()
+    {
+        RetainableByteBuffer buffer = pool.acquire(16384, true);
+        buffer.release();
+    }
+
+    @Benchmark
+    @BenchmarkMode({Mode.Throughput})
+    public void acquireManyReleaseMany(Blackhole blackhole)
+    {
+        // Simulate a frame read and a few frames written,
+        // all with small and similar capacities.
+        RetainableByteBuffer input = pool.acquire(16384, true);
+        RetainableByteBuffer output1 = pool.acquire(4096, true);
+        RetainableByteBuffer output2 = pool.acquire(ThreadLocalRandom.current().nextInt(1, 8192), true);
+        blackhole.consume(output2.capacity());
+        output2.release();
+        output1.release();
+        input.release();
+    }
+}
@@ -16,9 +16,15 @@ package org.eclipse.jetty.requestlog.jmh;
 import java.lang.invoke.MethodHandle;
 import java.lang.invoke.MethodHandles;
 import java.lang.invoke.MethodType;
+import java.nio.ByteBuffer;
+import java.nio.charset.StandardCharsets;
 import java.util.concurrent.ThreadLocalRandom;
 import java.util.concurrent.TimeUnit;
 
+import org.eclipse.jetty.io.ArrayByteBufferPool;
+import org.eclipse.jetty.io.ByteBufferPool;
+import org.eclipse.jetty.io.RetainableByteBuffer;
+import org.eclipse.jetty.util.BufferUtil;
 import org.eclipse.jetty.util.TypeUtil;
 import org.openjdk.jmh.annotations.Benchmark;
 import org.openjdk.jmh.annotations.BenchmarkMode;
@@ -73,6 +79,7 @@ public class RequestLogBenchmark
     }
 
     private ThreadLocal<StringBuilder> buffers = ThreadLocal.withInitial(() -> new StringBuilder(256));
+    private final ByteBufferPool bufferPool = new ArrayByteBufferPool();
     MethodHandle logHandle;
     Object[] iteratedLog;
 
@@ -184,6 +191,52 @@ public class RequestLogBenchmark
 
     ;
 
+    /**
+     * The {@code String} path used by {@code RequestLogWriter}: the entry is
+     * copied to a {@code String}, then encoded to a {@code byte[]}.
+     */
+    public int logMethodHandleToBytes(String request)
+    {
+        try
+        {
+            StringBuilder b = buffers.get();
+            logHandle.invoke(b, request);
+            byte[] bytes = b.toString().getBytes(StandardCharsets.UTF_8);
+            b.setLength(0);
+            return bytes.length;
+        }
+        catch (Throwable th)
+        {
+            throw new RuntimeException(th);
+        }
+    }
+
+    /**
+     * The {@code RequestLog.BufferWriter} path used by {@code CustomRequestLog}:
+     * the entry is encoded directly into a pooled buffer.
+     */
+    public int logMethodHandleToBuffer(String request)
+    {
+        try
+        {
+            StringBuilder b = buffers.get();
+            logHandle.invoke(b, request);
+            RetainableByteBuffer buffer = bufferPool.acquire(BufferUtil.utf8Length(b), true);
+            ByteBuffer byteBuffer = buffer.getByteBuffer();
+            int pos = BufferUtil.flipToFill(byteBuffer);
+            BufferUtil.putUtf8(byteBuffer, b);
+            BufferUtil.flipToFlush(byteBuffer, pos);
+            b.setLength(0);
+            int length = byteBuffer.remaining();
+            buffer.release();
+            return length;
+        }
+        catch (Throwable th)
+        {
+            throw new RuntimeException(th);
+        }
+    }
+
     @Benchmark
     @BenchmarkMode({Mode.Throughput})
     public String testHandle()
@@ -191,6 +244,20 @@ public class RequestLogBenchmark
         return logMethodHandle(Long.toString(ThreadLocalRandom.current().nextLong()));
     }
 
+    @Benchmark
+    @BenchmarkMode({Mode.Throughput})
+    public int testHandleToBytes()
+    {
+        return logMethodHandleToBytes(Long.toString(ThreadLocalRandom.current().nextLong()));
+    }
+
+    @Benchmark
+    @BenchmarkMode({Mode.Throughput})
+    public int testHandleToBuffer()
+    {
+        return logMethodHandleToBuffer(Long.toString(ThreadLocalRandom.current().nextLong()));
+    }
+
     public static void main(String[] args) throws RunnerException
     {
         Options opt = new OptionsBuilder()
@@ -0,0 +1,159 @@
+//
+// ========================================================================
+// Copyright (c) 1995 Mort Bay Consulting Pty Ltd and others.
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License v. 2.0 which is available at
+// https://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+// ========================================================================
+//
+
+package org.eclipse.jetty.server.jmh;
+
+import java.io.OutputStream;
+import java.net.InetSocketAddress;
+import java.nio.charset.StandardCharsets;
+import java.util.concurrent.TimeUnit;
+import javax.net.ssl.SSLSocket;
+
+import org.eclipse.jetty.http.HttpStatus;
+import org.eclipse.jetty.http.HttpTester;
+import org.eclipse.jetty.io.Content;
+import org.eclipse.jetty.server.Handler;
+import org.eclipse.jetty.server.HttpConnectionFactory;
+import org.eclipse.jetty.server.Request;
+import org.eclipse.jetty.server.Response;
+import org.eclipse.jetty.server.Server;
+import org.eclipse.jetty.server.ServerConnector;
+import org.eclipse.jetty.server.SslConnectionFactory;
+import org.eclipse.jetty.util.Callback;
+import org.eclipse.jetty.util.resource.ResourceFactory;
+import org.eclipse.jetty.util.ssl.SslContextFactory;
+import org.openjdk.jmh.annotations.Benchmark;
+import org.openjdk.jmh.annotations.BenchmarkMode;
+import org.openjdk.jmh.annotations.Mode;
+import org.openjdk.jmh.annotations.OutputTimeUnit;
+import org.openjdk.jmh.annotations.Param;
+import org.openjdk.jmh.annotations.Scope;
+import org.openjdk.jmh.annotations.Setup;
+import org.openjdk.jmh.annotations.State;
+import org.openjdk.jmh.annotations.TearDown;
+import org.openjdk.jmh.annotations.Threads;
+import org.openjdk.jmh.runner.Runner;
+import org.openjdk.jmh.runner.RunnerException;
+import org.openjdk.jmh.runner.options.Options;
+import org.openjdk.jmh.runner.options.OptionsBuilder;
+
+/**
+ * <p>Measures the throughput of uploads over TLS for different values of
+ * {@link SslConnectionFactory#setMaxRecordsPerFill(int)}.</p>
+ * <p>The CPU cost per upload can be measured with a JMH profiler,
+ * for example {@code -prof perfnorm} on Linux.</p>
+ */
+@State(Scope.Benchmark)
+@Threads(4)
+public class SslConnectionBenchmark
+{
+    private static final int CONTENT_LENGTH = 1024 * 1024;
+
+    public static void main(String[] args) throws RunnerException
+    {
+        Options opt = new OptionsBuilder()
+            .include(SslConnectionBenchmark.class.getSimpleName())
+            .warmupIterations(3)
+            .measurementIterations(5)
+            .forks(1)
+            .build();
+        new Runner(opt).run();
+    }
+
+    @Param({"1", "4", "8"})
+    public int maxRecordsPerFill;
+
+    private Server server;
+    private ServerConnector connector;
+    private SslContextFactory.Client clientSslContextFactory;
+
+    @Setup
+    public void prepare() throws Exception
+    {
+        server = new Server();
+        SslContextFactory.Server serverSslContextFactory = new SslContextFactory.Server();
+        serverSslContextFactory.setKeyStoreResource(ResourceFactory.of(server).newClassLoaderResource("keystore.p12"));
+        serverSslContextFactory.setKeyStorePassword("storepwd");
+        SslConnectionFactory ssl = new SslConnectionFactory(serverSslContextFactory, "http/1.1");
+        ssl.setMaxRecordsPerFill(maxRecordsPerFill);
+        connector = new ServerConnector(server, 1, 1, ssl, new HttpConnectionFactory());
+        server.addConnector(connector);
+        server.setHandler(new Handler.Abstract()
+        {
+            @Override
+            public boolean handle(Request request, Response response, Callback callback)
+            {
+                Content.Source.consumeAll(request, callback);
+                return true;
+            }
+        });
+        server.start();
+
+        clientSslContextFactory = new SslContextFactory.Client(true);
+        clientSslContextFactory.start();
+    }
+
+    @TearDown
+    public void dispose() throws Exception
+    {
+        clientSslContextFactory.stop();
+        server.stop();
+    }
+
+    @State(Scope.Thread)
+    public static class Client
+    {
+        private final byte[] content = new byte[CONTENT_LENGTH];
+        private SSLSocket socket;
+        private HttpTester.Input input;
+
+        @Setup
+        public void connect(SslConnectionBenchmark benchmark) throws Exception
+        {
+            socket = benchmark.clientSslContextFactory.newSslSocket();
+            socket.connect(new InetSocketAddress("localhost", benchmark.connector.getLocalPort()));
+            input = HttpTester.from(socket.getInputStream());
+        }
+
+        @TearDown
+        public void disconnect() throws Exception
+        {
+            socket.close();
+        }
+
+        private void upload() throws Exception
+        {
+            OutputStream output = socket.getOutputStream();
+            String request = """
+                POST / HTTP/1.1\r
+                Host: localhost\r
+                Content-Length: %d\r
+                \r
+                """.formatted(content.length);
+            output.write(request.getBytes(StandardCharsets.US_ASCII));
+            output.write(content);
+            output.flush();
+            HttpTester.Response response = HttpTester.parseResponse(input);
+            if (response == null || response.getStatus() != HttpStatus.OK_200)
+                throw new IllegalStateException("Unexpected response " + response);
+        }
+    }
+
+    @Benchmark
+    @BenchmarkMode(Mode.Throughput)
+    @OutputTimeUnit(TimeUnit.SECONDS)
+    public void testUpload(Client client) throws Exception
+    {
+        client.upload();
+    }
+}
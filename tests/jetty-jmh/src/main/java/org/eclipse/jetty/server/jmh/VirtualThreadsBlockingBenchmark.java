@@ -0,0 +1,162 @@
+//
+// ========================================================================
+// Copyright (c) 1995 Mort Bay Consulting Pty Ltd and others.
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License v. 2.0 which is available at
+// https://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+// ========================================================================
+//
+
+package org.eclipse.jetty.server.jmh;
+
+import java.io.OutputStream;
+import java.net.InetSocketAddress;
+import java.nio.channels.SocketChannel;
+import java.nio.charset.StandardCharsets;
+import java.util.concurrent.TimeUnit;
+
+import org.eclipse.jetty.http.HttpStatus;
+import org.eclipse.jetty.http.HttpTester;
+import org.eclipse.jetty.io.Content;
+import org.eclipse.jetty.server.Handler;
+import org.eclipse.jetty.server.Request;
+import org.eclipse.jetty.server.Response;
+import org.eclipse.jetty.server.Server;
+import org.eclipse.jetty.server.ServerConnector;
+import org.eclipse.jetty.util.Blocker;
+import org.eclipse.jetty.util.Callback;
+import org.eclipse.jetty.util.VirtualThreads;
+import org.eclipse.jetty.util.thread.QueuedThreadPool;
+import org.eclipse.jetty.util.thread.ScheduledExecutorScheduler;
+import org.eclipse.jetty.util.thread.Scheduler;
+import org.openjdk.jmh.annotations.Benchmark;
+import org.openjdk.jmh.annotations.BenchmarkMode;
+import org.openjdk.jmh.annotations.Level;
+import org.openjdk.jmh.annotations.Mode;
+import org.openjdk.jmh.annotations.Param;
+import org.openjdk.jmh.annotations.Scope;
+import org.openjdk.jmh.annotations.Setup;
+import org.openjdk.jmh.annotations.State;
+import org.openjdk.jmh.annotations.TearDown;
+import org.openjdk.jmh.runner.Runner;
+import org.openjdk.jmh.runner.options.Options;
+import org.openjdk.jmh.runner.options.OptionsBuilder;
+import org.openjdk.jmh.runner.options.TimeValue;
+
+/**
+ * <p>Measures the throughput of requests to a handler that blocks, as if waiting
+ * for a slow backend, with a small pool of platform threads and with virtual threads.</p>
+ * <p>With platform threads, the number of concurrent blocking requests is bounded by
+ * {@link #maxThreads}; with virtual threads, it is only bounded by the number of
+ * concurrent clients, so the throughput per core is expected to be higher.</p>
+ * <p>Requires a JVM that supports virtual threads to run the {@code virtual} mode.</p>
+ */
+@State(Scope.Benchmark)
+public class VirtualThreadsBlockingBenchmark
+{
+    public static void main(String[] args) throws Exception
+    {
+        Options opt = new OptionsBuilder()
+            .include(VirtualThreadsBlockingBenchmark.class.getSimpleName())
+            .warmupIterations(5)
+            .warmupTime(TimeValue.seconds(2))
+            .measurementIterations(5)
+            .measurementTime(TimeValue.seconds(2))
+            .forks(1)
+            .threads(400)
+            .build();
+        new Runner(opt).run();
+    }
+
+    @Param({"platform", "virtual"})
+    public String mode;
+
+    @Param({"32"})
+    public int maxThreads;
+
+    @Param({"5"})
+    public long blockMillis;
+
+    Scheduler scheduler;
+    Server server;
+    ServerConnector connector;
+
+    @Setup
+    public void prepare() throws Exception
+    {
+        scheduler = new ScheduledExecutorScheduler();
+        scheduler.start();
+
+        QueuedThreadPool threadPool = new QueuedThreadPool(maxThreads, maxThreads);
+        if ("virtual".equals(mode))
+        {
+            if (!VirtualThreads.areSupported())
+                throw new IllegalStateException("virtual threads not supported");
+            threadPool.setVirtualThreadsExecutor(VirtualThreads.getDefaultVirtualThreadsExecutor());
+        }
+        server = new Server(threadPool);
+        connector = new ServerConnector(server, 1, 1);
+        connector.setAcceptQueueSize(1024);
+        server.addConnector(connector);
+        server.setHandler(new Handler.Abstract()
+        {
+            @Override
+            public boolean handle(Request request, Response response, Callback callback) throws Exception
+            {
+                // Block the handling thread, as a blocking call to a slow backend would.
+                try (Blocker.Callback blocker = Blocker.callback())
+                {
+                    scheduler.schedule(blocker::succeeded, blockMillis, TimeUnit.MILLISECONDS);
+                    blocker.block();
+                }
+                try (OutputStream output = Content.Sink.asOutputStream(response))
+                {
+                    output.write("OK".getBytes(StandardCharsets.US_ASCII));
+                }
+                callback.succeeded();
+                return true;
+            }
+        });
+        server.start();
+    }
+
+    @TearDown
+    public void dispose() throws Exception
+    {
+        server.stop();
+        scheduler.stop();
+    }
+
+    @State(Scope.Thread)
+    public static class Client
+    {
+        SocketChannel channel;
+
+        @Setup(Level.Trial)
+        public void connect(VirtualThreadsBlockingBenchmark benchmark) throws Exception
+        {
+            channel = SocketChannel.open(new InetSocketAddress("localhost", benchmark.connector.getLocalPort()));
+        }
+
+        @TearDown(Level.Trial)
+        public void close() throws Exception
+        {
+            channel.close();
+        }
+    }
+
+    @Benchmark
+    @BenchmarkMode({Mode.Throughput})
+    public int request(Client client) throws Exception
+    {
+        client.channel.write(StandardCharsets.US_ASCII.encode("GET / HTTP/1.1\r\nHost: localhost\r\n\r\n"));
+        HttpTester.Response response = HttpTester.parseResponse(HttpTester.from(client.channel));
+        if (response == null || response.getStatus() != HttpStatus.OK_200)
+            throw new IllegalStateException("unexpected response " + response);
+        return response.getStatus();
+    }
+}
@@ -23,6 +23,7 @@ import org.eclipse.jetty.util.component.LifeCycle;
 import org.eclipse.jetty.util.thread.ExecutorThreadPool;
 import org.eclipse.jetty.util.thread.QueuedThreadPool;
 import org.eclipse.jetty.util.thread.ThreadPool;
+import org.eclipse.jetty.util.thread.WorkStealingThreadPool;
 import org.openjdk.jmh.annotations.Benchmark;
 import org.openjdk.jmh.annotations.BenchmarkMode;
 import org.openjdk.jmh.annotations.Measurement;
@@ -46,10 +47,10 @@ public class ThreadPoolBenchmark
 {
     public enum Type
     {
-        QTP, ETP, LQTP, LETP, AQTP, AETP;
+        QTP, ETP, LQTP, LETP, AQTP, AETP, WSTP;
     }
 
-    @Param({"QTP", "ETP" /*, "LQTP", "LETP", "AQTP", "AETP" */})
+    @Param({"QTP", "ETP", "WSTP" /*, "LQTP", "LETP", "AQTP", "AETP" */})
     Type type;
 
     @Param({"200"})
@@ -98,6 +99,10 @@ public class ThreadPoolBenchmark
                 pool = new ExecutorThreadPool(size, size, new ArrayBlockingQueue<>(32768));
                 break;
 
+            case WSTP:
+                pool = new WorkStealingThreadPool(size, size);
+                break;
+
             default:
                 throw new IllegalStateException();
         }
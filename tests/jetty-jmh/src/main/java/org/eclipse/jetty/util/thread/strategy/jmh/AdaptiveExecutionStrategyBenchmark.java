@@ -26,6 +26,7 @@ import org.eclipse.jetty.util.component.LifeCycle;
 import org.eclipse.jetty.util.thread.ExecutionStrategy;
 import org.eclipse.jetty.util.thread.Invocable;
 import org.eclipse.jetty.util.thread.ReservedThreadExecutor;
+import org.eclipse.jetty.util.thread.WorkStealingThreadPool;
 import org.eclipse.jetty.util.thread.strategy.AdaptiveExecutionStrategy;
 import org.eclipse.jetty.util.thread.strategy.ProduceConsume;
 import org.eclipse.jetty.util.thread.strategy.ProduceExecuteConsume;
@@ -54,6 +55,9 @@ public class AdaptiveExecutionStrategyBenchmark
     @Param({"PC", "PEC", "AES"})
     public static String strategyName;
 
+    @Param({"QTP", "WSTP"})
+    public static String poolName;
+
     @Param({"true", "false"})
     public static boolean sleeping;
 
@@ -72,7 +76,19 @@ public class AdaptiveExecutionStrategyBenchmark
             File.createTempFile("AES_benchmark", i + ".txt", directory.toFile());
         }
 
-        server = new TestServer(directory.toFile());
+        switch (poolName)
+        {
+            case "QTP":
+                server = new TestServer(directory.toFile());
+                break;
+
+            case "WSTP":
+                server = new TestServer(directory.toFile(), new WorkStealingThreadPool(200, 200));
+                break;
+
+            default:
+                throw new IllegalStateException();
+        }
         server.start();
         reserved = new ReservedThreadExecutor(server, 20);
         reserved.start();
@@ -21,21 +21,35 @@ import java.util.concurrent.ConcurrentMap;
 import java.util.concurrent.Executor;
 import java.util.concurrent.ThreadLocalRandom;
 
+import org.eclipse.jetty.util.component.LifeCycle;
 import org.eclipse.jetty.util.thread.QueuedThreadPool;
+import org.eclipse.jetty.util.thread.ThreadPool;
 import org.eclipse.jetty.util.thread.TryExecutor;
 
 public class TestServer implements Executor, TryExecutor
 {
     private final ConcurrentMap<String, Map<String, String>> _sessions = new ConcurrentHashMap<>();
-    private final QueuedThreadPool _threadpool = new QueuedThreadPool(200);
+    private final ThreadPool _threadpool;
     private final File _docroot;
 
     TestServer(File docroot)
     {
-        _threadpool.setReservedThreads(20);
+        this(docroot, newQueuedThreadPool());
+    }
+
+    TestServer(File docroot, ThreadPool threadpool)
+    {
+        _threadpool = threadpool;
         _docroot = docroot;
     }
 
+    private static ThreadPool newQueuedThreadPool()
+    {
+        QueuedThreadPool qtp = new QueuedThreadPool(200);
+        qtp.setReservedThreads(20);
+        return qtp;
+    }
+
     TestServer()
     {
         this(new File(System.getProperty("java.io.tmpdir")));
@@ -69,17 +83,17 @@ public class TestServer implements Executor, TryExecutor
     @Override
     public boolean tryExecute(Runnable task)
     {
-        return _threadpool.tryExecute(task);
+        return _threadpool instanceof TryExecutor tryExecutor && tryExecutor.tryExecute(task);
     }
 
     public void start() throws Exception
     {
-        _threadpool.start();
+        LifeCycle.start(_threadpool);
     }
 
     public void stop() throws Exception
     {
-        _threadpool.stop();
+        LifeCycle.stop(_threadpool);
     }
 
     public File getFile(String path)
@@ -0,0 +1,64 @@
+//
+// ========================================================================
+// Copyright (c) 1995 Mort Bay Consulting Pty Ltd and others.
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License v. 2.0 which is available at
+// https://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+// ========================================================================
+//
+
+package org.eclipse.jetty.tests.load;
+
+import java.nio.ByteBuffer;
+import java.util.function.Supplier;
+
+import org.eclipse.jetty.client.Request;
+import org.eclipse.jetty.client.Response;
+import org.eclipse.jetty.client.Result;
+import org.eclipse.jetty.http.HttpStatus;
+
+/**
+ * <p>A {@link LoadGenerator} that sends one HTTP request per operation.</p>
+ * <p>Response content is counted but not buffered, so that the client
+ * allocation does not dominate the measurement of large responses.</p>
+ */
+public class HttpLoadGenerator extends LoadGenerator
+{
+    private final Supplier<Request> requests;
+
+    /**
+     * @param requests creates a new request for each operation
+     */
+    public HttpLoadGenerator(Supplier<Request> requests)
+    {
+        this.requests = requests;
+    }
+
+    @Override
+    protected void send(long intendedNanos, boolean measured)
+    {
+        requests.get().send(new Response.Listener()
+        {
+            private long bytes;
+
+            @Override
+            public void onContent(Response response, ByteBuffer content)
+            {
+                bytes += content.remaining();
+            }
+
+            @Override
+            public void onComplete(Result result)
+            {
+                Throwable failure = result.getFailure();
+                if (failure == null && !HttpStatus.isSuccess(result.getResponse().getStatus()))
+                    failure = new IllegalStateException("Unexpected response " + result.getResponse());
+                HttpLoadGenerator.this.onComplete(intendedNanos, measured, bytes, failure);
+            }
+        });
+    }
+}
@@ -0,0 +1,152 @@
+//
+// ========================================================================
+// Copyright (c) 1995 Mort Bay Consulting Pty Ltd and others.
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License v. 2.0 which is available at
+// https://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+// ========================================================================
+//
+
+package org.eclipse.jetty.tests.load;
+
+import java.io.IOException;
+import java.util.Locale;
+import java.util.concurrent.TimeUnit;
+import java.util.concurrent.atomic.AtomicLongArray;
+import java.util.concurrent.atomic.LongAccumulator;
+import java.util.concurrent.atomic.LongAdder;
+
+/**
+ * <p>A lock-free, log-linear latency histogram in the style of HdrHistogram.</p>
+ * <p>Values below {@value #LINEAR_BUCKETS} are recorded exactly; above that,
+ * each power of two is split into {@value #SUB_BUCKETS} buckets, so that any
+ * recorded value is reported with a relative error below 1/{@value #SUB_BUCKETS}.
+ * Values are recorded in nanoseconds, up to ~18 minutes; larger values are
+ * clamped to the highest bucket.</p>
+ */
+public class LatencyHistogram
+{
+    private static final int SUB_BUCKET_BITS = 6;
+    private static final int SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+    private static final int LINEAR_BUCKETS = SUB_BUCKETS << 1;
+    private static final long MAX_VALUE = (1L << 40) - 1;
+    private static final int BUCKETS = indexOf(MAX_VALUE) + 1;
+
+    private final AtomicLongArray counts = new AtomicLongArray(BUCKETS);
+    private final LongAdder totalCount = new LongAdder();
+    private final LongAdder totalValue = new LongAdder();
+    private final LongAccumulator minValue = new LongAccumulator(Math::min, Long.MAX_VALUE);
+    private final LongAccumulator maxValue = new LongAccumulator(Math::max, 0);
+
+    static int indexOf(long value)
+    {
+        if (value < LINEAR_BUCKETS)
+            return (int)value;
+        int shift = 64 - Long.numberOfLeadingZeros(value) - SUB_BUCKET_BITS - 1;
+        int subBucket = (int)(value >>> shift) - SUB_BUCKETS;
+        return LINEAR_BUCKETS + (shift - 1) * SUB_BUCKETS + subBucket;
+    }
+
+    static long highestValueAt(int index)
+    {
+        if (index < LINEAR_BUCKETS)
+            return index;
+        int shift = (index - LINEAR_BUCKETS) / SUB_BUCKETS + 1;
+        long subBucket = (index - LINEAR_BUCKETS) % SUB_BUCKETS + SUB_BUCKETS;
+        return ((subBucket + 1) << shift) - 1;
+    }
+
+    /**
+     * @param nanos the latency to record, in nanoseconds
+     */
+    public void record(long nanos)
+    {
+        long value = Math.max(0, Math.min(nanos, MAX_VALUE));
+        counts.incrementAndGet(indexOf(value));
+        totalCount.increment();
+        totalValue.add(value);
+        minValue.accumulate(value);
+        maxValue.accumulate(value);
+    }
+
+    public long getCount()
+    {
+        return totalCount.sum();
+    }
+
+    public long getMin()
+    {
+        return getCount() == 0 ? 0 : minValue.get();
+    }
+
+    public long getMax()
+    {
+        return maxValue.get();
+    }
+
+    public double getMean()
+    {
+        long count = getCount();
+        return count == 0 ? 0 : (double)totalValue.sum() / count;
+    }
+
+    /**
+     * @param percentile the percentile, between 0 and 100
+     * @return the highest value, in nanoseconds, that the given percentile of samples is at or below
+     */
+    public long getValueAtPercentile(double percentile)
+    {
+        long count = getCount();
+        if (count == 0)
+            return 0;
+        long target = Math.max(1, (long)Math.ceil(Math.min(percentile, 100.0D) / 100.0D * count));
+        long accumulated = 0;
+        for (int i = 0; i < BUCKETS; ++i)
+        {
+            accumulated += counts.get(i);
+            if (accumulated >= target)
+                return Math.min(highestValueAt(i), getMax());
+        }
+        return getMax();
+    }
+
+    /**
+     * <p>Writes the percentile distribution, one {@code value percentile count} line
+     * per non-empty bucket, with values in microseconds, so that it can be plotted
+     * or diffed against the distribution of another run.</p>
+     *
+     * @param output where to write the distribution
+     * @throws IOException if the distribution cannot be written
+     */
+    public void writeDistribution(Appendable output) throws IOException
+    {
+        long count = getCount();
+        output.append(String.format(Locale.ROOT, "%12s %12s %12s%n", "Value(us)", "Percentile", "TotalCount"));
+        long accumulated = 0;
+        for (int i = 0; i < BUCKETS; ++i)
+        {
+            long bucketCount = counts.get(i);
+            if (bucketCount == 0)
+                continue;
+            accumulated += bucketCount;
+            double micros = Math.min(highestValueAt(i), getMax()) / (double)TimeUnit.MICROSECONDS.toNanos(1);
+            output.append(String.format(Locale.ROOT, "%12.3f %12.6f %12d%n", micros, (double)accumulated / count, accumulated));
+        }
+    }
+
+    @Override
+    public String toString()
+    {
+        return String.format("%s@%x[count=%d,p50=%d,p99=%d,max=%d]",
+            getClass().getSimpleName(),
+            hashCode(),
+            getCount(),
+            getValueAtPercentile(50),
+            getValueAtPercentile(99),
+            getMax());
+    }
+}
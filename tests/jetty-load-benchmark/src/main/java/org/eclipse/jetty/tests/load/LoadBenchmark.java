@@ -0,0 +1,257 @@
+//
+// ========================================================================
+// Copyright (c) 1995 Mort Bay Consulting Pty Ltd and others.
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License v. 2.0 which is available at
+// https://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+// ========================================================================
+//
+
+package org.eclipse.jetty.tests.load;
+
+import java.io.IOException;
+import java.io.UncheckedIOException;
+import java.io.Writer;
+import java.net.URI;
+import java.nio.charset.StandardCharsets;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.util.LinkedHashMap;
+import java.util.Locale;
+import java.util.Map;
+import java.util.Set;
+import java.util.function.Supplier;
+
+import org.eclipse.jetty.client.HttpClient;
+import org.eclipse.jetty.client.Request;
+import org.eclipse.jetty.server.Connector;
+import org.eclipse.jetty.server.Server;
+import org.eclipse.jetty.util.IO;
+import org.eclipse.jetty.util.component.LifeCycle;
+import org.eclipse.jetty.util.thread.QueuedThreadPool;
+import org.eclipse.jetty.websocket.client.WebSocketClient;
+
+/**
+ * <p>An end-to-end load benchmark that runs a Jetty server and an open-loop
+ * {@link LoadGenerator} in the same JVM, for a given {@link Protocol} and {@link Workload}.</p>
+ * <p>Usage:</p>
+ * <pre>{@code
+ * java -jar benchmarks.jar [key=value]...
+ *
+ *   protocol=HTTP|H2|H3|MEMORY     (default HTTP)
+ *   workload=JSON|FILE|UPLOAD|STREAM|WEBSOCKET  (default JSON)
+ *   rate=<ops/s>                   (default 1000)
+ *   warmup=<seconds>               (default 5)
+ *   duration=<seconds>             (default 20)
+ *   connections=<n>                (max client connections, default 8)
+ *   selectors=<n>                  (server and client selectors, default 1)
+ *   size=<bytes>                   (content size, default depends on the workload)
+ *   subscribers=<n>                (WebSocket sessions receiving each message, default 100)
+ *   report=<file>                  (writes the report to the file)
+ *   histogram=<file>               (writes the latency distribution to the file)
+ *   baseline=<file>                (compares the report with a previous report)
+ *   threshold=<percent>            (tolerated regression against the baseline, default 10)
+ *   jfr=<file>                     (dumps a JFR recording of the measurement period)
+ * }</pre>
+ * <p>The process exits with status {@code 1} if any metric regressed against the baseline.</p>
+ */
+public class LoadBenchmark
+{
+    private static final Set<String> OUTPUT_OPTIONS = Set.of("report", "histogram", "baseline", "threshold", "jfr");
+
+    private final Map<String, String> config = new LinkedHashMap<>();
+    private final Map<String, String> output = new LinkedHashMap<>();
+    private LoadGenerator generator;
+
+    /**
+     * @param options the {@code key=value} options, see the class javadoc
+     */
+    public LoadBenchmark(Map<String, String> options)
+    {
+        config.put("protocol", Protocol.HTTP.name());
+        config.put("workload", Workload.JSON.name());
+        config.put("rate", "1000");
+        config.put("warmup", "5");
+        config.put("duration", "20");
+        config.put("connections", "8");
+        config.put("selectors", "1");
+        config.put("size", "");
+        config.put("subscribers", "100");
+        output.put("threshold", "10");
+        options.forEach((key, value) ->
+        {
+            if (OUTPUT_OPTIONS.contains(key))
+                output.put(key, value);
+            else if (config.containsKey(key))
+                config.put(key, value);
+            else
+                throw new IllegalArgumentException("Unknown option " + key);
+        });
+
+        Workload workload = getWorkload();
+        if (config.get("size").isEmpty())
+            config.put("size", String.valueOf(workload.getDefaultSize()));
+        if (workload.isWebSocket())
+        {
+            if (getProtocol() != Protocol.HTTP)
+                throw new IllegalArgumentException("Workload " + workload + " requires protocol " + Protocol.HTTP);
+        }
+        else
+        {
+            config.remove("subscribers");
+        }
+    }
+
+    public static void main(String... args) throws Exception
+    {
+        Map<String, String> options = new LinkedHashMap<>();
+        for (String arg : args)
+        {
+            int equals = arg.indexOf('=');
+            if (equals <= 0)
+                throw new IllegalArgumentException("Invalid argument " + arg + ", expected key=value");
+            options.put(arg.substring(0, equals), arg.substring(equals + 1));
+        }
+
+        LoadBenchmark benchmark = new LoadBenchmark(options);
+        int regressions = benchmark.report(benchmark.run());
+        System.exit(regressions > 0 ? 1 : 0);
+    }
+
+    public Protocol getProtocol()
+    {
+        return Protocol.valueOf(config.get("protocol").toUpperCase(Locale.ENGLISH));
+    }
+
+    public Workload getWorkload()
+    {
+        return Workload.valueOf(config.get("workload").toUpperCase(Locale.ENGLISH));
+    }
+
+    private int getInt(String key)
+    {
+        return Integer.parseInt(config.get(key));
+    }
+
+    private Path getPath(String key)
+    {
+        String value = output.get(key);
+        return value == null ? null : Path.of(value);
+    }
+
+    /**
+     * <p>Starts the server and the client, runs the load and stops everything.</p>
+     *
+     * @return the report of the run
+     * @throws Exception if the benchmark fails
+     */
+    public Report run() throws Exception
+    {
+        Protocol protocol = getProtocol();
+        Workload workload = getWorkload();
+        int selectors = getInt("selectors");
+        int size = getInt("size");
+
+        Path workDir = Files.createTempDirectory("jetty-load-");
+        QueuedThreadPool serverThreads = new QueuedThreadPool();
+        serverThreads.setName("server");
+        Server server = new Server(serverThreads);
+        HttpClient httpClient = null;
+        WebSocketClient webSocketClient = null;
+        try
+        {
+            Connector connector = protocol.newConnector(server, selectors, workDir);
+            server.addConnector(connector);
+            server.setHandler(workload.newHandler(server, workDir, size));
+            server.start();
+
+            QueuedThreadPool clientThreads = new QueuedThreadPool();
+            clientThreads.setName("client");
+            httpClient = new HttpClient(protocol.newHttpClientTransport(selectors));
+            httpClient.setExecutor(clientThreads);
+            httpClient.setMaxConnectionsPerDestination(getInt("connections"));
+            // Open-loop: a slow server must queue requests, not fail them.
+            httpClient.setMaxRequestsQueuedPerDestination(Integer.MAX_VALUE);
+            httpClient.start();
+
+            URI uri = protocol.newURI(connector);
+            if (workload.isWebSocket())
+            {
+                webSocketClient = new WebSocketClient(httpClient);
+                webSocketClient.setMaxTextMessageSize(Math.max(64 * 1024, 2L * size));
+                webSocketClient.start();
+                WebSocketLoadGenerator webSocketGenerator = new WebSocketLoadGenerator(webSocketClient, uri, getInt("subscribers"), size);
+                webSocketGenerator.connect();
+                generator = webSocketGenerator;
+            }
+            else
+            {
+                Supplier<Request> requests = workload.newRequests(httpClient, uri, size);
+                generator = new HttpLoadGenerator(() -> protocol.configure(requests.get(), connector));
+            }
+
+            ResourceMonitor monitor = new ResourceMonitor(getPath("jfr"));
+            generator.run(getInt("rate"), getInt("warmup"), getInt("duration"), monitor::begin, () ->
+            {
+                try
+                {
+                    monitor.end();
+                }
+                catch (IOException x)
+                {
+                    throw new UncheckedIOException(x);
+                }
+            });
+
+            if (generator instanceof WebSocketLoadGenerator webSocketGenerator)
+                webSocketGenerator.disconnect();
+
+            return Report.of(config, generator, monitor);
+        }
+        finally
+        {
+            LifeCycle.stop(webSocketClient);
+            LifeCycle.stop(httpClient);
+            LifeCycle.stop(server);
+            IO.delete(workDir);
+        }
+    }
+
+    /**
+     * <p>Prints the report, writes the output files and compares the report with the baseline, if configured.</p>
+     *
+     * @param report the report of the run
+     * @return the number of metrics that regressed against the baseline
+     * @throws IOException if the output files cannot be written
+     */
+    public int report(Report report) throws IOException
+    {
+        report.write(System.out);
+
+        Path reportFile = getPath("report");
+        if (reportFile != null)
+            report.store(reportFile);
+
+        Path histogramFile = getPath("histogram");
+        if (histogramFile != null)
+        {
+            try (Writer writer = Files.newBufferedWriter(histogramFile, StandardCharsets.UTF_8))
+            {
+                generator.getHistogram().writeDistribution(writer);
+            }
+        }
+
+        Path baselineFile = getPath("baseline");
+        if (baselineFile == null)
+            return 0;
+        System.out.println();
+        System.out.printf("Comparison with baseline %s:%n", baselineFile);
+        int regressions = report.compare(Report.load(baselineFile), Double.parseDouble(output.get("threshold")), System.out);
+        System.out.printf("%d regression(s) above %s%%%n", regressions, output.get("threshold"));
+        return regressions;
+    }
+}
@@ -0,0 +1,192 @@
+//
+// ========================================================================
+// Copyright (c) 1995 Mort Bay Consulting Pty Ltd and others.
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License v. 2.0 which is available at
+// https://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+// ========================================================================
+//
+
+package org.eclipse.jetty.tests.load;
+
+import java.util.concurrent.TimeUnit;
+import java.util.concurrent.atomic.AtomicLong;
+import java.util.concurrent.atomic.LongAdder;
+import java.util.concurrent.locks.LockSupport;
+
+import org.eclipse.jetty.util.NanoTime;
+import org.slf4j.Logger;
+import org.slf4j.LoggerFactory;
+
+/**
+ * <p>An open-loop load generator.</p>
+ * <p>Operations are started at a fixed rate, following a schedule computed upfront,
+ * regardless of whether previous operations have completed: a slow server therefore
+ * accumulates outstanding operations rather than slowing down the generator, as it
+ * would with real, independent clients.</p>
+ * <p>Latency is measured from the time an operation was <em>scheduled</em> to start,
+ * not from the time it actually started, so that the delays caused by the server
+ * falling behind are accounted in the latency figures rather than hidden
+ * (the so called <em>coordinated omission</em> problem).</p>
+ * <p>Operations scheduled during the warmup period are executed but not measured.</p>
+ */
+public abstract class LoadGenerator
+{
+    private static final Logger LOG = LoggerFactory.getLogger(LoadGenerator.class);
+
+    private final LatencyHistogram histogram = new LatencyHistogram();
+    private final LongAdder scheduled = new LongAdder();
+    private final LongAdder succeeded = new LongAdder();
+    private final LongAdder failed = new LongAdder();
+    private final LongAdder bytes = new LongAdder();
+    private final AtomicLong pending = new AtomicLong();
+    private long measureNanos;
+
+    /**
+     * <p>Runs the load for the given warmup and measurement periods, then waits
+     * for the outstanding operations to complete.</p>
+     *
+     * @param rate the number of operations per second
+     * @param warmupSeconds the warmup period, in seconds
+     * @param durationSeconds the measurement period, in seconds
+     * @param onMeasureBegin invoked when the measurement period begins
+     * @param onMeasureEnd invoked when the measurement period ends, before waiting for outstanding operations
+     * @throws Exception if the load cannot be generated
+     */
+    public void run(int rate, int warmupSeconds, int durationSeconds, Runnable onMeasureBegin, Runnable onMeasureEnd) throws Exception
+    {
+        if (rate <= 0)
+            throw new IllegalArgumentException("Invalid rate " + rate);
+
+        long interval = TimeUnit.SECONDS.toNanos(1) / rate;
+        long begin = NanoTime.now();
+        long warmupEnd = begin + TimeUnit.SECONDS.toNanos(warmupSeconds);
+        long end = warmupEnd + TimeUnit.SECONDS.toNanos(durationSeconds);
+        boolean measuring = false;
+        for (long i = 0; ; ++i)
+        {
+            long intended = begin + i * interval;
+            if (!NanoTime.isBefore(intended, end))
+                break;
+
+            long wait = NanoTime.until(intended);
+            if (wait > 0)
+                LockSupport.parkNanos(wait);
+
+            boolean measured = NanoTime.isBeforeOrSame(warmupEnd, intended);
+            if (measured && !measuring)
+            {
+                measuring = true;
+                onMeasureBegin.run();
+            }
+
+            int fanOut = getFanOut();
+            pending.addAndGet(fanOut);
+            if (measured)
+                scheduled.add(fanOut);
+            try
+            {
+                send(intended, measured);
+            }
+            catch (Throwable x)
+            {
+                for (int f = 0; f < fanOut; ++f)
+                {
+                    onComplete(intended, measured, 0, x);
+                }
+            }
+        }
+        measureNanos = NanoTime.elapsed(warmupEnd, end);
+        onMeasureEnd.run();
+
+        long drainEnd = NanoTime.now() + TimeUnit.SECONDS.toNanos(30);
+        while (pending.get() > 0 && NanoTime.isBefore(NanoTime.now(), drainEnd))
+        {
+            Thread.sleep(10);
+        }
+        if (pending.get() > 0)
+            LOG.warn("{} operations still outstanding at the end of the run", pending.get());
+    }
+
+    /**
+     * @return the number of completions expected for each operation sent
+     */
+    protected int getFanOut()
+    {
+        return 1;
+    }
+
+    /**
+     * <p>Starts one operation; implementations must not block and must eventually
+     * call {@link #onComplete(long, boolean, long, Throwable)} {@link #getFanOut()} times.</p>
+     *
+     * @param intendedNanos the nanoTime at which the operation was scheduled
+     * @param measured whether the operation must be measured
+     */
+    protected abstract void send(long intendedNanos, boolean measured);
+
+    /**
+     * <p>Records the completion of an operation.</p>
+     *
+     * @param intendedNanos the nanoTime at which the operation was scheduled
+     * @param measured whether the operation must be measured
+     * @param byteCount the number of bytes transferred by the operation
+     * @param failure the operation failure, or {@code null} if the operation succeeded
+     */
+    protected void onComplete(long intendedNanos, boolean measured, long byteCount, Throwable failure)
+    {
+        if (measured)
+        {
+            if (failure == null)
+            {
+                histogram.record(NanoTime.since(intendedNanos));
+                succeeded.increment();
+                bytes.add(byteCount);
+            }
+            else
+            {
+                if (LOG.isDebugEnabled())
+                    LOG.debug("Operation failed", failure);
+                failed.increment();
+            }
+        }
+        pending.decrementAndGet();
+    }
+
+    public LatencyHistogram getHistogram()
+    {
+        return histogram;
+    }
+
+    public long getScheduled()
+    {
+        return scheduled.sum();
+    }
+
+    public long getSucceeded()
+    {
+        return succeeded.sum();
+    }
+
+    public long getFailed()
+    {
+        return failed.sum();
+    }
+
+    public long getBytes()
+    {
+        return bytes.sum();
+    }
+
+    /**
+     * @return the length of the measurement period, in nanoseconds
+     */
+    public long getMeasureNanos()
+    {
+        return measureNanos;
+    }
+}
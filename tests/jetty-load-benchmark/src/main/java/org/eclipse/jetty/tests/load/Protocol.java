@@ -0,0 +1,159 @@
+//
+// ========================================================================
+// Copyright (c) 1995 Mort Bay Consulting Pty Ltd and others.
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License v. 2.0 which is available at
+// https://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+// ========================================================================
+//
+
+package org.eclipse.jetty.tests.load;
+
+import java.net.URI;
+import java.nio.file.Path;
+
+import org.eclipse.jetty.alpn.server.ALPNServerConnectionFactory;
+import org.eclipse.jetty.client.HttpClientTransport;
+import org.eclipse.jetty.client.Request;
+import org.eclipse.jetty.client.transport.HttpClientTransportOverHTTP;
+import org.eclipse.jetty.http2.HTTP2Cipher;
+import org.eclipse.jetty.http2.client.HTTP2Client;
+import org.eclipse.jetty.http2.client.transport.HttpClientTransportOverHTTP2;
+import org.eclipse.jetty.http2.server.HTTP2ServerConnectionFactory;
+import org.eclipse.jetty.http3.client.HTTP3Client;
+import org.eclipse.jetty.http3.client.transport.HttpClientTransportOverHTTP3;
+import org.eclipse.jetty.http3.server.HTTP3ServerConnectionFactory;
+import org.eclipse.jetty.io.ClientConnector;
+import org.eclipse.jetty.quic.client.ClientQuicConfiguration;
+import org.eclipse.jetty.quic.server.QuicServerConnector;
+import org.eclipse.jetty.quic.server.ServerQuicConfiguration;
+import org.eclipse.jetty.server.Connector;
+import org.eclipse.jetty.server.HostHeaderCustomizer;
+import org.eclipse.jetty.server.HttpConfiguration;
+import org.eclipse.jetty.server.HttpConnectionFactory;
+import org.eclipse.jetty.server.MemoryConnector;
+import org.eclipse.jetty.server.MemoryTransport;
+import org.eclipse.jetty.server.NetworkConnector;
+import org.eclipse.jetty.server.SecureRequestCustomizer;
+import org.eclipse.jetty.server.Server;
+import org.eclipse.jetty.server.ServerConnector;
+import org.eclipse.jetty.server.SslConnectionFactory;
+import org.eclipse.jetty.util.resource.ResourceFactory;
+import org.eclipse.jetty.util.ssl.SslContextFactory;
+
+/**
+ * <p>The protocols, and the server connectors carrying them, that can be benchmarked.</p>
+ */
+public enum Protocol
+{
+    /**
+     * <p>HTTP/1.1 over a {@link ServerConnector}.</p>
+     */
+    HTTP,
+    /**
+     * <p>HTTP/2 over TLS over a {@link ServerConnector}.</p>
+     */
+    H2,
+    /**
+     * <p>HTTP/3 over a {@link QuicServerConnector}.</p>
+     */
+    H3,
+    /**
+     * <p>HTTP/1.1 over a {@link MemoryConnector}, excluding the network stack from the measurement.</p>
+     */
+    MEMORY;
+
+    public boolean isSecure()
+    {
+        return this == H2 || this == H3;
+    }
+
+    /**
+     * @param server the server
+     * @param selectors the number of selectors of the connector
+     * @param pemWorkDir the directory where QUIC exports the key material
+     * @return a new connector for this protocol
+     */
+    public Connector newConnector(Server server, int selectors, Path pemWorkDir)
+    {
+        HttpConfiguration httpConfig = new HttpConfiguration();
+        return switch (this)
+        {
+            case HTTP -> new ServerConnector(server, 1, selectors, new HttpConnectionFactory(httpConfig));
+            case H2 ->
+            {
+                httpConfig.addCustomizer(new SecureRequestCustomizer());
+                httpConfig.addCustomizer(new HostHeaderCustomizer());
+                HTTP2ServerConnectionFactory h2 = new HTTP2ServerConnectionFactory(httpConfig);
+                ALPNServerConnectionFactory alpn = new ALPNServerConnectionFactory(h2.getProtocol());
+                SslConnectionFactory ssl = new SslConnectionFactory(newSslContextFactoryServer(server), alpn.getProtocol());
+                yield new ServerConnector(server, 1, selectors, ssl, alpn, h2);
+            }
+            case H3 ->
+            {
+                httpConfig.addCustomizer(new SecureRequestCustomizer());
+                httpConfig.addCustomizer(new HostHeaderCustomizer());
+                ServerQuicConfiguration quicConfig = new ServerQuicConfiguration(newSslContextFactoryServer(server), pemWorkDir);
+                yield new QuicServerConnector(server, quicConfig, new HTTP3ServerConnectionFactory(quicConfig, httpConfig));
+            }
+            case MEMORY -> new MemoryConnector(server, new HttpConnectionFactory(httpConfig));
+        };
+    }
+
+    /**
+     * @param selectors the number of selectors of the client
+     * @return a new client transport for this protocol
+     */
+    public HttpClientTransport newHttpClientTransport(int selectors)
+    {
+        ClientConnector clientConnector = new ClientConnector();
+        clientConnector.setSelectors(selectors);
+        clientConnector.setSslContextFactory(new SslContextFactory.Client(true));
+        return switch (this)
+        {
+            case HTTP, MEMORY -> new HttpClientTransportOverHTTP(clientConnector);
+            case H2 -> new HttpClientTransportOverHTTP2(new HTTP2Client(clientConnector));
+            case H3 -> new HttpClientTransportOverHTTP3(new HTTP3Client(new ClientQuicConfiguration(new SslContextFactory.Client(true), null), clientConnector));
+        };
+    }
+
+    /**
+     * @param connector the connector returned by {@link #newConnector(Server, int, Path)}
+     * @return the URI to connect to the given connector
+     */
+    public URI newURI(Connector connector)
+    {
+        String uri = (isSecure() ? "https" : "http") + "://localhost";
+        if (connector instanceof NetworkConnector networkConnector)
+            uri += ":" + networkConnector.getLocalPort();
+        return URI.create(uri);
+    }
+
+    /**
+     * <p>Configures a request so that it is sent to the given connector.</p>
+     *
+     * @param request the request to configure
+     * @param connector the connector returned by {@link #newConnector(Server, int, Path)}
+     * @return the request
+     */
+    public Request configure(Request request, Connector connector)
+    {
+        if (connector instanceof MemoryConnector memoryConnector)
+            request.transport(new MemoryTransport(memoryConnector));
+        return request;
+    }
+
+    private static SslContextFactory.Server newSslContextFactoryServer(Server server)
+    {
+        SslContextFactory.Server ssl = new SslContextFactory.Server();
+        ssl.setKeyStoreResource(ResourceFactory.of(server).newClassLoaderResource("keystore.p12"));
+        ssl.setKeyStorePassword("storepwd");
+        ssl.setUseCipherSuitesOrder(true);
+        ssl.setCipherComparator(HTTP2Cipher.COMPARATOR);
+        return ssl;
+    }
+}
@@ -0,0 +1,203 @@
+//
+// ========================================================================
+// Copyright (c) 1995 Mort Bay Consulting Pty Ltd and others.
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License v. 2.0 which is available at
+// https://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+// ========================================================================
+//
+
+package org.eclipse.jetty.tests.load;
+
+import java.io.IOException;
+import java.io.Reader;
+import java.io.Writer;
+import java.nio.charset.StandardCharsets;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.util.Locale;
+import java.util.Map;
+import java.util.Objects;
+import java.util.Properties;
+import java.util.TreeMap;
+import java.util.concurrent.TimeUnit;
+
+import org.eclipse.jetty.util.Jetty;
+
+/**
+ * <p>The results of a benchmark run, as sorted {@code key=value} lines.</p>
+ * <p>Keys starting with {@code config.} describe the run, keys starting with
+ * {@code env.} describe the environment, and the other keys are the measured
+ * metrics; the stable format allows reports of different runs or releases to
+ * be diffed textually, or {@link #compare(Report, double, Appendable) compared}
+ * to detect regressions.</p>
+ */
+public class Report
+{
+    private static final double[] PERCENTILES = {50, 90, 99, 99.9, 99.99};
+
+    private final Map<String, String> values = new TreeMap<>();
+
+    /**
+     * @param config the benchmark configuration
+     * @param generator the load generator, after the run
+     * @param monitor the resource monitor, after the run
+     * @return a new report with the results of the run
+     */
+    public static Report of(Map<String, String> config, LoadGenerator generator, ResourceMonitor monitor)
+    {
+        Report report = new Report();
+        config.forEach((key, value) -> report.put("config." + key, value));
+        report.put("env.jetty.version", Jetty.VERSION);
+        report.put("env.java.version", System.getProperty("java.version"));
+        report.put("env.java.vm", System.getProperty("java.vm.name"));
+        report.put("env.os", System.getProperty("os.name") + " " + System.getProperty("os.arch"));
+        report.put("env.cpus", Runtime.getRuntime().availableProcessors());
+
+        long succeeded = generator.getSucceeded();
+        double seconds = generator.getMeasureNanos() / (double)TimeUnit.SECONDS.toNanos(1);
+        report.put("ops.scheduled", generator.getScheduled());
+        report.put("ops.succeeded", succeeded);
+        report.put("ops.failed", generator.getFailed());
+        report.put("throughput.ops", String.format(Locale.ROOT, "%.1f", succeeded / seconds));
+        report.put("throughput.bytes", String.format(Locale.ROOT, "%.0f", generator.getBytes() / seconds));
+
+        LatencyHistogram histogram = generator.getHistogram();
+        report.put("latency.min.us", toMicros(histogram.getMin()));
+        report.put("latency.mean.us", toMicros(histogram.getMean()));
+        for (double percentile : PERCENTILES)
+        {
+            report.put("latency.p" + formatPercentile(percentile) + ".us", toMicros(histogram.getValueAtPercentile(percentile)));
+        }
+        report.put("latency.max.us", toMicros(histogram.getMax()));
+
+        long ops = Math.max(1, succeeded);
+        report.put("gc.count", monitor.getGCCount());
+        report.put("gc.time.ms", monitor.getGCMillis());
+        report.put("alloc.bytes", monitor.getAllocatedBytes());
+        report.put("alloc.bytesPerOp", monitor.getAllocatedBytes() / ops);
+        report.put("cpu.nsPerOp", monitor.getCPUNanos() / ops);
+        return report;
+    }
+
+    /**
+     * @param path the report file
+     * @return the report loaded from the given file
+     * @throws IOException if the file cannot be read
+     */
+    public static Report load(Path path) throws IOException
+    {
+        Properties properties = new Properties();
+        try (Reader reader = Files.newBufferedReader(path, StandardCharsets.UTF_8))
+        {
+            properties.load(reader);
+        }
+        Report report = new Report();
+        properties.stringPropertyNames().forEach(key -> report.put(key, properties.getProperty(key)));
+        return report;
+    }
+
+    private static String formatPercentile(double percentile)
+    {
+        return percentile == Math.rint(percentile) ? String.valueOf((long)percentile) : String.valueOf(percentile);
+    }
+
+    private static String toMicros(double nanos)
+    {
+        return String.format(Locale.ROOT, "%.1f", nanos / TimeUnit.MICROSECONDS.toNanos(1));
+    }
+
+    public void put(String key, Object value)
+    {
+        values.put(key, String.valueOf(value));
+    }
+
+    public String get(String key)
+    {
+        return values.get(key);
+    }
+
+    /**
+     * @param path the file to write this report to
+     * @throws IOException if the file cannot be written
+     */
+    public void store(Path path) throws IOException
+    {
+        try (Writer writer = Files.newBufferedWriter(path, StandardCharsets.UTF_8))
+        {
+            write(writer);
+        }
+    }
+
+    /**
+     * @param output where to write this report
+     * @throws IOException if this report cannot be written
+     */
+    public void write(Appendable output) throws IOException
+    {
+        for (Map.Entry<String, String> entry : values.entrySet())
+        {
+            output.append(entry.getKey()).append('=').append(entry.getValue()).append(System.lineSeparator());
+        }
+    }
+
+    /**
+     * <p>Compares the metrics of this report with those of a baseline report.</p>
+     * <p>A metric regresses when it is worse than the baseline by more than the given
+     * threshold: lower is better for all the metrics except {@code throughput.*}.</p>
+     *
+     * @param baseline the baseline report
+     * @param thresholdPercent the tolerated difference, in percent
+     * @param output where to write the comparison
+     * @return the number of regressed metrics
+     * @throws IOException if the comparison cannot be written
+     */
+    public int compare(Report baseline, double thresholdPercent, Appendable output) throws IOException
+    {
+        for (Map.Entry<String, String> entry : values.entrySet())
+        {
+            String key = entry.getKey();
+            if (key.startsWith("config.") && !Objects.equals(entry.getValue(), baseline.get(key)))
+                output.append(String.format("WARNING: %s differs from baseline: %s vs %s%n", key, entry.getValue(), baseline.get(key)));
+        }
+
+        int regressions = 0;
+        for (Map.Entry<String, String> entry : values.entrySet())
+        {
+            String key = entry.getKey();
+            if (!isMetric(key))
+                continue;
+            String baselineValue = baseline.get(key);
+            if (baselineValue == null)
+                continue;
+            double current = Double.parseDouble(entry.getValue());
+            double previous = Double.parseDouble(baselineValue);
+            double change = previous == 0 ? (current == 0 ? 0 : 100) : (current - previous) * 100 / previous;
+            double worse = key.startsWith("throughput.") ? -change : change;
+            boolean regressed = worse > thresholdPercent;
+            if (regressed)
+                ++regressions;
+            output.append(String.format("%-24s %14s %14s %+8.1f%% %s%n", key, baselineValue, entry.getValue(), change, regressed ? "REGRESSION" : ""));
+        }
+        return regressions;
+    }
+
+    private static boolean isMetric(String key)
+    {
+        return key.startsWith("throughput.") ||
+            key.startsWith("latency.") ||
+            key.equals("gc.time.ms") ||
+            key.equals("alloc.bytesPerOp") ||
+            key.equals("cpu.nsPerOp");
+    }
+
+    @Override
+    public String toString()
+    {
+        return String.format("%s@%x%s", getClass().getSimpleName(), hashCode(), values);
+    }
+}
@@ -0,0 +1,159 @@
+//
+// ========================================================================
+// Copyright (c) 1995 Mort Bay Consulting Pty Ltd and others.
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License v. 2.0 which is available at
+// https://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+// ========================================================================
+//
+
+package org.eclipse.jetty.tests.load;
+
+import java.io.IOException;
+import java.lang.management.GarbageCollectorMXBean;
+import java.lang.management.ManagementFactory;
+import java.lang.management.ThreadMXBean;
+import java.nio.file.Path;
+import java.text.ParseException;
+
+import jdk.jfr.Configuration;
+import jdk.jfr.Recording;
+
+/**
+ * <p>Measures the JVM resources used during a benchmark run.</p>
+ * <p>Garbage collections are sampled from the {@link GarbageCollectorMXBean}s,
+ * and allocated bytes from the HotSpot {@link com.sun.management.ThreadMXBean},
+ * when available.
+ * Optionally, a JFR recording with the {@code profile} settings, which include
+ * allocation and CPU sampling, is taken for the measurement period.</p>
+ * <p>The client and the server run in the same JVM, so the figures cover both.</p>
+ */
+public class ResourceMonitor
+{
+    private final Path jfrFile;
+    private Recording recording;
+    private long gcCount;
+    private long gcMillis;
+    private long allocatedBytes;
+    private long cpuNanos;
+
+    /**
+     * @param jfrFile the file where the JFR recording is dumped, or {@code null} to not record
+     */
+    public ResourceMonitor(Path jfrFile)
+    {
+        this.jfrFile = jfrFile;
+    }
+
+    /**
+     * <p>Takes the initial snapshot and starts the JFR recording, if configured.</p>
+     */
+    public void begin()
+    {
+        if (jfrFile != null)
+        {
+            try
+            {
+                recording = new Recording(Configuration.getConfiguration("profile"));
+                recording.setName("jetty-load-benchmark");
+                recording.start();
+            }
+            catch (IOException | ParseException x)
+            {
+                throw new IllegalStateException(x);
+            }
+        }
+        gcCount = -totalGCCount();
+        gcMillis = -totalGCMillis();
+        allocatedBytes = -totalAllocatedBytes();
+        cpuNanos = -totalCPUNanos();
+    }
+
+    /**
+     * <p>Takes the final snapshot and dumps the JFR recording, if configured.</p>
+     *
+     * @throws IOException if the JFR recording cannot be dumped
+     */
+    public void end() throws IOException
+    {
+        gcCount += totalGCCount();
+        gcMillis += totalGCMillis();
+        allocatedBytes += totalAllocatedBytes();
+        cpuNanos += totalCPUNanos();
+        if (recording != null)
+        {
+            recording.stop();
+            recording.dump(jfrFile);
+            recording.close();
+        }
+    }
+
+    public long getGCCount()
+    {
+        return gcCount;
+    }
+
+    public long getGCMillis()
+    {
+        return gcMillis;
+    }
+
+    /**
+     * @return the bytes allocated by all threads, or 0 if not supported by the JVM
+     */
+    public long getAllocatedBytes()
+    {
+        return allocatedBytes;
+    }
+
+    /**
+     * @return the process CPU time in nanoseconds, or 0 if not supported by the JVM
+     */
+    public long getCPUNanos()
+    {
+        return cpuNanos;
+    }
+
+    private static long totalGCCount()
+    {
+        long result = 0;
+        for (GarbageCollectorMXBean gc : ManagementFactory.getGarbageCollectorMXBeans())
+        {
+            result += Math.max(0, gc.getCollectionCount());
+        }
+        return result;
+    }
+
+    private static long totalGCMillis()
+    {
+        long result = 0;
+        for (GarbageCollectorMXBean gc : ManagementFactory.getGarbageCollectorMXBeans())
+        {
+            result += Math.max(0, gc.getCollectionTime());
+        }
+        return result;
+    }
+
+    private static long totalAllocatedBytes()
+    {
+        ThreadMXBean threads = ManagementFactory.getThreadMXBean();
+        if (threads instanceof com.sun.management.ThreadMXBean hotspot && hotspot.isThreadAllocatedMemorySupported())
+        {
+            if (!hotspot.isThreadAllocatedMemoryEnabled())
+                hotspot.setThreadAllocatedMemoryEnabled(true);
+            return hotspot.getTotalThreadAllocatedBytes();
+        }
+        return 0;
+    }
+
+    private static long totalCPUNanos()
+    {
+        if (ManagementFactory.getOperatingSystemMXBean() instanceof com.sun.management.OperatingSystemMXBean os)
+            return os.getProcessCpuTime();
+        return 0;
+    }
+}
@@ -0,0 +1,118 @@
+//
+// ========================================================================
+// Copyright (c) 1995 Mort Bay Consulting Pty Ltd and others.
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License v. 2.0 which is available at
+// https://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+// ========================================================================
+//
+
+package org.eclipse.jetty.tests.load;
+
+import java.net.URI;
+import java.util.ArrayList;
+import java.util.List;
+import java.util.concurrent.CompletableFuture;
+import java.util.concurrent.TimeUnit;
+
+import org.eclipse.jetty.websocket.api.Callback;
+import org.eclipse.jetty.websocket.api.Session;
+import org.eclipse.jetty.websocket.api.StatusCode;
+import org.eclipse.jetty.websocket.client.WebSocketClient;
+
+/**
+ * <p>A {@link LoadGenerator} for WebSocket fan-out.</p>
+ * <p>Each operation is one message sent by a publisher session, that the server
+ * broadcasts to all the subscriber sessions; the latency of each delivery to
+ * a subscriber is recorded, so that each operation completes
+ * {@link #getFanOut() once per subscriber}.</p>
+ * <p>Messages carry the nanoTime at which they were scheduled, which is
+ * meaningful because the client and the server run in the same JVM.</p>
+ */
+public class WebSocketLoadGenerator extends LoadGenerator
+{
+    private final List<Session> subscribers = new ArrayList<>();
+    private final WebSocketClient client;
+    private final URI uri;
+    private final int subscriberCount;
+    private final String padding;
+    private Session publisher;
+
+    /**
+     * @param client the WebSocket client
+     * @param uri the server URI, resolved against {@code /subscribe} and {@code /publish}
+     * @param subscriberCount the number of subscriber sessions
+     * @param messageSize the approximate size of each message, in bytes
+     */
+    public WebSocketLoadGenerator(WebSocketClient client, URI uri, int subscriberCount, int messageSize)
+    {
+        this.client = client;
+        this.uri = uri;
+        this.subscriberCount = subscriberCount;
+        this.padding = "x".repeat(Math.max(0, messageSize - 24));
+    }
+
+    /**
+     * <p>Connects the subscriber sessions and the publisher session.</p>
+     *
+     * @throws Exception if the sessions cannot be connected
+     */
+    public void connect() throws Exception
+    {
+        List<CompletableFuture<Session>> futures = new ArrayList<>();
+        for (int i = 0; i < subscriberCount; ++i)
+        {
+            futures.add(client.connect(new Subscriber(), uri.resolve("/subscribe")));
+        }
+        for (CompletableFuture<Session> future : futures)
+        {
+            subscribers.add(future.get(10, TimeUnit.SECONDS));
+        }
+        publisher = client.connect(new Session.Listener.AbstractAutoDemanding() {}, uri.resolve("/publish")).get(10, TimeUnit.SECONDS);
+    }
+
+    /**
+     * <p>Closes the publisher and subscriber sessions.</p>
+     */
+    public void disconnect()
+    {
+        if (publisher != null)
+            publisher.close(StatusCode.NORMAL, null, Callback.NOOP);
+        subscribers.forEach(session -> session.close(StatusCode.NORMAL, null, Callback.NOOP));
+    }
+
+    @Override
+    protected int getFanOut()
+    {
+        return subscriberCount;
+    }
+
+    @Override
+    protected void send(long intendedNanos, boolean measured)
+    {
+        String message = intendedNanos + " " + (measured ? "1" : "0") + " " + padding;
+        publisher.sendText(message, Callback.from(() -> {}, x ->
+        {
+            for (int i = 0; i < subscriberCount; ++i)
+            {
+                onComplete(intendedNanos, measured, 0, x);
+            }
+        }));
+    }
+
+    private class Subscriber extends Session.Listener.AbstractAutoDemanding
+    {
+        @Override
+        public void onWebSocketText(String message)
+        {
+            int space = message.indexOf(' ');
+            long intendedNanos = Long.parseLong(message, 0, space, 10);
+            boolean measured = message.charAt(space + 1) == '1';
+            onComplete(intendedNanos, measured, message.length(), null);
+        }
+    }
+}
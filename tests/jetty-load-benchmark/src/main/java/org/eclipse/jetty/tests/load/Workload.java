@@ -0,0 +1,282 @@
+//
+// ========================================================================
+// Copyright (c) 1995 Mort Bay Consulting Pty Ltd and others.
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License v. 2.0 which is available at
+// https://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+// ========================================================================
+//
+
+package org.eclipse.jetty.tests.load;
+
+import java.io.IOException;
+import java.net.URI;
+import java.nio.ByteBuffer;
+import java.nio.charset.StandardCharsets;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.util.Set;
+import java.util.concurrent.ConcurrentHashMap;
+import java.util.function.Supplier;
+
+import org.eclipse.jetty.client.ByteBufferRequestContent;
+import org.eclipse.jetty.client.HttpClient;
+import org.eclipse.jetty.client.Request;
+import org.eclipse.jetty.http.HttpHeader;
+import org.eclipse.jetty.http.HttpMethod;
+import org.eclipse.jetty.io.Content;
+import org.eclipse.jetty.server.Handler;
+import org.eclipse.jetty.server.Response;
+import org.eclipse.jetty.server.Server;
+import org.eclipse.jetty.server.handler.ResourceHandler;
+import org.eclipse.jetty.util.Callback;
+import org.eclipse.jetty.util.IteratingCallback;
+import org.eclipse.jetty.util.resource.ResourceFactory;
+import org.eclipse.jetty.websocket.api.Session;
+import org.eclipse.jetty.websocket.server.WebSocketUpgradeHandler;
+
+/**
+ * <p>The workloads that can be benchmarked.</p>
+ * <p>Each workload provides the server {@link Handler} and, for HTTP workloads, the
+ * client request; the {@code size} parameter is the size in bytes of the content
+ * of the request or response, or of the WebSocket message.</p>
+ */
+public enum Workload
+{
+    /**
+     * <p>Small JSON responses from a dynamic handler.</p>
+     */
+    JSON(256),
+    /**
+     * <p>Static file responses from a {@link ResourceHandler}.</p>
+     */
+    FILE(64 * 1024),
+    /**
+     * <p>Request content uploads, fully consumed by the server.</p>
+     */
+    UPLOAD(64 * 1024),
+    /**
+     * <p>Large responses written in chunks by a dynamic handler.</p>
+     */
+    STREAM(1024 * 1024),
+    /**
+     * <p>WebSocket messages broadcast to many sessions.</p>
+     */
+    WEBSOCKET(128);
+
+    private static final int STREAM_CHUNK_SIZE = 8 * 1024;
+    private static final String FILE_NAME = "file.bin";
+
+    private final int defaultSize;
+
+    Workload(int defaultSize)
+    {
+        this.defaultSize = defaultSize;
+    }
+
+    public int getDefaultSize()
+    {
+        return defaultSize;
+    }
+
+    public boolean isWebSocket()
+    {
+        return this == WEBSOCKET;
+    }
+
+    /**
+     * @param server the server
+     * @param workDir a directory where the workload can create files
+     * @param size the content size
+     * @return the server handler for this workload
+     * @throws IOException if the workload files cannot be created
+     */
+    public Handler newHandler(Server server, Path workDir, int size) throws IOException
+    {
+        return switch (this)
+        {
+            case JSON -> new JsonHandler(size);
+            case FILE ->
+            {
+                byte[] bytes = new byte[size];
+                for (int i = 0; i < bytes.length; ++i)
+                {
+                    bytes[i] = (byte)('a' + i % 26);
+                }
+                Files.write(workDir.resolve(FILE_NAME), bytes);
+                ResourceHandler resourceHandler = new ResourceHandler();
+                resourceHandler.setBaseResource(ResourceFactory.of(resourceHandler).newResource(workDir));
+                resourceHandler.setDirAllowed(false);
+                yield resourceHandler;
+            }
+            case UPLOAD -> new UploadHandler();
+            case STREAM -> new StreamHandler(size);
+            case WEBSOCKET ->
+            {
+                Set<Session> subscribers = ConcurrentHashMap.newKeySet();
+                yield WebSocketUpgradeHandler.from(server, container ->
+                {
+                    container.setMaxTextMessageSize(Math.max(64 * 1024, 2L * size));
+                    container.addMapping("/subscribe", (rq, rs, cb) -> new SubscriberEndpoint(subscribers));
+                    container.addMapping("/publish", (rq, rs, cb) -> new PublisherEndpoint(subscribers));
+                });
+            }
+        };
+    }
+
+    /**
+     * @param client the HTTP client
+     * @param uri the server URI
+     * @param size the content size
+     * @return a supplier of new requests for this workload
+     */
+    public Supplier<Request> newRequests(HttpClient client, URI uri, int size)
+    {
+        return switch (this)
+        {
+            case JSON -> () -> client.newRequest(uri).path("/json");
+            case FILE -> () -> client.newRequest(uri).path("/" + FILE_NAME);
+            case UPLOAD ->
+            {
+                ByteBuffer content = toDirectBuffer(new byte[size]);
+                yield () -> client.newRequest(uri)
+                    .method(HttpMethod.POST)
+                    .path("/upload")
+                    .body(new ByteBufferRequestContent(content.slice()));
+            }
+            case STREAM -> () -> client.newRequest(uri).path("/stream");
+            case WEBSOCKET -> throw new UnsupportedOperationException("Not an HTTP workload: " + this);
+        };
+    }
+
+    private static ByteBuffer toDirectBuffer(byte[] bytes)
+    {
+        return ByteBuffer.allocateDirect(bytes.length).put(bytes).flip().asReadOnlyBuffer();
+    }
+
+    private static class JsonHandler extends Handler.Abstract.NonBlocking
+    {
+        private final ByteBuffer json;
+
+        private JsonHandler(int size)
+        {
+            StringBuilder builder = new StringBuilder("{\"id\":1,\"items\":[");
+            for (int i = 0; builder.length() < size - 16; ++i)
+            {
+                if (i > 0)
+                    builder.append(',');
+                builder.append("{\"n\":").append(i).append(",\"v\":\"item\"}");
+            }
+            builder.append("]}");
+            this.json = toDirectBuffer(builder.toString().getBytes(StandardCharsets.UTF_8));
+        }
+
+        @Override
+        public boolean handle(org.eclipse.jetty.server.Request request, Response response, Callback callback)
+        {
+            response.getHeaders().put(HttpHeader.CONTENT_TYPE, "application/json");
+            response.write(true, json.slice(), callback);
+            return true;
+        }
+    }
+
+    private static class UploadHandler extends Handler.Abstract.NonBlocking
+    {
+        @Override
+        public boolean handle(org.eclipse.jetty.server.Request request, Response response, Callback callback)
+        {
+            Content.Source.consumeAll(request, callback);
+            return true;
+        }
+    }
+
+    private static class StreamHandler extends Handler.Abstract.NonBlocking
+    {
+        private final ByteBuffer chunk = toDirectBuffer(new byte[STREAM_CHUNK_SIZE]);
+        private final int chunks;
+
+        private StreamHandler(int size)
+        {
+            this.chunks = Math.max(1, size / STREAM_CHUNK_SIZE);
+        }
+
+        @Override
+        public boolean handle(org.eclipse.jetty.server.Request request, Response response, Callback callback)
+        {
+            response.getHeaders().put(HttpHeader.CONTENT_TYPE, "application/octet-stream");
+            new IteratingCallback()
+            {
+                private int written;
+
+                @Override
+                protected Action process()
+                {
+                    if (written == chunks)
+                        return Action.SUCCEEDED;
+                    ++written;
+                    response.write(written == chunks, chunk.slice(), this);
+                    return Action.SCHEDULED;
+                }
+
+                @Override
+                protected void onCompleteSuccess()
+                {
+                    callback.succeeded();
+                }
+
+                @Override
+                protected void onCompleteFailure(Throwable cause)
+                {
+                    callback.failed(cause);
+                }
+            }.iterate();
+            return true;
+        }
+    }
+
+    private static class SubscriberEndpoint extends Session.Listener.AbstractAutoDemanding
+    {
+        private final Set<Session> subscribers;
+
+        private SubscriberEndpoint(Set<Session> subscribers)
+        {
+            this.subscribers = subscribers;
+        }
+
+        @Override
+        public void onWebSocketOpen(Session session)
+        {
+            super.onWebSocketOpen(session);
+            subscribers.add(session);
+        }
+
+        @Override
+        public void onWebSocketClose(int statusCode, String reason)
+        {
+            subscribers.remove(getSession());
+        }
+    }
+
+    private static class PublisherEndpoint extends Session.Listener.AbstractAutoDemanding
+    {
+        private final Set<Session> subscribers;
+
+        private PublisherEndpoint(Set<Session> subscribers)
+        {
+            this.subscribers = subscribers;
+        }
+
+        @Override
+        public void onWebSocketText(String message)
+        {
+            for (Session subscriber : subscribers)
+            {
+                subscriber.sendText(message, org.eclipse.jetty.websocket.api.Callback.NOOP);
+            }
+        }
+    }
+}
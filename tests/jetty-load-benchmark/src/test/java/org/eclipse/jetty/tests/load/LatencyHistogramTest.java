@@ -0,0 +1,86 @@
+//
+// ========================================================================
+// Copyright (c) 1995 Mort Bay Consulting Pty Ltd and others.
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License v. 2.0 which is available at
+// https://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+// ========================================================================
+//
+
+package org.eclipse.jetty.tests.load;
+
+import java.io.StringWriter;
+import java.util.concurrent.ThreadLocalRandom;
+
+import org.junit.jupiter.api.Test;
+
+import static org.hamcrest.MatcherAssert.assertThat;
+import static org.hamcrest.Matchers.containsString;
+import static org.hamcrest.Matchers.greaterThanOrEqualTo;
+import static org.hamcrest.Matchers.is;
+import static org.hamcrest.Matchers.lessThan;
+import static org.hamcrest.Matchers.lessThanOrEqualTo;
+
+public class LatencyHistogramTest
+{
+    @Test
+    public void testBucketBoundaries()
+    {
+        for (int i = 0; i < 100_000; ++i)
+        {
+            long value = i < 10_000 ? i : ThreadLocalRandom.current().nextLong(1L << 40);
+            int index = LatencyHistogram.indexOf(value);
+            long highest = LatencyHistogram.highestValueAt(index);
+            assertThat(highest, greaterThanOrEqualTo(value));
+            assertThat(highest - value, lessThanOrEqualTo(Math.max(1, value / 64)));
+            if (index > 0)
+                assertThat(LatencyHistogram.highestValueAt(index - 1), lessThan(value));
+        }
+    }
+
+    @Test
+    public void testPercentiles()
+    {
+        LatencyHistogram histogram = new LatencyHistogram();
+        for (long i = 1; i <= 10_000; ++i)
+        {
+            histogram.record(i * 1000);
+        }
+
+        assertThat(histogram.getCount(), is(10_000L));
+        assertThat(histogram.getMin(), is(1000L));
+        assertThat(histogram.getMax(), is(10_000_000L));
+        assertWithin(histogram.getValueAtPercentile(50), 5_000_000L);
+        assertWithin(histogram.getValueAtPercentile(99), 9_900_000L);
+        assertWithin(histogram.getValueAtPercentile(99.9), 9_990_000L);
+        assertThat(histogram.getValueAtPercentile(100), is(10_000_000L));
+        assertWithin((long)histogram.getMean(), 5_000_500L);
+    }
+
+    @Test
+    public void testEmptyAndClamped() throws Exception
+    {
+        LatencyHistogram histogram = new LatencyHistogram();
+        assertThat(histogram.getValueAtPercentile(99), is(0L));
+        assertThat(histogram.getMin(), is(0L));
+
+        histogram.record(-1);
+        histogram.record(Long.MAX_VALUE);
+        assertThat(histogram.getMin(), is(0L));
+        assertThat(histogram.getMax(), is((1L << 40) - 1));
+
+        StringWriter writer = new StringWriter();
+        histogram.writeDistribution(writer);
+        assertThat(writer.toString(), containsString("1.000000"));
+    }
+
+    private static void assertWithin(long actual, long expected)
+    {
+        assertThat(actual, greaterThanOrEqualTo(expected));
+        assertThat(actual, lessThanOrEqualTo(expected + expected / 64));
+    }
+}
@@ -0,0 +1,97 @@
+//
+// ========================================================================
+// Copyright (c) 1995 Mort Bay Consulting Pty Ltd and others.
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License v. 2.0 which is available at
+// https://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+// ========================================================================
+//
+
+package org.eclipse.jetty.tests.load;
+
+import java.io.StringWriter;
+import java.util.Map;
+
+import org.junit.jupiter.api.Test;
+import org.junit.jupiter.params.ParameterizedTest;
+import org.junit.jupiter.params.provider.EnumSource;
+
+import static org.hamcrest.MatcherAssert.assertThat;
+import static org.hamcrest.Matchers.containsString;
+import static org.hamcrest.Matchers.greaterThan;
+import static org.hamcrest.Matchers.is;
+import static org.hamcrest.Matchers.not;
+import static org.junit.jupiter.api.Assertions.assertThrows;
+
+public class LoadBenchmarkTest
+{
+    @ParameterizedTest
+    @EnumSource(value = Workload.class, names = "WEBSOCKET", mode = EnumSource.Mode.EXCLUDE)
+    public void testMemoryWorkload(Workload workload) throws Exception
+    {
+        Report report = new LoadBenchmark(Map.of(
+            "protocol", "memory",
+            "workload", workload.name(),
+            "rate", "200",
+            "warmup", "0",
+            "duration", "1"
+        )).run();
+
+        assertThat(report.get("ops.failed"), is("0"));
+        assertThat(Long.parseLong(report.get("ops.succeeded")), greaterThan(0L));
+        assertThat(report.get("config.size"), is(String.valueOf(workload.getDefaultSize())));
+        assertThat(report.get("latency.p99.us"), not(is("0.0")));
+    }
+
+    @Test
+    public void testWebSocketFanOut() throws Exception
+    {
+        Report report = new LoadBenchmark(Map.of(
+            "workload", "websocket",
+            "subscribers", "4",
+            "rate", "100",
+            "warmup", "0",
+            "duration", "1"
+        )).run();
+
+        assertThat(report.get("ops.failed"), is("0"));
+        assertThat(report.get("ops.succeeded"), is(report.get("ops.scheduled")));
+    }
+
+    @Test
+    public void testInvalidOptions()
+    {
+        assertThrows(IllegalArgumentException.class, () -> new LoadBenchmark(Map.of("unknown", "1")));
+        assertThrows(IllegalArgumentException.class, () -> new LoadBenchmark(Map.of("workload", "websocket", "protocol", "h2")));
+    }
+
+    @Test
+    public void testCompareWithBaseline() throws Exception
+    {
+        Report baseline = new Report();
+        baseline.put("config.rate", "1000");
+        baseline.put("throughput.ops", "1000.0");
+        baseline.put("latency.p99.us", "100.0");
+        baseline.put("alloc.bytesPerOp", "4096");
+
+        Report current = new Report();
+        current.put("config.rate", "1000");
+        current.put("throughput.ops", "995.0");
+        current.put("latency.p99.us", "150.0");
+        current.put("alloc.bytesPerOp", "2048");
+
+        StringWriter output = new StringWriter();
+        assertThat(current.compare(baseline, 10, output), is(1));
+        assertThat(output.toString(), containsString("latency.p99.us"));
+        assertThat(output.toString(), not(containsString("WARNING")));
+
+        current.put("config.rate", "2000");
+        output = new StringWriter();
+        current.compare(baseline, 10, output);
+        assertThat(output.toString(), containsString("WARNING: config.rate"));
+    }
+}